@@ -0,0 +1,561 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hash many independent messages per call
+ * @file MultiBuffer.cpp
+ * @date 2022-11-16
+ */
+#include "MultiBuffer.h"
+#include <boost/endian/conversion.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace bcos::crypto::hasher;
+using namespace bcos::crypto::hasher::multibuffer;
+
+// The kernels are written once over a lane type: a scalar integer, or a gcc vector of several
+// lanes whose arithmetic is lowered to AVX2/AVX-512 instructions by the target of the caller.
+// Everything below the entry points is always inlined so that it is compiled for that target.
+#define MULTIBUFFER_INLINE [[gnu::always_inline]] inline
+// the vectors never cross a call boundary
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace
+{
+using u64x4 = uint64_t __attribute__((vector_size(32)));
+using u64x8 = uint64_t __attribute__((vector_size(64)));
+using u32x8 = uint32_t __attribute__((vector_size(32)));
+using u32x16 = uint32_t __attribute__((vector_size(64)));
+
+template <class Lane>
+constexpr size_t laneCount()
+{
+    if constexpr (std::is_integral_v<Lane>)
+    {
+        return 1;
+    }
+    else
+    {
+        return sizeof(Lane) / sizeof(Lane{}[0]);
+    }
+}
+
+template <class Lane, class Value>
+MULTIBUFFER_INLINE void setLane(Lane& _lane, size_t _index, Value _value)
+{
+    if constexpr (std::is_integral_v<Lane>)
+    {
+        _lane = _value;
+    }
+    else
+    {
+        _lane[_index] = _value;
+    }
+}
+
+template <class Lane>
+MULTIBUFFER_INLINE auto getLane(Lane const& _lane, size_t _index)
+{
+    if constexpr (std::is_integral_v<Lane>)
+    {
+        return _lane;
+    }
+    else
+    {
+        return _lane[_index];
+    }
+}
+
+template <class Lane>
+MULTIBUFFER_INLINE Lane rotl64(Lane const& _value, int _shift)
+{
+    return (_value << _shift) | (_value >> (64 - _shift));
+}
+
+template <class Lane>
+MULTIBUFFER_INLINE Lane rotl32(Lane const& _value, int _shift)
+{
+    _shift &= 31;
+    if (_shift == 0)
+    {
+        return _value;
+    }
+    return (_value << _shift) | (_value >> (32 - _shift));
+}
+
+// one message: the full blocks are read in place, the padded tail from a copy
+template <size_t BLOCK_SIZE>
+struct Message
+{
+    std::byte const* data = nullptr;
+    size_t fullBlocks = 0;
+    size_t blocks = 0;
+    std::byte* out = nullptr;
+    std::array<std::byte, BLOCK_SIZE * 2> tail = {};
+
+    std::byte const* block(size_t _index) const
+    {
+        if (_index < fullBlocks)
+        {
+            return data + _index * BLOCK_SIZE;
+        }
+        return tail.data() + (_index - fullBlocks) * BLOCK_SIZE;
+    }
+};
+
+// keccak256: rate 136 bytes, padding 0x01 .. 0x80
+constexpr size_t KECCAK_RATE = 136;
+using KeccakMessage = Message<KECCAK_RATE>;
+
+void prepareKeccak(std::span<std::byte const> _input, std::byte* _out, KeccakMessage& _message)
+{
+    _message.data = _input.data();
+    _message.fullBlocks = _input.size() / KECCAK_RATE;
+    _message.blocks = _message.fullBlocks + 1;
+    _message.out = _out;
+    auto tailSize = _input.size() % KECCAK_RATE;
+    _message.tail.fill(std::byte(0));
+    if (tailSize > 0)
+    {
+        std::memcpy(_message.tail.data(), _input.data() + _message.fullBlocks * KECCAK_RATE,
+            tailSize);
+    }
+    _message.tail[tailSize] ^= std::byte(0x01);
+    _message.tail[KECCAK_RATE - 1] ^= std::byte(0x80);
+}
+
+constexpr std::array<uint64_t, 24> KECCAK_RC = {0x0000000000000001ULL, 0x0000000000008082ULL,
+    0x800000000000808aULL, 0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL, 0x0000000000000088ULL,
+    0x0000000080008009ULL, 0x000000008000000aULL, 0x000000008000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x0000000080000001ULL, 0x8000000080008008ULL};
+constexpr std::array<int, 24> KECCAK_ROTATION = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+constexpr std::array<int, 24> KECCAK_PI = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+
+template <class Lane>
+MULTIBUFFER_INLINE void keccakF1600(Lane* _state)
+{
+    Lane bc[5];
+#pragma GCC unroll 1
+    for (auto roundConstant : KECCAK_RC)
+    {
+        // theta
+#pragma GCC unroll 5
+        for (int i = 0; i < 5; ++i)
+        {
+            bc[i] = _state[i] ^ _state[i + 5] ^ _state[i + 10] ^ _state[i + 15] ^ _state[i + 20];
+        }
+#pragma GCC unroll 5
+        for (int i = 0; i < 5; ++i)
+        {
+            Lane t = bc[(i + 4) % 5] ^ rotl64(bc[(i + 1) % 5], 1);
+#pragma GCC unroll 5
+            for (int j = 0; j < 25; j += 5)
+            {
+                _state[j + i] ^= t;
+            }
+        }
+        // rho and pi
+        Lane t = _state[1];
+#pragma GCC unroll 24
+        for (int i = 0; i < 24; ++i)
+        {
+            auto j = KECCAK_PI[i];
+            bc[0] = _state[j];
+            _state[j] = rotl64(t, KECCAK_ROTATION[i]);
+            t = bc[0];
+        }
+        // chi
+#pragma GCC unroll 5
+        for (int j = 0; j < 25; j += 5)
+        {
+#pragma GCC unroll 5
+            for (int i = 0; i < 5; ++i)
+            {
+                bc[i] = _state[j + i];
+            }
+#pragma GCC unroll 5
+            for (int i = 0; i < 5; ++i)
+            {
+                _state[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            }
+        }
+        // iota
+        _state[0] ^= roundConstant;
+    }
+}
+
+// hash the messages of the same block count, one per lane
+template <class Lane>
+MULTIBUFFER_INLINE void keccakLanes(KeccakMessage const* const* _messages)
+{
+    constexpr auto LANES = laneCount<Lane>();
+    Lane state[25] = {};
+    for (size_t block = 0; block < _messages[0]->blocks; ++block)
+    {
+        std::byte const* data[LANES];
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            data[lane] = _messages[lane]->block(block);
+        }
+        for (size_t word = 0; word < KECCAK_RATE / 8; ++word)
+        {
+            Lane value;
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                uint64_t input;
+                std::memcpy(&input, data[lane] + word * 8, 8);
+                setLane(value, lane, boost::endian::little_to_native(input));
+            }
+            state[word] ^= value;
+        }
+        keccakF1600(state);
+    }
+    for (size_t lane = 0; lane < LANES; ++lane)
+    {
+        for (size_t word = 0; word < 4; ++word)
+        {
+            uint64_t output = boost::endian::native_to_little((uint64_t)getLane(state[word], lane));
+            std::memcpy(_messages[lane]->out + word * 8, &output, 8);
+        }
+    }
+}
+
+// sm3: block 64 bytes, padding 0x80 .. 64 bits big endian length
+constexpr size_t SM3_BLOCK = 64;
+using SM3Message = Message<SM3_BLOCK>;
+
+void prepareSM3(std::span<std::byte const> _input, std::byte* _out, SM3Message& _message)
+{
+    _message.data = _input.data();
+    _message.fullBlocks = _input.size() / SM3_BLOCK;
+    _message.out = _out;
+    auto tailSize = _input.size() % SM3_BLOCK;
+    auto tailBlocks = (tailSize + 9 + SM3_BLOCK - 1) / SM3_BLOCK;
+    _message.blocks = _message.fullBlocks + tailBlocks;
+    _message.tail.fill(std::byte(0));
+    if (tailSize > 0)
+    {
+        std::memcpy(
+            _message.tail.data(), _input.data() + _message.fullBlocks * SM3_BLOCK, tailSize);
+    }
+    _message.tail[tailSize] = std::byte(0x80);
+    uint64_t bits = boost::endian::native_to_big((uint64_t)_input.size() * 8);
+    std::memcpy(_message.tail.data() + tailBlocks * SM3_BLOCK - 8, &bits, 8);
+}
+
+constexpr std::array<uint32_t, 8> SM3_IV = {0x7380166f, 0x4914b2b9, 0x172442d7, 0xda8a0600,
+    0xa96f30bc, 0x163138aa, 0xe38dee4d, 0xb0fb0e4e};
+
+template <class Lane>
+MULTIBUFFER_INLINE Lane sm3P0(Lane const& _value)
+{
+    return _value ^ rotl32(_value, 9) ^ rotl32(_value, 17);
+}
+
+template <class Lane>
+MULTIBUFFER_INLINE Lane sm3P1(Lane const& _value)
+{
+    return _value ^ rotl32(_value, 15) ^ rotl32(_value, 23);
+}
+
+template <class Lane>
+MULTIBUFFER_INLINE void sm3Compress(Lane* _digest, Lane const* _words)
+{
+    Lane w[68];
+    for (int j = 0; j < 16; ++j)
+    {
+        w[j] = _words[j];
+    }
+    for (int j = 16; j < 68; ++j)
+    {
+        w[j] = sm3P1(w[j - 16] ^ w[j - 9] ^ rotl32(w[j - 3], 15)) ^ rotl32(w[j - 13], 7) ^
+               w[j - 6];
+    }
+
+    Lane a = _digest[0];
+    Lane b = _digest[1];
+    Lane c = _digest[2];
+    Lane d = _digest[3];
+    Lane e = _digest[4];
+    Lane f = _digest[5];
+    Lane g = _digest[6];
+    Lane h = _digest[7];
+    for (int j = 0; j < 64; ++j)
+    {
+        uint32_t t = j < 16 ? 0x79cc4519 : 0x7a879d8a;
+        t = (t << (j % 32)) | (j % 32 == 0 ? 0 : t >> (32 - j % 32));
+        Lane a12 = rotl32(a, 12);
+        Lane ss1 = rotl32(a12 + e + t, 7);
+        Lane ss2 = ss1 ^ a12;
+        Lane ff = j < 16 ? (a ^ b ^ c) : ((a & b) | (a & c) | (b & c));
+        Lane gg = j < 16 ? (e ^ f ^ g) : ((e & f) | (~e & g));
+        Lane tt1 = ff + d + ss2 + (w[j] ^ w[j + 4]);
+        Lane tt2 = gg + h + ss1 + w[j];
+        d = c;
+        c = rotl32(b, 9);
+        b = a;
+        a = tt1;
+        h = g;
+        g = rotl32(f, 19);
+        f = e;
+        e = sm3P0(tt2);
+    }
+    _digest[0] ^= a;
+    _digest[1] ^= b;
+    _digest[2] ^= c;
+    _digest[3] ^= d;
+    _digest[4] ^= e;
+    _digest[5] ^= f;
+    _digest[6] ^= g;
+    _digest[7] ^= h;
+}
+
+template <class Lane>
+MULTIBUFFER_INLINE void sm3Lanes(SM3Message const* const* _messages)
+{
+    constexpr auto LANES = laneCount<Lane>();
+    Lane digest[8] = {};
+    for (size_t i = 0; i < 8; ++i)
+    {
+        digest[i] += SM3_IV[i];
+    }
+    for (size_t block = 0; block < _messages[0]->blocks; ++block)
+    {
+        Lane words[16];
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            auto const* data = _messages[lane]->block(block);
+            for (size_t word = 0; word < 16; ++word)
+            {
+                uint32_t input;
+                std::memcpy(&input, data + word * 4, 4);
+                setLane(words[word], lane, boost::endian::big_to_native(input));
+            }
+        }
+        sm3Compress(digest, words);
+    }
+    for (size_t lane = 0; lane < LANES; ++lane)
+    {
+        for (size_t word = 0; word < 8; ++word)
+        {
+            uint32_t output = boost::endian::native_to_big((uint32_t)getLane(digest[word], lane));
+            std::memcpy(_messages[lane]->out + word * 4, &output, 4);
+        }
+    }
+}
+
+// group the messages by block count and hash laneCount<Lane>() of them at a time, the missing
+// lanes of the last group of a block count repeat its first message into a scratch output
+template <class Lane, class MessageType>
+MULTIBUFFER_INLINE void runLanes(std::vector<MessageType>& _messages)
+{
+    constexpr auto LANES = laneCount<Lane>();
+    std::vector<MessageType const*> order;
+    order.reserve(_messages.size());
+    for (auto const& message : _messages)
+    {
+        order.push_back(&message);
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [](MessageType const* _lhs, MessageType const* _rhs) { return _lhs->blocks < _rhs->blocks; });
+
+    MessageType padding;
+    std::array<std::byte, 32> scratch;
+    for (size_t begin = 0; begin < order.size();)
+    {
+        auto blocks = order[begin]->blocks;
+        MessageType const* lanes[LANES];
+        size_t count = 0;
+        while (count < LANES && begin + count < order.size() &&
+               order[begin + count]->blocks == blocks)
+        {
+            lanes[count] = order[begin + count];
+            ++count;
+        }
+        if (count < LANES)
+        {
+            padding = *lanes[0];
+            padding.out = scratch.data();
+            for (auto i = count; i < LANES; ++i)
+            {
+                lanes[i] = &padding;
+            }
+        }
+        if constexpr (std::is_same_v<MessageType, KeccakMessage>)
+        {
+            keccakLanes<Lane>(lanes);
+        }
+        else
+        {
+            sm3Lanes<Lane>(lanes);
+        }
+        begin += count;
+    }
+}
+
+void keccakScalar(std::vector<KeccakMessage>& _messages)
+{
+    runLanes<uint64_t>(_messages);
+}
+
+void sm3Scalar(std::vector<SM3Message>& _messages)
+{
+    runLanes<uint32_t>(_messages);
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) void keccakAVX2(std::vector<KeccakMessage>& _messages)
+{
+    runLanes<u64x4>(_messages);
+}
+
+__attribute__((target("avx512f"))) void keccakAVX512(std::vector<KeccakMessage>& _messages)
+{
+    runLanes<u64x8>(_messages);
+}
+
+__attribute__((target("avx2"))) void sm3AVX2(std::vector<SM3Message>& _messages)
+{
+    runLanes<u32x8>(_messages);
+}
+
+__attribute__((target("avx512f"))) void sm3AVX512(std::vector<SM3Message>& _messages)
+{
+    runLanes<u32x16>(_messages);
+}
+#endif
+
+Backend supportedBackend(Backend _backend)
+{
+    auto best = bestBackend();
+    return (int)_backend > (int)best ? best : _backend;
+}
+
+void checkOutputSize(size_t _inputs, size_t _outputs)
+{
+    if (_outputs < _inputs * 32) [[unlikely]]
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument{"Output size too short!"});
+    }
+}
+}  // namespace
+
+Backend multibuffer::bestBackend()
+{
+#if defined(__x86_64__)
+    static Backend const best = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return Backend::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return Backend::AVX2;
+        }
+        return Backend::Scalar;
+    }();
+    return best;
+#else
+    return Backend::Scalar;
+#endif
+}
+
+size_t multibuffer::keccak256Lanes(Backend _backend)
+{
+    switch (supportedBackend(_backend))
+    {
+    case Backend::AVX512:
+        return 8;
+    case Backend::AVX2:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+size_t multibuffer::sm3Lanes(Backend _backend)
+{
+    switch (supportedBackend(_backend))
+    {
+    case Backend::AVX512:
+        return 16;
+    case Backend::AVX2:
+        return 8;
+    default:
+        return 1;
+    }
+}
+
+void multibuffer::keccak256(std::span<std::span<std::byte const> const> _inputs,
+    std::span<std::byte> _outputs, Backend _backend)
+{
+    checkOutputSize(_inputs.size(), _outputs.size());
+    std::vector<KeccakMessage> messages(_inputs.size());
+    for (size_t i = 0; i < _inputs.size(); ++i)
+    {
+        prepareKeccak(_inputs[i], _outputs.data() + i * 32, messages[i]);
+    }
+    switch (_inputs.size() > 1 ? supportedBackend(_backend) : Backend::Scalar)
+    {
+#if defined(__x86_64__)
+    case Backend::AVX512:
+        keccakAVX512(messages);
+        break;
+    case Backend::AVX2:
+        keccakAVX2(messages);
+        break;
+#endif
+    default:
+        keccakScalar(messages);
+        break;
+    }
+}
+
+void multibuffer::sm3(std::span<std::span<std::byte const> const> _inputs,
+    std::span<std::byte> _outputs, Backend _backend)
+{
+    checkOutputSize(_inputs.size(), _outputs.size());
+    std::vector<SM3Message> messages(_inputs.size());
+    for (size_t i = 0; i < _inputs.size(); ++i)
+    {
+        prepareSM3(_inputs[i], _outputs.data() + i * 32, messages[i]);
+    }
+    switch (_inputs.size() > 1 ? supportedBackend(_backend) : Backend::Scalar)
+    {
+#if defined(__x86_64__)
+    case Backend::AVX512:
+        sm3AVX512(messages);
+        break;
+    case Backend::AVX2:
+        sm3AVX2(messages);
+        break;
+#endif
+    default:
+        sm3Scalar(messages);
+        break;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hash many independent messages per call
+ * @file MultiBuffer.h
+ * @date 2022-11-16
+ */
+#pragma once
+#include "Hasher.h"
+#include <cstddef>
+#include <span>
+
+namespace bcos::crypto::hasher
+{
+namespace multibuffer
+{
+enum class Backend
+{
+    Scalar,
+    // 4 keccak lanes, 8 sm3 lanes
+    AVX2,
+    // 8 keccak lanes, 16 sm3 lanes
+    AVX512,
+};
+
+// the widest backend supported by the running cpu
+Backend bestBackend();
+// the messages hashed by one call of the backend
+size_t keccak256Lanes(Backend _backend);
+size_t sm3Lanes(Backend _backend);
+
+// _outputs: _inputs.size() * 32 bytes, the hash of _inputs[i] is written at i * 32; a backend not
+// supported by the running cpu falls back to the best supported one
+void keccak256(std::span<std::span<std::byte const> const> _inputs,
+    std::span<std::byte> _outputs, Backend _backend = bestBackend());
+void sm3(std::span<std::span<std::byte const> const> _inputs, std::span<std::byte> _outputs,
+    Backend _backend = bestBackend());
+}  // namespace multibuffer
+
+template <class HasherType>
+concept MultiBufferHasher = Hasher<HasherType> &&
+    requires(std::span<std::span<std::byte const> const> inputs, std::span<std::byte> outputs)
+{
+    HasherType::hashBatch(inputs, outputs);
+};
+
+// hash every input independently, several lanes per call if the hasher supports it
+template <Hasher HasherType>
+void hashBatch(
+    std::span<std::span<std::byte const> const> _inputs, std::span<std::byte> _outputs)
+{
+    if constexpr (MultiBufferHasher<HasherType>)
+    {
+        HasherType::hashBatch(_inputs, _outputs);
+    }
+    else
+    {
+        HasherType hasher;
+        for (size_t i = 0; i < _inputs.size(); ++i)
+        {
+            hasher.update(_inputs[i]);
+            auto output = _outputs.subspan(i * HasherType::HASH_SIZE, HasherType::HASH_SIZE);
+            hasher.final(output);
+        }
+    }
+}
+}  // namespace bcos::crypto::hasher
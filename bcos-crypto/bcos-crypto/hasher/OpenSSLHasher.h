@@ -2,6 +2,7 @@
 
 #include "../TrivialObject.h"
 #include "Hasher.h"
+#include "MultiBuffer.h"
 #include <openssl/evp.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
@@ -108,6 +109,33 @@ public:
         }
     }
 
+    // hash several messages per call with the SIMD backend, fall back to openssl on the cpu
+    // without one
+    static void hashBatch(std::span<std::span<std::byte const> const> inputs,
+        std::span<std::byte> outputs) requires(hasherType == Keccak256 || hasherType == SM3)
+    {
+        auto backend = multibuffer::bestBackend();
+        if (backend == multibuffer::Backend::Scalar)
+        {
+            OpenSSLHasher hasher;
+            for (size_t i = 0; i < inputs.size(); ++i)
+            {
+                hasher.update(inputs[i]);
+                auto output = outputs.subspan(i * HASH_SIZE, HASH_SIZE);
+                hasher.final(output);
+            }
+            return;
+        }
+        if constexpr (hasherType == Keccak256)
+        {
+            multibuffer::keccak256(inputs, outputs, backend);
+        }
+        else
+        {
+            multibuffer::sm3(inputs, outputs, backend);
+        }
+    }
+
     constexpr const EVP_MD* chooseMD()
     {
         if constexpr (hasherType == SM3)
@@ -146,5 +174,8 @@ static_assert(Hasher<OpenSSL_SHA3_256_Hasher>, "Assert OpenSSLHasher type");
 static_assert(Hasher<OpenSSL_SHA2_256_Hasher>, "Assert OpenSSLHasher type");
 static_assert(Hasher<OpenSSL_SM3_Hasher>, "Assert OpenSSLHasher type");
 static_assert(Hasher<OpenSSL_Keccak256_Hasher>, "Assert OpenSSLHasher type");
+static_assert(MultiBufferHasher<OpenSSL_SM3_Hasher>, "Assert OpenSSLHasher type");
+static_assert(MultiBufferHasher<OpenSSL_Keccak256_Hasher>, "Assert OpenSSLHasher type");
+static_assert(!MultiBufferHasher<OpenSSL_SHA3_256_Hasher>, "Assert OpenSSLHasher type");
 
 }  // namespace bcos::crypto::hasher::openssl
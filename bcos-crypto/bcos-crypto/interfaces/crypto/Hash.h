@@ -24,6 +24,9 @@
 #include <bcos-crypto/interfaces/crypto/KeyInterface.h>
 #include <bcos-utilities/FixedBytes.h>
 #include <memory>
+#include <span>
+#include <variant>
+#include <vector>
 namespace bcos
 {
 namespace crypto
@@ -70,6 +73,29 @@ public:
 
     virtual bcos::crypto::hasher::AnyHasher hasher() const = 0;
 
+    // hash every input independently, several inputs per call if the hasher supports it
+    virtual void hashBatch(std::span<bytesConstRef const> _inputs, std::span<HashType> _outputs)
+    {
+        std::vector<std::span<std::byte const>> inputs;
+        inputs.reserve(_inputs.size());
+        for (auto const& input : _inputs)
+        {
+            inputs.emplace_back((std::byte const*)input.data(), input.size());
+        }
+        std::vector<std::byte> outputs(_inputs.size() * HashType::SIZE);
+        auto anyHasher = hasher();
+        std::visit(
+            [&inputs, &outputs](auto& hasher) {
+                using HasherType = std::remove_cvref_t<decltype(hasher)>;
+                bcos::crypto::hasher::hashBatch<HasherType>(inputs, outputs);
+            },
+            anyHasher);
+        for (size_t i = 0; i < _inputs.size(); ++i)
+        {
+            _outputs[i] = HashType((const byte*)outputs.data() + i * HashType::SIZE, HashType::SIZE);
+        }
+    }
+
 private:
     HashType m_emptyHash = HashType();
     HashImplType m_type = Keccak256Hash;
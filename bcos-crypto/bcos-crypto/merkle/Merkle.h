@@ -3,6 +3,7 @@
 #include <bcos-concepts/Basic.h>
 #include <bcos-concepts/ByteBuffer.h>
 #include <bcos-crypto/hasher/Hasher.h>
+#include <bcos-crypto/hasher/MultiBuffer.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/Ranges.h>
@@ -245,6 +246,11 @@ private:
         assert(RANGES::size(input) > 0);
 
         auto outputSize = RANGES::size(output);
+        if constexpr (bcos::crypto::hasher::MultiBufferHasher<HasherType>)
+        {
+            calculateLevelHashesBatch(input, output);
+            return;
+        }
         tbb::parallel_for(tbb::blocked_range<size_t>(0, outputSize),
             [&input, &output](const tbb::blocked_range<size_t>& range) {
                 HasherType hasher;
@@ -259,6 +265,48 @@ private:
                 }
             });
     }
+
+    // the children of every node are copied next to each other and the nodes of a range are
+    // hashed several per call
+    void calculateLevelHashesBatch(HashRange auto const& input, HashRange auto& output) const
+    {
+        auto outputSize = RANGES::size(output);
+        auto inputSize = RANGES::size(input);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, outputSize),
+            [&input, &output, inputSize](const tbb::blocked_range<size_t>& range) {
+                std::vector<std::byte> buffer;
+                buffer.reserve(range.size() * width * HasherType::HASH_SIZE);
+                std::vector<size_t> offsets;
+                offsets.reserve(range.size() + 1);
+                for (auto i = range.begin(); i < range.end(); ++i)
+                {
+                    offsets.push_back(buffer.size());
+                    for (auto j = i * width; j < (i + 1) * width && j < (size_t)inputSize; ++j)
+                    {
+                        auto const& child = input[j];
+                        auto const* data = reinterpret_cast<std::byte const*>(RANGES::data(child));
+                        buffer.insert(buffer.end(), data, data + RANGES::size(child));
+                    }
+                }
+                offsets.push_back(buffer.size());
+
+                std::vector<std::span<std::byte const>> messages;
+                messages.reserve(range.size());
+                for (size_t i = 0; i < range.size(); ++i)
+                {
+                    messages.emplace_back(buffer.data() + offsets[i], offsets[i + 1] - offsets[i]);
+                }
+                std::vector<std::byte> hashes(range.size() * HasherType::HASH_SIZE);
+                HasherType::hashBatch(messages, hashes);
+                for (size_t i = 0; i < range.size(); ++i)
+                {
+                    bcos::concepts::bytebuffer::assignTo(
+                        std::span<std::byte const>(
+                            hashes.data() + i * HasherType::HASH_SIZE, HasherType::HASH_SIZE),
+                        output[range.begin() + i]);
+                }
+            });
+    }
 };
 
 }  // namespace bcos::crypto::merkle
\ No newline at end of file
@@ -17,6 +17,7 @@
  * @file HasherTest.h
  * @date 2022.04.19
  */
+#include <bcos-crypto/hasher/MultiBuffer.h>
 #include <bcos-crypto/hasher/OpenSSLHasher.h>
 #include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
@@ -109,6 +110,66 @@ BOOST_AUTO_TEST_CASE(dynamicRange)
     auto b = bcos::crypto::trivial::DynamicRange<std::vector<char>>;
 }
 
+BOOST_AUTO_TEST_CASE(multiBuffer)
+{
+    // the lengths cover the padding of one and two blocks, the lanes hash different lengths
+    std::vector<std::string> messages;
+    for (auto length = 0u; length < 300u; ++length)
+    {
+        std::string message(length, 0);
+        for (auto i = 0u; i < length; ++i)
+        {
+            message[i] = (char)(i * 31 + length);
+        }
+        messages.emplace_back(std::move(message));
+    }
+    std::vector<std::span<std::byte const>> inputs;
+    for (auto const& message : messages)
+    {
+        inputs.emplace_back((std::byte const*)message.data(), message.size());
+    }
+
+    std::vector<std::byte> expected(inputs.size() * 32);
+    for (auto i = 0u; i < inputs.size(); ++i)
+    {
+        openssl::OpenSSL_SM3_Hasher hasher;
+        hasher.update(inputs[i]);
+        std::span<std::byte> output(expected.data() + i * 32, 32);
+        hasher.final(output);
+    }
+
+    std::vector<std::byte> keccakScalar(inputs.size() * 32);
+    multibuffer::keccak256(inputs, keccakScalar, multibuffer::Backend::Scalar);
+    for (auto backend : {multibuffer::Backend::Scalar, multibuffer::Backend::AVX2,
+             multibuffer::Backend::AVX512})
+    {
+        std::vector<std::byte> sm3(inputs.size() * 32);
+        multibuffer::sm3(inputs, sm3, backend);
+        BOOST_CHECK(sm3 == expected);
+
+        std::vector<std::byte> keccak(inputs.size() * 32);
+        multibuffer::keccak256(inputs, keccak, backend);
+        BOOST_CHECK(keccak == keccakScalar);
+    }
+
+    std::vector<std::byte> sm3(inputs.size() * 32);
+    hashBatch<openssl::OpenSSL_SM3_Hasher>(inputs, sm3);
+    BOOST_CHECK(sm3 == expected);
+
+    std::string abc = "abc";
+    std::vector<std::span<std::byte const>> keccakInputs = {
+        {}, {(std::byte const*)abc.data(), abc.size()}};
+    std::vector<std::byte> keccak(64);
+    multibuffer::keccak256(keccakInputs, keccak);
+    std::string hex;
+    boost::algorithm::hex_lower(
+        (char const*)keccak.data(), (char const*)keccak.data() + 64, std::back_inserter(hex));
+    BOOST_CHECK_EQUAL(hex.substr(0, 64),
+        "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    BOOST_CHECK_EQUAL(hex.substr(64),
+        "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
 
@@ -141,6 +141,44 @@ BOOST_AUTO_TEST_CASE(merkle)
     loopWidthTest<testCount>(hashes);
 }
 
+// the same hasher without the multi-buffer backend
+struct SerialSM3Hasher
+{
+    constexpr static size_t HASH_SIZE = 32;
+    void update(auto const& in) { hasher.update(in); }
+    void final(auto& out) { hasher.final(out); }
+
+    bcos::crypto::hasher::openssl::OpenSSL_SM3_Hasher hasher;
+};
+
+template <size_t width>
+void testMultiBufferMerkle(bcos::crypto::merkle::HashRange auto const& inputHashes)
+{
+    static_assert(!bcos::crypto::hasher::MultiBufferHasher<SerialSM3Hasher>);
+    for (auto count = 1lu; count <= RANGES::size(inputHashes); ++count)
+    {
+        std::span<HashType const> hashes(inputHashes.data(), count);
+
+        bcos::crypto::merkle::Merkle<bcos::crypto::hasher::openssl::OpenSSL_SM3_Hasher, width>
+            batchTrie;
+        std::vector<HashType> batchMerkle;
+        batchTrie.generateMerkle(hashes, batchMerkle);
+
+        bcos::crypto::merkle::Merkle<SerialSM3Hasher, width> serialTrie;
+        std::vector<HashType> serialMerkle;
+        serialTrie.generateMerkle(hashes, serialMerkle);
+
+        BOOST_CHECK(batchMerkle == serialMerkle);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(multiBufferMerkle)
+{
+    testMultiBufferMerkle<2>(hashes);
+    testMultiBufferMerkle<3>(hashes);
+    testMultiBufferMerkle<16>(hashes);
+}
+
 template <typename Hasher>
 std::shared_ptr<std::string> calculateRootByMerkleProof(
     const bcos::bytes& _txHash, MerkleProofPtr merkleProof, Hasher& hasher)
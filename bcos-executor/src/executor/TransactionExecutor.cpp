@@ -454,6 +454,8 @@ void TransactionExecutor::nextBlockHeader(int64_t schedulerTermId,
                 prev.storage->setReadOnly(true);
                 stateStorage = createStateStorage(prev.storage);
             }
+            // maintain the state hash while executing, getHash only merges the buckets
+            stateStorage->setHashImpl(m_hashImpl);
 
             if (m_blockContext)
             {
@@ -84,6 +84,7 @@ enum ModuleID
     LIGHTNODE_SEND_TRANSACTION = 4004,
     LIGHTNODE_CALL = 4005,
     LIGHTNODE_GET_ABI = 4006,
+    LIGHTNODE_GET_STATE_PROOF = 4007,
     LIGHTNODE_END = 4999,
 
     SYNC_PUSH_TRANSACTION = 5000,
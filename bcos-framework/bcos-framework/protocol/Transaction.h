@@ -63,6 +63,9 @@ public:
 
     virtual void decode(bytesConstRef _txData) = 0;
     virtual void encode(bcos::bytes& txData) const = 0;
+    // the encoded transaction kept since decoded or first encoded, valid until the transaction is
+    // modified or destroyed
+    virtual bytesConstRef encodedData() const = 0;
     virtual bcos::crypto::HashType hash() const = 0;
 
     virtual void verify(crypto::Hash& hashImpl, crypto::SignatureCrypto& signatureImpl) const
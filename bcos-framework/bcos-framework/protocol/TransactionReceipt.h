@@ -37,6 +37,9 @@ public:
 
     virtual void decode(bytesConstRef _receiptData) = 0;
     virtual void encode(bytes& _encodedData) const = 0;
+    // the encoded receipt kept since decoded or first encoded, valid until the receipt is modified
+    // or destroyed
+    virtual bytesConstRef encodedData() const = 0;
     virtual bcos::crypto::HashType hash() const = 0;
     virtual int32_t version() const = 0;
     virtual u256 gasUsed() const = 0;
@@ -19,6 +19,7 @@
  * @date 2021-05-14
  */
 #pragma once
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
 #include <bcos-utilities/Error.h>
 #include <functional>
 
@@ -47,6 +48,15 @@ public:
     virtual void asyncNoteLatestBlockNumber(int64_t _blockNumber) = 0;
     // interface for the consensus module to notify reset the sealing transactions
     virtual void asyncResetSealing(std::function<void(Error::Ptr)> _onRecvResponse) = 0;
+
+    // (Not required): the time cost(ms) of the scheduler to execute and commit the block, for the
+    // sealer to choose the block size
+    virtual void asyncNoteBlockExecuted(
+        bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost)
+    {}
+    virtual void asyncNoteBlockCommitted(
+        bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost)
+    {}
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
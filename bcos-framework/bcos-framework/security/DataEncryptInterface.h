@@ -45,6 +45,10 @@ public:
     // use to encrypt/decrypt in rocksdb
     virtual std::string encrypt(const std::string& data) = 0;
     virtual std::string decrypt(const std::string& data) = 0;
+
+    // the data key from the key center, also used to encrypt the files of rocksdb
+    virtual std::string const& dataKey() const = 0;
+    virtual bool smCryptoType() const = 0;
 };
 
 }  // namespace security
@@ -140,6 +140,17 @@ public:
 
     virtual void asyncRollback(
         const bcos::protocol::TwoPCParams& params, std::function<void(Error::Ptr)> callback) = 0;
+
+    // write the rows within the block prepared, committed or rolled back together with it, the
+    // rows are written directly if the storage can't do that
+    virtual Error::Ptr prepareRows([[maybe_unused]] const bcos::protocol::TwoPCParams& params,
+        std::string_view table,
+        const std::variant<const gsl::span<std::string_view const>,
+            const gsl::span<std::string const>>& keys,
+        std::variant<gsl::span<std::string_view const>, gsl::span<std::string const>> values)
+    {
+        return setRows(table, keys, std::move(values));
+    }
 };
 
 }  // namespace bcos::storage
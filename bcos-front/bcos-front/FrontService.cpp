@@ -24,8 +24,8 @@
 #include <bcos-front/FrontService.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Exceptions.h>
-#include <boost/uuid/random_generator.hpp>
-#include <boost/uuid/uuid_io.hpp>
+#include <boost/algorithm/hex.hpp>
+#include <boost/endian/conversion.hpp>
 #include <random>
 #include <thread>
 
@@ -34,6 +34,8 @@ using namespace front;
 using namespace protocol;
 
 FrontService::FrontService()
+  : m_sequence(uint64_t(std::random_device{}()) << 32),
+    m_timerWheel(TIMEOUT_TICK_MS, utcSteadyTime())
 {
     m_localProtocol = g_BCOSConfig.protocolInfo(ProtocolModuleID::NodeService);
     FRONT_LOG(INFO) << LOG_DESC("FrontService") << LOG_KV("this", this)
@@ -93,7 +95,13 @@ void FrontService::start()
 
     checkParams();
 
+    m_timeoutTimer = std::make_shared<boost::asio::steady_timer>(*m_ioService);
     m_run = true;
+    // the requests sent before start
+    if (m_timerWheel.size() > 0)
+    {
+        startTimeoutTimer();
+    }
 
     // try to getNodeIDs from gateway
     auto self = std::weak_ptr<FrontService>(shared_from_this());
@@ -159,20 +167,16 @@ void FrontService::stop()
 
     try
     {
+        for (auto& shard : m_callbackShards)
         {
-            Guard guard(x_callback);
-            for (auto& callback : m_callback)
+            Guard guard(shard.x_callback);
+            for (auto& callback : shard.callbacks)
             {
                 FRONT_LOG(INFO) << LOG_DESC("FrontService stopped, erase the callback")
-                                << LOG_KV("uuid", callback.first);
-                // cancel the timer
-                if (callback.second->timeoutHandler)
-                {
-                    callback.second->timeoutHandler->cancel();
-                }
+                                << LOG_KV("uuid", sequenceToID(callback.first));
             }
-            // clear the callback
-            m_callback.clear();
+            // clear the callback, the pending timeouts find nothing
+            shard.callbacks.clear();
         }
 
         if (m_ioService)
@@ -247,35 +251,23 @@ void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDP
 {
     try
     {
-        static thread_local auto uuid_gen =
-            boost::uuids::basic_random_generator<std::random_device>();
-        std::string uuid = boost::uuids::to_string(uuid_gen());
+        auto seq = m_sequence.fetch_add(1);
+        std::string uuid = sequenceToID(seq);
         if (_callbackFunc)
         {
             auto callback = std::make_shared<Callback>();
             callback->callbackFunc = _callbackFunc;
+            callback->nodeID = _nodeID;
+            addCallback(seq, callback);
 
             if (_timeout > 0)
             {
-                // create new timer to handle timeout
-                auto timeoutHandler = std::make_shared<boost::asio::deadline_timer>(
-                    *m_ioService, boost::posix_time::milliseconds(_timeout));
-
-                callback->timeoutHandler = timeoutHandler;
-                auto frontServiceWeakPtr = std::weak_ptr<FrontService>(shared_from_this());
-                // callback->startTime = utcSteadyTime();
-                timeoutHandler->async_wait(
-                    [frontServiceWeakPtr, _nodeID, uuid](const boost::system::error_code& e) {
-                        auto frontService = frontServiceWeakPtr.lock();
-                        if (frontService)
-                        {
-                            frontService->onMessageTimeout(e, _nodeID, uuid);
-                        }
-                    });
+                // the callback is removed when the response arrives, the entry of the wheel then
+                // expires without effect
+                m_timerWheel.add(seq, callback->startTime + _timeout, callback->startTime);
+                startTimeoutTimer();
             }
 
-            addCallback(uuid, callback);
-
             FRONT_LOG(DEBUG) << LOG_DESC("asyncSendMessageByNodeID") << LOG_KV("groupID", m_groupID)
                              << LOG_KV("moduleID", _moduleID) << LOG_KV("uuid", uuid)
                              << LOG_KV("nodeID", _nodeID->hex())
@@ -479,12 +471,6 @@ void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoa
                 });
         }
     };
-    // cancel the timer first
-    if (callback->timeoutHandler)
-    {
-        callback->timeoutHandler->cancel();
-    }
-
     if (m_threadPool)
     {
         // construct shared_ptr<bytes> from message->payload() first for
@@ -631,45 +617,117 @@ void FrontService::sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
         });
 }
 
-/**
- * @brief: handle message timeout
- * @param _error: boost error code
- * @param _uuid: message uuid
- * @return void
- */
-void FrontService::onMessageTimeout(const boost::system::error_code& _error,
-    bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid)
+std::string FrontService::sequenceToID(uint64_t _seq)
+{
+    auto bigEndian = boost::endian::native_to_big(_seq);
+    std::string id;
+    id.reserve(sizeof(_seq) * 2);
+    boost::algorithm::hex_lower((const char*)&bigEndian, (const char*)&bigEndian + sizeof(_seq),
+        std::back_inserter(id));
+    return id;
+}
+
+std::optional<uint64_t> FrontService::idToSequence(std::string_view _id)
 {
-    if (_error)
+    if (_id.size() != sizeof(uint64_t) * 2)
+    {
+        return std::nullopt;
+    }
+    uint64_t seq = 0;
+    for (auto c : _id)
+    {
+        uint64_t digit = 0;
+        if (c >= '0' && c <= '9')
+        {
+            digit = c - '0';
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            digit = c - 'a' + 10;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+        seq = (seq << 4) | digit;
+    }
+    return seq;
+}
+
+void FrontService::startTimeoutTimer()
+{
+    if (!m_timeoutTimer || m_timeoutTimerRunning.exchange(true))
     {
         return;
     }
+    auto self = weak_from_this();
+    m_timeoutTimer->expires_after(std::chrono::milliseconds(TIMEOUT_TICK_MS));
+    m_timeoutTimer->async_wait([self](const boost::system::error_code& _error) {
+        auto front = self.lock();
+        if (front)
+        {
+            front->onTimeoutTimer(_error);
+        }
+    });
+}
+
+void FrontService::onTimeoutTimer(const boost::system::error_code& _error)
+{
+    if (_error || !m_run)
+    {
+        m_timeoutTimerRunning = false;
+        return;
+    }
+    std::vector<uint64_t> expired;
+    m_timerWheel.expire(utcSteadyTime(), expired);
+    for (auto seq : expired)
+    {
+        onMessageTimeout(seq);
+    }
+
+    // keep ticking only while there are pending timeouts
+    m_timeoutTimerRunning = false;
+    if (m_timerWheel.size() > 0)
+    {
+        startTimeoutTimer();
+    }
+}
 
+/**
+ * @brief: handle message timeout
+ * @param _seq: the sequence of the timeout request
+ * @return void
+ */
+void FrontService::onMessageTimeout(uint64_t _seq)
+{
     try
     {
-        Callback::Ptr callback = getAndRemoveCallback(_uuid);
-        if (callback)
+        Callback::Ptr callback = getAndRemoveCallback(_seq);
+        if (!callback)
         {
-            auto errorPtr = std::make_shared<Error>(CommonError::TIMEOUT, "timeout");
-            if (m_threadPool)
-            {
-                m_threadPool->enqueue([_uuid, _nodeID, callback, errorPtr]() {
-                    callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), _uuid,
-                        std::function<void(bytesConstRef)>());
-                });
-            }
-            else
-            {
-                callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), _uuid,
+            // responded already
+            return;
+        }
+        auto uuid = sequenceToID(_seq);
+        auto errorPtr = std::make_shared<Error>(CommonError::TIMEOUT, "timeout");
+        if (m_threadPool)
+        {
+            m_threadPool->enqueue([uuid, callback, errorPtr]() {
+                callback->callbackFunc(errorPtr, callback->nodeID, bytesConstRef(), uuid,
                     std::function<void(bytesConstRef)>());
-            }
+            });
+        }
+        else
+        {
+            callback->callbackFunc(errorPtr, callback->nodeID, bytesConstRef(), uuid,
+                std::function<void(bytesConstRef)>());
         }
 
-        FRONT_LOG(WARNING) << LOG_BADGE("onMessageTimeout") << LOG_KV("uuid", _uuid);
+        FRONT_LOG(WARNING) << LOG_BADGE("onMessageTimeout") << LOG_KV("uuid", uuid);
     }
     catch (std::exception& e)
     {
-        FRONT_LOG(ERROR) << "onMessageTimeout" << LOG_KV("uuid", _uuid)
+        FRONT_LOG(ERROR) << "onMessageTimeout" << LOG_KV("seq", _seq)
                          << LOG_KV("error", boost::diagnostic_information(e));
     }
 }
@@ -25,7 +25,10 @@
 #include <bcos-framework/gateway/GroupNodeInfo.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/ThreadPool.h>
+#include <bcos-utilities/TimerWheel.h>
 #include <boost/asio.hpp>
+#include <array>
+#include <optional>
 #include <utility>
 
 namespace bcos
@@ -149,12 +152,10 @@ public:
 
     /**
      * @brief: handle message timeout
-     * @param _error: boost error code
-     * @param _uuid: message uuid
+     * @param _seq: the sequence of the timeout request
      * @return void
      */
-    void onMessageTimeout(const boost::system::error_code& _error, bcos::crypto::NodeIDPtr _nodeID,
-        const std::string& _uuid);
+    void onMessageTimeout(uint64_t _seq);
 
 public:
     FrontMessageFactory::Ptr messageFactory() const { return m_messageFactory; }
@@ -223,39 +224,61 @@ public:
         using Ptr = std::shared_ptr<Callback>;
         uint64_t startTime = utcSteadyTime();
         CallbackFunc callbackFunc;
-        std::shared_ptr<boost::asio::deadline_timer> timeoutHandler;
+        bcos::crypto::NodeIDPtr nodeID;
     };
-    // lock m_callback
-    mutable bcos::Mutex x_callback;
-    // uuid to callback
-    std::unordered_map<std::string, Callback::Ptr> m_callback;
 
     // only for ut
-    std::unordered_map<std::string, Callback::Ptr> callback() const { return m_callback; }
-
-    Callback::Ptr getAndRemoveCallback(const std::string& _uuid)
+    std::unordered_map<std::string, Callback::Ptr> callback() const
     {
-        Callback::Ptr callback = nullptr;
-
+        std::unordered_map<std::string, Callback::Ptr> callbacks;
+        for (auto const& shard : m_callbackShards)
         {
-            Guard guard(x_callback);
-            auto it = m_callback.find(_uuid);
-            if (it != m_callback.end())
+            Guard guard(shard.x_callback);
+            for (auto const& it : shard.callbacks)
             {
-                callback = it->second;
-                m_callback.erase(it);
+                callbacks.emplace(sequenceToID(it.first), it.second);
             }
         }
+        return callbacks;
+    }
 
+    Callback::Ptr getAndRemoveCallback(uint64_t _seq)
+    {
+        auto& shard = m_callbackShards[_seq % CALLBACK_SHARDS];
+        Guard guard(shard.x_callback);
+        auto it = shard.callbacks.find(_seq);
+        if (it == shard.callbacks.end())
+        {
+            return nullptr;
+        }
+        auto callback = std::move(it->second);
+        shard.callbacks.erase(it);
         return callback;
     }
 
-    void addCallback(const std::string& _uuid, Callback::Ptr _callback)
+    Callback::Ptr getAndRemoveCallback(const std::string& _uuid)
+    {
+        auto seq = idToSequence(_uuid);
+        if (!seq)
+        {
+            return nullptr;
+        }
+        return getAndRemoveCallback(*seq);
+    }
+
+    void addCallback(uint64_t _seq, Callback::Ptr _callback)
     {
-        Guard guard(x_callback);
-        m_callback[_uuid] = _callback;
+        auto& shard = m_callbackShards[_seq % CALLBACK_SHARDS];
+        Guard guard(shard.x_callback);
+        shard.callbacks[_seq] = std::move(_callback);
     }
 
+    // the request ids are 64-bit sequences carried as 16 hex characters in the uuid field of the
+    // message, the peers (including the ones still using random uuids) echo them back unchanged
+    static std::string sequenceToID(uint64_t _seq);
+    // nullopt if _id is not a sequence generated by sequenceToID
+    static std::optional<uint64_t> idToSequence(std::string_view _id);
+
 protected:
     virtual void handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoad,
         std::string const& _uuid, int _moduleID, bcos::crypto::NodeIDPtr _nodeID);
@@ -264,7 +287,32 @@ protected:
 
     virtual void protocolNegotiate(bcos::gateway::GroupNodeInfo::Ptr _groupNodeInfo);
 
+    // arm the timer driving m_timerWheel if it is not running
+    void startTimeoutTimer();
+    void onTimeoutTimer(const boost::system::error_code& _error);
+
 private:
+    constexpr static size_t CALLBACK_SHARDS = 16;
+    // the resolution of the request timeouts, in milliseconds
+    constexpr static uint64_t TIMEOUT_TICK_MS = 10;
+
+    struct CallbackShard
+    {
+        mutable bcos::Mutex x_callback;
+        // sequence to callback
+        std::unordered_map<uint64_t, Callback::Ptr> callbacks;
+    };
+    // the consecutive sequences are spread round-robin over the shards
+    std::array<CallbackShard, CALLBACK_SHARDS> m_callbackShards;
+    // the next request sequence, starts from a random epoch in the high 32 bits so that the late
+    // responses to the requests sent before a restart never match
+    std::atomic<uint64_t> m_sequence;
+
+    // the timeouts of all requests, driven by a single timer on m_ioService
+    bcos::TimerWheel m_timerWheel;
+    std::shared_ptr<boost::asio::steady_timer> m_timeoutTimer;
+    std::atomic_bool m_timeoutTimerRunning = {false};
+
     // thread pool
     bcos::ThreadPool::Ptr m_threadPool;
     // timer
@@ -320,4 +320,32 @@ BOOST_AUTO_TEST_CASE(testFrontService_loopTimeout)
     BOOST_CHECK(frontService->callback().empty());
 }
 
+BOOST_AUTO_TEST_CASE(testFrontService_sequenceID)
+{
+    for (uint64_t seq : {uint64_t(0), uint64_t(0x1234abcd00000001), UINT64_MAX})
+    {
+        auto id = FrontService::sequenceToID(seq);
+        BOOST_CHECK_EQUAL(id.size(), 16);
+        BOOST_CHECK_EQUAL(FrontService::idToSequence(id).value(), seq);
+    }
+    // the random uuids of the old peers never match a sequence
+    BOOST_CHECK(!FrontService::idToSequence("5d2c0a3e-9a3f-4c1e-8d7b-1f2e3d4c5b6a"));
+    BOOST_CHECK(!FrontService::idToSequence("5d2c0a3e-9a3f-4c"));
+    BOOST_CHECK(!FrontService::idToSequence(""));
+
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    frontService->asyncSendMessageByNodeID(12345, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 0,
+        [](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+            std::function<void(bytesConstRef)>) {});
+    auto uuid = frontService->callback().begin()->first;
+    BOOST_CHECK(FrontService::idToSequence(uuid));
+    // the response carrying another id is ignored
+    BOOST_CHECK(!frontService->getAndRemoveCallback("5d2c0a3e-9a3f-4c1e-8d7b-1f2e3d4c5b6a"));
+    BOOST_CHECK(frontService->getAndRemoveCallback(uuid));
+    BOOST_CHECK(frontService->callback().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -395,6 +395,16 @@ void GatewayConfig::initRateLimitConfig(const boost::property_tree::ptree& _pt)
     ;   group_outgoing_bw_limit_group0=2
     ;   group_outgoing_bw_limit_group1=2
     ;   group_outgoing_bw_limit_group2=2
+    ;
+    ; specify module to limit bandwidth in every group, module_outgoing_bw_limit_moduleName=n
+    ;   module_outgoing_bw_limit_block_sync=1
+    ;
+    ; the over-quota messages of the group are delayed by the weights of the modules instead of
+    ; being rejected, module_weight_moduleName=n, default 1
+    ;   module_weight_pbft=4
+    ;
+    ; the longest delay of the over-quota messages, unit: ms, 0 means reject directly
+    ; max_outgoing_delay=200
     */
 
     // enable_distributed_ratelimit=false
@@ -406,6 +416,8 @@ void GatewayConfig::initRateLimitConfig(const boost::property_tree::ptree& _pt)
     // enable_distributed_ratelimit=false
     int32_t distributedRateLimitCachePercent =
         _pt.get<int32_t>("flow_control.distributed_ratelimit_cache_percent", 20);
+    // max_outgoing_delay=200
+    int32_t maxOutgoingDelay = _pt.get<int32_t>("flow_control.max_outgoing_delay", 200);
     // stat_reporter_interval=60000
     int32_t statInterval = _pt.get<int32_t>("flow_control.stat_reporter_interval", 60000);
 
@@ -413,6 +425,20 @@ void GatewayConfig::initRateLimitConfig(const boost::property_tree::ptree& _pt)
     std::string strModulesWithoutLimit =
         _pt.get<std::string>("flow_control.modules_without_bw_limit", "raft,pbft,cons_txs_sync");
 
+    auto toModuleID = [](std::string _module) -> uint16_t {
+        boost::trim(_module);
+        boost::algorithm::to_lower(_module);
+        auto optModuleID = protocol::stringToModuleID(_module);
+        if (!optModuleID.has_value())
+        {
+            BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment(
+                                      "unrecognized module: " + _module +
+                                      " ,list of available modules: "
+                                      "raft,pbft,amop,block_sync,txs_sync,light_node"));
+        }
+        return optModuleID.value();
+    };
+
     std::set<uint16_t> moduleIDs;
     std::vector<std::string> modules;
 
@@ -421,19 +447,9 @@ void GatewayConfig::initRateLimitConfig(const boost::property_tree::ptree& _pt)
         boost::split(
             modules, strModulesWithoutLimit, boost::is_any_of(","), boost::token_compress_on);
 
-        for (auto module : modules)
+        for (auto const& module : modules)
         {
-            boost::trim(module);
-            boost::algorithm::to_lower(module);
-            auto optModuleID = protocol::stringToModuleID(module);
-            if (!optModuleID.has_value())
-            {
-                BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment(
-                                          "unrecognized module: " + module +
-                                          " ,list of available modules: "
-                                          "raft,pbft,amop,block_sync,txs_sync,light_node"));
-            }
-            moduleIDs.insert(optModuleID.value());
+            moduleIDs.insert(toModuleID(module));
         }
     }
 
@@ -535,11 +551,38 @@ void GatewayConfig::initRateLimitConfig(const boost::property_tree::ptree& _pt)
                 GATEWAY_CONFIG_LOG(INFO)
                     << LOG_BADGE("initRateLimiterConfig") << LOG_DESC("add group bandwidth limit")
                     << LOG_KV("group", group) << LOG_KV("bandwidth", bw);
+            }  // module_outgoing_bw_limit_block_sync
+            else if (boost::starts_with(key, "module_outgoing_bw_limit_"))
+            {
+                auto moduleID = toModuleID(key.substr(strlen("module_outgoing_bw_limit_")));
+                auto bw = boost::lexical_cast<double>(value);
+                m_rateLimiterConfig.module2BwLimit[moduleID] = doubleMBToBit(bw);
+
+                GATEWAY_CONFIG_LOG(INFO)
+                    << LOG_BADGE("initRateLimiterConfig") << LOG_DESC("add module bandwidth limit")
+                    << LOG_KV("moduleID", moduleID) << LOG_KV("bandwidth", bw);
+            }  // module_weight_pbft
+            else if (boost::starts_with(key, "module_weight_"))
+            {
+                auto moduleID = toModuleID(key.substr(strlen("module_weight_")));
+                auto weight = boost::lexical_cast<uint32_t>(value);
+                if (weight == 0)
+                {
+                    BOOST_THROW_EXCEPTION(
+                        InvalidParameter() << errinfo_comment(
+                            "flow_control.module_weight_xxx config, the weight should be positive"));
+                }
+                m_rateLimiterConfig.module2Weight[moduleID] = weight;
+
+                GATEWAY_CONFIG_LOG(INFO)
+                    << LOG_BADGE("initRateLimiterConfig") << LOG_DESC("add module weight")
+                    << LOG_KV("moduleID", moduleID) << LOG_KV("weight", weight);
             }
         }
     }
 
     m_rateLimiterConfig.statInterval = statInterval;
+    m_rateLimiterConfig.maxOutgoingDelay = maxOutgoingDelay;
     m_rateLimiterConfig.modulesWithoutLimit = moduleIDs;
     m_rateLimiterConfig.totalOutgoingBwLimit = totalOutgoingBwLimit;
     m_rateLimiterConfig.connOutgoingBwLimit = connOutgoingBwLimit;
@@ -581,7 +624,9 @@ void GatewayConfig::initRateLimitConfig(const boost::property_tree::ptree& _pt)
                              << LOG_KV("groupOutgoingBwLimit", groupOutgoingBwLimit)
                              << LOG_KV("moduleIDs", boost::join(modules, ","))
                              << LOG_KV("ips size", m_rateLimiterConfig.ip2BwLimit.size())
-                             << LOG_KV("groups size", m_rateLimiterConfig.group2BwLimit.size());
+                             << LOG_KV("groups size", m_rateLimiterConfig.group2BwLimit.size())
+                             << LOG_KV("modules size", m_rateLimiterConfig.module2BwLimit.size())
+                             << LOG_KV("maxOutgoingDelay", maxOutgoingDelay);
 
     if (m_rateLimiterConfig.enableDistributedRatelimit)
     {
@@ -87,6 +87,12 @@ public:
         int64_t groupOutgoingBwLimit = -1;
         // specify group bandwidth limiting
         std::unordered_map<std::string, int64_t> group2BwLimit;
+        // specify module bandwidth limiting, applies to the module in every group
+        std::unordered_map<uint16_t, int64_t> module2BwLimit;
+        // the weight of the module when the over-quota messages of a group are delayed, default 1
+        std::unordered_map<uint16_t, uint32_t> module2Weight;
+        // the longest delay of the over-quota group messages, unit: ms, rejected directly if <= 0
+        int32_t maxOutgoingDelay = 200;
 
         // the message of modules that do not limit bandwidth
         std::set<uint16_t> modulesWithoutLimit;
@@ -99,7 +105,7 @@ public:
                 return true;
             }
 
-            if (!group2BwLimit.empty() || !ip2BwLimit.empty())
+            if (!group2BwLimit.empty() || !ip2BwLimit.empty() || !module2BwLimit.empty())
             {
                 return true;
             }
@@ -689,7 +689,8 @@ std::shared_ptr<Gateway> GatewayFactory::buildGateway(GatewayConfig::Ptr _config
             });
 
         service->setBeforeMessageHandler([gatewayRateLimiterWeakPtr](SessionFace::Ptr _session,
-                                             Message::Ptr _msg, SessionCallbackFunc _callback) {
+                                             Message::Ptr _msg, SessionCallbackFunc _callback,
+                                             uint64_t& _sendTime) {
             auto gatewayRateLimiter = gatewayRateLimiterWeakPtr.lock();
             if (!gatewayRateLimiter)
             {
@@ -709,7 +710,8 @@ std::shared_ptr<Gateway> GatewayFactory::buildGateway(GatewayConfig::Ptr _config
             uint64_t msgLength = _msg->length();
 
             // bandwidth limit check
-            auto r = gatewayRateLimiter->checkOutGoing(endpoint, groupID, moduleID, msgLength);
+            auto r = gatewayRateLimiter->checkOutGoing(
+                endpoint, groupID, moduleID, msgLength, _sendTime);
             if (!r.first && _callback)
             {
                 _callback(NetworkException(BandwidthOverFlow, r.second), Message::Ptr());
@@ -22,6 +22,8 @@
 #include <bcos-gateway/libamop/AMOPMessage.h>
 #include <bcos-gateway/libnetwork/Common.h>
 #include <boost/bind/bind.hpp>
+#include <charconv>
+#include <optional>
 using namespace bcos;
 using namespace bcos::gateway;
 using namespace bcos::amop;
@@ -73,17 +75,28 @@ void AMOPImpl::onReceiveTopicSeqMessage(P2pID const& _nodeID, AMOPMessage::Ptr _
 {
     try
     {
-        uint32_t topicSeq =
-            boost::lexical_cast<uint32_t>(std::string(_msg->data().begin(), _msg->data().end()));
+        uint32_t topicSeq = 0;
+        auto data = _msg->data();
+        auto result = std::from_chars(
+            (const char*)data.data(), (const char*)data.data() + data.size(), topicSeq);
+        if (result.ec != std::errc())
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("invalid topicSeq"));
+        }
         if (!m_topicManager->checkTopicSeq(_nodeID, topicSeq))
         {
             return;
         }
+        // carry the topicSeq known locally to fetch the changes only, the nodes before the delta
+        // sync ignore it and respond all topics
+        auto request = m_topicManager->requestTopicsJson(_nodeID);
         AMOP_LOG(INFO) << LOG_BADGE(
                               "onReceiveTopicSeqMessage: try to request latest AMOP information")
-                       << LOG_KV("nodeID", _nodeID) << LOG_KV("topicSeq", topicSeq);
+                       << LOG_KV("nodeID", _nodeID) << LOG_KV("topicSeq", topicSeq)
+                       << LOG_KV("delta", !request.empty());
 
-        auto buffer = buildAndEncodeMessage(AMOPMessage::Type::RequestTopic, bytesConstRef());
+        auto buffer = buildAndEncodeMessage(AMOPMessage::Type::RequestTopic,
+            bytesConstRef((byte*)request.data(), request.size()));
         Options option(0);
         m_network->asyncSendMessageByP2PNodeID(GatewayMessageType::AMOPMessageType, _nodeID,
             bytesConstRef(buffer->data(), buffer->size()), option,
@@ -127,12 +140,13 @@ void AMOPImpl::onReceiveResponseTopicMessage(P2pID const& _nodeID, AMOPMessage::
 {
     try
     {
+        uint64_t topicEpoch;
         uint32_t topicSeq;
         TopicItems topicItems;
         std::string topicJson = std::string(_msg->data().begin(), _msg->data().end());
-        if (m_topicManager->parseTopicItemsJson(topicSeq, topicItems, topicJson))
+        if (m_topicManager->parseTopicItemsJson(topicEpoch, topicSeq, topicItems, topicJson))
         {
-            m_topicManager->updateSeqAndTopicsByNodeID(_nodeID, topicSeq, topicItems);
+            m_topicManager->updateSeqAndTopicsByNodeID(_nodeID, topicSeq, topicItems, topicEpoch);
         }
     }
     catch (const std::exception& e)
@@ -142,20 +156,47 @@ void AMOPImpl::onReceiveResponseTopicMessage(P2pID const& _nodeID, AMOPMessage::
     }
 }
 
+// receive the topic changes and update the local topicManager
+void AMOPImpl::onReceiveResponseTopicDeltaMessage(P2pID const& _nodeID, AMOPMessage::Ptr _msg)
+{
+    try
+    {
+        TopicsDelta delta;
+        std::string deltaJson = std::string(_msg->data().begin(), _msg->data().end());
+        if (m_topicManager->parseTopicsDeltaJson(deltaJson, delta))
+        {
+            m_topicManager->applyTopicsDeltaByNodeID(_nodeID, delta);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        AMOP_LOG(ERROR) << LOG_BADGE("onReceiveResponseTopicDeltaMessage")
+                        << LOG_KV("nodeID", _nodeID)
+                        << LOG_KV("error", boost::diagnostic_information(e));
+    }
+}
+
 // response topic message to the given node
 void AMOPImpl::onReceiveRequestTopicMessage(P2pID const& _nodeID, AMOPMessage::Ptr _msg)
 {
-    (void)_msg;
     try
     {
-        // the current node subscribed topic info
-        std::string topicJson = m_topicManager->queryTopicsSubByClient();
+        // the changes since the topicSeq known by the node, or all topics subscribed by the
+        // clients of the current node
+        auto type = AMOPMessage::Type::ResponseTopicDelta;
+        std::string topicJson = m_topicManager->queryTopicsDeltaByRequest(
+            std::string(_msg->data().begin(), _msg->data().end()));
+        if (topicJson.empty())
+        {
+            type = AMOPMessage::Type::ResponseTopic;
+            topicJson = m_topicManager->queryTopicsSubByClient();
+        }
 
         AMOP_LOG(INFO) << LOG_BADGE("onReceiveRequestTopicMessage") << LOG_KV("nodeID", _nodeID)
-                       << LOG_KV("topicJson", topicJson);
+                       << LOG_KV("type", type) << LOG_KV("topicJson", topicJson);
 
-        auto buffer = buildAndEncodeMessage(AMOPMessage::Type::ResponseTopic,
-            bytesConstRef((byte*)topicJson.data(), topicJson.size()));
+        auto buffer =
+            buildAndEncodeMessage(type, bytesConstRef((byte*)topicJson.data(), topicJson.size()));
         Options option(0);
         m_network->asyncSendMessageByP2PNodeID(GatewayMessageType::AMOPMessageType, _nodeID,
             bytesConstRef(buffer->data(), buffer->size()), option,
@@ -257,6 +298,8 @@ void AMOPImpl::onReceiveAMOPBroadcastMessage(P2pID const& _nodeID, AMOPMessage::
                           << LOG_KV("from", _nodeID);
         return;
     }
+    // the request pushed to the clients is built once and shared by all of them
+    std::optional<std::vector<tars::Char>> sharedRequest;
     for (const auto& client : clients)
     {
         auto clientService = m_topicManager->createAndGetServiceByClient(client);
@@ -267,17 +310,28 @@ void AMOPImpl::onReceiveAMOPBroadcastMessage(P2pID const& _nodeID, AMOPMessage::
         AMOP_LOG(DEBUG) << LOG_BADGE("onRecvAMOPBroadcastMessage")
                         << LOG_DESC("push message to client") << LOG_KV("topic", topic)
                         << LOG_KV("client", client);
-        clientService->asyncNotifyAMOPMessage(bcos::rpc::AMOPNotifyMessageType::Broadcast, topic,
-            _msg->data(), [client](Error::Ptr&& _error, bytesPointer) {
-                if (_error)
-                {
-                    AMOP_LOG(WARNING)
-                        << LOG_BADGE("onRecvAMOPBroadcastMessage")
-                        << LOG_DESC("asyncNotifyAMOPMessage error") << LOG_KV("client", client)
-                        << LOG_KV("code", _error->errorCode())
-                        << LOG_KV("msg", _error->errorMessage());
-                }
-            });
+        auto callback = [client](Error::Ptr&& _error, bytesPointer) {
+            if (_error)
+            {
+                AMOP_LOG(WARNING) << LOG_BADGE("onRecvAMOPBroadcastMessage")
+                                  << LOG_DESC("asyncNotifyAMOPMessage error")
+                                  << LOG_KV("client", client) << LOG_KV("code", _error->errorCode())
+                                  << LOG_KV("msg", _error->errorMessage());
+            }
+        };
+        auto tarsClient = std::dynamic_pointer_cast<bcostars::RpcServiceClient>(clientService);
+        if (!tarsClient)
+        {
+            clientService->asyncNotifyAMOPMessage(bcos::rpc::AMOPNotifyMessageType::Broadcast,
+                topic, _msg->data(), std::move(callback));
+            continue;
+        }
+        if (!sharedRequest)
+        {
+            sharedRequest.emplace(_msg->data().begin(), _msg->data().end());
+        }
+        tarsClient->asyncNotifyAMOPMessage(bcos::rpc::AMOPNotifyMessageType::Broadcast, topic,
+            *sharedRequest, std::move(callback));
     }
     AMOP_LOG(DEBUG) << LOG_DESC("onReceiveAMOPBroadcastMessage") << LOG_KV("nodeID", _nodeID);
 }
@@ -358,11 +412,12 @@ void AMOPImpl::asyncSendMessageByTopic(const std::string& _topic, bcos::bytesCon
 
                 return;
             }
-            auto choosedNodeID = randomChoose(m_nodeIDs);
+            auto index = randomIndex(m_nodeIDs.size());
+            auto choosedNodeID = m_nodeIDs[index];
             AMOP_LOG(INFO) << LOG_DESC("asyncSendMessageByTopic")
                            << LOG_KV("choosedNodeID", choosedNodeID);
             // erase in case of select the same node when retry
-            m_nodeIDs.erase(m_nodeIDs.begin());
+            m_nodeIDs.erase(m_nodeIDs.begin() + index);
             // try to send message to node
             Options option(0);
             auto self = shared_from_this();
@@ -526,6 +581,9 @@ void AMOPImpl::dispatcherAMOPMessage(
     case AMOPMessage::Type::ResponseTopic:
         onReceiveResponseTopicMessage(fromNodeID, amopMessage);
         break;
+    case AMOPMessage::Type::ResponseTopicDelta:
+        onReceiveResponseTopicDeltaMessage(fromNodeID, amopMessage);
+        break;
     case AMOPMessage::Type::AMOPRequest:
         onReceiveAMOPMessage(fromNodeID, amopMessage,
             [this, _session, _message](bytesPointer _responseData, int16_t _type) {
@@ -113,6 +113,15 @@ protected:
     virtual void onReceiveResponseTopicMessage(
         bcos::gateway::P2pID const& _nodeID, AMOPMessage::Ptr _msg);
 
+    /**
+     * @brief: receive the topic changes from other nodes
+     * @param _nodeID: the sender nodeID
+     * @param _msg: message
+     * @return void
+     */
+    virtual void onReceiveResponseTopicDeltaMessage(
+        bcos::gateway::P2pID const& _nodeID, AMOPMessage::Ptr _msg);
+
     /**
      * @brief: receive amop message
      * @param _nodeID: the sender nodeID
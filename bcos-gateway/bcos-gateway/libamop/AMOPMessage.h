@@ -34,7 +34,9 @@ public:
         ResponseTopic = 0x3,
         AMOPRequest = 0x4,
         AMOPResponse = 0x5,
-        AMOPBroadcast = 0x5
+        AMOPBroadcast = 0x5,
+        // the topics changed since the topicSeq of the RequestTopic
+        ResponseTopicDelta = 0x6
     };
     /// type(2) + status(2) + version(2)
     const static size_t HEADER_LENGTH = 6;
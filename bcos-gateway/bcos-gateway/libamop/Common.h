@@ -57,12 +57,16 @@ inline bool operator<(const TopicItem& _topicItem0, const TopicItem& _topicItem1
 }
 using TopicItems = std::set<TopicItem>;
 
-inline std::string randomChoose(std::vector<std::string> _datas)
+inline size_t randomIndex(size_t _size)
 {
-    auto seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::default_random_engine e(seed);
-    std::shuffle(_datas.begin(), _datas.end(), e);
-    return *(_datas.begin());
+    thread_local std::default_random_engine e(
+        std::chrono::system_clock::now().time_since_epoch().count());
+    return std::uniform_int_distribution<size_t>(0, _size - 1)(e);
+}
+
+inline std::string randomChoose(std::vector<std::string> const& _datas)
+{
+    return _datas[randomIndex(_datas.size())];
 }
 
 inline std::string shortHex(std::string const& _nodeID)
@@ -26,6 +26,7 @@
 #include <json/json.h>
 #include <servant/Application.h>
 #include <algorithm>
+#include <map>
 #include <memory>
 
 using namespace bcos;
@@ -103,8 +104,23 @@ void TopicManager::subTopic(const std::string& _client, const TopicItems& _topic
 {
     {
         std::unique_lock lock(x_clientTopics);
-        m_client2TopicItems[_client] = _topicItems;  // Override the previous value
-        incTopicSeq();
+        auto& topicItems = m_client2TopicItems[_client];
+        auto seq = incTopicSeq();
+        for (auto const& topicItem : topicItems)
+        {
+            if (!_topicItems.count(topicItem))
+            {
+                unsubscribeTopic(_client, topicItem.topicName(), seq);
+            }
+        }
+        for (auto const& topicItem : _topicItems)
+        {
+            if (!topicItems.count(topicItem))
+            {
+                subscribeTopic(_client, topicItem.topicName(), seq);
+            }
+        }
+        topicItems = _topicItems;  // Override the previous value
     }
     createAndGetServiceByClient(_client);
     TOPIC_LOG(INFO) << LOG_BADGE("subTopic") << LOG_KV("client", _client)
@@ -112,6 +128,42 @@ void TopicManager::subTopic(const std::string& _client, const TopicItems& _topic
                     << LOG_KV("topicItems size", _topicItems.size());
 }
 
+void TopicManager::subscribeTopic(
+    const std::string& _client, const std::string& _topic, uint32_t _topicSeq)
+{
+    m_clientTopicTrie.insert(_topic, _client);
+    if (m_topicRefCount[_topic]++ == 0)
+    {
+        recordTopicChange(_topicSeq, _topic, true);
+    }
+}
+
+void TopicManager::unsubscribeTopic(
+    const std::string& _client, const std::string& _topic, uint32_t _topicSeq)
+{
+    m_clientTopicTrie.erase(_topic, _client);
+    auto it = m_topicRefCount.find(_topic);
+    if (it == m_topicRefCount.end())
+    {
+        return;
+    }
+    if (--it->second == 0)
+    {
+        m_topicRefCount.erase(it);
+        recordTopicChange(_topicSeq, _topic, false);
+    }
+}
+
+void TopicManager::recordTopicChange(uint32_t _topicSeq, const std::string& _topic, bool _subscribed)
+{
+    m_topicChanges.push_back(TopicChange{_topicSeq, _topic, _subscribed});
+    while (m_topicChanges.size() > MAX_TOPIC_CHANGES)
+    {
+        m_topicChangesBaseSeq = m_topicChanges.front().topicSeq;
+        m_topicChanges.pop_front();
+    }
+}
+
 /**
  * @brief: query topics sub by client
  * @param _clientID: client identify, to be defined
@@ -150,20 +202,21 @@ void TopicManager::removeTopics(
     }
     {
         std::unique_lock lock(x_clientTopics);
-        if (!m_client2TopicItems.count(_client))
+        auto it = m_client2TopicItems.find(_client);
+        if (it == m_client2TopicItems.end())
         {
             return;
         }
+        auto seq = incTopicSeq();
         for (auto const& topic : _topicList)
         {
-            if (m_client2TopicItems[_client].count(topic))
+            if (it->second.erase(topic))
             {
-                m_client2TopicItems[_client].erase(topic);
+                unsubscribeTopic(_client, topic, seq);
             }
             TOPIC_LOG(INFO) << LOG_BADGE("removeTopics") << LOG_KV("client", _client)
                             << LOG_KV("topicSeq", topicSeq()) << LOG_KV("topic", topic);
         }
-        incTopicSeq();
     }
 }
 
@@ -172,12 +225,19 @@ void TopicManager::removeTopicsByClient(const std::string& _client)
     std::size_t result = 0;
     {
         std::unique_lock lock(x_clientTopics);
-
-        result = m_client2TopicItems.erase(_client);
+        auto seq = incTopicSeq();
+        auto it = m_client2TopicItems.find(_client);
+        if (it != m_client2TopicItems.end())
+        {
+            for (auto const& topicItem : it->second)
+            {
+                unsubscribeTopic(_client, topicItem.topicName(), seq);
+            }
+            m_client2TopicItems.erase(it);
+            result = 1;
+        }
     }
 
-    incTopicSeq();
-
     TOPIC_LOG(INFO) << LOG_BADGE("removeTopicsByClient") << LOG_KV("client", _client)
                     << LOG_KV("success", result);
 }
@@ -191,24 +251,19 @@ std::string TopicManager::queryTopicsSubByClient()
     try
     {
         uint32_t seq;
-        TopicItems topicItems;
+        Json::Value jTopics = Json::Value(Json::arrayValue);
         {
             std::shared_lock lock(x_clientTopics);
             seq = topicSeq();
-            for (const auto& m : m_client2TopicItems)
+            for (const auto& it : m_topicRefCount)
             {
-                topicItems.insert(m.second.begin(), m.second.end());
+                jTopics.append(it.first);
             }
         }
 
-        Json::Value jTopics = Json::Value(Json::arrayValue);
-        for (const auto& topicItem : topicItems)
-        {
-            jTopics.append(topicItem.topicName());
-        }
-
         Json::Value jResp;
         jResp["topicSeq"] = seq;
+        jResp["topicEpoch"] = Json::UInt64(m_topicEpoch);
         jResp["topicItems"] = jTopics;
 
         Json::FastWriter writer;
@@ -235,6 +290,13 @@ std::string TopicManager::queryTopicsSubByClient()
  */
 bool TopicManager::parseTopicItemsJson(
     uint32_t& _topicSeq, TopicItems& _topicItems, const std::string& _json)
+{
+    uint64_t topicEpoch = 0;
+    return parseTopicItemsJson(topicEpoch, _topicSeq, _topicItems, _json);
+}
+
+bool TopicManager::parseTopicItemsJson(uint64_t& _topicEpoch, uint32_t& _topicSeq,
+    TopicItems& _topicItems, const std::string& _json)
 {
     Json::Value root;
     Json::Reader jsonReader;
@@ -262,6 +324,8 @@ bool TopicManager::parseTopicItemsJson(
 
         _topicSeq = topicSeq;
         _topicItems = topicItems;
+        // the nodes before the delta sync send no epoch
+        _topicEpoch = root.isMember("topicEpoch") ? root["topicEpoch"].asUInt64() : 0;
 
         TOPIC_LOG(INFO) << LOG_BADGE("parseTopicItemsJson") << LOG_KV("topicSeq", topicSeq)
                         << LOG_KV("topicItems size", topicItems.size()) << LOG_KV("json", _json);
@@ -293,6 +357,164 @@ bool TopicManager::checkTopicSeq(P2pID const& _nodeID, uint32_t _topicSeq)
     return true;
 }
 
+std::string TopicManager::requestTopicsJson(P2pID const& _nodeID)
+{
+    Json::Value request;
+    {
+        std::shared_lock lock(x_topics);
+        auto seqIt = m_nodeID2TopicSeq.find(_nodeID);
+        auto epochIt = m_nodeID2TopicEpoch.find(_nodeID);
+        if (seqIt == m_nodeID2TopicSeq.end() || epochIt == m_nodeID2TopicEpoch.end() ||
+            epochIt->second == 0)
+        {
+            return "";
+        }
+        request["topicEpoch"] = Json::UInt64(epochIt->second);
+        request["topicSeq"] = seqIt->second;
+    }
+    Json::FastWriter writer;
+    return writer.write(request);
+}
+
+std::string TopicManager::queryTopicsDeltaByRequest(const std::string& _requestJson)
+{
+    try
+    {
+        Json::Value request;
+        Json::Reader jsonReader;
+        if (_requestJson.empty() || !jsonReader.parse(_requestJson, request) ||
+            !request.isMember("topicEpoch") || !request.isMember("topicSeq"))
+        {
+            return "";
+        }
+        auto epoch = request["topicEpoch"].asUInt64();
+        auto fromSeq = request["topicSeq"].asUInt();
+
+        // the last change of every topic since fromSeq
+        std::map<std::string, bool> changes;
+        uint32_t seq = 0;
+        {
+            std::shared_lock lock(x_clientTopics);
+            seq = topicSeq();
+            if (epoch != m_topicEpoch || fromSeq < m_topicChangesBaseSeq || fromSeq > seq)
+            {
+                return "";
+            }
+            auto it = std::upper_bound(m_topicChanges.begin(), m_topicChanges.end(), fromSeq,
+                [](uint32_t _seq, TopicChange const& _change) { return _seq < _change.topicSeq; });
+            for (; it != m_topicChanges.end(); ++it)
+            {
+                changes[it->topic] = it->subscribed;
+            }
+        }
+
+        Json::Value delta;
+        delta["topicEpoch"] = Json::UInt64(epoch);
+        delta["fromSeq"] = fromSeq;
+        delta["topicSeq"] = seq;
+        delta["subscribed"] = Json::Value(Json::arrayValue);
+        delta["unsubscribed"] = Json::Value(Json::arrayValue);
+        for (auto const& [topic, subscribed] : changes)
+        {
+            delta[subscribed ? "subscribed" : "unsubscribed"].append(topic);
+        }
+        Json::FastWriter writer;
+        return writer.write(delta);
+    }
+    catch (const std::exception& e)
+    {
+        TOPIC_LOG(WARNING) << LOG_BADGE("queryTopicsDeltaByRequest")
+                           << LOG_KV("error", boost::diagnostic_information(e))
+                           << LOG_KV("request", _requestJson);
+        return "";
+    }
+}
+
+bool TopicManager::parseTopicsDeltaJson(const std::string& _json, TopicsDelta& _delta)
+{
+    try
+    {
+        Json::Value root;
+        Json::Reader jsonReader;
+        if (!jsonReader.parse(_json, root))
+        {
+            TOPIC_LOG(ERROR) << LOG_BADGE("parseTopicsDeltaJson")
+                             << LOG_DESC("unable to parse json") << LOG_KV("json:", _json);
+            return false;
+        }
+        _delta.topicEpoch = root["topicEpoch"].asUInt64();
+        _delta.fromSeq = root["fromSeq"].asUInt();
+        _delta.topicSeq = root["topicSeq"].asUInt();
+        for (auto const& topic : root["subscribed"])
+        {
+            _delta.subscribed.push_back(topic.asString());
+        }
+        for (auto const& topic : root["unsubscribed"])
+        {
+            _delta.unsubscribed.push_back(topic.asString());
+        }
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        TOPIC_LOG(ERROR) << LOG_BADGE("parseTopicsDeltaJson")
+                         << LOG_KV("error", boost::diagnostic_information(e))
+                         << LOG_KV("json:", _json);
+        return false;
+    }
+}
+
+bool TopicManager::applyTopicsDeltaByNodeID(P2pID const& _nodeID, TopicsDelta const& _delta)
+{
+    {
+        std::unique_lock lock(x_topics);
+        auto seqIt = m_nodeID2TopicSeq.find(_nodeID);
+        auto epochIt = m_nodeID2TopicEpoch.find(_nodeID);
+        if (seqIt == m_nodeID2TopicSeq.end() || epochIt == m_nodeID2TopicEpoch.end() ||
+            seqIt->second != _delta.fromSeq || epochIt->second != _delta.topicEpoch)
+        {
+            TOPIC_LOG(INFO) << LOG_BADGE("applyTopicsDeltaByNodeID")
+                            << LOG_DESC("topicSeq mismatch, fetch all topics next time")
+                            << LOG_KV("nodeID", _nodeID) << LOG_KV("fromSeq", _delta.fromSeq);
+            removeNodeState(_nodeID);
+            return false;
+        }
+        auto& topicItems = m_nodeID2TopicItems[_nodeID];
+        for (auto const& topic : _delta.unsubscribed)
+        {
+            topicItems.erase(TopicItem(topic));
+            m_nodeTopicTrie.erase(topic, _nodeID);
+        }
+        for (auto const& topic : _delta.subscribed)
+        {
+            topicItems.insert(TopicItem(topic));
+            m_nodeTopicTrie.insert(topic, _nodeID);
+        }
+        seqIt->second = _delta.topicSeq;
+    }
+
+    TOPIC_LOG(INFO) << LOG_BADGE("applyTopicsDeltaByNodeID") << LOG_KV("nodeID", _nodeID)
+                    << LOG_KV("fromSeq", _delta.fromSeq) << LOG_KV("topicSeq", _delta.topicSeq)
+                    << LOG_KV("subscribed", _delta.subscribed.size())
+                    << LOG_KV("unsubscribed", _delta.unsubscribed.size());
+    return true;
+}
+
+void TopicManager::removeNodeState(P2pID const& _nodeID)
+{
+    auto it = m_nodeID2TopicItems.find(_nodeID);
+    if (it != m_nodeID2TopicItems.end())
+    {
+        for (auto const& topicItem : it->second)
+        {
+            m_nodeTopicTrie.erase(topicItem.topicName(), _nodeID);
+        }
+        m_nodeID2TopicItems.erase(it);
+    }
+    m_nodeID2TopicSeq.erase(_nodeID);
+    m_nodeID2TopicEpoch.erase(_nodeID);
+}
+
 /**
  * @brief: update online nodeIDs, clean up the offline nodeIDs state
  * @param _nodeIDs: the online nodeIDs
@@ -309,8 +531,8 @@ void TopicManager::notifyNodeIDs(const std::vector<P2pID>& _nodeIDs)
                     return it->first == _nodeID;
                 }) == _nodeIDs.end())
             {  // nodeID is offline, remove the nodeID's state
-                m_nodeID2TopicItems.erase(it->first);
-                it = m_nodeID2TopicSeq.erase(it);
+                auto nodeID = (it++)->first;
+                removeNodeState(nodeID);
                 removeCount++;
             }
             else
@@ -331,12 +553,18 @@ void TopicManager::notifyNodeIDs(const std::vector<P2pID>& _nodeIDs)
  * @return void
  */
 void TopicManager::updateSeqAndTopicsByNodeID(
-    P2pID const& _nodeID, uint32_t _topicSeq, const TopicItems& _topicItems)
+    P2pID const& _nodeID, uint32_t _topicSeq, const TopicItems& _topicItems, uint64_t _topicEpoch)
 {
     {
         std::unique_lock lock(x_topics);
+        removeNodeState(_nodeID);
         m_nodeID2TopicSeq[_nodeID] = _topicSeq;
+        m_nodeID2TopicEpoch[_nodeID] = _topicEpoch;
         m_nodeID2TopicItems[_nodeID] = _topicItems;
+        for (auto const& topicItem : _topicItems)
+        {
+            m_nodeTopicTrie.insert(topicItem.topicName(), _nodeID);
+        }
     }
 
     TOPIC_LOG(INFO) << LOG_BADGE("updateSeqAndTopicsByNodeID") << LOG_KV("nodeID", _nodeID)
@@ -353,18 +581,19 @@ void TopicManager::updateSeqAndTopicsByNodeID(
 void TopicManager::queryNodeIDsByTopic(
     const std::string& _topic, std::vector<std::string>& _nodeIDs)
 {
-    std::shared_lock lock(x_topics);
-    for (auto it = m_nodeID2TopicItems.begin(); it != m_nodeID2TopicItems.end(); ++it)
+    std::vector<std::string> nodeIDs;
+    {
+        std::shared_lock lock(x_topics);
+        m_nodeTopicTrie.match(_topic, nodeIDs);
+    }
+    // only return the connected nodes
+    for (auto& nodeID : nodeIDs)
     {
-        auto findIt = std::find_if(it->second.begin(), it->second.end(),
-            [_topic](const TopicItem& _topicItem) { return _topic == _topicItem.topicName(); });
-        // only return the connected nodes
-        if (findIt != it->second.end() && m_network->isReachable(it->first))
+        if (m_network->isReachable(nodeID))
         {
-            _nodeIDs.push_back(it->first);
+            _nodeIDs.push_back(std::move(nodeID));
         }
     }
-    return;
 }
 
 /**
@@ -378,19 +607,11 @@ void TopicManager::queryClientsByTopic(
 {
     {
         std::shared_lock lock(x_clientTopics);
-        for (const auto& items : m_client2TopicItems)
-        {
-            auto it = std::find_if(items.second.begin(), items.second.end(),
-                [_topic](const TopicItem& _topicItem) { return _topic == _topicItem.topicName(); });
-            if (it != items.second.end())
-            {
-                _clients.push_back(items.first);
-            }
-        }
+        m_clientTopicTrie.match(_topic, _clients);
     }
 
-    TOPIC_LOG(INFO) << LOG_BADGE("queryClientsByTopic") << LOG_KV("topic", _topic)
-                    << LOG_KV("clients size", _clients.size());
+    TOPIC_LOG(DEBUG) << LOG_BADGE("queryClientsByTopic") << LOG_KV("topic", _topic)
+                     << LOG_KV("clients size", _clients.size());
 }
 
 //
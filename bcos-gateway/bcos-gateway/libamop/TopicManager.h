@@ -23,26 +23,43 @@
 #include <bcos-crypto/interfaces/crypto/KeyInterface.h>
 #include <bcos-framework/rpc/RPCInterface.h>
 #include <bcos-gateway/libamop/Common.h>
+#include <bcos-gateway/libamop/TopicTrie.h>
 #include <bcos-gateway/libp2p/P2PInterface.h>
 #include <bcos-tars-protocol/client/RpcServiceClient.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Timer.h>
 #include <servant/Application.h>
 #include <algorithm>
+#include <deque>
 #include <shared_mutex>
 
 namespace bcos
 {
 namespace amop
 {
+// the topics subscribed and unsubscribed by the clients of a gateway between two topicSeqs
+struct TopicsDelta
+{
+    uint64_t topicEpoch = 0;
+    uint32_t fromSeq = 0;
+    uint32_t topicSeq = 0;
+    std::vector<std::string> subscribed;
+    std::vector<std::string> unsubscribed;
+};
+
 class TopicManager : public std::enable_shared_from_this<TopicManager>
 {
 public:
     using Ptr = std::shared_ptr<TopicManager>;
+    // the topic changes kept for the delta sync, the peers falling further behind get all topics
+    constexpr static size_t MAX_TOPIC_CHANGES = 4096;
+
     TopicManager(std::string const& _rpcServiceName, bcos::gateway::P2PInterface::Ptr _network)
     {
         m_rpcServiceName = _rpcServiceName;
         m_network = _network;
+        m_topicEpoch = std::random_device{}() | 1;
+        m_topicChangesBaseSeq = m_topicSeq;
     }
     virtual ~TopicManager() {}
 
@@ -50,6 +67,8 @@ public:
     virtual void stop() {}
 
     uint32_t topicSeq() const { return m_topicSeq; }
+    // identify the topicSeqs of this gateway since it started
+    uint64_t topicEpoch() const { return m_topicEpoch; }
     uint32_t incTopicSeq()
     {
         uint32_t topicSeq = ++m_topicSeq;
@@ -106,6 +125,27 @@ public:
      */
     bool parseTopicItemsJson(
         uint32_t& _topicSeq, TopicItems& _topicItems, const std::string& _json);
+    bool parseTopicItemsJson(uint64_t& _topicEpoch, uint32_t& _topicSeq, TopicItems& _topicItems,
+        const std::string& _json);
+    /**
+     * @brief: the request for the topics of the nodeID, carrying the topicEpoch and topicSeq
+     * known locally
+     * @return json string, empty if nothing of the nodeID is known
+     */
+    std::string requestTopicsJson(bcos::gateway::P2pID const& _nodeID);
+    /**
+     * @brief: the topics changed since the topicSeq of the request
+     * @param _requestJson: built by requestTopicsJson of the peer
+     * @return json string, empty if the changes are no longer kept or the epoch mismatch
+     */
+    std::string queryTopicsDeltaByRequest(const std::string& _requestJson);
+    bool parseTopicsDeltaJson(const std::string& _json, TopicsDelta& _delta);
+    /**
+     * @brief: apply the topic changes of the nodeID
+     * @return bool: false if the delta does not start from the topicSeq known locally, the state
+     * of the nodeID is dropped to fetch all topics next time
+     */
+    bool applyTopicsDeltaByNodeID(bcos::gateway::P2pID const& _nodeID, TopicsDelta const& _delta);
     /**
      * @brief: check if the topicSeq of nodeID changed
      * @param _nodeID: the peer nodeID
@@ -126,8 +166,8 @@ public:
      * @param _topicItems: topicItems
      * @return void
      */
-    void updateSeqAndTopicsByNodeID(
-        bcos::gateway::P2pID const& _nodeID, uint32_t _topicSeq, const TopicItems& _topicItems);
+    void updateSeqAndTopicsByNodeID(bcos::gateway::P2pID const& _nodeID, uint32_t _topicSeq,
+        const TopicItems& _topicItems, uint64_t _topicEpoch = 0);
     /**
      * @brief: find the nodeIDs by topic
      * @param _topic: topic
@@ -148,14 +188,37 @@ public:
 protected:
     virtual void notifyRpcToSubscribeTopics();
 
+    // index and record the subscription of the client, under x_clientTopics
+    void subscribeTopic(const std::string& _client, const std::string& _topic, uint32_t _topicSeq);
+    void unsubscribeTopic(
+        const std::string& _client, const std::string& _topic, uint32_t _topicSeq);
+    void recordTopicChange(uint32_t _topicSeq, const std::string& _topic, bool _subscribed);
+    // drop everything known about the nodeID, under x_topics
+    void removeNodeState(bcos::gateway::P2pID const& _nodeID);
+
     // m_client2TopicItems lock
     mutable std::shared_mutex x_clientTopics;
     // client => TopicItems
     // Note: the clientID is the rpc node endpoint
     std::unordered_map<std::string, TopicItems> m_client2TopicItems;
+    // topic => clients
+    TopicTrie m_clientTopicTrie;
+    // topic => count of the clients subscribing it, the topics of this gateway
+    std::unordered_map<std::string, size_t> m_topicRefCount;
+
+    struct TopicChange
+    {
+        uint32_t topicSeq;
+        std::string topic;
+        bool subscribed;
+    };
+    // the recent changes of m_topicRefCount, every change after m_topicChangesBaseSeq is kept
+    std::deque<TopicChange> m_topicChanges;
+    uint32_t m_topicChangesBaseSeq;
 
     // topicSeq
     std::atomic<uint32_t> m_topicSeq{1};
+    uint64_t m_topicEpoch;
 
     // nodeID => topicSeq
     std::unordered_map<std::string, uint32_t> m_nodeID2TopicSeq;
@@ -164,6 +227,10 @@ protected:
 
     // nodeID => topicItems
     std::unordered_map<std::string, TopicItems> m_nodeID2TopicItems;
+    // nodeID => topicEpoch, 0 for the nodes not supporting the delta sync
+    std::unordered_map<std::string, uint64_t> m_nodeID2TopicEpoch;
+    // topic => nodeIDs
+    TopicTrie m_nodeTopicTrie;
 
     std::map<std::string, bcos::rpc::RPCInterface::Ptr> m_clientInfo;
     mutable SharedMutex x_clientInfo;
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief index from topic to the subscribers, with wildcard prefix topics
+ * @file TopicTrie.cpp
+ * @date 2022-11-21
+ */
+#include <bcos-gateway/libamop/TopicTrie.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::amop;
+
+void TopicTrie::insert(std::string const& _topic, std::string const& _subscriber)
+{
+    if (!isWildcard(_topic))
+    {
+        m_exact[_topic].insert(_subscriber);
+        return;
+    }
+    auto* node = &m_root;
+    for (auto c : std::string_view(_topic).substr(0, _topic.size() - 1))
+    {
+        auto& child = node->children[c];
+        if (!child)
+        {
+            child = std::make_unique<Node>();
+        }
+        node = child.get();
+    }
+    if (node->subscribers.insert(_subscriber).second)
+    {
+        ++m_wildcards;
+    }
+}
+
+void TopicTrie::erase(std::string const& _topic, std::string const& _subscriber)
+{
+    if (!isWildcard(_topic))
+    {
+        auto it = m_exact.find(_topic);
+        if (it != m_exact.end())
+        {
+            it->second.erase(_subscriber);
+            if (it->second.empty())
+            {
+                m_exact.erase(it);
+            }
+        }
+        return;
+    }
+
+    auto prefix = std::string_view(_topic).substr(0, _topic.size() - 1);
+    std::vector<Node*> path;
+    path.reserve(prefix.size() + 1);
+    path.push_back(&m_root);
+    for (auto c : prefix)
+    {
+        auto it = path.back()->children.find(c);
+        if (it == path.back()->children.end())
+        {
+            return;
+        }
+        path.push_back(it->second.get());
+    }
+    if (path.back()->subscribers.erase(_subscriber) == 0)
+    {
+        return;
+    }
+    --m_wildcards;
+    // prune the nodes left without subscribers and children
+    for (auto i = prefix.size(); i > 0; --i)
+    {
+        auto* node = path[i];
+        if (!node->subscribers.empty() || !node->children.empty())
+        {
+            break;
+        }
+        path[i - 1]->children.erase(prefix[i - 1]);
+    }
+}
+
+void TopicTrie::clear()
+{
+    m_exact.clear();
+    m_root.children.clear();
+    m_root.subscribers.clear();
+    m_wildcards = 0;
+}
+
+void TopicTrie::match(std::string_view _topic, std::vector<std::string>& _subscribers) const
+{
+    auto begin = _subscribers.size();
+    auto it = m_exact.find(std::string(_topic));
+    if (it != m_exact.end())
+    {
+        _subscribers.insert(_subscribers.end(), it->second.begin(), it->second.end());
+    }
+    if (m_wildcards == 0)
+    {
+        return;
+    }
+
+    auto const* node = &m_root;
+    for (size_t i = 0;; ++i)
+    {
+        _subscribers.insert(_subscribers.end(), node->subscribers.begin(), node->subscribers.end());
+        if (i == _topic.size())
+        {
+            break;
+        }
+        auto child = node->children.find(_topic[i]);
+        if (child == node->children.end())
+        {
+            break;
+        }
+        node = child->second.get();
+    }
+    // a subscriber may match by several prefixes and the exact topic
+    std::sort(_subscribers.begin() + begin, _subscribers.end());
+    _subscribers.erase(
+        std::unique(_subscribers.begin() + begin, _subscribers.end()), _subscribers.end());
+}
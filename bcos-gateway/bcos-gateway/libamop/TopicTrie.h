@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief index from topic to the subscribers, with wildcard prefix topics
+ * @file TopicTrie.h
+ * @date 2022-11-21
+ */
+#pragma once
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace amop
+{
+/**
+ * @brief The subscribers of the exact topics are found by one hash lookup, a topic ending with '*'
+ * subscribes every topic starting with the part before the '*' and is kept in a character trie
+ * walked along the topic only when such subscriptions exist.
+ * Not thread safe, guarded by the owner.
+ */
+class TopicTrie
+{
+public:
+    static bool isWildcard(std::string_view _topic)
+    {
+        return !_topic.empty() && _topic.back() == '*';
+    }
+
+    void insert(std::string const& _topic, std::string const& _subscriber);
+    void erase(std::string const& _topic, std::string const& _subscriber);
+    void clear();
+
+    // append the subscribers of _topic to _subscribers, each subscriber once
+    void match(std::string_view _topic, std::vector<std::string>& _subscribers) const;
+    bool empty() const { return m_exact.empty() && m_wildcards == 0; }
+
+private:
+    struct Node
+    {
+        std::map<char, std::unique_ptr<Node>> children;
+        std::set<std::string> subscribers;
+    };
+
+    std::unordered_map<std::string, std::set<std::string>> m_exact;
+    Node m_root;
+    // the wildcard subscriptions in the trie
+    size_t m_wildcards = 0;
+};
+}  // namespace amop
+}  // namespace bcos
@@ -82,7 +82,8 @@ void Session::asyncSendMessage(Message::Ptr message, Options options, SessionCal
 
     auto session = shared_from_this();
     // checking before send the message
-    if (m_beforeMessageHandler && !m_beforeMessageHandler(session, message, callback))
+    uint64_t sendTime = 0;
+    if (m_beforeMessageHandler && !m_beforeMessageHandler(session, message, callback, sendTime))
     {
         return;
     }
@@ -132,7 +133,83 @@ void Session::asyncSendMessage(Message::Ptr message, Options options, SessionCal
     std::shared_ptr<bytes> p_buffer = std::make_shared<bytes>();
     message->encode(*p_buffer);
 
-    send(p_buffer);
+    // paced by the rate limiter, the response timeout has been counted from now
+    sendAt(p_buffer, sendTime);
+}
+
+void Session::sendAt(const std::shared_ptr<bytes>& _msg, uint64_t _sendTime)
+{
+    Guard lock(x_delayedMessages);
+    if (_sendTime == 0 && m_delayedMessages.empty())
+    {
+        send(_msg);
+        return;
+    }
+
+    // the rate limiter never schedules a message before the earlier ones of its module, so the
+    // module's messages due by now go first
+    auto now = utcSteadyTime();
+    sendDueMessages(now);
+    if (_sendTime <= now)
+    {
+        send(_msg);
+        return;
+    }
+    m_delayedMessages.emplace(_sendTime, _msg);
+    startDelayTimer(now);
+}
+
+void Session::onDelayTimer()
+{
+    Guard lock(x_delayedMessages);
+    m_delayTimer.reset();
+    m_delayTimerTime = 0;
+    auto now = utcSteadyTime();
+    sendDueMessages(now);
+    startDelayTimer(now);
+}
+
+void Session::sendDueMessages(uint64_t _now)
+{
+    auto end = m_delayedMessages.upper_bound(_now);
+    for (auto it = m_delayedMessages.begin(); it != end; ++it)
+    {
+        send(it->second);
+    }
+    m_delayedMessages.erase(m_delayedMessages.begin(), end);
+}
+
+void Session::startDelayTimer(uint64_t _now)
+{
+    if (m_delayedMessages.empty())
+    {
+        return;
+    }
+    auto sendTime = m_delayedMessages.begin()->first;
+    if (m_delayTimer && m_delayTimerTime <= sendTime)
+    {
+        return;
+    }
+    auto server = m_server.lock();
+    if (!server)
+    {
+        return;
+    }
+    if (m_delayTimer)
+    {
+        m_delayTimer->cancel();
+    }
+    m_delayTimer = server->asioInterface()->newTimer(sendTime - _now);
+    m_delayTimerTime = sendTime;
+    auto sessionWeakPtr = std::weak_ptr<Session>(shared_from_this());
+    m_delayTimer->async_wait([sessionWeakPtr](const boost::system::error_code& _error) {
+        auto session = sessionWeakPtr.lock();
+        if (!session || _error)
+        {
+            return;
+        }
+        session->onDelayTimer();
+    });
 }
 
 void Session::send(const std::shared_ptr<bytes>& _msg)
@@ -14,6 +14,7 @@
 #include <boost/heap/priority_queue.hpp>
 #include <array>
 #include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -78,9 +79,11 @@ public:
     }
 
     // handle before sending message, if the check fails, meaning false is returned, the message is
-    // not sent, and the SessionCallbackFunc will be performed
+    // not sent, and the SessionCallbackFunc will be performed, otherwise the message is sent at the
+    // steady time in ms set by the handler, 0 to send it at once
     void setBeforeMessageHandler(
-        std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc)> handler) override
+        std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc, uint64_t&)>
+            handler) override
     {
         m_beforeMessageHandler = handler;
     }
@@ -92,6 +95,12 @@ protected:
 
 private:
     void send(const std::shared_ptr<bytes>& _msg);
+    // send the message at the steady time in ms, after the delayed messages due before it
+    void sendAt(const std::shared_ptr<bytes>& _msg, uint64_t _sendTime);
+    void onDelayTimer();
+    // with x_delayedMessages held
+    void sendDueMessages(uint64_t _now);
+    void startDelayTimer(uint64_t _now);
 
     void doRead();
     std::vector<byte> m_data;  ///< Buffer for ingress packet data.
@@ -135,6 +144,13 @@ private:
     std::atomic_bool m_writing = {false};
     bcos::Mutex x_writeQueue;
 
+    // the messages delayed by the rate limiter by the steady time in ms to send them at, the
+    // messages of the same time are kept in order
+    std::multimap<uint64_t, std::shared_ptr<bytes>> m_delayedMessages;
+    std::shared_ptr<boost::asio::deadline_timer> m_delayTimer;
+    uint64_t m_delayTimerTime = 0;
+    bcos::Mutex x_delayedMessages;
+
     mutable bcos::Mutex x_info;
 
     bool m_actived = false;
@@ -143,7 +159,8 @@ private:
 
     std::function<void(NetworkException, SessionFace::Ptr, Message::Ptr)> m_messageHandler;
 
-    std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc)> m_beforeMessageHandler;
+    std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc, uint64_t&)>
+        m_beforeMessageHandler;
 
     uint64_t m_shutDownTimeThres = 50000;
     // 1min
@@ -42,9 +42,11 @@ public:
         std::function<void(NetworkException, SessionFace::Ptr, Message::Ptr)> messageHandler) = 0;
 
     // handle before sending message, if the check fails, meaning false is returned, the message is
-    // not sent, and the SessionCallbackFunc will be performed
+    // not sent, and the SessionCallbackFunc will be performed, otherwise the message is sent at the
+    // steady time in ms set by the handler, 0 to send it at once
     virtual void setBeforeMessageHandler(
-        std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc)> handler) = 0;
+        std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc, uint64_t&)>
+            handler) = 0;
 
     virtual NodeIPEndpoint nodeIPEndpoint() const = 0;
 
@@ -202,8 +202,9 @@ void Service::onConnect(
     auto p2pSessionWeakPtr = std::weak_ptr<P2PSession>(p2pSession);
     p2pSession->session()->setMessageHandler(std::bind(&Service::onMessage, shared_from_this(),
         std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, p2pSessionWeakPtr));
-    p2pSession->session()->setBeforeMessageHandler(std::bind(&Service::onBeforeMessage,
-        shared_from_this(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+    p2pSession->session()->setBeforeMessageHandler(
+        std::bind(&Service::onBeforeMessage, shared_from_this(), std::placeholders::_1,
+            std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
     p2pSession->start();
     asyncSendProtocol(p2pSession);
     updateStaticNodes(session->socket(), p2pID);
@@ -297,12 +298,12 @@ void Service::sendRespMessageBySession(
                        << LOG_KV("payload size", _payload.size());
 }
 
-bool Service::onBeforeMessage(
-    SessionFace::Ptr _session, Message::Ptr _message, SessionCallbackFunc _callback)
+bool Service::onBeforeMessage(SessionFace::Ptr _session, Message::Ptr _message,
+    SessionCallbackFunc _callback, uint64_t& _sendTime)
 {
     if (m_beforeMessageHandler)
     {
-        return m_beforeMessageHandler(_session, _message, _callback);
+        return m_beforeMessageHandler(_session, _message, _callback, _sendTime);
     }
 
     return true;
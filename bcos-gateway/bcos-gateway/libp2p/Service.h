@@ -47,8 +47,8 @@ public:
     virtual void onMessage(NetworkException e, SessionFace::Ptr session, Message::Ptr message,
         std::weak_ptr<P2PSession> p2pSessionWeakPtr);
 
-    virtual bool onBeforeMessage(
-        SessionFace::Ptr _session, Message::Ptr _message, SessionCallbackFunc _callback);
+    virtual bool onBeforeMessage(SessionFace::Ptr _session, Message::Ptr _message,
+        SessionCallbackFunc _callback, uint64_t& _sendTime);
 
     void sendRespMessageBySession(
         bytesConstRef _payload, P2PMessage::Ptr _p2pMessage, P2PSession::Ptr _p2pSession) override;
@@ -161,9 +161,11 @@ public:
         CallbackFuncWithSession callback, Options options = Options());
 
     // handle before sending message, if the check fails, meaning false is returned, the message is
-    // not sent, and the SessionCallbackFunc will be performed
+    // not sent, and the SessionCallbackFunc will be performed, otherwise the message is sent at the
+    // steady time in ms set by the handler, 0 to send it at once
     void setBeforeMessageHandler(
-        std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc)> _handler)
+        std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc, uint64_t&)>
+            _handler)
     {
         m_beforeMessageHandler = _handler;
     }
@@ -259,7 +261,8 @@ protected:
     // handlers called when delete-session
     std::vector<std::function<void(P2PSession::Ptr)>> m_deleteSessionHandlers;
 
-    std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc)> m_beforeMessageHandler;
+    std::function<bool(SessionFace::Ptr, Message::Ptr, SessionCallbackFunc, uint64_t&)>
+        m_beforeMessageHandler;
 
     std::function<void(SessionFace::Ptr, Message::Ptr)> m_onMessageHandler;
 };
@@ -84,50 +84,45 @@ void DistributedRateLimiter::acquire(int64_t _requiredPermits)
  */
 bool DistributedRateLimiter::tryAcquire(int64_t _requiredPermits)
 {
-    // try local cache acquire first
-    if (m_enableLocalCache && tryAcquireLocalCache(_requiredPermits, true))
-    {
-        return true;
-    }
-
     if (!m_enableLocalCache)
     {
         // local cache not enable,  request redis directly
         return requestRedis(_requiredPermits) >= 0;
     }
 
-    std::lock_guard<std::mutex> lock(x_localCache);
-    // another thread update local cache again
-    if (tryAcquireLocalCache(_requiredPermits, false))
+    // try local cache acquire first
+    if (tryAcquireLocalCache(_requiredPermits))
     {
         return true;
     }
 
     // the request acquire bigger than _requiredPermits has been failed
-    if (m_lastFailedPermit > 0 && _requiredPermits >= m_lastFailedPermit)
+    auto lastFailedPermit = m_lastFailedPermit.load();
+    if (lastFailedPermit > 0 && _requiredPermits >= lastFailedPermit)
     {
         return false;
     }
 
-    // request redis to update local cache
-    int64_t permits = m_maxPermits / 100 * m_localCachePermits;
-    if (requestRedis(permits > _requiredPermits ? permits : _requiredPermits) >= 0)
+    std::lock_guard<std::mutex> lock(x_localCache);
+    // another thread update local cache again
+    if (tryAcquireLocalCache(_requiredPermits))
     {
-        // update local cache
-        m_localCachePermits += (permits - _requiredPermits);
         return true;
     }
 
-    // update failed info
-    m_lastFailedPermit = permits;
-    if (permits == _requiredPermits)
+    // request redis to update local cache
+    int64_t permits = m_maxPermits * m_localCachePercent / 100;
+    if (permits > _requiredPermits && requestRedis(permits) >= 0)
     {
-        return false;
+        // update local cache
+        m_localCachePermits += (permits - _requiredPermits);
+        return true;
     }
 
     auto result = requestRedis(_requiredPermits);
     if (result < 0)
     {
+        // update failed info
         m_lastFailedPermit = _requiredPermits;
     }
 
@@ -141,44 +136,40 @@ bool DistributedRateLimiter::tryAcquire(int64_t _requiredPermits)
  */
 void DistributedRateLimiter::rollback(int64_t _requiredPermits)
 {
-    // Note: This operation is not supported
-    std::ignore = _requiredPermits;
+    // Note: the permits are returned to the local cache only, redis is not updated
+    if (m_enableLocalCache && _requiredPermits > 0)
+    {
+        m_localCachePermits += _requiredPermits;
+    }
+}
+
+void DistributedRateLimiter::forceAcquire(int64_t _requiredPermits)
+{
+    if (!tryAcquire(_requiredPermits) && m_enableLocalCache)
+    {
+        // in debt until the local cache is refreshed
+        m_localCachePermits -= _requiredPermits;
+    }
 }
 
 /**
  * @brief
  *
  * @param _requiredPermits
- * @param _withLock
  * @return true
  * @return false
  */
-bool DistributedRateLimiter::tryAcquireLocalCache(int64_t _requiredPermits, bool _withLock)
+bool DistributedRateLimiter::tryAcquireLocalCache(int64_t _requiredPermits)
 {
-    // enable local cache and local cache is not enough
-    if (m_localCachePermits < _requiredPermits)
-    {
-        return false;
-    }
-
-    bool result = false;
-    if (_withLock)
+    auto permits = m_localCachePermits.load();
+    while (permits >= _requiredPermits)
     {
-        x_localCache.lock();
-    }
-
-    if (m_localCachePermits >= _requiredPermits)
-    {
-        m_localCachePermits -= _requiredPermits;
-        result = true;
-    }
-
-    if (_withLock)
-    {
-        x_localCache.unlock();
+        if (m_localCachePermits.compare_exchange_weak(permits, permits - _requiredPermits))
+        {
+            return true;
+        }
     }
-
-    return result;
+    return false;
 }
 
 /**
@@ -224,8 +215,8 @@ int64_t DistributedRateLimiter::requestRedis(int64_t _requiredPermits)
                            << LOG_KV("enableLocalCache", m_enableLocalCache)
                            << LOG_KV("error", e.what());
 
-        // exception throw, allow this acquire
-        return _requiredPermits;
+        // redis is unreachable, approximate with the local rate limiter
+        return m_localRateLimiter->tryAcquire(_requiredPermits) ? _requiredPermits : -1;
     }
 }
 
@@ -255,7 +246,6 @@ void DistributedRateLimiter::refreshLocalCache()
     {
         std::lock_guard<std::mutex> lock(x_localCache);
         m_localCachePermits = 0;
-        m_localCachePercent = 0;
         m_lastFailedPermit = 0;
     }
 
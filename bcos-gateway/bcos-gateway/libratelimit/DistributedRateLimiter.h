@@ -24,6 +24,7 @@
 #include "bcos-utilities/BoostLog.h"
 #include "bcos-utilities/Timer.h"
 #include <bcos-gateway/libratelimit/RateLimiterInterface.h>
+#include <bcos-gateway/libratelimit/TokenBucketRateLimiter.h>
 #include <bcos-utilities/Common.h>
 #include <sw/redis++/redis++.h>
 #include <memory>
@@ -36,6 +37,12 @@ namespace gateway
 namespace ratelimiter
 {
 
+/**
+ * @brief The permits are fetched from redis in batches of localCachePercent of maxPermits and
+ * consumed locally, so redis is queried once per batch instead of once per message. A rejection of
+ * redis is remembered until the next interval, and when redis is unreachable the permits are
+ * approximated by a local token bucket of the same rate instead of being unlimited.
+ */
 class DistributedRateLimiter : public RateLimiterInterface,
                                public std::enable_shared_from_this<DistributedRateLimiter>
 {
@@ -56,8 +63,9 @@ public:
         m_maxPermits(_maxPermits),
         m_interval(_interval),
         m_enableLocalCache(_enableLocalCache),
-        m_localCachePercent(_localCachePercent)
-
+        m_localCachePercent(_localCachePercent),
+        m_localRateLimiter(std::make_shared<TokenBucketRateLimiter>(
+            std::max<int64_t>(_maxPermits / std::max(_interval, 1), 1)))
     {
         GATEWAY_LOG(INFO) << LOG_BADGE("DistributedRateLimiter::NEWOBJ")
                           << LOG_DESC("construct distributed rate limiter")
@@ -174,23 +182,28 @@ public:
     void rollback(int64_t _requiredPermits) override;
 
     /**
-     * @brief
+     * @brief charge the local cache, the following acquires fetch from redis
      *
      * @param _requiredPermits
-     * @param _withLock
-     * @return true
-     * @return false
      */
-    bool tryAcquireLocalCache(int64_t _requiredPermits, bool _withLock = true);
+    void forceAcquire(int64_t _requiredPermits) override;
 
     /**
-     * @brief
+     * @brief take the permits from the local cache without lock
      *
      * @param _requiredPermits
      * @return true
      * @return false
      */
-    int64_t requestRedis(int64_t _requiredPermits);
+    bool tryAcquireLocalCache(int64_t _requiredPermits);
+
+    /**
+     * @brief acquire the permits from redis, overridden by the test stand-in
+     *
+     * @param _requiredPermits
+     * @return the permits acquired, negative if rejected
+     */
+    virtual int64_t requestRedis(int64_t _requiredPermits);
 
     /**
      * @brief
@@ -209,6 +222,7 @@ public:
     int64_t interval() const { return m_interval; }
     bool enableLocalCache() const { return m_enableLocalCache; }
     int32_t localCachePercent() const { return m_localCachePercent; }
+    int64_t localCachePermits() const { return m_localCachePermits; }
     std::string rateLimitKey() const { return m_rateLimiterKey; }
     std::shared_ptr<sw::redis::Redis> redis() const { return m_redis; }
 
@@ -227,14 +241,16 @@ private:
 
     // enable local cache for improve perf and reduce latency
     bool m_enableLocalCache = false;
-    // lock for m_localCachePermits
+    // lock for fetching the permits from redis into the local cache
     std::mutex x_localCache;
     // local cache percent of m_maxPermits
     int32_t m_localCachePercent = DEFAULT_LOCAL_CACHE_PERCENT;
-    // local cache value
-    int64_t m_localCachePermits = 0;
-    //
-    int64_t m_lastFailedPermit = 0;
+    // local cache value, taken without lock
+    std::atomic<int64_t> m_localCachePermits = {0};
+    // the permits rejected by redis in this interval
+    std::atomic<int64_t> m_lastFailedPermit = {0};
+    // approximate the limit locally while redis is unreachable
+    TokenBucketRateLimiter::Ptr m_localRateLimiter;
     // clear local cache info periodically
     std::shared_ptr<bcos::Timer> m_clearCacheTimer = nullptr;
     // stat info periodically
@@ -25,7 +25,7 @@ using namespace bcos::gateway;
 using namespace bcos::gateway::ratelimiter;
 
 std::pair<bool, std::string> GatewayRateLimiter::checkOutGoing(const std::string& _endpoint,
-    const std::string& _groupID, uint16_t _moduleID, uint64_t _msgLength)
+    const std::string& _groupID, uint16_t _moduleID, uint64_t _msgLength, uint64_t* _sendTime)
 {
     // endpoint of the p2p connection
     const std::string& endpoint = _endpoint;
@@ -41,8 +41,7 @@ std::pair<bool, std::string> GatewayRateLimiter::checkOutGoing(const std::string
     {
         // total outgoing bandwidth
         ratelimiter::RateLimiterInterface::Ptr totalOutGoingBWLimit =
-            m_rateLimiterManager->getRateLimiter(
-                ratelimiter::RateLimiterManager::TOTAL_OUTGOING_KEY);
+            m_rateLimiterManager->totalOutgoingRateLimiter();
 
         // connection outgoing bandwidth
         ratelimiter::RateLimiterInterface::Ptr connOutGoingBWLimit =
@@ -55,7 +54,7 @@ std::pair<bool, std::string> GatewayRateLimiter::checkOutGoing(const std::string
             groupOutGoingBWLimit = m_rateLimiterManager->getGroupRateLimiter(groupID);
         }
 
-        auto modulesWithoutLimit = m_rateLimiterManager->modulesWithoutLimit();
+        auto const& modulesWithoutLimit = m_rateLimiterManager->modulesWithoutLimit();
 
         // if moduleID is zero, the P2P network itself's message, the ratelimiter does not limit
         // P2P own's messages
@@ -116,21 +115,67 @@ std::pair<bool, std::string> GatewayRateLimiter::checkOutGoing(const std::string
                 break;
             }
 
-            if (groupOutGoingBWLimit && !groupOutGoingBWLimit->tryAcquire(msgLength))
+            // group and module outgoing bandwidth
+            ratelimiter::RateLimiterInterface::Ptr moduleOutGoingBWLimit = nullptr;
+            if (!groupID.empty())
             {
-                // group outgoing bandwidth overflow
-                errorMsg = "the group outgoing bandwidth overflow, groupID: " + groupID;
-                if (totalOutGoingBWLimit)
+                moduleOutGoingBWLimit =
+                    m_rateLimiterManager->getGroupModuleRateLimiter(groupID, moduleID);
+            }
+            auto fairQueue =
+                _sendTime ? m_rateLimiterManager->getGroupFairQueue(groupID) : nullptr;
+            auto now = (int64_t)utcSteadyTimeUs();
+            // once the module has delayed messages, the following ones wait behind them instead
+            // of overtaking them with the permits produced meanwhile
+            bool queued = fairQueue && fairQueue->queued(moduleID, now);
+            bool groupAcquired =
+                !queued && (!groupOutGoingBWLimit || groupOutGoingBWLimit->tryAcquire(msgLength));
+            bool moduleAcquired = groupAcquired &&
+                                  (!moduleOutGoingBWLimit ||
+                                      moduleOutGoingBWLimit->tryAcquire(msgLength));
+            if (!moduleAcquired)
+            {
+                if (groupAcquired && groupOutGoingBWLimit)
                 {
-                    totalOutGoingBWLimit->rollback(msgLength);
+                    groupOutGoingBWLimit->rollback(msgLength);
                 }
 
-                if (connOutGoingBWLimit)
+                // delay the message until the module earns the bandwidth of the group
+                int64_t delay = -1;
+                if (fairQueue)
+                {
+                    delay = fairQueue->schedule(moduleID, msgLength, now);
+                }
+                if (delay < 0)
                 {
-                    connOutGoingBWLimit->rollback(msgLength);
+                    // group or module outgoing bandwidth overflow
+                    errorMsg = (groupAcquired || queued) ?
+                                   "the module outgoing bandwidth overflow, groupID: " + groupID +
+                                       ", moduleID: " + std::to_string(moduleID) :
+                                   "the group outgoing bandwidth overflow, groupID: " + groupID;
+                    if (totalOutGoingBWLimit)
+                    {
+                        totalOutGoingBWLimit->rollback(msgLength);
+                    }
+
+                    if (connOutGoingBWLimit)
+                    {
+                        connOutGoingBWLimit->rollback(msgLength);
+                    }
+
+                    break;
                 }
 
-                break;
+                // the delayed message is charged, the following messages of the group wait
+                if (groupOutGoingBWLimit)
+                {
+                    groupOutGoingBWLimit->forceAcquire(msgLength);
+                }
+                if (moduleOutGoingBWLimit)
+                {
+                    moduleOutGoingBWLimit->forceAcquire(msgLength);
+                }
+                *_sendTime = (uint64_t)(now / 1000 + delay);
             }
         }
 
@@ -95,7 +95,24 @@ public:
 
 public:
     std::pair<bool, std::string> checkOutGoing(const std::string& _endpoint,
-        const std::string& _groupID, uint16_t _moduleID, uint64_t _msgLength);
+        const std::string& _groupID, uint16_t _moduleID, uint64_t _msgLength)
+    {
+        return checkOutGoing(_endpoint, _groupID, _moduleID, _msgLength, nullptr);
+    }
+
+    /**
+     * @brief check the outgoing message, the group or module over-quota message is delayed by the
+     * group's weighted fair queue instead of being rejected when possible
+     *
+     * @param _sendTime the steady time in ms to send the message at, set when the message is
+     * admitted, 0 to send it at once
+     */
+    std::pair<bool, std::string> checkOutGoing(const std::string& _endpoint,
+        const std::string& _groupID, uint16_t _moduleID, uint64_t _msgLength, uint64_t& _sendTime)
+    {
+        _sendTime = 0;
+        return checkOutGoing(_endpoint, _groupID, _moduleID, _msgLength, &_sendTime);
+    }
 
 
     std::pair<bool, std::string> checkInComing(const std::string& _endpoint, uint64_t _msgLength);
@@ -103,6 +120,10 @@ public:
         const std::string& _groupID, uint16_t _moduleID, uint64_t _msgLength);
 
 private:
+    std::pair<bool, std::string> checkOutGoing(const std::string& _endpoint,
+        const std::string& _groupID, uint16_t _moduleID, uint64_t _msgLength,
+        uint64_t* _sendTime);
+
     bool m_running = false;
 
     ratelimiter::RateLimiterManager::Ptr m_rateLimiterManager;
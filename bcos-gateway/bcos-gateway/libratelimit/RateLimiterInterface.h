@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace bcos
@@ -69,6 +70,14 @@ public:
      * @return
      */
     virtual void rollback(int64_t _requiredPermits) = 0;
+
+    /**
+     * @brief take the permits even if they are not enough, used for the messages that have been
+     * delayed instead of rejected, the following acquires fail until the permits are produced
+     *
+     * @param _requiredPermits
+     */
+    virtual void forceAcquire(int64_t _requiredPermits) { tryAcquire(_requiredPermits); }
 };
 
 }  // namespace ratelimiter
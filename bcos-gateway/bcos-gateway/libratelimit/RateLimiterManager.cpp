@@ -30,9 +30,10 @@ const std::string RateLimiterManager::TOTAL_OUTGOING_KEY = "total-outgoing-key";
 
 RateLimiterInterface::Ptr RateLimiterManager::getRateLimiter(const std::string& _rateLimiterKey)
 {
-    std::shared_lock lock(x_rateLimiters);
-    auto it = m_rateLimiters.find(_rateLimiterKey);
-    if (it != m_rateLimiters.end())
+    auto& rateLimiterShard = shard(_rateLimiterKey);
+    std::shared_lock lock(rateLimiterShard.x_rateLimiters);
+    auto it = rateLimiterShard.rateLimiters.find(_rateLimiterKey);
+    if (it != rateLimiterShard.rateLimiters.end())
     {
         return it->second;
     }
@@ -43,8 +44,13 @@ RateLimiterInterface::Ptr RateLimiterManager::getRateLimiter(const std::string&
 bool RateLimiterManager::registerRateLimiter(
     const std::string& _rateLimiterKey, RateLimiterInterface::Ptr _rateLimiter)
 {
-    std::unique_lock lock(x_rateLimiters);
-    auto result = m_rateLimiters.try_emplace(_rateLimiterKey, _rateLimiter);
+    auto& rateLimiterShard = shard(_rateLimiterKey);
+    std::unique_lock lock(rateLimiterShard.x_rateLimiters);
+    auto result = rateLimiterShard.rateLimiters.try_emplace(_rateLimiterKey, _rateLimiter);
+    if (result.second && _rateLimiterKey == TOTAL_OUTGOING_KEY)
+    {
+        std::atomic_store(&m_totalOutgoingRateLimiter, _rateLimiter);
+    }
 
     RATELIMIT_MGR_LOG(INFO) << LOG_BADGE("registerRateLimiter")
                             << LOG_KV("rateLimiterKey", _rateLimiterKey)
@@ -57,8 +63,14 @@ bool RateLimiterManager::removeRateLimiter(const std::string& _rateLimiterKey)
     RATELIMIT_MGR_LOG(INFO) << LOG_BADGE("removeRateLimiter")
                             << LOG_KV("rateLimiterKey", _rateLimiterKey);
 
-    std::unique_lock lock(x_rateLimiters);
-    return m_rateLimiters.erase(_rateLimiterKey) > 0;
+    auto& rateLimiterShard = shard(_rateLimiterKey);
+    std::unique_lock lock(rateLimiterShard.x_rateLimiters);
+    if (_rateLimiterKey == TOTAL_OUTGOING_KEY)
+    {
+        std::atomic_store(&m_totalOutgoingRateLimiter, RateLimiterInterface::Ptr());
+    }
+    rateLimiterShard.fairQueues.erase(_rateLimiterKey);
+    return rateLimiterShard.rateLimiters.erase(_rateLimiterKey) > 0;
 }
 
 RateLimiterInterface::Ptr RateLimiterManager::getGroupRateLimiter(const std::string& _group)
@@ -159,4 +171,87 @@ RateLimiterInterface::Ptr RateLimiterManager::getConnRateLimiter(const std::stri
     }
 
     return rateLimiter;
-}
\ No newline at end of file
+}
+
+RateLimiterInterface::Ptr RateLimiterManager::getGroupModuleRateLimiter(
+    const std::string& _group, uint16_t _moduleID)
+{
+    auto it = m_rateLimiterConfig.module2BwLimit.find(_moduleID);
+    if (it == m_rateLimiterConfig.module2BwLimit.end())
+    {
+        return nullptr;
+    }
+
+    auto rateLimiterKey = toGroupModuleKey(_group, _moduleID);
+    auto rateLimiter = getRateLimiter(rateLimiterKey);
+    if (rateLimiter != nullptr)
+    {
+        return rateLimiter;
+    }
+
+    auto moduleOutgoingBwLimit = it->second;
+    RATELIMIT_MGR_LOG(INFO) << LOG_BADGE("getGroupModuleRateLimiter")
+                            << LOG_DESC("group module rate limiter not exist")
+                            << LOG_KV("rateLimiterKey", rateLimiterKey)
+                            << LOG_KV("moduleOutgoingBwLimit", moduleOutgoingBwLimit);
+    if (m_rateLimiterConfig.enableDistributedRatelimit)
+    {
+        rateLimiter = m_rateLimiterFactory->buildRedisDistributedRateLimiter(
+            m_rateLimiterFactory->toTokenKey(rateLimiterKey), moduleOutgoingBwLimit, 1,
+            m_rateLimiterConfig.enableDistributedRateLimitCache,
+            m_rateLimiterConfig.distributedRateLimitCachePercent);
+    }
+    else
+    {
+        rateLimiter = m_rateLimiterFactory->buildTokenBucketRateLimiter(moduleOutgoingBwLimit);
+    }
+    if (!registerRateLimiter(rateLimiterKey, rateLimiter))
+    {
+        // registered by another thread
+        return getRateLimiter(rateLimiterKey);
+    }
+    return rateLimiter;
+}
+
+WeightedFairQueue::Ptr RateLimiterManager::getGroupFairQueue(const std::string& _group)
+{
+    if (m_rateLimiterConfig.maxOutgoingDelay <= 0 || !m_rateLimiterConfig.enableGroupRateLimit)
+    {
+        return nullptr;
+    }
+
+    auto& rateLimiterShard = shard(_group);
+    {
+        std::shared_lock lock(rateLimiterShard.x_rateLimiters);
+        auto it = rateLimiterShard.fairQueues.find(_group);
+        if (it != rateLimiterShard.fairQueues.end())
+        {
+            return it->second;
+        }
+    }
+
+    int64_t groupOutgoingBwLimit = m_rateLimiterConfig.groupOutgoingBwLimit;
+    auto it = m_rateLimiterConfig.group2BwLimit.find(_group);
+    if (it != m_rateLimiterConfig.group2BwLimit.end())
+    {
+        groupOutgoingBwLimit = it->second;
+    }
+    if (groupOutgoingBwLimit <= 0)
+    {
+        return nullptr;
+    }
+
+    auto fairQueue = std::make_shared<WeightedFairQueue>(
+        groupOutgoingBwLimit, m_rateLimiterConfig.maxOutgoingDelay);
+    for (auto const& [moduleID, weight] : m_rateLimiterConfig.module2Weight)
+    {
+        fairQueue->setWeight(moduleID, weight);
+    }
+
+    std::unique_lock lock(rateLimiterShard.x_rateLimiters);
+    auto result = rateLimiterShard.fairQueues.try_emplace(_group, fairQueue);
+    RATELIMIT_MGR_LOG(INFO) << LOG_BADGE("getGroupFairQueue") << LOG_KV("group", _group)
+                            << LOG_KV("groupOutgoingBwLimit", groupOutgoingBwLimit)
+                            << LOG_KV("maxOutgoingDelay", m_rateLimiterConfig.maxOutgoingDelay);
+    return result.first->second;
+}
@@ -22,8 +22,10 @@
 
 #include "bcos-gateway/libratelimit/ModuleWhiteList.h"
 #include "bcos-gateway/libratelimit/RateLimiterFactory.h"
+#include "bcos-gateway/libratelimit/WeightedFairQueue.h"
 #include <bcos-gateway/GatewayConfig.h>
 #include <bcos-utilities/Common.h>
+#include <array>
 #include <shared_mutex>
 #include <unordered_map>
 
@@ -43,6 +45,8 @@ public:
 
 public:
     const static std::string TOTAL_OUTGOING_KEY;
+    // the limiters are spread over the shards to reduce the lock contention of the lookups
+    constexpr static size_t SHARD_SIZE = 16;
 
 public:
     RateLimiterManager(const GatewayConfig::RateLimiterConfig& _rateLimiterConfig)
@@ -58,6 +62,17 @@ public:
 
     RateLimiterInterface::Ptr getGroupRateLimiter(const std::string& _group);
     RateLimiterInterface::Ptr getConnRateLimiter(const std::string& _connIP);
+    // the quota of the module in the group, nullptr if the module is not limited
+    RateLimiterInterface::Ptr getGroupModuleRateLimiter(
+        const std::string& _group, uint16_t _moduleID);
+    // the queue delaying the over-quota messages of the group, nullptr if the delay is disabled or
+    // the group is not limited
+    WeightedFairQueue::Ptr getGroupFairQueue(const std::string& _group);
+
+    RateLimiterInterface::Ptr totalOutgoingRateLimiter() const
+    {
+        return std::atomic_load(&m_totalOutgoingRateLimiter);
+    }
 
 public:
     ratelimiter::RateLimiterFactory::Ptr rateLimiterFactory() const { return m_rateLimiterFactory; }
@@ -85,10 +100,28 @@ private:
     //   factory for RateLimiterInterface
     ratelimiter::RateLimiterFactory::Ptr m_rateLimiterFactory;
 
-    // lock for m_group2RateLimiter
-    mutable std::shared_mutex x_rateLimiters;
-    // group/ip => ratelimiter
-    std::unordered_map<std::string, RateLimiterInterface::Ptr> m_rateLimiters;
+    static std::string toGroupModuleKey(const std::string& _group, uint16_t _moduleID)
+    {
+        return _group + "#" + std::to_string(_moduleID);
+    }
+
+    struct RateLimiterShard
+    {
+        // lock for rateLimiters and fairQueues
+        mutable std::shared_mutex x_rateLimiters;
+        // group/ip/group#module => ratelimiter
+        std::unordered_map<std::string, RateLimiterInterface::Ptr> rateLimiters;
+        // group => the queue of the over-quota messages
+        std::unordered_map<std::string, WeightedFairQueue::Ptr> fairQueues;
+    };
+    RateLimiterShard& shard(const std::string& _key)
+    {
+        return m_shards[std::hash<std::string>{}(_key) % SHARD_SIZE];
+    }
+
+    std::array<RateLimiterShard, SHARD_SIZE> m_shards;
+    // the total outgoing limiter is checked by every message, kept out of the maps
+    RateLimiterInterface::Ptr m_totalOutgoingRateLimiter;
 
     // the message of modules that do not limit bandwidth
     std::set<uint16_t> m_modulesWithoutLimit;
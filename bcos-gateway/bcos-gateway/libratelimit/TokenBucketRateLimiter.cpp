@@ -22,27 +22,38 @@
  */
 #include <bcos-gateway/Common.h>
 #include <bcos-gateway/libratelimit/TokenBucketRateLimiter.h>
+#include <array>
 #include <thread>
 
 using namespace bcos;
 using namespace bcos::gateway;
 using namespace bcos::gateway::ratelimiter;
 
+namespace
+{
+std::atomic<size_t> c_threadCount = {0};
+// spread the threads over the shards
+thread_local size_t t_threadIndex = c_threadCount.fetch_add(1);
+}  // namespace
+
 TokenBucketRateLimiter::TokenBucketRateLimiter(int64_t _maxQPS)
-  : m_maxQPS(_maxQPS),
-    m_permitsUpdateInterval((double)1000000 / (double)m_maxQPS),
-    m_lastPermitsUpdateTime(utcSteadyTimeUs()),
+  : m_maxQPS(std::max<int64_t>(_maxQPS, 1)),
     m_maxPermits(m_maxQPS),
-    m_futureBurstResetTime(m_lastPermitsUpdateTime + m_burstTimeInterval)
+    m_shardSize(
+        std::min<size_t>(MAX_SHARDS, std::max<size_t>(std::thread::hardware_concurrency(), 1))),
+    m_shards(std::make_unique<Shard[]>(m_shardSize)),
+    m_lastRefillTime(utcSteadyTimeUs())
 {
+    updateShardCapacity();
     RATELIMIT_LOG(INFO) << LOG_BADGE("[NEWOBJ][TokenBucketRateLimiter]")
-                        << LOG_KV("permitsUpdateInterval", m_permitsUpdateInterval)
-                        << LOG_KV("maxPermits", m_maxPermits);
+                        << LOG_KV("maxQPS", m_maxQPS) << LOG_KV("maxPermits", m_maxPermits)
+                        << LOG_KV("shardSize", m_shardSize);
 }
 
 void TokenBucketRateLimiter::setMaxPermitsSize(int64_t const& _maxPermitsSize)
 {
     m_maxPermits = _maxPermitsSize;
+    updateShardCapacity();
 
     RATELIMIT_LOG(INFO) << LOG_BADGE("setMaxPermitsSize") << LOG_DESC("setMaxPermitsSize")
                         << LOG_KV("maxPermitsSize", m_maxPermits);
@@ -64,105 +75,236 @@ void TokenBucketRateLimiter::setMaxBurstReqNum(int64_t const& _maxBurstReqNum)
                         << LOG_KV("maxBurstReqNum", m_maxBurstReqNum);
 }
 
-bool TokenBucketRateLimiter::tryAcquire(int64_t _requiredPermits)
+void TokenBucketRateLimiter::updateShardCapacity()
 {
-    int64_t waitTime = fetchPermitsAndGetWaitTime(_requiredPermits, false, utcSteadyTimeUs());
-    return (waitTime == 0);
+    auto shardSize = (int64_t)m_shardSize;
+    for (int64_t i = 0; i < shardSize; ++i)
+    {
+        m_shards[i].maxPermits =
+            m_maxPermits / shardSize + (i < m_maxPermits % shardSize ? 1 : 0);
+    }
 }
 
-void TokenBucketRateLimiter::acquire(int64_t _requiredPermits)
+TokenBucketRateLimiter::Shard& TokenBucketRateLimiter::localShard()
+{
+    return m_shards[t_threadIndex % m_shardSize];
+}
+
+int64_t TokenBucketRateLimiter::takePermits(
+    Shard& _shard, int64_t _requiredPermits, bool _partial)
 {
-    int64_t waitTime = fetchPermitsAndGetWaitTime(_requiredPermits, false, utcSteadyTimeUs());
-    if (waitTime > 0)
+    auto permits = _shard.permits.load(std::memory_order_relaxed);
+    while (permits > 0)
     {
-        std::this_thread::sleep_for(std::chrono::microseconds(waitTime));
+        auto taken = std::min(permits, _requiredPermits);
+        if (taken < _requiredPermits && !_partial)
+        {
+            return 0;
+        }
+        if (_shard.permits.compare_exchange_weak(permits, permits - taken))
+        {
+            return taken;
+        }
     }
-    return;
+    return 0;
 }
 
-void TokenBucketRateLimiter::rollback(int64_t _requiredPermits)
+void TokenBucketRateLimiter::putPermits(Shard& _shard, int64_t _permits)
 {
-    Guard l(m_mutex);
-    m_currentStoredPermits += _requiredPermits;
-    if (m_currentStoredPermits > m_maxPermits)
+    // repay the borrowed permits first
+    auto debt = m_debt.load();
+    while (debt > 0 && _permits > 0)
     {
-        m_currentStoredPermits = m_maxPermits;
+        auto repaid = std::min(debt, _permits);
+        if (m_debt.compare_exchange_weak(debt, debt - repaid))
+        {
+            _permits -= repaid;
+            break;
+        }
+    }
+    // the local shard first, then the others, the permits over the capacity are dropped
+    auto index = &_shard - m_shards.get();
+    for (size_t i = 0; i < m_shardSize && _permits > 0; ++i)
+    {
+        auto& shard = m_shards[(index + i) % m_shardSize];
+        auto permits = shard.permits.load(std::memory_order_relaxed);
+        while (permits < shard.maxPermits)
+        {
+            auto added = std::min(shard.maxPermits - permits, _permits);
+            if (shard.permits.compare_exchange_weak(permits, permits + added))
+            {
+                _permits -= added;
+                break;
+            }
+        }
     }
-    return;
 }
 
-int64_t TokenBucketRateLimiter::fetchPermitsAndGetWaitTime(
-    int64_t _requiredPermits, bool _fetchPermitsWhenRequireWait, int64_t _now)
+void TokenBucketRateLimiter::refill(int64_t _now)
 {
-    Guard l(m_mutex);
-    // has remaining permits, handle the request directly
-    if (m_currentStoredPermits > _requiredPermits)
+    auto lastRefillTime = m_lastRefillTime.load();
+    auto elapsed = _now - lastRefillTime;
+    if (elapsed < REFILL_INTERVAL)
+    {
+        return;
+    }
+    int64_t producedPermits = 0;
+    int64_t refillTime = _now;
+    // the time to fill all the shards and repay the debt
+    auto fullPermits = m_maxPermits + m_debt.load();
+    if ((double)elapsed * (double)m_maxQPS >= (double)fullPermits * 1000000)
     {
-        m_currentStoredPermits -= _requiredPermits;
-        return 0;
+        producedPermits = fullPermits;
+    }
+    else
+    {
+        producedPermits = (int64_t)((double)elapsed * (double)m_maxQPS / 1000000);
+        if (producedPermits <= 0)
+        {
+            return;
+        }
+        // keep the fraction of the permit for the next refill
+        refillTime =
+            lastRefillTime + (int64_t)((double)producedPermits * 1000000 / (double)m_maxQPS);
+    }
+    // only one thread refills the permits produced in the interval
+    if (!m_lastRefillTime.compare_exchange_strong(lastRefillTime, refillTime))
+    {
+        return;
     }
 
-    // update the permits
-    updatePermits(_now);
-    int64_t waitAvailableTime = m_lastPermitsUpdateTime - _now;
-    // _fetchPermitsWhenRequireWait is false: don't fetch permits after timeout
-    // _fetchPermitsWhenRequireWait is true: fetch permits after timeout
-    if (!_fetchPermitsWhenRequireWait)
+    auto debt = m_debt.load();
+    while (debt > 0)
     {
-        if (waitAvailableTime > 0)
+        auto repaid = std::min(debt, producedPermits);
+        if (m_debt.compare_exchange_weak(debt, debt - repaid))
         {
-            return waitAvailableTime;
+            producedPermits -= repaid;
+            break;
         }
-        // Only permits of m_maxQPS can be used in advance
-        if ((_requiredPermits - m_currentStoredPermits) >= m_maxQPS)
+    }
+    if (producedPermits <= 0)
+    {
+        return;
+    }
+
+    // rebalance: the shards drained by the busy threads receive most of the permits
+    std::array<int64_t, MAX_SHARDS> lacks{};
+    int64_t totalLack = 0;
+    for (size_t i = 0; i < m_shardSize; ++i)
+    {
+        lacks[i] = std::max<int64_t>(
+            m_shards[i].maxPermits - m_shards[i].permits.load(std::memory_order_relaxed), 0);
+        totalLack += lacks[i];
+    }
+    if (totalLack == 0)
+    {
+        return;
+    }
+    int64_t givenPermits = 0;
+    for (size_t i = 0; i < m_shardSize; ++i)
+    {
+        auto permits = totalLack <= producedPermits ?
+                           lacks[i] :
+                           (int64_t)((double)lacks[i] * (double)producedPermits / totalLack);
+        if (permits > 0)
         {
-            // Indicates that the permits was not obtained
-            return 1;
+            m_shards[i].permits.fetch_add(permits);
+            givenPermits += permits;
         }
     }
-    if ((waitAvailableTime > 0 || (_requiredPermits - m_currentStoredPermits) >= m_maxQPS) &&
-        !_fetchPermitsWhenRequireWait)
+    if (producedPermits > givenPermits && totalLack > givenPermits)
     {
-        return waitAvailableTime;
+        putPermits(localShard(), std::min(producedPermits, totalLack) - givenPermits);
     }
-    updateCurrentStoredPermits(_requiredPermits);
-    return std::max(waitAvailableTime, (int64_t)0);
 }
 
-void TokenBucketRateLimiter::updateCurrentStoredPermits(int64_t _requiredPermits)
+bool TokenBucketRateLimiter::tryAcquire(int64_t _requiredPermits)
 {
-    double waitTime = 0;
+    if (_requiredPermits <= 0)
+    {
+        return true;
+    }
+    auto& shard = localShard();
+    if (takePermits(shard, _requiredPermits, false) == _requiredPermits)
+    {
+        return true;
+    }
+    refill(utcSteadyTimeUs());
 
-    if (_requiredPermits > m_currentStoredPermits)
+    // steal from the other shards when the local one is not enough
+    auto index = &shard - m_shards.get();
+    int64_t takenPermits = 0;
+    for (size_t i = 0; i < m_shardSize && takenPermits < _requiredPermits; ++i)
     {
-        waitTime = (_requiredPermits - m_currentStoredPermits) * m_permitsUpdateInterval;
-        m_currentStoredPermits = 0;
+        takenPermits +=
+            takePermits(m_shards[(index + i) % m_shardSize], _requiredPermits - takenPermits, true);
     }
-    else
+    if (takenPermits == _requiredPermits)
     {
-        m_currentStoredPermits -= _requiredPermits;
+        return true;
     }
-    if (waitTime > 0)
+
+    // Only permits of m_maxQPS can be used in advance, and only when nothing is borrowed
+    auto missingPermits = _requiredPermits - takenPermits;
+    int64_t debt = 0;
+    if (missingPermits < m_maxQPS && m_debt.compare_exchange_strong(debt, missingPermits))
     {
-        m_lastPermitsUpdateTime += (int64_t)(waitTime);
+        return true;
     }
+    putPermits(shard, takenPermits);
+    return false;
 }
 
-void TokenBucketRateLimiter::updatePermits(int64_t _now)
+void TokenBucketRateLimiter::forceAcquire(int64_t _requiredPermits)
 {
-    if (_now <= m_lastPermitsUpdateTime)
+    if (_requiredPermits <= 0)
     {
         return;
     }
-    int64_t increasedPermits = (double)(_now - m_lastPermitsUpdateTime) / m_permitsUpdateInterval;
-    m_currentStoredPermits = std::min(m_maxPermits, m_currentStoredPermits + increasedPermits);
-    // update last permits update time
-    if (m_currentStoredPermits == m_maxPermits)
+    refill(utcSteadyTimeUs());
+    auto& shard = localShard();
+    auto index = &shard - m_shards.get();
+    int64_t takenPermits = 0;
+    for (size_t i = 0; i < m_shardSize && takenPermits < _requiredPermits; ++i)
     {
-        m_lastPermitsUpdateTime = _now;
+        takenPermits +=
+            takePermits(m_shards[(index + i) % m_shardSize], _requiredPermits - takenPermits, true);
     }
-    else
+    if (takenPermits < _requiredPermits)
+    {
+        m_debt.fetch_add(_requiredPermits - takenPermits);
+    }
+}
+
+void TokenBucketRateLimiter::acquire(int64_t _requiredPermits)
+{
+    if (tryAcquire(_requiredPermits))
+    {
+        return;
+    }
+    // wait the permits to be produced, at most 1s
+    auto waitTime = std::min<int64_t>(
+        (int64_t)((double)_requiredPermits * 1000000 / (double)m_maxQPS), 1000000);
+    std::this_thread::sleep_for(std::chrono::microseconds(waitTime));
+    forceAcquire(_requiredPermits);
+}
+
+void TokenBucketRateLimiter::rollback(int64_t _requiredPermits)
+{
+    if (_requiredPermits <= 0)
+    {
+        return;
+    }
+    putPermits(localShard(), _requiredPermits);
+}
+
+int64_t TokenBucketRateLimiter::availablePermits() const
+{
+    int64_t permits = 0;
+    for (size_t i = 0; i < m_shardSize; ++i)
     {
-        m_lastPermitsUpdateTime += increasedPermits * m_permitsUpdateInterval;
+        permits += m_shards[i].permits.load(std::memory_order_relaxed);
     }
+    return permits - m_debt.load();
 }
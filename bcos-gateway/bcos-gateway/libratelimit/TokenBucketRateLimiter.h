@@ -24,6 +24,8 @@
 
 #include <bcos-gateway/libratelimit/RateLimiterInterface.h>
 #include <bcos-utilities/Common.h>
+#include <atomic>
+#include <memory>
 
 namespace bcos
 {
@@ -32,6 +34,14 @@ namespace gateway
 namespace ratelimiter
 {
 
+/**
+ * @brief The permits are kept in per-thread shards updated with CAS only, so the senders on
+ * different threads do not contend on one lock. A thread takes the permits from its own shard,
+ * refills all the shards once the refill interval has passed, giving the new permits to the shards
+ * by how much they lack, and only steals from the other shards when its own is empty.
+ * A request larger than the stored permits may still borrow up to maxQPS permits from the future
+ * when nothing is borrowed, the later requests are rejected until the debt is repaid.
+ */
 class TokenBucketRateLimiter : public RateLimiterInterface
 {
 public:
@@ -39,6 +49,11 @@ public:
     using ConstPtr = std::shared_ptr<const TokenBucketRateLimiter>;
     using UniquePtr = std::unique_ptr<const TokenBucketRateLimiter>;
 
+    // the max number of the shards
+    constexpr static size_t MAX_SHARDS = 16;
+    // refill at most once per interval, in us
+    constexpr static int64_t REFILL_INTERVAL = 1000;
+
 public:
     TokenBucketRateLimiter(int64_t _maxQPS);
 
@@ -73,44 +88,58 @@ public:
      */
     void rollback(int64_t _requiredPermits) override;
 
+    /**
+     * @brief take the permits even if they are not enough, the missing part is borrowed
+     *
+     * @param _requiredPermits
+     */
+    void forceAcquire(int64_t _requiredPermits) override;
+
 public:
     int64_t maxQPS() const { return m_maxQPS; }
+    int64_t maxPermits() const { return m_maxPermits; }
+    size_t shardSize() const { return m_shardSize; }
+    // the stored permits of all shards minus the borrowed ones, for stat and test
+    int64_t availablePermits() const;
 
     void setMaxPermitsSize(int64_t const& _maxPermitsSize);
     void setBurstTimeInterval(int64_t const& _burstInterval);
     void setMaxBurstReqNum(int64_t const& _maxBurstReqNum);
 
-protected:
-    int64_t fetchPermitsAndGetWaitTime(
-        int64_t _requiredPermits, bool _fetchPermitsWhenRequireWait, int64_t _now);
-
-    void updatePermits(int64_t _now);
+    // refill the permits produced until _now, in us
+    void refill(int64_t _now);
 
-    void updateCurrentStoredPermits(int64_t _requiredPermits);
+protected:
+    struct alignas(64) Shard
+    {
+        std::atomic<int64_t> permits = {0};
+        int64_t maxPermits = 0;
+    };
+
+    Shard& localShard();
+    // take up to _requiredPermits from the shard, return the permits taken
+    static int64_t takePermits(Shard& _shard, int64_t _requiredPermits, bool _partial);
+    void putPermits(Shard& _shard, int64_t _permits);
+    void updateShardCapacity();
 
 private:
-    mutable bcos::Mutex m_mutex;
-
     // the max QPS
     int64_t m_maxQPS;
-
-    // stored permits
-    std::atomic<int64_t> m_currentStoredPermits = 0;
-
-    // the interval time to update storedPermits
-    double m_permitsUpdateInterval;
-    int64_t m_lastPermitsUpdateTime;
     int64_t m_maxPermits = 0;
 
-    // the current burstReqNum, every m_burstTimeInterval is refreshed to 0
-    std::atomic<int64_t> m_burstReqNum = {0};
+    size_t m_shardSize;
+    std::unique_ptr<Shard[]> m_shards;
+    // the permits borrowed from the future, repaid before the shards are refilled
+    std::atomic<int64_t> m_debt = {0};
+    // the time the permits have been produced until, in us
+    std::atomic<int64_t> m_lastRefillTime;
+
     // the max burst num during m_burstTimeInterval
     int64_t m_maxBurstReqNum = 0;
     // default burst interval is 1s
     uint64_t m_burstTimeInterval = 1000000;
-    std::atomic<int64_t> m_futureBurstResetTime;
 };
 
 }  // namespace ratelimiter
 }  // namespace gateway
-}  // namespace bcos
\ No newline at end of file
+}  // namespace bcos
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WeightedFairQueue.cpp
+ * @date 2022-11-22
+ */
+
+#include <bcos-gateway/libratelimit/WeightedFairQueue.h>
+
+using namespace bcos;
+using namespace bcos::gateway;
+using namespace bcos::gateway::ratelimiter;
+
+void WeightedFairQueue::setWeight(uint16_t _moduleID, uint32_t _weight)
+{
+    Guard guard(x_flows);
+    m_flows[_moduleID].weight = std::max<uint32_t>(_weight, 1);
+}
+
+uint32_t WeightedFairQueue::weight(uint16_t _moduleID) const
+{
+    Guard guard(x_flows);
+    auto it = m_flows.find(_moduleID);
+    return it == m_flows.end() ? 1 : it->second.weight;
+}
+
+int64_t WeightedFairQueue::schedule(uint16_t _moduleID, int64_t _permits, int64_t _now)
+{
+    Guard guard(x_flows);
+    auto& flow = m_flows[_moduleID];
+    // the flows with messages waiting share the bandwidth
+    uint64_t activeWeight = flow.weight;
+    for (auto const& it : m_flows)
+    {
+        if (it.first != _moduleID && it.second.finishTime > _now)
+        {
+            activeWeight += it.second.weight;
+        }
+    }
+    auto startTime = std::max(flow.finishTime, _now);
+    auto serviceTime = (int64_t)((double)_permits * 1000000 * (double)activeWeight /
+                                 ((double)m_rate * (double)flow.weight));
+    auto finishTime = startTime + serviceTime;
+    auto sendTime = std::max((finishTime + 999) / 1000, flow.sendTime);
+    auto delay = sendTime - _now / 1000;
+    if (delay > m_maxDelay)
+    {
+        return -1;
+    }
+    flow.finishTime = finishTime;
+    flow.sendTime = sendTime;
+    return delay;
+}
+
+bool WeightedFairQueue::queued(uint16_t _moduleID, int64_t _now) const
+{
+    Guard guard(x_flows);
+    auto it = m_flows.find(_moduleID);
+    return it != m_flows.end() && it->second.sendTime > _now / 1000;
+}
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WeightedFairQueue.h
+ * @date 2022-11-22
+ */
+
+#pragma once
+
+#include <bcos-utilities/Common.h>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace gateway
+{
+namespace ratelimiter
+{
+
+/**
+ * @brief Paces the over-quota messages of a group instead of rejecting them. Each module is a flow
+ * with a weight, and the bandwidth of the group is shared by the flows that have messages waiting
+ * in proportion to their weights: a message is delayed until its flow has earned the bandwidth to
+ * send it, the virtual clock approximation of weighted fair queuing.
+ */
+class WeightedFairQueue
+{
+public:
+    using Ptr = std::shared_ptr<WeightedFairQueue>;
+    using ConstPtr = std::shared_ptr<const WeightedFairQueue>;
+
+    // _rate: the permits per second of the group, _maxDelay: the longest delay in ms
+    WeightedFairQueue(int64_t _rate, int64_t _maxDelay)
+      : m_rate(std::max<int64_t>(_rate, 1)), m_maxDelay(_maxDelay)
+    {}
+
+    void setWeight(uint16_t _moduleID, uint32_t _weight);
+    uint32_t weight(uint16_t _moduleID) const;
+
+    /**
+     * @brief schedule the _permits of the module at _now, in us
+     *
+     * @return the delay in ms from _now / 1000 before sending the message, never before the
+     * previous message of the module, -1 if the delay is longer than the max delay and the message
+     * should be rejected
+     */
+    int64_t schedule(uint16_t _moduleID, int64_t _permits, int64_t _now);
+
+    // whether the module has scheduled messages not sent yet at _now, in us, the following
+    // messages of the module must be scheduled behind them to keep their order
+    bool queued(uint16_t _moduleID, int64_t _now) const;
+
+    int64_t rate() const { return m_rate; }
+    int64_t maxDelay() const { return m_maxDelay; }
+
+private:
+    struct Flow
+    {
+        uint32_t weight = 1;
+        // the time the scheduled permits of the flow are earned, in us
+        int64_t finishTime = 0;
+        // the time the last scheduled message of the flow is sent, in ms
+        int64_t sendTime = 0;
+    };
+
+    int64_t m_rate;
+    int64_t m_maxDelay;
+    mutable bcos::Mutex x_flows;
+    std::unordered_map<uint16_t, Flow> m_flows;
+};
+
+}  // namespace ratelimiter
+}  // namespace gateway
+}  // namespace bcos
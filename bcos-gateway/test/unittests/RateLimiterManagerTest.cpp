@@ -325,6 +325,35 @@ BOOST_AUTO_TEST_CASE(test_rateLimiterManagerConfigIPv6)
 
         BOOST_CHECK_EQUAL(tokenBucketRateLimiter2->maxQPS(), 3 * 1024 * 1024 / 8);
     }
+
+    {
+        // module quota of every group and the weights of the delayed messages
+        BOOST_CHECK_EQUAL(rateLimiterConfig.maxOutgoingDelay, 300);
+        BOOST_CHECK_EQUAL(rateLimiterConfig.module2BwLimit.size(), 1);
+        BOOST_CHECK_EQUAL(
+            rateLimiterConfig.module2BwLimit.at(bcos::protocol::BlockSync), 512 * 1024 / 8);
+        BOOST_CHECK_EQUAL(rateLimiterConfig.module2Weight.at(bcos::protocol::TxsSync), 4);
+
+        auto rateLimiterManager =
+            gatewayFactory->buildRateLimiterManager(rateLimiterConfig, nullptr);
+        auto moduleRateLimiter = std::dynamic_pointer_cast<ratelimiter::TokenBucketRateLimiter>(
+            rateLimiterManager->getGroupModuleRateLimiter("group0", bcos::protocol::BlockSync));
+        BOOST_CHECK_EQUAL(moduleRateLimiter->maxQPS(), 512 * 1024 / 8);
+        BOOST_CHECK(moduleRateLimiter ==
+                    rateLimiterManager->getGroupModuleRateLimiter(
+                        "group0", bcos::protocol::BlockSync));
+        BOOST_CHECK(moduleRateLimiter != rateLimiterManager->getGroupModuleRateLimiter(
+                                             "group1", bcos::protocol::BlockSync));
+        BOOST_CHECK(rateLimiterManager->getGroupModuleRateLimiter(
+                        "group0", bcos::protocol::TxsSync) == nullptr);
+
+        auto fairQueue = rateLimiterManager->getGroupFairQueue("group0");
+        BOOST_CHECK_EQUAL(fairQueue->rate(), 1024 * 1024 / 8);
+        BOOST_CHECK_EQUAL(fairQueue->maxDelay(), 300);
+        BOOST_CHECK_EQUAL(fairQueue->weight(bcos::protocol::TxsSync), 4);
+        BOOST_CHECK_EQUAL(fairQueue->weight(bcos::protocol::BlockSync), 1);
+        BOOST_CHECK(fairQueue == rateLimiterManager->getGroupFairQueue("group0"));
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END()
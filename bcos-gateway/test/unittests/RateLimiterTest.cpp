@@ -0,0 +1,260 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the rate limiters
+ * @file RateLimiterTest.cpp
+ * @date 2022-11-22
+ */
+
+#include "bcos-gateway/libratelimit/DistributedRateLimiter.h"
+#include "bcos-gateway/libratelimit/GatewayRateLimiter.h"
+#include "bcos-gateway/libratelimit/TokenBucketRateLimiter.h"
+#include "bcos-gateway/libratelimit/WeightedFairQueue.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::gateway;
+using namespace bcos::gateway::ratelimiter;
+using namespace bcos::test;
+
+namespace
+{
+// emulates the lua script of the redis rate limiter in memory
+class FakeDistributedRateLimiter : public DistributedRateLimiter
+{
+public:
+    using DistributedRateLimiter::DistributedRateLimiter;
+
+    int64_t requestRedis(int64_t _requiredPermits) override
+    {
+        ++m_requestCount;
+        if (m_permits < _requiredPermits)
+        {
+            return -1;
+        }
+        m_permits -= _requiredPermits;
+        return _requiredPermits;
+    }
+
+    std::atomic<int64_t> m_permits = 0;
+    std::atomic<int64_t> m_requestCount = 0;
+};
+
+// a limiter that has the permits or not as the test says
+class FakeRateLimiter : public RateLimiterInterface
+{
+public:
+    void acquire(int64_t _requiredPermits) override { m_acquired += _requiredPermits; }
+    bool tryAcquire(int64_t _requiredPermits) override
+    {
+        if (!m_allow)
+        {
+            return false;
+        }
+        m_acquired += _requiredPermits;
+        return true;
+    }
+    void rollback(int64_t _requiredPermits) override { m_acquired -= _requiredPermits; }
+    void forceAcquire(int64_t _requiredPermits) override { m_acquired += _requiredPermits; }
+
+    bool m_allow = true;
+    int64_t m_acquired = 0;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(RateLimiterTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_tokenBucketRateLimiter)
+{
+    int64_t maxQPS = 1000;
+    auto rateLimiter = std::make_shared<TokenBucketRateLimiter>(maxQPS);
+    BOOST_CHECK_GE(rateLimiter->shardSize(), 1);
+
+    // nothing stored, less than maxQPS permits can be borrowed once
+    BOOST_CHECK(!rateLimiter->tryAcquire(maxQPS));
+    BOOST_CHECK(rateLimiter->tryAcquire(maxQPS / 2));
+    BOOST_CHECK(!rateLimiter->tryAcquire(1));
+
+    // a long time later the debt is repaid and all the shards are full
+    rateLimiter->refill(utcSteadyTimeUs() + 10 * 1000000);
+    BOOST_CHECK_EQUAL(rateLimiter->availablePermits(), maxQPS);
+
+    // the permits of the other shards are stolen
+    BOOST_CHECK(rateLimiter->tryAcquire(maxQPS - 1));
+    BOOST_CHECK(rateLimiter->tryAcquire(1));
+    rateLimiter->rollback(100);
+    BOOST_CHECK(rateLimiter->tryAcquire(100));
+
+    // forced permits are borrowed and repaid by the rollback first
+    rateLimiter->forceAcquire(50);
+    BOOST_CHECK_LE(rateLimiter->availablePermits(), -50 + 1);
+    rateLimiter->rollback(50);
+    BOOST_CHECK_GE(rateLimiter->availablePermits(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_tokenBucketRateLimiterConcurrent)
+{
+    int64_t maxQPS = 100000;
+    auto rateLimiter = std::make_shared<TokenBucketRateLimiter>(maxQPS);
+    auto startTime = utcSteadyTimeUs();
+    rateLimiter->refill(startTime + 10 * 1000000);
+
+    std::atomic<int64_t> acquired = 0;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < 50000; ++j)
+            {
+                if (rateLimiter->tryAcquire(1))
+                {
+                    ++acquired;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = utcSteadyTimeUs() - startTime;
+
+    // all the stored permits are taken, plus the permits produced meanwhile and one borrowed
+    BOOST_CHECK_GE(acquired, maxQPS);
+    BOOST_CHECK_LE(acquired, maxQPS + elapsed * maxQPS / 1000000 + 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_weightedFairQueue)
+{
+    // 1000 permits per second, delay at most 1s
+    WeightedFairQueue fairQueue(1000, 1000);
+    fairQueue.setWeight(1000, 3);
+    BOOST_CHECK_EQUAL(fairQueue.weight(1000), 3);
+    BOOST_CHECK_EQUAL(fairQueue.weight(2000), 1);
+
+    int64_t now = 1000000;
+    // alone, the flow has all the bandwidth
+    BOOST_CHECK_EQUAL(fairQueue.schedule(1000, 300, now), 300);
+    // shares a quarter of the bandwidth with the waiting flow of weight 3
+    BOOST_CHECK_EQUAL(fairQueue.schedule(2000, 100, now), 400);
+    // and three quarters for the flow of weight 3, after its previous message
+    BOOST_CHECK_EQUAL(fairQueue.schedule(1000, 300, now), 700);
+    // too long, rejected without being scheduled
+    BOOST_CHECK_EQUAL(fairQueue.schedule(1000, 300, now), -1);
+    BOOST_CHECK_EQUAL(fairQueue.schedule(1000, 1, now), 702);
+
+    // idle flows do not share the bandwidth
+    now += 2000000;
+    BOOST_CHECK_EQUAL(fairQueue.schedule(2000, 100, now), 100);
+
+    // waiting until the last scheduled message of the flow is sent
+    BOOST_CHECK(fairQueue.queued(2000, now));
+    BOOST_CHECK(fairQueue.queued(2000, now + 99999));
+    BOOST_CHECK(!fairQueue.queued(2000, now + 100000));
+    BOOST_CHECK(!fairQueue.queued(1000, now));
+    BOOST_CHECK(!fairQueue.queued(3000, now));
+}
+
+BOOST_AUTO_TEST_CASE(test_outgoingOrderOfModule)
+{
+    GatewayConfig::RateLimiterConfig rateLimiterConfig;
+    rateLimiterConfig.enableGroupRateLimit = true;
+    rateLimiterConfig.groupOutgoingBwLimit = 1000;
+    rateLimiterConfig.maxOutgoingDelay = 1000;
+    auto rateLimiterManager = std::make_shared<RateLimiterManager>(rateLimiterConfig);
+    auto groupRateLimiter = std::make_shared<FakeRateLimiter>();
+    rateLimiterManager->registerRateLimiter("group0", groupRateLimiter);
+    auto rateLimiterStat = std::make_shared<RateLimiterStat>();
+    GatewayRateLimiter gatewayRateLimiter(rateLimiterManager, rateLimiterStat);
+
+    // over the group quota, delayed by 100ms
+    groupRateLimiter->m_allow = false;
+    uint64_t sendTime = 0;
+    auto startTime = utcSteadyTime();
+    BOOST_CHECK(gatewayRateLimiter.checkOutGoing("127.0.0.1", "group0", 1000, 100, sendTime).first);
+    BOOST_CHECK_GE(sendTime, startTime + 100);
+    BOOST_CHECK_EQUAL(groupRateLimiter->m_acquired, 100);
+
+    // the permits are produced meanwhile, the following messages of the module still wait behind
+    // the delayed one, in order
+    groupRateLimiter->m_allow = true;
+    auto lastSendTime = sendTime;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        BOOST_CHECK(
+            gatewayRateLimiter.checkOutGoing("127.0.0.1", "group0", 1000, 10, sendTime).first);
+        BOOST_CHECK_GE(sendTime, lastSendTime);
+        lastSendTime = sendTime;
+    }
+    BOOST_CHECK_EQUAL(groupRateLimiter->m_acquired, 150);
+
+    // the other modules are not blocked
+    BOOST_CHECK(gatewayRateLimiter.checkOutGoing("127.0.0.1", "group0", 2000, 10, sendTime).first);
+    BOOST_CHECK_EQUAL(sendTime, 0);
+
+    // sent at once after the delayed messages of the module are sent
+    auto now = utcSteadyTime();
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(lastSendTime > now ? lastSendTime - now + 1 : 0));
+    BOOST_CHECK(gatewayRateLimiter.checkOutGoing("127.0.0.1", "group0", 1000, 10, sendTime).first);
+    BOOST_CHECK_EQUAL(sendTime, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_distributedRateLimiterLocalCache)
+{
+    // fetch 10% of the permits from redis every time
+    auto rateLimiter = std::make_shared<FakeDistributedRateLimiter>(
+        nullptr, "test", 1000, 60, true, 10);
+    rateLimiter->m_permits = 1000;
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK(rateLimiter->tryAcquire(10));
+    }
+    BOOST_CHECK_EQUAL(rateLimiter->m_requestCount, 1);
+    BOOST_CHECK_EQUAL(rateLimiter->localCachePermits(), 0);
+
+    // the permits rejected by redis are not requested again in this interval
+    int64_t acquired = 100;
+    while (rateLimiter->tryAcquire(10))
+    {
+        acquired += 10;
+    }
+    BOOST_CHECK_EQUAL(acquired, 1000);
+    auto requestCount = rateLimiter->m_requestCount.load();
+    BOOST_CHECK(!rateLimiter->tryAcquire(10));
+    BOOST_CHECK(!rateLimiter->tryAcquire(20));
+    BOOST_CHECK_EQUAL(rateLimiter->m_requestCount, requestCount);
+
+    // the next interval
+    rateLimiter->m_permits = 1000;
+    rateLimiter->refreshLocalCache();
+    BOOST_CHECK(rateLimiter->tryAcquire(10));
+    BOOST_CHECK_EQUAL(rateLimiter->localCachePercent(), 10);
+    BOOST_CHECK_EQUAL(rateLimiter->localCachePermits(), 90);
+
+    // without the local cache every acquire requests redis
+    auto noCacheRateLimiter = std::make_shared<FakeDistributedRateLimiter>(
+        nullptr, "test", 1000, 60, false, 10);
+    noCacheRateLimiter->m_permits = 1000;
+    BOOST_CHECK(noCacheRateLimiter->tryAcquire(10));
+    BOOST_CHECK(noCacheRateLimiter->tryAcquire(10));
+    BOOST_CHECK_EQUAL(noCacheRateLimiter->m_requestCount, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
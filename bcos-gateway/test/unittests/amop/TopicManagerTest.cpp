@@ -20,6 +20,7 @@
  */
 #include "bcos-gateway/libamop/AirTopicManager.h"
 #include <bcos-gateway/libamop/TopicManager.h>
+#include <bcos-gateway/libamop/TopicTrie.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <boost/test/unit_test.hpp>
 
@@ -136,4 +137,115 @@ BOOST_AUTO_TEST_CASE(test_subTopics)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_topicTrie)
+{
+    TopicTrie trie;
+    trie.insert("a.b", "client0");
+    trie.insert("a.*", "client1");
+    trie.insert("a.b*", "client1");
+    trie.insert("*", "client2");
+    trie.insert("a.b", "client3");
+
+    std::vector<std::string> subscribers;
+    trie.match("a.b", subscribers);
+    BOOST_CHECK((subscribers == std::vector<std::string>{"client0", "client1", "client2", "client3"}));
+
+    subscribers.clear();
+    trie.match("a.c", subscribers);
+    BOOST_CHECK((subscribers == std::vector<std::string>{"client1", "client2"}));
+
+    trie.erase("*", "client2");
+    trie.erase("a.*", "client1");
+    subscribers.clear();
+    trie.match("a.c", subscribers);
+    BOOST_CHECK(subscribers.empty());
+    subscribers.clear();
+    trie.match("a.bc", subscribers);
+    BOOST_CHECK((subscribers == std::vector<std::string>{"client1"}));
+
+    trie.erase("a.b*", "client1");
+    trie.erase("a.b", "client0");
+    trie.erase("a.b", "client3");
+    BOOST_CHECK(trie.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_wildcardClients)
+{
+    auto topicManager = std::make_shared<LocalTopicManager>("", nullptr);
+    topicManager->subTopic("client0", TopicItems{TopicItem("orders.*"), TopicItem("blocks")});
+    topicManager->subTopic("client1", TopicItems{TopicItem("orders.new")});
+
+    std::vector<std::string> clients;
+    topicManager->queryClientsByTopic("orders.new", clients);
+    BOOST_CHECK((clients == std::vector<std::string>{"client0", "client1"}));
+    clients.clear();
+    topicManager->queryClientsByTopic("orders.cancel", clients);
+    BOOST_CHECK((clients == std::vector<std::string>{"client0"}));
+
+    // override the topics of client0
+    topicManager->subTopic("client0", TopicItems{TopicItem("blocks")});
+    clients.clear();
+    topicManager->queryClientsByTopic("orders.cancel", clients);
+    BOOST_CHECK(clients.empty());
+
+    topicManager->removeTopicsByClient("client1");
+    clients.clear();
+    topicManager->queryClientsByTopic("orders.new", clients);
+    BOOST_CHECK(clients.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_topicsDelta)
+{
+    auto sender = std::make_shared<LocalTopicManager>("", nullptr);
+    auto receiver = std::make_shared<LocalTopicManager>("", nullptr);
+    std::string nodeID = "sender";
+
+    sender->subTopic("client0", TopicItems{TopicItem("a"), TopicItem("b")});
+    sender->subTopic("client1", TopicItems{TopicItem("b")});
+
+    // unknown sender, fetch all topics
+    BOOST_CHECK(receiver->requestTopicsJson(nodeID).empty());
+    BOOST_CHECK(sender->queryTopicsDeltaByRequest("").empty());
+    uint64_t topicEpoch = 0;
+    uint32_t topicSeq = 0;
+    TopicItems topicItems;
+    BOOST_CHECK(receiver->parseTopicItemsJson(
+        topicEpoch, topicSeq, topicItems, sender->queryTopicsSubByClient()));
+    BOOST_CHECK_EQUAL(topicEpoch, sender->topicEpoch());
+    BOOST_CHECK_EQUAL(topicItems.size(), 2);
+    receiver->updateSeqAndTopicsByNodeID(nodeID, topicSeq, topicItems, topicEpoch);
+    BOOST_CHECK(!receiver->checkTopicSeq(nodeID, sender->topicSeq()));
+
+    // b is still subscribed by client1, only a and c change
+    sender->subTopic("client0", TopicItems{TopicItem("c")});
+    sender->removeTopics("client1", {"x"});
+    BOOST_CHECK(receiver->checkTopicSeq(nodeID, sender->topicSeq()));
+
+    auto deltaJson = sender->queryTopicsDeltaByRequest(receiver->requestTopicsJson(nodeID));
+    BOOST_CHECK(!deltaJson.empty());
+    TopicsDelta delta;
+    BOOST_CHECK(receiver->parseTopicsDeltaJson(deltaJson, delta));
+    BOOST_CHECK((delta.subscribed == std::vector<std::string>{"c"}));
+    BOOST_CHECK((delta.unsubscribed == std::vector<std::string>{"a"}));
+    BOOST_CHECK(receiver->applyTopicsDeltaByNodeID(nodeID, delta));
+    BOOST_CHECK(!receiver->checkTopicSeq(nodeID, sender->topicSeq()));
+
+    // applied twice: the fromSeq mismatch, the state is dropped
+    BOOST_CHECK(!receiver->applyTopicsDeltaByNodeID(nodeID, delta));
+    BOOST_CHECK(receiver->requestTopicsJson(nodeID).empty());
+
+    // another epoch, restarted sender
+    auto restarted = std::make_shared<LocalTopicManager>("", nullptr);
+    receiver->updateSeqAndTopicsByNodeID(nodeID, 1, TopicItems{}, sender->topicEpoch());
+    BOOST_CHECK(restarted->queryTopicsDeltaByRequest(receiver->requestTopicsJson(nodeID)).empty());
+
+    // the changes beyond MAX_TOPIC_CHANGES are dropped
+    auto request = receiver->requestTopicsJson(nodeID);
+    for (size_t i = 0; i <= TopicManager::MAX_TOPIC_CHANGES; ++i)
+    {
+        sender->subTopic("client2", TopicItems{TopicItem("t" + std::to_string(i))});
+    }
+    BOOST_CHECK(sender->queryTopicsDeltaByRequest(request).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -143,6 +143,7 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
             });
         return;
     }
+    auto prewriteStart = utcTime();
     auto header = block->blockHeaderConst();
 
     auto blockNumberStr = boost::lexical_cast<std::string>(header->number());
@@ -252,6 +253,7 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     number2TransactionHashesEntry.importFields({std::move(transactionsBuffer)});
     storage->asyncSetRow(SYS_NUMBER_2_TXS, blockNumberStr, std::move(number2TransactionHashesEntry),
         [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
+    auto writeBlockTime = utcTime() - prewriteStart;
 
     std::atomic_int64_t totalCount = 0;
     std::atomic_int64_t failedCount = 0;
@@ -316,7 +318,8 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
 
     // total transaction count
     asyncGetTotalTransactionCount(
-        [storage, block, &setRowCallback, &totalCount, &failedCount](
+        [storage, block, &setRowCallback, &totalCount, &failedCount, prewriteStart,
+            writeBlockTime](
             Error::Ptr error, int64_t total, int64_t failed, bcos::protocol::BlockNumber) {
             if (error)
             {
@@ -347,7 +350,9 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
             LEDGER_LOG(INFO) << METRIC << LOG_DESC("asyncPrewriteBlock")
                              << LOG_KV("number", block->blockHeaderConst()->number())
                              << LOG_KV("totalTxs", totalTxsCount) << LOG_KV("failedTxs", failedTxs)
-                             << LOG_KV("incTxs", totalCount) << LOG_KV("incFailedTxs", failedCount);
+                             << LOG_KV("incTxs", totalCount) << LOG_KV("incFailedTxs", failedCount)
+                             << LOG_KV("writeBlockTime(ms)", writeBlockTime)
+                             << LOG_KV("timeCost", utcTime() - prewriteStart);
         });
 }
 
@@ -399,9 +404,29 @@ bcos::Error::Ptr Ledger::storeTransactionsAndReceipts(
     auto start = utcTime();
     bcos::Error::Ptr error = nullptr;
     auto txSize = std::max(block->transactionsSize(), block->transactionsMetaDataSize());
+    auto blockNumber = block->blockHeaderConst()->number();
+    // put the rows into the write batch of the block, written to the disk by one write with the
+    // state and the other ledger tables when the block committed
+    auto transactionalStorage =
+        m_enableGroupCommit ?
+            std::dynamic_pointer_cast<bcos::storage::TransactionalStorageInterface>(m_storage) :
+            nullptr;
+    bcos::protocol::TwoPCParams params;
+    params.number = blockNumber;
+    auto setRows = [storage = m_storage, transactionalStorage, params](std::string_view table,
+                       auto&& keys, auto&& values) {
+        if (transactionalStorage)
+        {
+            return transactionalStorage->prepareRows(params, table,
+                std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values));
+        }
+        return storage->setRows(
+            table, std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values));
+    };
 
     std::vector<std::string> txsHash(txSize);
-    std::vector<bytes> receipts(txSize);
+    // the receipts keep the encoded data viewed by receiptsView alive
+    std::vector<bcos::protocol::TransactionReceipt::ConstPtr> receipts(txSize);
     std::vector<std::string_view> receiptsView(txSize);
     tbb::parallel_for(tbb::blocked_range<size_t>(0, txSize),
         [&blockTxs, &block, &txsHash, &receipts, &receiptsView](
@@ -410,49 +435,69 @@ bcos::Error::Ptr Ledger::storeTransactionsAndReceipts(
             {
                 auto hash = blockTxs ? blockTxs->at(i)->hash() : block->transaction(i)->hash();
                 txsHash[i] = std::string((char*)hash.data(), hash.size());
-                auto receipt = block->receipt(i);
-                receipt->encode(receipts[i]);
-                receiptsView[i] = std::string_view((char*)receipts[i].data(), receipts[i].size());
+                receipts[i] = block->receipt(i);
+                // the encoded receipt decoded from the block is reused without encoding again
+                auto encodedData = receipts[i]->encodedData();
+                receiptsView[i] =
+                    std::string_view((const char*)encodedData.data(), encodedData.size());
             }
         });
+    auto encodeReceiptsTime = utcTime() - start;
+    auto cachedReceipts =
+        m_ledgerCache ? receipts : std::vector<bcos::protocol::TransactionReceipt::ConstPtr>();
     auto promise = std::make_shared<std::promise<bcos::Error::Ptr>>();
-    m_threadPool->enqueue([storage = m_storage, promise, keys = std::move(txsHash),
-                              values = std::move(receiptsView)]() mutable {
-        auto err = storage->setRows(SYS_HASH_2_RECEIPT, std::move(keys), std::move(values));
+    m_threadPool->enqueue([setRows, promise, keys = std::move(txsHash),
+                              values = std::move(receiptsView),
+                              receipts = std::move(receipts)]() mutable {
+        auto err = setRows(SYS_HASH_2_RECEIPT, std::move(keys), std::move(values));
         promise->set_value(err);
     });
-    auto txsToStore = std::make_shared<std::vector<bytes>>();
-    txsToStore->reserve(txSize);
-    auto txsToStoreHash = std::make_shared<HashList>();
-    txsToStoreHash->reserve(txSize);
+    // the transactions keep the encoded data viewed by txsView alive
+    std::vector<bcos::protocol::Transaction::ConstPtr> txs(txSize);
+    auto txsToStoreHash = std::make_shared<HashList>(txSize);
+    std::vector<std::string_view> txsView(txSize);
+
+    RecursiveGuard guard(m_mutex);
+    auto encodeTxsStart = utcTime();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, txSize),
+        [&blockTxs, &block, &txs, &txsToStoreHash, &txsView](
+            const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i)
+            {
+                auto tx = blockTxs ? blockTxs->at(i) : block->transaction(i);
+                txs[i] = tx;
+                if (blockTxs && tx->storeToBackend())
+                {
+                    continue;
+                }
+                (*txsToStoreHash)[i] = tx->hash();
+                auto encodedData = tx->encodedData();
+                txsView[i] = std::string_view((const char*)encodedData.data(), encodedData.size());
+            }
+        });
     std::vector<std::string_view> keys;
     keys.reserve(txSize);
     std::vector<std::string_view> values;
     values.reserve(txSize);
-    auto blockNumber = block->blockHeaderConst()->number();
-
-    RecursiveGuard guard(m_mutex);
     size_t unstoredTxs = 0;
     for (size_t i = 0; i < txSize; i++)
     {
-        auto tx = blockTxs ? blockTxs->at(i) : block->transaction(i);
-        if (blockTxs && tx->storeToBackend())
+        // the stored transactions are skipped, an encoded transaction is never empty
+        if (txsView[i].empty())
         {
             continue;
         }
-        bcos::bytes encodeData;
-        tx->encode(encodeData);
-        txsToStoreHash->emplace_back(tx->hash());
-        txsToStore->emplace_back(std::move(encodeData));
-        keys.push_back(bcos::concepts::bytebuffer::toView((*txsToStoreHash)[unstoredTxs]));
-        values.push_back(bcos::concepts::bytebuffer::toView((*txsToStore)[unstoredTxs]));
+        keys.push_back(bcos::concepts::bytebuffer::toView((*txsToStoreHash)[i]));
+        values.push_back(txsView[i]);
         ++unstoredTxs;
     }
+    auto encodeTxsTime = utcTime() - encodeTxsStart;
+    auto writeTxsStart = utcTime();
     if (!keys.empty())
     {
         // asyncPreStoreBlockTxs also write txs to DB, needStoreUnsavedTxs is out of lock, so
         // the transactions may be write twice
-        error = m_storage->setRows(SYS_HASH_2_TX, std::move(keys), std::move(values));
+        error = setRows(SYS_HASH_2_TX, std::move(keys), std::move(values));
         if (error)
         {
             LEDGER_LOG(ERROR) << LOG_DESC("ledger write transactions failed")
@@ -469,6 +514,8 @@ bcos::Error::Ptr Ledger::storeTransactionsAndReceipts(
             }
         }
     }
+    auto writeTxsTime = utcTime() - writeTxsStart;
+    auto waitReceiptsStart = utcTime();
     auto err = promise->get_future().get();
     if (err)
     {
@@ -477,11 +524,21 @@ bcos::Error::Ptr Ledger::storeTransactionsAndReceipts(
                           << LOG_KV("message", err->errorMessage());
         return err;
     }
-    auto writeReceiptsTime = utcTime();
+    auto waitReceiptsTime = utcTime() - waitReceiptsStart;
+    if (m_ledgerCache)
+    {
+        // readable after the block committed
+        m_ledgerCache->stage(block->blockHeaderConst(), std::move(txs), std::move(cachedReceipts));
+    }
 
-    LEDGER_LOG(INFO) << LOG_DESC("storeTransactionsAndReceipts finished")
+    LEDGER_LOG(INFO) << METRIC << LOG_DESC("storeTransactionsAndReceipts finished")
                      << LOG_KV("blockNumber", blockNumber) << LOG_KV("blockTxsSize", txSize)
                      << LOG_KV("unStoredTxs", unstoredTxs)
+                     << LOG_KV("groupCommit", transactionalStorage != nullptr)
+                     << LOG_KV("encodeReceiptsTime(ms)", encodeReceiptsTime)
+                     << LOG_KV("encodeTxsTime(ms)", encodeTxsTime)
+                     << LOG_KV("writeTxsTime(ms)", writeTxsTime)
+                     << LOG_KV("waitReceiptsTime(ms)", waitReceiptsTime)
                      << LOG_KV("timeCost", (utcTime() - start));
     return nullptr;
 }
@@ -635,7 +692,7 @@ void Ledger::asyncGetBlockNumber(
     std::function<void(Error::Ptr, bcos::protocol::BlockNumber)> _onGetBlock)
 {
     asyncGetSystemTableEntry(SYS_CURRENT_STATE, SYS_KEY_CURRENT_NUMBER,
-        [callback = std::move(_onGetBlock)](
+        [ledgerCache = m_ledgerCache, callback = std::move(_onGetBlock)](
             Error::Ptr&& error, std::optional<bcos::storage::Entry>&& entry) {
             if (error)
             {
@@ -660,6 +717,10 @@ void Ledger::asyncGetBlockNumber(
             }
 
             LEDGER_LOG(TRACE) << "GetBlockNumber success" << LOG_KV("blockNumber", blockNumber);
+            if (ledgerCache)
+            {
+                ledgerCache->onCommitted(blockNumber);
+            }
             callback(nullptr, blockNumber);
         });
 }
@@ -676,6 +737,15 @@ void Ledger::asyncGetBlockHashByNumber(bcos::protocol::BlockNumber _blockNumber,
         return;
     }
 
+    if (m_ledgerCache)
+    {
+        if (auto header = m_ledgerCache->header(_blockNumber))
+        {
+            _onGetBlock(nullptr, header->hash());
+            return;
+        }
+    }
+
     auto key = boost::lexical_cast<std::string>(_blockNumber);
     asyncGetSystemTableEntry(SYS_NUMBER_2_HASH, key,
         [callback = std::move(_onGetBlock)](
@@ -712,6 +782,14 @@ void Ledger::asyncGetBlockNumberByHash(const crypto::HashType& _blockHash,
 {
     auto key = _blockHash;
     LEDGER_LOG(TRACE) << "GetBlockNumberByHash request" << LOG_KV("hash", key.hex());
+    if (m_ledgerCache)
+    {
+        if (auto number = m_ledgerCache->blockNumber(_blockHash))
+        {
+            _onGetBlock(nullptr, *number);
+            return;
+        }
+    }
 
     asyncGetSystemTableEntry(SYS_HASH_2_NUMBER, bcos::concepts::bytebuffer::toView(key),
         [callback = std::move(_onGetBlock)](
@@ -848,8 +926,46 @@ void Ledger::asyncGetTransactionReceiptByHash(bcos::crypto::HashType const& _txH
 
     LEDGER_LOG(TRACE) << "GetTransactionReceiptByHash" << LOG_KV("hash", key);
 
+    auto onGetReceipt = [this, _withProof](protocol::TransactionReceipt::Ptr receipt,
+                            std::function<void(Error::Ptr, protocol::TransactionReceipt::ConstPtr,
+                                MerkleProofPtr)>
+                                callback) {
+        if (_withProof)
+        {
+            getReceiptProof(
+                receipt, [receipt, _onGetTx = callback](Error::Ptr _error, MerkleProofPtr _proof) {
+                    if (_error)
+                    {
+                        LEDGER_LOG(DEBUG) << "GetTransactionReceiptByHash"
+                                          << LOG_KV("code", _error->errorCode())
+                                          << LOG_KV("msg", _error->errorMessage())
+                                          << boost::diagnostic_information(_error);
+                        _onGetTx(std::move(_error), receipt, nullptr);
+                        return;
+                    }
+
+                    _onGetTx(nullptr, receipt, std::move(_proof));
+                });
+        }
+        else
+        {
+            callback(nullptr, receipt, nullptr);
+        }
+    };
+    if (m_ledgerCache)
+    {
+        // the cached receipt is shared read-only
+        if (auto receipt =
+                m_ledgerCache->receipt(bcos::concepts::bytebuffer::toView(_txHash)))
+        {
+            onGetReceipt(
+                std::const_pointer_cast<protocol::TransactionReceipt>(receipt), std::move(_onGetTx));
+            return;
+        }
+    }
+
     asyncGetSystemTableEntry(SYS_HASH_2_RECEIPT, bcos::concepts::bytebuffer::toView(key),
-        [this, callback = std::move(_onGetTx), _withProof](
+        [this, callback = std::move(_onGetTx), onGetReceipt](
             Error::Ptr&& error, std::optional<bcos::storage::Entry>&& entry) {
             if (error)
             {
@@ -865,28 +981,7 @@ void Ledger::asyncGetTransactionReceiptByHash(bcos::crypto::HashType const& _txH
             auto value = entry->getField(0);
             auto receipt = m_blockFactory->receiptFactory()->createReceipt(
                 bcos::bytesConstRef((bcos::byte*)value.data(), value.size()));
-
-            if (_withProof)
-            {
-                getReceiptProof(receipt,
-                    [receipt, _onGetTx = callback](Error::Ptr _error, MerkleProofPtr _proof) {
-                        if (_error)
-                        {
-                            LEDGER_LOG(DEBUG) << "GetTransactionReceiptByHash"
-                                              << LOG_KV("code", _error->errorCode())
-                                              << LOG_KV("msg", _error->errorMessage())
-                                              << boost::diagnostic_information(_error);
-                            _onGetTx(std::move(_error), receipt, nullptr);
-                            return;
-                        }
-
-                        _onGetTx(nullptr, receipt, std::move(_proof));
-                    });
-            }
-            else
-            {
-                callback(nullptr, receipt, nullptr);
-            }
+            onGetReceipt(std::move(receipt), callback);
         });
 }
 
@@ -1069,7 +1164,7 @@ void Ledger::asyncGetNonceList(bcos::protocol::BlockNumber _startNumber, int64_t
             return boost::lexical_cast<std::string>(blockNumber);
         }) | RANGES::to<std::vector<std::string>>();
 
-        table->asyncGetRows(numberList, [this, numberRange, callback = std::move(callback)](
+        table->asyncGetRows(numberList, [this, _startNumber, callback = std::move(callback)](
                                             auto&& error,
                                             std::vector<std::optional<Entry>>&& entries) {
             if (error)
@@ -1081,30 +1176,40 @@ void Ledger::asyncGetNonceList(bcos::protocol::BlockNumber _startNumber, int64_t
                 return;
             }
 
+            // decode the blocks of the nonces in parallel, they are loaded at startup
+            std::vector<NonceListPtr> nonceLists(entries.size());
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, entries.size()),
+                [this, &entries, &nonceLists](const tbb::blocked_range<size_t>& range) {
+                    for (auto i = range.begin(); i < range.end(); ++i)
+                    {
+                        auto const& entry = entries[i];
+                        if (!entry)
+                        {
+                            continue;
+                        }
+                        try
+                        {
+                            auto value = entry->getField(0);
+                            auto block = m_blockFactory->createBlock(
+                                bcos::bytesConstRef((bcos::byte*)value.data(), value.size()),
+                                false, false);
+                            nonceLists[i] = std::make_shared<NonceList>(
+                                block->nonceList() | RANGES::to<NonceList>());
+                        }
+                        catch (std::exception const& e)
+                        {
+                            LEDGER_LOG(WARNING) << "Parse nonce list error"
+                                                << boost::diagnostic_information(e);
+                        }
+                    }
+                });
             auto retMap =
                 std::make_shared<std::map<protocol::BlockNumber, protocol::NonceListPtr>>();
-
-            for (auto const& [number, entry] : RANGES::zip_view(numberRange, entries))
+            for (size_t i = 0; i < nonceLists.size(); ++i)
             {
-                try
-                {
-                    if (!entry)
-                    {
-                        continue;
-                    }
-
-                    auto value = entry->getField(0);
-                    auto block = m_blockFactory->createBlock(
-                        bcos::bytesConstRef((bcos::byte*)value.data(), value.size()), false, false);
-
-                    retMap->emplace(std::make_pair(number,
-                        std::make_shared<NonceList>(block->nonceList() | RANGES::to<NonceList>())));
-                }
-                catch (std::exception const& e)
+                if (nonceLists[i])
                 {
-                    LEDGER_LOG(WARNING)
-                        << "Parse nonce list error" << boost::diagnostic_information(e);
-                    continue;
+                    retMap->emplace(_startNumber + (BlockNumber)i, std::move(nonceLists[i]));
                 }
             }
 
@@ -1214,6 +1319,15 @@ Error::Ptr Ledger::checkEntryValid(Error::UniquePtr&& error,
 void Ledger::asyncGetBlockHeader(bcos::protocol::Block::Ptr block,
     bcos::protocol::BlockNumber blockNumber, std::function<void(Error::Ptr&&)> callback)
 {
+    if (m_ledgerCache)
+    {
+        if (auto header = m_ledgerCache->header(blockNumber))
+        {
+            block->setBlockHeader(std::const_pointer_cast<bcos::protocol::BlockHeader>(header));
+            callback(nullptr);
+            return;
+        }
+    }
     m_storage->asyncOpenTable(SYS_NUMBER_2_BLOCK_HEADER,
         [this, blockNumber, block, callback](auto&& error, std::optional<Table>&& table) {
             auto validError = checkTableValid(std::move(error), table, SYS_NUMBER_2_BLOCK_HEADER);
@@ -1246,6 +1360,14 @@ void Ledger::asyncGetBlockHeader(bcos::protocol::Block::Ptr block,
 void Ledger::asyncGetBlockTransactionHashes(bcos::protocol::BlockNumber blockNumber,
     std::function<void(Error::Ptr&&, std::vector<std::string>&&)> callback)
 {
+    if (m_ledgerCache)
+    {
+        if (auto hashes = m_ledgerCache->transactionHashes(blockNumber))
+        {
+            callback(nullptr, std::move(*hashes));
+            return;
+        }
+    }
     m_storage->asyncOpenTable(SYS_NUMBER_2_TXS,
         [this, blockNumber, callback](auto&& error, std::optional<Table>&& table) {
             auto validError = checkTableValid(std::move(error), table, SYS_NUMBER_2_BLOCK_HEADER);
@@ -1285,6 +1407,26 @@ void Ledger::asyncGetBlockTransactionHashes(bcos::protocol::BlockNumber blockNum
 void Ledger::asyncBatchGetTransactions(std::shared_ptr<std::vector<std::string>> hashes,
     std::function<void(Error::Ptr&&, std::vector<protocol::Transaction::Ptr>&&)> callback)
 {
+    if (m_ledgerCache)
+    {
+        // the cached transactions are shared read-only, read all from the storage if any missed
+        std::vector<protocol::Transaction::Ptr> transactions;
+        transactions.reserve(hashes->size());
+        for (auto const& hash : *hashes)
+        {
+            auto transaction = m_ledgerCache->transaction(hash);
+            if (!transaction)
+            {
+                break;
+            }
+            transactions.emplace_back(std::const_pointer_cast<protocol::Transaction>(transaction));
+        }
+        if (transactions.size() == hashes->size())
+        {
+            callback(nullptr, std::move(transactions));
+            return;
+        }
+    }
     m_storage->asyncOpenTable(
         SYS_HASH_2_TX, [this, hashes, callback](auto&& error, std::optional<Table>&& table) {
             auto validError =
@@ -1357,6 +1499,25 @@ void Ledger::asyncBatchGetTransactions(std::shared_ptr<std::vector<std::string>>
 void Ledger::asyncBatchGetReceipts(std::shared_ptr<std::vector<std::string>> hashes,
     std::function<void(Error::Ptr&&, std::vector<protocol::TransactionReceipt::Ptr>&&)> callback)
 {
+    if (m_ledgerCache)
+    {
+        std::vector<protocol::TransactionReceipt::Ptr> receipts;
+        receipts.reserve(hashes->size());
+        for (auto const& hash : *hashes)
+        {
+            auto receipt = m_ledgerCache->receipt(hash);
+            if (!receipt)
+            {
+                break;
+            }
+            receipts.emplace_back(std::const_pointer_cast<protocol::TransactionReceipt>(receipt));
+        }
+        if (receipts.size() == hashes->size())
+        {
+            callback(nullptr, std::move(receipts));
+            return;
+        }
+    }
     m_storage->asyncOpenTable(
         SYS_HASH_2_RECEIPT, [this, hashes, callback](auto&& error, std::optional<Table>&& table) {
             auto validError = checkTableValid(std::move(error), table, SYS_HASH_2_RECEIPT);
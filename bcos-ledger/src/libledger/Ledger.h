@@ -25,6 +25,7 @@
 #include "bcos-framework/protocol/ProtocolTypeDef.h"
 #include "bcos-framework/storage/Common.h"
 #include "bcos-framework/storage/StorageInterface.h"
+#include "LedgerCache.h"
 #include "utilities/Common.h"
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Exceptions.h>
@@ -47,6 +48,12 @@ public:
 
     ~Ledger() override = default;
 
+    // write the transactions and the receipts into the write batch of the block committing
+    void setEnableGroupCommit(bool _enableGroupCommit) { m_enableGroupCommit = _enableGroupCommit; }
+    // serve the reads of the latest blocks from the cache populated by the blocks committed
+    void setLedgerCache(LedgerCache::Ptr _ledgerCache) { m_ledgerCache = std::move(_ledgerCache); }
+    LedgerCache::Ptr const& ledgerCache() const { return m_ledgerCache; }
+
     void asyncPreStoreBlockTxs(bcos::protocol::TransactionsPtr _blockTxs,
         bcos::protocol::Block::ConstPtr block,
         std::function<void(Error::UniquePtr&&)> _callback) override;
@@ -153,5 +160,7 @@ private:
 
     mutable RecursiveMutex m_mutex;
     std::shared_ptr<bcos::ThreadPool> m_threadPool;
+    bool m_enableGroupCommit = false;
+    LedgerCache::Ptr m_ledgerCache;
 };
 }  // namespace bcos::ledger
\ No newline at end of file
@@ -0,0 +1,166 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache of the latest committed blocks for the RPC reads
+ * @file LedgerCache.cpp
+ * @date 2022-12-12
+ */
+#include "LedgerCache.h"
+#include "Ledger.h"
+#include <bcos-framework/Common.h>
+
+using namespace bcos;
+using namespace bcos::ledger;
+using namespace bcos::protocol;
+
+void LedgerCache::stage(BlockHeader::ConstPtr _header,
+    std::vector<Transaction::ConstPtr> _transactions,
+    std::vector<TransactionReceipt::ConstPtr> _receipts)
+{
+    if (!_header || _transactions.size() != _receipts.size())
+    {
+        return;
+    }
+    CachedBlock block;
+    block.header = std::move(_header);
+    block.transactionHashes.reserve(_transactions.size());
+    for (size_t i = 0; i < _transactions.size(); ++i)
+    {
+        auto hash = _transactions[i]->hash();
+        block.transactionHashes.emplace_back((const char*)hash.data(), hash.size());
+        block.size += hash.size() + _transactions[i]->encodedData().size() +
+                      _receipts[i]->encodedData().size();
+    }
+    block.transactions = std::move(_transactions);
+    block.receipts = std::move(_receipts);
+
+    auto number = block.header->number();
+    WriteGuard lock(x_blocks);
+    // the blocks committed can't be staged again
+    if (!m_blocks.empty() && number <= m_blocks.rbegin()->first)
+    {
+        return;
+    }
+    m_stagedBlocks[number] = std::move(block);
+}
+
+void LedgerCache::onCommitted(BlockNumber _committedNumber)
+{
+    size_t committedBlocks = 0;
+    size_t cachedBlocks = 0;
+    size_t size = 0;
+    {
+        UpgradableGuard lock(x_blocks);
+        if (m_stagedBlocks.empty() || m_stagedBlocks.begin()->first > _committedNumber)
+        {
+            return;
+        }
+        UpgradeGuard writeLock(lock);
+        auto end = m_stagedBlocks.upper_bound(_committedNumber);
+        for (auto it = m_stagedBlocks.begin(); it != end; ++it)
+        {
+            auto number = it->first;
+            auto& block = it->second;
+            for (size_t i = 0; i < block.transactionHashes.size(); ++i)
+            {
+                m_txIndex[block.transactionHashes[i]] = {number, i};
+            }
+            auto blockHash = block.header->hash();
+            m_blockNumbers[std::string((const char*)blockHash.data(), blockHash.size())] = number;
+            m_size += block.size;
+            m_blocks[number] = std::move(block);
+            ++committedBlocks;
+        }
+        m_stagedBlocks.erase(m_stagedBlocks.begin(), end);
+        evict();
+        cachedBlocks = m_blocks.size();
+        size = m_size;
+    }
+    LEDGER_LOG(INFO) << METRIC << LOG_DESC("LedgerCache")
+                     << LOG_KV("committedNumber", _committedNumber)
+                     << LOG_KV("committedBlocks", committedBlocks)
+                     << LOG_KV("cachedBlocks", cachedBlocks) << LOG_KV("size", size)
+                     << LOG_KV("capacity", m_capacity) << LOG_KV("hits", m_hits)
+                     << LOG_KV("misses", m_misses) << LOG_KV("evictions", m_evictions);
+}
+
+void LedgerCache::evict()
+{
+    // keep the latest block even if it exceeds the capacity
+    while (m_size > m_capacity && m_blocks.size() > 1)
+    {
+        auto it = m_blocks.begin();
+        auto& block = it->second;
+        for (auto const& hash : block.transactionHashes)
+        {
+            m_txIndex.erase(hash);
+        }
+        auto blockHash = block.header->hash();
+        m_blockNumbers.erase(std::string((const char*)blockHash.data(), blockHash.size()));
+        m_size -= block.size;
+        m_blocks.erase(it);
+        ++m_evictions;
+    }
+}
+
+BlockHeader::ConstPtr LedgerCache::header(BlockNumber _number) const
+{
+    ReadGuard lock(x_blocks);
+    auto it = m_blocks.find(_number);
+    return countHit(it != m_blocks.end() ? it->second.header : nullptr);
+}
+
+std::optional<std::vector<std::string>> LedgerCache::transactionHashes(BlockNumber _number) const
+{
+    ReadGuard lock(x_blocks);
+    auto it = m_blocks.find(_number);
+    if (it == m_blocks.end())
+    {
+        return countHit(std::optional<std::vector<std::string>>());
+    }
+    return countHit(std::make_optional(it->second.transactionHashes));
+}
+
+Transaction::ConstPtr LedgerCache::transaction(std::string_view _hash) const
+{
+    ReadGuard lock(x_blocks);
+    auto it = m_txIndex.find(std::string(_hash));
+    if (it == m_txIndex.end())
+    {
+        return countHit(Transaction::ConstPtr());
+    }
+    auto const& [number, index] = it->second;
+    return countHit(m_blocks.at(number).transactions[index]);
+}
+
+TransactionReceipt::ConstPtr LedgerCache::receipt(std::string_view _hash) const
+{
+    ReadGuard lock(x_blocks);
+    auto it = m_txIndex.find(std::string(_hash));
+    if (it == m_txIndex.end())
+    {
+        return countHit(TransactionReceipt::ConstPtr());
+    }
+    auto const& [number, index] = it->second;
+    return countHit(m_blocks.at(number).receipts[index]);
+}
+
+std::optional<BlockNumber> LedgerCache::blockNumber(crypto::HashType const& _blockHash) const
+{
+    ReadGuard lock(x_blocks);
+    auto it = m_blockNumbers.find(std::string((const char*)_blockHash.data(), _blockHash.size()));
+    return countHit(
+        it != m_blockNumbers.end() ? std::make_optional(it->second) : std::optional<BlockNumber>());
+}
@@ -0,0 +1,109 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache of the latest committed blocks for the RPC reads
+ * @file LedgerCache.h
+ * @date 2022-12-12
+ */
+#pragma once
+#include "bcos-framework/protocol/BlockHeader.h"
+#include "bcos-framework/protocol/ProtocolTypeDef.h"
+#include "bcos-framework/protocol/Transaction.h"
+#include "bcos-framework/protocol/TransactionReceipt.h"
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+namespace bcos::ledger
+{
+/**
+ * @brief The decoded headers, transactions and receipts of the latest blocks, shared with the
+ * responses without copying. A block is staged when its transactions and receipts are stored,
+ * and becomes readable after the committed block number read from the storage reaches it, so
+ * that the blocks rolled back are never returned. The oldest blocks are evicted when the size,
+ * approximated by the encoded size of the transactions and receipts, exceeds the capacity.
+ */
+class LedgerCache
+{
+public:
+    using Ptr = std::shared_ptr<LedgerCache>;
+    constexpr static size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+    explicit LedgerCache(size_t _capacity = DEFAULT_CAPACITY) : m_capacity(_capacity) {}
+    virtual ~LedgerCache() = default;
+
+    // the staged block of the same number is replaced
+    virtual void stage(bcos::protocol::BlockHeader::ConstPtr _header,
+        std::vector<bcos::protocol::Transaction::ConstPtr> _transactions,
+        std::vector<bcos::protocol::TransactionReceipt::ConstPtr> _receipts);
+    // make the staged blocks no larger than _committedNumber readable
+    virtual void onCommitted(bcos::protocol::BlockNumber _committedNumber);
+
+    // nullptr or std::nullopt if not cached
+    bcos::protocol::BlockHeader::ConstPtr header(bcos::protocol::BlockNumber _number) const;
+    std::optional<std::vector<std::string>> transactionHashes(
+        bcos::protocol::BlockNumber _number) const;
+    bcos::protocol::Transaction::ConstPtr transaction(std::string_view _hash) const;
+    bcos::protocol::TransactionReceipt::ConstPtr receipt(std::string_view _hash) const;
+    std::optional<bcos::protocol::BlockNumber> blockNumber(
+        bcos::crypto::HashType const& _blockHash) const;
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    uint64_t evictions() const { return m_evictions; }
+
+private:
+    struct CachedBlock
+    {
+        bcos::protocol::BlockHeader::ConstPtr header;
+        std::vector<std::string> transactionHashes;
+        std::vector<bcos::protocol::Transaction::ConstPtr> transactions;
+        std::vector<bcos::protocol::TransactionReceipt::ConstPtr> receipts;
+        size_t size = 0;
+    };
+
+    template <class T>
+    T countHit(T _value) const
+    {
+        if (_value)
+        {
+            ++m_hits;
+        }
+        else
+        {
+            ++m_misses;
+        }
+        return _value;
+    }
+    void evict();
+
+    size_t m_capacity;
+    std::map<bcos::protocol::BlockNumber, CachedBlock> m_stagedBlocks;
+    std::map<bcos::protocol::BlockNumber, CachedBlock> m_blocks;
+    // the transaction hash => the number of the block and the index in it
+    std::unordered_map<std::string, std::pair<bcos::protocol::BlockNumber, size_t>> m_txIndex;
+    std::unordered_map<std::string, bcos::protocol::BlockNumber> m_blockNumbers;
+    size_t m_size = 0;
+    mutable SharedMutex x_blocks;
+
+    mutable std::atomic_uint64_t m_hits = {0};
+    mutable std::atomic_uint64_t m_misses = {0};
+    std::atomic_uint64_t m_evictions = {0};
+};
+}  // namespace bcos::ledger
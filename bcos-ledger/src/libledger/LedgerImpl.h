@@ -37,6 +37,7 @@ struct MismatchTransactionCount : public bcos::error::Exception {};
 struct MismatchParentHash: public bcos::error::Exception {};
 struct NotFoundBlockHeader: public bcos::error::Exception {};
 struct GetABIError : public bcos::error::Exception {};
+struct GetStateError : public bcos::error::Exception {};
 // clang-format on
 
 template <bcos::crypto::hasher::Hasher Hasher, bcos::concepts::storage::Storage Storage>
@@ -161,6 +162,65 @@ private:
         co_return abiStr;
     }
 
+    task::Task<void> impl_getStateProof(RANGES::range auto const& keys, auto& proof)
+    {
+        LEDGER_LOG(DEBUG) << "getStateProof: " << RANGES::size(keys);
+
+        auto versionEntry =
+            storage().getRow(ledger::SYS_CONFIG, ledger::SYSTEM_KEY_COMPATIBILITY_VERSION);
+        if (!versionEntry)
+        {
+            BOOST_THROW_EXCEPTION(GetStateError{} << bcos::error::ErrorMessage{
+                                      "get compatibilityVersion not found"});
+        }
+        auto [compatibilityVersionStr, number] =
+            versionEntry->template getObject<SystemConfigEntry>();
+        auto stateStorageFactory = std::make_shared<storage::StateStorageFactory>(m_keyPageSize);
+
+        // a block may be committed between the reads, read again until the block number is stable
+        constexpr static auto MAX_READ_TIMES = 3;
+        for (auto i = 0; i < MAX_READ_TIMES; ++i)
+        {
+            auto status = co_await impl_getStatus();
+            auto stateStorage = stateStorageFactory->createStateStorage(
+                m_backupStorage, bcos::tool::toVersionNumber(compatibilityVersionStr));
+
+            bcos::concepts::resizeTo(proof.values, RANGES::size(keys));
+            auto valueIt = RANGES::begin(proof.values);
+            for (auto const& stateKey : keys)
+            {
+                auto& value = *(valueIt++);
+                value.table = stateKey.table;
+                value.key = stateKey.key;
+
+                auto [error, entry] = stateStorage->getRow(stateKey.table, stateKey.key);
+                if (error)
+                {
+                    BOOST_THROW_EXCEPTION(GetStateError{}
+                                          << bcos::error::ErrorMessage{error->errorMessage()});
+                }
+                value.exists = entry.has_value();
+                value.value.clear();
+                if (entry)
+                {
+                    auto field = entry->get();
+                    value.value.assign(field.begin(), field.end());
+                }
+            }
+
+            auto currentStatus = co_await impl_getStatus();
+            if (currentStatus.blockNumber == status.blockNumber)
+            {
+                proof.blockNumber = status.blockNumber;
+                co_await impl_getBlockHashByNumber(status.blockNumber, proof.blockHash);
+                co_return;
+            }
+        }
+
+        BOOST_THROW_EXCEPTION(
+            GetStateError{} << bcos::error::ErrorMessage{"The block number keeps changing"});
+    }
+
     task::Task<void> impl_getTransactions(RANGES::range auto const& hashes, RANGES::range auto& out)
     {
         bcos::concepts::resizeTo(out, RANGES::size(hashes));
@@ -1000,6 +1000,70 @@ BOOST_AUTO_TEST_CASE(getTransactionReceiptByHash)
     BOOST_CHECK_EQUAL(f4.get(), true);
 }
 
+BOOST_AUTO_TEST_CASE(getFromLedgerCache)
+{
+    initFixture();
+    initChain(5);
+    auto ledgerCache = std::make_shared<LedgerCache>();
+    m_ledger->setLedgerCache(ledgerCache);
+    auto block = m_fakeBlocks->at(3);
+    auto txHash = block->transactionHash(0);
+    auto error = m_ledger->storeTransactionsAndReceipts(nullptr, block);
+    BOOST_CHECK(!error);
+
+    // not readable before committed
+    auto hashView = std::string_view((const char*)txHash.data(), txHash.size());
+    BOOST_CHECK(ledgerCache->receipt(hashView) == nullptr);
+    BOOST_CHECK_EQUAL(ledgerCache->misses(), 1);
+
+    std::promise<bool> p1;
+    m_ledger->asyncGetBlockNumber([&](Error::Ptr _error, BlockNumber _number) {
+        BOOST_CHECK(!_error);
+        BOOST_CHECK_EQUAL(_number, 5);
+        p1.set_value(true);
+    });
+    BOOST_CHECK_EQUAL(p1.get_future().get(), true);
+    BOOST_CHECK(ledgerCache->header(block->blockHeaderConst()->number()) != nullptr);
+    BOOST_CHECK_GT(ledgerCache->size(), 0);
+
+    // the receipt is shared from the cache, the proof is read from the storage
+    std::promise<bool> p2;
+    m_ledger->asyncGetTransactionReceiptByHash(txHash, true,
+        [&](Error::Ptr _error, TransactionReceipt::ConstPtr _receipt, MerkleProofPtr _proof) {
+            BOOST_CHECK_EQUAL(_error, nullptr);
+            BOOST_CHECK_EQUAL(_receipt->hash().hex(), block->receipt(0)->hash().hex());
+            BOOST_CHECK(_proof != nullptr);
+            BOOST_CHECK(merkleUtility.verifyMerkleProof(
+                *_proof, _receipt->hash(), block->blockHeader()->receiptsRoot()));
+            p2.set_value(true);
+        });
+    BOOST_CHECK_EQUAL(p2.get_future().get(), true);
+
+    std::promise<bool> p3;
+    auto hashes = std::make_shared<std::vector<std::string>>(1, std::string(hashView));
+    m_ledger->asyncBatchGetTransactions(
+        hashes, [&](Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _transactions) {
+            BOOST_CHECK(!_error);
+            BOOST_CHECK_EQUAL(_transactions.size(), 1);
+            BOOST_CHECK_EQUAL(_transactions[0]->hash().hex(), txHash.hex());
+            p3.set_value(true);
+        });
+    BOOST_CHECK_EQUAL(p3.get_future().get(), true);
+    BOOST_CHECK_GE(ledgerCache->hits(), 3);
+
+    // the oldest blocks are evicted, the latest one is kept
+    auto smallCache = std::make_shared<LedgerCache>(1);
+    m_ledger->setLedgerCache(smallCache);
+    for (int i = 2; i < 5; ++i)
+    {
+        BOOST_CHECK(!m_ledger->storeTransactionsAndReceipts(nullptr, m_fakeBlocks->at(i)));
+    }
+    smallCache->onCommitted(5);
+    BOOST_CHECK_EQUAL(smallCache->evictions(), 2);
+    BOOST_CHECK(smallCache->header(m_fakeBlocks->at(2)->blockHeaderConst()->number()) == nullptr);
+    BOOST_CHECK(smallCache->header(m_fakeBlocks->at(4)->blockHeaderConst()->number()) != nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(getNonceList)
 {
     initFixture();
@@ -54,7 +54,6 @@ public:
         }
         CONSENSUS_LOG(INFO) << LOG_DESC("Stop consensusEngine");
         m_started = false;
-        finishWorker();
         if (isWorking())
         {
             // stop the worker thread
@@ -66,10 +66,9 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
         }
         return;
     }
-    auto block = m_blockFactory->createBlock(_proposal->data());
+    auto block = createBlock(_lastAppliedProposal, _proposal);
     // invalid block
-    auto blockHeader = block->blockHeader();
-    if (!blockHeader)
+    if (!block)
     {
         if (_onExecuteFinished)
         {
@@ -77,30 +76,12 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
         }
         return;
     }
-    // set the parentHash information
-    if (_proposal->index() == _lastAppliedProposal->index() + 1)
-    {
-        ParentInfoList parentInfoList;
-        ParentInfo parentInfo{_lastAppliedProposal->index(), _lastAppliedProposal->hash()};
-        parentInfoList.push_back(parentInfo);
-        blockHeader->setParentInfo(parentInfoList);
-        CONSENSUS_LOG(DEBUG) << LOG_DESC("setParentInfo for the proposal")
-                             << LOG_KV("proposalIndex", _proposal->index())
-                             << LOG_KV("lastAppliedProposal", _lastAppliedProposal->index())
-                             << LOG_KV("parentHash", _lastAppliedProposal->hash().abridged());
-    }
-    else
-    {
-        CONSENSUS_LOG(FATAL) << LOG_DESC("invalid lastAppliedProposal")
-                             << LOG_KV("lastAppliedIndex", _lastAppliedProposal->index())
-                             << LOG_KV("proposal", _proposal->index());
-    }
-    blockHeader->calculateHash(*m_blockFactory->cryptoSuite()->hashImpl());
 
     // calls dispatcher to execute the block
     auto startT = utcTime();
-    m_scheduler->executeBlock(block, false,
-        [startT, block, _onExecuteFinished, _proposal, _executedProposal](
+    executeBlock(_proposal->hash(), block,
+        [startT, block, _onExecuteFinished, _proposal, _executedProposal,
+            executedNotifier = m_executedNotifier](
             Error::Ptr&& _error, BlockHeader::Ptr&& _blockHeader, bool _sysBlock) {
             if (!_onExecuteFinished)
             {
@@ -135,6 +116,11 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
                                        << LOG_KV("timeCost", (utcTime() - startT));
                 return;
             }
+            if (executedNotifier)
+            {
+                executedNotifier(_blockHeader->number(), block->transactionsHashSize(),
+                    utcTime() - startT);
+            }
             _executedProposal->setIndex(_blockHeader->number());
             _executedProposal->setHash(_blockHeader->hash());
 
@@ -179,4 +165,150 @@ void StateMachine::preApply(
                 _onPreApplyFinished(false);
             }
         });
-}
\ No newline at end of file
+}
+
+Block::Ptr StateMachine::createBlock(ProposalInterface::ConstPtr const& _lastAppliedProposal,
+    ProposalInterface::Ptr const& _proposal)
+{
+    auto block = m_blockFactory->createBlock(_proposal->data());
+    auto blockHeader = block->blockHeader();
+    if (!blockHeader)
+    {
+        return nullptr;
+    }
+    // set the parentHash information
+    if (_proposal->index() == _lastAppliedProposal->index() + 1)
+    {
+        ParentInfoList parentInfoList;
+        ParentInfo parentInfo{_lastAppliedProposal->index(), _lastAppliedProposal->hash()};
+        parentInfoList.push_back(parentInfo);
+        blockHeader->setParentInfo(parentInfoList);
+        CONSENSUS_LOG(DEBUG) << LOG_DESC("setParentInfo for the proposal")
+                             << LOG_KV("proposalIndex", _proposal->index())
+                             << LOG_KV("lastAppliedProposal", _lastAppliedProposal->index())
+                             << LOG_KV("parentHash", _lastAppliedProposal->hash().abridged());
+    }
+    else
+    {
+        CONSENSUS_LOG(FATAL) << LOG_DESC("invalid lastAppliedProposal")
+                             << LOG_KV("lastAppliedIndex", _lastAppliedProposal->index())
+                             << LOG_KV("proposal", _proposal->index());
+    }
+    blockHeader->calculateHash(*m_blockFactory->cryptoSuite()->hashImpl());
+    return block;
+}
+
+void StateMachine::asyncPreExecute(
+    ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal)
+{
+    auto self = weak_from_this();
+    m_worker->enqueue([self, _lastAppliedProposal, _proposal]() {
+        auto stateMachine = self.lock();
+        if (!stateMachine)
+        {
+            return;
+        }
+        stateMachine->preExecute(_lastAppliedProposal, _proposal);
+    });
+}
+
+void StateMachine::preExecute(
+    ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal)
+{
+    auto index = _proposal->index();
+    auto preExecution = std::make_shared<PreExecution>();
+    preExecution->proposalHash = _proposal->hash();
+    {
+        std::lock_guard<std::mutex> lock(x_preExecutions);
+        // the pre-executions of the lower proposals will never be applied
+        m_preExecutions.erase(m_preExecutions.begin(), m_preExecutions.lower_bound(index));
+        // only the first proposal of the index is pre-executed, the executed block of the index
+        // is cached by the scheduler
+        if (m_preExecutions.contains(index))
+        {
+            return;
+        }
+        m_preExecutions[index] = preExecution;
+    }
+    auto block = createBlock(_lastAppliedProposal, _proposal);
+    if (!block)
+    {
+        std::lock_guard<std::mutex> lock(x_preExecutions);
+        m_preExecutions.erase(index);
+        return;
+    }
+    auto startT = utcTime();
+    m_scheduler->executeBlock(block, false,
+        [preExecution, index, startT](
+            Error::Ptr&& _error, BlockHeader::Ptr&& _blockHeader, bool _sysBlock) {
+            std::vector<ExecuteCallback> waiters;
+            {
+                std::lock_guard<std::mutex> lock(preExecution->mutex);
+                preExecution->finished = true;
+                preExecution->error = _error;
+                preExecution->header = _blockHeader;
+                preExecution->sysBlock = _sysBlock;
+                waiters.swap(preExecution->waiters);
+            }
+            CONSENSUS_LOG(INFO) << METRIC << LOG_DESC("preExecute finished")
+                                << LOG_KV("index", index)
+                                << LOG_KV("hash", preExecution->proposalHash.abridged())
+                                << LOG_KV("code", _error ? _error->errorCode() : 0)
+                                << LOG_KV("waiters", waiters.size())
+                                << LOG_KV("timeCost", (utcTime() - startT));
+            for (auto& waiter : waiters)
+            {
+                auto error = _error;
+                auto blockHeader = _blockHeader;
+                waiter(std::move(error), std::move(blockHeader), _sysBlock);
+            }
+        });
+}
+
+void StateMachine::executeBlock(
+    HashType const& _proposalHash, Block::Ptr _block, ExecuteCallback _callback)
+{
+    auto index = _block->blockHeaderConst()->number();
+    PreExecution::Ptr preExecution;
+    {
+        std::lock_guard<std::mutex> lock(x_preExecutions);
+        auto it = m_preExecutions.find(index);
+        if (it != m_preExecutions.end())
+        {
+            if (it->second->proposalHash == _proposalHash)
+            {
+                preExecution = it->second;
+            }
+            else
+            {
+                // the scheduler re-executes the block of the index for the conflicting proposal
+                CONSENSUS_LOG(INFO) << LOG_DESC("discard the pre-executed proposal")
+                                    << LOG_KV("index", index)
+                                    << LOG_KV("preExecuted", it->second->proposalHash.abridged())
+                                    << LOG_KV("applied", _proposalHash.abridged());
+            }
+        }
+        m_preExecutions.erase(m_preExecutions.begin(), m_preExecutions.upper_bound(index));
+    }
+    if (preExecution)
+    {
+        std::unique_lock<std::mutex> lock(preExecution->mutex);
+        if (!preExecution->finished)
+        {
+            preExecution->waiters.emplace_back(std::move(_callback));
+            return;
+        }
+        if (!preExecution->error)
+        {
+            auto blockHeader = preExecution->header;
+            auto sysBlock = preExecution->sysBlock;
+            lock.unlock();
+            CONSENSUS_LOG(INFO) << LOG_DESC("hit the pre-executed proposal")
+                                << LOG_KV("index", index)
+                                << LOG_KV("hash", _proposalHash.abridged());
+            _callback(nullptr, std::move(blockHeader), sysBlock);
+            return;
+        }
+    }
+    m_scheduler->executeBlock(std::move(_block), false, std::move(_callback));
+}
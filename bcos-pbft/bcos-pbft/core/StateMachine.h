@@ -24,6 +24,8 @@
 #include <bcos-framework/protocol/BlockFactory.h>
 #include <bcos-utilities/ThreadPool.h>
 
+#include <map>
+#include <mutex>
 #include <utility>
 namespace bcos
 {
@@ -55,17 +57,56 @@ public:
     void asyncPreApply(
         ProposalInterface::Ptr _proposal, std::function<void(bool)> _onPreApplyFinished) override;
 
+    void asyncPreExecute(ProposalInterface::ConstPtr _lastAppliedProposal,
+        ProposalInterface::Ptr _proposal) override;
+
+    void registerExecutedNotifier(
+        std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> _executedNotifier)
+        override
+    {
+        m_executedNotifier = std::move(_executedNotifier);
+    }
+
 private:
+    using ExecuteCallback = std::function<void(
+        Error::Ptr&&, bcos::protocol::BlockHeader::Ptr&&, bool _sysBlock)>;
+    // the result of the pre-executed proposal, waited by the apply if not finished
+    struct PreExecution
+    {
+        using Ptr = std::shared_ptr<PreExecution>;
+        bcos::crypto::HashType proposalHash;
+        bool finished = false;
+        Error::Ptr error;
+        bcos::protocol::BlockHeader::Ptr header;
+        bool sysBlock = false;
+        std::vector<ExecuteCallback> waiters;
+        std::mutex mutex;
+    };
+
     void apply(ssize_t _execTimeout, ProposalInterface::ConstPtr _lastAppliedProposal,
         ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executedProposal,
         std::function<void(int64_t)> _onExecuteFinished);
 
     void preApply(ProposalInterface::Ptr _proposal, std::function<void(bool)> _onPreApplyFinished);
 
+    void preExecute(
+        ProposalInterface::ConstPtr _lastAppliedProposal, ProposalInterface::Ptr _proposal);
+    // the block to execute with the parent info, nullptr if the proposal is invalid
+    bcos::protocol::Block::Ptr createBlock(ProposalInterface::ConstPtr const& _lastAppliedProposal,
+        ProposalInterface::Ptr const& _proposal);
+    // reuse the result of the pre-executed proposal with the same hash
+    void executeBlock(bcos::crypto::HashType const& _proposalHash,
+        bcos::protocol::Block::Ptr _block, ExecuteCallback _callback);
+
 protected:
     bcos::scheduler::SchedulerInterface::Ptr m_scheduler;
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::ThreadPool::Ptr m_worker;
+    std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> m_executedNotifier;
+
+    // the index of the proposal => the pre-execution
+    std::map<bcos::protocol::BlockNumber, PreExecution::Ptr> m_preExecutions;
+    std::mutex x_preExecutions;
 };
 }  // namespace consensus
 }  // namespace bcos
\ No newline at end of file
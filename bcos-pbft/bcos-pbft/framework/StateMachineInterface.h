@@ -37,5 +37,15 @@ public:
     // (Not required): Just for performance, call this before "asyncApply" in the other thread.
     virtual void asyncPreApply(
         ProposalInterface::Ptr _proposal, std::function<void(bool)> _onPreApplyFinished) = 0;
+
+    // (Not required): execute the proposal before committed, the result is reused by "asyncApply"
+    // of the proposal with the same hash, and discarded if another proposal applied
+    virtual void asyncPreExecute(ProposalInterface::ConstPtr _lastAppliedProposal [[maybe_unused]],
+        ProposalInterface::Ptr _proposal [[maybe_unused]])
+    {}
+
+    // notify the number, transactions size and time cost(ms) after the block executed
+    virtual void registerExecutedNotifier(
+        std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> _executedNotifier) = 0;
 };
 }  // namespace bcos::consensus
@@ -66,6 +66,13 @@ PBFTImpl::Ptr PBFTFactory::createPBFT()
     PBFT_LOG(INFO) << LOG_DESC("create pbftStorage");
     auto pbftStorage =
         std::make_shared<LedgerStorage>(m_scheduler, m_storage, m_blockFactory, pbftMessageFactory);
+    if (!m_walPath.empty())
+    {
+        PBFT_LOG(INFO) << LOG_DESC("create consensus WAL") << LOG_KV("path", m_walPath);
+        auto wal = std::make_shared<ConsensusWAL>(m_walPath);
+        wal->open();
+        pbftStorage->setConsensusWAL(wal);
+    }
 
     PBFT_LOG(INFO) << LOG_DESC("create pbftConfig");
     auto pbftConfig = std::make_shared<PBFTConfig>(m_cryptoSuite, m_keyPair, pbftMessageFactory,
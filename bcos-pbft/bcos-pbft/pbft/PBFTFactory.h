@@ -43,6 +43,8 @@ public:
 
     virtual ~PBFTFactory() = default;
     virtual PBFTImpl::Ptr createPBFT();
+    // persist the committed proposals into the WAL under the path, disabled if empty
+    void setConsensusWALPath(std::string _walPath) { m_walPath = std::move(_walPath); }
 
 protected:
     bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
@@ -54,5 +56,6 @@ protected:
     bcos::txpool::TxPoolInterface::Ptr m_txpool;
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::protocol::TransactionSubmitResultFactory::Ptr m_txResultFactory;
+    std::string m_walPath;
 };
 }  // namespace bcos::consensus
\ No newline at end of file
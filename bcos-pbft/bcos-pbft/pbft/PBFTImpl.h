@@ -81,6 +81,17 @@ public:
     {
         m_pbftEngine->pbftConfig()->registerStateNotifier(_stateNotifier);
     }
+
+    // notify the sealer the time cost to execute and commit the blocks
+    void registerBlockCostNotifier(
+        std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> _executedNotifier,
+        std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> _committedNotifier)
+    {
+        m_pbftEngine->pbftConfig()->stateMachine()->registerExecutedNotifier(
+            std::move(_executedNotifier));
+        m_pbftEngine->pbftConfig()->storage()->registerCommittedNotifier(
+            std::move(_committedNotifier));
+    }
     // the sync module notify the consensus module the new block
     void registerNewBlockNotifier(
         std::function<void(bcos::ledger::LedgerConfig::Ptr, std::function<void(Error::Ptr)>)>
@@ -239,6 +239,13 @@ bool PBFTCache::checkAndPreCommit()
     auto commitReq = m_config->pbftMessageFactory()->populateFrom(PacketType::CommitPacket,
         m_config->pbftMsgDefaultVersion(), m_config->view(), utcTime(), m_config->nodeIndex(),
         m_precommitWithoutData->consensusProposal(), m_config->cryptoSuite(), m_config->keyPair());
+    if (m_config->voteCollection())
+    {
+        // sign the commit digest, the prepare votes in the QC can't be replayed as commit votes
+        auto signature = m_config->cryptoSuite()->signatureImpl()->sign(
+            *m_config->keyPair(), m_config->commitVoteHash(commitReq->hash()));
+        commitReq->consensusProposal()->setSignature(*signature);
+    }
     // add the commitReq to local cache
     addCommitCache(commitReq);
     // broadcast the commitReq
@@ -247,9 +254,10 @@ bool PBFTCache::checkAndPreCommit()
                    << LOG_KV("hash", commitReq->hash().abridged())
                    << LOG_KV("index", commitReq->index());
     auto encodedData = m_config->codec()->encode(commitReq, m_config->pbftMsgDefaultVersion());
-    // only broadcast message to consensus nodes
-    m_config->frontService()->asyncSendBroadcastMessage(
-        bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, ref(*encodedData));
+    sendVote(commitReq, encodedData);
+    // the collector broadcasts the prepare votes it collected
+    broadcastQuorumCert(
+        PacketType::PrepareQCPacket, m_precommit->consensusProposal(), m_prepareCacheList);
     m_precommitted = true;
     // collect the commitReq and try to commit
     return checkAndCommit();
@@ -284,6 +292,8 @@ bool PBFTCache::checkAndCommit()
                    << printPBFTProposal(m_precommit->consensusProposal())
                    << m_config->printCurrentState();
     m_submitted.store(true);
+    broadcastQuorumCert(
+        PacketType::CommitQCPacket, m_precommit->consensusProposal(), m_commitCacheList);
     return true;
 }
 
@@ -376,6 +386,8 @@ bool PBFTCache::checkAndCommitStableCheckPoint()
     }
     setSignatureList(m_checkpointProposal, m_checkpointCacheList);
     m_stableCommitted = true;
+    broadcastQuorumCert(
+        PacketType::CheckPointQCPacket, m_checkpointProposal, m_checkpointCacheList);
     PBFT_LOG(INFO) << LOG_DESC("checkAndCommitStableCheckPoint")
                    << LOG_KV("index", m_checkpointProposal->index())
                    << LOG_KV("hash", m_checkpointProposal->hash().abridged())
@@ -388,4 +400,127 @@ bool PBFTCache::checkAndCommitStableCheckPoint()
         return false;
     }
     return true;
-}
\ No newline at end of file
+}
+
+void PBFTCache::sendVote(PBFTMessageInterface::Ptr _vote, bytesPointer _encodedData)
+{
+    if (!m_config->voteCollection())
+    {
+        // only broadcast message to consensus nodes
+        m_config->frontService()->asyncSendBroadcastMessage(
+            bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, ref(*_encodedData));
+        return;
+    }
+    auto collector = m_config->voteCollector(m_index);
+    if (collector != m_config->nodeIndex())
+    {
+        auto nodeInfo = m_config->getConsensusNodeByIndex(collector);
+        if (nodeInfo)
+        {
+            m_config->frontService()->asyncSendMessageByNodeID(
+                ModuleID::PBFT, nodeInfo->nodeID(), ref(*_encodedData), 0, nullptr);
+        }
+    }
+    // broadcast the vote in checkPendingVotes if the QC not received in time
+    m_pendingVotes[_vote->packetType()] = std::make_pair(utcTime(), _encodedData);
+}
+
+bool PBFTCache::voteCollected(PacketType _packetType) const
+{
+    switch (_packetType)
+    {
+    case PacketType::PreparePacket:
+        return m_precommitted;
+    case PacketType::CommitPacket:
+        return m_submitted;
+    case PacketType::CheckPoint:
+        return m_stableCommitted;
+    default:
+        return true;
+    }
+}
+
+void PBFTCache::checkPendingVotes()
+{
+    for (auto it = m_pendingVotes.begin(); it != m_pendingVotes.end();)
+    {
+        if (voteCollected(it->first))
+        {
+            it = m_pendingVotes.erase(it);
+            continue;
+        }
+        if (utcTime() - it->second.first < (int64_t)m_config->voteCollectionTimeout())
+        {
+            ++it;
+            continue;
+        }
+        PBFT_LOG(WARNING) << LOG_DESC("checkPendingVotes: broadcast the vote for QC timeout")
+                          << LOG_KV("type", it->first) << LOG_KV("index", m_index)
+                          << LOG_KV("collector", m_config->voteCollector(m_index))
+                          << m_config->printCurrentState();
+        m_config->frontService()->asyncSendBroadcastMessage(
+            bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, ref(*(it->second.second)));
+        it = m_pendingVotes.erase(it);
+    }
+}
+
+void PBFTCache::broadcastQuorumCert(
+    PacketType _packetType, PBFTProposalInterface::Ptr _proposal, CollectionCacheType& _cache)
+{
+    if (!isVoteCollector())
+    {
+        return;
+    }
+    auto proposal = m_config->pbftMessageFactory()->populateFrom(_proposal, false, false);
+    setSignatureList(proposal, _cache);
+    auto quorumCert = m_config->pbftMessageFactory()->populateFrom(_packetType, proposal,
+        m_config->pbftMsgDefaultVersion(), m_config->view(), utcTime(), m_config->nodeIndex());
+    auto encodedData = m_config->codec()->encode(quorumCert, m_config->pbftMsgDefaultVersion());
+    // only broadcast message to consensus nodes
+    m_config->frontService()->asyncSendBroadcastMessage(
+        bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, ref(*encodedData));
+    PBFT_LOG(INFO) << METRIC << LOG_DESC("broadcastQuorumCert") << LOG_KV("type", _packetType)
+                   << LOG_KV("index", proposal->index())
+                   << LOG_KV("hash", proposal->hash().abridged())
+                   << LOG_KV("votes", proposal->signatureProofSize())
+                   << LOG_KV("size", encodedData->size());
+}
+
+void PBFTCache::addQuorumCert(PBFTMessageInterface::Ptr _quorumCert)
+{
+    PacketType voteType;
+    CollectionCacheType* cache = nullptr;
+    QuorumRecoderType* weight = nullptr;
+    switch (_quorumCert->packetType())
+    {
+    case PacketType::PrepareQCPacket:
+        voteType = PacketType::PreparePacket;
+        cache = &m_prepareCacheList;
+        weight = &m_prepareReqWeight;
+        break;
+    case PacketType::CommitQCPacket:
+        voteType = PacketType::CommitPacket;
+        cache = &m_commitCacheList;
+        weight = &m_commitReqWeight;
+        break;
+    case PacketType::CheckPointQCPacket:
+        voteType = PacketType::CheckPoint;
+        cache = &m_checkpointCacheList;
+        weight = &m_checkpointCacheWeight;
+        break;
+    default:
+        return;
+    }
+    // expand the QC into the votes, the same as the votes received one by one
+    auto proposal = _quorumCert->consensusProposal();
+    for (size_t i = 0; i < proposal->signatureProofSize(); i++)
+    {
+        auto proof = proposal->signatureProof(i);
+        auto signedProposal = m_config->pbftMessageFactory()->populateFrom(proposal, false, false);
+        signedProposal->setSignature(proof.second.toBytes());
+        auto vote = m_config->pbftMessageFactory()->populateFrom(voteType, signedProposal,
+            _quorumCert->version(), _quorumCert->view(), _quorumCert->timestamp(),
+            (IndexType)proof.first);
+        addCache(*cache, *weight, vote);
+    }
+}
@@ -108,6 +108,13 @@ public:
         m_committedIndexNotifier = std::move(_committedIndexNotifier);
     }
 
+    // send the vote to the collector when vote collection enabled, otherwise broadcast it
+    virtual void sendVote(PBFTMessageInterface::Ptr _vote, bytesPointer _encodedData);
+    // add the votes in the quorum certificate verified into the cache
+    virtual void addQuorumCert(PBFTMessageInterface::Ptr _quorumCert);
+    // broadcast the votes whose quorum certificate not received in voteCollectionTimeout
+    virtual void checkPendingVotes();
+
     uint64_t getCollectedCheckPointWeight(bcos::crypto::HashType const& _hash)
     {
         if (m_checkpointCacheWeight.count(_hash))
@@ -140,6 +147,14 @@ protected:
     virtual void intoPrecommit();
     virtual void setSignatureList(
         PBFTProposalInterface::Ptr _proposal, CollectionCacheType& _cache);
+    bool isVoteCollector() const
+    {
+        return m_config->voteCollection() &&
+               m_config->voteCollector(m_index) == m_config->nodeIndex();
+    }
+    bool voteCollected(PacketType _packetType) const;
+    virtual void broadcastQuorumCert(
+        PacketType _packetType, PBFTProposalInterface::Ptr _proposal, CollectionCacheType& _cache);
 
     template <typename T>
     void resetCacheAfterViewChange(T& _caches, ViewType _curView)
@@ -218,5 +233,8 @@ protected:
     QuorumRecoderType m_checkpointCacheWeight;
 
     std::function<void(bcos::protocol::BlockNumber)> m_committedIndexNotifier;
+
+    // the packet type => the time sent to the collector and the encoded vote
+    std::map<PacketType, std::pair<int64_t, bytesPointer>> m_pendingVotes;
 };
 }  // namespace bcos::consensus
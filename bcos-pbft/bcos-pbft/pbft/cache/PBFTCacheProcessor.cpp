@@ -22,6 +22,7 @@
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-framework/protocol/Protocol.h>
 #include <boost/bind/bind.hpp>
+#include <set>
 #include <utility>
 
 using namespace bcos;
@@ -334,6 +335,27 @@ ProposalInterface::ConstPtr PBFTCacheProcessor::getAppliedCheckPointProposal(
     return (m_caches[_index])->checkPointProposal();
 }
 
+void PBFTCacheProcessor::tryToPreExecuteProposal(PBFTProposalInterface::Ptr _proposal)
+{
+    if (!m_config->preExecuteProposal())
+    {
+        return;
+    }
+    // only the proposal next to the committed one is pre-executed, and never overlaps with the
+    // execution of the committed proposals
+    auto committedProposal = m_config->committedProposal();
+    if (_proposal->index() != committedProposal->index() + 1 ||
+        _proposal->index() != m_config->expectedCheckPoint() || !m_executingProposals.empty() ||
+        !m_committedQueue.empty())
+    {
+        return;
+    }
+    PBFT_LOG(INFO) << LOG_DESC("tryToPreExecuteProposal") << LOG_KV("index", _proposal->index())
+                   << LOG_KV("hash", _proposal->hash().abridged())
+                   << m_config->printCurrentState();
+    m_config->stateMachine()->asyncPreExecute(committedProposal, _proposal);
+}
+
 bool PBFTCacheProcessor::tryToPreApplyProposal(ProposalInterface::Ptr _proposal)
 {
     m_config->stateMachine()->asyncPreApply(
@@ -820,6 +842,54 @@ bool PBFTCacheProcessor::checkPrecommitWeight(PBFTMessageInterface::Ptr _precomm
     return (weight >= m_config->minRequiredQuorum());
 }
 
+bool PBFTCacheProcessor::checkQuorumCert(PBFTMessageInterface::Ptr _quorumCert)
+{
+    auto proposal = _quorumCert->consensusProposal();
+    if (!proposal || proposal->hash() != _quorumCert->hash() ||
+        proposal->index() != _quorumCert->index())
+    {
+        return false;
+    }
+    // the commit votes sign the commit digest
+    auto signedHash = proposal->hash();
+    if (_quorumCert->packetType() == PacketType::CommitQCPacket)
+    {
+        signedHash = m_config->commitVoteHash(proposal->hash());
+    }
+    uint64_t weight = 0;
+    std::set<int64_t> voters;
+    auto proofSize = proposal->signatureProofSize();
+    for (size_t i = 0; i < proofSize; i++)
+    {
+        auto proof = proposal->signatureProof(i);
+        if (!voters.insert(proof.first).second)
+        {
+            return false;
+        }
+        auto nodeInfo = m_config->getConsensusNodeByIndex(proof.first);
+        if (!nodeInfo)
+        {
+            return false;
+        }
+        auto ret = m_config->cryptoSuite()->signatureImpl()->verify(
+            nodeInfo->nodeID(), signedHash, proof.second);
+        if (!ret)
+        {
+            return false;
+        }
+        weight += nodeInfo->weight();
+    }
+    return (weight >= m_config->minRequiredQuorum());
+}
+
+void PBFTCacheProcessor::checkPendingVotes()
+{
+    for (auto const& cache : m_caches)
+    {
+        cache.second->checkPendingVotes();
+    }
+}
+
 ViewChangeMsgInterface::Ptr PBFTCacheProcessor::fetchPrecommitData(
     BlockNumber _index, bcos::crypto::HashType const& _hash)
 {
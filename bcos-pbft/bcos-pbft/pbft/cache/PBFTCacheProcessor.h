@@ -76,6 +76,25 @@ public:
             });
     }
 
+    // send the prepare/commit/checkpoint vote to the collector or broadcast it
+    virtual void sendVote(PBFTMessageInterface::Ptr _vote, bytesPointer _encodedData)
+    {
+        addCache(m_caches, std::move(_vote),
+            [_encodedData](PBFTCache::Ptr _pbftCache, PBFTMessageInterface::Ptr _vote) {
+                _pbftCache->sendVote(std::move(_vote), _encodedData);
+            });
+    }
+    // verify every vote of the quorum certificate and the weight of the votes
+    virtual bool checkQuorumCert(PBFTMessageInterface::Ptr _quorumCert);
+    virtual void addQuorumCert(PBFTMessageInterface::Ptr _quorumCert)
+    {
+        addCache(m_caches, std::move(_quorumCert),
+            [](PBFTCache::Ptr _pbftCache, PBFTMessageInterface::Ptr _quorumCert) {
+                _pbftCache->addQuorumCert(std::move(_quorumCert));
+            });
+    }
+    virtual void checkPendingVotes();
+
     PBFTMessageList preCommitCachesWithData()
     {
         PBFTMessageList precommitCacheList;
@@ -136,6 +155,8 @@ public:
         m_committedProposalNotifier = std::move(_committedProposalNotifier);
     }
 
+    // execute the pre-prepared proposal before committed if pre_execute_proposal enabled
+    virtual void tryToPreExecuteProposal(PBFTProposalInterface::Ptr _proposal);
     bool tryToPreApplyProposal(ProposalInterface::Ptr _proposal);
     bool tryToApplyCommitQueue();
 
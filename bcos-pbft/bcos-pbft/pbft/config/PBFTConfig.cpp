@@ -390,6 +390,14 @@ uint64_t PBFTConfig::minRequiredQuorum() const
     return m_minRequiredQuorum;
 }
 
+bcos::crypto::HashType PBFTConfig::commitVoteHash(bcos::crypto::HashType const& _proposalHash)
+{
+    bytes data(_proposalHash.begin(), _proposalHash.end());
+    std::string const suffix = "commit";
+    data.insert(data.end(), suffix.begin(), suffix.end());
+    return m_cryptoSuite->hash(data);
+}
+
 void PBFTConfig::updateQuorum()
 {
     m_totalQuorum.store(0);
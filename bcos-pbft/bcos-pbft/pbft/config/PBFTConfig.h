@@ -173,6 +173,31 @@ public:
         m_checkPointTimeoutInterval = _timeoutInterval;
     }
 
+    // send the pre-prepare message by the erasure-coded chunks relayed by the followers
+    bool proposalDissemination() const { return m_proposalDissemination; }
+    void setProposalDissemination(bool _proposalDissemination)
+    {
+        m_proposalDissemination = _proposalDissemination;
+    }
+
+    // send the votes to the leader of the proposal, which broadcasts the quorum certificate
+    bool voteCollection() const { return m_voteCollection; }
+    void setVoteCollection(bool _voteCollection) { m_voteCollection = _voteCollection; }
+    // execute the pre-prepared proposal while waiting for the prepare and commit votes
+    bool preExecuteProposal() const { return m_preExecuteProposal; }
+    void setPreExecuteProposal(bool _preExecuteProposal)
+    {
+        m_preExecuteProposal = _preExecuteProposal;
+    }
+    IndexType voteCollector(bcos::protocol::BlockNumber _index) { return leaderIndex(_index); }
+    // broadcast the vote if the quorum certificate not received in time
+    uint64_t voteCollectionTimeout() const
+    {
+        return std::max(consensusTimeout() / 4, c_minVoteCollectionTimeout);
+    }
+    // the commit vote signs another hash, not to be replayed by the prepare votes
+    bcos::crypto::HashType commitVoteHash(bcos::crypto::HashType const& _proposalHash);
+
     void resetToView()
     {
         m_toView.store(m_view);
@@ -439,6 +464,10 @@ protected:
 
     int64_t m_waterMarkLimit = 50;
     std::atomic<int64_t> m_checkPointTimeoutInterval = {3000};
+    std::atomic_bool m_proposalDissemination = {false};
+    std::atomic_bool m_voteCollection = {false};
+    std::atomic_bool m_preExecuteProposal = {false};
+    const uint64_t c_minVoteCollectionTimeout = 200;
     std::atomic<int64_t> m_minSealTime = {3000};
 
     std::atomic<uint64_t> m_leaderSwitchPeriod = {1};
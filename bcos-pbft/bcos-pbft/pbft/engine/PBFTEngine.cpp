@@ -43,6 +43,11 @@ PBFTEngine::PBFTEngine(PBFTConfig::Ptr _config)
     auto cacheFactory = std::make_shared<PBFTCacheFactory>();
     m_cacheProcessor = std::make_shared<PBFTCacheProcessor>(cacheFactory, _config);
     m_logSync = std::make_shared<PBFTLogSync>(m_config, m_cacheProcessor);
+    m_disseminator = std::make_shared<ProposalDisseminator>(m_config);
+    m_disseminator->registerProposalHandler([this](PBFTMessageInterface::Ptr _prePrepareMsg) {
+        m_msgQueue->push(std::move(_prePrepareMsg));
+        notifyWorker();
+    });
     // register the timeout function
     m_config->timer()->registerTimeoutHandler(boost::bind(&PBFTEngine::onTimeout, this));
     m_config->storage()->registerFinalizeHandler(boost::bind(
@@ -130,6 +135,28 @@ void PBFTEngine::start()
         }
     });
     m_timer->start();
+    if (m_config->voteCollection())
+    {
+        m_voteTimer = std::make_shared<PBFTTimer>(
+            m_config->voteCollectionTimeout() / 2, "voteCollectionTimer");
+        m_voteTimer->registerTimeoutHandler([self]() {
+            try
+            {
+                auto engine = self.lock();
+                if (!engine)
+                {
+                    return;
+                }
+                engine->checkPendingVotes();
+            }
+            catch (std::exception const& e)
+            {
+                PBFT_LOG(WARNING) << LOG_DESC("checkPendingVotes error")
+                                  << LOG_KV("errorInfo", boost::diagnostic_information(e));
+            }
+        });
+        m_voteTimer->start();
+    }
     // trigger fast viewchange to reachNewView
     if (!m_config->startRecovered())
     {
@@ -146,6 +173,15 @@ void PBFTEngine::tryToResendCheckPoint()
     m_timer->restart();
 }
 
+void PBFTEngine::checkPendingVotes()
+{
+    {
+        RecursiveGuard l(m_mutex);
+        m_cacheProcessor->checkPendingVotes();
+    }
+    m_voteTimer->restart();
+}
+
 void PBFTEngine::restart()
 {
     PBFT_LOG(INFO) << LOG_DESC("restart the consensus module");
@@ -178,6 +214,10 @@ void PBFTEngine::stop()
     {
         m_timer->stop();
     }
+    if (m_voteTimer)
+    {
+        m_voteTimer->stop();
+    }
     PBFT_LOG(INFO) << LOG_DESC("stop the PBFTEngine");
 }
 
@@ -256,14 +296,13 @@ void PBFTEngine::onProposalApplySuccess(
         _executedProposal, m_config->cryptoSuite(), m_config->keyPair(), true);
 
     auto encodedData = m_config->codec()->encode(checkPointMsg);
-    // only broadcast message to the consensus nodes
-    m_config->frontService()->asyncSendBroadcastMessage(
-        bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, ref(*encodedData));
     auto startT = utcTime();
     auto recordT = utcTime();
     // Note: must lock here to ensure thread safe
     RecursiveGuard l(m_mutex);
     auto lockT = (utcTime() - startT);
+    // only send the message to the consensus nodes
+    m_cacheProcessor->sendVote(checkPointMsg, encodedData);
     // restart the timer when proposal execute finished to in case of timeout
     if (m_config->timer()->running())
     {
@@ -407,6 +446,11 @@ void PBFTEngine::onRecvProposal(bool _containSysTxs, bytesConstRef _proposalData
     {
         // broadcast the pre-prepare packet
         auto encodedData = m_config->codec()->encode(pbftMessage);
+        if (m_config->proposalDissemination() &&
+            m_disseminator->disseminate(pbftMessage, ref(*encodedData)))
+        {
+            return;
+        }
         // only broadcast pbft message to the consensus nodes
         m_config->frontService()->asyncSendBroadcastMessage(
             bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, ref(*encodedData));
@@ -486,6 +530,12 @@ void PBFTEngine::onReceivePBFTMessage(Error::Ptr _error, NodeIDPtr _fromNode, by
                 "node");
             return;
         }
+        // the chunks of the pre-prepare message are pushed into the queue after recovered
+        if (ProposalDisseminator::isProposalChunk(_data))
+        {
+            m_disseminator->onReceiveChunk(_fromNode, _data);
+            return;
+        }
         // decode the message and push the message into the queue
         auto pbftMsg = m_config->codec()->decode(_data);
         pbftMsg->setFrom(_fromNode);
@@ -534,7 +584,7 @@ void PBFTEngine::onReceivePBFTMessage(Error::Ptr _error, NodeIDPtr _fromNode, by
             return;
         }
         m_msgQueue->push(pbftMsg);
-        m_signalled.notify_all();
+        notifyWorker();
     }
     catch (std::exception const& _e)
     {
@@ -566,8 +616,8 @@ void PBFTEngine::executeWorker()
         waitSignal();
         return;
     }
-    // handle the PBFT message(here will wait when the msgQueue is empty)
-    auto messageResult = m_msgQueue->tryPop(c_PopWaitSeconds);
+    // handle the PBFT message(wait for the notification when the msgQueue is empty)
+    auto messageResult = m_msgQueue->tryPop(0);
     auto empty = m_msgQueue->empty();
     if (messageResult.first)
     {
@@ -654,6 +704,14 @@ void PBFTEngine::handleMsg(std::shared_ptr<PBFTBaseMessageInterface> _msg)
         handleRecoverRequest(request);
         break;
     }
+    case PacketType::PrepareQCPacket:
+    case PacketType::CommitQCPacket:
+    case PacketType::CheckPointQCPacket:
+    {
+        auto quorumCert = std::dynamic_pointer_cast<PBFTMessageInterface>(_msg);
+        handleQuorumCert(quorumCert);
+        break;
+    }
     case PacketType::RecoverResponse:
     {
         auto recoverResponse = std::dynamic_pointer_cast<PBFTMessageInterface>(_msg);
@@ -853,6 +911,7 @@ bool PBFTEngine::handlePrePrepareMsg(PBFTMessageInterface::Ptr _prePrepareMsg,
         broadcastPrepareMsg(_prePrepareMsg);
         PBFT_LOG(INFO) << LOG_DESC("handlePrePrepareMsg and broadcast prepare packet")
                        << printPBFTMsgInfo(_prePrepareMsg) << m_config->printCurrentState();
+        m_cacheProcessor->tryToPreExecuteProposal(_prePrepareMsg->consensusProposal());
         m_cacheProcessor->checkAndPreCommit();
         return true;
     }
@@ -927,9 +986,8 @@ void PBFTEngine::broadcastPrepareMsg(PBFTMessageInterface::Ptr _prePrepareMsg)
     m_cacheProcessor->addPrepareCache(prepareMsg);
 
     auto encodedData = m_config->codec()->encode(prepareMsg, m_config->pbftMsgDefaultVersion());
-    // only broadcast to the consensus nodes
-    m_config->frontService()->asyncSendBroadcastMessage(
-        bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, ref(*encodedData));
+    // only send to the consensus nodes
+    m_cacheProcessor->sendVote(prepareMsg, encodedData);
     // try to precommit the message
     m_cacheProcessor->checkAndPreCommit();
 }
@@ -986,6 +1044,20 @@ bool PBFTEngine::handleCommitMsg(PBFTMessageInterface::Ptr _commitMsg)
     {
         return false;
     }
+    // the commit votes sign the commit digest when the votes collected
+    if (m_config->voteCollection())
+    {
+        auto nodeInfo = m_config->getConsensusNodeByIndex(_commitMsg->generatedFrom());
+        auto proposal = _commitMsg->consensusProposal();
+        if (!nodeInfo || !proposal ||
+            !m_config->cryptoSuite()->signatureImpl()->verify(nodeInfo->nodeID(),
+                m_config->commitVoteHash(proposal->hash()), proposal->signature()))
+        {
+            PBFT_LOG(WARNING) << LOG_DESC("handleCommitMsg: invalid commit vote signature")
+                              << printPBFTMsgInfo(_commitMsg);
+            return false;
+        }
+    }
     m_cacheProcessor->addCommitReq(_commitMsg);
     m_cacheProcessor->checkAndCommit();
     return true;
@@ -1439,6 +1511,46 @@ bool PBFTEngine::handleCheckPointMsg(std::shared_ptr<PBFTMessageInterface> _chec
     return true;
 }
 
+bool PBFTEngine::handleQuorumCert(PBFTMessageInterface::Ptr _quorumCert)
+{
+    PBFT_LOG(TRACE) << LOG_DESC("handleQuorumCert") << printPBFTMsgInfo(_quorumCert)
+                    << m_config->printCurrentState();
+    auto packetType = _quorumCert->packetType();
+    if (packetType == PacketType::CheckPointQCPacket)
+    {
+        if (_quorumCert->index() <= m_config->committedProposal()->index() ||
+            checkSignature(_quorumCert) == CheckResult::INVALID)
+        {
+            return false;
+        }
+    }
+    else if (checkPBFTMsg(_quorumCert) == CheckResult::INVALID)
+    {
+        return false;
+    }
+    if (!m_cacheProcessor->checkQuorumCert(_quorumCert))
+    {
+        PBFT_LOG(WARNING) << LOG_DESC("handleQuorumCert: invalid quorum certificate")
+                          << printPBFTMsgInfo(_quorumCert);
+        return false;
+    }
+    m_cacheProcessor->addQuorumCert(_quorumCert);
+    switch (packetType)
+    {
+    case PacketType::PrepareQCPacket:
+        m_cacheProcessor->checkAndPreCommit();
+        break;
+    case PacketType::CommitQCPacket:
+        m_cacheProcessor->checkAndCommit();
+        break;
+    default:
+        m_cacheProcessor->tryToApplyCommitQueue();
+        m_cacheProcessor->checkAndCommitStableCheckPoint();
+        break;
+    }
+    return true;
+}
+
 void PBFTEngine::handleRecoverResponse(PBFTMessageInterface::Ptr _recoverResponse)
 {
     if (checkSignature(_recoverResponse) == CheckResult::INVALID)
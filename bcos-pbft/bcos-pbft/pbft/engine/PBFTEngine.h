@@ -20,6 +20,7 @@
  */
 #pragma once
 #include "PBFTLogSync.h"
+#include "ProposalDisseminator.h"
 #include "bcos-pbft/core/ConsensusEngine.h"
 #include <bcos-tool/LedgerConfigFetcher.h>
 #include <bcos-utilities/ConcurrentQueue.h>
@@ -106,6 +107,7 @@ public:
 protected:
     virtual void initSendResponseHandler();
     virtual void tryToResendCheckPoint();
+    virtual void checkPendingVotes();
     virtual void onReceivePBFTMessage(bcos::Error::Ptr _error, bcos::crypto::NodeIDPtr _nodeID,
         bytesConstRef _data, SendResponseCallback _sendResponse);
 
@@ -160,6 +162,8 @@ protected:
 
     // handle the checkpoint message
     virtual bool handleCheckPointMsg(std::shared_ptr<PBFTMessageInterface> _checkPointMsg);
+    // handle the prepare/commit/checkpoint votes bundled by the collector
+    virtual bool handleQuorumCert(std::shared_ptr<PBFTMessageInterface> _quorumCert);
 
     // function called after reaching a consensus
     virtual void finalizeConsensus(
@@ -205,11 +209,8 @@ protected:
 
 private:
     // utility functions
-    void waitSignal()
-    {
-        boost::unique_lock<boost::mutex> l(x_signalled);
-        m_signalled.wait_for(l, boost::chrono::milliseconds(5));
-    }
+    // returns as soon as a new message arrives
+    void waitSignal() { waitWorkerSignal(c_waitSignalMs); }
 
 protected:
     // PBFT configuration class
@@ -223,23 +224,26 @@ protected:
     std::shared_ptr<PBFTCacheProcessor> m_cacheProcessor;
     // for log syncing
     PBFTLogSync::Ptr m_logSync;
+    // for the erasure-coded pre-prepare message
+    ProposalDisseminator::Ptr m_disseminator;
 
     std::function<void(std::string const& _id, int _moduleID, bcos::crypto::NodeIDPtr _dstNode,
         bytesConstRef _data)>
         m_sendResponseHandler;
 
-    boost::condition_variable m_signalled;
-    boost::mutex x_signalled;
     mutable RecursiveMutex m_mutex;
 
-    const unsigned c_PopWaitSeconds = 5;
-    const std::set<PacketType> c_consensusPacket = {PrePreparePacket, PreparePacket, CommitPacket};
+    const unsigned c_waitSignalMs = 5;
+    const std::set<PacketType> c_consensusPacket = {
+        PrePreparePacket, PreparePacket, CommitPacket, PrepareQCPacket, CommitQCPacket};
 
     std::atomic_bool m_stopped = {false};
     bcos::tool::LedgerConfigFetcher::Ptr m_ledgerFetcher;
 
     // the timer used to resend checkPointProposal
     std::shared_ptr<bcos::Timer> m_timer;
+    // the timer used to broadcast the votes whose QC not received in time
+    std::shared_ptr<bcos::Timer> m_voteTimer;
 };
 }  // namespace consensus
 }  // namespace bcos
\ No newline at end of file
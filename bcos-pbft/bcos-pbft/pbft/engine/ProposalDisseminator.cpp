@@ -0,0 +1,344 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief disseminate the pre-prepare message by erasure-coded chunks relayed by the followers
+ * @file ProposalDisseminator.cpp
+ * @date 2022-11-28
+ */
+#include "ProposalDisseminator.h"
+#include "bcos-pbft/pbft/protocol/proto/PBFT.pb.h"
+#include <bcos-framework/protocol/Protocol.h>
+#include <bcos-protocol/Common.h>
+#include <bcos-utilities/Common.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <optional>
+
+using namespace bcos;
+using namespace bcos::consensus;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+NodeIDs ProposalDisseminator::followers(ConsensusNodeList const& _nodes, IndexType _leader)
+{
+    NodeIDs nodeIDs;
+    for (size_t i = 0; i < _nodes.size(); ++i)
+    {
+        if ((IndexType)i != _leader)
+        {
+            nodeIDs.push_back(_nodes[i]->nodeID());
+        }
+    }
+    return nodeIDs;
+}
+
+bool ProposalDisseminator::disseminate(
+    PBFTMessageInterface::Ptr _prePrepareMsg, bytesConstRef _encodedMsg)
+{
+    auto startT = utcTime();
+    auto nodeIDs = followers(m_config->consensusNodeList(), m_config->nodeIndex());
+    if (nodeIDs.size() + 1 < MIN_CONSENSUS_NODES || nodeIDs.size() > ReedSolomon::MAX_SHARDS)
+    {
+        return false;
+    }
+    ReedSolomon codec(dataChunks(nodeIDs.size()), nodeIDs.size());
+    auto chunks = codec.encode(_encodedMsg);
+
+    auto hashImpl = m_config->cryptoSuite()->hashImpl();
+    ProposalChunkHeader header;
+    header.set_view(_prePrepareMsg->view());
+    header.set_index(_prePrepareMsg->index());
+    header.set_generatedfrom(m_config->nodeIndex());
+    auto proposalHash = _prePrepareMsg->hash();
+    header.set_proposalhash(proposalHash.data(), proposalHash.size());
+    auto messageHash = hashImpl->hash(_encodedMsg);
+    header.set_messagehash(messageHash.data(), messageHash.size());
+    header.set_messagesize(_encodedMsg.size());
+    header.set_datachunks(codec.dataShards());
+    for (auto const& chunk : chunks)
+    {
+        auto chunkHash = hashImpl->hash(chunk);
+        header.add_chunkhashes(chunkHash.data(), chunkHash.size());
+    }
+    auto headerData = header.SerializeAsString();
+    auto signatureData = m_config->cryptoSuite()->signatureImpl()->sign(*m_config->keyPair(),
+        hashImpl->hash(bytesConstRef((byte const*)headerData.data(), headerData.size())), false);
+
+    size_t egress = 0;
+    for (size_t i = 0; i < nodeIDs.size(); ++i)
+    {
+        auto proposalChunk = std::make_shared<ProposalChunk>();
+        proposalChunk->set_header(headerData);
+        proposalChunk->set_signaturedata(signatureData->data(), signatureData->size());
+        proposalChunk->set_chunkindex((int32_t)i);
+        proposalChunk->set_chunk(chunks[i].data(), chunks[i].size());
+        auto payLoad = encodePBObject(proposalChunk);
+        auto rawMessage = std::make_shared<RawMessage>();
+        rawMessage->set_version(m_config->pbftMsgDefaultVersion());
+        rawMessage->set_type((int32_t)PacketType::ProposalChunkPacket);
+        rawMessage->set_payload(payLoad->data(), payLoad->size());
+        auto encodedData = encodePBObject(rawMessage);
+        egress += encodedData->size();
+        m_config->frontService()->asyncSendMessageByNodeID(
+            ModuleID::PBFT, nodeIDs[i], ref(*encodedData), 0, nullptr);
+    }
+    PBFT_LOG(INFO) << METRIC << LOG_DESC("disseminateProposal")
+                   << LOG_KV("index", _prePrepareMsg->index())
+                   << LOG_KV("hash", proposalHash.abridged())
+                   << LOG_KV("chunks", codec.totalShards())
+                   << LOG_KV("dataChunks", codec.dataShards())
+                   << LOG_KV("messageSize", _encodedMsg.size()) << LOG_KV("egress", egress)
+                   << LOG_KV("broadcastEgress", _encodedMsg.size() * nodeIDs.size())
+                   << LOG_KV("timeCost", utcTime() - startT);
+    return true;
+}
+
+bool ProposalDisseminator::isProposalChunk(bytesConstRef _data)
+{
+    // the fields of RawMessage are serialized in order, the type is before the payload
+    google::protobuf::io::CodedInputStream input(_data.data(), (int)_data.size());
+    while (auto tag = input.ReadTag())
+    {
+        auto field = google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag);
+        auto wireType = google::protobuf::internal::WireFormatLite::GetTagWireType(tag);
+        if (wireType != google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT)
+        {
+            return false;
+        }
+        uint64_t value = 0;
+        if (!input.ReadVarint64(&value))
+        {
+            return false;
+        }
+        if (field == RawMessage::kTypeFieldNumber)
+        {
+            return value == PacketType::ProposalChunkPacket;
+        }
+    }
+    return false;
+}
+
+void ProposalDisseminator::onReceiveChunk(NodeIDPtr _fromNode, bytesConstRef _data)
+{
+    auto rawMessage = std::make_shared<RawMessage>();
+    decodePBObject(rawMessage, _data);
+    auto const& payLoad = rawMessage->payload();
+    auto proposalChunk = std::make_shared<ProposalChunk>();
+    decodePBObject(proposalChunk, bytesConstRef((byte const*)payLoad.data(), payLoad.size()));
+    auto const& headerData = proposalChunk->header();
+    auto hashImpl = m_config->cryptoSuite()->hashImpl();
+    auto headerHash =
+        hashImpl->hash(bytesConstRef((byte const*)headerData.data(), headerData.size()));
+
+    ProposalChunkHeader header;
+    if (!header.ParseFromString(headerData) || header.messagehash().size() != HashType::SIZE)
+    {
+        PBFT_LOG(WARNING) << LOG_DESC("onReceiveChunk: invalid header")
+                          << LOG_KV("from", _fromNode->shortHex());
+        return;
+    }
+    auto messageHash = HashType((byte const*)header.messagehash().data(),
+        HashType::ConstructorType::FromPointer);
+    auto chunkIndex = (size_t)proposalChunk->chunkindex();
+    auto const& chunk = proposalChunk->chunk();
+    bool relayChunk = false;
+    NodeIDPtr leaderNodeID;
+    std::optional<ProposalChunks> recoveredProposal;
+    {
+        std::unique_lock lock(x_proposals);
+        auto it = m_proposals.find(messageHash);
+        if (it == m_proposals.end())
+        {
+            // verify the header signed by the leader once for every proposal
+            auto nodes = m_config->consensusNodeList();
+            auto leader = header.generatedfrom();
+            auto committedIndex = m_config->committedProposal()->index();
+            if (leader < 0 || leader >= (int64_t)nodes.size() || leader == m_config->nodeIndex() ||
+                header.index() <= committedIndex)
+            {
+                return;
+            }
+            // the headers are kept until committed, only accept the proposals within the water
+            // mark from their leaders
+            if (header.index() > committedIndex + m_config->waterMarkLimit() ||
+                leader != m_config->leaderIndex(header.index()))
+            {
+                PBFT_LOG(WARNING) << LOG_DESC("onReceiveChunk: unexpected header")
+                                  << LOG_KV("index", header.index()) << LOG_KV("leader", leader)
+                                  << LOG_KV("committedIndex", committedIndex)
+                                  << LOG_KV("from", _fromNode->shortHex());
+                return;
+            }
+            auto followerSize = nodes.size() - 1;
+            if (followerSize + 1 < MIN_CONSENSUS_NODES || followerSize > ReedSolomon::MAX_SHARDS ||
+                header.chunkhashes_size() != (int)followerSize ||
+                header.datachunks() != (int)dataChunks(followerSize) ||
+                header.proposalhash().size() != HashType::SIZE || header.messagesize() <= 0)
+            {
+                PBFT_LOG(WARNING) << LOG_DESC("onReceiveChunk: mismatched header")
+                                  << LOG_KV("index", header.index()) << LOG_KV("leader", leader)
+                                  << LOG_KV("chunks", header.chunkhashes_size())
+                                  << LOG_KV("consensusNodes", nodes.size());
+                return;
+            }
+            auto const& signatureData = proposalChunk->signaturedata();
+            if (!m_config->cryptoSuite()->signatureImpl()->verify(nodes[leader]->nodeID(),
+                    headerHash,
+                    bytesConstRef((byte const*)signatureData.data(), signatureData.size())))
+            {
+                PBFT_LOG(WARNING) << LOG_DESC("onReceiveChunk: invalid signature")
+                                  << LOG_KV("index", header.index()) << LOG_KV("leader", leader)
+                                  << LOG_KV("from", _fromNode->shortHex());
+                return;
+            }
+            clearExpiredProposals();
+            ProposalChunks proposal;
+            proposal.header = headerData;
+            proposal.index = header.index();
+            proposal.leader = (IndexType)leader;
+            proposal.proposalHash = HashType((byte const*)header.proposalhash().data(),
+                HashType::ConstructorType::FromPointer);
+            proposal.messageSize = header.messagesize();
+            for (auto const& chunkHash : header.chunkhashes())
+            {
+                if (chunkHash.size() != HashType::SIZE)
+                {
+                    return;
+                }
+                proposal.chunkHashes.emplace_back(
+                    (byte const*)chunkHash.data(), HashType::ConstructorType::FromPointer);
+            }
+            proposal.codec = std::make_shared<ReedSolomon>(header.datachunks(), followerSize);
+            it = m_proposals.emplace(messageHash, std::move(proposal)).first;
+        }
+        else if (it->second.header != headerData)
+        {
+            return;
+        }
+        auto& proposal = it->second;
+        if (proposal.recovered || chunkIndex >= proposal.chunkHashes.size() ||
+            proposal.chunks.count(chunkIndex))
+        {
+            return;
+        }
+        if (chunk.size() != proposal.codec->shardSize(proposal.messageSize) ||
+            hashImpl->hash(bytesConstRef((byte const*)chunk.data(), chunk.size())) !=
+                proposal.chunkHashes[chunkIndex])
+        {
+            PBFT_LOG(WARNING) << LOG_DESC("onReceiveChunk: invalid chunk")
+                              << LOG_KV("index", proposal.index) << LOG_KV("chunk", chunkIndex)
+                              << LOG_KV("from", _fromNode->shortHex());
+            return;
+        }
+        proposal.chunks.emplace(chunkIndex, bytes(chunk.begin(), chunk.end()));
+        // relay the chunk of the node-self received from the leader
+        auto position = m_config->nodeIndex() < proposal.leader ? m_config->nodeIndex() :
+                                                                  m_config->nodeIndex() - 1;
+        leaderNodeID = m_config->getConsensusNodeByIndex(proposal.leader)->nodeID();
+        relayChunk =
+            (chunkIndex == (size_t)position && _fromNode->data() == leaderNodeID->data());
+        if (proposal.chunks.size() >= proposal.codec->dataShards())
+        {
+            // keep the header to drop the late chunks until the proposal committed
+            proposal.recovered = true;
+            recoveredProposal.emplace();
+            recoveredProposal->index = proposal.index;
+            recoveredProposal->leader = proposal.leader;
+            recoveredProposal->proposalHash = proposal.proposalHash;
+            recoveredProposal->messageSize = proposal.messageSize;
+            recoveredProposal->codec = proposal.codec;
+            recoveredProposal->chunks = std::move(proposal.chunks);
+            proposal.chunks.clear();
+        }
+    }
+    if (relayChunk)
+    {
+        relay(leaderNodeID, chunkIndex, _data);
+    }
+    if (recoveredProposal)
+    {
+        recover(messageHash, std::move(*recoveredProposal));
+    }
+}
+
+void ProposalDisseminator::relay(NodeIDPtr _leader, size_t _chunkIndex, bytesConstRef _data)
+{
+    auto nodes = m_config->consensusNodeList();
+    for (auto const& node : nodes)
+    {
+        auto nodeID = node->nodeID();
+        if (nodeID->data() == _leader->data() || nodeID->data() == m_config->nodeID()->data())
+        {
+            continue;
+        }
+        m_config->frontService()->asyncSendMessageByNodeID(
+            ModuleID::PBFT, nodeID, _data, 0, nullptr);
+    }
+    PBFT_LOG(DEBUG) << LOG_DESC("relayProposalChunk") << LOG_KV("chunk", _chunkIndex)
+                    << LOG_KV("size", _data.size());
+}
+
+void ProposalDisseminator::recover(HashType const& _messageHash, ProposalChunks _proposal)
+{
+    auto startT = utcTime();
+    auto message = _proposal.codec->decode(_proposal.chunks, _proposal.messageSize);
+    if (m_config->cryptoSuite()->hashImpl()->hash(message) != _messageHash)
+    {
+        PBFT_LOG(WARNING) << LOG_DESC("recoverProposal: mismatched message hash")
+                          << LOG_KV("index", _proposal.index)
+                          << LOG_KV("hash", _proposal.proposalHash.abridged());
+        return;
+    }
+    auto pbftMsg = std::dynamic_pointer_cast<PBFTMessageInterface>(
+        m_config->codec()->decode(ref(message)));
+    if (!pbftMsg || pbftMsg->packetType() != PacketType::PrePreparePacket ||
+        pbftMsg->index() != _proposal.index || pbftMsg->hash() != _proposal.proposalHash ||
+        pbftMsg->generatedFrom() != _proposal.leader)
+    {
+        PBFT_LOG(WARNING) << LOG_DESC("recoverProposal: mismatched pre-prepare message")
+                          << LOG_KV("index", _proposal.index)
+                          << LOG_KV("hash", _proposal.proposalHash.abridged());
+        return;
+    }
+    pbftMsg->setFrom(m_config->getConsensusNodeByIndex(_proposal.leader)->nodeID());
+    PBFT_LOG(INFO) << METRIC << LOG_DESC("recoverProposal") << LOG_KV("index", _proposal.index)
+                   << LOG_KV("hash", _proposal.proposalHash.abridged())
+                   << LOG_KV("messageSize", message.size())
+                   << LOG_KV("timeCost", utcTime() - startT);
+    if (m_handler)
+    {
+        m_handler(std::move(pbftMsg));
+    }
+}
+
+size_t ProposalDisseminator::pendingProposals()
+{
+    std::unique_lock lock(x_proposals);
+    return m_proposals.size();
+}
+
+void ProposalDisseminator::clearExpiredProposals()
+{
+    auto committedIndex = m_config->committedProposal()->index();
+    for (auto it = m_proposals.begin(); it != m_proposals.end();)
+    {
+        if (it->second.index <= committedIndex)
+        {
+            it = m_proposals.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
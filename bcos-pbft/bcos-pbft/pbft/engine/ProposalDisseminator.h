@@ -0,0 +1,94 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief disseminate the pre-prepare message by erasure-coded chunks relayed by the followers
+ * @file ProposalDisseminator.h
+ * @date 2022-11-28
+ */
+#pragma once
+#include "../config/PBFTConfig.h"
+#include "../utilities/ReedSolomon.h"
+#include <bcos-utilities/FixedBytes.h>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace bcos::consensus
+{
+/**
+ * @brief Instead of sending the whole pre-prepare message to the n - 1 followers, the leader
+ * encodes it into n - 1 Reed-Solomon chunks and sends the i-th chunk to the i-th follower only,
+ * every follower relays the chunk received from the leader to the other followers, and recovers
+ * the message from any n - 1 - f chunks. The egress of the leader drops from (n - 1) * |M| to
+ * about (n - 1) / (n - 1 - f) * |M|.
+ *
+ * The leader signs the header carrying the hash of the message and of every chunk, so a chunk is
+ * verified before relayed, and the recovered message is checked against the header before handled
+ * as a normal pre-prepare message. A follower missing the chunks falls back to the view change.
+ */
+class ProposalDisseminator : public std::enable_shared_from_this<ProposalDisseminator>
+{
+public:
+    using Ptr = std::shared_ptr<ProposalDisseminator>;
+    using ProposalHandler = std::function<void(PBFTMessageInterface::Ptr)>;
+    // the chunks are not used with less nodes, the broadcast costs no more
+    constexpr static size_t MIN_CONSENSUS_NODES = 4;
+
+    explicit ProposalDisseminator(PBFTConfig::Ptr _config) : m_config(std::move(_config)) {}
+    virtual ~ProposalDisseminator() = default;
+
+    // handle the recovered pre-prepare message
+    void registerProposalHandler(ProposalHandler _handler) { m_handler = std::move(_handler); }
+
+    // send the chunks of the encoded pre-prepare message, false if the chunks are not used
+    virtual bool disseminate(PBFTMessageInterface::Ptr _prePrepareMsg, bytesConstRef _encodedMsg);
+
+    // read the packet type of the encoded message without decoding the payload
+    static bool isProposalChunk(bytesConstRef _data);
+    virtual void onReceiveChunk(bcos::crypto::NodeIDPtr _fromNode, bytesConstRef _data);
+    // the proposals with the headers received, until committed
+    size_t pendingProposals();
+
+    // the followers in the order of the chunks, all the consensus nodes except the leader
+    static bcos::crypto::NodeIDs followers(ConsensusNodeList const& _nodes, IndexType _leader);
+    // n - 1 - f chunks of the n - 1 recover the message
+    static size_t dataChunks(size_t _followers) { return _followers - _followers / 3; }
+
+private:
+    struct ProposalChunks
+    {
+        std::string header;
+        bcos::protocol::BlockNumber index;
+        IndexType leader;
+        bcos::crypto::HashType proposalHash;
+        size_t messageSize;
+        std::vector<bcos::crypto::HashType> chunkHashes;
+        std::shared_ptr<ReedSolomon> codec;
+        std::map<size_t, bytes> chunks;
+        bool recovered = false;
+    };
+
+    void recover(bcos::crypto::HashType const& _messageHash, ProposalChunks _proposal);
+    void relay(bcos::crypto::NodeIDPtr _leader, size_t _chunkIndex, bytesConstRef _data);
+    void clearExpiredProposals();
+
+    PBFTConfig::Ptr m_config;
+    ProposalHandler m_handler;
+
+    // the message hash => the chunks received
+    std::map<bcos::crypto::HashType, ProposalChunks> m_proposals;
+    std::mutex x_proposals;
+};
+}  // namespace bcos::consensus
@@ -50,6 +50,9 @@ public:
     virtual void registerOnStableCheckPointCommitFailed(
         std::function<void(bcos::Error::Ptr&&, PBFTProposalInterface::Ptr)>
             _onStableCheckPointCommitFailed) = 0;
+    // notify the number, transactions size and time cost(ms) after the block committed
+    virtual void registerCommittedNotifier(
+        std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> _committedNotifier) = 0;
 };
 }  // namespace consensus
 }  // namespace bcos
\ No newline at end of file
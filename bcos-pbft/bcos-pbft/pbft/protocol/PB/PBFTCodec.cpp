@@ -74,6 +74,9 @@ PBFTBaseMessageInterface::Ptr PBFTCodec::decode(bytesConstRef _data) const
     case PacketType::CheckPoint:
     case PacketType::RecoverRequest:
     case PacketType::RecoverResponse:
+    case PacketType::PrepareQCPacket:
+    case PacketType::CommitQCPacket:
+    case PacketType::CheckPointQCPacket:
         decodedMsg = m_pbftMessageFactory->createPBFTMsg(m_cryptoSuite, payLoadRefData);
         break;
     case PacketType::PreparedProposalResponse:
@@ -0,0 +1,454 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief append-only write-ahead log for the committed PBFT proposals
+ * @file ConsensusWAL.cpp
+ * @date 2022-12-05
+ */
+#include "ConsensusWAL.h"
+#include "../utilities/Common.h"
+#include <bcos-utilities/FileUtility.h>
+#include <boost/crc.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace bcos;
+using namespace bcos::consensus;
+using namespace bcos::protocol;
+
+namespace
+{
+uint32_t checksum(byte const* _data, size_t _size)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(_data, _size);
+    return crc.checksum();
+}
+
+void syncFile(int _fd)
+{
+#ifdef __APPLE__
+    auto ret = ::fsync(_fd);
+#else
+    auto ret = ::fdatasync(_fd);
+#endif
+    if (ret != 0)
+    {
+        BOOST_THROW_EXCEPTION(ConsensusWALException() << errinfo_comment(
+                                  "sync the segment failed, errno: " + std::to_string(errno)));
+    }
+}
+}  // namespace
+
+ConsensusWAL::ConsensusWAL(boost::filesystem::path _path, size_t _segmentSize)
+  : m_path(std::move(_path)), m_segmentSize(_segmentSize)
+{}
+
+boost::filesystem::path ConsensusWAL::segmentPath(uint64_t _segment) const
+{
+    // the zero-padded sequence keeps the segments in order when listed
+    auto name = std::to_string(_segment);
+    name.insert(0, 20 - std::min(name.size(), (size_t)20), '0');
+    return m_path / (name + ".wal");
+}
+
+void ConsensusWAL::open()
+{
+    boost::filesystem::create_directories(m_path);
+    std::vector<uint64_t> segments;
+    for (auto const& entry : boost::filesystem::directory_iterator(m_path))
+    {
+        auto const& path = entry.path();
+        if (path.extension() != ".wal")
+        {
+            continue;
+        }
+        try
+        {
+            segments.push_back(boost::lexical_cast<uint64_t>(path.stem().string()));
+        }
+        catch (boost::bad_lexical_cast const&)
+        {
+            PBFT_STORAGE_LOG(WARNING) << LOG_DESC("ConsensusWAL: ignore the unknown file")
+                                      << LOG_KV("file", path.string());
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+    for (auto segment : segments)
+    {
+        recoverSegment(segment);
+    }
+    // never append to the recovered segments
+    openSegment(segments.empty() ? 0 : segments.back() + 1);
+    m_running = true;
+    m_worker = std::thread([this]() { executeWorker(); });
+    PBFT_STORAGE_LOG(INFO) << LOG_DESC("ConsensusWAL: open") << LOG_KV("path", m_path.string())
+                           << LOG_KV("segments", segments.size())
+                           << LOG_KV("records", m_locations.size())
+                           << LOG_KV("maxIndex", m_maxIndex);
+}
+
+void ConsensusWAL::recoverSegment(uint64_t _segment)
+{
+    auto path = segmentPath(_segment);
+    auto data = readContents(path);
+    uint64_t offset = 0;
+    BlockNumber maxIndex = -1;
+    while (offset + RECORD_HEADER_SIZE <= data->size())
+    {
+        auto const* header = data->data() + offset;
+        uint32_t size = 0;
+        uint32_t crc = 0;
+        BlockNumber index = 0;
+        std::memcpy(&size, header, sizeof(size));
+        std::memcpy(&crc, header + 4, sizeof(crc));
+        std::memcpy(&index, header + 8, sizeof(index));
+        if (offset + RECORD_HEADER_SIZE + size > data->size() ||
+            checksum(header + 8, RECORD_HEADER_SIZE - 8 + size) != crc)
+        {
+            break;
+        }
+        m_locations[index] = Location{_segment, offset + RECORD_HEADER_SIZE, size};
+        maxIndex = std::max(maxIndex, index);
+        offset += RECORD_HEADER_SIZE + size;
+    }
+    if (offset < data->size())
+    {
+        // the record not synced completely before the node crashed
+        PBFT_STORAGE_LOG(WARNING) << LOG_DESC("ConsensusWAL: cut off the torn record")
+                                  << LOG_KV("segment", path.string()) << LOG_KV("offset", offset)
+                                  << LOG_KV("fileSize", data->size());
+        boost::filesystem::resize_file(path, offset);
+    }
+    m_segments[_segment] = maxIndex;
+    if (maxIndex > m_maxIndex)
+    {
+        m_maxIndex = maxIndex;
+    }
+}
+
+void ConsensusWAL::openSegment(uint64_t _segment)
+{
+    auto path = segmentPath(_segment);
+    auto fd = ::open(path.string().c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0)
+    {
+        BOOST_THROW_EXCEPTION(ConsensusWALException() << errinfo_comment(
+                                  "open the segment " + path.string() +
+                                  " failed, errno: " + std::to_string(errno)));
+    }
+    // make the new segment file durable in the directory
+    auto dirFd = ::open(m_path.string().c_str(), O_RDONLY);
+    if (dirFd >= 0)
+    {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    std::lock_guard<std::mutex> l(x_locations);
+    m_fd = fd;
+    m_activeSegment = _segment;
+    m_activeOffset = 0;
+    m_segments.emplace(_segment, -1);
+}
+
+ssize_t ConsensusWAL::writeSegment(byte const* _data, size_t _size)
+{
+    return ::write(m_fd, _data, _size);
+}
+
+void ConsensusWAL::closeSegment()
+{
+    if (m_fd < 0)
+    {
+        return;
+    }
+    syncFile(m_fd);
+    ::close(m_fd);
+    m_fd = -1;
+}
+
+void ConsensusWAL::writeRecords(std::vector<std::pair<BlockNumber, bytesPointer>>& _records)
+{
+    std::vector<std::pair<BlockNumber, Location>> locations;
+    locations.reserve(_records.size());
+    bytes buffer;
+    auto writeBuffer = [this, &buffer]() {
+        size_t written = 0;
+        while (written < buffer.size())
+        {
+            auto ret = writeSegment(buffer.data() + written, buffer.size() - written);
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                BOOST_THROW_EXCEPTION(ConsensusWALException() << errinfo_comment(
+                                          "write the segment failed, errno: " +
+                                          std::to_string(errno)));
+            }
+            written += ret;
+        }
+        m_activeOffset += buffer.size();
+        buffer.clear();
+    };
+    for (auto const& [index, data] : _records)
+    {
+        if (m_activeOffset + buffer.size() >= m_segmentSize)
+        {
+            writeBuffer();
+            // synced by closeSegment
+            closeSegment();
+            publishLocations(locations);
+            openSegment(m_activeSegment + 1);
+        }
+        auto recordOffset = m_activeOffset + buffer.size();
+        auto size = (uint32_t)data->size();
+        auto headerOffset = buffer.size();
+        buffer.resize(headerOffset + RECORD_HEADER_SIZE);
+        std::memcpy(buffer.data() + headerOffset, &size, sizeof(size));
+        std::memcpy(buffer.data() + headerOffset + 8, &index, sizeof(index));
+        buffer.insert(buffer.end(), data->begin(), data->end());
+        auto crc = checksum(buffer.data() + headerOffset + 8, RECORD_HEADER_SIZE - 8 + size);
+        std::memcpy(buffer.data() + headerOffset + 4, &crc, sizeof(crc));
+        locations.emplace_back(
+            index, Location{m_activeSegment, recordOffset + RECORD_HEADER_SIZE, size});
+    }
+    writeBuffer();
+    // one sync for all the records
+    syncFile(m_fd);
+    publishLocations(locations);
+}
+
+void ConsensusWAL::publishLocations(std::vector<std::pair<BlockNumber, Location>>& _locations)
+{
+    std::lock_guard<std::mutex> l(x_locations);
+    for (auto const& [index, location] : _locations)
+    {
+        m_locations[index] = location;
+        auto& segmentMaxIndex = m_segments[location.segment];
+        segmentMaxIndex = std::max(segmentMaxIndex, index);
+        if (index > m_maxIndex)
+        {
+            m_maxIndex = index;
+        }
+    }
+    _locations.clear();
+}
+
+void ConsensusWAL::onWriteFailed(std::string const& _error)
+{
+    // the pages of a failed fdatasync may be dropped by the kernel, and a partial write leaves the
+    // file longer than m_activeOffset, so never write the segment again
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    {
+        std::lock_guard<std::mutex> l(x_pendingRecords);
+        m_failed = true;
+        m_error = _error;
+        m_pendingRecords.clear();
+    }
+    m_syncedSignalled.notify_all();
+}
+
+void ConsensusWAL::executeWorker()
+{
+    while (true)
+    {
+        std::vector<std::pair<BlockNumber, bytesPointer>> records;
+        {
+            std::unique_lock<std::mutex> l(x_pendingRecords);
+            m_signalled.wait(l, [this]() { return !m_pendingRecords.empty() || !m_running; });
+            if (m_pendingRecords.empty())
+            {
+                return;
+            }
+            records.swap(m_pendingRecords);
+        }
+        auto startT = utcTime();
+        size_t dataSize = 0;
+        for (auto const& record : records)
+        {
+            dataSize += record.second->size();
+        }
+        try
+        {
+            writeRecords(records);
+        }
+        catch (std::exception const& e)
+        {
+            PBFT_STORAGE_LOG(ERROR) << LOG_DESC("ConsensusWAL: write records failed")
+                                    << LOG_KV("records", records.size())
+                                    << LOG_KV("error", boost::diagnostic_information(e));
+            onWriteFailed(boost::diagnostic_information(e));
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> l(x_pendingRecords);
+            m_synced += records.size();
+        }
+        m_syncedSignalled.notify_all();
+        PBFT_STORAGE_LOG(INFO) << METRIC << LOG_DESC("ConsensusWAL: group commit")
+                               << LOG_KV("records", records.size()) << LOG_KV("size", dataSize)
+                               << LOG_KV("maxIndex", records.back().first)
+                               << LOG_KV("timeCost", utcTime() - startT);
+    }
+}
+
+void ConsensusWAL::append(BlockNumber _index, bytesPointer _data)
+{
+    if (!_data)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> l(x_pendingRecords);
+        if (m_failed)
+        {
+            BOOST_THROW_EXCEPTION(ConsensusWALException() << errinfo_comment(
+                                      "append to the failed WAL, error: " + m_error));
+        }
+        m_pendingRecords.emplace_back(_index, std::move(_data));
+        m_appended++;
+    }
+    m_signalled.notify_one();
+}
+
+void ConsensusWAL::flush()
+{
+    std::unique_lock<std::mutex> l(x_pendingRecords);
+    auto appended = m_appended;
+    m_syncedSignalled.wait(
+        l, [this, appended]() { return m_synced >= appended || m_failed || !m_running; });
+    if (m_failed)
+    {
+        BOOST_THROW_EXCEPTION(ConsensusWALException()
+                              << errinfo_comment("flush the WAL failed, error: " + m_error));
+    }
+}
+
+void ConsensusWAL::stop()
+{
+    {
+        std::lock_guard<std::mutex> l(x_pendingRecords);
+        if (!m_running)
+        {
+            return;
+        }
+        m_running = false;
+    }
+    // the writer thread exits after the pending records written
+    m_signalled.notify_all();
+    m_syncedSignalled.notify_all();
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+    try
+    {
+        closeSegment();
+    }
+    catch (std::exception const& e)
+    {
+        PBFT_STORAGE_LOG(ERROR) << LOG_DESC("ConsensusWAL: close the segment failed")
+                                << LOG_KV("error", boost::diagnostic_information(e));
+    }
+}
+
+bytesPointer ConsensusWAL::read(BlockNumber _index)
+{
+    Location location;
+    {
+        std::lock_guard<std::mutex> l(x_locations);
+        auto it = m_locations.find(_index);
+        if (it == m_locations.end())
+        {
+            return nullptr;
+        }
+        location = it->second;
+    }
+    auto path = segmentPath(location.segment);
+    auto fd = ::open(path.string().c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    // read the header together to check the record
+    bytes record(RECORD_HEADER_SIZE + location.size);
+    auto recordOffset = location.offset - RECORD_HEADER_SIZE;
+    size_t readSize = 0;
+    while (readSize < record.size())
+    {
+        auto ret = ::pread(
+            fd, record.data() + readSize, record.size() - readSize, recordOffset + readSize);
+        if (ret <= 0)
+        {
+            break;
+        }
+        readSize += ret;
+    }
+    ::close(fd);
+    uint32_t size = 0;
+    uint32_t crc = 0;
+    BlockNumber index = 0;
+    if (readSize == record.size())
+    {
+        std::memcpy(&size, record.data(), sizeof(size));
+        std::memcpy(&crc, record.data() + 4, sizeof(crc));
+        std::memcpy(&index, record.data() + 8, sizeof(index));
+    }
+    if (readSize != record.size() || size != location.size || index != _index ||
+        checksum(record.data() + 8, record.size() - 8) != crc)
+    {
+        PBFT_STORAGE_LOG(WARNING) << LOG_DESC("ConsensusWAL: read record failed")
+                                  << LOG_KV("index", _index) << LOG_KV("segment", path.string())
+                                  << LOG_KV("offset", recordOffset) << LOG_KV("readSize", readSize);
+        return nullptr;
+    }
+    return std::make_shared<bytes>(record.begin() + RECORD_HEADER_SIZE, record.end());
+}
+
+void ConsensusWAL::truncate(BlockNumber _index)
+{
+    std::vector<uint64_t> removedSegments;
+    {
+        std::lock_guard<std::mutex> l(x_locations);
+        m_locations.erase(m_locations.begin(), m_locations.upper_bound(_index));
+        for (auto it = m_segments.begin(); it != m_segments.end();)
+        {
+            if (it->first == m_activeSegment || it->second > _index)
+            {
+                ++it;
+                continue;
+            }
+            removedSegments.push_back(it->first);
+            it = m_segments.erase(it);
+        }
+    }
+    for (auto segment : removedSegments)
+    {
+        boost::system::error_code error;
+        boost::filesystem::remove(segmentPath(segment), error);
+        PBFT_STORAGE_LOG(INFO) << LOG_DESC("ConsensusWAL: remove the segment")
+                               << LOG_KV("segment", segment) << LOG_KV("truncateIndex", _index)
+                               << LOG_KV("error", error.message());
+    }
+}
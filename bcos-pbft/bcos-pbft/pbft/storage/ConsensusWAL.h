@@ -0,0 +1,128 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief append-only write-ahead log for the committed PBFT proposals
+ * @file ConsensusWAL.h
+ * @date 2022-12-05
+ */
+#pragma once
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Exceptions.h>
+#include <sys/types.h>
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bcos::consensus
+{
+DERIVE_BCOS_EXCEPTION(ConsensusWALException);
+/**
+ * @brief The committed proposals are appended to segment files named by the sequence of the
+ * segment, every record is [size(4B)][crc32(4B)][index(8B)][data], and the crc32 covers the index
+ * and the data. The records appended meanwhile are written by the writer thread and synced to the
+ * disk by one fdatasync. The segments whose records are all no larger than the stable checkpoint
+ * are removed by truncate. A torn record at the tail of a segment is cut off when the WAL opened.
+ * A failed write or sync is fatal: the records not synced are never made readable, the pending
+ * flushes fail and no more record is accepted until the WAL reopened.
+ */
+class ConsensusWAL
+{
+public:
+    using Ptr = std::shared_ptr<ConsensusWAL>;
+    constexpr static size_t DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+    constexpr static size_t RECORD_HEADER_SIZE = 16;
+
+    explicit ConsensusWAL(
+        boost::filesystem::path _path, size_t _segmentSize = DEFAULT_SEGMENT_SIZE);
+    virtual ~ConsensusWAL() { stop(); }
+
+    // recover the records from the segments and start the writer thread
+    virtual void open();
+    virtual void stop();
+
+    // the record is written and synced by the writer thread, the later record of the same index
+    // overwrites the former one, throw ConsensusWALException if the WAL failed
+    virtual void append(bcos::protocol::BlockNumber _index, bytesPointer _data);
+    // wait until all the records appended before synced to the disk, throw ConsensusWALException
+    // if any of them failed to be written or synced
+    virtual void flush();
+
+    // nullptr if the record of the index not exists
+    virtual bytesPointer read(bcos::protocol::BlockNumber _index);
+    // remove the records no larger than _index, and the segments containing only them
+    virtual void truncate(bcos::protocol::BlockNumber _index);
+
+    bcos::protocol::BlockNumber maxIndex() const { return m_maxIndex; }
+    size_t segmentSize() const { return m_segmentSize; }
+    bool failed() const { return m_failed; }
+
+protected:
+    // write to the active segment, overridden by the tests to inject the failures
+    virtual ssize_t writeSegment(byte const* _data, size_t _size);
+
+private:
+    struct Location
+    {
+        uint64_t segment;
+        uint64_t offset;
+        uint32_t size;
+    };
+
+    boost::filesystem::path segmentPath(uint64_t _segment) const;
+    void recoverSegment(uint64_t _segment);
+    // called by the writer thread
+    void openSegment(uint64_t _segment);
+    void closeSegment();
+    void writeRecords(std::vector<std::pair<bcos::protocol::BlockNumber, bytesPointer>>& _records);
+    void onWriteFailed(std::string const& _error);
+    // make the synced records readable
+    void publishLocations(
+        std::vector<std::pair<bcos::protocol::BlockNumber, Location>>& _locations);
+    void executeWorker();
+
+    boost::filesystem::path m_path;
+    size_t m_segmentSize;
+
+    // the index => the location of the latest record
+    std::map<bcos::protocol::BlockNumber, Location> m_locations;
+    // the sequence of the segment => the max index of the records in it
+    std::map<uint64_t, bcos::protocol::BlockNumber> m_segments;
+    std::atomic<bcos::protocol::BlockNumber> m_maxIndex = {0};
+    mutable std::mutex x_locations;
+
+    // the segment written by the writer thread, the sequence updated with x_locations held
+    int m_fd = -1;
+    uint64_t m_activeSegment = 0;
+    uint64_t m_activeOffset = 0;
+
+    std::vector<std::pair<bcos::protocol::BlockNumber, bytesPointer>> m_pendingRecords;
+    // the records appended and handled by the writer thread, used by flush
+    uint64_t m_appended = 0;
+    uint64_t m_synced = 0;
+    std::atomic_bool m_failed = {false};
+    std::string m_error;
+    std::mutex x_pendingRecords;
+    std::condition_variable m_signalled;
+    std::condition_variable m_syncedSignalled;
+
+    std::thread m_worker;
+    bool m_running = false;
+};
+}  // namespace bcos::consensus
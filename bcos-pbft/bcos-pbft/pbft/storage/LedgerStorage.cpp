@@ -32,18 +32,14 @@ using namespace bcos::storage;
 
 PBFTProposalListPtr LedgerStorage::loadState(BlockNumber _stabledIndex)
 {
-    m_maxCommittedProposalIndexFetched = false;
-    asyncGetLatestCommittedProposalIndex();
-    auto startT = utcSteadyTime();
-    while (utcSteadyTime() - startT < m_timeout)
+    // the proposals committed before the WAL enabled are still in the kv-storage
+    if (m_wal && m_wal->maxIndex() > 0)
     {
-        if (m_maxCommittedProposalIndexFetched)
-        {
-            break;
-        }
-        boost::unique_lock<boost::mutex> l(x_signalled);
-        m_signalled.wait_for(l, boost::chrono::milliseconds(10));
+        return loadStateFromWAL(_stabledIndex);
     }
+    m_maxCommittedProposalIndexFetched = false;
+    asyncGetLatestCommittedProposalIndex();
+    waitSignal([this]() { return m_maxCommittedProposalIndexFetched.load(); });
     if (!m_maxCommittedProposalIndexFetched)
     {
         PBFT_STORAGE_LOG(WARNING) << LOG_DESC(
@@ -81,7 +77,7 @@ PBFTProposalListPtr LedgerStorage::loadState(BlockNumber _stabledIndex)
                     storage->m_stateProposals = _proposalList;
                 }
                 storage->m_stateFetched = true;
-                storage->m_signalled.notify_all();
+                storage->notifySignal();
             }
             catch (std::exception const& e)
             {
@@ -92,16 +88,7 @@ PBFTProposalListPtr LedgerStorage::loadState(BlockNumber _stabledIndex)
                     << LOG_KV("error", boost::diagnostic_information(e));
             }
         });
-    startT = utcSteadyTime();
-    while (utcSteadyTime() - startT < m_timeout)
-    {
-        if (m_stateFetched)
-        {
-            break;
-        }
-        boost::unique_lock<boost::mutex> l(x_signalled);
-        m_signalled.wait_for(l, boost::chrono::milliseconds(10));
-    }
+    waitSignal([this]() { return m_stateFetched.load(); });
     if (!m_stateFetched)
     {
         PBFT_STORAGE_LOG(WARNING) << LOG_DESC(
@@ -116,6 +103,52 @@ PBFTProposalListPtr LedgerStorage::loadState(BlockNumber _stabledIndex)
     return m_stateProposals;
 }
 
+PBFTProposalListPtr LedgerStorage::loadStateFromWAL(BlockNumber _stabledIndex)
+{
+    if (m_maxCommittedProposalIndex < m_wal->maxIndex())
+    {
+        m_maxCommittedProposalIndex = m_wal->maxIndex();
+    }
+    if (m_maxCommittedProposalIndex <= _stabledIndex)
+    {
+        PBFT_STORAGE_LOG(INFO) << LOG_DESC("no need to recover committed proposal from the WAL")
+                               << LOG_KV("maxCommittedProposal", m_maxCommittedProposalIndex)
+                               << LOG_KV("stableCheckPoint", _stabledIndex);
+        m_maxCommittedProposalIndex = _stabledIndex;
+        return nullptr;
+    }
+    auto startT = utcTime();
+    auto proposals = readProposalsFromWAL(_stabledIndex + 1, m_maxCommittedProposalIndex);
+    PBFT_STORAGE_LOG(INFO) << LOG_DESC("recover committed proposal from the WAL")
+                           << LOG_KV("start", _stabledIndex + 1)
+                           << LOG_KV("end", m_maxCommittedProposalIndex)
+                           << LOG_KV("recovered", proposals ? proposals->size() : 0)
+                           << LOG_KV("timeCost", utcTime() - startT);
+    if (!proposals || proposals->empty())
+    {
+        m_maxCommittedProposalIndex = _stabledIndex;
+    }
+    m_stateProposals = proposals;
+    return proposals;
+}
+
+PBFTProposalListPtr LedgerStorage::readProposalsFromWAL(BlockNumber _start, BlockNumber _end)
+{
+    auto proposalList = std::make_shared<PBFTProposalList>();
+    for (auto i = _start; i <= _end; i++)
+    {
+        auto data = m_wal->read(i);
+        if (!data)
+        {
+            PBFT_STORAGE_LOG(INFO) << LOG_DESC("readProposalsFromWAL: missing committed proposal")
+                                   << LOG_KV("index", i);
+            return nullptr;
+        }
+        proposalList->push_back(m_messageFactory->createPBFTProposal(ref(*data)));
+    }
+    return proposalList;
+}
+
 void LedgerStorage::asyncGetCommittedProposals(
     BlockNumber _start, size_t _offset, std::function<void(PBFTProposalListPtr)> _onSuccess)
 {
@@ -128,9 +161,14 @@ void LedgerStorage::asyncGetCommittedProposals(
                                   << LOG_KV("requestedMinIndex", _start);
         return;
     }
-    auto keys = std::make_shared<std::vector<std::string>>();
     auto endIndex =
         std::min((int64_t)(_start + _offset - 1), (int64_t)m_maxCommittedProposalIndex.load());
+    if (m_wal)
+    {
+        _onSuccess(readProposalsFromWAL(_start, endIndex));
+        return;
+    }
+    auto keys = std::make_shared<std::vector<std::string>>();
     for (int64_t i = _start; i <= endIndex; i++)
     {
         keys->push_back(boost::lexical_cast<std::string>(i));
@@ -191,13 +229,12 @@ void LedgerStorage::asyncGetLatestCommittedProposalIndex()
                 auto storage = self.lock();
                 if (!storage)
                 {
-                    storage->m_signalled.notify_all();
                     return;
                 }
                 if (_value.empty())
                 {
                     storage->m_maxCommittedProposalIndexFetched = true;
-                    storage->m_signalled.notify_all();
+                    storage->notifySignal();
                     return;
                 }
                 if (_error != nullptr)
@@ -206,7 +243,7 @@ void LedgerStorage::asyncGetLatestCommittedProposalIndex()
                         << LOG_DESC("asyncGetLatestCommittedProposalIndex failed")
                         << LOG_KV("errorCode", _error->errorCode())
                         << LOG_KV("errorMessage", _error->errorMessage());
-                    storage->m_signalled.notify_all();
+                    storage->notifySignal();
                     return;
                 }
                 auto latestCommittedProposalIndex = boost::lexical_cast<int64_t>(_value);
@@ -215,7 +252,7 @@ void LedgerStorage::asyncGetLatestCommittedProposalIndex()
                     storage->m_maxCommittedProposalIndex = latestCommittedProposalIndex;
                 }
                 storage->m_maxCommittedProposalIndexFetched = true;
-                storage->m_signalled.notify_all();
+                storage->notifySignal();
                 PBFT_STORAGE_LOG(INFO)
                     << LOG_DESC("asyncGetLatestCommittedProposalIndex")
                     << LOG_KV("latestCommittedProposalIndex", storage->m_maxCommittedProposalIndex);
@@ -238,6 +275,21 @@ void LedgerStorage::asyncCommitProposal(PBFTProposalInterface::Ptr _committedPro
     m_maxCommittedProposalIndex.store(_committedProposal->index());
     PBFT_STORAGE_LOG(INFO) << LOG_DESC("asyncCommitProposal: write the committed proposal into db")
                            << LOG_KV("index", _committedProposal->index());
+    if (m_wal)
+    {
+        // the max committed index is recovered from the records of the WAL
+        try
+        {
+            m_wal->append(_committedProposal->index(), _committedProposal->encode());
+        }
+        catch (std::exception const& e)
+        {
+            PBFT_STORAGE_LOG(ERROR) << LOG_DESC("asyncCommitProposal: append to the WAL failed")
+                                    << LOG_KV("index", _committedProposal->index())
+                                    << LOG_KV("error", boost::diagnostic_information(e));
+        }
+        return;
+    }
     // commit the max-index proposal information
     auto maxIndexStr = boost::lexical_cast<std::string>(m_maxCommittedProposalIndex);
     auto maxIndexBytes = std::make_shared<bytes>(maxIndexStr.begin(), maxIndexStr.end());
@@ -385,6 +437,11 @@ void LedgerStorage::commitStableCheckPoint(PBFTProposalInterface::Ptr _stablePro
                 << LOG_KV("txs", _blockInfo->transactionsHashSize())
                 << LOG_KV("timeCost", utcTime() - startT) << LOG_KV("commitPerTx", commitPerTx);
             auto txsSize = _blockInfo->transactionsHashSize();
+            if (ledgerStorage->m_committedNotifier)
+            {
+                ledgerStorage->m_committedNotifier(
+                    _blockHeader->number(), txsSize, utcTime() - startT);
+            }
             // Note:Here the thread pool is used to asynchronize the operation of PBFT finalize to
             // prevent the commitBlock from calling the callback synchronously and affecting the
             // performance.
@@ -410,6 +467,11 @@ void LedgerStorage::asyncRemoveStabledCheckPoint(size_t _stabledCheckPointIndex)
 {
     PBFT_STORAGE_LOG(INFO) << LOG_DESC("asyncRemoveStabledCheckPoint")
                            << LOG_KV("index", _stabledCheckPointIndex);
+    if (m_wal)
+    {
+        m_wal->truncate(_stabledCheckPointIndex);
+        return;
+    }
     asyncRemove(m_pbftCommitDB, boost::lexical_cast<std::string>(_stabledCheckPointIndex));
 }
 
@@ -21,6 +21,7 @@
 #pragma once
 #include "../interfaces/PBFTMessageFactory.h"
 #include "../interfaces/PBFTStorage.h"
+#include "ConsensusWAL.h"
 #include <bcos-framework/dispatcher/SchedulerInterface.h>
 #include <bcos-framework/protocol/BlockFactory.h>
 #include <bcos-framework/storage/KVStorageHelper.h>
@@ -53,6 +54,9 @@ public:
         }
     }
     void createKVTable(std::string const& _dbName);
+    // persist the committed proposals into the WAL instead of the kv-storage
+    void setConsensusWAL(ConsensusWAL::Ptr _wal) { m_wal = std::move(_wal); }
+
     PBFTProposalListPtr loadState(bcos::protocol::BlockNumber _stabledIndex) override;
 
     // commit the committed proposal into the kv-storage
@@ -72,6 +76,13 @@ public:
         m_onStableCheckPointCommitFailed = std::move(_onStableCheckPointCommitFailed);
     }
 
+    void registerCommittedNotifier(
+        std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> _committedNotifier)
+        override
+    {
+        m_committedNotifier = std::move(_committedNotifier);
+    }
+
     void asyncGetCommittedProposals(bcos::protocol::BlockNumber _start, size_t _offset,
         std::function<void(PBFTProposalListPtr)> _onSuccess) override;
 
@@ -89,6 +100,25 @@ protected:
     virtual void commitStableCheckPoint(PBFTProposalInterface::Ptr _stableProposal,
         bcos::protocol::BlockHeader::Ptr _blockHeader, bcos::protocol::Block::Ptr _blockInfo);
     virtual void asyncGetLatestCommittedProposalIndex();
+    virtual PBFTProposalListPtr loadStateFromWAL(bcos::protocol::BlockNumber _stabledIndex);
+    virtual PBFTProposalListPtr readProposalsFromWAL(
+        bcos::protocol::BlockNumber _start, bcos::protocol::BlockNumber _end);
+
+    // wait until _fetched returns true or m_timeout elapsed, woken up by notifySignal
+    template <class Predicate>
+    void waitSignal(Predicate _fetched)
+    {
+        boost::unique_lock<boost::mutex> l(x_signalled);
+        m_signalled.wait_for(l, boost::chrono::milliseconds(m_timeout), _fetched);
+    }
+    void notifySignal()
+    {
+        {
+            // avoid missing the notification before waitSignal starts waiting
+            boost::unique_lock<boost::mutex> l(x_signalled);
+        }
+        m_signalled.notify_all();
+    }
 
     virtual void onStableCheckPointCommitted(size_t _txsSize,
         bcos::protocol::BlockHeader::Ptr _blockHeader,
@@ -117,6 +147,8 @@ protected:
     std::function<void(bcos::ledger::LedgerConfig::Ptr, bool _syncBlock)> m_finalizeHandler;
     std::function<void(bcos::Error::Ptr&&, PBFTProposalInterface::Ptr)>
         m_onStableCheckPointCommitFailed;
+    std::function<void(bcos::protocol::BlockNumber, size_t, uint64_t)> m_committedNotifier;
     std::shared_ptr<ThreadPool> m_commitBlockWorker;
+    ConsensusWAL::Ptr m_wal;
 };
 }  // namespace bcos::consensus
\ No newline at end of file
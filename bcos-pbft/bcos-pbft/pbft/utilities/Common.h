@@ -42,6 +42,12 @@ enum PacketType : uint32_t
     CheckPoint = 0x9,
     RecoverRequest = 0xa,
     RecoverResponse = 0xb,
+    // the erasure-coded chunk of the pre-prepare message
+    ProposalChunkPacket = 0xc,
+    // the votes bundled by the collector
+    PrepareQCPacket = 0xd,
+    CommitQCPacket = 0xe,
+    CheckPointQCPacket = 0xf,
 };
 DERIVE_BCOS_EXCEPTION(UnknownPBFTMsgType);
 DERIVE_BCOS_EXCEPTION(InitPBFTException);
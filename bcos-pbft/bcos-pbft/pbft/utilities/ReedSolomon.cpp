@@ -0,0 +1,218 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief systematic Reed-Solomon erasure code over GF(2^8)
+ * @file ReedSolomon.cpp
+ * @date 2022-11-28
+ */
+#include "ReedSolomon.h"
+#include <array>
+#include <cstring>
+
+using namespace bcos;
+using namespace bcos::consensus;
+
+namespace
+{
+// the exp and log tables of GF(2^8) generated by x^8 + x^4 + x^3 + x^2 + 1
+struct GaloisField
+{
+    GaloisField()
+    {
+        unsigned x = 1;
+        for (size_t i = 0; i < 255; ++i)
+        {
+            exp[i] = (uint8_t)x;
+            exp[i + 255] = (uint8_t)x;
+            log[x] = (uint8_t)i;
+            x <<= 1;
+            if (x & 0x100)
+            {
+                x ^= 0x11d;
+            }
+        }
+    }
+    uint8_t mul(uint8_t _a, uint8_t _b) const
+    {
+        if (_a == 0 || _b == 0)
+        {
+            return 0;
+        }
+        return exp[log[_a] + log[_b]];
+    }
+    uint8_t inv(uint8_t _a) const { return exp[255 - log[_a]]; }
+
+    std::array<uint8_t, 510> exp{};
+    std::array<uint8_t, 256> log{};
+};
+
+GaloisField const& gf()
+{
+    static const GaloisField field;
+    return field;
+}
+
+// _out ^= _coefficient * _in, byte by byte
+void mulAdd(uint8_t _coefficient, byte const* _in, byte* _out, size_t _size)
+{
+    if (_coefficient == 0)
+    {
+        return;
+    }
+    std::array<uint8_t, 256> row;
+    for (unsigned i = 0; i < 256; ++i)
+    {
+        row[i] = gf().mul(_coefficient, (uint8_t)i);
+    }
+    for (size_t i = 0; i < _size; ++i)
+    {
+        _out[i] ^= row[_in[i]];
+    }
+}
+}  // namespace
+
+ReedSolomon::ReedSolomon(size_t _dataShards, size_t _totalShards)
+  : m_dataShards(_dataShards), m_totalShards(_totalShards)
+{
+    if (m_dataShards == 0 || m_dataShards > m_totalShards || m_totalShards > MAX_SHARDS)
+    {
+        BOOST_THROW_EXCEPTION(ReedSolomonException() << errinfo_comment(
+                                  "invalid shards: " + std::to_string(_dataShards) + "/" +
+                                  std::to_string(_totalShards)));
+    }
+}
+
+uint8_t ReedSolomon::coefficient(size_t _row, size_t _column) const
+{
+    if (_row < m_dataShards)
+    {
+        return _row == _column ? 1 : 0;
+    }
+    // 1 / (x_row + y_column), the x and y are distinct in GF(2^8)
+    return gf().inv((uint8_t)(_row ^ _column));
+}
+
+std::vector<bytes> ReedSolomon::encode(bytesConstRef _data) const
+{
+    auto size = shardSize(_data.size());
+    std::vector<bytes> shards(m_totalShards, bytes(size, 0));
+    for (size_t i = 0; i < m_dataShards; ++i)
+    {
+        auto offset = i * size;
+        if (offset < _data.size())
+        {
+            std::memcpy(
+                shards[i].data(), _data.data() + offset, std::min(size, _data.size() - offset));
+        }
+    }
+    for (size_t row = m_dataShards; row < m_totalShards; ++row)
+    {
+        for (size_t column = 0; column < m_dataShards; ++column)
+        {
+            mulAdd(coefficient(row, column), shards[column].data(), shards[row].data(), size);
+        }
+    }
+    return shards;
+}
+
+bytes ReedSolomon::decode(std::map<size_t, bytes> const& _shards, size_t _dataSize) const
+{
+    auto size = shardSize(_dataSize);
+    // the first dataShards shards received, the data shards come first in the map
+    std::vector<std::pair<size_t, bytes const*>> rows;
+    for (auto const& [index, shard] : _shards)
+    {
+        if (index >= m_totalShards || shard.size() != size)
+        {
+            BOOST_THROW_EXCEPTION(ReedSolomonException()
+                                  << errinfo_comment("invalid shard " + std::to_string(index)));
+        }
+        rows.emplace_back(index, &shard);
+        if (rows.size() == m_dataShards)
+        {
+            break;
+        }
+    }
+    if (rows.size() < m_dataShards)
+    {
+        BOOST_THROW_EXCEPTION(ReedSolomonException() << errinfo_comment(
+                                  "not enough shards: " + std::to_string(rows.size())));
+    }
+    bytes data(m_dataShards * size, 0);
+    if (rows.back().first < m_dataShards)
+    {
+        for (size_t i = 0; i < m_dataShards; ++i)
+        {
+            std::memcpy(data.data() + i * size, rows[i].second->data(), size);
+        }
+        data.resize(_dataSize);
+        return data;
+    }
+    // invert the rows of the received shards in the encoding matrix by Gauss-Jordan elimination
+    auto k = m_dataShards;
+    std::vector<std::vector<uint8_t>> matrix(k, std::vector<uint8_t>(k));
+    std::vector<std::vector<uint8_t>> inverse(k, std::vector<uint8_t>(k, 0));
+    for (size_t i = 0; i < k; ++i)
+    {
+        for (size_t j = 0; j < k; ++j)
+        {
+            matrix[i][j] = coefficient(rows[i].first, j);
+        }
+        inverse[i][i] = 1;
+    }
+    for (size_t column = 0; column < k; ++column)
+    {
+        auto pivot = column;
+        while (pivot < k && matrix[pivot][column] == 0)
+        {
+            ++pivot;
+        }
+        if (pivot == k)
+        {
+            BOOST_THROW_EXCEPTION(
+                ReedSolomonException() << errinfo_comment("singular decoding matrix"));
+        }
+        std::swap(matrix[pivot], matrix[column]);
+        std::swap(inverse[pivot], inverse[column]);
+        auto factor = gf().inv(matrix[column][column]);
+        for (size_t j = 0; j < k; ++j)
+        {
+            matrix[column][j] = gf().mul(matrix[column][j], factor);
+            inverse[column][j] = gf().mul(inverse[column][j], factor);
+        }
+        for (size_t i = 0; i < k; ++i)
+        {
+            auto scale = matrix[i][column];
+            if (i == column || scale == 0)
+            {
+                continue;
+            }
+            for (size_t j = 0; j < k; ++j)
+            {
+                matrix[i][j] ^= gf().mul(scale, matrix[column][j]);
+                inverse[i][j] ^= gf().mul(scale, inverse[column][j]);
+            }
+        }
+    }
+    for (size_t i = 0; i < k; ++i)
+    {
+        for (size_t j = 0; j < k; ++j)
+        {
+            mulAdd(inverse[i][j], rows[j].second->data(), data.data() + i * size, size);
+        }
+    }
+    data.resize(_dataSize);
+    return data;
+}
@@ -0,0 +1,61 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief systematic Reed-Solomon erasure code over GF(2^8)
+ * @file ReedSolomon.h
+ * @date 2022-11-28
+ */
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Exceptions.h>
+#include <map>
+#include <vector>
+
+namespace bcos::consensus
+{
+DERIVE_BCOS_EXCEPTION(ReedSolomonException);
+/**
+ * @brief Splits the data into dataShards shards of the same size and appends
+ * totalShards - dataShards parity shards, the data is recovered from any dataShards of them.
+ * The first dataShards shards are the data itself, the parity rows are a Cauchy matrix so every
+ * square sub-matrix of the encoding matrix is invertible.
+ */
+class ReedSolomon
+{
+public:
+    constexpr static size_t MAX_SHARDS = 255;
+
+    ReedSolomon(size_t _dataShards, size_t _totalShards);
+    virtual ~ReedSolomon() = default;
+
+    size_t dataShards() const { return m_dataShards; }
+    size_t totalShards() const { return m_totalShards; }
+    size_t shardSize(size_t _dataSize) const
+    {
+        return std::max((_dataSize + m_dataShards - 1) / m_dataShards, (size_t)1);
+    }
+
+    // the data is padded with zero to dataShards * shardSize
+    std::vector<bytes> encode(bytesConstRef _data) const;
+    // recover the _dataSize bytes from at least dataShards shards indexed by the shard index
+    bytes decode(std::map<size_t, bytes> const& _shards, size_t _dataSize) const;
+
+private:
+    uint8_t coefficient(size_t _row, size_t _column) const;
+
+    size_t m_dataShards;
+    size_t m_totalShards;
+};
+}  // namespace bcos::consensus
@@ -0,0 +1,235 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the pre-execution of the StateMachine
+ * @file StateMachineTest.cpp
+ * @date 2022-11-28
+ */
+#include "bcos-pbft/core/Proposal.h"
+#include "bcos-pbft/core/StateMachine.h"
+#include <bcos-framework/dispatcher/SchedulerTypeDef.h>
+#include <bcos-framework/testutils/faker/FakeScheduler.h>
+#include <bcos-tars-protocol/testutil/FakeBlock.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::consensus;
+using namespace bcos::protocol;
+namespace bcos
+{
+namespace test
+{
+// executes the blocks when finish() is called, and like the scheduler, fails the block of the
+// executed number with another hash and drops the executed one
+class DeferredScheduler : public FakeScheduler
+{
+public:
+    using Ptr = std::shared_ptr<DeferredScheduler>;
+    explicit DeferredScheduler(BlockFactory::Ptr _blockFactory)
+      : FakeScheduler(nullptr, std::move(_blockFactory))
+    {}
+
+    void executeBlock(bcos::protocol::Block::Ptr _block, bool _verify,
+        std::function<void(bcos::Error::Ptr&&, bcos::protocol::BlockHeader::Ptr&&, bool)>
+            _callback) noexcept override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_executions;
+        m_pending.emplace_back(std::move(_block), _verify, std::move(_callback));
+    }
+
+    size_t executions()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_executions;
+    }
+
+    // wait for the state machine to call executeBlock on its worker
+    bool waitForPending(size_t _pending)
+    {
+        for (auto i = 0; i < 500; ++i)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_pending.size() >= _pending)
+                {
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    void finish()
+    {
+        Pending pending;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            pending = std::move(m_pending.front());
+            m_pending.pop_front();
+        }
+        auto& [block, verify, callback] = pending;
+        auto header = block->blockHeader();
+        auto it = m_executed.find(header->number());
+        if (it != m_executed.end() && it->second != header->hash())
+        {
+            m_executed.erase(it);
+            callback(BCOS_ERROR_PTR(
+                         bcos::scheduler::SchedulerError::InvalidBlocks, "another cached block"),
+                nullptr, false);
+            return;
+        }
+        m_executed[header->number()] = header->hash();
+        FakeScheduler::executeBlock(block, verify, std::move(callback));
+    }
+
+private:
+    using Pending = std::tuple<Block::Ptr, bool,
+        std::function<void(bcos::Error::Ptr&&, bcos::protocol::BlockHeader::Ptr&&, bool)>>;
+    std::mutex m_mutex;
+    std::deque<Pending> m_pending;
+    size_t m_executions = 0;
+    std::map<BlockNumber, bcos::crypto::HashType> m_executed;
+};
+
+class StateMachineFixture : public TestPromptFixture
+{
+public:
+    StateMachineFixture()
+    {
+        m_cryptoSuite = createNormalCryptoSuite();
+        m_blockFactory = createBlockFactory(m_cryptoSuite);
+        m_scheduler = std::make_shared<DeferredScheduler>(m_blockFactory);
+        m_stateMachine = std::make_shared<StateMachine>(m_scheduler, m_blockFactory);
+
+        m_lastAppliedProposal = std::make_shared<Proposal>();
+        m_lastAppliedProposal->setIndex(10);
+        m_lastAppliedProposal->setHash(m_cryptoSuite->hash(std::string("parent")));
+    }
+
+    // the proposals of the same index differ in the timestamp
+    ProposalInterface::Ptr fakeProposal(int64_t _timestamp)
+    {
+        auto block = m_blockFactory->createBlock();
+        block->blockHeader()->setNumber(m_lastAppliedProposal->index() + 1);
+        block->blockHeader()->setTimestamp(_timestamp);
+        for (size_t i = 0; i < 10; ++i)
+        {
+            auto hash = m_cryptoSuite->hash(std::to_string(i));
+            block->appendTransactionMetaData(
+                m_blockFactory->createTransactionMetaData(hash, "contract"));
+        }
+        bytes data;
+        block->encode(data);
+        auto proposal = std::make_shared<Proposal>();
+        proposal->setIndex(block->blockHeader()->number());
+        proposal->setHash(m_cryptoSuite->hash(data));
+        proposal->setData(std::move(data));
+        return proposal;
+    }
+
+    std::future<int64_t> apply(ProposalInterface::Ptr _proposal, ProposalInterface::Ptr _executed)
+    {
+        auto promise = std::make_shared<std::promise<int64_t>>();
+        m_stateMachine->asyncApply(0, m_lastAppliedProposal, std::move(_proposal),
+            std::move(_executed), [promise](int64_t _code) { promise->set_value(_code); });
+        return promise->get_future();
+    }
+
+    bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
+    BlockFactory::Ptr m_blockFactory;
+    DeferredScheduler::Ptr m_scheduler;
+    std::shared_ptr<StateMachine> m_stateMachine;
+    ProposalInterface::Ptr m_lastAppliedProposal;
+};
+
+BOOST_FIXTURE_TEST_SUITE(StateMachineTest, StateMachineFixture)
+
+BOOST_AUTO_TEST_CASE(testPreExecuted)
+{
+    auto proposal = fakeProposal(1000);
+    m_stateMachine->asyncPreExecute(m_lastAppliedProposal, proposal);
+    BOOST_REQUIRE(m_scheduler->waitForPending(1));
+    // the proposal of the index is pre-executed only once
+    m_stateMachine->asyncPreExecute(m_lastAppliedProposal, proposal);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(m_scheduler->executions(), 1);
+    m_scheduler->finish();
+
+    // the result of the pre-execution is applied without executing the block again
+    auto executedProposal = std::make_shared<Proposal>();
+    auto result = apply(proposal, executedProposal);
+    BOOST_REQUIRE(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(result.get(), 0);
+    BOOST_CHECK_EQUAL(m_scheduler->executions(), 1);
+    BOOST_CHECK_EQUAL(executedProposal->index(), proposal->index());
+}
+
+BOOST_AUTO_TEST_CASE(testWaitForPreExecution)
+{
+    auto proposal = fakeProposal(1000);
+    m_stateMachine->asyncPreExecute(m_lastAppliedProposal, proposal);
+    BOOST_REQUIRE(m_scheduler->waitForPending(1));
+
+    // applied while the pre-execution is running
+    auto executedProposal = std::make_shared<Proposal>();
+    auto result = apply(proposal, executedProposal);
+    BOOST_CHECK(result.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+    BOOST_CHECK_EQUAL(m_scheduler->executions(), 1);
+
+    m_scheduler->finish();
+    BOOST_REQUIRE(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(result.get(), 0);
+    BOOST_CHECK_EQUAL(m_scheduler->executions(), 1);
+    BOOST_CHECK_EQUAL(executedProposal->index(), proposal->index());
+}
+
+BOOST_AUTO_TEST_CASE(testConflictedProposal)
+{
+    auto preExecutedProposal = fakeProposal(1000);
+    m_stateMachine->asyncPreExecute(m_lastAppliedProposal, preExecutedProposal);
+    BOOST_REQUIRE(m_scheduler->waitForPending(1));
+    m_scheduler->finish();
+
+    // another proposal of the index is committed after a view change
+    auto proposal = fakeProposal(2000);
+    BOOST_CHECK_NE(proposal->hash(), preExecutedProposal->hash());
+    auto executedProposal = std::make_shared<Proposal>();
+    auto result = apply(proposal, executedProposal);
+    BOOST_REQUIRE(m_scheduler->waitForPending(1));
+    m_scheduler->finish();
+    BOOST_REQUIRE(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(result.get(), bcos::scheduler::SchedulerError::InvalidBlocks);
+    BOOST_CHECK_EQUAL(m_scheduler->executions(), 2);
+
+    // the retry executes the committed proposal
+    result = apply(proposal, executedProposal);
+    BOOST_REQUIRE(m_scheduler->waitForPending(1));
+    m_scheduler->finish();
+    BOOST_REQUIRE(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(result.get(), 0);
+    BOOST_CHECK_EQUAL(m_scheduler->executions(), 3);
+    BOOST_CHECK_EQUAL(executedProposal->index(), proposal->index());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
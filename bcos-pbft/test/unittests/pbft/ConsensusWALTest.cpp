@@ -0,0 +1,216 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit tests for the consensus WAL
+ * @file ConsensusWALTest.cpp
+ * @date 2022-12-05
+ */
+#include "bcos-pbft/pbft/storage/ConsensusWAL.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::consensus;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(ConsensusWALTest, TestPromptFixture)
+
+bytesPointer fakeRecord(protocol::BlockNumber _index, size_t _size)
+{
+    auto data = std::make_shared<bytes>(_size, (byte)_index);
+    return data;
+}
+
+size_t segmentFiles(boost::filesystem::path const& _path)
+{
+    size_t count = 0;
+    for (auto const& entry : boost::filesystem::directory_iterator(_path))
+    {
+        count += (entry.path().extension() == ".wal");
+    }
+    return count;
+}
+
+BOOST_AUTO_TEST_CASE(testAppendAndRecover)
+{
+    auto path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("consensus_wal_%%%%%%");
+    {
+        auto wal = std::make_shared<ConsensusWAL>(path, 4096);
+        wal->open();
+        BOOST_CHECK_EQUAL(wal->maxIndex(), 0);
+        for (protocol::BlockNumber i = 1; i <= 20; i++)
+        {
+            wal->append(i, fakeRecord(i, 1000));
+        }
+        // overwrite the record of index 10
+        wal->append(10, fakeRecord(100, 10));
+        wal->flush();
+        BOOST_CHECK_EQUAL(wal->maxIndex(), 20);
+        BOOST_CHECK(*(wal->read(1)) == *fakeRecord(1, 1000));
+        BOOST_CHECK(*(wal->read(10)) == *fakeRecord(100, 10));
+        BOOST_CHECK(wal->read(21) == nullptr);
+        BOOST_CHECK_GT(segmentFiles(path), 1);
+    }
+    // recover from the segments
+    {
+        auto wal = std::make_shared<ConsensusWAL>(path, 4096);
+        wal->open();
+        BOOST_CHECK_EQUAL(wal->maxIndex(), 20);
+        for (protocol::BlockNumber i = 1; i <= 20; i++)
+        {
+            auto expected = (i == 10) ? fakeRecord(100, 10) : fakeRecord(i, 1000);
+            BOOST_CHECK(*(wal->read(i)) == *expected);
+        }
+        // remove the segments of the stable proposals
+        auto segments = segmentFiles(path);
+        wal->truncate(15);
+        BOOST_CHECK_LT(segmentFiles(path), segments);
+        BOOST_CHECK(wal->read(15) == nullptr);
+        BOOST_CHECK(*(wal->read(16)) == *fakeRecord(16, 1000));
+    }
+    boost::filesystem::remove_all(path);
+}
+
+BOOST_AUTO_TEST_CASE(testTornRecord)
+{
+    auto path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("consensus_wal_%%%%%%");
+    boost::filesystem::path segment;
+    {
+        auto wal = std::make_shared<ConsensusWAL>(path);
+        wal->open();
+        for (protocol::BlockNumber i = 1; i <= 3; i++)
+        {
+            wal->append(i, fakeRecord(i, 100));
+        }
+        wal->flush();
+        segment = boost::filesystem::directory_iterator(path)->path();
+    }
+    // the last record is not written completely
+    auto fileSize = boost::filesystem::file_size(segment);
+    boost::filesystem::resize_file(segment, fileSize - 10);
+    {
+        auto wal = std::make_shared<ConsensusWAL>(path);
+        wal->open();
+        BOOST_CHECK_EQUAL(wal->maxIndex(), 2);
+        BOOST_CHECK(wal->read(3) == nullptr);
+        BOOST_CHECK(*(wal->read(2)) == *fakeRecord(2, 100));
+        // the torn record is cut off
+        BOOST_CHECK_EQUAL(boost::filesystem::file_size(segment),
+            fileSize - 100 - ConsensusWAL::RECORD_HEADER_SIZE);
+        wal->append(3, fakeRecord(3, 100));
+        wal->flush();
+        BOOST_CHECK(*(wal->read(3)) == *fakeRecord(3, 100));
+    }
+    boost::filesystem::remove_all(path);
+}
+
+// fail the writes from the _failedWrites-th one, the first write partially written
+class FakeConsensusWAL : public ConsensusWAL
+{
+public:
+    FakeConsensusWAL(boost::filesystem::path _path, size_t _failedWrites)
+      : ConsensusWAL(std::move(_path)), m_failedWrites(_failedWrites)
+    {}
+    ~FakeConsensusWAL() override { stop(); }
+
+protected:
+    ssize_t writeSegment(byte const* _data, size_t _size) override
+    {
+        auto writes = m_writes++;
+        if (writes < m_failedWrites)
+        {
+            return ConsensusWAL::writeSegment(_data, _size);
+        }
+        if (writes == m_failedWrites)
+        {
+            return ConsensusWAL::writeSegment(_data, _size / 2);
+        }
+        errno = ENOSPC;
+        return -1;
+    }
+
+private:
+    size_t m_failedWrites;
+    std::atomic<size_t> m_writes = {0};
+};
+
+BOOST_AUTO_TEST_CASE(testWriteFailure)
+{
+    auto path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("consensus_wal_%%%%%%");
+    {
+        auto wal = std::make_shared<FakeConsensusWAL>(path, 1);
+        wal->open();
+        wal->append(1, fakeRecord(1, 100));
+        wal->flush();
+        BOOST_CHECK(*(wal->read(1)) == *fakeRecord(1, 100));
+
+        // the record partially written is never reported synced or made readable
+        wal->append(2, fakeRecord(2, 100));
+        BOOST_CHECK_THROW(wal->flush(), ConsensusWALException);
+        BOOST_CHECK(wal->failed());
+        BOOST_CHECK(wal->read(2) == nullptr);
+        BOOST_CHECK_EQUAL(wal->maxIndex(), 1);
+        BOOST_CHECK_THROW(wal->append(3, fakeRecord(3, 100)), ConsensusWALException);
+        BOOST_CHECK_THROW(wal->flush(), ConsensusWALException);
+        BOOST_CHECK(*(wal->read(1)) == *fakeRecord(1, 100));
+    }
+    // the partial record is cut off when reopened
+    {
+        auto wal = std::make_shared<ConsensusWAL>(path);
+        wal->open();
+        BOOST_CHECK_EQUAL(wal->maxIndex(), 1);
+        BOOST_CHECK(wal->read(2) == nullptr);
+        wal->append(2, fakeRecord(2, 100));
+        wal->flush();
+        BOOST_CHECK(*(wal->read(2)) == *fakeRecord(2, 100));
+    }
+    boost::filesystem::remove_all(path);
+}
+
+BOOST_AUTO_TEST_CASE(testCorruptRecord)
+{
+    auto path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("consensus_wal_%%%%%%");
+    auto wal = std::make_shared<ConsensusWAL>(path);
+    wal->open();
+    for (protocol::BlockNumber i = 1; i <= 3; i++)
+    {
+        wal->append(i, fakeRecord(i, 100));
+    }
+    wal->flush();
+    // flip a byte of the data of the second record
+    auto segment = boost::filesystem::directory_iterator(path)->path();
+    {
+        std::fstream file(segment.string(), std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(ConsensusWAL::RECORD_HEADER_SIZE * 2 + 100 + 10);
+        file.put((char)0xff);
+    }
+    BOOST_CHECK(*(wal->read(1)) == *fakeRecord(1, 100));
+    BOOST_CHECK(wal->read(2) == nullptr);
+    BOOST_CHECK(*(wal->read(3)) == *fakeRecord(3, 100));
+    wal->stop();
+    boost::filesystem::remove_all(path);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
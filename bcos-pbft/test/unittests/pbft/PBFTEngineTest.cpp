@@ -37,6 +37,37 @@ namespace bcos
 {
 namespace test
 {
+// drops the quorum certificates broadcast by the vote collectors
+class QuorumCertWithholdingGateWay : public FakeGateWay
+{
+public:
+    using Ptr = std::shared_ptr<QuorumCertWithholdingGateWay>;
+    void setCodec(PBFTCodecInterface::Ptr _codec) { m_codec = std::move(_codec); }
+    size_t withheldQuorumCerts() const { return m_withheldQuorumCerts; }
+
+    void asyncSendMessageByNodeID(int _moduleId, NodeIDPtr _fromNode, NodeIDPtr _nodeId,
+        bytesConstRef _data, uint32_t _timeout, CallbackFunc _responseCallback) override
+    {
+        if (_moduleId == ModuleID::PBFT && m_codec)
+        {
+            auto packetType = m_codec->decode(_data)->packetType();
+            if (packetType == PacketType::PrepareQCPacket ||
+                packetType == PacketType::CommitQCPacket ||
+                packetType == PacketType::CheckPointQCPacket)
+            {
+                m_withheldQuorumCerts++;
+                return;
+            }
+        }
+        FakeGateWay::asyncSendMessageByNodeID(
+            _moduleId, _fromNode, _nodeId, _data, _timeout, _responseCallback);
+    }
+
+private:
+    PBFTCodecInterface::Ptr m_codec;
+    std::atomic<size_t> m_withheldQuorumCerts = 0;
+};
+
 BOOST_FIXTURE_TEST_SUITE(PBFTEngineTest, TestPromptFixture)
 inline bool shouldExit(std::map<IndexType, PBFTFixture::Ptr>& _consensusNodes,
     BlockNumber _expectedNumber, size_t _connectedNodes)
@@ -52,7 +83,8 @@ inline bool shouldExit(std::map<IndexType, PBFTFixture::Ptr>& _consensusNodes,
     return true;
 }
 
-void testPBFTEngineWithFaulty(size_t _consensusNodes, size_t _connectedNodes)
+void testPBFTEngineWithFaulty(
+    size_t _consensusNodes, size_t _connectedNodes, bool _voteCollection = false)
 {
     auto hashImpl = std::make_shared<Keccak256>();
     auto signatureImpl = std::make_shared<Secp256k1Crypto>();
@@ -62,6 +94,10 @@ void testPBFTEngineWithFaulty(size_t _consensusNodes, size_t _connectedNodes)
     std::cout << "### createFakers: " << currentBlockNumber << std::endl;
     auto fakerMap = createFakers(cryptoSuite, _consensusNodes, currentBlockNumber, _connectedNodes);
     std::cout << "### createFakers: " << currentBlockNumber << " success" << std::endl;
+    for (auto const& node : fakerMap)
+    {
+        node.second->pbftConfig()->setVoteCollection(_voteCollection);
+    }
     // check the leader notify the sealer to seal proposals
     IndexType leaderIndex = 0;
     auto leaderFaker = fakerMap[leaderIndex];
@@ -149,6 +185,62 @@ BOOST_AUTO_TEST_CASE(testPBFTEngineWithAllNonFaulty)
     std::cout << "testPBFTEngineWithFaulty with 7 non-faulty success" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(testPBFTEngineWithVoteCollection)
+{
+    // the votes are sent to the leader, and reach the quorum by the QCs broadcast by the leader
+    std::cout << "testPBFTEngineWithFaulty with 10 non-faulty and vote collection" << std::endl;
+    testPBFTEngineWithFaulty(10, 10, true);
+    std::cout << "testPBFTEngineWithFaulty with vote collection success" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(testPBFTEngineWithWithheldQuorumCert)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+
+    size_t consensusNodeSize = 4;
+    BlockNumber currentBlockNumber = 19;
+    auto gateWay = std::make_shared<QuorumCertWithholdingGateWay>();
+    auto fakerMap = createFakers(
+        cryptoSuite, consensusNodeSize, currentBlockNumber, consensusNodeSize, 1000, gateWay);
+    for (auto const& node : fakerMap)
+    {
+        node.second->pbftConfig()->setVoteCollection(true);
+    }
+    gateWay->setCodec(fakerMap[0]->pbftConfig()->codec());
+
+    // the leader collects the votes but never broadcasts the QCs
+    auto expectedIndex = fakerMap[0]->pbftConfig()->progressedIndex();
+    auto leaderFaker = fakerMap[fakerMap[0]->pbftConfig()->leaderIndex(expectedIndex)];
+    auto block = fakeBlock(cryptoSuite, leaderFaker, expectedIndex, 10);
+    auto blockData = std::make_shared<bytes>();
+    block->encode(*blockData);
+    auto blockHeader = block->blockHeader();
+    leaderFaker->pbftEngine()->asyncSubmitProposal(
+        false, ref(*blockData), blockHeader->number(), blockHeader->hash(), nullptr);
+
+    // the votes pending for voteCollectionTimeout are broadcast, and the block is committed
+    // before the consensus timeout
+    auto startT = utcTime();
+    while (!shouldExit(fakerMap, currentBlockNumber + 1, consensusNodeSize) &&
+           (utcTime() - startT <= 60 * 1000))
+    {
+        for (auto const& node : fakerMap)
+        {
+            node.second->pbftEngine()->executeWorkerByRoundbin();
+            node.second->pbftEngine()->checkPendingVotesByRoundbin();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(shouldExit(fakerMap, currentBlockNumber + 1, consensusNodeSize));
+    BOOST_CHECK(gateWay->withheldQuorumCerts() > 0);
+    for (auto const& node : fakerMap)
+    {
+        BOOST_CHECK_EQUAL(node.second->pbftConfig()->view(), 0);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testHandlePrePrepareMsg)
 {
     auto hashImpl = std::make_shared<Keccak256>();
@@ -157,6 +157,12 @@ public:
     }
 
     void executeWorkerByRoundbin() { return PBFTEngine::executeWorker(); }
+    // the vote timer is not started in the tests
+    void checkPendingVotesByRoundbin()
+    {
+        RecursiveGuard l(m_mutex);
+        m_cacheProcessor->checkPendingVotes();
+    }
 
     void onRecvProposal(bool _containSysTxs, bytesConstRef _proposalData,
         bcos::protocol::BlockNumber _proposalIndex,
@@ -350,7 +356,7 @@ inline PBFTFixture::Ptr createPBFTFixture(
 
 inline std::map<IndexType, PBFTFixture::Ptr> createFakers(CryptoSuite::Ptr _cryptoSuite,
     size_t _consensusNodeSize, size_t _currentBlockNumber, size_t _connectedNodes,
-    size_t _txCountLimit = 1000)
+    size_t _txCountLimit = 1000, FakeGateWay::Ptr _fakeGateWay = nullptr)
 {
     PBFTFixtureList fakerList;
     // create block factory
@@ -379,7 +385,7 @@ inline std::map<IndexType, PBFTFixture::Ptr> createFakers(CryptoSuite::Ptr _cryp
         }
     }
     // init the fakers
-    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto fakeGateWay = _fakeGateWay ? _fakeGateWay : std::make_shared<FakeGateWay>();
     for (size_t i = 0; i < _consensusNodeSize; i++)
     {
         auto faker = fakerList[i];
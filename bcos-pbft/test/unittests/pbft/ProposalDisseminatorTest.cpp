@@ -0,0 +1,248 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit tests for the erasure-coded proposal dissemination
+ * @file ProposalDisseminatorTest.cpp
+ * @date 2022-11-28
+ */
+#include <bcos-tars-protocol/testutil/FakeBlock.h>
+#include <bcos-tars-protocol/testutil/FakeBlockHeader.h>
+
+#include "bcos-pbft/pbft/engine/ProposalDisseminator.h"
+#include "bcos-pbft/pbft/protocol/proto/PBFT.pb.h"
+#include "bcos-pbft/pbft/utilities/ReedSolomon.h"
+#include "test/unittests/pbft/PBFTFixture.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-protocol/Common.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::consensus;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(ProposalDisseminatorTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testReedSolomon)
+{
+    std::mt19937 random(1024);
+    for (size_t followers : {3, 6, 9, 30, 100})
+    {
+        ReedSolomon codec(ProposalDisseminator::dataChunks(followers), followers);
+        for (size_t dataSize : {0, 1, 1000, 100001})
+        {
+            bytes data(dataSize);
+            std::generate(data.begin(), data.end(), [&random]() { return (byte)random(); });
+            auto chunks = codec.encode(ref(data));
+            BOOST_CHECK_EQUAL(chunks.size(), followers);
+
+            // recover from any dataChunks chunks
+            std::vector<size_t> indexes(followers);
+            std::iota(indexes.begin(), indexes.end(), 0);
+            for (size_t i = 0; i < 5; i++)
+            {
+                std::shuffle(indexes.begin(), indexes.end(), random);
+                std::map<size_t, bytes> received;
+                for (size_t j = 0; j < codec.dataShards(); j++)
+                {
+                    received[indexes[j]] = chunks[indexes[j]];
+                }
+                BOOST_CHECK(codec.decode(received, dataSize) == data);
+                // less chunks
+                received.erase(received.begin());
+                BOOST_CHECK_THROW(codec.decode(received, dataSize), ReedSolomonException);
+            }
+        }
+    }
+    BOOST_CHECK_THROW(ReedSolomon(0, 3), ReedSolomonException);
+    BOOST_CHECK_THROW(ReedSolomon(4, 3), ReedSolomonException);
+    BOOST_CHECK_THROW(ReedSolomon(10, 256), ReedSolomonException);
+}
+
+void testDissemination(size_t _consensusNodes, size_t _connectedNodes)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+
+    BlockNumber currentBlockNumber = 19;
+    auto fakerMap = createFakers(cryptoSuite, _consensusNodes, currentBlockNumber, _connectedNodes);
+    for (auto const& node : fakerMap)
+    {
+        node.second->pbftConfig()->setProposalDissemination(true);
+    }
+    auto leaderIndex = fakerMap[0]->pbftConfig()->leaderIndex(currentBlockNumber + 1);
+    auto leaderFaker = fakerMap[leaderIndex];
+    auto block = fakeBlock(cryptoSuite, leaderFaker, currentBlockNumber + 1, 1000);
+    auto blockData = std::make_shared<bytes>();
+    block->encode(*blockData);
+    auto blockHeader = block->blockHeader();
+
+    auto startT = utcTime();
+    leaderFaker->pbftEngine()->asyncSubmitProposal(
+        false, ref(*blockData), blockHeader->number(), blockHeader->hash(), nullptr);
+    while (!std::all_of(fakerMap.begin(), fakerMap.end(),
+               [&](auto const& _node) {
+                   return _node.first >= (IndexType)_connectedNodes ||
+                          _node.second->ledger()->blockNumber() == currentBlockNumber + 1;
+               }) &&
+           (utcTime() - startT <= 60 * 1000))
+    {
+        for (auto const& node : fakerMap)
+        {
+            node.second->pbftEngine()->executeWorkerByRoundbin();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (IndexType i = 0; i < (IndexType)_connectedNodes; i++)
+    {
+        BOOST_CHECK_EQUAL(fakerMap[i]->ledger()->blockNumber(), currentBlockNumber + 1);
+    }
+    std::cout << "testDissemination, nodes: " << _consensusNodes
+              << ", connected: " << _connectedNodes << ", proposalSize: " << blockData->size()
+              << ", timeCost: " << (utcTime() - startT) << "ms" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(testProposalDissemination)
+{
+    // all the followers relay the chunks
+    testDissemination(4, 4);
+    // recovered from the chunks of the n - 1 - f followers
+    testDissemination(7, 5);
+}
+
+// the chunk of a proposal header generated and signed by the node
+bytesPointer fakeProposalChunk(
+    PBFTFixture::Ptr _generatedFrom, BlockNumber _index, size_t _followers, size_t _chunkIndex)
+{
+    auto config = _generatedFrom->pbftConfig();
+    auto hashImpl = config->cryptoSuite()->hashImpl();
+    bytes message(1000, 1);
+    ReedSolomon codec(ProposalDisseminator::dataChunks(_followers), _followers);
+    auto chunks = codec.encode(ref(message));
+
+    ProposalChunkHeader header;
+    header.set_view(config->view());
+    header.set_index(_index);
+    header.set_generatedfrom(config->nodeIndex());
+    auto proposalHash = hashImpl->hash(std::to_string(_index));
+    header.set_proposalhash(proposalHash.data(), proposalHash.size());
+    auto messageHash = hashImpl->hash(ref(message));
+    header.set_messagehash(messageHash.data(), messageHash.size());
+    header.set_messagesize(message.size());
+    header.set_datachunks(codec.dataShards());
+    for (auto const& chunk : chunks)
+    {
+        auto chunkHash = hashImpl->hash(chunk);
+        header.add_chunkhashes(chunkHash.data(), chunkHash.size());
+    }
+    auto headerData = header.SerializeAsString();
+    auto signatureData = config->cryptoSuite()->signatureImpl()->sign(*config->keyPair(),
+        hashImpl->hash(bytesConstRef((byte const*)headerData.data(), headerData.size())), false);
+
+    auto proposalChunk = std::make_shared<ProposalChunk>();
+    proposalChunk->set_header(headerData);
+    proposalChunk->set_signaturedata(signatureData->data(), signatureData->size());
+    proposalChunk->set_chunkindex((int32_t)_chunkIndex);
+    proposalChunk->set_chunk(chunks[_chunkIndex].data(), chunks[_chunkIndex].size());
+    auto payLoad = encodePBObject(proposalChunk);
+    auto rawMessage = std::make_shared<RawMessage>();
+    rawMessage->set_version(config->pbftMsgDefaultVersion());
+    rawMessage->set_type((int32_t)PacketType::ProposalChunkPacket);
+    rawMessage->set_payload(payLoad->data(), payLoad->size());
+    return encodePBObject(rawMessage);
+}
+
+BOOST_AUTO_TEST_CASE(testUnexpectedProposalHeader)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    size_t consensusNodes = 4;
+    auto fakerMap = createFakers(cryptoSuite, consensusNodes, 10, consensusNodes);
+    auto config = fakerMap[0]->pbftConfig();
+    auto committedIndex = config->committedProposal()->index();
+    auto nextIndex = committedIndex + 1;
+    auto highIndex = committedIndex + config->waterMarkLimit();
+    auto nextLeader = config->leaderIndex(nextIndex);
+    auto highLeader = config->leaderIndex(highIndex);
+    // the receiver is neither of the leaders
+    IndexType receiverIndex = 0;
+    while (receiverIndex == nextLeader || receiverIndex == highLeader)
+    {
+        receiverIndex++;
+    }
+    auto receiver = std::make_shared<ProposalDisseminator>(fakerMap[receiverIndex]->pbftConfig());
+    auto followers = consensusNodes - 1;
+    // not relayed, the chunk of another follower
+    auto chunkOf = [&](IndexType _leader) {
+        auto position = receiverIndex < _leader ? receiverIndex : receiverIndex - 1;
+        return (size_t)(position + 1) % followers;
+    };
+    auto receive = [&](IndexType _generatedFrom, BlockNumber _index) {
+        auto leaderIndex = config->leaderIndex(_index);
+        auto data = fakeProposalChunk(
+            fakerMap[_generatedFrom], _index, followers, chunkOf(leaderIndex));
+        receiver->onReceiveChunk(fakerMap[_generatedFrom]->keyPair()->publicKey(), ref(*data));
+    };
+
+    // the header of the next proposal from a node not its leader
+    IndexType forgerIndex = 0;
+    while (forgerIndex == nextLeader || forgerIndex == receiverIndex)
+    {
+        forgerIndex++;
+    }
+    receive(forgerIndex, nextIndex);
+    BOOST_CHECK_EQUAL(receiver->pendingProposals(), 0);
+    // the headers out of the water mark from the leaders
+    receive(config->leaderIndex(committedIndex), committedIndex);
+    auto farIndex = highIndex + 1;
+    while (config->leaderIndex(farIndex) == receiverIndex)
+    {
+        farIndex++;
+    }
+    receive(config->leaderIndex(farIndex), farIndex);
+    BOOST_CHECK_EQUAL(receiver->pendingProposals(), 0);
+    // the headers within the water mark from the leaders
+    receive(nextLeader, nextIndex);
+    BOOST_CHECK_EQUAL(receiver->pendingProposals(), 1);
+    receive(highLeader, highIndex);
+    BOOST_CHECK_EQUAL(receiver->pendingProposals(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(testIsProposalChunk)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto fakerMap = createFakers(cryptoSuite, 4, 10, 4);
+    auto leaderFaker = fakerMap[0];
+    auto pbftMsg = leaderFaker->pbftConfig()->pbftMessageFactory()->createPBFTMsg();
+    pbftMsg->setPacketType(PacketType::CommitPacket);
+    auto data = leaderFaker->pbftConfig()->codec()->encode(pbftMsg);
+    BOOST_CHECK(!ProposalDisseminator::isProposalChunk(ref(*data)));
+    BOOST_CHECK(!ProposalDisseminator::isProposalChunk(bytesConstRef()));
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
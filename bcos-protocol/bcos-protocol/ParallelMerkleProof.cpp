@@ -48,9 +48,13 @@ HashType bcos::protocol::calculateMerkleProofRoot(
         higherLevelList.resize(size);
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& _r) {
+                // the nodes of the range are hashed together by the multi-buffer hasher
+                std::vector<bytes> byteValues(_r.size());
+                std::vector<bytesConstRef> inputs;
+                inputs.reserve(_r.size());
                 for (uint32_t i = _r.begin(); i < _r.end(); ++i)
                 {
-                    bytes byteValue;
+                    auto& byteValue = byteValues[i - _r.begin()];
                     for (uint32_t j = 0; j < MAX_CHILD_COUNT; j++)
                     {
                         uint32_t index = i * MAX_CHILD_COUNT + j;
@@ -60,7 +64,13 @@ HashType bcos::protocol::calculateMerkleProofRoot(
                                 bytesCachesTemp[index].end());
                         }
                     }
-                    higherLevelList[i] = _cryptoSuite->hash(byteValue).asBytes();
+                    inputs.emplace_back(ref(byteValue));
+                }
+                std::vector<HashType> hashes(_r.size());
+                _cryptoSuite->hashImpl()->hashBatch(inputs, hashes);
+                for (uint32_t i = _r.begin(); i < _r.end(); ++i)
+                {
+                    higherLevelList[i] = hashes[i - _r.begin()].asBytes();
                 }
             });
         bytesCachesTemp = std::move(higherLevelList);
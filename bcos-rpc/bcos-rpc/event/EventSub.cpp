@@ -240,17 +240,23 @@ void EventSub::subscribeEventSub(EventSubTask::Ptr _task)
 {
     EVENT_SUB(INFO) << LOG_BADGE("subscribeEventSub") << LOG_KV("id", _task->id())
                     << LOG_KV("startBlk", _task->state()->currentBlockNumber());
-    std::unique_lock lock(x_addTasks);
-    m_addTasks.push_back(_task);
-    m_addTaskCount++;
+    {
+        std::unique_lock lock(x_addTasks);
+        m_addTasks.push_back(_task);
+        m_addTaskCount++;
+    }
+    notifyWorker();
 }
 
 void EventSub::unsubscribeEventSub(const std::string& _id)
 {
     EVENT_SUB(INFO) << LOG_BADGE("unsubscribeEventSub") << LOG_KV("id", _id);
-    std::unique_lock lock(x_cancelTasks);
-    m_cancelTasks.push_back(_id);
-    m_cancelTaskCount++;
+    {
+        std::unique_lock lock(x_cancelTasks);
+        m_cancelTasks.push_back(_id);
+        m_cancelTaskCount++;
+    }
+    notifyWorker();
 }
 
 void EventSub::executeWorker()
@@ -545,7 +551,4 @@ void EventSub::executeEventSubTasks()
     {
         executeEventSubTask(task.second);
     }
-
-    // limiting speed
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
 }
@@ -498,6 +498,8 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
 
                 return;
             }
+            m_prewriteElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now() - m_currentTimePoint);
 
             auto status = std::make_shared<CommitStatus>();
             // self + ledger(txs receipts) + executors = 1 + 1 + executors
@@ -539,6 +541,8 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
                 }
 
                 SCHEDULER_LOG(DEBUG) << BLOCK_NUMBER(number()) << "batchCommitBlock begin";
+                m_prepareElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now() - m_currentTimePoint);
                 batchBlockCommit(status.startTS, [this, callback](Error::UniquePtr&& error) {
                     if (error)
                     {
@@ -560,11 +564,14 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
 
                     m_commitElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
                         std::chrono::system_clock::now() - m_currentTimePoint);
-                    SCHEDULER_LOG(DEBUG)
-                        << BLOCK_NUMBER(number()) << "CommitBlock: "
+                    SCHEDULER_LOG(INFO)
+                        << METRIC << BLOCK_NUMBER(number()) << "CommitBlock: "
                         << "success, execute elapsed: " << m_executeElapsed.count()
                         << "ms hash elapsed: " << m_hashElapsed.count()
-                        << "ms commit elapsed: " << m_commitElapsed.count() << "ms";
+                        << "ms commit elapsed: " << m_commitElapsed.count()
+                        << "ms (prewrite: " << m_prewriteElapsed.count()
+                        << "ms, prepare: " << (m_prepareElapsed - m_prewriteElapsed).count()
+                        << "ms, write: " << (m_commitElapsed - m_prepareElapsed).count() << "ms)";
 
                     callback(nullptr);
                 });
@@ -172,6 +172,9 @@ protected:
     std::chrono::milliseconds m_executeElapsed;
     std::chrono::milliseconds m_hashElapsed;
     std::chrono::milliseconds m_commitElapsed;
+    // the phases of the commit
+    std::chrono::milliseconds m_prewriteElapsed;
+    std::chrono::milliseconds m_prepareElapsed;
 
     bcos::protocol::Block::Ptr m_block;
     bcos::protocol::TransactionsPtr m_blockTxs;
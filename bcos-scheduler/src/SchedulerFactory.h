@@ -40,6 +40,7 @@ public:
 
         scheduler->registerBlockNumberReceiver(m_blockNumberReceiver);
         scheduler->registerTransactionNotifier(m_txNotifier);
+        scheduler->setPreExecuteProposal(m_preExecuteProposal);
 
         return scheduler;
     }
@@ -56,6 +57,11 @@ public:
         m_txNotifier = std::move(txNotifier);
     }
 
+    void setPreExecuteProposal(bool _preExecuteProposal)
+    {
+        m_preExecuteProposal = _preExecuteProposal;
+    }
+
     bcos::ledger::LedgerInterface::Ptr getLedger() { return m_ledger; }
 
 private:
@@ -70,6 +76,7 @@ private:
     bool m_isAuthCheck;
     bool m_isWasm;
     bool m_isSerialExecute;
+    bool m_preExecuteProposal = false;
 
     std::function<void(protocol::BlockNumber blockNumber)> m_blockNumberReceiver;
     std::function<void(bcos::protocol::BlockNumber, bcos::protocol::TransactionSubmitResultsPtr,
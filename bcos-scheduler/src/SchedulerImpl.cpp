@@ -200,7 +200,24 @@ void SchedulerImpl::executeBlock(bcos::protocol::Block::Ptr block, bool verify,
         }
         else
         {
-            if (verify && blockHeader->hash() != block->blockHeader()->hash())
+            // the block of the number may be executed for another proposal in advance
+            if (m_preExecuteProposal && !verify &&
+                blockExecutive->block()->blockHeaderConst()->hash() !=
+                    block->blockHeaderConst()->hash())
+            {
+                SCHEDULER_LOG(WARNING)
+                    << BLOCK_NUMBER(requestBlockNumber)
+                    << "ExecuteBlock failed. The executed block has been cached "
+                       "but request block is not the same. Trigger switch."
+                    << LOG_KV("cachedBlockHash",
+                           blockExecutive->block()->blockHeaderConst()->hash().abridged())
+                    << LOG_KV("requestBlockHash", block->blockHeaderConst()->hash().abridged());
+                triggerSwitch();
+                callback(BCOS_ERROR_UNIQUE_PTR(SchedulerError::InvalidBlocks,
+                             "request block not the same with cached"),
+                    nullptr, false);
+            }
+            else if (verify && blockHeader->hash() != block->blockHeader()->hash())
             {
                 SCHEDULER_LOG(WARNING)
                     << BLOCK_NUMBER(requestBlockNumber)
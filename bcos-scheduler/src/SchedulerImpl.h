@@ -195,6 +195,13 @@ public:
 
     bcos::crypto::Hash::Ptr getHashImpl() { return m_hashImpl; }
 
+    // the consensus may execute a proposal before it is committed, and the committed one of the
+    // same number may differ
+    void setPreExecuteProposal(bool _preExecuteProposal)
+    {
+        m_preExecuteProposal = _preExecuteProposal;
+    }
+
 private:
     void handleBlockQueue(bcos::protocol::BlockNumber requestBlockNumber,
         std::function<void(bcos::protocol::BlockNumber)> whenOlder,  // whenOlder(frontNumber)
@@ -252,6 +259,7 @@ private:
     bool m_isAuthCheck = false;
     bool m_isWasm = false;
     bool m_isSerialExecute = false;
+    bool m_preExecuteProposal = false;
 
     std::function<void(protocol::BlockNumber blockNumber)> m_blockNumberReceiver;
     std::function<void(bcos::protocol::BlockNumber, bcos::protocol::TransactionSubmitResultsPtr,
@@ -467,6 +467,71 @@ BOOST_AUTO_TEST_CASE(handlerBlockTest)
 }
 
 
+BOOST_AUTO_TEST_CASE(executeAnotherCachedBlock)
+{
+    auto createBlock = [this](int64_t timestamp) {
+        auto block = blockFactory->createBlock();
+        block->blockHeader()->setNumber(6);
+        block->blockHeader()->setTimestamp(timestamp);
+        for (size_t i = 0; i < 10; ++i)
+        {
+            auto metaTx =
+                std::make_shared<bcostars::protocol::TransactionMetaDataImpl>(h256(i), "contract1");
+            block->appendTransactionMetaData(std::move(metaTx));
+        }
+        block->blockHeader()->calculateHash(*blockFactory->cryptoSuite()->hashImpl());
+        return block;
+    };
+    auto block = createBlock(1000);
+    auto anotherBlock = createBlock(2000);
+    BOOST_CHECK_NE(block->blockHeader()->hash(), anotherBlock->blockHeader()->hash());
+
+    for (auto preExecuteProposal : {false, true})
+    {
+        auto scheduler = std::make_shared<SchedulerImpl>(executorManager, ledger, storage,
+            executionMessageFactory, blockFactory, txPool, transactionSubmitResultFactory,
+            hashImpl, false, false, false, 0);
+        scheduler->setBlockExecutiveFactory(
+            std::make_shared<bcos::test::MockBlockExecutiveFactory>(false));
+        scheduler->setPreExecuteProposal(preExecuteProposal);
+        size_t switches = 0;
+        scheduler->setOnNeedSwitchEventHandler([&switches](int64_t) { ++switches; });
+
+        bcos::Error::Ptr executeError;
+        bcos::protocol::BlockHeader::Ptr blockHeader;
+        scheduler->executeBlock(block, false,
+            [&](bcos::Error::Ptr&& error, bcos::protocol::BlockHeader::Ptr header, bool) {
+                executeError = std::move(error);
+                blockHeader = std::move(header);
+            });
+        BOOST_CHECK(!executeError);
+        BOOST_CHECK(blockHeader);
+
+        // the cached block of the number is returned for another block without
+        // pre_execute_proposal, and is dropped with it
+        bcos::protocol::BlockHeader::Ptr anotherHeader;
+        scheduler->executeBlock(anotherBlock, false,
+            [&](bcos::Error::Ptr&& error, bcos::protocol::BlockHeader::Ptr header, bool) {
+                executeError = std::move(error);
+                anotherHeader = std::move(header);
+            });
+        if (preExecuteProposal)
+        {
+            BOOST_REQUIRE(executeError);
+            BOOST_CHECK_EQUAL(executeError->errorCode(), SchedulerError::InvalidBlocks);
+            BOOST_CHECK(!anotherHeader);
+            BOOST_CHECK_EQUAL(switches, 1);
+        }
+        else
+        {
+            BOOST_CHECK(!executeError);
+            BOOST_REQUIRE(anotherHeader);
+            BOOST_CHECK_EQUAL(anotherHeader->hash(), blockHeader->hash());
+            BOOST_CHECK_EQUAL(switches, 0);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(getCode)
 {
     auto scheduler =
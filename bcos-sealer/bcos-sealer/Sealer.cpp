@@ -47,7 +47,6 @@ void Sealer::stop()
     SEAL_LOG(INFO) << LOG_DESC("stop the sealer");
     m_running = false;
     m_sealingManager->stop();
-    finishWorker();
     if (isWorking())
     {
         stopWorking();
@@ -65,6 +64,7 @@ void Sealer::asyncNotifySealProposal(uint64_t _proposalStartIndex, uint64_t _pro
     uint64_t _maxTxsPerBlock, std::function<void(Error::Ptr)> _onRecvResponse)
 {
     m_sealingManager->resetSealingInfo(_proposalStartIndex, _proposalEndIndex, _maxTxsPerBlock);
+    notifyWorker();
     if (_onRecvResponse)
     {
         _onRecvResponse(nullptr);
@@ -78,6 +78,7 @@ void Sealer::asyncNotifySealProposal(uint64_t _proposalStartIndex, uint64_t _pro
 void Sealer::asyncNoteLatestBlockNumber(int64_t _blockNumber)
 {
     m_sealingManager->resetCurrentNumber(_blockNumber);
+    notifyWorker();
     SEAL_LOG(INFO) << LOG_DESC("asyncNoteLatestBlockNumber") << LOG_KV("number", _blockNumber);
 }
 
@@ -85,6 +86,7 @@ void Sealer::asyncNoteUnSealedTxsSize(
     uint64_t _unsealedTxsSize, std::function<void(Error::Ptr)> _onRecvResponse)
 {
     m_sealingManager->setUnsealedTxsSize(_unsealedTxsSize);
+    notifyWorker();
     if (_onRecvResponse)
     {
         _onRecvResponse(nullptr);
@@ -95,9 +97,8 @@ void Sealer::executeWorker()
 {
     if (!m_sealingManager->shouldGenerateProposal() && !m_sealingManager->shouldFetchTransaction())
     {
-        ///< 10 milliseconds to next loop
-        boost::unique_lock<boost::mutex> l(x_signalled);
-        m_signalled.wait_for(l, boost::chrono::milliseconds(1));
+        ///< 1 millisecond to next loop if not notified
+        waitWorkerSignal(1);
     }
     // try to generateProposal
     if (m_sealingManager->shouldGenerateProposal())
@@ -175,3 +176,21 @@ void Sealer::asyncResetSealing(std::function<void(Error::Ptr)> _onRecvResponse)
         _onRecvResponse(nullptr);
     }
 }
+
+void Sealer::asyncNoteBlockExecuted(
+    bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost)
+{
+    if (auto controller = m_sealingManager->controller())
+    {
+        controller->onBlockExecuted(_number, _txsSize, _timeCost);
+    }
+}
+
+void Sealer::asyncNoteBlockCommitted(
+    bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost)
+{
+    if (auto controller = m_sealingManager->controller())
+    {
+        controller->onBlockCommitted(_number, _txsSize, _timeCost);
+    }
+}
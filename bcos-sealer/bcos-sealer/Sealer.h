@@ -52,11 +52,16 @@ public:
     // interface for the consensus module to notify reset the sealing transactions
     void asyncResetSealing(std::function<void(Error::Ptr)> _onRecvResponse) override;
 
+    void asyncNoteBlockExecuted(
+        bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost) override;
+    void asyncNoteBlockCommitted(
+        bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost) override;
+
     virtual void init(bcos::consensus::ConsensusInterface::Ptr _consensus);
 
 protected:
     void executeWorker() override;
-    virtual void noteGenerateProposal() { m_signalled.notify_all(); }
+    virtual void noteGenerateProposal() { notifyWorker(); }
 
     virtual void submitProposal(bool _containSysTxs, bcos::protocol::Block::Ptr _proposal);
 
@@ -65,9 +70,6 @@ protected:
     SealingManager::Ptr m_sealingManager;
     std::atomic_bool m_running = {false};
 
-    boost::condition_variable m_signalled;
-    // mutex to access m_signalled
-    boost::mutex x_signalled;
     bcos::crypto::Hash::Ptr m_hashImpl;
 };
 }  // namespace bcos::sealer
\ No newline at end of file
@@ -48,6 +48,17 @@ public:
     virtual unsigned minSealTime() const { return m_minSealTime; }
     virtual void setMinSealTime(unsigned _minSealTime) { m_minSealTime = _minSealTime; }
 
+    // choose the block size and seal interval by the measured execution time
+    virtual bool adaptiveSealing() const { return m_adaptiveSealing; }
+    virtual void setAdaptiveSealing(bool _adaptiveSealing) { m_adaptiveSealing = _adaptiveSealing; }
+    virtual unsigned targetBlockTime() const { return m_targetBlockTime; }
+    virtual void setTargetBlockTime(unsigned _targetBlockTime)
+    {
+        m_targetBlockTime = _targetBlockTime;
+    }
+    virtual size_t minTxsPerBlock() const { return m_minTxsPerBlock; }
+    virtual void setMinTxsPerBlock(size_t _minTxsPerBlock) { m_minTxsPerBlock = _minTxsPerBlock; }
+
     bcos::protocol::BlockFactory::Ptr blockFactory() { return m_blockFactory; }
     bcos::consensus::ConsensusInterface::Ptr consensus() { return m_consensus; }
     bcos::tool::NodeTimeMaintenance::Ptr nodeTimeMaintenance() { return m_nodeTimeMaintenance; }
@@ -58,6 +69,9 @@ protected:
     bcos::consensus::ConsensusInterface::Ptr m_consensus;
     bcos::tool::NodeTimeMaintenance::Ptr m_nodeTimeMaintenance;
     unsigned m_minSealTime = 500;
+    bool m_adaptiveSealing = false;
+    unsigned m_targetBlockTime = 1000;
+    size_t m_minTxsPerBlock = 100;
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
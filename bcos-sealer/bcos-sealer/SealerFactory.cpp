@@ -40,5 +40,8 @@ Sealer::Ptr SealerFactory::createSealer()
     auto sealerConfig =
         std::make_shared<SealerConfig>(m_blockFactory, m_txpool, m_nodeTimeMaintenance);
     sealerConfig->setMinSealTime(m_minSealTime);
+    sealerConfig->setAdaptiveSealing(m_adaptiveSealing);
+    sealerConfig->setTargetBlockTime(m_targetBlockTime);
+    sealerConfig->setMinTxsPerBlock(m_minTxsPerBlock);
     return std::make_shared<Sealer>(sealerConfig);
 }
\ No newline at end of file
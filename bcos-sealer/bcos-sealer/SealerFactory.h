@@ -35,11 +35,22 @@ public:
     virtual ~SealerFactory() = default;
     Sealer::Ptr createSealer();
 
+    void setAdaptiveSealing(
+        bool _adaptiveSealing, unsigned _targetBlockTime, size_t _minTxsPerBlock)
+    {
+        m_adaptiveSealing = _adaptiveSealing;
+        m_targetBlockTime = _targetBlockTime;
+        m_minTxsPerBlock = _minTxsPerBlock;
+    }
+
 protected:
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::txpool::TxPoolInterface::Ptr m_txpool;
     unsigned m_minSealTime;
     bcos::tool::NodeTimeMaintenance::Ptr m_nodeTimeMaintenance;
+    bool m_adaptiveSealing = false;
+    unsigned m_targetBlockTime = 1000;
+    size_t m_minTxsPerBlock = 100;
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
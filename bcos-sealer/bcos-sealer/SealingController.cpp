@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief choose the block size and the seal interval by the measured execution time
+ * @file SealingController.cpp
+ * @date: 2022-11-25
+ */
+#include "SealingController.h"
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::sealer;
+
+// the weight of a new sample faster than the average
+constexpr static double c_smoothFactor = 0.2;
+
+void SealingController::onBlockExecuted(
+    bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost)
+{
+    // the fixed cost of the small blocks overestimates the cost per transaction
+    if (_txsSize < m_minTxsPerBlock)
+    {
+        return;
+    }
+    std::unique_lock lock(x_averages);
+    update(m_executePerTx, (double)_timeCost * 1000 / (double)_txsSize);
+    SEAL_LOG(DEBUG) << LOG_DESC("onBlockExecuted") << LOG_KV("number", _number)
+                    << LOG_KV("txs", _txsSize) << LOG_KV("timeCost", _timeCost)
+                    << LOG_KV("executePerTx(us)", m_executePerTx);
+}
+
+void SealingController::onBlockCommitted(
+    bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost)
+{
+    if (_txsSize < m_minTxsPerBlock)
+    {
+        return;
+    }
+    std::unique_lock lock(x_averages);
+    update(m_commitPerTx, (double)_timeCost * 1000 / (double)_txsSize);
+    auto cost = txCost();
+    if (cost > 0)
+    {
+        m_txsPerBlock =
+            std::max((size_t)((double)m_targetBlockTime * 1000 / cost), m_minTxsPerBlock);
+    }
+    SEAL_LOG(INFO) << METRIC << LOG_DESC("adaptiveSealing") << LOG_KV("number", _number)
+                   << LOG_KV("txs", _txsSize) << LOG_KV("executePerTx(us)", m_executePerTx)
+                   << LOG_KV("commitPerTx(us)", m_commitPerTx)
+                   << LOG_KV("txsPerBlock", m_txsPerBlock)
+                   << LOG_KV("targetBlockTime", m_targetBlockTime);
+}
+
+void SealingController::update(double& _average, double _sample)
+{
+    if (_average == 0 || _sample > _average)
+    {
+        _average = _sample;
+        return;
+    }
+    _average = _average * (1 - c_smoothFactor) + _sample * c_smoothFactor;
+}
+
+double SealingController::txCost() const
+{
+    // the execution of the next block overlaps the commit of the last one
+    return std::max(m_executePerTx, m_commitPerTx);
+}
+
+size_t SealingController::txsPerBlock(size_t _txCountLimit) const
+{
+    auto txsPerBlock = m_txsPerBlock.load();
+    if (txsPerBlock == 0)
+    {
+        return _txCountLimit;
+    }
+    return std::min(txsPerBlock, _txCountLimit);
+}
+
+uint64_t SealingController::sealInterval(size_t _backlog) const
+{
+    double cost = 0;
+    {
+        std::unique_lock lock(x_averages);
+        cost = txCost();
+    }
+    if (cost == 0)
+    {
+        return m_minSealTime;
+    }
+    auto expectedTime = (uint64_t)((double)_backlog * cost / 1000);
+    if (expectedTime >= m_targetBlockTime)
+    {
+        return m_minSealTime;
+    }
+    return std::max(m_targetBlockTime - expectedTime, m_minSealTime);
+}
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief choose the block size and the seal interval by the measured execution time
+ * @file SealingController.h
+ * @date: 2022-11-25
+ */
+#pragma once
+#include "Common.h"
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <atomic>
+#include <mutex>
+
+namespace bcos::sealer
+{
+/**
+ * @brief Keeps the moving averages of the execution and commit time per transaction reported by
+ * the consensus after the scheduler executed and committed a block, and chooses:
+ *   - txsPerBlock: the transactions the slower stage of the pipeline handles in targetBlockTime,
+ *     bounded by [minTxsPerBlock, the tx_count_limit of the chain]
+ *   - sealInterval: how long to wait for a non-full block, targetBlockTime minus the estimated
+ *     time of the pending transactions, bounded by [minSealTime, targetBlockTime]
+ * A slower sample is taken at once so an oversized block is not repeated until the consensus
+ * timeout, a faster one is averaged in.
+ */
+class SealingController
+{
+public:
+    using Ptr = std::shared_ptr<SealingController>;
+    SealingController(uint64_t _targetBlockTime, uint64_t _minSealTime, size_t _minTxsPerBlock)
+      : m_targetBlockTime(_targetBlockTime),
+        m_minSealTime(std::min(_minSealTime, _targetBlockTime)),
+        m_minTxsPerBlock(std::max(_minTxsPerBlock, (size_t)1))
+    {}
+    virtual ~SealingController() = default;
+
+    // the time cost(ms) of the scheduler to execute the block
+    virtual void onBlockExecuted(
+        bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost);
+    // the time cost(ms) of the scheduler to commit the block
+    virtual void onBlockCommitted(
+        bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost);
+
+    // the transactions to seal into the next block, no more than _txCountLimit
+    virtual size_t txsPerBlock(size_t _txCountLimit) const;
+    // the time(ms) to wait before sealing a non-full block with the _backlog transactions
+    virtual uint64_t sealInterval(size_t _backlog) const;
+
+    uint64_t targetBlockTime() const { return m_targetBlockTime; }
+
+private:
+    void update(double& _average, double _sample);
+    // the time(us) per transaction of the slower stage, 0 before measured
+    double txCost() const;
+
+    uint64_t m_targetBlockTime;
+    uint64_t m_minSealTime;
+    size_t m_minTxsPerBlock;
+
+    mutable std::mutex x_averages;
+    // in us per transaction
+    double m_executePerTx = 0;
+    double m_commitPerTx = 0;
+    std::atomic<size_t> m_txsPerBlock = {0};
+};
+}  // namespace bcos::sealer
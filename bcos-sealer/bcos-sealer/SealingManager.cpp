@@ -60,7 +60,7 @@ bool SealingManager::shouldGenerateProposal()
     }
     // check the txs size
     auto txsSize = pendingTxsSize();
-    if (txsSize >= m_maxTxsPerBlock || reachMinSealTimeCondition())
+    if (txsSize >= maxTxsPerBlock() || reachMinSealTimeCondition())
     {
         return true;
     }
@@ -151,8 +151,8 @@ std::pair<bool, bcos::protocol::Block::Ptr> SealingManager::generateProposal()
     blockHeader->setTimestamp(m_config->nodeTimeMaintenance()->getAlignedTime());
     blockHeader->calculateHash(*m_config->blockFactory()->cryptoSuite()->hashImpl());
     block->setBlockHeader(blockHeader);
-    auto txsSize =
-        std::min((size_t)m_maxTxsPerBlock, (m_pendingTxs->size() + m_pendingSysTxs->size()));
+    auto pendingSize = m_pendingTxs->size() + m_pendingSysTxs->size();
+    auto txsSize = std::min(maxTxsPerBlock(), pendingSize);
     // prioritize seal from the system txs list
     auto systemTxsSize = std::min(txsSize, m_pendingSysTxs->size());
     if (!m_pendingSysTxs->empty())
@@ -174,6 +174,14 @@ std::pair<bool, bcos::protocol::Block::Ptr> SealingManager::generateProposal()
         block->appendTransactionMetaData(std::move(m_pendingTxs->front()));
         m_pendingTxs->pop_front();
     }
+    if (m_controller)
+    {
+        SEAL_LOG(INFO) << METRIC << LOG_DESC("adaptiveSeal") << LOG_KV("number", m_sealingNumber)
+                       << LOG_KV("txs", txsSize) << LOG_KV("maxTxsPerBlock", maxTxsPerBlock())
+                       << LOG_KV("txCountLimit", m_maxTxsPerBlock)
+                       << LOG_KV("backlog", pendingSize - txsSize + m_unsealedTxsSize)
+                       << LOG_KV("waited", utcSteadyTime() - m_lastSealTime);
+    }
     m_sealingNumber++;
 
     m_lastSealTime = utcSteadyTime();
@@ -189,6 +197,15 @@ size_t SealingManager::pendingTxsSize()
     return m_pendingSysTxs->size() + m_pendingTxs->size();
 }
 
+size_t SealingManager::maxTxsPerBlock() const
+{
+    if (m_controller)
+    {
+        return m_controller->txsPerBlock(m_maxTxsPerBlock);
+    }
+    return m_maxTxsPerBlock;
+}
+
 bool SealingManager::reachMinSealTimeCondition()
 {
     auto txsSize = pendingTxsSize();
@@ -196,7 +213,13 @@ bool SealingManager::reachMinSealTimeCondition()
     {
         return false;
     }
-    if ((utcSteadyTime() - m_lastSealTime) < m_config->minSealTime())
+    uint64_t sealInterval = m_config->minSealTime();
+    if (m_controller)
+    {
+        // wait longer to fill the block if the transactions are executed fast
+        sealInterval = m_controller->sealInterval(txsSize + m_unsealedTxsSize);
+    }
+    if ((utcSteadyTime() - m_lastSealTime) < sealInterval)
     {
         return false;
     }
@@ -220,7 +243,7 @@ bool SealingManager::shouldFetchTransaction()
 
 int64_t SealingManager::txsSizeExpectedToFetch()
 {
-    auto txsSizeToFetch = (m_endSealingNumber - m_sealingNumber + 1) * m_maxTxsPerBlock;
+    auto txsSizeToFetch = (m_endSealingNumber - m_sealingNumber + 1) * maxTxsPerBlock();
     auto txsSize = pendingTxsSize();
     if (txsSizeToFetch <= txsSize)
     {
@@ -20,6 +20,7 @@
 #pragma once
 #include "Common.h"
 #include "SealerConfig.h"
+#include "SealingController.h"
 #include "bcos-framework/protocol/BlockFactory.h"
 #include "bcos-framework/protocol/TransactionMetaData.h"
 #include <bcos-utilities/CallbackCollectionHandler.h>
@@ -39,7 +40,13 @@ public:
         m_pendingTxs(std::make_shared<TxsMetaDataQueue>()),
         m_pendingSysTxs(std::make_shared<TxsMetaDataQueue>()),
         m_worker(std::make_shared<ThreadPool>("sealerWorker", 1))
-    {}
+    {
+        if (m_config->adaptiveSealing())
+        {
+            m_controller = std::make_shared<SealingController>(
+                m_config->targetBlockTime(), m_config->minSealTime(), m_config->minTxsPerBlock());
+        }
+    }
 
     virtual ~SealingManager() { stop(); }
 
@@ -112,6 +119,9 @@ public:
     }
     virtual void notifyResetProposal(bcos::protocol::Block::Ptr _block);
 
+    // nullptr if the adaptive sealing is disabled
+    SealingController::Ptr controller() const { return m_controller; }
+
 protected:
     virtual void appendTransactions(
         std::shared_ptr<TxsMetaDataQueue> _txsQueue, bcos::protocol::Block::Ptr _fetchedTxs);
@@ -122,6 +132,8 @@ protected:
 
     virtual int64_t txsSizeExpectedToFetch();
     virtual size_t pendingTxsSize();
+    // the transactions of the next block, chosen by the controller if enabled
+    virtual size_t maxTxsPerBlock() const;
 
 private:
     SealerConfig::Ptr m_config;
@@ -148,6 +160,8 @@ private:
     std::atomic_bool m_fetchingTxs = {false};
 
     std::atomic<ssize_t> m_currentNumber = {0};
+
+    SealingController::Ptr m_controller;
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,102 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit tests for the adaptive sealing controller
+ * @file SealingControllerTest.cpp
+ * @date 2022-11-25
+ */
+#include "bcos-sealer/SealingController.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::sealer;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(SealingControllerTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testTxsPerBlock)
+{
+    SealingController controller(1000, 200, 100);
+    // not measured yet
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(1000), 1000);
+
+    // the small blocks are ignored
+    controller.onBlockExecuted(1, 10, 1000);
+    controller.onBlockCommitted(1, 10, 1000);
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(1000), 1000);
+
+    // 500us per tx to execute, 200us per tx to commit, the slower stage decides
+    controller.onBlockExecuted(2, 1000, 500);
+    controller.onBlockCommitted(2, 1000, 200);
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(5000), 2000);
+    // no more than the tx_count_limit
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(1000), 1000);
+
+    // the faster sample is averaged in: 500 * 0.8 + 250 * 0.2 = 450us
+    controller.onBlockExecuted(3, 1000, 250);
+    controller.onBlockCommitted(3, 1000, 200);
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(5000), 1000000 / 450);
+
+    // the slower sample is taken at once, and the commit stage decides
+    controller.onBlockExecuted(4, 1000, 400);
+    controller.onBlockCommitted(4, 1000, 800);
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(5000), 1250);
+
+    // clamped to min_txs_per_block: 100ms per tx
+    controller.onBlockExecuted(5, 100, 10000);
+    controller.onBlockCommitted(5, 100, 10000);
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(5000), 100);
+}
+
+BOOST_AUTO_TEST_CASE(testSealInterval)
+{
+    SealingController controller(1000, 200, 100);
+    // not measured yet
+    BOOST_CHECK_EQUAL(controller.sealInterval(0), 200);
+    BOOST_CHECK_EQUAL(controller.sealInterval(100000), 200);
+
+    // 500us per tx
+    controller.onBlockExecuted(1, 1000, 500);
+    controller.onBlockCommitted(1, 1000, 500);
+    // wait for the target block time without the pending txs
+    BOOST_CHECK_EQUAL(controller.sealInterval(0), 1000);
+    // minus the estimated time of the pending txs
+    BOOST_CHECK_EQUAL(controller.sealInterval(1000), 500);
+    // clamped to min_seal_time
+    BOOST_CHECK_EQUAL(controller.sealInterval(1800), 200);
+    BOOST_CHECK_EQUAL(controller.sealInterval(2000), 200);
+    BOOST_CHECK_EQUAL(controller.sealInterval(100000), 200);
+}
+
+BOOST_AUTO_TEST_CASE(testBounds)
+{
+    // min_seal_time is bounded by the target block time, and min_txs_per_block by 1
+    SealingController controller(1000, 5000, 0);
+    BOOST_CHECK_EQUAL(controller.targetBlockTime(), 1000);
+    BOOST_CHECK_EQUAL(controller.sealInterval(0), 1000);
+    controller.onBlockExecuted(1, 1, 10000000);
+    controller.onBlockCommitted(1, 1, 10000000);
+    BOOST_CHECK_EQUAL(controller.txsPerBlock(5000), 1);
+    BOOST_CHECK_EQUAL(controller.sealInterval(0), 1000);
+    BOOST_CHECK_EQUAL(controller.sealInterval(1), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
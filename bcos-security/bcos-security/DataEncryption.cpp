@@ -41,6 +41,7 @@ namespace security
 void DataEncryption::init()
 {
     bool smCryptoType = m_nodeConfig->smCryptoType();
+    m_smCryptoType = smCryptoType;
 
     if (true == m_nodeConfig->storageSecurityEnable())
     {
@@ -69,6 +70,7 @@ void DataEncryption::init()
 void DataEncryption::init(const std::string& dataKey, const bool smCryptoType)
 {
     m_dataKey = dataKey;
+    m_smCryptoType = smCryptoType;
 
     if (false == smCryptoType)
     {
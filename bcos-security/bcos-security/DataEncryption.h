@@ -54,10 +54,14 @@ public:
     std::string encrypt(const std::string& data) override;
     std::string decrypt(const std::string& data) override;
 
+    std::string const& dataKey() const override { return m_dataKey; }
+    bool smCryptoType() const override { return m_smCryptoType; }
+
 private:
     bcos::tool::NodeConfig::Ptr m_nodeConfig{nullptr};
 
     std::string m_dataKey;
+    bool m_smCryptoType = false;
     bcos::crypto::SymmetricEncryption::Ptr m_symmetricEncrypt{nullptr};
 };
 
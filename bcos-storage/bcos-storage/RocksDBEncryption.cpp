@@ -0,0 +1,241 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief encrypt the files of rocksdb by blocks
+ * @file RocksDBEncryption.cpp
+ * @date: 2022-11-24
+ */
+#include "RocksDBEncryption.h"
+#include <bcos-utilities/Log.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+using namespace bcos::storage;
+
+#define STORAGE_ENCRYPTION_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-Encryption]"
+
+namespace
+{
+constexpr char c_prefixMagic[8] = {'F', 'B', 'C', 'S', 'B', 'E', 'N', 'C'};
+constexpr uint8_t c_prefixVersion = 1;
+constexpr size_t c_ctrBlockSize = 16;
+// magic | version | cipher | nonce | mac
+constexpr size_t c_versionOffset = sizeof(c_prefixMagic);
+constexpr size_t c_cipherOffset = c_versionOffset + 1;
+constexpr size_t c_nonceOffset = c_cipherOffset + 1;
+constexpr size_t c_macOffset = c_nonceOffset + BlockEncryptionProvider::NONCE_SIZE;
+static_assert(
+    c_macOffset + BlockEncryptionProvider::MAC_SIZE <= BlockEncryptionProvider::PREFIX_SIZE);
+
+const EVP_CIPHER* evpCipher(BlockEncryptionProvider::Cipher _cipher)
+{
+    if (_cipher == BlockEncryptionProvider::Cipher::SM4_CTR)
+    {
+#ifndef OPENSSL_NO_SM4
+        return EVP_sm4_ctr();
+#else
+        return nullptr;
+#endif
+    }
+    return EVP_aes_256_ctr();
+}
+
+// AES-NI or the SM4 instructions are used by openssl when the cpu supports
+class CTRCipherStream : public rocksdb::BlockAccessCipherStream
+{
+public:
+    CTRCipherStream(const EVP_CIPHER* _cipher, std::array<unsigned char, 32> const& _key,
+        const unsigned char* _nonce)
+      : m_cipher(_cipher), m_key(_key)
+    {
+        std::memcpy(m_nonce.data(), _nonce, m_nonce.size());
+    }
+    ~CTRCipherStream() override { OPENSSL_cleanse(m_key.data(), m_key.size()); }
+
+    size_t BlockSize() override { return c_ctrBlockSize; }
+
+    // encrypt and decrypt are the same in CTR mode, the whole range is done by one openssl call
+    rocksdb::Status Encrypt(uint64_t _fileOffset, char* _data, size_t _dataSize) override
+    {
+        return crypt(_fileOffset, _data, _dataSize);
+    }
+    rocksdb::Status Decrypt(uint64_t _fileOffset, char* _data, size_t _dataSize) override
+    {
+        return crypt(_fileOffset, _data, _dataSize);
+    }
+
+protected:
+    void AllocateScratch(std::string&) override {}
+    rocksdb::Status EncryptBlock(uint64_t _blockIndex, char* _data, char*) override
+    {
+        return crypt(_blockIndex * c_ctrBlockSize, _data, c_ctrBlockSize);
+    }
+    rocksdb::Status DecryptBlock(uint64_t _blockIndex, char* _data, char*) override
+    {
+        return crypt(_blockIndex * c_ctrBlockSize, _data, c_ctrBlockSize);
+    }
+
+private:
+    rocksdb::Status crypt(uint64_t _offset, char* _data, size_t _size)
+    {
+        // the counter of the block is nonce + blockIndex in big endian
+        std::array<unsigned char, BlockEncryptionProvider::NONCE_SIZE> iv = m_nonce;
+        uint64_t carry = _offset / c_ctrBlockSize;
+        for (size_t i = iv.size(); i > 0 && carry != 0; --i)
+        {
+            carry += iv[i - 1];
+            iv[i - 1] = (unsigned char)carry;
+            carry >>= 8;
+        }
+
+        std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)> ctx(
+            EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+        if (!ctx || EVP_EncryptInit_ex(ctx.get(), m_cipher, nullptr, m_key.data(), iv.data()) != 1)
+        {
+            return rocksdb::Status::IOError("init the cipher of the storage encryption failed");
+        }
+        int length = 0;
+        // skip the key stream before the offset in the first block
+        if (auto skip = _offset % c_ctrBlockSize; skip != 0)
+        {
+            std::array<unsigned char, c_ctrBlockSize> dummy{};
+            if (EVP_EncryptUpdate(ctx.get(), dummy.data(), &length, dummy.data(), (int)skip) != 1)
+            {
+                return rocksdb::Status::IOError("storage encryption failed");
+            }
+        }
+        auto* data = (unsigned char*)_data;
+        while (_size > 0)
+        {
+            auto size = std::min(_size, (size_t)(INT_MAX / 2));
+            if (EVP_EncryptUpdate(ctx.get(), data, &length, data, (int)size) != 1)
+            {
+                return rocksdb::Status::IOError("storage encryption failed");
+            }
+            data += size;
+            _size -= size;
+        }
+        return rocksdb::Status::OK();
+    }
+
+    const EVP_CIPHER* m_cipher;
+    std::array<unsigned char, 32> m_key;
+    std::array<unsigned char, BlockEncryptionProvider::NONCE_SIZE> m_nonce;
+};
+}  // namespace
+
+BlockEncryptionProvider::BlockEncryptionProvider(std::string const& _dataKey, bool _smCryptoType)
+  : m_cipher(_smCryptoType ? Cipher::SM4_CTR : Cipher::AES_256_CTR)
+{
+    if (_dataKey.empty())
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("empty data key of storage encryption"));
+    }
+    if (evpCipher(m_cipher) == nullptr)
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("SM4 not supported by the openssl"));
+    }
+    // the same as the value level encryption, padded with zero or truncated to the key size
+    m_key.fill(0);
+    std::memcpy(m_key.data(), _dataKey.data(),
+        std::min(_dataKey.size(), (size_t)EVP_CIPHER_key_length(evpCipher(m_cipher))));
+    STORAGE_ENCRYPTION_LOG(INFO) << LOG_DESC("BlockEncryptionProvider")
+                                 << LOG_KV("cipher", cipherName());
+}
+
+std::string BlockEncryptionProvider::cipherName() const
+{
+    return m_cipher == Cipher::SM4_CTR ? "SM4-CTR" : "AES-256-CTR";
+}
+
+std::array<unsigned char, BlockEncryptionProvider::MAC_SIZE> BlockEncryptionProvider::mac(
+    const unsigned char* _nonce) const
+{
+    std::array<unsigned char, EVP_MAX_MD_SIZE> digest;
+    unsigned int digestSize = 0;
+    HMAC(EVP_sha256(), m_key.data(), (int)m_key.size(), _nonce, NONCE_SIZE, digest.data(),
+        &digestSize);
+    std::array<unsigned char, MAC_SIZE> out;
+    std::memcpy(out.data(), digest.data(), out.size());
+    return out;
+}
+
+rocksdb::Status BlockEncryptionProvider::CreateNewPrefix(
+    const std::string&, char* _prefix, size_t _prefixLength) const
+{
+    if (_prefixLength < PREFIX_SIZE)
+    {
+        return rocksdb::Status::InvalidArgument("the prefix of storage encryption too short");
+    }
+    std::memset(_prefix, 0, _prefixLength);
+    auto* prefix = (unsigned char*)_prefix;
+    std::memcpy(prefix, c_prefixMagic, sizeof(c_prefixMagic));
+    prefix[c_versionOffset] = c_prefixVersion;
+    prefix[c_cipherOffset] = (uint8_t)m_cipher;
+    if (RAND_bytes(prefix + c_nonceOffset, NONCE_SIZE) != 1)
+    {
+        return rocksdb::Status::IOError("generate the nonce of storage encryption failed");
+    }
+    auto prefixMac = mac(prefix + c_nonceOffset);
+    std::memcpy(prefix + c_macOffset, prefixMac.data(), prefixMac.size());
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status BlockEncryptionProvider::AddCipher(const std::string&, const char*, size_t, bool)
+{
+    // the only key is the data key from the key center
+    return rocksdb::Status::NotSupported("the key of storage encryption is set by the data key");
+}
+
+rocksdb::Status BlockEncryptionProvider::CreateCipherStream(const std::string& _fileName,
+    const rocksdb::EnvOptions&, rocksdb::Slice& _prefix,
+    std::unique_ptr<rocksdb::BlockAccessCipherStream>* _result)
+{
+    auto const* prefix = (const unsigned char*)_prefix.data();
+    if (_prefix.size() < PREFIX_SIZE ||
+        std::memcmp(prefix, c_prefixMagic, sizeof(c_prefixMagic)) != 0)
+    {
+        return rocksdb::Status::Corruption("not an encrypted storage file", _fileName);
+    }
+    if (prefix[c_versionOffset] != c_prefixVersion || prefix[c_cipherOffset] != (uint8_t)m_cipher)
+    {
+        return rocksdb::Status::NotSupported(
+            "the version or cipher of storage encryption mismatch", _fileName);
+    }
+    auto expectedMac = mac(prefix + c_nonceOffset);
+    if (CRYPTO_memcmp(expectedMac.data(), prefix + c_macOffset, MAC_SIZE) != 0)
+    {
+        return rocksdb::Status::Corruption("wrong data key of storage encryption", _fileName);
+    }
+    *_result =
+        std::make_unique<CTRCipherStream>(evpCipher(m_cipher), m_key, prefix + c_nonceOffset);
+    return rocksdb::Status::OK();
+}
+
+std::shared_ptr<rocksdb::Env> bcos::storage::newBlockEncryptedEnv(
+    bcos::security::DataEncryptInterface const& _dataEncryption)
+{
+    auto provider = std::make_shared<BlockEncryptionProvider>(
+        _dataEncryption.dataKey(), _dataEncryption.smCryptoType());
+    return std::shared_ptr<rocksdb::Env>(
+        rocksdb::NewEncryptedEnv(rocksdb::Env::Default(), provider));
+}
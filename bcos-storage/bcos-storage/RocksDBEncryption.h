@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief encrypt the files of rocksdb by blocks
+ * @file RocksDBEncryption.h
+ * @date: 2022-11-24
+ */
+#pragma once
+
+#include <bcos-framework/security/DataEncryptInterface.h>
+#include <rocksdb/env.h>
+#include <rocksdb/env_encryption.h>
+#include <array>
+#include <memory>
+#include <string>
+
+namespace bcos::storage
+{
+/**
+ * @brief Encrypts every file of rocksdb (sst, wal, manifest...) in CTR mode with the data key of
+ * the key center, AES-256 or SM4 by the crypto type. The data is compressed before encrypted so the
+ * compression keeps effective, and nothing is done for the values read from the block cache.
+ *
+ * Every file starts with a plain prefix of PREFIX_SIZE bytes:
+ *   magic | version | cipher | nonce | HMAC-SHA256(key, nonce)
+ * the nonce is random for every file, the mac detects a wrong data key when the file is opened.
+ */
+class BlockEncryptionProvider : public rocksdb::EncryptionProvider
+{
+public:
+    constexpr static size_t PREFIX_SIZE = 4096;
+    constexpr static size_t NONCE_SIZE = 16;
+    constexpr static size_t MAC_SIZE = 16;
+
+    enum class Cipher : uint8_t
+    {
+        AES_256_CTR = 0,
+        SM4_CTR = 1,
+    };
+
+    BlockEncryptionProvider(std::string const& _dataKey, bool _smCryptoType);
+
+    const char* Name() const override { return "BcosBlockEncryptionProvider"; }
+    size_t GetPrefixLength() const override { return PREFIX_SIZE; }
+    rocksdb::Status CreateNewPrefix(
+        const std::string& _fileName, char* _prefix, size_t _prefixLength) const override;
+    rocksdb::Status AddCipher(const std::string& _descriptor, const char* _cipher, size_t _len,
+        bool _forWrite) override;
+    rocksdb::Status CreateCipherStream(const std::string& _fileName,
+        const rocksdb::EnvOptions& _options, rocksdb::Slice& _prefix,
+        std::unique_ptr<rocksdb::BlockAccessCipherStream>* _result) override;
+
+    Cipher cipher() const { return m_cipher; }
+    // the name of the cipher recorded in the marker file of the database
+    std::string cipherName() const;
+
+private:
+    std::array<unsigned char, MAC_SIZE> mac(const unsigned char* _nonce) const;
+
+    Cipher m_cipher;
+    // 32 bytes for AES-256, the first 16 bytes for SM4
+    std::array<unsigned char, 32> m_key;
+};
+
+// the env encrypting all the files of a database, should outlive the database
+std::shared_ptr<rocksdb::Env> newBlockEncryptedEnv(
+    bcos::security::DataEncryptInterface const& _dataEncryption);
+}  // namespace bcos::storage
@@ -20,6 +20,7 @@
  */
 #include "RocksDBStorage.h"
 #include "Common.h"
+#include "bcos-framework/Common.h"
 #include "bcos-framework/protocol/ProtocolTypeDef.h"
 #include "bcos-framework/storage/Table.h"
 #include "bcos-utilities/Common.h"
@@ -295,18 +296,10 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
 void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorageInterface& storage,
     std::function<void(Error::Ptr, uint64_t startTS, const std::string&)> callback)
 {
-    std::ignore = param;
     try
     {
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare") << LOG_KV("number", param.number);
         auto start = utcSteadyTime();
-        {
-            std::unique_lock lock(m_writeBatchMutex);
-            if (!m_writeBatch)
-            {
-                m_writeBatch = std::make_shared<WriteBatch>();
-            }
-        }
         std::atomic_uint64_t putCount{0};
         std::atomic_uint64_t deleteCount{0};
         atomic_bool isTableValid = true;
@@ -360,25 +353,33 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
             return true;
         });
 
+        // the rows of the block may be prepared by prepareRows meanwhile
+        std::unique_lock writeBatchLock(m_writeBatchMutex);
+        // prepared again after a failure
+        if (m_abortedNumber == param.number)
+        {
+            m_abortedNumber.reset();
+        }
+        auto& batch = writeBatch(param.number);
         for (auto& [status, key, value] : dataChanges)
         {
             if (status == Entry::DELETED)
             {
-                m_writeBatch->Delete(key);
+                batch.Delete(key);
             }
             else
             {
                 auto& localKey = key;
                 std::visit(
-                    [this, &localKey](auto&& valueStr) {
+                    [&batch, &localKey](auto&& valueStr) {
                         using ValueType = std::decay_t<decltype(valueStr)>;
                         if constexpr (std::same_as<ValueType, std::string>)
                         {
-                            m_writeBatch->Put(localKey, valueStr);
+                            batch.Put(localKey, valueStr);
                         }
                         else if constexpr (std::same_as<ValueType, Entry>)
                         {
-                            m_writeBatch->Put(localKey, valueStr.get());
+                            batch.Put(localKey, valueStr.get());
                         }
                         else
                         {
@@ -389,11 +390,14 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
             }
         }
 
+        writeBatchLock.unlock();
+
         if (!isTableValid)
         {
             {
                 std::unique_lock lock(m_writeBatchMutex);
                 m_writeBatch = nullptr;
+                m_abortedNumber = param.number;
             }
             STORAGE_ROCKSDB_LOG(ERROR)
                 << LOG_DESC("asyncPrepare invalidTable") << LOG_KV("blockNumber", param.number);
@@ -402,7 +406,7 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
         }
         auto end = utcSteadyTime();
         callback(nullptr, 0, "");
-        STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare finished")
+        STORAGE_ROCKSDB_LOG(INFO) << METRIC << LOG_DESC("asyncPrepare finished")
                                   << LOG_KV("blockNumber", param.number) << LOG_KV("put", putCount)
                                   << LOG_KV("delete", deleteCount)
                                   << LOG_KV("startTS", param.timestamp)
@@ -411,6 +415,11 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
     }
     catch (const std::exception& e)
     {
+        {
+            std::unique_lock lock(m_writeBatchMutex);
+            m_writeBatch = nullptr;
+            m_abortedNumber = param.number;
+        }
         callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(UnknownEntryType, "Prepare failed! ", e), 0, "");
     }
 }
@@ -419,15 +428,27 @@ void RocksDBStorage::asyncCommit(
     const TwoPCParams& params, std::function<void(Error::Ptr, uint64_t)> callback)
 {
     size_t count = 0;
+    size_t dataSize = 0;
     auto start = utcSteadyTime();
-    std::ignore = params;
     {
         std::unique_lock lock(m_writeBatchMutex);
+        if (m_writeBatch && m_writeBatchNumber != params.number)
+        {
+            STORAGE_ROCKSDB_LOG(WARNING)
+                << LOG_DESC("asyncCommit the write batch of another block")
+                << LOG_KV("blockNumber", params.number)
+                << LOG_KV("batchNumber", m_writeBatchNumber);
+            m_writeBatch = nullptr;
+            lock.unlock();
+            callback(BCOS_ERROR_PTR(WriteError, "Commit the write batch of another block"), 0);
+            return;
+        }
         if (m_writeBatch)
         {
             WriteOptions options;
             // options.sync = true;
             count = m_writeBatch->Count();
+            dataSize = m_writeBatch->GetDataSize();
             auto status = m_db->Write(options, m_writeBatch.get());
             auto err = checkStatus(status);
             if (err)
@@ -446,12 +467,12 @@ void RocksDBStorage::asyncCommit(
     auto end = utcSteadyTime();
     callback(nullptr, 0);
 
-    STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncCommit finished")
+    STORAGE_ROCKSDB_LOG(INFO) << METRIC << LOG_DESC("asyncCommit finished")
                               << LOG_KV("blockNumber", params.number)
                               << LOG_KV("startTS", params.timestamp)
                               << LOG_KV("time(ms)", end - start)
                               << LOG_KV("callback time(ms)", utcSteadyTime() - end)
-                              << LOG_KV("count", count);
+                              << LOG_KV("count", count) << LOG_KV("dataSize", dataSize);
 }
 
 void RocksDBStorage::asyncRollback(
@@ -459,10 +480,10 @@ void RocksDBStorage::asyncRollback(
 {
     auto start = utcSteadyTime();
 
-    std::ignore = params;
     {
         std::unique_lock lock(m_writeBatchMutex);
         m_writeBatch = nullptr;
+        m_abortedNumber = params.number;
     }
     auto end = utcSteadyTime();
     callback(nullptr);
@@ -476,6 +497,45 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view table,
     const std::variant<const gsl::span<std::string_view const>, const gsl::span<std::string const>>&
         _keys,
     std::variant<gsl::span<std::string_view const>, gsl::span<std::string const>> _values) noexcept
+{
+    return writeRows(table, _keys, std::move(_values), std::nullopt);
+}
+
+bcos::Error::Ptr RocksDBStorage::prepareRows(const bcos::protocol::TwoPCParams& params,
+    std::string_view table,
+    const std::variant<const gsl::span<std::string_view const>, const gsl::span<std::string const>>&
+        _keys,
+    std::variant<gsl::span<std::string_view const>, gsl::span<std::string const>> _values) noexcept
+{
+    STORAGE_ROCKSDB_LOG(DEBUG) << LOG_DESC("prepareRows") << LOG_KV("number", params.number)
+                               << LOG_KV("table", table);
+    return writeRows(table, _keys, std::move(_values), params.number);
+}
+
+rocksdb::WriteBatch& RocksDBStorage::writeBatch(bcos::protocol::BlockNumber _number)
+{
+    if (m_writeBatch && m_writeBatchNumber != _number)
+    {
+        // left by a block failed before committed
+        STORAGE_ROCKSDB_LOG(WARNING) << LOG_DESC("discard the write batch of another block")
+                                     << LOG_KV("blockNumber", _number)
+                                     << LOG_KV("batchNumber", m_writeBatchNumber)
+                                     << LOG_KV("count", m_writeBatch->Count());
+        m_writeBatch = nullptr;
+    }
+    if (!m_writeBatch)
+    {
+        m_writeBatch = std::make_shared<WriteBatch>();
+        m_writeBatchNumber = _number;
+    }
+    return *m_writeBatch;
+}
+
+bcos::Error::Ptr RocksDBStorage::writeRows(std::string_view table,
+    const std::variant<const gsl::span<std::string_view const>, const gsl::span<std::string const>>&
+        _keys,
+    std::variant<gsl::span<std::string_view const>, gsl::span<std::string const>> _values,
+    std::optional<bcos::protocol::BlockNumber> _prepareNumber) noexcept
 {
     bcos::Error::Ptr err = nullptr;
     std::visit(
@@ -522,28 +582,50 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view table,
                         }
                     }
                 });
-            auto writeBatch = WriteBatch();
             size_t dataSize = 0;
-            for (size_t i = 0; i < keys.size(); ++i)
-            {
-                // Storage Security
-                if (m_dataEncryption)
+            auto putRows = [&](WriteBatch& writeBatch) {
+                for (size_t i = 0; i < keys.size(); ++i)
                 {
-                    dataSize += realKeys[i].size() + encryptedValues[i].size();
-                    writeBatch.Put(std::move(realKeys[i]), std::move(encryptedValues[i]));
+                    // Storage Security
+                    if (m_dataEncryption)
+                    {
+                        dataSize += realKeys[i].size() + encryptedValues[i].size();
+                        writeBatch.Put(std::move(realKeys[i]), std::move(encryptedValues[i]));
+                    }
+                    else
+                    {
+                        dataSize += realKeys[i].size() + values[i].size();
+                        writeBatch.Put(std::move(realKeys[i]), std::move(values[i]));
+                    }
                 }
-                else
+            };
+            if (_prepareNumber)
+            {
+                // written to the disk with the other rows of the block by asyncCommit
+                std::unique_lock lock(m_writeBatchMutex);
+                if (m_abortedNumber == *_prepareNumber)
                 {
-                    dataSize += realKeys[i].size() + values[i].size();
-                    writeBatch.Put(std::move(realKeys[i]), std::move(values[i]));
+                    STORAGE_ROCKSDB_LOG(WARNING)
+                        << LOG_DESC("prepareRows of the aborted block")
+                        << LOG_KV("blockNumber", *_prepareNumber) << LOG_KV("table", table);
+                    err = BCOS_ERROR_PTR(WriteError, "The block failed to prepare");
+                    return;
                 }
+                putRows(writeBatch(*_prepareNumber));
+            }
+            else
+            {
+                auto writeBatch = WriteBatch();
+                putRows(writeBatch);
+                WriteOptions options;
+                auto status = m_db->Write(options, &writeBatch);
+                err = checkStatus(status);
             }
-            WriteOptions options;
-            auto status = m_db->Write(options, &writeBatch);
-            err = checkStatus(status);
             STORAGE_ROCKSDB_LOG(INFO)
-                << LOG_DESC("setRows finished") << LOG_KV("put", keys.size())
-                << LOG_KV("dataSize", dataSize) << LOG_KV("time(ms)", utcSteadyTime() - start);
+                << LOG_DESC("setRows finished") << LOG_KV("table", table)
+                << LOG_KV("put", keys.size()) << LOG_KV("dataSize", dataSize)
+                << LOG_KV("prepare", _prepareNumber.has_value())
+                << LOG_KV("time(ms)", utcSteadyTime() - start);
         },
         _keys, _values);
     return err;
@@ -27,6 +27,7 @@
 #include <bcos-security/bcos-security/DataEncryption.h>
 #include <rocksdb/db.h>
 #include <tbb/parallel_for.h>
+#include <optional>
 
 namespace rocksdb
 {
@@ -78,10 +79,27 @@ public:
     virtual Error::Ptr deleteRows(
         std::string_view, const std::variant<const gsl::span<std::string_view const>,
                               const gsl::span<std::string const>>&) noexcept override;
+    // the rows are put into the write batch of the block, written by asyncCommit
+    Error::Ptr prepareRows(const bcos::protocol::TwoPCParams& params, std::string_view table,
+        const std::variant<const gsl::span<std::string_view const>,
+            const gsl::span<std::string const>>& keys,
+        std::variant<gsl::span<std::string_view const>, gsl::span<std::string const>>
+            values) noexcept override;
 
 private:
     Error::Ptr checkStatus(rocksdb::Status const& status);
+    Error::Ptr writeRows(std::string_view table,
+        const std::variant<const gsl::span<std::string_view const>,
+            const gsl::span<std::string const>>& keys,
+        std::variant<gsl::span<std::string_view const>, gsl::span<std::string const>> values,
+        std::optional<bcos::protocol::BlockNumber> _prepareNumber) noexcept;
+    // the write batch of the block, the batch left by another block is discarded, called with
+    // m_writeBatchMutex held
+    rocksdb::WriteBatch& writeBatch(bcos::protocol::BlockNumber _number);
     std::shared_ptr<rocksdb::WriteBatch> m_writeBatch = nullptr;
+    bcos::protocol::BlockNumber m_writeBatchNumber = -1;
+    // the block failed to prepare or rolled back, the rows prepared for it are dropped
+    std::optional<bcos::protocol::BlockNumber> m_abortedNumber;
     std::mutex m_writeBatchMutex;
     std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>> m_db;
 
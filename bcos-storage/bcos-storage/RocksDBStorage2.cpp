@@ -0,0 +1,209 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief RocksDB backend of the coroutine storage concept (Storage2)
+ * @file RocksDBStorage2.cpp
+ */
+#include "RocksDBStorage2.h"
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/Common.h>
+#include <rocksdb/options.h>
+#include <rocksdb/slice.h>
+
+using namespace bcos::storage;
+
+#define STORAGE_ROCKSDB2_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-RocksDB2]"
+
+RocksDBStorage2::RocksDBStorage2(rocksdb::DB& db,
+    bcos::security::DataEncryptInterface::Ptr dataEncryption, task::WorkStealingPool* resumePool,
+    size_t ioThreads, size_t maxBatchKeys)
+  : m_db(db),
+    m_dataEncryption(std::move(dataEncryption)),
+    m_resumePool(resumePool),
+    m_maxBatchKeys(std::max<size_t>(maxBatchKeys, 1))
+{
+    ioThreads = std::max<size_t>(ioThreads, 1);
+    m_ioThreads.reserve(ioThreads);
+    for (size_t i = 0; i < ioThreads; ++i)
+    {
+        m_ioThreads.emplace_back([this]() {
+            bcos::pthread_setThreadName("rocksdb2-io");
+            ioLoop();
+        });
+    }
+}
+
+RocksDBStorage2::~RocksDBStorage2()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_stopped = true;
+    }
+    m_condition.notify_all();
+    for (auto& thread : m_ioThreads)
+    {
+        thread.join();
+    }
+}
+
+void RocksDBStorage2::enqueue(ReadRequest* request)
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_requests.push_back(request);
+    }
+    m_condition.notify_one();
+}
+
+void RocksDBStorage2::ioLoop()
+{
+    std::vector<ReadRequest*> requests;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopped || !m_requests.empty(); });
+            if (m_requests.empty())
+            {
+                // Stopped and nothing left to serve
+                break;
+            }
+
+            // Everything that queued up while the previous MultiGet was running goes into the
+            // next one, bounded by m_maxBatchKeys (a single request is never split)
+            size_t keyCount = 0;
+            while (!m_requests.empty() &&
+                   (requests.empty() ||
+                       keyCount + m_requests.front()->dbKeys.size() <= m_maxBatchKeys))
+            {
+                keyCount += m_requests.front()->dbKeys.size();
+                requests.push_back(m_requests.front());
+                m_requests.pop_front();
+            }
+        }
+
+        multiGet(requests);
+        resume(requests);
+        requests.clear();
+    }
+}
+
+void RocksDBStorage2::multiGet(std::vector<ReadRequest*>& requests)
+{
+    size_t keyCount = 0;
+    for (auto* request : requests)
+    {
+        keyCount += request->dbKeys.size();
+    }
+
+    std::vector<rocksdb::Slice> slices;
+    slices.reserve(keyCount);
+    for (auto* request : requests)
+    {
+        for (auto const& dbKey : request->dbKeys)
+        {
+            slices.emplace_back(dbKey.data(), dbKey.size());
+        }
+    }
+
+    std::vector<rocksdb::PinnableSlice> values(keyCount);
+    std::vector<rocksdb::Status> statusList(keyCount);
+    if (keyCount > 0)
+    {
+        m_db.MultiGet(rocksdb::ReadOptions(), m_db.DefaultColumnFamily(), keyCount, slices.data(),
+            values.data(), statusList.data());
+    }
+    m_multiGetCalls.fetch_add(1, std::memory_order_relaxed);
+    m_readKeys.fetch_add(keyCount, std::memory_order_relaxed);
+
+    size_t index = 0;
+    for (auto* request : requests)
+    {
+        for (auto& value : request->values)
+        {
+            auto& status = statusList[index];
+            auto& slice = values[index];
+            ++index;
+
+            if (status.ok())
+            {
+                std::string data(slice.data(), slice.size());
+                if (!data.empty() && m_dataEncryption)
+                {
+                    try
+                    {
+                        data = m_dataEncryption->decrypt(data);
+                    }
+                    catch (std::exception& e)
+                    {
+                        request->error = std::make_exception_ptr(BCOS_ERROR_WITH_PREV(
+                            StorageError::ReadError, "Decrypt value failed!", e));
+                        continue;
+                    }
+                }
+                value.emplace(std::move(data));
+            }
+            else if (!status.IsNotFound())
+            {
+                STORAGE_ROCKSDB2_LOG(WARNING)
+                    << LOG_DESC("MultiGet failed") << LOG_KV("status", status.ToString());
+                request->error = std::make_exception_ptr(
+                    BCOS_ERROR(StorageError::ReadError, "RocksDB get failed! " + status.ToString()));
+            }
+        }
+    }
+
+    STORAGE_ROCKSDB2_LOG(TRACE) << LOG_DESC("MultiGet") << LOG_KV("requests", requests.size())
+                                << LOG_KV("keys", keyCount);
+}
+
+void RocksDBStorage2::resume(std::vector<ReadRequest*>& requests)
+{
+    for (auto* request : requests)
+    {
+        // The request is destroyed as soon as the coroutine continues, do not touch it after
+        auto handle = request->handle;
+        if (m_resumePool)
+        {
+            m_resumePool->schedule(handle);
+        }
+        else
+        {
+            handle.resume();
+        }
+    }
+}
+
+std::string RocksDBStorage2::encode(std::string_view value)
+{
+    // Storage Security
+    if (!value.empty() && m_dataEncryption)
+    {
+        return m_dataEncryption->encrypt(std::string(value));
+    }
+    return std::string(value);
+}
+
+void RocksDBStorage2::write(rocksdb::WriteBatch& writeBatch)
+{
+    auto status = m_db.Write(rocksdb::WriteOptions(), &writeBatch);
+    if (!status.ok())
+    {
+        STORAGE_ROCKSDB2_LOG(WARNING)
+            << LOG_DESC("Write failed") << LOG_KV("status", status.ToString());
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(StorageError::WriteError, "RocksDB write failed! " + status.ToString()));
+    }
+}
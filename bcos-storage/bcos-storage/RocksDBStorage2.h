@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief RocksDB backend of the coroutine storage concept (Storage2)
+ * @file RocksDBStorage2.h
+ */
+#pragma once
+
+#include "Common.h"
+#include <bcos-concepts/ByteBuffer.h>
+#include <bcos-concepts/storage/Storage2.h>
+#include <bcos-framework/security/DataEncryptInterface.h>
+#include <bcos-task/Coroutine.h>
+#include <bcos-task/WorkStealingPool.h>
+#include <bcos-utilities/Error.h>
+#include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
+#include <boost/throw_exception.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bcos::storage
+{
+
+// getRows() of every coroutine suspends on a shared read queue, the dedicated I/O threads drain
+// the queue and serve all pending keys with one MultiGet, so that concurrent point reads coming
+// from many executive coroutines are coalesced into a few large batched reads.
+class RocksDBStorage2 : public bcos::concepts::storage::StorageBase<RocksDBStorage2>
+{
+public:
+    constexpr static size_t DEFAULT_IO_THREADS = 2;
+    constexpr static size_t DEFAULT_MAX_BATCH_KEYS = 4096;
+
+    // resumePool: where to resume the readers after their batch completed, resumed on the I/O
+    // thread if null
+    RocksDBStorage2(rocksdb::DB& db,
+        bcos::security::DataEncryptInterface::Ptr dataEncryption = nullptr,
+        task::WorkStealingPool* resumePool = nullptr, size_t ioThreads = DEFAULT_IO_THREADS,
+        size_t maxBatchKeys = DEFAULT_MAX_BATCH_KEYS);
+    RocksDBStorage2(const RocksDBStorage2&) = delete;
+    RocksDBStorage2(RocksDBStorage2&&) = delete;
+    RocksDBStorage2& operator=(const RocksDBStorage2&) = delete;
+    RocksDBStorage2& operator=(RocksDBStorage2&&) = delete;
+    ~RocksDBStorage2();
+
+    task::Task<void> impl_getRows(concepts::bytebuffer::ByteBuffer auto const& tableName,
+        concepts::storage::Keys auto const& keys, concepts::storage::OptionalEntries auto& out)
+    {
+        auto tableNameView = concepts::bytebuffer::toView(tableName);
+        if (!isValid(tableNameView))
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::TableNotExists, "empty tableName"));
+        }
+
+        ReadRequest request;
+        request.dbKeys.reserve(RANGES::size(keys));
+        for (auto const& key : keys)
+        {
+            request.dbKeys.emplace_back(
+                toDBKey(tableNameView, concepts::bytebuffer::toView(key)));
+        }
+        request.values.resize(request.dbKeys.size());
+
+        co_await ReadAwaitable{this, &request};
+        if (request.error)
+        {
+            std::rethrow_exception(request.error);
+        }
+
+        concepts::resizeTo(out, request.values.size());
+        auto outIt = RANGES::begin(out);
+        for (auto& value : request.values)
+        {
+            if (value)
+            {
+                outIt->emplace();
+                (*outIt)->set(std::move(*value));
+            }
+            else
+            {
+                outIt->reset();
+            }
+            ++outIt;
+        }
+    }
+
+    task::Task<void> impl_setRows(concepts::bytebuffer::ByteBuffer auto const& tableName,
+        concepts::storage::Keys auto const& keys, concepts::storage::Entries auto const& entries)
+    {
+        auto tableNameView = concepts::bytebuffer::toView(tableName);
+        if (!isValid(tableNameView))
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::TableNotExists, "empty tableName"));
+        }
+        if (RANGES::size(keys) != RANGES::size(entries))
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::WriteError, "keys size mismatch"));
+        }
+
+        rocksdb::WriteBatch writeBatch;
+        auto entryIt = RANGES::begin(entries);
+        for (auto const& key : keys)
+        {
+            auto const& entry = *entryIt;
+            auto dbKey = toDBKey(tableNameView, concepts::bytebuffer::toView(key));
+            if (entry.status() == Entry::DELETED)
+            {
+                writeBatch.Delete(dbKey);
+            }
+            else
+            {
+                writeBatch.Put(dbKey, encode(entry.get()));
+            }
+            ++entryIt;
+        }
+        write(writeBatch);
+
+        co_return;
+    }
+
+    // Reads served and MultiGet calls issued, the ratio is the average batch size
+    uint64_t readKeys() const noexcept { return m_readKeys.load(std::memory_order_relaxed); }
+    uint64_t multiGetCalls() const noexcept
+    {
+        return m_multiGetCalls.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct ReadRequest
+    {
+        std::vector<std::string> dbKeys;
+        std::vector<std::optional<std::string>> values;
+        std::exception_ptr error;
+        CO_STD::coroutine_handle<> handle;
+    };
+
+    // Only holds pointers, the request lives in the frame of the suspended getRows coroutine
+    struct ReadAwaitable
+    {
+        constexpr bool await_ready() const noexcept { return false; }
+        void await_suspend(CO_STD::coroutine_handle<> handle)
+        {
+            m_request->handle = handle;
+            m_storage->enqueue(m_request);
+        }
+        constexpr void await_resume() const noexcept {}
+
+        RocksDBStorage2* m_storage;
+        ReadRequest* m_request;
+    };
+
+    void enqueue(ReadRequest* request);
+    void ioLoop();
+    void multiGet(std::vector<ReadRequest*>& requests);
+    void resume(std::vector<ReadRequest*>& requests);
+    std::string encode(std::string_view value);
+    void write(rocksdb::WriteBatch& writeBatch);
+
+    rocksdb::DB& m_db;
+    bcos::security::DataEncryptInterface::Ptr m_dataEncryption;
+    task::WorkStealingPool* m_resumePool;
+    size_t m_maxBatchKeys;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<ReadRequest*> m_requests;
+    bool m_stopped = false;
+    std::vector<std::thread> m_ioThreads;
+
+    std::atomic_uint64_t m_readKeys{0};
+    std::atomic_uint64_t m_multiGetCalls{0};
+};
+
+static_assert(bcos::concepts::storage::Storage<RocksDBStorage2>);
+}  // namespace bcos::storage
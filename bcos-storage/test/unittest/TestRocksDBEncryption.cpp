@@ -0,0 +1,150 @@
+#include "boost/filesystem.hpp"
+#include <bcos-storage/RocksDBEncryption.h>
+#include <rocksdb/db.h>
+#include <boost/log/core.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace bcos::storage;
+
+namespace bcos::test
+{
+struct TestRocksDBEncryptionFixture
+{
+    TestRocksDBEncryptionFixture()
+    {
+        boost::log::core::get()->set_logging_enabled(false);
+        boost::filesystem::remove_all(path);
+    }
+    ~TestRocksDBEncryptionFixture()
+    {
+        boost::filesystem::remove_all(path);
+        boost::log::core::get()->set_logging_enabled(true);
+    }
+
+    std::unique_ptr<rocksdb::DB> open(std::shared_ptr<rocksdb::Env> const& env)
+    {
+        rocksdb::Options options;
+        options.create_if_missing = true;
+        options.compression = rocksdb::kZSTD;
+        options.env = env.get();
+        rocksdb::DB* db = nullptr;
+        auto status = rocksdb::DB::Open(options, path, &db);
+        if (!status.ok())
+        {
+            return nullptr;
+        }
+        return std::unique_ptr<rocksdb::DB>(db);
+    }
+
+    // true if any file of the database contains the text
+    bool filesContain(std::string const& text)
+    {
+        for (auto const& file : boost::filesystem::directory_iterator(path))
+        {
+            std::ifstream input(file.path().string(), std::ios::binary);
+            std::string content(
+                (std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+            if (content.find(text) != std::string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<rocksdb::Env> env(std::string const& key, bool sm)
+    {
+        auto provider = std::make_shared<BlockEncryptionProvider>(key, sm);
+        return std::shared_ptr<rocksdb::Env>(
+            rocksdb::NewEncryptedEnv(rocksdb::Env::Default(), provider));
+    }
+
+    std::string path = "./unittestdb_encryption";
+    std::string key = "0123456789abcdef0123456789abcdef";
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestRocksDBEncryption, TestRocksDBEncryptionFixture)
+
+BOOST_AUTO_TEST_CASE(cipherStream)
+{
+    for (auto sm : {false, true})
+    {
+        BlockEncryptionProvider provider(key, sm);
+        std::string prefix(BlockEncryptionProvider::PREFIX_SIZE, '\0');
+        BOOST_CHECK(provider.CreateNewPrefix("test", prefix.data(), prefix.size()).ok());
+        rocksdb::Slice prefixSlice(prefix);
+        std::unique_ptr<rocksdb::BlockAccessCipherStream> stream;
+        BOOST_CHECK(provider.CreateCipherStream("test", {}, prefixSlice, &stream).ok());
+
+        std::string plain(1000, '\0');
+        for (size_t i = 0; i < plain.size(); ++i)
+        {
+            plain[i] = (char)(i * 7);
+        }
+        auto whole = plain;
+        BOOST_CHECK(stream->Encrypt(0, whole.data(), whole.size()).ok());
+        BOOST_CHECK(whole != plain);
+
+        // encrypted piece by piece at the unaligned offsets is the same
+        auto pieces = plain;
+        std::vector<size_t> offsets{0, 3, 17, 31, 32, 500, 999, 1000};
+        for (size_t i = 0; i + 1 < offsets.size(); ++i)
+        {
+            BOOST_CHECK(stream
+                            ->Encrypt(offsets[i], pieces.data() + offsets[i],
+                                offsets[i + 1] - offsets[i])
+                            .ok());
+        }
+        BOOST_CHECK(pieces == whole);
+        BOOST_CHECK(stream->Decrypt(0, whole.data(), whole.size()).ok());
+        BOOST_CHECK(whole == plain);
+
+        // another key or cipher can't open the file
+        std::unique_ptr<rocksdb::BlockAccessCipherStream> wrongStream;
+        BlockEncryptionProvider wrongKey("another key", sm);
+        BOOST_CHECK(!wrongKey.CreateCipherStream("test", {}, prefixSlice, &wrongStream).ok());
+        BlockEncryptionProvider wrongCipher(key, !sm);
+        BOOST_CHECK(!wrongCipher.CreateCipherStream("test", {}, prefixSlice, &wrongStream).ok());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(encryptedDB)
+{
+    std::string value = "encrypted_value_encrypted_value";
+    // the env should outlive the database
+    auto encryptedEnv = env(key, false);
+    {
+        auto db = open(encryptedEnv);
+        BOOST_REQUIRE(db);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            BOOST_CHECK(db->Put(rocksdb::WriteOptions(), "key" + std::to_string(i), value).ok());
+        }
+        BOOST_CHECK(db->Flush(rocksdb::FlushOptions()).ok());
+    }
+    // nothing in plain in the sst, wal and manifest
+    BOOST_CHECK(!filesContain(value));
+    BOOST_CHECK(!filesContain("key99"));
+
+    {
+        auto db = open(encryptedEnv);
+        BOOST_REQUIRE(db);
+        std::string out;
+        BOOST_CHECK(db->Get(rocksdb::ReadOptions(), "key99", &out).ok());
+        BOOST_CHECK_EQUAL(out, value);
+    }
+
+    // neither the wrong key nor the plain env opens the database
+    auto wrongEnv = env("another key", false);
+    BOOST_CHECK(!open(wrongEnv));
+    auto plainEnv = std::shared_ptr<rocksdb::Env>(rocksdb::Env::Default(), [](auto*) {});
+    BOOST_CHECK(!open(plainEnv));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -498,6 +498,77 @@ BOOST_AUTO_TEST_CASE(asyncPrepare)
     cleanupTestTableData();
 }
 
+BOOST_AUTO_TEST_CASE(prepareRows)
+{
+    std::string tableName = "test_prepare_rows";
+    auto getValue = [&](std::string const& key) {
+        std::optional<std::string> value;
+        rocksDBStorage->asyncGetRow(
+            tableName, key, [&](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                if (entry)
+                {
+                    value = std::string(entry->get());
+                }
+            });
+        return value;
+    };
+    auto prepareRows = [&](bcos::protocol::BlockNumber number, std::string const& key) {
+        bcos::protocol::TwoPCParams params;
+        params.number = number;
+        std::vector<std::string> keys{key};
+        std::vector<std::string> values{"value_" + key};
+        return rocksDBStorage->prepareRows(params, tableName, keys, values);
+    };
+    auto prepare = [&](bcos::protocol::BlockNumber number) {
+        bcos::protocol::TwoPCParams params;
+        params.number = number;
+        auto state = std::make_shared<StateStorage>(rocksDBStorage);
+        rocksDBStorage->asyncPrepare(params, *state,
+            [](Error::Ptr error, uint64_t, const std::string&) { BOOST_CHECK(!error); });
+    };
+    auto commit = [&](bcos::protocol::BlockNumber number) {
+        bcos::protocol::TwoPCParams params;
+        params.number = number;
+        Error::Ptr commitError;
+        rocksDBStorage->asyncCommit(
+            params, [&](Error::Ptr error, uint64_t) { commitError = std::move(error); });
+        return commitError;
+    };
+
+    // invisible until committed
+    prepare(1);
+    BOOST_CHECK(!prepareRows(1, "key1"));
+    BOOST_CHECK(!getValue("key1"));
+    BOOST_CHECK(!commit(1));
+    BOOST_CHECK_EQUAL(getValue("key1").value_or(""), "value_key1");
+
+    // discarded by the rollback, and not prepared for the rolled back block any more
+    prepare(2);
+    BOOST_CHECK(!prepareRows(2, "key2"));
+    bcos::protocol::TwoPCParams params;
+    params.number = 2;
+    rocksDBStorage->asyncRollback(params, [](Error::Ptr error) { BOOST_CHECK(!error); });
+    BOOST_CHECK(prepareRows(2, "key2"));
+    prepare(3);
+    BOOST_CHECK(!commit(3));
+    BOOST_CHECK(!getValue("key2"));
+
+    // the rows left by a block never committed are not committed with the next block
+    prepare(4);
+    BOOST_CHECK(!prepareRows(4, "key4"));
+    prepare(5);
+    BOOST_CHECK(!prepareRows(5, "key5"));
+    // not the batch of the block
+    BOOST_CHECK(commit(6));
+    BOOST_CHECK(!getValue("key5"));
+    prepare(5);
+    BOOST_CHECK(!prepareRows(5, "key5"));
+    BOOST_CHECK(!commit(5));
+    BOOST_CHECK(!getValue("key4"));
+    BOOST_CHECK_EQUAL(getValue("key5").value_or(""), "value_key5");
+}
+
 BOOST_AUTO_TEST_CASE(boostSerialize)
 {
     // encode the vector
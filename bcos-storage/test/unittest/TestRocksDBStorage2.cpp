@@ -0,0 +1,227 @@
+#include "bcos-table/src/StateStorage2.h"
+#include <bcos-storage/RocksDBStorage2.h>
+#include <bcos-task/Wait.h>
+#include <bcos-task/WhenAll.h>
+#include <bcos-task/WorkStealingPool.h>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/log/core.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+using namespace bcos;
+using namespace bcos::storage;
+
+namespace bcos::test
+{
+struct TestRocksDBStorage2Fixture
+{
+    TestRocksDBStorage2Fixture()
+    {
+        boost::log::core::get()->set_logging_enabled(false);
+
+        rocksdb::Options options;
+        options.create_if_missing = true;
+        rocksdb::DB* db = nullptr;
+        auto status = rocksdb::DB::Open(options, path, &db);
+        BOOST_REQUIRE(status.ok());
+        rocksDB.reset(db);
+    }
+
+    ~TestRocksDBStorage2Fixture()
+    {
+        rocksDB.reset();
+        if (boost::filesystem::exists(path))
+        {
+            boost::filesystem::remove_all(path);
+        }
+        boost::log::core::get()->set_logging_enabled(true);
+    }
+
+    std::string path = "./unittestdb2";
+    std::unique_ptr<rocksdb::DB> rocksDB;
+    std::string tableName = "TestTable";
+};
+
+// stores the values as they are, and holds the I/O thread on the first value read until open()
+class GatedEncryption : public bcos::security::DataEncryptInterface
+{
+public:
+    void init() override {}
+    void init(const std::string&, const bool) override {}
+    std::shared_ptr<bytes> decryptContents(const std::shared_ptr<bytes>& contents) override
+    {
+        return contents;
+    }
+    std::shared_ptr<bytes> decryptFile(const std::string&) override { return nullptr; }
+    std::string encrypt(const std::string& data) override { return data; }
+    std::string decrypt(const std::string& data) override
+    {
+        std::unique_lock lock(m_mutex);
+        if (!m_read)
+        {
+            m_read = true;
+            m_condition.notify_all();
+            m_condition.wait(lock, [this]() { return m_opened; });
+        }
+        return data;
+    }
+    std::string const& dataKey() const override { return m_dataKey; }
+    bool smCryptoType() const override { return false; }
+
+    void waitForRead()
+    {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_read; });
+    }
+    void open()
+    {
+        std::unique_lock lock(m_mutex);
+        m_opened = true;
+        m_condition.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_read = false;
+    bool m_opened = false;
+    std::string m_dataKey;
+};
+
+struct Reads
+{
+    size_t total = 0;
+    std::atomic_size_t matched = 0;
+    std::atomic_size_t finished = 0;
+    std::promise<void> done;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestRocksDBStorage2, TestRocksDBStorage2Fixture)
+
+BOOST_AUTO_TEST_CASE(setAndGet)
+{
+    RocksDBStorage2 storage(*rocksDB);
+
+    std::vector<std::string> keys;
+    std::vector<Entry> entries;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        keys.emplace_back("key" + boost::lexical_cast<std::string>(i));
+        Entry entry;
+        entry.set("value" + boost::lexical_cast<std::string>(i));
+        entries.emplace_back(std::move(entry));
+    }
+    task::syncWait(storage.setRows(tableName, keys, entries));
+
+    keys.emplace_back("not exists");
+    std::vector<std::optional<Entry>> out(keys.size());
+    task::syncWait(storage.getRows(tableName, keys, out));
+    for (size_t i = 0; i < 100; ++i)
+    {
+        BOOST_REQUIRE(out[i]);
+        BOOST_CHECK_EQUAL(out[i]->get(), "value" + boost::lexical_cast<std::string>(i));
+    }
+    BOOST_CHECK(!out[100]);
+
+    Entry deleted;
+    deleted.setStatus(Entry::DELETED);
+    task::syncWait(storage.setRow(tableName, std::string_view("key0"), deleted));
+    BOOST_CHECK(!task::syncWait(storage.getRow(tableName, std::string_view("key0"))));
+    BOOST_CHECK(task::syncWait(storage.getRow(tableName, std::string_view("key1"))));
+}
+
+BOOST_AUTO_TEST_CASE(coalesceConcurrentReads)
+{
+    constexpr static size_t count = 1000;
+    {
+        RocksDBStorage2 storage(*rocksDB);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Entry entry;
+            entry.set("value" + boost::lexical_cast<std::string>(i));
+            task::syncWait(
+                storage.setRow(tableName, "key" + boost::lexical_cast<std::string>(i), entry));
+        }
+    }
+
+    auto read = [](RocksDBStorage2& storage, std::string& tableName, size_t index,
+                    Reads& reads) -> task::Task<void> {
+        auto key = "key" + boost::lexical_cast<std::string>(index);
+        auto entry = co_await storage.getRow(tableName, key);
+        if (entry && entry->get() == "value" + boost::lexical_cast<std::string>(index))
+        {
+            ++reads.matched;
+        }
+        if (++reads.finished == reads.total)
+        {
+            reads.done.set_value();
+        }
+    };
+
+    // every read queued while the I/O thread is busy is served by one MultiGet, split by
+    // maxBatchKeys
+    for (auto [maxBatchKeys, expectedCalls] :
+        {std::tuple<size_t, size_t>{RocksDBStorage2::DEFAULT_MAX_BATCH_KEYS, 2},
+            std::tuple<size_t, size_t>{100, 11}})
+    {
+        task::WorkStealingPool pool(4);
+        auto encryption = std::make_shared<GatedEncryption>();
+        RocksDBStorage2 storage(*rocksDB, encryption, &pool, 1, maxBatchKeys);
+
+        Reads reads;
+        reads.total = count + 1;
+        auto done = reads.done.get_future();
+        // the single I/O thread is held by the first read
+        task::wait(read(storage, tableName, 0, reads));
+        encryption->waitForRead();
+        for (size_t i = 0; i < count; ++i)
+        {
+            task::wait(read(storage, tableName, i, reads));
+        }
+        encryption->open();
+        done.get();
+
+        BOOST_CHECK_EQUAL(reads.matched, count + 1);
+        BOOST_CHECK_EQUAL(storage.readKeys(), count + 1);
+        BOOST_CHECK_EQUAL(storage.multiGetCalls(), expectedCalls);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(layeredStateStorage)
+{
+    RocksDBStorage2 storage(*rocksDB);
+    StateStorage2<RocksDBStorage2> stateStorage(&storage);
+
+    Entry entry;
+    entry.set("base");
+    task::syncWait(storage.setRow(tableName, std::string_view("key"), entry));
+    task::syncWait(storage.setRow(tableName, std::string_view("removed"), entry));
+
+    // Reads fall through, writes stay in memory until flush
+    BOOST_CHECK_EQUAL(
+        task::syncWait(stateStorage.getRow(tableName, std::string_view("key")))->get(), "base");
+    entry.set("layer");
+    task::syncWait(stateStorage.setRow(tableName, std::string_view("key"), entry));
+    Entry deleted;
+    deleted.setStatus(Entry::DELETED);
+    task::syncWait(stateStorage.setRow(tableName, std::string_view("removed"), deleted));
+
+    BOOST_CHECK_EQUAL(
+        task::syncWait(stateStorage.getRow(tableName, std::string_view("key")))->get(), "layer");
+    BOOST_CHECK(!task::syncWait(stateStorage.getRow(tableName, std::string_view("removed"))));
+    BOOST_CHECK_EQUAL(
+        task::syncWait(storage.getRow(tableName, std::string_view("key")))->get(), "base");
+
+    task::syncWait(stateStorage.flush());
+    BOOST_CHECK_EQUAL(stateStorage.size(), 0);
+    BOOST_CHECK_EQUAL(
+        task::syncWait(storage.getRow(tableName, std::string_view("key")))->get(), "layer");
+    BOOST_CHECK(!task::syncWait(storage.getRow(tableName, std::string_view("removed"))));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -151,7 +151,6 @@ void BlockSync::stop()
         m_downloadingTimer->destroy();
     }
     m_running = false;
-    finishWorker();
     if (isWorking())
     {
         // stop the worker thread
@@ -232,8 +231,7 @@ void BlockSync::workerProcessLoop()
             executeWorker();
             if (idleWaitMs())
             {
-                boost::unique_lock<boost::mutex> l(x_signalled);
-                m_signalled.wait_for(l, boost::chrono::milliseconds(idleWaitMs()));
+                waitWorkerSignal(idleWaitMs());
             }
         }
         catch (std::exception const& e)
@@ -409,6 +407,11 @@ void BlockSync::onPeerStatus(NodeIDPtr _nodeID, BlockSyncMsgInterface::Ptr _sync
     {
         m_config->nodeTimeMaintenance()->tryToUpdatePeerTimeInfo(_nodeID, statusMsg->time());
     }
+    // the peer is higher than this node, request the blocks now
+    if (_syncMsg->number() > m_config->blockNumber())
+    {
+        notifyWorker();
+    }
 }
 
 void BlockSync::onPeerBlocks(NodeIDPtr _nodeID, BlockSyncMsgInterface::Ptr _syncMsg)
@@ -418,7 +421,7 @@ void BlockSync::onPeerBlocks(NodeIDPtr _nodeID, BlockSyncMsgInterface::Ptr _sync
                        << LOG_DESC("Receive peer block packet")
                        << LOG_KV("peer", _nodeID->shortHex());
     m_downloadingQueue->push(blockMsg);
-    m_signalled.notify_all();
+    notifyWorker();
 }
 
 void BlockSync::onPeerBlocksRequest(NodeIDPtr _nodeID, BlockSyncMsgInterface::Ptr _syncMsg)
@@ -445,7 +448,7 @@ void BlockSync::onPeerBlocksRequest(NodeIDPtr _nodeID, BlockSyncMsgInterface::Pt
     if (peerStatus)
     {
         peerStatus->downloadRequests()->push(blockRequest->number(), blockRequest->size());
-        m_signalled.notify_all();
+        notifyWorker();
         return;
     }
     BLKSYNC_LOG(WARNING) << LOG_BADGE("Download") << LOG_BADGE("onPeerBlocksRequest")
@@ -460,6 +463,8 @@ void BlockSync::onDownloadTimeout()
     // stop the timer and reset the state to idle
     m_downloadingTimer->stop();
     m_state = SyncState::Idle;
+    // retry requesting blocks
+    notifyWorker();
 }
 
 void BlockSync::downloadFinish()
@@ -132,8 +132,6 @@ protected:
     std::atomic<SyncState> m_state = {SyncState::Idle};
     std::atomic<bcos::protocol::BlockNumber> m_maxRequestNumber = {0};
 
-    boost::condition_variable m_signalled;
-    boost::mutex x_signalled;
     bcos::protocol::BlockNumber m_waterMark = 10;
     bcos::protocol::BlockNumber c_FaultyNodeBlockDelta = 50;
 
@@ -21,7 +21,10 @@
 #include "KeyPageStorage.h"
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <algorithm>
+#include <numeric>
 #include <sstream>
+#include <unordered_map>
 
 namespace bcos::storage
 {
@@ -234,118 +237,165 @@ void KeyPageStorage::parallelTraverse(bool onlyDirty,
         const std::string_view& table, const std::string_view& key, const Entry& entry)>
         callback) const
 {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_buckets.size(), 32),
-        [this, &onlyDirty, &callback](const tbb::blocked_range<size_t>& range) {
-            for (auto i = range.begin(); i != range.end(); ++i)
+    auto start = utcSteadyTimeUs();
+    // flatten the data of all the buckets, a table is in one bucket but its pages and meta are
+    // encoded in parallel
+    std::vector<std::pair<const std::pair<std::string, std::string>*, const Data*>> allData;
+    std::vector<size_t> tableIndexes;
+    std::vector<std::string_view> tables;
+    std::unordered_map<std::string_view, size_t> tableIndexMap;
+    for (const auto& bucket : m_buckets)
+    {
+        for (const auto& it : bucket.container)
+        {
+            if (onlyDirty && !it.second->entry.dirty())
             {
-                const auto& bucket = m_buckets[i];
+                continue;
+            }
+            auto [tableIt, inserted] = tableIndexMap.try_emplace(it.first.first, tables.size());
+            if (inserted)
+            {
+                tables.emplace_back(it.first.first);
+            }
+            allData.emplace_back(&it.first, it.second.get());
+            tableIndexes.emplace_back(tableIt->second);
+        }
+    }
 
-                for (const auto& it : bucket.container)
-                {
-                    if (it.second->type == Data::Type::TableMeta)
-                    {  // if metadata
-                        if (!onlyDirty || it.second->entry.dirty())
-                        {
-                            auto* meta = &std::get<1>(it.second->data);
-                            auto readLock = meta->rLock();
-                            Entry entry;
-                            entry.setObject(*meta);
-                            readLock.unlock();
-                            if (!m_readOnly)
-                            {
-                                if (meta->size() <= 10)
-                                {  // FIXME: this log is only for debug, comment it when release
-                                    KeyPage_LOG(DEBUG)
-                                        << LOG_DESC("TableMeta") << LOG_KV("table", it.first.first)
-                                        << LOG_KV("key", toHex(it.first.second))
-                                        << LOG_KV("meta", *meta);
-                                }
-                                KeyPage_LOG(DEBUG)
-                                    << LOG_DESC("Traverse TableMeta")
-                                    << LOG_KV("table", it.first.first)
-                                    << LOG_KV("pageCount", meta->size())
-                                    << LOG_KV("rowCount", meta->rowCount())
-                                    << LOG_KV("size", entry.size())
-                                    << LOG_KV("payloadRate",
-                                           sizeof(PageInfo) * meta->size() / (double)entry.size())
-                                    << LOG_KV("predictHit", meta->hitRate());
-                            }
-                            callback(it.first.first, it.first.second, entry);
-                        }
-                    }
-                    else if (it.second->type == Data::Type::Page)
-                    {  // if page, encode and return
-                        auto* page = &std::get<0>(it.second->data);
-                        if (!onlyDirty || it.second->entry.dirty())
-                        {
-                            Entry entry;
-                            if (page->validCount() == 0)
-                            {
-                                if (!m_readOnly)
-                                {
-                                    KeyPage_LOG(DEBUG) << LOG_DESC("Traverse deleted Page")
-                                                       << LOG_KV("table", it.first.first)
-                                                       << LOG_KV("key", toHex(it.first.second))
-                                                       << LOG_KV("validCount", page->validCount());
-                                }
-                                entry.setStatus(Entry::Status::DELETED);
-                                callback(it.first.first, it.first.second, entry);
-                            }
-                            else
-                            {
-                                entry.setObject(*page);
-                                entry.setStatus(it.second->entry.status());
-                                if (!m_readOnly)
-                                {
-                                    KeyPage_LOG(DEBUG)
-                                        << LOG_DESC("Traverse Page")
-                                        << LOG_KV("table", it.first.first)
-                                        << LOG_KV("pageKey", toHex(it.first.second))
-                                        << LOG_KV("valid", page->validCount())
-                                        << LOG_KV("count", page->count())
-                                        << LOG_KV("status", (int)it.second->entry.status())
-                                        << LOG_KV("pageSize", page->size())
-                                        << LOG_KV("size", entry.size());
-                                }
-                                if (it.first.second != page->endKey())
-                                {
-                                    KeyPage_LOG(FATAL)
-                                        << LOG_DESC("Traverse Page pageKey not equal to map key")
-                                        << LOG_KV("table", it.first.first)
-                                        << LOG_KV("pageKey", page->endKey())
-                                        << LOG_KV("mapKey", it.first.second);
-                                }
-                                callback(it.first.first, it.first.second, entry);
-                            }
-                            auto invalidKeys = page->invalidKeySet();
-                            for (const auto& k : invalidKeys)
-                            {
-                                if (!m_readOnly)
-                                {
-                                    KeyPage_LOG(DEBUG)
-                                        << LOG_DESC("Traverse Page delete invalid key")
-                                        << LOG_KV("currentKey", toHex(page->endKey()))
-                                        << LOG_KV("table", it.first.first)
-                                        << LOG_KV("key", toHex(k));
-                                }
-                                Entry e;
-                                e.setStatus(Entry::Status::DELETED);
-                                callback(it.first.first, k, e);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (!onlyDirty || it.second->entry.dirty())
-                        {
-                            auto& entry = it.second->entry;
-                            // assert(it.first.first == SYS_TABLES);
-                            callback(it.first.first, it.first.second, entry);
-                        }
-                    }
-                }
+    std::vector<TraverseStat> stats(tables.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, allData.size()),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (auto i = range.begin(); i != range.end(); ++i)
+            {
+                auto begin = utcSteadyTimeUs();
+                auto& stat = stats[tableIndexes[i]];
+                traverseData(allData[i].first->first, allData[i].first->second,
+                    *allData[i].second, onlyDirty, stat, callback);
+                stat.timeUs += utcSteadyTimeUs() - begin;
             }
         });
+
+    if (!m_readOnly && !tables.empty())
+    {
+        // the tables cost the most time are the bottleneck of the commit
+        std::vector<size_t> slowest(tables.size());
+        std::iota(slowest.begin(), slowest.end(), 0);
+        auto count = std::min(slowest.size(), c_traverseStatTables);
+        std::partial_sort(slowest.begin(), slowest.begin() + count, slowest.end(),
+            [&stats](size_t lhs, size_t rhs) { return stats[lhs].timeUs > stats[rhs].timeUs; });
+        std::stringstream slowTables;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto const& stat = stats[slowest[i]];
+            slowTables << tables[slowest[i]] << ":" << stat.timeUs << "us/" << stat.written
+                       << "/" << stat.skipped << "/" << stat.bytes << "B ";
+        }
+        KeyPage_LOG(INFO) << LOG_DESC("parallelTraverse") << LOG_KV("onlyDirty", onlyDirty)
+                          << LOG_KV("tables", tables.size()) << LOG_KV("data", allData.size())
+                          << LOG_KV("slowTables(time/written/skipped/size)", slowTables.str())
+                          << LOG_KV("time(us)", utcSteadyTimeUs() - start);
+    }
+}
+
+void KeyPageStorage::traverseData(std::string_view table, std::string_view key, const Data& data,
+    bool onlyDirty, TraverseStat& stat,
+    const std::function<bool(
+        const std::string_view& table, const std::string_view& key, const Entry& entry)>& callback)
+    const
+{
+    auto emit = [&](std::string_view emitKey, const Entry& entry) {
+        // the value in the backend is not changed, nothing to write
+        if (onlyDirty && data.backendValue && entry.status() != Entry::Status::DELETED &&
+            entry.get() == data.entry.get())
+        {
+            ++stat.skipped;
+            return;
+        }
+        ++stat.written;
+        stat.bytes += entry.size();
+        callback(table, emitKey, entry);
+    };
+
+    if (data.type == Data::Type::TableMeta)
+    {  // if metadata
+        const auto* meta = &std::get<1>(data.data);
+        auto readLock = meta->rLock();
+        Entry entry;
+        entry.setObject(*meta);
+        readLock.unlock();
+        if (!m_readOnly)
+        {
+            if (meta->size() <= 10)
+            {  // FIXME: this log is only for debug, comment it when release
+                KeyPage_LOG(DEBUG) << LOG_DESC("TableMeta") << LOG_KV("table", table)
+                                   << LOG_KV("key", toHex(key)) << LOG_KV("meta", *meta);
+            }
+            KeyPage_LOG(DEBUG) << LOG_DESC("Traverse TableMeta") << LOG_KV("table", table)
+                               << LOG_KV("pageCount", meta->size())
+                               << LOG_KV("rowCount", meta->rowCount())
+                               << LOG_KV("size", entry.size())
+                               << LOG_KV("payloadRate",
+                                      sizeof(PageInfo) * meta->size() / (double)entry.size())
+                               << LOG_KV("predictHit", meta->hitRate());
+        }
+        emit(key, entry);
+    }
+    else if (data.type == Data::Type::Page)
+    {  // if page, encode and return
+        const auto* page = &std::get<0>(data.data);
+        Entry entry;
+        if (page->validCount() == 0)
+        {
+            if (!m_readOnly)
+            {
+                KeyPage_LOG(DEBUG) << LOG_DESC("Traverse deleted Page") << LOG_KV("table", table)
+                                   << LOG_KV("key", toHex(key))
+                                   << LOG_KV("validCount", page->validCount());
+            }
+            entry.setStatus(Entry::Status::DELETED);
+            emit(key, entry);
+        }
+        else
+        {
+            entry.setObject(*page);
+            entry.setStatus(data.entry.status());
+            if (!m_readOnly)
+            {
+                KeyPage_LOG(DEBUG)
+                    << LOG_DESC("Traverse Page") << LOG_KV("table", table)
+                    << LOG_KV("pageKey", toHex(key)) << LOG_KV("valid", page->validCount())
+                    << LOG_KV("count", page->count()) << LOG_KV("status", (int)data.entry.status())
+                    << LOG_KV("pageSize", page->size()) << LOG_KV("size", entry.size());
+            }
+            if (key != page->endKey())
+            {
+                KeyPage_LOG(FATAL) << LOG_DESC("Traverse Page pageKey not equal to map key")
+                                   << LOG_KV("table", table) << LOG_KV("pageKey", page->endKey())
+                                   << LOG_KV("mapKey", key);
+            }
+            emit(key, entry);
+        }
+        auto invalidKeys = page->invalidKeySet();
+        for (const auto& k : invalidKeys)
+        {
+            if (!m_readOnly)
+            {
+                KeyPage_LOG(DEBUG) << LOG_DESC("Traverse Page delete invalid key")
+                                   << LOG_KV("currentKey", toHex(page->endKey()))
+                                   << LOG_KV("table", table) << LOG_KV("key", toHex(k));
+            }
+            Entry e;
+            e.setStatus(Entry::Status::DELETED);
+            emit(k, e);
+        }
+    }
+    else
+    {
+        // assert(table == SYS_TABLES);
+        ++stat.written;
+        stat.bytes += data.entry.size();
+        callback(table, key, data.entry);
+    }
 }
 
 auto KeyPageStorage::hash(const bcos::crypto::Hash::Ptr& hashImpl) const -> crypto::HashType
@@ -622,6 +672,7 @@ auto KeyPageStorage::getData(std::string_view tableView, std::string_view key, b
                 entry->setStatus(Entry::Status::NORMAL);
                 d = std::make_shared<Data>(std::string(tableView), std::string(key),
                     std::move(*entry), key.empty() ? Data::Type::TableMeta : Data::Type::Page);
+                d->backendValue = true;
                 break;
             }
         }
@@ -84,6 +84,8 @@ constexpr static int32_t ARCHIVE_FLAG =
 
 const char* const TABLE_META_KEY = "";
 const size_t MIN_PAGE_SIZE = 2048;
+// the count of the slowest tables logged by parallelTraverse
+const size_t c_traverseStatTables = 5;
 class KeyPageStorage : public virtual storage::StateStorageInterface
 {
 public:
@@ -1079,6 +1081,8 @@ public:
         Type type = Type::NormalEntry;
         Entry entry;
         std::variant<KeyPageStorage::Page, KeyPageStorage::TableMeta> data;
+        // the entry is the value in the backend, unchanged page or meta is not written again
+        bool backendValue = false;
         // std::pair<std::string_view, std::string_view> view() const
         // {
         //     return std::make_pair(std::string_view(table), std::string_view(key));
@@ -1111,7 +1115,10 @@ public:
         auto it = bucket->container.find(std::make_pair(std::string(table), std::string(key)));
         if (it != bucket->container.end())
         {
-            return std::make_optional(std::make_shared<Data>(*it->second));
+            auto data = std::make_shared<Data>(*it->second);
+            // the dirty data will be written by this storage
+            data->backendValue = data->backendValue && !data->entry.dirty();
+            return std::make_optional(std::move(data));
         }
         auto prevKeyPage = std::dynamic_pointer_cast<bcos::storage::KeyPageStorage>(getPrev());
         if (prevKeyPage)
@@ -1135,8 +1142,10 @@ public:
         if (entry)
         {
             entry->setStatus(Entry::Status::NORMAL);
-            return std::make_optional(std::make_shared<Data>(std::string(table), std::string(key),
-                std::move(*entry), key.empty() ? Data::Type::TableMeta : Data::Type::Page));
+            auto data = std::make_shared<Data>(std::string(table), std::string(key),
+                std::move(*entry), key.empty() ? Data::Type::TableMeta : Data::Type::Page);
+            data->backendValue = true;
+            return std::make_optional(std::move(data));
         }
         return std::nullopt;
     }
@@ -1178,6 +1187,8 @@ private:
                            << LOG_KV("validCount", page->validCount());
         node.key().second = newPageKey;
         node.mapped()->key = newPageKey;
+        // the page is written to the new key
+        node.mapped()->backendValue = false;
         if (newPageKey.empty())
         {
             return nullptr;
@@ -1239,6 +1250,18 @@ private:
         std::string_view table, std::string_view key);
     Entry importExistingEntry(std::string_view table, std::string_view key, Entry entry);
 
+    struct TraverseStat
+    {
+        std::atomic_uint64_t written{0};
+        std::atomic_uint64_t skipped{0};
+        std::atomic_uint64_t bytes{0};
+        std::atomic_uint64_t timeUs{0};
+    };
+    void traverseData(std::string_view table, std::string_view key, const Data& data,
+        bool onlyDirty, TraverseStat& stat,
+        const std::function<bool(const std::string_view& table, const std::string_view& key,
+            const Entry& entry)>& callback) const;
+
     // if data not exist, create an empty one
     std::tuple<Error::UniquePtr, std::optional<Data*>> getData(
         std::string_view tableView, std::string_view key, bool mustExist = false);
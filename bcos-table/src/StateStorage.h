@@ -315,6 +315,8 @@ public:
 
         ssize_t updatedCapacity = entry.size();
         std::optional<Entry> entryOld;
+        // hash the new entry out of the bucket lock
+        auto updatedHash = entryHash(tableView, keyView, entry);
 
         auto [bucket, lock] = getBucket(tableView);
         boost::ignore_unused(lock);
@@ -323,6 +325,7 @@ public:
         if (it != bucket->container.end())
         {
             auto& existsEntry = it->entry;
+            updatedHash ^= entryHash(tableView, keyView, existsEntry);
             entryOld.emplace(std::move(existsEntry));
 
             updatedCapacity -= entryOld->size();
@@ -347,6 +350,7 @@ public:
         }
 
         bucket->capacity += updatedCapacity;
+        bucket->hash ^= updatedHash;
 
         lock.unlock();
         callback(nullptr);
@@ -397,6 +401,14 @@ public:
     crypto::HashType hash(const bcos::crypto::Hash::Ptr& hashImpl) const override
     {
         bcos::crypto::HashType totalHash;
+        if (m_hashImpl && hashImpl == m_hashImpl)
+        {
+            for (auto const& bucket : m_buckets)
+            {
+                totalHash ^= bucket.hash;
+            }
+            return totalHash;
+        }
 
         std::vector<bcos::crypto::HashType> hashes(m_buckets.size());
         tbb::parallel_for(tbb::blocked_range<size_t>(0U, m_buckets.size()),
@@ -458,6 +470,8 @@ public:
                     }
 
                     updateCapacity = change.entry->size() - it->entry.size();
+                    bucket->hash ^= entryHash(change.table, change.key, it->entry) ^
+                                    entryHash(change.table, change.key, *change.entry);
 
                     const auto& rollbackEntry = change.entry;
                     bucket->container.modify(it,
@@ -472,6 +486,7 @@ public:
                             << " | " << toHex(change.entry->get());
                     }
                     updateCapacity = change.entry->size();
+                    bucket->hash ^= entryHash(change.table, change.key, *change.entry);
                     bucket->container.emplace(
                         Data{change.table, change.key, std::move(*(change.entry))});
                 }
@@ -487,6 +502,7 @@ public:
                     }
 
                     updateCapacity = 0 - it->entry.size();
+                    bucket->hash ^= entryHash(change.table, change.key, it->entry);
                     bucket->container.erase(it);
                 }
                 else
@@ -506,7 +522,39 @@ public:
     void setEnableTraverse(bool enableTraverse) { m_enableTraverse = enableTraverse; }
     void setMaxCapacity(ssize_t capacity) { m_maxCapacity = capacity; }
 
+    // the hashes of the dirty entries are accumulated by bucket when written and rollbacked, so
+    // hash() with the same hashImpl only xors the buckets instead of walking all the entries
+    void setHashImpl(bcos::crypto::Hash::Ptr hashImpl) override
+    {
+        m_hashImpl = std::move(hashImpl);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0U, m_buckets.size()), [this](auto const& range) {
+                for (auto i = range.begin(); i < range.end(); ++i)
+                {
+                    auto& bucket = m_buckets[i];
+                    std::unique_lock<std::mutex> lock(bucket.mutex);
+                    bucket.hash = bcos::crypto::HashType();
+                    for (auto& it : bucket.container)
+                    {
+                        bucket.hash ^= entryHash(it.table, it.key, it.entry);
+                    }
+                }
+            });
+    }
+
 private:
+    bcos::crypto::HashType entryHash(
+        std::string_view table, std::string_view key, Entry const& entry) const
+    {
+        if (!m_hashImpl || !entry.dirty())
+        {
+            return {};
+        }
+        return m_hashImpl->hash(bytesConstRef((const bcos::byte*)table.data(), table.size())) ^
+               m_hashImpl->hash(bytesConstRef((const bcos::byte*)key.data(), key.size())) ^
+               entry.hash(table, key, m_hashImpl, m_blockVersion);
+    }
+
     Entry importExistingEntry(std::string_view table, std::string_view key, Entry entry)
     {
         if (m_readOnly)
@@ -544,6 +592,7 @@ private:
     }
 
     bool m_enableTraverse = false;
+    bcos::crypto::Hash::Ptr m_hashImpl;
 
     constexpr static int64_t DEFAULT_CAPACITY = 32L * 1024 * 1024;
     int64_t m_maxCapacity = DEFAULT_CAPACITY;
@@ -575,6 +624,8 @@ private:
         Container container;
         std::mutex mutex;
         ssize_t capacity = 0;
+        // xor of the hashes of the dirty entries, maintained if m_hashImpl set
+        bcos::crypto::HashType hash;
     };
     uint32_t m_blockVersion = 0;
     std::vector<Bucket> m_buckets;
@@ -600,6 +651,7 @@ private:
         {
             auto& item = bucket.container.template get<1>().front();
             bucket.capacity -= item.entry.size();
+            bucket.hash ^= entryHash(item.table, item.key, item.entry);
 
             bucket.container.template get<1>().pop_front();
             ++clearCount;
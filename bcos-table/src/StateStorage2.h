@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief layered in-memory storage of the coroutine storage concept (Storage2)
+ * @file StateStorage2.h
+ */
+#pragma once
+
+#include <bcos-concepts/Basic.h>
+#include <bcos-concepts/ByteBuffer.h>
+#include <bcos-concepts/storage/Storage2.h>
+#include <bcos-framework/storage/Common.h>
+#include <bcos-utilities/Error.h>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace bcos::storage
+{
+
+// The Storage2 counterpart of StateStorage: writes stay in memory (deletions as DELETED
+// tombstones), reads fall through to the previous layer for keys this layer has never seen, and
+// flush() pushes all changes down to the previous layer in one setRows per table.
+template <class PrevStorage>
+class StateStorage2 : public concepts::storage::StorageBase<StateStorage2<PrevStorage>>
+{
+public:
+    // prev may be null (or PrevStorage void) for a pure in-memory storage
+    explicit StateStorage2(
+        PrevStorage* prev, size_t bucketCount = std::thread::hardware_concurrency())
+      : m_prev(prev), m_buckets(std::max<size_t>(bucketCount, 1))
+    {}
+    StateStorage2(const StateStorage2&) = delete;
+    StateStorage2(StateStorage2&&) = delete;
+    StateStorage2& operator=(const StateStorage2&) = delete;
+    StateStorage2& operator=(StateStorage2&&) = delete;
+    ~StateStorage2() = default;
+
+    task::Task<void> impl_getRows(concepts::bytebuffer::ByteBuffer auto const& tableName,
+        concepts::storage::Keys auto const& keys, concepts::storage::OptionalEntries auto& out)
+    {
+        auto tableNameView = concepts::bytebuffer::toView(tableName);
+        concepts::resizeTo(out, RANGES::size(keys));
+
+        std::vector<std::string_view> missingKeys;
+        std::vector<decltype(RANGES::begin(out))> missingOuts;
+        auto outIt = RANGES::begin(out);
+        for (auto const& key : keys)
+        {
+            auto keyView = concepts::bytebuffer::toView(key);
+            auto& bucket = getBucket(tableNameView, keyView);
+            {
+                std::unique_lock lock(bucket.mutex);
+                auto it = bucket.entries.find(std::make_tuple(tableNameView, keyView));
+                if (it != bucket.entries.end())
+                {
+                    if (it->second.status() == Entry::DELETED)
+                    {
+                        outIt->reset();
+                    }
+                    else
+                    {
+                        *outIt = it->second;
+                    }
+                    ++outIt;
+                    continue;
+                }
+            }
+
+            outIt->reset();
+            missingKeys.emplace_back(keyView);
+            missingOuts.emplace_back(outIt);
+            ++outIt;
+        }
+
+        if constexpr (!std::is_void_v<PrevStorage>)
+        {
+            if (m_prev && !missingKeys.empty())
+            {
+                std::vector<concepts::storage::OptionalEntry> prevEntries(missingKeys.size());
+                co_await m_prev->getRows(tableNameView, missingKeys, prevEntries);
+                for (size_t i = 0; i < missingOuts.size(); ++i)
+                {
+                    *missingOuts[i] = std::move(prevEntries[i]);
+                }
+            }
+        }
+    }
+
+    task::Task<void> impl_setRows(concepts::bytebuffer::ByteBuffer auto const& tableName,
+        concepts::storage::Keys auto const& keys, concepts::storage::Entries auto const& entries)
+    {
+        if (RANGES::size(keys) != RANGES::size(entries))
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::WriteError, "keys size mismatch"));
+        }
+
+        auto tableNameView = concepts::bytebuffer::toView(tableName);
+        auto entryIt = RANGES::begin(entries);
+        for (auto const& key : keys)
+        {
+            auto keyView = concepts::bytebuffer::toView(key);
+            auto& bucket = getBucket(tableNameView, keyView);
+            {
+                std::unique_lock lock(bucket.mutex);
+                auto it = bucket.entries.find(std::make_tuple(tableNameView, keyView));
+                if (it != bucket.entries.end())
+                {
+                    it->second = *entryIt;
+                }
+                else
+                {
+                    bucket.entries.emplace(
+                        std::make_tuple(std::string(tableNameView), std::string(keyView)),
+                        *entryIt);
+                }
+            }
+            ++entryIt;
+        }
+
+        co_return;
+    }
+
+    // Write every change of this layer into the previous layer, then clear this layer
+    task::Task<void> flush() requires(!std::is_void_v<PrevStorage>)
+    {
+        if (!m_prev)
+        {
+            co_return;
+        }
+
+        std::map<std::string, std::tuple<std::vector<std::string>, std::vector<Entry>>,
+            std::less<>>
+            tables;
+        for (auto& bucket : m_buckets)
+        {
+            std::unique_lock lock(bucket.mutex);
+            for (auto& [tableKey, entry] : bucket.entries)
+            {
+                auto& [keys, entries] = tables[std::get<0>(tableKey)];
+                keys.emplace_back(std::get<1>(tableKey));
+                entries.emplace_back(std::move(entry));
+            }
+            bucket.entries.clear();
+        }
+
+        for (auto& [tableName, changes] : tables)
+        {
+            auto& [keys, entries] = changes;
+            co_await m_prev->setRows(tableName, keys, entries);
+        }
+    }
+
+    size_t size() const
+    {
+        size_t count = 0;
+        for (auto& bucket : m_buckets)
+        {
+            std::unique_lock lock(bucket.mutex);
+            count += bucket.entries.size();
+        }
+        return count;
+    }
+
+private:
+    struct Bucket
+    {
+        mutable std::mutex mutex;
+        std::map<std::tuple<std::string, std::string>, Entry, std::less<>> entries;
+    };
+
+    Bucket& getBucket(std::string_view tableName, std::string_view key)
+    {
+        constexpr static std::hash<std::string_view> hasher;
+        auto hash = hasher(tableName) ^ (hasher(key) << 1);
+        return m_buckets[hash % m_buckets.size()];
+    }
+
+    PrevStorage* m_prev;
+    std::vector<Bucket> m_buckets;
+};
+
+}  // namespace bcos::storage
@@ -107,6 +107,8 @@ public:
     }
 
     virtual crypto::HashType hash(const bcos::crypto::Hash::Ptr& hashImpl) const = 0;
+    // maintain the hash incrementally with the hashImpl passed to hash() later, if supported
+    virtual void setHashImpl(bcos::crypto::Hash::Ptr hashImpl [[maybe_unused]]) {}
     virtual void setPrev(std::shared_ptr<StorageInterface> prev)
     {
         std::unique_lock<std::shared_mutex> lock(m_prevMutex);
@@ -35,8 +35,10 @@
 #include <exception>
 #include <future>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <random>
+#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -2866,6 +2868,56 @@ BOOST_AUTO_TEST_CASE(insertAndDelete)
     }
 }
 
+BOOST_AUTO_TEST_CASE(skipUnchangedPages)
+{
+    auto backend = make_shared<StateStorage>(nullptr);
+    auto tableStorage = make_shared<KeyPageStorage>(backend);
+    std::string tableName = "testTable";
+    tableStorage->createTable(tableName, "value");
+    auto table = tableStorage->openTable(tableName);
+    for (int i = 0; i < 10; ++i)
+    {
+        auto entry = table->newEntry();
+        entry.setField(0, "value" + boost::lexical_cast<std::string>(i));
+        table->setRow("key" + boost::lexical_cast<std::string>(i), entry);
+    }
+    tableStorage->setReadOnly(true);
+    backend->merge(true, *tableStorage);
+
+    // the same value is written again, the page and meta in the backend are not changed
+    tableStorage = make_shared<KeyPageStorage>(backend);
+    table = tableStorage->openTable(tableName);
+    auto entry = table->newEntry();
+    entry.setField(0, "value3");
+    table->setRow("key3", entry);
+    BOOST_TEST(tableStorage->hash(hashImpl) != crypto::HashType(0));
+    std::atomic<size_t> written = 0;
+    tableStorage->parallelTraverse(true, [&](auto&, auto&, auto&) {
+        ++written;
+        return true;
+    });
+    BOOST_TEST(written == 0);
+    // all the data is traversed without onlyDirty
+    tableStorage->parallelTraverse(false, [&](auto&, auto&, auto&) {
+        ++written;
+        return true;
+    });
+    BOOST_TEST(written > 0);
+
+    entry.setField(0, "changed value");
+    table->setRow("key4", entry);
+    std::set<std::string> pageKeys;
+    std::mutex mutex;
+    tableStorage->parallelTraverse(true, [&](auto&, auto& key, auto& entry) {
+        BOOST_TEST(entry.status() != Entry::Status::DELETED);
+        std::unique_lock lock(mutex);
+        pageKeys.emplace(key);
+        return true;
+    });
+    // the changed page is written
+    BOOST_TEST(pageKeys.size() == 1);
+    BOOST_TEST(pageKeys.count("key9") == 1);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
@@ -1149,6 +1149,62 @@ BOOST_AUTO_TEST_CASE(randomRWHash)
     }
 }
 
+BOOST_AUTO_TEST_CASE(incrementalHash)
+{
+    // the same writes to a storage without hashImpl set are hashed by walking the entries
+    auto incremental = std::make_shared<StateStorage>(memoryStorage);
+    incremental->setHashImpl(hashImpl);
+    auto walked = std::make_shared<StateStorage>(memoryStorage);
+    auto setRow = [&](std::string_view table, std::string_view key,
+                      std::optional<std::string> value) {
+        for (auto& storage : {incremental, walked})
+        {
+            Entry entry;
+            if (value)
+            {
+                entry.importFields({*value});
+            }
+            else
+            {
+                entry.setStatus(Entry::DELETED);
+            }
+            storage->asyncSetRow(
+                table, key, std::move(entry), [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+        }
+    };
+    auto checkHash = [&]() {
+        auto hash = incremental->hash(hashImpl);
+        BOOST_CHECK_EQUAL(hash.hex(), walked->hash(hashImpl).hex());
+        return hash;
+    };
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        setRow("t_" + boost::lexical_cast<std::string>(i % 7), boost::lexical_cast<std::string>(i),
+            boost::lexical_cast<std::string>(i));
+    }
+    auto hash = checkHash();
+    BOOST_CHECK(hash != crypto::HashType());
+
+    auto incrementalRecoder = std::make_shared<Recoder>();
+    auto walkedRecoder = std::make_shared<Recoder>();
+    incremental->setRecoder(incrementalRecoder);
+    walked->setRecoder(walkedRecoder);
+    // overwrite, delete and insert
+    setRow("t_1", "1", "updated");
+    setRow("t_2", "2", std::nullopt);
+    setRow("t_new", "key", "value");
+    BOOST_CHECK(checkHash() != hash);
+
+    incremental->rollback(*incrementalRecoder);
+    walked->rollback(*walkedRecoder);
+    BOOST_CHECK_EQUAL(checkHash().hex(), hash.hex());
+
+    // the hash of the entries written before set is recalculated
+    walked->setHashImpl(hashImpl);
+    BOOST_CHECK_EQUAL(walked->hash(hashImpl).hex(), hash.hex());
+}
+
 BOOST_AUTO_TEST_CASE(hash_map)
 {
     class EntryKey
@@ -143,6 +143,15 @@ public:
     void asyncNotifyAMOPMessage(int16_t _type, std::string const& _topic, bcos::bytesConstRef _data,
         std::function<void(bcos::Error::Ptr&& _error, bcos::bytesPointer _responseData)> _callback)
         override
+    {
+        asyncNotifyAMOPMessage(
+            _type, _topic, vector<tars::Char>(_data.begin(), _data.end()), std::move(_callback));
+    }
+
+    // the request is encoded before returning, the same request can be pushed to many clients
+    void asyncNotifyAMOPMessage(int16_t _type, std::string const& _topic,
+        vector<tars::Char> const& _request,
+        std::function<void(bcos::Error::Ptr&& _error, bcos::bytesPointer _responseData)> _callback)
     {
         class Callback : public bcostars::RpcServicePrxCallback
         {
@@ -182,9 +191,8 @@ public:
         {
             return;
         }
-        vector<tars::Char> request(_data.begin(), _data.end());
         m_prx->tars_set_timeout(c_amopTimeout)
-            ->async_asyncNotifyAMOPMessage(new Callback(_callback), _type, _topic, request);
+            ->async_asyncNotifyAMOPMessage(new Callback(_callback), _type, _topic, _request);
     }
 
     void asyncNotifySubscribeTopic(
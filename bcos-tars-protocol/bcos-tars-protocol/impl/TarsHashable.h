@@ -4,9 +4,15 @@
 #include <bcos-concepts/Basic.h>
 #include <bcos-concepts/ByteBuffer.h>
 #include <bcos-crypto/hasher/Hasher.h>
+#include <bcos-crypto/hasher/MultiBuffer.h>
 #include <bcos-tars-protocol/tars/Block.h>
 #include <bcos-tars-protocol/tars/Transaction.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <boost/endian/conversion.hpp>
+#include <array>
+#include <cstring>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -137,4 +143,98 @@ auto impl_calculate(bcostars::Block const& block, bcos::concepts::bytebuffer::By
     impl_calculate<Hasher>(block.blockHeader, out);
 }
 
+namespace detail
+{
+inline void appendHashField(std::vector<std::byte>& out, std::integral auto value)
+{
+    auto const* data = reinterpret_cast<std::byte const*>(&value);
+    out.insert(out.end(), data, data + sizeof(value));
+}
+inline void appendHashField(std::vector<std::byte>& out, RANGES::contiguous_range auto const& value)
+{
+    auto const* data = reinterpret_cast<std::byte const*>(RANGES::data(value));
+    out.insert(out.end(), data, data + RANGES::size(value) * sizeof(*RANGES::data(value)));
+}
+
+// the same byte sequence impl_calculate feeds to the hasher
+inline void appendHashFields(std::vector<std::byte>& out, bcostars::Transaction const& transaction)
+{
+    auto const& hashFields = transaction.data;
+    appendHashField(out, boost::endian::native_to_big((int32_t)hashFields.version));
+    appendHashField(out, hashFields.chainID);
+    appendHashField(out, hashFields.groupID);
+    appendHashField(out, boost::endian::native_to_big((int64_t)hashFields.blockLimit));
+    appendHashField(out, hashFields.nonce);
+    appendHashField(out, hashFields.to);
+    appendHashField(out, hashFields.input);
+    appendHashField(out, hashFields.abi);
+}
+
+inline void appendHashFields(
+    std::vector<std::byte>& out, bcostars::TransactionReceipt const& receipt)
+{
+    auto const& hashFields = receipt.data;
+    appendHashField(out, boost::endian::native_to_big((int32_t)hashFields.version));
+    appendHashField(out, hashFields.gasUsed);
+    appendHashField(out, hashFields.contractAddress);
+    appendHashField(out, boost::endian::native_to_big((int32_t)hashFields.status));
+    appendHashField(out, hashFields.output);
+    for (auto const& log : hashFields.logEntries)
+    {
+        appendHashField(out, log.address);
+        for (auto const& topicItem : log.topic)
+        {
+            appendHashField(out, topicItem);
+        }
+        appendHashField(out, log.data);
+    }
+    appendHashField(out, boost::endian::native_to_big((int64_t)hashFields.blockNumber));
+}
+}  // namespace detail
+
+// calculate the hashes of many transactions or receipts, the ones without dataHash are hashed
+// several per call by a multi-buffer hasher
+template <bcos::crypto::hasher::Hasher Hasher, class Item>
+std::vector<std::array<std::byte, Hasher::HASH_SIZE>> calculateBatch(std::vector<Item> const& items)
+{
+    std::vector<std::array<std::byte, Hasher::HASH_SIZE>> hashes(items.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, items.size()),
+        [&items, &hashes](const tbb::blocked_range<size_t>& range) {
+            std::vector<std::byte> buffer;
+            std::vector<size_t> offsets;
+            std::vector<size_t> indexes;
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                if (!items[i].dataHash.empty())
+                {
+                    bcos::concepts::bytebuffer::assignTo(items[i].dataHash, hashes[i]);
+                    continue;
+                }
+                offsets.push_back(buffer.size());
+                indexes.push_back(i);
+                detail::appendHashFields(buffer, items[i]);
+            }
+            if (indexes.empty())
+            {
+                return;
+            }
+            offsets.push_back(buffer.size());
+
+            std::vector<std::span<std::byte const>> messages;
+            messages.reserve(indexes.size());
+            for (size_t i = 0; i < indexes.size(); ++i)
+            {
+                messages.emplace_back(buffer.data() + offsets[i], offsets[i + 1] - offsets[i]);
+            }
+            std::vector<std::byte> outputs(indexes.size() * Hasher::HASH_SIZE);
+            bcos::crypto::hasher::hashBatch<Hasher>(messages, outputs);
+            for (size_t i = 0; i < indexes.size(); ++i)
+            {
+                std::memcpy(hashes[indexes[i]].data(), outputs.data() + i * Hasher::HASH_SIZE,
+                    Hasher::HASH_SIZE);
+            }
+        });
+    return hashes;
+}
+
 }  // namespace bcos::concepts::hash
@@ -0,0 +1,500 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief read-only view over a tars encoded struct
+ * @file TarsView.h
+ * @date 2022-11-14
+ */
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Exceptions.h>
+#include <boost/endian/conversion.hpp>
+#include <boost/throw_exception.hpp>
+#include <tup/Tars.h>
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace bcostars::protocol::impl
+{
+struct TarsViewException : public bcos::Exception
+{
+    using bcos::Exception::Exception;
+};
+
+/**
+ * @brief The offsets of the fields of a tars struct are located once over the encoded buffer, the
+ * fields are read on demand without copying them, and the view shares the ownership of the
+ * buffer so that the views of the nested structs (the transactions of a block) outlive the
+ * object they are decoded from.
+ */
+class TarsView
+{
+public:
+    // the wire types of tars
+    enum Type : uint8_t
+    {
+        Char = 0,
+        Short = 1,
+        Int32 = 2,
+        Int64 = 3,
+        Float = 4,
+        Double = 5,
+        String1 = 6,
+        String4 = 7,
+        Map = 8,
+        List = 9,
+        StructBegin = 10,
+        StructEnd = 11,
+        ZeroTag = 12,
+        SimpleList = 13,
+    };
+
+    struct Field
+    {
+        uint8_t tag = 0;
+        uint8_t type = 0;
+        // the offsets in the view: the head, the value and the end of the field
+        size_t head = 0;
+        size_t value = 0;
+        size_t end = 0;
+    };
+
+    TarsView() = default;
+    // _data: the encoded fields of the struct (without StructBegin/StructEnd)
+    TarsView(std::shared_ptr<const bcos::bytes> _owner, bcos::bytesConstRef _data)
+      : m_owner(std::move(_owner)), m_data(_data)
+    {
+        size_t pos = 0;
+        while (pos < m_data.size())
+        {
+            Field field;
+            field.head = pos;
+            pos = readHead(pos, field.tag, field.type);
+            if (field.type == StructEnd)
+            {
+                break;
+            }
+            field.value = pos;
+            pos = skip(pos, field.type);
+            field.end = pos;
+            m_fields.emplace_back(field);
+        }
+    }
+    // copy the buffer once, the fields of the view are read from the copy
+    static TarsView fromBuffer(bcos::bytesConstRef _data)
+    {
+        auto owner = std::make_shared<const bcos::bytes>(_data.begin(), _data.end());
+        return TarsView(owner, bcos::ref(*owner));
+    }
+
+    bool empty() const { return m_data.empty(); }
+    bcos::bytesConstRef data() const { return m_data; }
+    // the fields without the StructEnd of a nested struct, the same as the struct encoded alone
+    bcos::bytesConstRef encodedData() const
+    {
+        return m_fields.empty() ? bcos::bytesConstRef() :
+                                  m_data.getCroppedData(0, m_fields.back().end);
+    }
+    std::shared_ptr<const bcos::bytes> const& owner() const { return m_owner; }
+    std::vector<Field> const& fields() const { return m_fields; }
+
+    Field const* field(uint8_t _tag) const
+    {
+        auto it = std::find_if(m_fields.begin(), m_fields.end(),
+            [_tag](Field const& _field) { return _field.tag == _tag; });
+        return it == m_fields.end() ? nullptr : &(*it);
+    }
+    bool has(uint8_t _tag) const { return field(_tag) != nullptr; }
+
+    int64_t getInt(uint8_t _tag, int64_t _default = 0) const
+    {
+        auto const* target = field(_tag);
+        if (!target)
+        {
+            return _default;
+        }
+        return readInt(target->value, target->type);
+    }
+
+    std::string_view getString(uint8_t _tag) const
+    {
+        auto const* target = field(_tag);
+        if (!target)
+        {
+            return {};
+        }
+        auto [offset, length] = stringRange(target->value, target->type);
+        return {(const char*)m_data.data() + offset, length};
+    }
+
+    // vector<byte>
+    bcos::bytesConstRef getBytes(uint8_t _tag) const
+    {
+        auto const* target = field(_tag);
+        if (!target)
+        {
+            return {};
+        }
+        return bytesOf(*target);
+    }
+
+    TarsView getStruct(uint8_t _tag) const
+    {
+        auto const* target = field(_tag);
+        if (!target)
+        {
+            return {};
+        }
+        checkType(target->type, StructBegin);
+        return structOf(*target);
+    }
+
+    // vector<Struct>
+    std::vector<TarsView> getStructList(uint8_t _tag) const
+    {
+        std::vector<TarsView> views;
+        forEachElement(_tag, [this, &views](Field const& _element) {
+            checkType(_element.type, StructBegin);
+            views.emplace_back(structOf(_element));
+        });
+        return views;
+    }
+
+    // vector<vector<byte>>
+    std::vector<bcos::bytesConstRef> getBytesList(uint8_t _tag) const
+    {
+        std::vector<bcos::bytesConstRef> values;
+        forEachElement(
+            _tag, [this, &values](Field const& _element) { values.emplace_back(bytesOf(_element)); });
+        return values;
+    }
+
+    // vector<string>
+    std::vector<std::string_view> getStringList(uint8_t _tag) const
+    {
+        std::vector<std::string_view> values;
+        forEachElement(_tag, [this, &values](Field const& _element) {
+            auto [offset, length] = stringRange(_element.value, _element.type);
+            values.emplace_back((const char*)m_data.data() + offset, length);
+        });
+        return values;
+    }
+
+    // vector<long>
+    std::vector<int64_t> getIntList(uint8_t _tag) const
+    {
+        std::vector<int64_t> values;
+        forEachElement(_tag, [this, &values](Field const& _element) {
+            values.emplace_back(readInt(_element.value, _element.type));
+        });
+        return values;
+    }
+
+    size_t listSize(uint8_t _tag) const
+    {
+        auto const* target = field(_tag);
+        if (!target)
+        {
+            return 0;
+        }
+        if (target->type == SimpleList)
+        {
+            return bytesOf(*target).size();
+        }
+        checkType(target->type, List);
+        uint8_t type = 0;
+        uint8_t tag = 0;
+        auto pos = readHead(target->value, tag, type);
+        return (size_t)readInt(pos, type);
+    }
+
+    // the encoded bytes of the field, including its head
+    bcos::bytesConstRef rawField(uint8_t _tag) const
+    {
+        auto const* target = field(_tag);
+        if (!target)
+        {
+            return {};
+        }
+        return m_data.getCroppedData(target->head, target->end - target->head);
+    }
+
+    // decode all the fields of the view into _out
+    template <class TarsStructType>
+    void decodeTo(TarsStructType& _out) const
+    {
+        tars::TarsInputStream<tars::BufferReader> input;
+        input.setBuffer((const char*)m_data.data(), m_data.size());
+        _out.readFrom(input);
+    }
+
+    // decode the fields of the view except _skipTags into _out, the skipped fields keep their
+    // default values
+    template <class TarsStructType>
+    void decodeTo(TarsStructType& _out, std::initializer_list<uint8_t> _skipTags) const
+    {
+        bcos::bytes buffer;
+        buffer.reserve(m_data.size());
+        for (auto const& it : m_fields)
+        {
+            if (std::find(_skipTags.begin(), _skipTags.end(), it.tag) != _skipTags.end())
+            {
+                continue;
+            }
+            buffer.insert(buffer.end(), m_data.begin() + it.head, m_data.begin() + it.end);
+        }
+        tars::TarsInputStream<tars::BufferReader> input;
+        input.setBuffer((const char*)buffer.data(), buffer.size());
+        _out.readFrom(input);
+    }
+
+    static std::span<std::byte const> toSpan(std::string_view _value)
+    {
+        return {(std::byte const*)_value.data(), _value.size()};
+    }
+    static std::span<std::byte const> toSpan(bcos::bytesConstRef _value)
+    {
+        return {(std::byte const*)_value.data(), _value.size()};
+    }
+
+private:
+    [[noreturn]] static void malformed(std::string const& _message)
+    {
+        BOOST_THROW_EXCEPTION(TarsViewException("malformed tars data: " + _message));
+    }
+    static void checkType(uint8_t _type, uint8_t _expected)
+    {
+        if (_type != _expected)
+        {
+            malformed("unexpected type " + std::to_string(_type));
+        }
+    }
+    void checkSize(size_t _pos, size_t _length) const
+    {
+        if (_pos > m_data.size() || _length > m_data.size() - _pos)
+        {
+            malformed("out of range");
+        }
+    }
+
+    template <class IntType>
+    IntType readBigEndian(size_t _pos) const
+    {
+        checkSize(_pos, sizeof(IntType));
+        IntType value;
+        std::memcpy(&value, m_data.data() + _pos, sizeof(IntType));
+        return boost::endian::big_to_native(value);
+    }
+
+    size_t readHead(size_t _pos, uint8_t& _tag, uint8_t& _type) const
+    {
+        checkSize(_pos, 1);
+        auto head = m_data[_pos++];
+        _type = head & 0x0F;
+        _tag = (head & 0xF0) >> 4;
+        if (_tag == 15)
+        {
+            checkSize(_pos, 1);
+            _tag = m_data[_pos++];
+        }
+        return _pos;
+    }
+
+    int64_t readInt(size_t _pos, uint8_t _type) const
+    {
+        switch (_type)
+        {
+        case ZeroTag:
+            return 0;
+        case Char:
+            return readBigEndian<int8_t>(_pos);
+        case Short:
+            return readBigEndian<int16_t>(_pos);
+        case Int32:
+            return readBigEndian<int32_t>(_pos);
+        case Int64:
+            return readBigEndian<int64_t>(_pos);
+        default:
+            malformed("not an integer, type " + std::to_string(_type));
+        }
+    }
+
+    // read a (head, integer) pair, return the position after it
+    size_t readTaggedInt(size_t _pos, int64_t& _value) const
+    {
+        uint8_t tag = 0;
+        uint8_t type = 0;
+        _pos = readHead(_pos, tag, type);
+        _value = readInt(_pos, type);
+        return skip(_pos, type);
+    }
+
+    std::pair<size_t, size_t> stringRange(size_t _pos, uint8_t _type) const
+    {
+        size_t length = 0;
+        if (_type == String1)
+        {
+            length = readBigEndian<uint8_t>(_pos);
+            _pos += 1;
+        }
+        else if (_type == String4)
+        {
+            length = readBigEndian<uint32_t>(_pos);
+            _pos += 4;
+        }
+        else
+        {
+            malformed("not a string, type " + std::to_string(_type));
+        }
+        checkSize(_pos, length);
+        return {_pos, length};
+    }
+
+    bcos::bytesConstRef bytesOf(Field const& _field) const
+    {
+        checkType(_field.type, SimpleList);
+        uint8_t tag = 0;
+        uint8_t type = 0;
+        // the head of the byte element type
+        auto pos = readHead(_field.value, tag, type);
+        int64_t length = 0;
+        pos = readTaggedInt(pos, length);
+        if (length < 0)
+        {
+            malformed("negative length");
+        }
+        checkSize(pos, length);
+        return m_data.getCroppedData(pos, length);
+    }
+
+    TarsView structOf(Field const& _field) const
+    {
+        // the fields between StructBegin and StructEnd
+        return TarsView(m_owner, m_data.getCroppedData(_field.value, _field.end - _field.value));
+    }
+
+    template <class Handler>
+    void forEachElement(uint8_t _tag, Handler&& _handler) const
+    {
+        auto const* target = field(_tag);
+        if (!target)
+        {
+            return;
+        }
+        checkType(target->type, List);
+        int64_t size = 0;
+        auto pos = readTaggedInt(target->value, size);
+        for (int64_t i = 0; i < size; ++i)
+        {
+            Field element;
+            element.head = pos;
+            pos = readHead(pos, element.tag, element.type);
+            element.value = pos;
+            pos = skip(pos, element.type);
+            element.end = pos;
+            _handler(element);
+        }
+    }
+
+    // return the position after the value of type _type starting at _pos
+    size_t skip(size_t _pos, uint8_t _type) const
+    {
+        switch (_type)
+        {
+        case Char:
+            checkSize(_pos, 1);
+            return _pos + 1;
+        case Short:
+            checkSize(_pos, 2);
+            return _pos + 2;
+        case Int32:
+        case Float:
+            checkSize(_pos, 4);
+            return _pos + 4;
+        case Int64:
+        case Double:
+            checkSize(_pos, 8);
+            return _pos + 8;
+        case String1:
+        case String4:
+        {
+            auto [offset, length] = stringRange(_pos, _type);
+            return offset + length;
+        }
+        case Map:
+        case List:
+        {
+            int64_t size = 0;
+            _pos = readTaggedInt(_pos, size);
+            if (size < 0)
+            {
+                malformed("negative size");
+            }
+            auto elements = (_type == Map) ? size * 2 : size;
+            for (int64_t i = 0; i < elements; ++i)
+            {
+                uint8_t tag = 0;
+                uint8_t type = 0;
+                _pos = readHead(_pos, tag, type);
+                _pos = skip(_pos, type);
+            }
+            return _pos;
+        }
+        case StructBegin:
+        {
+            while (true)
+            {
+                uint8_t tag = 0;
+                uint8_t type = 0;
+                _pos = readHead(_pos, tag, type);
+                if (type == StructEnd)
+                {
+                    return _pos;
+                }
+                _pos = skip(_pos, type);
+            }
+        }
+        case StructEnd:
+        case ZeroTag:
+            return _pos;
+        case SimpleList:
+        {
+            uint8_t tag = 0;
+            uint8_t type = 0;
+            _pos = readHead(_pos, tag, type);
+            int64_t length = 0;
+            _pos = readTaggedInt(_pos, length);
+            if (length < 0)
+            {
+                malformed("negative length");
+            }
+            checkSize(_pos, length);
+            return _pos + length;
+        }
+        default:
+            malformed("unknown type " + std::to_string(_type));
+        }
+    }
+
+    std::shared_ptr<const bcos::bytes> m_owner;
+    bcos::bytesConstRef m_data;
+    std::vector<Field> m_fields;
+};
+}  // namespace bcostars::protocol::impl
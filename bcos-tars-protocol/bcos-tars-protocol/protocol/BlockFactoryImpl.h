@@ -55,9 +55,11 @@ public:
         auto block = std::make_shared<BlockImpl>();
         block->decode(_data, _calculateHash, _checkSig);
 
-        if (block->inner().blockHeader.dataHash.empty())
+        // access the header only, inner() would decode all the transactions and receipts
+        auto blockHeader = std::dynamic_pointer_cast<BlockHeaderImpl>(block->blockHeader());
+        if (blockHeader->inner().dataHash.empty())
         {
-            block->blockHeader()->calculateHash(*m_cryptoSuite->hashImpl());
+            blockHeader->calculateHash(*m_cryptoSuite->hashImpl());
         }
 
         return block;
@@ -30,11 +30,41 @@ using namespace bcostars::protocol;
 
 void BlockImpl::decode(bcos::bytesConstRef _data, bool, bool)
 {
-    bcos::concepts::serialize::decode(_data, *m_inner);
+    auto view = impl::TarsView::fromBuffer(_data);
+    *m_inner = bcostars::Block();
+    view.decodeTo(*m_inner, {4, 5});
+    m_transactionViews = view.getStructList(4);
+    m_receiptViews = view.getStructList(5);
+    m_lazy.store(true, std::memory_order_release);
+}
+
+void BlockImpl::materialize() const
+{
+    if (!lazy())
+    {
+        return;
+    }
+    std::unique_lock lock(x_materialize);
+    if (!lazy())
+    {
+        return;
+    }
+    m_inner->transactions.resize(m_transactionViews.size());
+    for (size_t i = 0; i < m_transactionViews.size(); ++i)
+    {
+        m_transactionViews[i].decodeTo(m_inner->transactions[i]);
+    }
+    m_inner->receipts.resize(m_receiptViews.size());
+    for (size_t i = 0; i < m_receiptViews.size(); ++i)
+    {
+        m_receiptViews[i].decodeTo(m_inner->receipts[i]);
+    }
+    m_lazy.store(false, std::memory_order_release);
 }
 
 void BlockImpl::encode(bcos::bytes& _encodeData) const
 {
+    materialize();
     bcos::concepts::serialize::encode(*m_inner, _encodeData);
 }
 
@@ -54,12 +84,26 @@ bcos::protocol::BlockHeader::ConstPtr BlockImpl::blockHeaderConst() const
 
 bcos::protocol::Transaction::ConstPtr BlockImpl::transaction(uint64_t _index) const
 {
+    if (lazy())
+    {
+        auto transaction = std::make_shared<bcostars::protocol::TransactionImpl>(
+            [inner = bcostars::Transaction()]() mutable { return &inner; });
+        transaction->decodeView(m_transactionViews[_index]);
+        return transaction;
+    }
     return std::make_shared<const bcostars::protocol::TransactionImpl>(
         [inner = m_inner, _index]() { return &(inner->transactions[_index]); });
 }
 
 bcos::protocol::TransactionReceipt::ConstPtr BlockImpl::receipt(uint64_t _index) const
 {
+    if (lazy())
+    {
+        auto receipt = std::make_shared<bcostars::protocol::TransactionReceiptImpl>(
+            [inner = bcostars::TransactionReceipt()]() mutable { return &inner; });
+        receipt->decodeView(m_receiptViews[_index]);
+        return receipt;
+    }
     return std::make_shared<const bcostars::protocol::TransactionReceiptImpl>(
         [inner = m_inner, _index]() { return &(inner->receipts[_index]); });
 }
@@ -76,6 +120,7 @@ void BlockImpl::setBlockHeader(bcos::protocol::BlockHeader::Ptr _blockHeader)
 
 void BlockImpl::setReceipt(uint64_t _index, bcos::protocol::TransactionReceipt::Ptr _receipt)
 {
+    materialize();
     if (_index >= m_inner->receipts.size())
     {
         m_inner->receipts.resize(m_inner->transactions.size());
@@ -87,6 +132,7 @@ void BlockImpl::setReceipt(uint64_t _index, bcos::protocol::TransactionReceipt::
 
 void BlockImpl::appendReceipt(bcos::protocol::TransactionReceipt::Ptr _receipt)
 {
+    materialize();
     m_inner->receipts.emplace_back(
         std::dynamic_pointer_cast<bcostars::protocol::TransactionReceiptImpl>(_receipt)->inner());
 }
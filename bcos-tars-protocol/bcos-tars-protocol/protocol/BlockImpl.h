@@ -21,6 +21,7 @@
 #pragma once
 
 #include "../impl/TarsHashable.h"
+#include "../impl/TarsView.h"
 
 #include "../Common.h"
 #include "BlockHeaderImpl.h"
@@ -39,7 +40,10 @@
 #include <bcos-framework/protocol/Block.h>
 #include <bcos-framework/protocol/BlockHeader.h>
 #include <gsl/span>
+#include <atomic>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <ranges>
 #include <type_traits>
 
@@ -52,6 +56,8 @@ public:
     BlockImpl(bcostars::Block _block) : BlockImpl() { *m_inner = std::move(_block); }
     ~BlockImpl() override = default;
 
+    // the transactions and the receipts are kept as views over a copy of _data, they are decoded
+    // one by one when accessed and all together on the first access to inner() or mutation
     void decode(bcos::bytesConstRef _data, bool _calculateHash, bool _checkSig) override;
     void encode(bcos::bytes& _encodeData) const override;
 
@@ -82,11 +88,13 @@ public:
 
     void setTransaction(uint64_t _index, bcos::protocol::Transaction::Ptr _transaction) override
     {
+        materialize();
         m_inner->transactions[_index] =
             std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(_transaction)->inner();
     }
     void appendTransaction(bcos::protocol::Transaction::Ptr _transaction) override
     {
+        materialize();
         m_inner->transactions.emplace_back(
             std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(_transaction)->inner());
     }
@@ -97,16 +105,30 @@ public:
     void appendTransactionMetaData(bcos::protocol::TransactionMetaData::Ptr _txMetaData) override;
 
     // get transactions size
-    uint64_t transactionsSize() const override { return m_inner->transactions.size(); }
+    uint64_t transactionsSize() const override
+    {
+        return lazy() ? m_transactionViews.size() : m_inner->transactions.size();
+    }
     uint64_t transactionsMetaDataSize() const override;
     // get receipts size
-    uint64_t receiptsSize() const override { return m_inner->receipts.size(); }
+    uint64_t receiptsSize() const override
+    {
+        return lazy() ? m_receiptViews.size() : m_inner->receipts.size();
+    }
 
     void setNonceList(RANGES::any_view<bcos::u256> nonces) override;
     RANGES::any_view<bcos::u256> nonceList() const override;
 
-    const bcostars::Block& inner() const { return *m_inner; }
-    void setInner(bcostars::Block inner) { *m_inner = std::move(inner); }
+    const bcostars::Block& inner() const
+    {
+        materialize();
+        return *m_inner;
+    }
+    void setInner(bcostars::Block inner)
+    {
+        *m_inner = std::move(inner);
+        m_lazy.store(false, std::memory_order_release);
+    }
 
     bcos::crypto::HashType calculateTransactionRoot(
         const bcos::crypto::Hash& hashImpl) const override
@@ -124,16 +146,19 @@ public:
                 using Hasher = std::remove_reference_t<decltype(hasher)>;
                 bcos::crypto::merkle::Merkle<Hasher> merkle;
 
-                if (transactionsSize() > 0)
+                auto viewHashes = lazy() ? dataHashes(m_transactionViews, Hasher::HASH_SIZE) :
+                                           std::vector<bcos::bytesConstRef>();
+                if (!viewHashes.empty())
                 {
-                    auto hashesRange =
-                        m_inner->transactions |
-                        RANGES::views::transform([](const bcostars::Transaction& transaction) {
-                            std::array<std::byte, Hasher::HASH_SIZE> hash;
-                            bcos::concepts::hash::calculate<Hasher>(transaction, hash);
-                            return hash;
-                        });
-                    merkle.generateMerkle(hashesRange, m_inner->transactionsMerkle);
+                    merkle.generateMerkle(viewHashes | RANGES::views::transform(toHash<Hasher>),
+                        m_inner->transactionsMerkle);
+                }
+                else if (transactionsSize() > 0)
+                {
+                    materialize();
+                    merkle.generateMerkle(
+                        bcos::concepts::hash::calculateBatch<Hasher>(m_inner->transactions),
+                        m_inner->transactionsMerkle);
                 }
                 else if (transactionsMetaDataSize() > 0)
                 {
@@ -165,15 +190,21 @@ public:
         std::visit(
             [this, &receiptsRoot](auto& hasher) {
                 using Hasher = std::remove_reference_t<decltype(hasher)>;
-                auto hashesRange =
-                    m_inner->receipts |
-                    RANGES::views::transform([](const bcostars::TransactionReceipt& receipt) {
-                        std::array<std::byte, Hasher::HASH_SIZE> hash;
-                        bcos::concepts::hash::calculate<Hasher>(receipt, hash);
-                        return hash;
-                    });
                 bcos::crypto::merkle::Merkle<Hasher> merkle;
-                merkle.generateMerkle(hashesRange, m_inner->receiptsMerkle);
+                auto viewHashes = lazy() ? dataHashes(m_receiptViews, Hasher::HASH_SIZE) :
+                                           std::vector<bcos::bytesConstRef>();
+                if (!viewHashes.empty())
+                {
+                    merkle.generateMerkle(viewHashes | RANGES::views::transform(toHash<Hasher>),
+                        m_inner->receiptsMerkle);
+                    bcos::concepts::bytebuffer::assignTo(
+                        *RANGES::rbegin(m_inner->receiptsMerkle), receiptsRoot);
+                    return;
+                }
+                materialize();
+                merkle.generateMerkle(
+                    bcos::concepts::hash::calculateBatch<Hasher>(m_inner->receipts),
+                    m_inner->receiptsMerkle);
                 bcos::concepts::bytebuffer::assignTo(
                     *RANGES::rbegin(m_inner->receiptsMerkle), receiptsRoot);
             },
@@ -183,7 +214,42 @@ public:
     }
 
 private:
+    bool lazy() const { return m_lazy.load(std::memory_order_acquire); }
+    // decode the transactions and the receipts from the views into the inner struct
+    void materialize() const;
+
+    // the dataHash of every view, empty if any of them has to be calculated
+    static std::vector<bcos::bytesConstRef> dataHashes(
+        std::vector<impl::TarsView> const& _views, size_t _hashSize)
+    {
+        std::vector<bcos::bytesConstRef> hashes;
+        hashes.reserve(_views.size());
+        for (auto const& view : _views)
+        {
+            auto hash = view.getBytes(2);
+            if (hash.size() != _hashSize)
+            {
+                return {};
+            }
+            hashes.emplace_back(hash);
+        }
+        return hashes;
+    }
+    template <class Hasher>
+    static std::array<std::byte, Hasher::HASH_SIZE> toHash(bcos::bytesConstRef _hash)
+    {
+        std::array<std::byte, Hasher::HASH_SIZE> hash;
+        std::memcpy(hash.data(), _hash.data(), hash.size());
+        return hash;
+    }
+
     std::shared_ptr<bcostars::Block> m_inner;
     mutable bcos::SharedMutex x_blockHeader;
+
+    // transactions (tag 4) and receipts (tag 5), valid while m_lazy is set
+    std::vector<impl::TarsView> m_transactionViews;
+    std::vector<impl::TarsView> m_receiptViews;
+    mutable std::atomic_bool m_lazy = {false};
+    mutable std::mutex x_materialize;
 };
 }  // namespace bcostars::protocol
\ No newline at end of file
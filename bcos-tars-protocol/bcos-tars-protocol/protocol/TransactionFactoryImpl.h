@@ -51,8 +51,12 @@ public:
 
         transaction->decode(txData);
 
-        auto originDataHash = std::move(transaction->mutableInner().dataHash);
-        transaction->mutableInner().dataHash.clear();
+        // only the meta fields are decoded, keep the data of the transaction as a view
+        auto& dataHash = transaction->m_inner()->dataHash;
+        auto originDataHash = std::move(dataHash);
+        dataHash.clear();
+        auto encodedDataOwner = transaction->m_encodedDataOwner;
+        auto encodedData = transaction->m_encodedData;
 
         auto anyHasher = m_cryptoSuite->hashImpl()->hasher();
         std::visit(
@@ -60,16 +64,19 @@ public:
                 transaction->calculateHash<std::remove_cvref_t<decltype(hasher)>>();
             },
             anyHasher);
+        // the encoded data is still valid if the hash carried is the same as the calculated one
+        if (originDataHash == dataHash)
+        {
+            transaction->m_encodedDataOwner = std::move(encodedDataOwner);
+            transaction->m_encodedData = encodedData;
+        }
 
         // check if hash matching
-        if (checkHash && !originDataHash.empty() &&
-            (originDataHash != transaction->mutableInner().dataHash)) [[unlikely]]
+        if (checkHash && !originDataHash.empty() && (originDataHash != dataHash)) [[unlikely]]
         {
             bcos::crypto::HashType originHashResult(
                 (bcos::byte*)originDataHash.data(), originDataHash.size());
-            bcos::crypto::HashType hashResult(
-                (bcos::byte*)transaction->mutableInner().dataHash.data(),
-                transaction->mutableInner().dataHash.size());
+            bcos::crypto::HashType hashResult((bcos::byte*)dataHash.data(), dataHash.size());
 
             BCOS_LOG(WARNING) << LOG_DESC("the transaction hash does not match")
                               << LOG_KV("originHash", originHashResult.hex())
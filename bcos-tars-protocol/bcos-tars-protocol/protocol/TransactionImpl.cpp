@@ -38,14 +38,69 @@ struct EmptyTransactionHash : public bcos::error::Exception
 
 void TransactionImpl::decode(bcos::bytesConstRef _txData)
 {
-    bcos::concepts::serialize::decode(_txData, *m_inner());
+    decodeView(impl::TarsView::fromBuffer(_txData));
+}
+
+void TransactionImpl::decodeView(impl::TarsView const& _view)
+{
+    auto* inner = m_inner();
+    *inner = bcostars::Transaction();
+    _view.decodeTo(*inner, {1, 3});
+    m_dataView = _view.getStruct(1);
+    m_signatureView = _view.getBytes(3);
+    {
+        std::unique_lock lock(x_encodedData);
+        m_encodedDataOwner = _view.owner();
+        m_encodedData = _view.encodedData();
+    }
+    m_lazy.store(true, std::memory_order_release);
+}
+
+void TransactionImpl::materialize() const
+{
+    if (!lazy())
+    {
+        return;
+    }
+    std::unique_lock lock(x_materialize);
+    if (!lazy())
+    {
+        return;
+    }
+    auto* inner = m_inner();
+    m_dataView.decodeTo(inner->data);
+    inner->signature.assign(m_signatureView.begin(), m_signatureView.end());
+    m_lazy.store(false, std::memory_order_release);
 }
 
 void TransactionImpl::encode(bcos::bytes& txData) const
 {
+    {
+        std::unique_lock lock(x_encodedData);
+        if (!m_encodedData.empty())
+        {
+            txData.assign(m_encodedData.begin(), m_encodedData.end());
+            return;
+        }
+    }
+    materialize();
     bcos::concepts::serialize::encode(*m_inner(), txData);
 }
 
+bcos::bytesConstRef TransactionImpl::encodedData() const
+{
+    std::unique_lock lock(x_encodedData);
+    if (m_encodedData.empty())
+    {
+        materialize();
+        auto encodedData = std::make_shared<bcos::bytes>();
+        bcos::concepts::serialize::encode(*m_inner(), *encodedData);
+        m_encodedData = bcos::ref(*encodedData);
+        m_encodedDataOwner = std::move(encodedData);
+    }
+    return m_encodedData;
+}
+
 bcos::crypto::HashType TransactionImpl::hash() const
 {
     if (m_inner()->dataHash.empty())
@@ -61,6 +116,15 @@ bcos::crypto::HashType TransactionImpl::hash() const
 
 bcos::u256 TransactionImpl::nonce() const
 {
+    if (lazy())
+    {
+        auto nonce = m_dataView.getString(5);
+        if (!nonce.empty())
+        {
+            m_nonce = boost::lexical_cast<bcos::u256>(std::string(nonce));
+        }
+        return m_nonce;
+    }
     if (!m_inner()->data.nonce.empty())
     {
         m_nonce = boost::lexical_cast<bcos::u256>(m_inner()->data.nonce);
@@ -70,6 +134,10 @@ bcos::u256 TransactionImpl::nonce() const
 
 bcos::bytesConstRef TransactionImpl::input() const
 {
+    if (lazy())
+    {
+        return m_dataView.getBytes(7);
+    }
     return bcos::bytesConstRef(reinterpret_cast<const bcos::byte*>(m_inner()->data.input.data()),
         m_inner()->data.input.size());
 }
\ No newline at end of file
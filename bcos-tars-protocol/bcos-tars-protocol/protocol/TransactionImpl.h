@@ -22,6 +22,7 @@
 #pragma once
 
 #include "../impl/TarsHashable.h"
+#include "../impl/TarsView.h"
 
 #include "bcos-concepts/Hash.h"
 #include "bcos-tars-protocol/tars/Transaction.h"
@@ -30,7 +31,9 @@
 #include <bcos-framework/protocol/Transaction.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/DataConvertUtility.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace bcostars::protocol
 {
@@ -47,29 +50,91 @@ public:
 
     bool operator==(const Transaction& rhs) const { return this->hash() == rhs.hash(); }
 
+    // decode the meta fields eagerly, the data and the signature are kept as views over a copy of
+    // _txData and decoded on the first access to inner()
     void decode(bcos::bytesConstRef _txData) override;
+    // decode from the view of a transaction encoded in a larger buffer (e.g. a block)
+    void decodeView(impl::TarsView const& _view);
     void encode(bcos::bytes& txData) const override;
+    bcos::bytesConstRef encodedData() const override;
 
     bcos::crypto::HashType hash() const override;
-    
+
     template <bcos::crypto::hasher::Hasher Hasher>
     void calculateHash()
     {
-        bcos::concepts::hash::calculate<Hasher>(*m_inner(), m_inner()->dataHash);
+        if (!lazy())
+        {
+            auto originDataHash = m_inner()->dataHash;
+            bcos::concepts::hash::calculate<Hasher>(*m_inner(), m_inner()->dataHash);
+            if (originDataHash != m_inner()->dataHash)
+            {
+                resetEncodedData();
+            }
+            return;
+        }
+        auto& dataHash = m_inner()->dataHash;
+        if (!dataHash.empty())
+        {
+            return;
+        }
+        resetEncodedData();
+        // the same fields in the same order as impl_calculate of bcostars::Transaction
+        Hasher hasher;
+        int32_t version = boost::endian::native_to_big((int32_t)m_dataView.getInt(1));
+        hasher.update(version);
+        hasher.update(impl::TarsView::toSpan(m_dataView.getString(2)));
+        hasher.update(impl::TarsView::toSpan(m_dataView.getString(3)));
+        int64_t blockLimit = boost::endian::native_to_big((int64_t)m_dataView.getInt(4));
+        hasher.update(blockLimit);
+        hasher.update(impl::TarsView::toSpan(m_dataView.getString(5)));
+        hasher.update(impl::TarsView::toSpan(m_dataView.getString(6)));
+        hasher.update(impl::TarsView::toSpan(m_dataView.getBytes(7)));
+        hasher.update(impl::TarsView::toSpan(m_dataView.getString(8)));
+        hasher.final(dataHash);
     }
 
-    int32_t version() const override { return m_inner()->data.version; }
-    std::string_view chainId() const override { return m_inner()->data.chainID; }
-    std::string_view groupId() const override { return m_inner()->data.groupID; }
-    int64_t blockLimit() const override { return m_inner()->data.blockLimit; }
+    int32_t version() const override
+    {
+        return lazy() ? (int32_t)m_dataView.getInt(1) : m_inner()->data.version;
+    }
+    std::string_view chainId() const override
+    {
+        return lazy() ? m_dataView.getString(2) : std::string_view(m_inner()->data.chainID);
+    }
+    std::string_view groupId() const override
+    {
+        return lazy() ? m_dataView.getString(3) : std::string_view(m_inner()->data.groupID);
+    }
+    int64_t blockLimit() const override
+    {
+        return lazy() ? m_dataView.getInt(4) : m_inner()->data.blockLimit;
+    }
     bcos::u256 nonce() const override;
-    std::string_view to() const override { return m_inner()->data.to; }
-    std::string_view abi() const override { return m_inner()->data.abi; }
+    std::string_view to() const override
+    {
+        return lazy() ? m_dataView.getString(6) : std::string_view(m_inner()->data.to);
+    }
+    std::string_view abi() const override
+    {
+        return lazy() ? m_dataView.getString(8) : std::string_view(m_inner()->data.abi);
+    }
     bcos::bytesConstRef input() const override;
     int64_t importTime() const override { return m_inner()->importTime; }
-    void setImportTime(int64_t _importTime) override { m_inner()->importTime = _importTime; }
+    void setImportTime(int64_t _importTime) override
+    {
+        if (m_inner()->importTime != _importTime)
+        {
+            m_inner()->importTime = _importTime;
+            resetEncodedData();
+        }
+    }
     bcos::bytesConstRef signatureData() const override
     {
+        if (lazy())
+        {
+            return m_signatureView;
+        }
         return {reinterpret_cast<const bcos::byte*>(m_inner()->signature.data()),
             m_inner()->signature.size()};
     }
@@ -79,26 +144,80 @@ public:
     }
     void forceSender(bcos::bytes _sender) const override
     {
+        // the sender of the transaction synced is the same as the recovered one
+        if (sender() == std::string_view((const char*)_sender.data(), _sender.size()))
+        {
+            return;
+        }
         m_inner()->sender.assign(_sender.begin(), _sender.end());
+        resetEncodedData();
     }
 
     void setSignatureData(bcos::bytes& signature)
     {
+        materialize();
         m_inner()->signature.assign(signature.begin(), signature.end());
+        resetEncodedData();
     }
 
     int32_t attribute() const override { return m_inner()->attribute; }
-    void setAttribute(int32_t attribute) override { m_inner()->attribute = attribute; }
+    void setAttribute(int32_t attribute) override
+    {
+        if (m_inner()->attribute != attribute)
+        {
+            m_inner()->attribute = attribute;
+            resetEncodedData();
+        }
+    }
 
     std::string_view extraData() const override { return m_inner()->extraData; }
-    void setExtraData(std::string const& _extraData) override { m_inner()->extraData = _extraData; }
+    void setExtraData(std::string const& _extraData) override
+    {
+        m_inner()->extraData = _extraData;
+        resetEncodedData();
+    }
 
-    const bcostars::Transaction& inner() const { return *m_inner(); }
-    bcostars::Transaction& mutableInner() { return *m_inner(); }
-    void setInner(bcostars::Transaction inner) { *m_inner() = std::move(inner); }
+    const bcostars::Transaction& inner() const
+    {
+        materialize();
+        return *m_inner();
+    }
+    bcostars::Transaction& mutableInner()
+    {
+        materialize();
+        resetEncodedData();
+        return *m_inner();
+    }
+    void setInner(bcostars::Transaction inner)
+    {
+        *m_inner() = std::move(inner);
+        m_lazy.store(false, std::memory_order_release);
+        resetEncodedData();
+    }
 
 private:
+    bool lazy() const { return m_lazy.load(std::memory_order_acquire); }
+    // decode the data and the signature from the views into the inner struct
+    void materialize() const;
+    void resetEncodedData() const
+    {
+        std::unique_lock lock(x_encodedData);
+        m_encodedDataOwner.reset();
+        m_encodedData = {};
+    }
+
     std::function<bcostars::Transaction*()> m_inner;
     mutable bcos::u256 m_nonce;
+
+    // TransactionData (tag 1) and signature (tag 3), valid while m_lazy is set
+    impl::TarsView m_dataView;
+    bcos::bytesConstRef m_signatureView;
+    mutable std::atomic_bool m_lazy = {false};
+    mutable std::mutex x_materialize;
+
+    // the encoded transaction, a view over the decoded buffer or the encoded copy
+    mutable std::shared_ptr<const bcos::bytes> m_encodedDataOwner;
+    mutable bcos::bytesConstRef m_encodedData;
+    mutable std::mutex x_encodedData;
 };
 }  // namespace bcostars::protocol
\ No newline at end of file
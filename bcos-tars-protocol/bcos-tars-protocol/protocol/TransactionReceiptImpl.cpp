@@ -34,14 +34,85 @@ struct EmptyReceiptHash : public bcos::error::Exception
 
 void TransactionReceiptImpl::decode(bcos::bytesConstRef _receiptData)
 {
-    bcos::concepts::serialize::decode(_receiptData, *m_inner());
+    decodeView(impl::TarsView::fromBuffer(_receiptData));
+}
+
+void TransactionReceiptImpl::decodeView(impl::TarsView const& _view)
+{
+    auto* inner = m_inner();
+    *inner = bcostars::TransactionReceipt();
+    _view.decodeTo(*inner, {1});
+    m_dataView = _view.getStruct(1);
+    m_logEntries.clear();
+    {
+        std::unique_lock lock(x_encodedData);
+        m_encodedDataOwner = _view.owner();
+        m_encodedData = _view.encodedData();
+    }
+    m_lazy.store(true, std::memory_order_release);
+}
+
+void TransactionReceiptImpl::materialize() const
+{
+    if (!lazy())
+    {
+        return;
+    }
+    std::unique_lock lock(x_materialize);
+    if (!lazy())
+    {
+        return;
+    }
+    m_dataView.decodeTo(m_inner()->data);
+    m_lazy.store(false, std::memory_order_release);
+}
+
+void TransactionReceiptImpl::logEntriesFromView() const
+{
+    auto logEntries = m_dataView.getStructList(6);
+    m_logEntries.reserve(logEntries.size());
+    for (auto const& logEntry : logEntries)
+    {
+        auto address = logEntry.getString(1);
+        std::vector<bcos::h256> topics;
+        for (auto const& topic : logEntry.getBytesList(2))
+        {
+            topics.emplace_back(topic.data(), topic.size());
+        }
+        auto data = logEntry.getBytes(3);
+        m_logEntries.emplace_back(bcos::bytes(address.begin(), address.end()), std::move(topics),
+            bcos::bytes(data.begin(), data.end()));
+    }
 }
 
 void TransactionReceiptImpl::encode(bcos::bytes& _encodedData) const
 {
+    {
+        std::unique_lock lock(x_encodedData);
+        if (!m_encodedData.empty())
+        {
+            _encodedData.assign(m_encodedData.begin(), m_encodedData.end());
+            return;
+        }
+    }
+    materialize();
     bcos::concepts::serialize::encode(*m_inner(), _encodedData);
 }
 
+bcos::bytesConstRef TransactionReceiptImpl::encodedData() const
+{
+    std::unique_lock lock(x_encodedData);
+    if (m_encodedData.empty())
+    {
+        materialize();
+        auto encodedData = std::make_shared<bcos::bytes>();
+        bcos::concepts::serialize::encode(*m_inner(), *encodedData);
+        m_encodedData = bcos::ref(*encodedData);
+        m_encodedDataOwner = std::move(encodedData);
+    }
+    return m_encodedData;
+}
+
 bcos::crypto::HashType TransactionReceiptImpl::hash() const
 {
     if (m_inner()->dataHash.empty())
@@ -57,6 +128,15 @@ bcos::crypto::HashType TransactionReceiptImpl::hash() const
 
 bcos::u256 TransactionReceiptImpl::gasUsed() const
 {
+    if (lazy())
+    {
+        auto gasUsed = m_dataView.getString(2);
+        if (!gasUsed.empty())
+        {
+            return boost::lexical_cast<bcos::u256>(std::string(gasUsed));
+        }
+        return {};
+    }
     if (!m_inner()->data.gasUsed.empty())
     {
         return boost::lexical_cast<bcos::u256>(m_inner()->data.gasUsed);
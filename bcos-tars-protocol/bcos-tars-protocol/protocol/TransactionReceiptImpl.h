@@ -22,6 +22,7 @@
 #pragma once
 
 #include "../Common.h"
+#include "../impl/TarsView.h"
 #include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-crypto/interfaces/crypto/Hash.h>
 #include <bcos-framework/protocol/Block.h>
@@ -31,6 +32,8 @@
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/FixedBytes.h>
+#include <atomic>
+#include <mutex>
 #include <utility>
 #include <variant>
 
@@ -44,45 +47,99 @@ public:
     {}
 
     ~TransactionReceiptImpl() override = default;
+    // decode the meta fields eagerly, the data is kept as a view over a copy of _receiptData and
+    // decoded on the first access to inner()
     void decode(bcos::bytesConstRef _receiptData) override;
+    // decode from the view of a receipt encoded in a larger buffer (e.g. a block)
+    void decodeView(impl::TarsView const& _view);
     void encode(bcos::bytes& _encodedData) const override;
+    bcos::bytesConstRef encodedData() const override;
     bcos::crypto::HashType hash() const override;
 
-    int32_t version() const override { return m_inner()->data.version; }
+    int32_t version() const override
+    {
+        return lazy() ? (int32_t)m_dataView.getInt(1) : m_inner()->data.version;
+    }
     bcos::u256 gasUsed() const override;
 
-    std::string_view contractAddress() const override { return m_inner()->data.contractAddress; }
-    int32_t status() const override { return m_inner()->data.status; }
+    std::string_view contractAddress() const override
+    {
+        return lazy() ? m_dataView.getString(3) :
+                        std::string_view(m_inner()->data.contractAddress);
+    }
+    int32_t status() const override
+    {
+        return lazy() ? (int32_t)m_dataView.getInt(4) : m_inner()->data.status;
+    }
     bcos::bytesConstRef output() const override
     {
+        if (lazy())
+        {
+            return m_dataView.getBytes(5);
+        }
         return {(const unsigned char*)m_inner()->data.output.data(), m_inner()->data.output.size()};
     }
     gsl::span<const bcos::protocol::LogEntry> logEntries() const override
     {
         if (m_logEntries.empty())
         {
-            m_logEntries.reserve(m_inner()->data.logEntries.size());
-            for (auto& it : m_inner()->data.logEntries)
+            if (lazy())
             {
-                auto bcosLogEntry = toBcosLogEntry(it);
-                m_logEntries.emplace_back(std::move(bcosLogEntry));
+                logEntriesFromView();
+            }
+            else
+            {
+                m_logEntries.reserve(m_inner()->data.logEntries.size());
+                for (auto& it : m_inner()->data.logEntries)
+                {
+                    auto bcosLogEntry = toBcosLogEntry(it);
+                    m_logEntries.emplace_back(std::move(bcosLogEntry));
+                }
             }
         }
 
         return {m_logEntries.data(), m_logEntries.size()};
     }
-    bcos::protocol::BlockNumber blockNumber() const override { return m_inner()->data.blockNumber; }
+    bcos::protocol::BlockNumber blockNumber() const override
+    {
+        return lazy() ? m_dataView.getInt(7) : m_inner()->data.blockNumber;
+    }
 
-    const bcostars::TransactionReceipt& inner() const { return *m_inner(); }
-    bcostars::TransactionReceipt& mutableInner() { return *m_inner(); }
+    const bcostars::TransactionReceipt& inner() const
+    {
+        materialize();
+        return *m_inner();
+    }
+    bcostars::TransactionReceipt& mutableInner()
+    {
+        materialize();
+        resetEncodedData();
+        return *m_inner();
+    }
 
-    void setInner(const bcostars::TransactionReceipt& inner) { *m_inner() = inner; }
-    void setInner(bcostars::TransactionReceipt&& inner) { *m_inner() = std::move(inner); }
+    void setInner(const bcostars::TransactionReceipt& inner)
+    {
+        *m_inner() = inner;
+        m_lazy.store(false, std::memory_order_release);
+        resetEncodedData();
+    }
+    void setInner(bcostars::TransactionReceipt&& inner)
+    {
+        *m_inner() = std::move(inner);
+        m_lazy.store(false, std::memory_order_release);
+        resetEncodedData();
+    }
 
-    std::function<bcostars::TransactionReceipt*()> const& innerGetter() { return m_inner; }
+    std::function<bcostars::TransactionReceipt*()> const& innerGetter()
+    {
+        materialize();
+        resetEncodedData();
+        return m_inner;
+    }
 
     void setLogEntries(std::vector<bcos::protocol::LogEntry> const& _logEntries)
     {
+        materialize();
         m_logEntries.clear();
         m_inner()->data.logEntries.clear();
         m_inner()->data.logEntries.reserve(_logEntries.size());
@@ -92,14 +149,40 @@ public:
             auto tarsLogEntry = toTarsLogEntry(it);
             m_inner()->data.logEntries.emplace_back(std::move(tarsLogEntry));
         }
+        resetEncodedData();
     }
 
     std::string const& message() const override { return m_inner()->message; }
 
-    void setMessage(std::string message) override { m_inner()->message = std::move(message); }
+    void setMessage(std::string message) override
+    {
+        m_inner()->message = std::move(message);
+        resetEncodedData();
+    }
 
 private:
+    bool lazy() const { return m_lazy.load(std::memory_order_acquire); }
+    // decode the data from the view into the inner struct
+    void materialize() const;
+    void logEntriesFromView() const;
+    void resetEncodedData() const
+    {
+        std::unique_lock lock(x_encodedData);
+        m_encodedDataOwner.reset();
+        m_encodedData = {};
+    }
+
     std::function<bcostars::TransactionReceipt*()> m_inner;
     mutable std::vector<bcos::protocol::LogEntry> m_logEntries;
+
+    // TransactionReceiptData (tag 1), valid while m_lazy is set
+    impl::TarsView m_dataView;
+    mutable std::atomic_bool m_lazy = {false};
+    mutable std::mutex x_materialize;
+
+    // the encoded receipt, a view over the decoded buffer or the encoded copy
+    mutable std::shared_ptr<const bcos::bytes> m_encodedDataOwner;
+    mutable bcos::bytesConstRef m_encodedData;
+    mutable std::mutex x_encodedData;
 };
 }  // namespace bcostars::protocol
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <bcos-concepts/Serialize.h>
 #include <bcos-crypto/hash/Keccak256.h>
 #include <bcos-crypto/hash/SM3.h>
 #include <bcos-crypto/interfaces/crypto/CommonType.h>
@@ -419,6 +420,144 @@ BOOST_AUTO_TEST_CASE(block)
     }
 }
 
+BOOST_AUTO_TEST_CASE(lazyDecode)
+{
+    std::string to("Target");
+    bcos::bytes input(bcos::asBytes("Arguments"));
+    bcos::bytes output(bcos::asBytes("Output!"));
+    std::vector<bcos::protocol::LogEntry> logEntries;
+    logEntries.emplace_back(bcos::asBytes("Address"),
+        bcos::h256s{bcos::h256(bcos::asBytes("topic"))}, bcos::asBytes("Data"));
+
+    auto block = blockFactory->createBlock();
+    block->blockHeader()->setNumber(100);
+    block->blockHeader()->calculateHash(*cryptoSuite->hashImpl());
+    for (size_t i = 0; i < 10; ++i)
+    {
+        block->appendTransaction(transactionFactory->createTransaction(0, to, input, i, i,
+            "testChain", "testGroup", 1000, cryptoSuite->signatureImpl()->generateKeyPair()));
+        block->appendReceipt(transactionReceiptFactory->createReceipt(
+            1000, "contract", logEntries, 0, bcos::ref(output), 100));
+    }
+    bcos::bytes buffer;
+    block->encode(buffer);
+
+    // the fields are read from the views before anything is materialized
+    auto decodedBlock = blockFactory->createBlock(bcos::ref(buffer));
+    BOOST_CHECK_EQUAL(decodedBlock->transactionsSize(), 10);
+    BOOST_CHECK_EQUAL(decodedBlock->receiptsSize(), 10);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto tx = decodedBlock->transaction(i);
+        auto originTx = block->transaction(i);
+        BOOST_CHECK_EQUAL(tx->hash(), originTx->hash());
+        BOOST_CHECK_EQUAL(tx->nonce(), i);
+        BOOST_CHECK_EQUAL(tx->blockLimit(), i);
+        BOOST_CHECK_EQUAL(tx->to(), to);
+        BOOST_CHECK_EQUAL(tx->chainId(), "testChain");
+        BOOST_CHECK_EQUAL(bcos::asString(tx->input()), bcos::asString(input));
+        BOOST_CHECK(tx->signatureData().toBytes() == originTx->signatureData().toBytes());
+
+        auto receipt = decodedBlock->receipt(i);
+        BOOST_CHECK_EQUAL(receipt->hash(), block->receipt(i)->hash());
+        BOOST_CHECK_EQUAL(receipt->gasUsed(), 1000);
+        BOOST_CHECK_EQUAL(receipt->contractAddress(), "contract");
+        BOOST_CHECK_EQUAL(receipt->blockNumber(), 100);
+        BOOST_CHECK_EQUAL(bcos::asString(receipt->output()), bcos::asString(output));
+        BOOST_REQUIRE_EQUAL(receipt->logEntries().size(), 1);
+        BOOST_CHECK_EQUAL(receipt->logEntries()[0].topics()[0], logEntries[0].topics()[0]);
+    }
+    BOOST_CHECK_EQUAL(decodedBlock->calculateTransactionRoot(*cryptoSuite->hashImpl()),
+        block->calculateTransactionRoot(*cryptoSuite->hashImpl()));
+    BOOST_CHECK_EQUAL(decodedBlock->calculateReceiptRoot(*cryptoSuite->hashImpl()),
+        block->calculateReceiptRoot(*cryptoSuite->hashImpl()));
+
+    // the hash and the signature of a single transaction are checked on the view
+    bcos::bytes txBuffer;
+    block->transaction(3)->encode(txBuffer);
+    auto tx = transactionFactory->createTransaction(bcos::ref(txBuffer), true, true);
+    BOOST_CHECK_EQUAL(tx->hash(), block->transaction(3)->hash());
+    BOOST_CHECK(!tx->sender().empty());
+
+    // mutation materializes the block, the encoded data is unchanged
+    decodedBlock->appendTransaction(
+        std::const_pointer_cast<bcos::protocol::Transaction>(decodedBlock->transaction(0)));
+    BOOST_CHECK_EQUAL(decodedBlock->transactionsSize(), 11);
+    auto reencodedBlock = blockFactory->createBlock(bcos::ref(buffer));
+    bcos::bytes reencoded;
+    reencodedBlock->encode(reencoded);
+    BOOST_CHECK(reencoded == buffer);
+}
+
+BOOST_AUTO_TEST_CASE(encodedDataCache)
+{
+    std::string to("Target");
+    bcos::bytes input(bcos::asBytes("Arguments"));
+    bcos::bytes output(bcos::asBytes("Output!"));
+    std::vector<bcos::protocol::LogEntry> logEntries;
+    logEntries.emplace_back(bcos::asBytes("Address"),
+        bcos::h256s{bcos::h256(bcos::asBytes("topic"))}, bcos::asBytes("Data"));
+
+    // the cached encoding is the same as a fresh one of the inner struct
+    auto checkEncodedData = [](auto const& object) {
+        bcos::bytes encoded;
+        bcos::concepts::serialize::encode(object.inner(), encoded);
+        BOOST_CHECK(object.encodedData().toBytes() == encoded);
+        bcos::bytes buffer;
+        object.encode(buffer);
+        BOOST_CHECK(buffer == encoded);
+    };
+
+    auto originTx = transactionFactory->createTransaction(0, to, input, 1, 100, "testChain",
+        "testGroup", 1000, cryptoSuite->signatureImpl()->generateKeyPair());
+    bcos::bytes txBuffer;
+    originTx->encode(txBuffer);
+    auto tx = std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(
+        transactionFactory->createTransaction(bcos::ref(txBuffer), false));
+    BOOST_REQUIRE(tx);
+    // a view over the decoded buffer
+    BOOST_CHECK(tx->encodedData().toBytes() == txBuffer);
+
+    tx->setImportTime(2000);
+    checkEncodedData(*tx);
+    tx->forceSender(bcos::asBytes("another sender"));
+    checkEncodedData(*tx);
+    tx->setAttribute(1);
+    checkEncodedData(*tx);
+    tx->setExtraData("extra data");
+    checkEncodedData(*tx);
+    tx->mutableInner().data.blockLimit = 200;
+    checkEncodedData(*tx);
+    auto inner = tx->inner();
+    inner.data.to = "another target";
+    tx->setInner(std::move(inner));
+    checkEncodedData(*tx);
+    BOOST_CHECK(tx->encodedData().toBytes() != txBuffer);
+
+    auto originReceipt = transactionReceiptFactory->createReceipt(
+        1000, "contract", logEntries, 0, bcos::ref(output), 100);
+    bcos::bytes receiptBuffer;
+    originReceipt->encode(receiptBuffer);
+    auto receipt = transactionReceiptFactory->createReceipt(bcos::ref(receiptBuffer));
+    BOOST_CHECK(receipt->encodedData().toBytes() == receiptBuffer);
+
+    receipt->setMessage("message");
+    checkEncodedData(*receipt);
+    logEntries.emplace_back(bcos::asBytes("Address2"), bcos::h256s{}, bcos::asBytes("Data2"));
+    receipt->setLogEntries(logEntries);
+    checkEncodedData(*receipt);
+    receipt->mutableInner().data.status = 1;
+    checkEncodedData(*receipt);
+    auto receiptInner = receipt->inner();
+    receiptInner.data.blockNumber = 200;
+    receipt->setInner(receiptInner);
+    checkEncodedData(*receipt);
+    receiptInner.data.gasUsed = "2000";
+    receipt->setInner(std::move(receiptInner));
+    checkEncodedData(*receipt);
+    BOOST_CHECK(receipt->encodedData().toBytes() != receiptBuffer);
+}
+
 BOOST_AUTO_TEST_CASE(blockHeader)
 {
     auto header = blockHeaderFactory->createBlockHeader();
@@ -504,10 +504,24 @@ void NodeConfig::loadTxPoolConfig(boost::property_tree::ptree const& _pt)
     m_txsExpirationTime = std::max(
         {txsExpirationTime * 1000, (int64_t)DEFAULT_MIN_CONSENSUS_TIME_MS, (int64_t)m_minSealTime});
 
+    // the memory of the pending txs, in MB, the txs exceeded are evicted by the priority
+    m_txpoolMemoryLimit = _pt.get<size_t>("txpool.memory_limit", 0) * 1024 * 1024;
+    // the evicted txs are spilled to the path and reloaded later, dropped if not set
+    m_txpoolSpillPath = _pt.get<std::string>("txpool.spill_path", "");
+    m_txpoolPriority = _pt.get<std::string>("txpool.priority", "import_time");
+    if (m_txpoolPriority != "import_time" && m_txpoolPriority != "sender")
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set txpool.priority to import_time or sender !"));
+    }
+
     NodeConfig_LOG(INFO) << LOG_DESC("loadTxPoolConfig") << LOG_KV("txpoolLimit", m_txpoolLimit)
                          << LOG_KV("notifierWorkers", m_notifyWorkerNum)
                          << LOG_KV("verifierWorkers", m_verifierWorkerNum)
-                         << LOG_KV("txsExpirationTime(ms)", m_txsExpirationTime);
+                         << LOG_KV("txsExpirationTime(ms)", m_txsExpirationTime)
+                         << LOG_KV("memoryLimit", m_txpoolMemoryLimit)
+                         << LOG_KV("spillPath", m_txpoolSpillPath)
+                         << LOG_KV("priority", m_txpoolPriority);
 }
 
 void NodeConfig::loadChainConfig(boost::property_tree::ptree const& _pt, bool _enforceGroupId)
@@ -571,7 +585,29 @@ void NodeConfig::loadSealerConfig(boost::property_tree::ptree const& _pt)
         BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
                                   "Please set consensus.min_seal_time between 1 and 600000!"));
     }
-    NodeConfig_LOG(INFO) << LOG_DESC("loadSealerConfig") << LOG_KV("minSealTime", m_minSealTime);
+    m_adaptiveSealing = _pt.get<bool>("consensus.adaptive_sealing", false);
+    // the default never conflicts with the min_seal_time of the existing configurations
+    auto targetBlockTime = checkAndGetValue(_pt, "consensus.target_block_time",
+        std::to_string(std::max<int64_t>(1000, m_minSealTime)));
+    if (m_adaptiveSealing &&
+        (targetBlockTime < (int64_t)m_minSealTime || targetBlockTime > DEFAULT_MAX_SEAL_TIME_MS))
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfig() << errinfo_comment("Please set consensus.target_block_time between "
+                                               "consensus.min_seal_time and 600000!"));
+    }
+    m_targetBlockTime = targetBlockTime;
+    auto minTxsPerBlock = checkAndGetValue(_pt, "consensus.min_txs_per_block", "100");
+    if (minTxsPerBlock <= 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set consensus.min_txs_per_block to positive!"));
+    }
+    m_minTxsPerBlock = minTxsPerBlock;
+    NodeConfig_LOG(INFO) << LOG_DESC("loadSealerConfig") << LOG_KV("minSealTime", m_minSealTime)
+                         << LOG_KV("adaptiveSealing", m_adaptiveSealing)
+                         << LOG_KV("targetBlockTime", m_targetBlockTime)
+                         << LOG_KV("minTxsPerBlock", m_minTxsPerBlock);
 }
 
 void NodeConfig::loadStorageSecurityConfig(boost::property_tree::ptree const& _pt)
@@ -609,8 +645,17 @@ void NodeConfig::loadStorageSecurityConfig(boost::property_tree::ptree const& _p
         BOOST_THROW_EXCEPTION(
             InvalidConfig() << errinfo_comment("Please provide cipher_data_key!"));
     }
+    // value: encrypt every value, block: encrypt the files of rocksdb
+    auto level = _pt.get<std::string>("storage_security.level", "value");
+    if (level != "value" && level != "block")
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "storage_security.level should be value or block!"));
+    }
+    m_storageSecurityBlockLevel = (level == "block");
     NodeConfig_LOG(INFO) << LOG_DESC("loadStorageSecurityConfig")
-                         << LOG_KV("keyCenterUrl", storageSecurityKeyCenterUrl);
+                         << LOG_KV("keyCenterUrl", storageSecurityKeyCenterUrl)
+                         << LOG_KV("level", level);
 }
 
 void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
@@ -637,13 +682,19 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
     boost::split(m_pd_addrs, pd_addrs, boost::is_any_of(","));
     m_enableLRUCacheStorage = _pt.get<bool>("storage.enable_cache", true);
     m_cacheSize = _pt.get<ssize_t>("storage.cache_size", DEFAULT_CACHE_SIZE);
+    m_enableGroupCommit = _pt.get<bool>("storage.enable_group_commit", false);
+    m_enablePipelinedWrite = _pt.get<bool>("storage.enable_pipelined_write", false);
+    m_ledgerCacheSize = _pt.get<ssize_t>("storage.ledger_cache_size", DEFAULT_LEDGER_CACHE_SIZE);
     NodeConfig_LOG(INFO) << LOG_DESC("loadStorageConfig") << LOG_KV("storagePath", m_storagePath)
                          << LOG_KV("KeyPage", m_keyPageSize) << LOG_KV("storageType", m_storageType)
                          << LOG_KV("pdAddrs", pd_addrs) << LOG_KV("pdCaPath", m_pdCaPath)
                          << LOG_KV("enableArchive", m_enableArchive)
                          << LOG_KV("archiveListenIP", m_archiveListenIP)
                          << LOG_KV("archiveListenPort", m_archiveListenPort)
-                         << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage);
+                         << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage)
+                         << LOG_KV("enableGroupCommit", m_enableGroupCommit)
+                         << LOG_KV("enablePipelinedWrite", m_enablePipelinedWrite)
+                         << LOG_KV("ledgerCacheSize", m_ledgerCacheSize);
 }
 
 // Note: In components that do not require failover, do not need to set member_id
@@ -682,10 +733,26 @@ void NodeConfig::loadOthersConfig(boost::property_tree::ptree const& _pt)
 {
     m_sendTxTimeout = _pt.get<int>("others.send_tx_timeout", -1);
     m_vmCacheSize = _pt.get<int>("executor.vm_cache_size", 1024);
+    // the threads shared by the sealer/consensus/sync workers, 0 means one thread per worker
+    m_workerReactorThreads = _pt.get<size_t>("others.worker_reactor_threads", 2);
+    // the ThreadPools and workers of the node share the threads of the runtime when enabled
+    m_enableNodeRuntime = _pt.get<bool>("runtime.enable", false);
+    m_runtimeWorkerThreads =
+        _pt.get<size_t>("runtime.worker_threads", std::thread::hardware_concurrency());
+    m_runtimeIOThreads = _pt.get<size_t>("runtime.io_threads", 2);
+    m_runtimePinThreads = _pt.get<bool>("runtime.pin_threads", true);
+    // in ms, 0 means never report the cpu usage of the groups
+    m_runtimeReportInterval = _pt.get<uint64_t>("runtime.report_interval", 60000);
 
     NodeConfig_LOG(INFO) << LOG_DESC("loadOthersConfig")
                          << LOG_KV("sendTxTimeout", m_sendTxTimeout)
-                         << LOG_KV("vmCacheSize", m_vmCacheSize);
+                         << LOG_KV("vmCacheSize", m_vmCacheSize)
+                         << LOG_KV("workerReactorThreads", m_workerReactorThreads)
+                         << LOG_KV("enableNodeRuntime", m_enableNodeRuntime)
+                         << LOG_KV("runtimeWorkerThreads", m_runtimeWorkerThreads)
+                         << LOG_KV("runtimeIOThreads", m_runtimeIOThreads)
+                         << LOG_KV("runtimePinThreads", m_runtimePinThreads)
+                         << LOG_KV("runtimeReportInterval", m_runtimeReportInterval);
 }
 
 void NodeConfig::loadConsensusConfig(boost::property_tree::ptree const& _pt)
@@ -698,8 +765,20 @@ void NodeConfig::loadConsensusConfig(boost::property_tree::ptree const& _pt)
                                   "Please set consensus.checkpoint_timeout to no less than " +
                                   std::to_string(DEFAULT_MIN_CONSENSUS_TIME_MS) + "ms!"));
     }
+    // all the consensus nodes should support the chunks of the pre-prepare message
+    m_proposalDissemination = _pt.get<bool>("consensus.proposal_dissemination", false);
+    // all the consensus nodes should send the votes to the leader and handle the QCs
+    m_voteCollection = _pt.get<bool>("consensus.vote_collection", false);
+    // persist the committed proposals into the segment files under storage.data_path
+    m_enableConsensusWAL = _pt.get<bool>("consensus.enable_wal", false);
+    // execute the pre-prepared proposal before it committed
+    m_preExecuteProposal = _pt.get<bool>("consensus.pre_execute_proposal", false);
     NodeConfig_LOG(INFO) << LOG_DESC("loadConsensusConfig")
-                         << LOG_KV("checkPointTimeoutInterval", m_checkPointTimeoutInterval);
+                         << LOG_KV("checkPointTimeoutInterval", m_checkPointTimeoutInterval)
+                         << LOG_KV("proposalDissemination", m_proposalDissemination)
+                         << LOG_KV("voteCollection", m_voteCollection)
+                         << LOG_KV("enableConsensusWAL", m_enableConsensusWAL)
+                         << LOG_KV("preExecuteProposal", m_preExecuteProposal);
 }
 
 void NodeConfig::loadLedgerConfig(boost::property_tree::ptree const& _genesisConfig)
@@ -39,6 +39,7 @@ class NodeConfig
 {
 public:
     constexpr static ssize_t DEFAULT_CACHE_SIZE = 32 * 1024 * 1024;
+    constexpr static ssize_t DEFAULT_LEDGER_CACHE_SIZE = 64 * 1024 * 1024;
     constexpr static ssize_t DEFAULT_MIN_CONSENSUS_TIME_MS = 3000;
     constexpr static ssize_t DEFAULT_MIN_LEASE_TTL_SECONDS = 3;
     constexpr static ssize_t DEFAULT_MAX_SEAL_TIME_MS = 600000;
@@ -102,6 +103,9 @@ public:
     size_t notifyWorkerNum() const { return m_notifyWorkerNum; }
     size_t verifierWorkerNum() const { return m_verifierWorkerNum; }
     int64_t txsExpirationTime() const { return m_txsExpirationTime; }
+    size_t txpoolMemoryLimit() const { return m_txpoolMemoryLimit; }
+    std::string const& txpoolSpillPath() const { return m_txpoolSpillPath; }
+    std::string const& txpoolPriority() const { return m_txpoolPriority; }
 
     bool smCryptoType() const { return m_smCryptoType; }
     std::string const& chainId() const { return m_chainId; }
@@ -115,7 +119,14 @@ public:
     std::string const& password() const { return m_password; }
 
     size_t minSealTime() const { return m_minSealTime; }
+    bool adaptiveSealing() const { return m_adaptiveSealing; }
+    size_t targetBlockTime() const { return m_targetBlockTime; }
+    size_t minTxsPerBlock() const { return m_minTxsPerBlock; }
     size_t checkPointTimeoutInterval() const { return m_checkPointTimeoutInterval; }
+    bool proposalDissemination() const { return m_proposalDissemination; }
+    bool voteCollection() const { return m_voteCollection; }
+    bool enableConsensusWAL() const { return m_enableConsensusWAL; }
+    bool preExecuteProposal() const { return m_preExecuteProposal; }
 
     std::string const& storagePath() const { return m_storagePath; }
     std::string const& storageType() const { return m_storageType; }
@@ -142,6 +153,12 @@ public:
     bool isAuthCheck() const { return m_isAuthCheck; }
     bool isSerialExecute() const { return m_isSerialExecute; }
     size_t vmCacheSize() const { return m_vmCacheSize; }
+    size_t workerReactorThreads() const { return m_workerReactorThreads; }
+    bool enableNodeRuntime() const { return m_enableNodeRuntime; }
+    size_t runtimeWorkerThreads() const { return m_runtimeWorkerThreads; }
+    size_t runtimeIOThreads() const { return m_runtimeIOThreads; }
+    bool runtimePinThreads() const { return m_runtimePinThreads; }
+    uint64_t runtimeReportInterval() const { return m_runtimeReportInterval; }
 
     std::string const& authAdminAddress() const { return m_authAdminAddress; }
 
@@ -203,6 +220,9 @@ public:
 
     bool enableLRUCacheStorage() const { return m_enableLRUCacheStorage; }
     ssize_t cacheSize() const { return m_cacheSize; }
+    bool enableGroupCommit() const { return m_enableGroupCommit; }
+    bool enablePipelinedWrite() const { return m_enablePipelinedWrite; }
+    ssize_t ledgerCacheSize() const { return m_ledgerCacheSize; }
 
     uint32_t compatibilityVersion() const { return m_compatibilityVersion; }
     std::string const& compatibilityVersionStr() const { return m_compatibilityVersionStr; }
@@ -216,6 +236,8 @@ public:
     std::string storageSecurityKeyCenterIp() const { return m_storageSecurityKeyCenterIp; }
     unsigned short storageSecurityKeyCenterPort() const { return m_storageSecurityKeyCenterPort; }
     std::string storageSecurityCipherDataKey() const { return m_storageSecurityCipherDataKey; }
+    // encrypt the files of rocksdb by blocks instead of every value
+    bool storageSecurityBlockLevel() const { return m_storageSecurityBlockLevel; }
 
     int sendTxTimeout() const { return m_sendTxTimeout; }
 
@@ -270,6 +292,10 @@ private:
     size_t m_notifyWorkerNum;
     size_t m_verifierWorkerNum;
     int64_t m_txsExpirationTime;
+    // the bytes of the pending txs kept in memory, 0 means unlimited
+    size_t m_txpoolMemoryLimit = 0;
+    std::string m_txpoolSpillPath;
+    std::string m_txpoolPriority;
     // TODO: the block sync module need some configurations?
 
     // chain configuration
@@ -280,7 +306,14 @@ private:
 
     // sealer configuration
     size_t m_minSealTime = 0;
+    bool m_adaptiveSealing = false;
+    size_t m_targetBlockTime = 1000;
+    size_t m_minTxsPerBlock = 100;
     size_t m_checkPointTimeoutInterval;
+    bool m_proposalDissemination = false;
+    bool m_voteCollection = false;
+    bool m_enableConsensusWAL = false;
+    bool m_preExecuteProposal = false;
 
     // for security
     std::string m_privateKeyPath;
@@ -294,6 +327,7 @@ private:
     std::string m_storageSecurityKeyCenterIp;
     unsigned short m_storageSecurityKeyCenterPort;
     std::string m_storageSecurityCipherDataKey;
+    bool m_storageSecurityBlockLevel = false;
 
     // ledger configuration
     std::string m_consensusType;
@@ -321,6 +355,13 @@ private:
     bool m_isAuthCheck = false;
     bool m_isSerialExecute = false;
     size_t m_vmCacheSize = 1024;
+    size_t m_workerReactorThreads = 2;
+    // the node-wide runtime shared by the modules of all groups
+    bool m_enableNodeRuntime = false;
+    size_t m_runtimeWorkerThreads = 0;
+    size_t m_runtimeIOThreads = 2;
+    bool m_runtimePinThreads = true;
+    uint64_t m_runtimeReportInterval = 60000;
     std::string m_authAdminAddress;
 
     // Pro and Max versions run do not apply to tars admin site
@@ -367,6 +408,10 @@ private:
 
     bool m_enableLRUCacheStorage = true;
     ssize_t m_cacheSize = DEFAULT_CACHE_SIZE;  // 32MB for default
+    bool m_enableGroupCommit = false;
+    bool m_enablePipelinedWrite = false;
+    // the ledger cache of the latest blocks is disabled if not positive
+    ssize_t m_ledgerCacheSize = DEFAULT_LEDGER_CACHE_SIZE;
     uint32_t m_compatibilityVersion;
     std::string m_compatibilityVersionStr;
 
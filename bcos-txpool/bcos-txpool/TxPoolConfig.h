@@ -22,6 +22,7 @@
 #pragma once
 #include "txpool/interfaces/NonceCheckerInterface.h"
 #include "txpool/interfaces/TxPoolStorageInterface.h"
+#include "txpool/interfaces/TxPriorityInterface.h"
 #include "txpool/interfaces/TxValidatorInterface.h"
 #include <bcos-framework/ledger/LedgerInterface.h>
 #include <bcos-framework/protocol/BlockFactory.h>
@@ -52,6 +53,18 @@ public:
     virtual void setPoolLimit(size_t _poolLimit) { m_poolLimit = _poolLimit; }
     virtual size_t poolLimit() const { return m_poolLimit; }
 
+    // the bytes of the pending txs kept in memory, 0 means unlimited
+    void setMemoryLimit(size_t _memoryLimit) { m_memoryLimit = _memoryLimit; }
+    size_t memoryLimit() const { return m_memoryLimit; }
+    // the directory to spill the txs evicted, the evicted txs are dropped if empty
+    void setSpillPath(std::string _spillPath) { m_spillPath = std::move(_spillPath); }
+    std::string const& spillPath() const { return m_spillPath; }
+    void setTxPriority(TxPriorityInterface::Ptr _txPriority)
+    {
+        m_txPriority = std::move(_txPriority);
+    }
+    TxPriorityInterface::Ptr txPriority() const { return m_txPriority; }
+
     NonceCheckerInterface::Ptr txPoolNonceChecker() { return m_txPoolNonceChecker; }
 
     TxValidatorInterface::Ptr txValidator() { return m_txValidator; }
@@ -80,6 +93,9 @@ private:
     std::shared_ptr<bcos::ledger::LedgerInterface> m_ledger;
     NonceCheckerInterface::Ptr m_txPoolNonceChecker;
     size_t m_poolLimit = 15000;
+    size_t m_memoryLimit = 0;
+    std::string m_spillPath;
+    TxPriorityInterface::Ptr m_txPriority;
     int64_t m_blockLimit = 1000;
 };
 }  // namespace txpool
@@ -55,7 +55,6 @@ void TransactionSync::stop()
     {
         m_txsRequester->stop();
     }
-    finishWorker();
     stopWorking();
     terminate();
     SYNC_LOG(DEBUG) << LOG_DESC("stop SyncTransaction");
@@ -73,8 +72,7 @@ void TransactionSync::executeWorker()
     }
     if (!m_config->existsInGroup() || (!m_newTransactions && downloadTxsBufferEmpty()))
     {
-        boost::unique_lock<boost::mutex> l(x_signalled);
-        m_signalled.wait_for(l, boost::chrono::milliseconds(10));
+        waitWorkerSignal(10);
     }
 }
 
@@ -101,7 +99,7 @@ void TransactionSync::onRecvSyncMessage(
         {
             txsSyncMsg->setFrom(_nodeID);
             appendDownloadTxsBuffer(txsSyncMsg);
-            m_signalled.notify_all();
+            notifyWorker();
             return;
         }
         // receive txs request, and response the transactions
@@ -135,7 +135,7 @@ protected:
     void noteNewTransactions()
     {
         m_newTransactions = true;
-        m_signalled.notify_all();
+        notifyWorker();
     }
 
 private:
@@ -151,10 +151,6 @@ private:
 
     std::atomic_bool m_newTransactions = {false};
 
-    // signal to notify all thread to work
-    boost::condition_variable m_signalled;
-    // mutex to access m_signalled
-    boost::mutex x_signalled;
 
     bcos::crypto::Hash::Ptr m_hashImpl;
     bcos::crypto::SignatureCrypto::Ptr m_signatureImpl;
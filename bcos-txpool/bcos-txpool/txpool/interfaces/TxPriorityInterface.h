@@ -0,0 +1,41 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Interface to rank the pending transactions to be evicted when the txpool is full
+ * @file TxPriorityInterface.h
+ * @date 2022-12-26
+ */
+#pragma once
+#include <bcos-framework/protocol/Transaction.h>
+
+namespace bcos
+{
+namespace txpool
+{
+class TxPriorityInterface
+{
+public:
+    using Ptr = std::shared_ptr<TxPriorityInterface>;
+    TxPriorityInterface() = default;
+    virtual ~TxPriorityInterface() {}
+
+    // the rank of the tx inserted into the txpool, the txs of the highest rank are evicted first,
+    // and the txs of the same rank are evicted from the latest inserted
+    virtual int64_t onInserted(bcos::protocol::Transaction const& _tx) = 0;
+    virtual void onRemoved(bcos::protocol::Transaction const& _tx) = 0;
+    virtual void clear() = 0;
+};
+}  // namespace txpool
+}  // namespace bcos
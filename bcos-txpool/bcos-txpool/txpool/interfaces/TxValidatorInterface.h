@@ -34,6 +34,13 @@ public:
     virtual ~TxValidatorInterface() {}
 
     virtual bcos::protocol::TransactionStatus verify(bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    // verify without recording the nonce of the tx, safe to be called concurrently for the txs of
+    // a batch; the nonce should be recorded by acceptNonce later
+    virtual bcos::protocol::TransactionStatus verifyWithoutNonceUpdate(
+        bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    // record the nonce of a verified tx, fail if the nonce has been recorded by another tx
+    virtual bcos::protocol::TransactionStatus acceptNonce(
+        bcos::protocol::Transaction::ConstPtr _tx) = 0;
     virtual bcos::protocol::TransactionStatus submittedToChain(
         bcos::protocol::Transaction::ConstPtr _tx) = 0;
     virtual NonceCheckerInterface::Ptr ledgerNonceChecker() { return m_ledgerNonceChecker; }
@@ -19,14 +19,18 @@
  * @date 2021-05-07
  */
 #include "bcos-txpool/txpool/storage/MemoryStorage.h"
+#include "bcos-txpool/txpool/storage/TxPriority.h"
 #include "bcos-utilities/Common.h"
+#include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
 #include <tbb/pipeline.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <memory>
 #include <tuple>
+#include <unordered_set>
 #include <variant>
 
 using namespace bcos;
@@ -42,6 +46,7 @@ MemoryStorage::MemoryStorage(
     // Trigger a transaction cleanup operation every 3s
     m_cleanUpTimer = std::make_shared<Timer>(3000, "txpoolTimer");
     m_cleanUpTimer->registerTimeoutHandler([this] { cleanUpExpiredTransactions(); });
+    m_admissionWorker = std::make_shared<ThreadPool>("txsAdmission", 1);
     TXPOOL_LOG(INFO) << LOG_DESC("init MemoryStorage of txpool")
                      << LOG_KV("txNotifierWorkerNum", _notifyWorkerNum)
                      << LOG_KV("txsExpirationTime", m_txsExpirationTime);
@@ -49,6 +54,23 @@ MemoryStorage::MemoryStorage(
 
 void MemoryStorage::start()
 {
+    m_memoryLimit = m_config->memoryLimit();
+    m_txPriority = m_config->txPriority();
+    if (m_memoryLimit > 0)
+    {
+        if (!m_txPriority)
+        {
+            m_txPriority = std::make_shared<ImportTimePriority>();
+        }
+        if (!m_config->spillPath().empty())
+        {
+            m_spillQueue = std::make_shared<TxSpillQueue>(m_config->spillPath());
+            m_spillQueue->open();
+        }
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("start MemoryStorage of txpool")
+                     << LOG_KV("memoryLimit", m_memoryLimit)
+                     << LOG_KV("spillPath", m_config->spillPath());
     if (m_cleanUpTimer)
     {
         m_cleanUpTimer->start();
@@ -61,6 +83,12 @@ void MemoryStorage::stop()
     {
         m_cleanUpTimer->stop();
     }
+    if (m_admissionWorker)
+    {
+        m_admissionWorker->stop();
+    }
+    // the txs queued before the worker stopped
+    admitPendingTxs();
 }
 
 task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransaction(
@@ -74,8 +102,8 @@ task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransact
         {
             try
             {
-                auto result = m_self->verifyAndSubmitTransaction(
-                    std::move(m_transaction),
+                // the callback is called with the error if the tx is rejected by the admission
+                m_self->submitToAdmission(std::move(m_transaction),
                     [this, m_handle = handle](Error::Ptr error,
                         bcos::protocol::TransactionSubmitResult::Ptr result) mutable {
                         if (error)
@@ -91,16 +119,7 @@ task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransact
                         {
                             m_handle.resume();
                         }
-                    },
-                    true, true);
-
-                if (result != TransactionStatus::None)
-                {
-                    TXPOOL_LOG(DEBUG) << "Submit transaction error! " << result;
-                    m_submitResult.emplace<Error::Ptr>(
-                        BCOS_ERROR_PTR((int32_t)result, bcos::protocol::toString(result)));
-                    handle.resume();
-                }
+                    });
             }
             catch (std::exception& e)
             {
@@ -140,6 +159,14 @@ TransactionStatus MemoryStorage::txpoolStorageCheck(const Transaction& transacti
     {
         return TransactionStatus::AlreadyInTxPool;
     }
+    if (m_spillQueue)
+    {
+        Guard l(x_spilledTxs);
+        if (m_spilledTxs.count(txHash))
+        {
+            return TransactionStatus::AlreadyInTxPool;
+        }
+    }
     return TransactionStatus::None;
 }
 
@@ -176,6 +203,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
             {
                 m_sealedTxsSize++;
                 tx->setSealed(true);
+                onTxSealed(*tx, true);
             }
             tx->setBatchId(_tx->batchId());
             tx->setBatchHash(_tx->batchHash());
@@ -208,6 +236,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
         if (!tx->sealed())
         {
             tx->setSealed(true);
+            onTxSealed(*tx, true);
             m_sealedTxsSize++;
         }
     }
@@ -215,30 +244,83 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
     {
         // avoid the sealed txs be sealed again
         _tx->setSealed(true);
+        onTxSealed(*_tx, true);
         m_sealedTxsSize++;
     }
     return TransactionStatus::None;
 }
 
-TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
-    Transaction::Ptr transaction, TxSubmitCallback txSubmitCallback, bool checkPoolLimit, bool lock)
+void MemoryStorage::submitToAdmission(Transaction::Ptr _tx, TxSubmitCallback _callback)
 {
-    size_t txsSize = 0;
     {
-        std::optional<ReadGuard> lockMutex;
-        if (lock)
+        Guard l(x_pendingSubmits);
+        m_pendingSubmits.emplace_back(PendingSubmit{std::move(_tx), std::move(_callback)});
+        // the running admission will take the tx in its next batch
+        if (m_admitting)
+        {
+            return;
+        }
+        m_admitting = true;
+    }
+    if (m_admissionWorker->hasStopped())
+    {
+        admitPendingTxs();
+        return;
+    }
+    auto self = weak_from_this();
+    m_admissionWorker->enqueue([self]() {
+        auto storage = self.lock();
+        if (storage)
         {
-            lockMutex.emplace(x_txpoolMutex);
+            storage->admitPendingTxs();
         }
-        txsSize = m_txsTable.size();
+    });
+}
 
-        auto result = txpoolStorageCheck(*transaction);
-        if (result != TransactionStatus::None)
+void MemoryStorage::admitPendingTxs()
+{
+    while (true)
+    {
+        // the txs submitted while the last batch was being admitted form the next batch
+        std::vector<PendingSubmit> batch;
         {
-            return result;
+            Guard l(x_pendingSubmits);
+            if (m_pendingSubmits.empty())
+            {
+                m_admitting = false;
+                return;
+            }
+            batch.swap(m_pendingSubmits);
+        }
+        auto results = batchVerifyAndSubmit(batch, true);
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            auto result = results[i];
+            if (result == TransactionStatus::None || !batch[i].callback)
+            {
+                continue;
+            }
+            TXPOOL_LOG(DEBUG) << "Submit transaction error! " << result;
+            try
+            {
+                batch[i].callback(
+                    BCOS_ERROR_PTR((int32_t)result, bcos::protocol::toString(result)), nullptr);
+            }
+            catch (std::exception const& e)
+            {
+                TXPOOL_LOG(WARNING) << LOG_DESC("admitPendingTxs: notify rejected tx failed")
+                                    << LOG_KV("errorInfo", boost::diagnostic_information(e));
+            }
         }
     }
+}
 
+std::vector<TransactionStatus> MemoryStorage::batchVerifyAndSubmit(
+    std::vector<PendingSubmit>& _txs, bool _checkPoolLimit)
+{
+    auto recordT = utcTime();
+    std::vector<TransactionStatus> results(_txs.size(), TransactionStatus::None);
+    auto txsSize = m_txsTable.size();
     // start stat the tps when receive first new tx from the sdk
     if (m_tpsStatstartTime == 0 && txsSize == 0)
     {
@@ -246,30 +328,100 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     }
     // Note: In order to ensure that transactions can reach all nodes, transactions from P2P are not
     // restricted
-    if (checkPoolLimit && txsSize >= m_config->poolLimit())
+    // the spilled txs are still pending, count them in the pool limit
+    auto poolLimit = m_config->poolLimit();
+    auto spilledTxs = spilledTxsSize();
+    if (_checkPoolLimit && txsSize + spilledTxs >= poolLimit)
     {
-        return TransactionStatus::TxPoolIsFull;
+        std::fill(results.begin(), results.end(), TransactionStatus::TxPoolIsFull);
+        return results;
     }
 
-    // verify the transaction
-    auto result = m_config->txValidator()->verify(transaction);
-    if (result == TransactionStatus::None)
     {
-        if (txSubmitCallback)
-        {
-            transaction->setSubmitCallback(std::move(txSubmitCallback));
-        }
-        if (lock)
+        // the same tx may be submitted more than once in a batch
+        std::unordered_set<HashType, std::hash<HashType>> batchTxs;
+        ReadGuard l(x_txpoolMutex);
+        for (size_t i = 0; i < _txs.size(); ++i)
         {
-            result = insert(std::move(transaction));
+            auto const& tx = _txs[i].transaction;
+            if (!tx)
+            {
+                results[i] = TransactionStatus::Malform;
+                continue;
+            }
+            results[i] = txpoolStorageCheck(*tx);
+            if (results[i] == TransactionStatus::None && !batchTxs.insert(tx->hash()).second)
+            {
+                results[i] = TransactionStatus::AlreadyInTxPool;
+            }
         }
-        else
+    }
+    // the signature recovery of the txs are independent, verify them without the lock
+    auto txValidator = m_config->txValidator();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _txs.size()),
+        [&_txs, &results, &txValidator](tbb::blocked_range<size_t> const& _range) {
+            for (auto i = _range.begin(); i < _range.end(); ++i)
+            {
+                if (results[i] == TransactionStatus::None)
+                {
+                    results[i] = txValidator->verifyWithoutNonceUpdate(_txs[i].transaction);
+                }
+            }
+        });
+    auto verifyT = utcTime() - recordT;
+
+    recordT = utcTime();
+    size_t insertedTxs = 0;
+    {
+        ReadGuard l(x_txpoolMutex);
+        for (size_t i = 0; i < _txs.size(); ++i)
         {
-            result = insertWithoutLock(std::move(transaction));
+            if (results[i] != TransactionStatus::None)
+            {
+                continue;
+            }
+            auto& tx = _txs[i].transaction;
+            // the tx may be imported after the verification
+            results[i] = txpoolStorageCheck(*tx);
+            if (results[i] != TransactionStatus::None)
+            {
+                continue;
+            }
+            if (_checkPoolLimit && m_txsTable.size() + spilledTxs >= poolLimit)
+            {
+                results[i] = TransactionStatus::TxPoolIsFull;
+                continue;
+            }
+            // the txs of the same batch may have the same nonce
+            results[i] = txValidator->acceptNonce(tx);
+            if (results[i] != TransactionStatus::None)
+            {
+                continue;
+            }
+            if (_txs[i].callback)
+            {
+                tx->setSubmitCallback(std::move(_txs[i].callback));
+            }
+            auto [it, inserted] = m_txsTable.insert(std::make_pair(tx->hash(), tx));
+            if (!inserted)
+            {
+                results[i] = TransactionStatus::AlreadyInTxPool;
+                continue;
+            }
+            onTxInserted(*tx);
+            insertedTxs++;
         }
     }
-
-    return result;
+    tryToEvictTxs();
+    if (insertedTxs > 0)
+    {
+        m_onReady();
+        notifyUnsealedTxsSize();
+    }
+    TXPOOL_LOG(TRACE) << LOG_DESC("batchVerifyAndSubmit") << LOG_KV("txs", _txs.size())
+                      << LOG_KV("inserted", insertedTxs) << LOG_KV("verifyT", verifyT)
+                      << LOG_KV("insertT", (utcTime() - recordT));
+    return results;
 }
 
 void MemoryStorage::notifyInvalidReceipt(
@@ -303,6 +455,7 @@ TransactionStatus MemoryStorage::insertWithoutLock(Transaction::Ptr transaction)
     {
         return TransactionStatus::AlreadyInTxPool;
     }
+    onTxInserted(*transaction);
     m_onReady();
 
     notifyUnsealedTxsSize();
@@ -335,6 +488,10 @@ Transaction::Ptr MemoryStorage::removeWithoutLock(HashType const& _txHash)
         --m_sealedTxsSize;
     }
     m_txsTable.unsafe_erase(it);
+    if (tx)
+    {
+        onTxRemoved(*tx);
+    }
 #if FISCO_DEBUG
     // TODO: remove this, now just for bug tracing
     TXPOOL_LOG(DEBUG) << LOG_DESC("remove tx: ") << tx->hash().abridged()
@@ -441,6 +598,7 @@ void MemoryStorage::batchRemove(BlockNumber batchId, TransactionSubmitResults co
     size_t succCount = 0;
     NonceList nonceList;
     std::vector<std::tuple<Transaction::Ptr, TransactionSubmitResult::Ptr>> results;
+    std::vector<std::tuple<SpilledTx, TransactionSubmitResult::Ptr>> spilledResults;
 
     results.reserve(txsResult.size());
     nonceList.reserve(txsResult.size());
@@ -450,6 +608,18 @@ void MemoryStorage::batchRemove(BlockNumber batchId, TransactionSubmitResults co
         {
             auto const& txResult = it;
             auto tx = removeWithoutLock(txResult->txHash());
+            if (!tx && m_spillQueue)
+            {
+                // the tx committed while spilled, notify it with the callback kept in memory
+                auto spilledTx = takeSpilledTx(txResult->txHash());
+                if (spilledTx)
+                {
+                    ++succCount;
+                    nonceList.emplace_back(spilledTx->nonce);
+                    spilledResults.emplace_back(std::tuple{std::move(*spilledTx), txResult});
+                    continue;
+                }
+            }
             if (!tx && txResult->nonce() != NonceType(-1))
             {
                 nonceList.emplace_back(txResult->nonce());
@@ -505,13 +675,36 @@ void MemoryStorage::batchRemove(BlockNumber batchId, TransactionSubmitResults co
             notifyTxResult(*tx, std::move(txResult));
         }
     }
+    for (auto& [spilledTx, txResult] : spilledResults)
+    {
+        if (!spilledTx.callback)
+        {
+            continue;
+        }
+        auto txHash = txResult->txHash();
+        txResult->setSender(std::move(spilledTx.sender));
+        txResult->setTo(std::move(spilledTx.to));
+        try
+        {
+            spilledTx.callback(nullptr, std::move(txResult));
+        }
+        catch (std::exception const& e)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("notifyTxResult failed")
+                                << LOG_KV("tx", txHash.abridged())
+                                << LOG_KV("errorInfo", boost::diagnostic_information(e));
+        }
+    }
 
     TXPOOL_LOG(INFO) << METRIC << LOG_DESC("batchRemove txs success")
                      << LOG_KV("expectedSize", txsResult.size()) << LOG_KV("succCount", succCount)
                      << LOG_KV("batchId", batchId) << LOG_KV("timecost", (utcTime() - recordT))
                      << LOG_KV("lockT", lockT) << LOG_KV("removeT", removeT)
                      << LOG_KV("updateLedgerNonceT", updateLedgerNonceT)
-                     << LOG_KV("updateTxPoolNonceT", updateTxPoolNonceT);
+                     << LOG_KV("updateTxPoolNonceT", updateTxPoolNonceT)
+                     << LOG_KV("spilledTxs", spilledResults.size());
+    // the sealed txs removed, reload the spilled txs
+    tryToReloadTxs();
 }
 
 TransactionsPtr MemoryStorage::fetchTxs(HashList& _missedTxs, HashList const& _txs)
@@ -659,7 +852,11 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
                          << LOG_KV("batchHash", tx->batchHash().abridged())
                          << LOG_KV("txPointer", tx);
 #endif
-        tx->setSealed(true);
+        if (!tx->sealed())
+        {
+            tx->setSealed(true);
+            onTxSealed(*tx, true);
+        }
         tx->setBatchId(-1);
         tx->setBatchHash(HashType());
         if ((_txsList->transactionsMetaDataSize() + _sysTxsList->transactionsMetaDataSize()) >=
@@ -726,6 +923,23 @@ void MemoryStorage::clear()
     m_invalidTxs.clear();
     m_invalidNonces.clear();
     m_missedTxs.clear();
+    {
+        Guard evictionLock(x_evictionQueue);
+        m_evictionQueue.clear();
+        m_evictionEntries.clear();
+        m_txsMemory = 0;
+        m_unsealedTxsMemory = 0;
+        if (m_txPriority)
+        {
+            m_txPriority->clear();
+        }
+    }
+    if (m_spillQueue)
+    {
+        Guard spilledLock(x_spilledTxs);
+        m_spilledTxs.clear();
+        m_spillQueue->clear();
+    }
     notifyUnsealedTxsSize();
 }
 
@@ -818,7 +1032,11 @@ void MemoryStorage::batchMarkTxsWithoutLock(
         {
             m_sealedTxsSize--;
         }
-        tx->setSealed(_sealFlag);
+        if (tx->sealed() != _sealFlag)
+        {
+            tx->setSealed(_sealFlag);
+            onTxSealed(*tx, _sealFlag);
+        }
         successCount += 1;
         // set the block information for the transaction
         if (_sealFlag)
@@ -851,7 +1069,11 @@ void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
         {
             continue;
         }
-        tx->setSealed(_sealFlag);
+        if (tx->sealed() != _sealFlag)
+        {
+            tx->setSealed(_sealFlag);
+            onTxSealed(*tx, _sealFlag);
+        }
         if (!_sealFlag)
         {
             tx->setBatchId(-1);
@@ -982,6 +1204,8 @@ HashListPtr MemoryStorage::getTxsHash(int _limit)
 void MemoryStorage::cleanUpExpiredTransactions()
 {
     m_cleanUpTimer->restart();
+    tryToReloadTxs();
+    cleanUpExpiredSpilledTxs();
 
     // Note: In order to minimize the impact of cleanUp on performance,
     // the normal consensus node does not clear expired txs in m_clearUpTimer, but clears
@@ -1030,25 +1254,30 @@ void MemoryStorage::cleanUpExpiredTransactions()
 void MemoryStorage::batchImportTxs(TransactionsPtr _txs)
 {
     auto recordT = utcTime();
-    ReadGuard l(x_txpoolMutex);
-    size_t successCount = 0;
+    std::vector<PendingSubmit> txs;
+    txs.reserve(_txs->size());
     for (auto const& tx : *_txs)
     {
         if (!tx || tx->invalid())
         {
             continue;
         }
-        // not checkLimit when receive txs from p2p
-        auto ret = verifyAndSubmitTransaction(tx, nullptr, false, false);
-        if (ret != TransactionStatus::None)
+        txs.emplace_back(PendingSubmit{tx, nullptr});
+    }
+    // not checkLimit when receive txs from p2p
+    auto results = batchVerifyAndSubmit(txs, false);
+    size_t successCount = 0;
+    for (size_t i = 0; i < txs.size(); ++i)
+    {
+        if (results[i] != TransactionStatus::None)
         {
             TXPOOL_LOG(TRACE) << LOG_DESC("batchImportTxs failed")
-                              << LOG_KV("tx", tx->hash().abridged()) << LOG_KV("error", ret);
+                              << LOG_KV("tx", txs[i].transaction->hash().abridged())
+                              << LOG_KV("error", results[i]);
             continue;
         }
         successCount++;
     }
-    notifyUnsealedTxsSize();
     TXPOOL_LOG(DEBUG) << LOG_DESC("batchImportTxs success") << LOG_KV("importTxs", successCount)
                       << LOG_KV("totalTxs", _txs->size()) << LOG_KV("pendingTxs", m_txsTable.size())
                       << LOG_KV("timecost", (utcTime() - recordT));
@@ -1088,4 +1317,407 @@ bool MemoryStorage::batchVerifyAndSubmitTransaction(
                       << LOG_KV("totalTxs", _txs->size()) << LOG_KV("lockT", lockT)
                       << LOG_KV("submitT", (utcTime() - recordT));
     return true;
-}
\ No newline at end of file
+}
+
+size_t MemoryStorage::txMemory(Transaction const& _tx)
+{
+    // the fixed fields, the hashes, the nonce and the entries of the tables
+    constexpr size_t TX_OVERHEAD = 512;
+    return TX_OVERHEAD + _tx.input().size() + _tx.abi().size() + _tx.extraData().size() +
+           _tx.signatureData().size() + _tx.to().size() + _tx.sender().size();
+}
+
+size_t MemoryStorage::spilledTxsSize() const
+{
+    Guard l(x_spilledTxs);
+    return m_spilledTxs.size();
+}
+
+std::optional<MemoryStorage::SpilledTx> MemoryStorage::takeSpilledTx(HashType const& _txHash)
+{
+    Guard l(x_spilledTxs);
+    auto it = m_spilledTxs.find(_txHash);
+    if (it == m_spilledTxs.end())
+    {
+        return std::nullopt;
+    }
+    auto spilledTx = std::move(it->second);
+    m_spilledTxs.erase(it);
+    return spilledTx;
+}
+
+void MemoryStorage::onTxInserted(Transaction& _tx)
+{
+    if (m_spillQueue)
+    {
+        // the spilled tx imported again from the peers or the proposal, the record on disk is
+        // skipped when reloaded
+        auto spilledTx = takeSpilledTx(_tx.hash());
+        if (spilledTx && spilledTx->callback && !_tx.submitCallback())
+        {
+            _tx.setSubmitCallback(std::move(spilledTx->callback));
+        }
+    }
+    if (m_memoryLimit == 0)
+    {
+        return;
+    }
+    auto memory = txMemory(_tx);
+    Guard l(x_evictionQueue);
+    if (m_evictionEntries.count(_tx.hash()))
+    {
+        return;
+    }
+    auto key = EvictionKey{m_txPriority->onInserted(_tx), m_evictionSequence++};
+    m_evictionEntries.emplace(_tx.hash(), EvictionEntry{key, memory, _tx.sealed()});
+    m_txsMemory += memory;
+    if (!_tx.sealed())
+    {
+        m_evictionQueue.emplace(key, _tx.hash());
+        m_unsealedTxsMemory += memory;
+    }
+}
+
+void MemoryStorage::onTxRemoved(Transaction const& _tx)
+{
+    if (m_memoryLimit == 0)
+    {
+        return;
+    }
+    Guard l(x_evictionQueue);
+    auto it = m_evictionEntries.find(_tx.hash());
+    if (it == m_evictionEntries.end())
+    {
+        return;
+    }
+    m_txsMemory -= it->second.memory;
+    if (!it->second.sealed)
+    {
+        m_evictionQueue.erase(it->second.key);
+        m_unsealedTxsMemory -= it->second.memory;
+    }
+    m_evictionEntries.erase(it);
+    m_txPriority->onRemoved(_tx);
+}
+
+void MemoryStorage::onTxSealed(Transaction const& _tx, bool _sealed)
+{
+    if (m_memoryLimit == 0)
+    {
+        return;
+    }
+    Guard l(x_evictionQueue);
+    auto it = m_evictionEntries.find(_tx.hash());
+    if (it == m_evictionEntries.end() || it->second.sealed == _sealed)
+    {
+        return;
+    }
+    it->second.sealed = _sealed;
+    if (_sealed)
+    {
+        m_evictionQueue.erase(it->second.key);
+        m_unsealedTxsMemory -= it->second.memory;
+    }
+    else
+    {
+        m_evictionQueue.emplace(it->second.key, _tx.hash());
+        m_unsealedTxsMemory += it->second.memory;
+    }
+}
+
+void MemoryStorage::tryToEvictTxs()
+{
+    // the sealed txs can not be evicted, nothing to do if they alone exceed the memory limit
+    if (m_memoryLimit == 0 || m_txsMemory <= m_memoryLimit || m_unsealedTxsMemory == 0)
+    {
+        return;
+    }
+    auto recordT = utcTime();
+    std::vector<Transaction::Ptr> evictedTxs;
+    {
+        WriteGuard l(x_txpoolMutex);
+        HashList evictedHashes;
+        {
+            Guard evictionLock(x_evictionQueue);
+            size_t evictedMemory = 0;
+            for (auto it = m_evictionQueue.rbegin();
+                 it != m_evictionQueue.rend() && m_txsMemory > m_memoryLimit + evictedMemory; ++it)
+            {
+                // the sealed txs are taken out of the queue, check again for the ones sealed
+                // without holding x_txpoolMutex exclusively
+                auto txIt = m_txsTable.find(it->second);
+                if (txIt == m_txsTable.end() || !txIt->second || txIt->second->sealed())
+                {
+                    continue;
+                }
+                evictedHashes.emplace_back(it->second);
+                evictedMemory += m_evictionEntries.at(it->second).memory;
+            }
+        }
+        evictedTxs.reserve(evictedHashes.size());
+        for (auto const& txHash : evictedHashes)
+        {
+            auto tx = removeWithoutLock(txHash);
+            if (tx)
+            {
+                evictedTxs.emplace_back(std::move(tx));
+            }
+        }
+        // register the spilled txs before releasing the lock, to reject the same txs submitted
+        if (m_spillQueue)
+        {
+            Guard spilledLock(x_spilledTxs);
+            for (auto const& tx : evictedTxs)
+            {
+                m_spilledTxs[tx->hash()] = SpilledTx{tx->takeSubmitCallback(), tx->nonce(),
+                    tx->importTime(), std::string(tx->sender()), std::string(tx->to()),
+                    std::nullopt};
+            }
+        }
+    }
+    if (evictedTxs.empty())
+    {
+        return;
+    }
+    notifyUnsealedTxsSize();
+
+    bool spilled = false;
+    if (m_spillQueue)
+    {
+        try
+        {
+            std::vector<bytesConstPtr> datas(evictedTxs.size());
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, evictedTxs.size()),
+                [&evictedTxs, &datas](tbb::blocked_range<size_t> const& _range) {
+                    for (auto i = _range.begin(); i < _range.end(); ++i)
+                    {
+                        auto data = std::make_shared<bytes>();
+                        evictedTxs[i]->encode(*data);
+                        datas[i] = std::move(data);
+                    }
+                });
+            auto segments = m_spillQueue->push(datas);
+            spilled = true;
+            Guard spilledLock(x_spilledTxs);
+            for (size_t i = 0; i < evictedTxs.size(); ++i)
+            {
+                auto it = m_spilledTxs.find(evictedTxs[i]->hash());
+                if (it != m_spilledTxs.end())
+                {
+                    it->second.segment = segments[i];
+                }
+            }
+        }
+        catch (std::exception const& e)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("tryToEvictTxs: spill txs failed, drop them")
+                                << LOG_KV("txs", evictedTxs.size())
+                                << LOG_KV("errorInfo", boost::diagnostic_information(e));
+        }
+    }
+    if (!spilled)
+    {
+        NonceList nonceList;
+        nonceList.reserve(evictedTxs.size());
+        for (auto const& tx : evictedTxs)
+        {
+            auto callback = tx->takeSubmitCallback();
+            if (m_spillQueue)
+            {
+                auto spilledTx = takeSpilledTx(tx->hash());
+                // committed meanwhile
+                if (!spilledTx)
+                {
+                    continue;
+                }
+                callback = std::move(spilledTx->callback);
+            }
+            nonceList.emplace_back(tx->nonce());
+            notifyInvalidReceipt(tx->hash(), TransactionStatus::TxPoolIsFull, std::move(callback));
+        }
+        m_config->txPoolNonceChecker()->batchRemove(nonceList);
+    }
+    TXPOOL_LOG(INFO) << METRIC << LOG_DESC("tryToEvictTxs")
+                     << LOG_KV("evictedTxs", evictedTxs.size()) << LOG_KV("spilled", spilled)
+                     << LOG_KV("txsMemory", m_txsMemory)
+                     << LOG_KV("unsealedTxsMemory", m_unsealedTxsMemory)
+                     << LOG_KV("memoryLimit", m_memoryLimit)
+                     << LOG_KV("pendingTxs", m_txsTable.size())
+                     << LOG_KV("spilledTxs", spilledTxsSize())
+                     << LOG_KV("timecost", (utcTime() - recordT));
+}
+
+void MemoryStorage::tryToReloadTxs()
+{
+    if (!m_spillQueue)
+    {
+        return;
+    }
+    // the txs are reloaded by one thread
+    std::unique_lock reloadLock(x_reloadTxs, std::try_to_lock);
+    if (!reloadLock.owns_lock())
+    {
+        return;
+    }
+    auto recordT = utcTime();
+    size_t reloadedTxs = 0;
+    size_t expiredTxs = 0;
+    auto txFactory = m_config->txFactory();
+    while (m_txsMemory * 4 < m_memoryLimit * 3 && m_spillQueue->size() > 0)
+    {
+        std::vector<bytesPointer> datas;
+        std::vector<uint64_t> droppedSegments;
+        try
+        {
+            datas = m_spillQueue->pop(c_reloadBatchSize, &droppedSegments);
+        }
+        catch (std::exception const& e)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("tryToReloadTxs: read the spilled txs failed")
+                                << LOG_KV("errorInfo", boost::diagnostic_information(e));
+            break;
+        }
+        if (!droppedSegments.empty())
+        {
+            onSpilledSegmentsDropped(droppedSegments);
+        }
+        std::vector<Transaction::Ptr> txs(datas.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, datas.size()),
+            [&datas, &txs, &txFactory](tbb::blocked_range<size_t> const& _range) {
+                for (auto i = _range.begin(); i < _range.end(); ++i)
+                {
+                    try
+                    {
+                        txs[i] = txFactory->createTransaction(ref(*datas[i]), false, false);
+                    }
+                    catch (std::exception const& e)
+                    {
+                        TXPOOL_LOG(WARNING)
+                            << LOG_DESC("tryToReloadTxs: decode the spilled tx failed")
+                            << LOG_KV("errorInfo", boost::diagnostic_information(e));
+                    }
+                }
+            });
+
+        std::vector<std::tuple<HashType, SpilledTx>> expired;
+        auto currentTime = (int64_t)utcTime();
+        {
+            ReadGuard l(x_txpoolMutex);
+            for (auto& tx : txs)
+            {
+                if (!tx)
+                {
+                    continue;
+                }
+                // the tx committed or imported again since spilled
+                auto spilledTx = takeSpilledTx(tx->hash());
+                if (!spilledTx)
+                {
+                    continue;
+                }
+                if (currentTime > (spilledTx->importTime + m_txsExpirationTime))
+                {
+                    expired.emplace_back(std::tuple{tx->hash(), std::move(*spilledTx)});
+                    continue;
+                }
+                tx->setImportTime(spilledTx->importTime);
+                if (spilledTx->callback)
+                {
+                    tx->setSubmitCallback(std::move(spilledTx->callback));
+                }
+                auto [it, inserted] = m_txsTable.insert(std::make_pair(tx->hash(), tx));
+                if (!inserted)
+                {
+                    continue;
+                }
+                onTxInserted(*tx);
+                ++reloadedTxs;
+            }
+        }
+        expiredTxs += expired.size();
+        notifySpilledTxs(expired, TransactionStatus::TransactionPoolTimeout);
+    }
+    if (reloadedTxs == 0 && expiredTxs == 0)
+    {
+        return;
+    }
+    if (reloadedTxs > 0)
+    {
+        m_onReady();
+        notifyUnsealedTxsSize();
+    }
+    TXPOOL_LOG(INFO) << METRIC << LOG_DESC("tryToReloadTxs") << LOG_KV("reloadedTxs", reloadedTxs)
+                     << LOG_KV("expiredTxs", expiredTxs) << LOG_KV("txsMemory", m_txsMemory)
+                     << LOG_KV("pendingTxs", m_txsTable.size())
+                     << LOG_KV("spilledTxs", spilledTxsSize())
+                     << LOG_KV("timecost", (utcTime() - recordT));
+}
+
+void MemoryStorage::notifySpilledTxs(
+    std::vector<std::tuple<HashType, SpilledTx>>& _spilledTxs, TransactionStatus _status)
+{
+    NonceList nonceList;
+    nonceList.reserve(_spilledTxs.size());
+    for (auto& [txHash, spilledTx] : _spilledTxs)
+    {
+        nonceList.emplace_back(spilledTx.nonce);
+        notifyInvalidReceipt(txHash, _status, std::move(spilledTx.callback));
+    }
+    m_config->txPoolNonceChecker()->batchRemove(nonceList);
+}
+
+void MemoryStorage::cleanUpExpiredSpilledTxs()
+{
+    if (!m_spillQueue)
+    {
+        return;
+    }
+    // the records of the expired txs are skipped when reloaded
+    std::vector<std::tuple<HashType, SpilledTx>> expired;
+    auto currentTime = (int64_t)utcTime();
+    {
+        Guard l(x_spilledTxs);
+        for (auto it = m_spilledTxs.begin(); it != m_spilledTxs.end();)
+        {
+            if (currentTime <= (it->second.importTime + m_txsExpirationTime))
+            {
+                ++it;
+                continue;
+            }
+            expired.emplace_back(std::tuple{it->first, std::move(it->second)});
+            it = m_spilledTxs.erase(it);
+        }
+    }
+    if (expired.empty())
+    {
+        return;
+    }
+    notifySpilledTxs(expired, TransactionStatus::TransactionPoolTimeout);
+    TXPOOL_LOG(INFO) << LOG_DESC("cleanUpExpiredSpilledTxs") << LOG_KV("expiredTxs", expired.size())
+                     << LOG_KV("spilledTxs", spilledTxsSize());
+}
+
+void MemoryStorage::onSpilledSegmentsDropped(std::vector<uint64_t> const& _segments)
+{
+    std::vector<std::tuple<HashType, SpilledTx>> dropped;
+    {
+        Guard l(x_spilledTxs);
+        for (auto it = m_spilledTxs.begin(); it != m_spilledTxs.end();)
+        {
+            if (!it->second.segment || std::find(_segments.begin(), _segments.end(),
+                                           *it->second.segment) == _segments.end())
+            {
+                ++it;
+                continue;
+            }
+            dropped.emplace_back(std::tuple{it->first, std::move(it->second)});
+            it = m_spilledTxs.erase(it);
+        }
+    }
+    // lost as the evicted txs dropped without the spill path
+    notifySpilledTxs(dropped, TransactionStatus::TxPoolIsFull);
+    TXPOOL_LOG(WARNING) << LOG_DESC("onSpilledSegmentsDropped")
+                        << LOG_KV("segments", _segments.size())
+                        << LOG_KV("droppedTxs", dropped.size())
+                        << LOG_KV("spilledTxs", spilledTxsSize());
+}
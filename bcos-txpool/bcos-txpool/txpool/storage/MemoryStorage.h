@@ -21,11 +21,13 @@
 #pragma once
 
 #include "bcos-txpool/TxPoolConfig.h"
+#include "bcos-txpool/txpool/storage/TxSpillQueue.h"
 #include <bcos-utilities/ThreadPool.h>
 #include <bcos-utilities/Timer.h>
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_unordered_set.h>
 #include <boost/thread/pthread/shared_mutex.hpp>
+#include <map>
 
 namespace bcos::txpool
 {
@@ -95,14 +97,46 @@ public:
         bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash,
         bool _sealFlag) override;
 
+    // the estimated bytes of the txs in memory, only counted when the memory limit is set
+    size_t txsMemory() const { return m_txsMemory; }
+    // the estimated bytes of the unsealed txs, only they can be evicted
+    size_t unsealedTxsMemory() const { return m_unsealedTxsMemory; }
+    size_t spilledTxsSize() const;
+
+    // the estimated bytes of the decoded tx
+    static size_t txMemory(bcos::protocol::Transaction const& _tx);
+
 protected:
+    struct PendingSubmit
+    {
+        bcos::protocol::Transaction::Ptr transaction;
+        bcos::protocol::TxSubmitCallback callback;
+    };
+    // the tx spilled to disk, the callback and the fields to notify the result are kept in memory
+    struct SpilledTx
+    {
+        bcos::protocol::TxSubmitCallback callback;
+        bcos::protocol::NonceType nonce;
+        int64_t importTime;
+        std::string sender;
+        std::string to;
+        // the segment of the spill queue holding the tx, set after the tx written
+        std::optional<uint64_t> segment;
+    };
+    // queue the tx to be admitted together with the other txs submitted meanwhile, the callback
+    // is called with the error if the tx is rejected
+    virtual void submitToAdmission(
+        bcos::protocol::Transaction::Ptr _tx, bcos::protocol::TxSubmitCallback _callback);
+    virtual void admitPendingTxs();
+    // verify the signatures of the txs in parallel, then check the nonces and insert the txs under
+    // a single lock acquisition
+    virtual std::vector<bcos::protocol::TransactionStatus> batchVerifyAndSubmit(
+        std::vector<PendingSubmit>& _txs, bool _checkPoolLimit);
+
     bcos::protocol::TransactionStatus insertWithoutLock(
         bcos::protocol::Transaction::Ptr transaction);
     bcos::protocol::TransactionStatus enforceSubmitTransaction(
         bcos::protocol::Transaction::Ptr _tx);
-    bcos::protocol::TransactionStatus verifyAndSubmitTransaction(
-        protocol::Transaction::Ptr transaction, protocol::TxSubmitCallback txSubmitCallback,
-        bool checkPoolLimit, bool lock);
     size_t unSealedTxsSizeWithoutLock();
     bcos::protocol::TransactionStatus txpoolStorageCheck(
         const bcos::protocol::Transaction& transaction);
@@ -128,6 +162,25 @@ protected:
         bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash,
         bool _sealFlag);
 
+    // account the memory and the eviction rank of the tx, called with x_txpoolMutex held
+    void onTxInserted(bcos::protocol::Transaction& _tx);
+    void onTxRemoved(bcos::protocol::Transaction const& _tx);
+    // take the sealed tx out of the eviction queue, and put it back when unsealed
+    void onTxSealed(bcos::protocol::Transaction const& _tx, bool _sealed);
+    // evict the unsealed txs of the highest rank until the txs in memory are within the memory
+    // limit, the evicted txs are spilled to disk if the spill path is set, otherwise dropped
+    virtual void tryToEvictTxs();
+    // reload the spilled txs while the txs in memory are below 3/4 of the memory limit
+    virtual void tryToReloadTxs();
+    std::optional<SpilledTx> takeSpilledTx(bcos::crypto::HashType const& _txHash);
+    // notify the spilled txs expired without waiting for them to be reloaded
+    void cleanUpExpiredSpilledTxs();
+    // notify the spilled txs lost with the segments dropped for the read errors
+    void onSpilledSegmentsDropped(std::vector<uint64_t> const& _segments);
+    // notify the spilled txs taken and release their nonces
+    void notifySpilledTxs(std::vector<std::tuple<bcos::crypto::HashType, SpilledTx>>& _spilledTxs,
+        bcos::protocol::TransactionStatus _status);
+
 protected:
     TxPoolConfig::Ptr m_config;
 
@@ -159,6 +212,39 @@ protected:
     // The limit set here is to minimize the impact of the cleanup operation on txpool performance
     uint64_t c_maxTraverseTxsNum = 10000;
 
+    // the txs submitted while the last batch is being admitted
+    mutable Mutex x_pendingSubmits;
+    std::vector<PendingSubmit> m_pendingSubmits;
+    bool m_admitting = false;
+    ThreadPool::Ptr m_admissionWorker;
+
+    size_t m_memoryLimit = 0;
+    std::atomic<size_t> m_txsMemory = {0};
+    std::atomic<size_t> m_unsealedTxsMemory = {0};
+    TxPriorityInterface::Ptr m_txPriority;
+    // the unsealed txs ordered by {rank, insertion sequence}, the last one is evicted first
+    using EvictionKey = std::pair<int64_t, uint64_t>;
+    struct EvictionEntry
+    {
+        EvictionKey key;
+        size_t memory;
+        bool sealed;
+    };
+    std::map<EvictionKey, bcos::crypto::HashType> m_evictionQueue;
+    std::unordered_map<bcos::crypto::HashType, EvictionEntry, std::hash<bcos::crypto::HashType>>
+        m_evictionEntries;
+    uint64_t m_evictionSequence = 0;
+    mutable Mutex x_evictionQueue;
+
+    // the txs spilled to disk, the records of the txs not in m_spilledTxs are skipped when
+    // reloaded, for the txs have been committed or imported again
+    TxSpillQueue::Ptr m_spillQueue;
+    std::unordered_map<bcos::crypto::HashType, SpilledTx, std::hash<bcos::crypto::HashType>>
+        m_spilledTxs;
+    mutable Mutex x_spilledTxs;
+    mutable Mutex x_reloadTxs;
+    size_t c_reloadBatchSize = 1000;
+
     // for tps stat
     std::atomic_uint64_t m_tpsStatstartTime = {0};
     std::atomic_uint64_t m_onChainTxsCount = {0};
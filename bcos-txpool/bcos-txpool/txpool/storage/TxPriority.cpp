@@ -0,0 +1,57 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the priorities to evict the pending transactions
+ * @file TxPriority.cpp
+ * @date 2022-12-26
+ */
+#include "TxPriority.h"
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+int64_t SenderFairPriority::onInserted(Transaction const& _tx)
+{
+    Guard l(x_pendingTxs);
+    return ++m_pendingTxs[std::string(_tx.sender())];
+}
+
+void SenderFairPriority::onRemoved(Transaction const& _tx)
+{
+    Guard l(x_pendingTxs);
+    auto it = m_pendingTxs.find(std::string(_tx.sender()));
+    if (it == m_pendingTxs.end())
+    {
+        return;
+    }
+    if (--(it->second) <= 0)
+    {
+        m_pendingTxs.erase(it);
+    }
+}
+
+void SenderFairPriority::clear()
+{
+    Guard l(x_pendingTxs);
+    m_pendingTxs.clear();
+}
+
+size_t SenderFairPriority::pendingTxs(std::string_view _sender) const
+{
+    Guard l(x_pendingTxs);
+    auto it = m_pendingTxs.find(std::string(_sender));
+    return it == m_pendingTxs.end() ? 0 : it->second;
+}
@@ -0,0 +1,54 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the priorities to evict the pending transactions
+ * @file TxPriority.h
+ * @date 2022-12-26
+ */
+#pragma once
+#include "bcos-txpool/txpool/interfaces/TxPriorityInterface.h"
+#include <bcos-utilities/Common.h>
+#include <unordered_map>
+
+namespace bcos::txpool
+{
+// the txs imported latest are evicted first
+class ImportTimePriority : public TxPriorityInterface
+{
+public:
+    int64_t onInserted(bcos::protocol::Transaction const& _tx) override
+    {
+        return _tx.importTime();
+    }
+    void onRemoved(bcos::protocol::Transaction const&) override {}
+    void clear() override {}
+};
+
+// the tx ranked by the pending txs of its sender when inserted, the txs of the senders submitting
+// the most txs are evicted first
+class SenderFairPriority : public TxPriorityInterface
+{
+public:
+    int64_t onInserted(bcos::protocol::Transaction const& _tx) override;
+    void onRemoved(bcos::protocol::Transaction const& _tx) override;
+    void clear() override;
+
+    size_t pendingTxs(std::string_view _sender) const;
+
+private:
+    std::unordered_map<std::string, int64_t> m_pendingTxs;
+    mutable Mutex x_pendingTxs;
+};
+}  // namespace bcos::txpool
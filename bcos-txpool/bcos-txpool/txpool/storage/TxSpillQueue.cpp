@@ -0,0 +1,261 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the on-disk FIFO queue of the encoded transactions evicted from the txpool
+ * @file TxSpillQueue.cpp
+ * @date 2022-12-26
+ */
+#include "TxSpillQueue.h"
+#include <bcos-crypto/interfaces/crypto/CommonType.h>
+#include <bcos-framework/txpool/TxPoolTypeDef.h>
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace bcos;
+using namespace bcos::txpool;
+
+namespace
+{
+constexpr const char* SEGMENT_EXTENSION = ".spill";
+}  // namespace
+
+TxSpillQueue::TxSpillQueue(boost::filesystem::path _path, size_t _segmentSize)
+  : m_path(std::move(_path)), m_segmentSize(std::max<size_t>(_segmentSize, 1))
+{}
+
+TxSpillQueue::~TxSpillQueue()
+{
+    try
+    {
+        clear();
+    }
+    catch (std::exception const& e)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxSpillQueue: remove the segments failed")
+                            << LOG_KV("path", m_path.string())
+                            << LOG_KV("error", boost::diagnostic_information(e));
+    }
+}
+
+boost::filesystem::path TxSpillQueue::segmentPath(uint64_t _id) const
+{
+    return m_path / (std::to_string(_id) + SEGMENT_EXTENSION);
+}
+
+void TxSpillQueue::open()
+{
+    Guard l(x_segments);
+    boost::filesystem::create_directories(m_path);
+    size_t removed = 0;
+    for (auto const& entry : boost::filesystem::directory_iterator(m_path))
+    {
+        if (boost::filesystem::is_regular_file(entry.path()) &&
+            entry.path().extension() == SEGMENT_EXTENSION)
+        {
+            boost::filesystem::remove(entry.path());
+            ++removed;
+        }
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("TxSpillQueue: open") << LOG_KV("path", m_path.string())
+                     << LOG_KV("removedSegments", removed);
+}
+
+std::vector<uint64_t> TxSpillQueue::push(std::vector<bytesConstPtr> const& _datas)
+{
+    Guard l(x_segments);
+    std::vector<uint64_t> segments;
+    segments.reserve(_datas.size());
+    // rolled back to if the write failed
+    auto segmentsSize = m_segments.size();
+    std::optional<Segment> lastSegment;
+    if (!m_segments.empty())
+    {
+        lastSegment = m_segments.back();
+    }
+    try
+    {
+        size_t size = 0;
+        size_t dataBytes = 0;
+        for (auto const& data : _datas)
+        {
+            // a new segment after the writer closed by the last failure
+            if (m_segments.empty() || !m_writer.is_open() ||
+                m_segments.back().bytes >= m_segmentSize)
+            {
+                if (m_writer.is_open())
+                {
+                    m_writer.close();
+                }
+                if (!m_writer)
+                {
+                    BOOST_THROW_EXCEPTION(TxSpillQueueException() << errinfo_comment(
+                                              "close the spill segment failed, path: " +
+                                              segmentPath(m_segments.back().id).string()));
+                }
+                m_segments.push_back(Segment{m_nextSegment++});
+                m_writer.open(segmentPath(m_segments.back().id),
+                    std::ios::binary | std::ios::out | std::ios::trunc);
+            }
+            auto recordSize = (uint32_t)data->size();
+            m_writer.write((char const*)&recordSize, sizeof(recordSize));
+            m_writer.write((char const*)data->data(), recordSize);
+
+            auto& segment = m_segments.back();
+            ++segment.records;
+            segment.bytes += sizeof(recordSize) + recordSize;
+            segment.dataBytes += recordSize;
+            segments.push_back(segment.id);
+            ++size;
+            dataBytes += recordSize;
+        }
+        // flush to be read from the reader
+        m_writer.flush();
+        if (!m_writer)
+        {
+            BOOST_THROW_EXCEPTION(TxSpillQueueException() << errinfo_comment(
+                                      "write the spill segment failed, path: " + m_path.string()));
+        }
+        m_size += size;
+        m_bytes += dataBytes;
+    }
+    catch (...)
+    {
+        // the records written partially are cut off, and the next push opens a new segment
+        m_writer.close();
+        m_writer.clear();
+        while (m_segments.size() > segmentsSize)
+        {
+            boost::system::error_code error;
+            boost::filesystem::remove(segmentPath(m_segments.back().id), error);
+            m_segments.pop_back();
+        }
+        if (lastSegment)
+        {
+            m_segments.back() = *lastSegment;
+            boost::system::error_code error;
+            boost::filesystem::resize_file(
+                segmentPath(lastSegment->id), lastSegment->bytes, error);
+        }
+        throw;
+    }
+    return segments;
+}
+
+void TxSpillQueue::popSegment()
+{
+    auto const& segment = m_segments.front();
+    m_reader.close();
+    m_reader.clear();
+    m_readSegment.reset();
+    // the next push opens a new segment if it is the segment written
+    if (m_segments.size() == 1)
+    {
+        m_writer.close();
+        m_writer.clear();
+    }
+    boost::system::error_code error;
+    boost::filesystem::remove(segmentPath(segment.id), error);
+    m_size -= segment.records;
+    m_bytes -= segment.dataBytes;
+    m_segments.pop_front();
+}
+
+std::vector<bytesPointer> TxSpillQueue::pop(size_t _count, std::vector<uint64_t>* _droppedSegments)
+{
+    Guard l(x_segments);
+    std::vector<bytesPointer> datas;
+    datas.reserve(std::min(_count, m_size));
+    while (datas.size() < _count && !m_segments.empty())
+    {
+        auto& segment = m_segments.front();
+        if (segment.records > 0)
+        {
+            if (m_readSegment != segment.id)
+            {
+                m_reader.close();
+                m_reader.clear();
+                m_reader.open(segmentPath(segment.id), std::ios::binary | std::ios::in);
+                m_readSegment = segment.id;
+            }
+            uint32_t size = 0;
+            m_reader.read((char*)&size, sizeof(size));
+            bytesPointer data;
+            // the size of a corrupted record may exceed the segment
+            auto offset = m_reader ? (size_t)m_reader.tellg() : segment.bytes;
+            if (m_reader && size <= segment.bytes - std::min(offset, segment.bytes))
+            {
+                data = std::make_shared<bcos::bytes>(size);
+                m_reader.read((char*)data->data(), size);
+            }
+            if (!data || !m_reader)
+            {
+                TXPOOL_LOG(WARNING)
+                    << LOG_DESC("TxSpillQueue: read the spill segment failed, drop it")
+                    << LOG_KV("segment", segmentPath(segment.id).string())
+                    << LOG_KV("droppedRecords", segment.records);
+                if (_droppedSegments)
+                {
+                    _droppedSegments->push_back(segment.id);
+                }
+                popSegment();
+                continue;
+            }
+            datas.emplace_back(std::move(data));
+            --segment.records;
+            segment.dataBytes -= size;
+            --m_size;
+            m_bytes -= size;
+        }
+        if (segment.records > 0)
+        {
+            continue;
+        }
+        popSegment();
+    }
+    return datas;
+}
+
+void TxSpillQueue::removeSegments()
+{
+    m_writer.close();
+    m_writer.clear();
+    m_reader.close();
+    m_reader.clear();
+    m_readSegment.reset();
+    for (auto const& segment : m_segments)
+    {
+        boost::filesystem::remove(segmentPath(segment.id));
+    }
+    m_segments.clear();
+    m_size = 0;
+    m_bytes = 0;
+}
+
+void TxSpillQueue::clear()
+{
+    Guard l(x_segments);
+    removeSegments();
+}
+
+size_t TxSpillQueue::size() const
+{
+    Guard l(x_segments);
+    return m_size;
+}
+
+size_t TxSpillQueue::bytes() const
+{
+    Guard l(x_segments);
+    return m_bytes;
+}
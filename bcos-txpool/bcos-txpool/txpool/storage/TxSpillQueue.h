@@ -0,0 +1,89 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the on-disk FIFO queue of the encoded transactions evicted from the txpool
+ * @file TxSpillQueue.h
+ * @date 2022-12-26
+ */
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Exceptions.h>
+#include <boost/filesystem.hpp>
+#include <deque>
+#include <fstream>
+#include <optional>
+
+namespace bcos::txpool
+{
+DERIVE_BCOS_EXCEPTION(TxSpillQueueException);
+
+// the records [uint32 size][data] appended to the segment files, and the segment files removed
+// when all their records popped. A failed push is rolled back, and a segment that can not be read
+// is dropped with all its records so the later records are still popped
+class TxSpillQueue
+{
+public:
+    using Ptr = std::shared_ptr<TxSpillQueue>;
+    explicit TxSpillQueue(
+        boost::filesystem::path _path, size_t _segmentSize = DEFAULT_SEGMENT_SIZE);
+    virtual ~TxSpillQueue();
+
+    // create the directory, and remove the segments left by the last run, the spilled txs are not
+    // recovered after restart just as the txs in memory
+    virtual void open();
+    // the segment of every record, throw TxSpillQueueException with none of the records pushed if
+    // the write failed
+    virtual std::vector<uint64_t> push(std::vector<bytesConstPtr> const& _datas);
+    // the segments dropped for the read errors are appended to _droppedSegments
+    virtual std::vector<bytesPointer> pop(
+        size_t _count, std::vector<uint64_t>* _droppedSegments = nullptr);
+    virtual void clear();
+
+    size_t size() const;
+    size_t bytes() const;
+    boost::filesystem::path const& path() const { return m_path; }
+
+    static constexpr size_t DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+
+private:
+    struct Segment
+    {
+        uint64_t id;
+        // the records not popped
+        size_t records = 0;
+        // the size of the file
+        size_t bytes = 0;
+        // the data size of the records not popped
+        size_t dataBytes = 0;
+    };
+    boost::filesystem::path segmentPath(uint64_t _id) const;
+    void removeSegments();
+    // remove the front segment and reset the reader
+    void popSegment();
+
+    boost::filesystem::path m_path;
+    size_t m_segmentSize;
+
+    std::deque<Segment> m_segments;
+    uint64_t m_nextSegment = 0;
+    std::ofstream m_writer;
+    std::ifstream m_reader;
+    // the segment m_reader opened
+    std::optional<uint64_t> m_readSegment;
+    size_t m_size = 0;
+    size_t m_bytes = 0;
+    mutable Mutex x_segments;
+};
+}  // namespace bcos::txpool
@@ -0,0 +1,267 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the nonces of the latest blocks bucketed by the block number
+ * @file BlockNonceSet.cpp
+ * @date 2022-12-19
+ */
+#include "BlockNonceSet.h"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <bit>
+#include <limits>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+namespace
+{
+// the number of the erased slots, never alive
+constexpr BlockNumber ERASED_NUMBER = std::numeric_limits<BlockNumber>::min();
+
+// the finalizer of splitmix64
+inline uint64_t mix(uint64_t _value)
+{
+    _value ^= _value >> 30;
+    _value *= 0xbf58476d1ce4e5b9ULL;
+    _value ^= _value >> 27;
+    _value *= 0x94d049bb133111ebULL;
+    _value ^= _value >> 31;
+    return _value;
+}
+}  // namespace
+
+BlockNonceSet::BlockNonceSet(int64_t _window)
+  : m_slots(MIN_CAPACITY), m_buckets((size_t)std::max<int64_t>(_window, 1))
+{
+    std::random_device device;
+    m_seed = ((uint64_t)device() << 32) | device();
+}
+
+uint64_t BlockNonceSet::fingerprint(NonceType const& _nonce) const
+{
+    auto const& backend = _nonce.backend();
+    auto value = mix(m_seed ^ backend.size());
+    for (size_t i = 0; i < backend.size(); ++i)
+    {
+        value = mix(value ^ backend.limbs()[i]);
+    }
+    return value == 0 ? 1 : value;
+}
+
+BlockNonceSet::Slot const* BlockNonceSet::find(uint64_t _fingerprint) const
+{
+    auto mask = m_slots.size() - 1;
+    for (auto i = _fingerprint & mask;; i = (i + 1) & mask)
+    {
+        auto const& slot = m_slots[i];
+        if (slot.fingerprint == 0)
+        {
+            return nullptr;
+        }
+        if (slot.fingerprint == _fingerprint && alive(slot))
+        {
+            return &slot;
+        }
+    }
+}
+
+bool BlockNonceSet::contains(NonceType const& _nonce) const
+{
+    return find(fingerprint(_nonce)) != nullptr;
+}
+
+bool BlockNonceSet::insertFingerprint(BlockNumber _number, uint64_t _fingerprint)
+{
+    if (_number <= m_expiredNumber)
+    {
+        return false;
+    }
+    // the bucket of the block is still used by the block _number - window
+    if (_number - m_expiredNumber > (BlockNumber)m_buckets.size())
+    {
+        expire(_number - (BlockNumber)m_buckets.size());
+    }
+    reserve(1);
+    auto mask = m_slots.size() - 1;
+    Slot* deadSlot = nullptr;
+    auto i = _fingerprint & mask;
+    for (;; i = (i + 1) & mask)
+    {
+        auto& slot = m_slots[i];
+        if (slot.fingerprint == 0)
+        {
+            break;
+        }
+        if (!alive(slot))
+        {
+            deadSlot = deadSlot ? deadSlot : &slot;
+            continue;
+        }
+        if (slot.fingerprint == _fingerprint)
+        {
+            return false;
+        }
+    }
+    auto* slot = deadSlot;
+    if (!slot)
+    {
+        slot = &m_slots[i];
+        ++m_used;
+    }
+    slot->fingerprint = _fingerprint;
+    slot->number = _number;
+    ++m_size;
+
+    auto& numberBucket = bucket(_number);
+    if (numberBucket.number != _number)
+    {
+        numberBucket.number = _number;
+        numberBucket.count = 0;
+    }
+    ++numberBucket.count;
+    return true;
+}
+
+bool BlockNonceSet::insert(BlockNumber _number, NonceType const& _nonce)
+{
+    return insertFingerprint(_number, fingerprint(_nonce));
+}
+
+void BlockNonceSet::erase(NonceType const& _nonce)
+{
+    auto* slot = const_cast<Slot*>(find(fingerprint(_nonce)));
+    if (!slot)
+    {
+        return;
+    }
+    auto& numberBucket = bucket(slot->number);
+    if (numberBucket.number == slot->number && numberBucket.count > 0)
+    {
+        --numberBucket.count;
+    }
+    slot->number = ERASED_NUMBER;
+    --m_size;
+}
+
+void BlockNonceSet::insertBlock(BlockNumber _number, NonceList const& _nonceList)
+{
+    expire(_number - (BlockNumber)m_buckets.size());
+    reserve(_nonceList.size());
+    for (auto const& nonce : _nonceList)
+    {
+        insert(_number, nonce);
+    }
+}
+
+void BlockNonceSet::insertBlocks(std::map<BlockNumber, NonceListPtr> const& _blocks)
+{
+    if (_blocks.empty())
+    {
+        return;
+    }
+    std::vector<std::pair<BlockNumber, NonceListPtr>> blocks(_blocks.begin(), _blocks.end());
+    std::vector<std::vector<uint64_t>> fingerprints(blocks.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks.size()),
+        [this, &blocks, &fingerprints](tbb::blocked_range<size_t> const& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                if (!blocks[i].second)
+                {
+                    continue;
+                }
+                fingerprints[i].reserve(blocks[i].second->size());
+                for (auto const& nonce : *(blocks[i].second))
+                {
+                    fingerprints[i].push_back(fingerprint(nonce));
+                }
+            }
+        });
+    expire(blocks.back().first - (BlockNumber)m_buckets.size());
+    size_t count = 0;
+    for (auto const& blockFingerprints : fingerprints)
+    {
+        count += blockFingerprints.size();
+    }
+    reserve(count);
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        for (auto value : fingerprints[i])
+        {
+            insertFingerprint(blocks[i].first, value);
+        }
+    }
+}
+
+void BlockNonceSet::expire(BlockNumber _number)
+{
+    if (_number <= m_expiredNumber)
+    {
+        return;
+    }
+    // all the live blocks are expired
+    if (_number - m_expiredNumber >= (BlockNumber)m_buckets.size())
+    {
+        std::fill(m_buckets.begin(), m_buckets.end(), Bucket());
+        m_size = 0;
+    }
+    else
+    {
+        for (auto number = m_expiredNumber + 1; number <= _number; ++number)
+        {
+            auto& numberBucket = bucket(number);
+            if (numberBucket.number == number)
+            {
+                m_size -= numberBucket.count;
+                numberBucket = Bucket();
+            }
+        }
+    }
+    m_expiredNumber = _number;
+}
+
+void BlockNonceSet::reserve(size_t _size)
+{
+    // keep the load factor of the live and dead slots no larger than 3/4, and no larger than 2/3
+    // after rehashed to leave room for the dead slots of the expired blocks
+    if ((m_used + _size) * 4 <= m_slots.size() * 3)
+    {
+        return;
+    }
+    rehash(std::max(MIN_CAPACITY, std::bit_ceil((m_size + _size) * 3 / 2)));
+}
+
+void BlockNonceSet::rehash(size_t _capacity)
+{
+    std::vector<Slot> slots(_capacity);
+    auto mask = _capacity - 1;
+    for (auto const& slot : m_slots)
+    {
+        if (slot.fingerprint == 0 || !alive(slot))
+        {
+            continue;
+        }
+        auto i = slot.fingerprint & mask;
+        while (slots[i].fingerprint != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+    m_slots.swap(slots);
+    m_used = m_size;
+}
@@ -0,0 +1,98 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the nonces of the latest blocks bucketed by the block number
+ * @file BlockNonceSet.h
+ * @date 2022-12-19
+ */
+#pragma once
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace bcos::txpool
+{
+/**
+ * @brief The nonces of the latest _window blocks, stored as 64-bit fingerprints tagged with the
+ * number of the block in an open-addressing table with linear probing. The fingerprints are
+ * seeded randomly for every instance, so the false positive rate is about size()/2^64 and the
+ * collisions are hard to craft. The live nonces of every block are counted in a ring of buckets
+ * indexed by the block number, expiring a block drops its bucket and turns all its slots dead at
+ * once, the dead slots are reused by the inserts and dropped when rehashed. Not thread-safe.
+ */
+class BlockNonceSet
+{
+public:
+    constexpr static size_t MIN_CAPACITY = 1024;
+
+    explicit BlockNonceSet(int64_t _window);
+
+    bool contains(bcos::protocol::NonceType const& _nonce) const;
+    // return false if the nonce exists or the block expired
+    bool insert(bcos::protocol::BlockNumber _number, bcos::protocol::NonceType const& _nonce);
+    void erase(bcos::protocol::NonceType const& _nonce);
+    // expire the blocks up to _number - _window, and insert the nonces of the block _number
+    void insertBlock(
+        bcos::protocol::BlockNumber _number, bcos::protocol::NonceList const& _nonceList);
+    // insert the nonces of the blocks, the fingerprints are computed in parallel
+    void insertBlocks(
+        std::map<bcos::protocol::BlockNumber, bcos::protocol::NonceListPtr> const& _blocks);
+    // drop the buckets of the blocks no larger than _number
+    void expire(bcos::protocol::BlockNumber _number);
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_slots.size(); }
+    // the memory of the slots and the buckets
+    size_t memory() const
+    {
+        return m_slots.capacity() * sizeof(Slot) + m_buckets.capacity() * sizeof(Bucket);
+    }
+    bcos::protocol::BlockNumber expiredNumber() const { return m_expiredNumber; }
+
+private:
+    // the fingerprint 0 marks an empty slot
+    struct Slot
+    {
+        uint64_t fingerprint = 0;
+        bcos::protocol::BlockNumber number = 0;
+    };
+    struct Bucket
+    {
+        bcos::protocol::BlockNumber number = -1;
+        size_t count = 0;
+    };
+
+    uint64_t fingerprint(bcos::protocol::NonceType const& _nonce) const;
+    bool alive(Slot const& _slot) const { return _slot.number > m_expiredNumber; }
+    Bucket& bucket(bcos::protocol::BlockNumber _number)
+    {
+        return m_buckets[(size_t)(_number % (bcos::protocol::BlockNumber)m_buckets.size())];
+    }
+    // the slot of the live fingerprint, or nullptr
+    Slot const* find(uint64_t _fingerprint) const;
+    bool insertFingerprint(bcos::protocol::BlockNumber _number, uint64_t _fingerprint);
+    void reserve(size_t _size);
+    void rehash(size_t _capacity);
+
+    uint64_t m_seed;
+    std::vector<Slot> m_slots;
+    std::vector<Bucket> m_buckets;
+    // the live slots, and the live and dead slots
+    size_t m_size = 0;
+    size_t m_used = 0;
+    bcos::protocol::BlockNumber m_expiredNumber = -1;
+};
+}  // namespace bcos::txpool
@@ -24,27 +24,75 @@ using namespace bcos::protocol;
 using namespace bcos::txpool;
 
 void LedgerNonceChecker::initNonceCache(
-    std::map<int64_t, bcos::protocol::NonceListPtr> _initialNonces)
+    std::map<int64_t, bcos::protocol::NonceListPtr> const& _initialNonces)
 {
-    for (auto const& it : _initialNonces)
-    {
-        m_blockNonceCache[it.first] = it.second;
-        TxPoolNonceChecker::batchInsert(it.first, it.second);
-    }
+    auto startT = utcTime();
+    std::unique_lock lock(x_nonces);
+    m_nonces.insertBlocks(_initialNonces);
+    NONCECHECKER_LOG(INFO) << METRIC << LOG_DESC("initNonceCache")
+                           << LOG_KV("blocks", _initialNonces.size())
+                           << LOG_KV("nonceSize", m_nonces.size())
+                           << LOG_KV("memory", m_nonces.memory())
+                           << LOG_KV("timeCost", (utcTime() - startT));
 }
 
 TransactionStatus LedgerNonceChecker::checkNonce(Transaction::ConstPtr _tx, bool _shouldUpdate)
 {
     // check nonce
-    auto status = TxPoolNonceChecker::checkNonce(_tx, _shouldUpdate);
-    if (status != TransactionStatus::None)
+    auto nonce = _tx->nonce();
+    if (_shouldUpdate)
+    {
+        std::unique_lock lock(x_nonces);
+        if (!m_nonces.insert(m_blockNumber, nonce))
+        {
+            return TransactionStatus::NonceCheckFail;
+        }
+    }
+    else if (exists(nonce))
     {
-        return status;
+        return TransactionStatus::NonceCheckFail;
     }
     // check blockLimit
     return checkBlockLimit(_tx);
 }
 
+bool LedgerNonceChecker::exists(NonceType const& _nonce)
+{
+    std::shared_lock lock(x_nonces);
+    return m_nonces.contains(_nonce);
+}
+
+void LedgerNonceChecker::insert(NonceType const& _nonce)
+{
+    std::unique_lock lock(x_nonces);
+    m_nonces.insert(m_blockNumber, _nonce);
+}
+
+void LedgerNonceChecker::remove(NonceType const& _nonce)
+{
+    std::unique_lock lock(x_nonces);
+    m_nonces.erase(_nonce);
+}
+
+void LedgerNonceChecker::batchRemove(NonceList const& _nonceList)
+{
+    std::unique_lock lock(x_nonces);
+    for (auto const& nonce : _nonceList)
+    {
+        m_nonces.erase(nonce);
+    }
+}
+
+void LedgerNonceChecker::batchRemove(tbb::concurrent_unordered_set<bcos::protocol::NonceType,
+    std::hash<bcos::crypto::HashType>> const& _nonceList)
+{
+    std::unique_lock lock(x_nonces);
+    for (auto const& nonce : _nonceList)
+    {
+        m_nonces.erase(nonce);
+    }
+}
+
 TransactionStatus LedgerNonceChecker::checkBlockLimit(bcos::protocol::Transaction::ConstPtr _tx)
 {
     auto blockNumber = m_blockNumber.load();
@@ -67,33 +115,12 @@ void LedgerNonceChecker::batchInsert(BlockNumber _batchId, NonceListPtr const& _
     {
         m_blockNumber.store(_batchId);
     }
-    ssize_t batchToBeRemoved = (_batchId > m_blockLimit) ? (_batchId - m_blockLimit) : -1;
-    // insert the latest nonces
-    TxPoolNonceChecker::batchInsert(_batchId, _nonceList);
-
-    WriteGuard l(x_blockNonceCache);
-    if (!m_blockNonceCache.count(_batchId))
-    {
-        m_blockNonceCache[_batchId] = _nonceList;
-        NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert nonceList") << LOG_KV("batchId", _batchId)
-                                << LOG_KV("nonceSize", _nonceList->size());
-    }
-    // the genesis has no nonceList
-    if (batchToBeRemoved == -1)
-    {
-        return;
-    }
-    // remove the expired nonces
-    if (!m_blockNonceCache.count(batchToBeRemoved))
-    {
-        NONCECHECKER_LOG(WARNING) << LOG_DESC("batchInsert: miss cache when remove expired cache")
-                                  << LOG_KV("batchToBeRemoved", batchToBeRemoved);
-        return;
-    }
-    auto nonceList = m_blockNonceCache[batchToBeRemoved];
-    m_blockNonceCache.erase(batchToBeRemoved);
-    batchRemove(*nonceList);
-    NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert: remove expired nonce")
-                            << LOG_KV("batchToBeRemoved", batchToBeRemoved)
-                            << LOG_KV("nonceSize", nonceList->size());
-}
\ No newline at end of file
+    // insert the latest nonces, and drop the bucket of the block _batchId - m_blockLimit
+    std::unique_lock lock(x_nonces);
+    m_nonces.insertBlock(_batchId, *_nonceList);
+    NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert nonceList") << LOG_KV("batchId", _batchId)
+                            << LOG_KV("nonceSize", _nonceList->size())
+                            << LOG_KV("expiredNumber", m_nonces.expiredNumber())
+                            << LOG_KV("totalNonceSize", m_nonces.size())
+                            << LOG_KV("capacity", m_nonces.capacity());
+}
@@ -19,20 +19,27 @@
  * @date 2021-05-10
  */
 #pragma once
-#include "bcos-txpool/txpool/validator/TxPoolNonceChecker.h"
+#include "bcos-txpool/txpool/interfaces/NonceCheckerInterface.h"
+#include "bcos-txpool/txpool/validator/BlockNonceSet.h"
 #include <bcos-framework/ledger/LedgerInterface.h>
+#include <shared_mutex>
 
 namespace bcos
 {
 namespace txpool
 {
-class LedgerNonceChecker : public TxPoolNonceChecker
+/**
+ * @brief check the nonces of the transactions against the nonces of the latest blockLimit blocks
+ * kept in the BlockNonceSet, the nonces of a block expire together when the block out of the
+ * blockLimit
+ */
+class LedgerNonceChecker : public NonceCheckerInterface
 {
 public:
     LedgerNonceChecker(
         std::shared_ptr<std::map<int64_t, bcos::protocol::NonceListPtr> > _initialNonces,
         bcos::protocol::BlockNumber _blockNumber, int64_t _blockLimit)
-      : TxPoolNonceChecker(), m_blockNumber(_blockNumber), m_blockLimit(_blockLimit)
+      : m_blockNumber(_blockNumber), m_blockLimit(_blockLimit), m_nonces(_blockLimit)
     {
         if (_initialNonces)
         {
@@ -42,24 +49,28 @@ public:
     bcos::protocol::TransactionStatus checkNonce(
         bcos::protocol::Transaction::ConstPtr _tx, bool _shouldUpdate = false) override;
 
+    bool exists(bcos::protocol::NonceType const& _nonce) override;
+    void insert(bcos::protocol::NonceType const& _nonce) override;
     void batchInsert(bcos::protocol::BlockNumber _batchId,
         bcos::protocol::NonceListPtr const& _nonceList) override;
+    void batchRemove(bcos::protocol::NonceList const& _nonceList) override;
+    void batchRemove(tbb::concurrent_unordered_set<bcos::protocol::NonceType,
+        std::hash<bcos::crypto::HashType>> const& _nonceList) override;
 
 protected:
+    void remove(bcos::protocol::NonceType const& _nonce) override;
+
     virtual bcos::protocol::TransactionStatus checkBlockLimit(
         bcos::protocol::Transaction::ConstPtr _tx);
-    virtual void initNonceCache(std::map<int64_t, bcos::protocol::NonceListPtr> _initialNonces);
+    virtual void initNonceCache(
+        std::map<int64_t, bcos::protocol::NonceListPtr> const& _initialNonces);
 
 private:
     std::atomic<bcos::protocol::BlockNumber> m_blockNumber = {0};
     int64_t m_blockLimit;
 
-    /// cache the block nonce to in case of accessing the DB to get nonces of given block frequently
-    /// key: block number
-    /// value: all the nonces of a given block
-    /// we cache at most m_blockLimit entries(occuppy about 32KB)
-    std::map<int64_t, bcos::protocol::NonceListPtr> m_blockNonceCache;
-    mutable SharedMutex x_blockNonceCache;
+    BlockNonceSet m_nonces;
+    mutable std::shared_mutex x_nonces;
 };
 }  // namespace txpool
 }  // namespace bcos
\ No newline at end of file
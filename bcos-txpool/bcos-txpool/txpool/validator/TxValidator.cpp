@@ -25,6 +25,17 @@ using namespace bcos::protocol;
 using namespace bcos::txpool;
 
 TransactionStatus TxValidator::verify(bcos::protocol::Transaction::ConstPtr _tx)
+{
+    auto status = verifyWithoutNonceUpdate(_tx);
+    if (status != TransactionStatus::None)
+    {
+        return status;
+    }
+    m_txPoolNonceChecker->insert(_tx->nonce());
+    return TransactionStatus::None;
+}
+
+TransactionStatus TxValidator::verifyWithoutNonceUpdate(bcos::protocol::Transaction::ConstPtr _tx)
 {
     if (_tx->invalid())
     {
@@ -64,10 +75,14 @@ TransactionStatus TxValidator::verify(bcos::protocol::Transaction::ConstPtr _tx)
     {
         _tx->setSystemTx(true);
     }
-    m_txPoolNonceChecker->insert(_tx->nonce());
     return TransactionStatus::None;
 }
 
+TransactionStatus TxValidator::acceptNonce(bcos::protocol::Transaction::ConstPtr _tx)
+{
+    return m_txPoolNonceChecker->checkNonce(_tx, true);
+}
+
 TransactionStatus TxValidator::submittedToChain(bcos::protocol::Transaction::ConstPtr _tx)
 {
     // compare with nonces stored on-chain
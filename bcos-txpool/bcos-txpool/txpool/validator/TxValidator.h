@@ -42,6 +42,10 @@ public:
     ~TxValidator() override {}
 
     bcos::protocol::TransactionStatus verify(bcos::protocol::Transaction::ConstPtr _tx) override;
+    bcos::protocol::TransactionStatus verifyWithoutNonceUpdate(
+        bcos::protocol::Transaction::ConstPtr _tx) override;
+    bcos::protocol::TransactionStatus acceptNonce(
+        bcos::protocol::Transaction::ConstPtr _tx) override;
     bcos::protocol::TransactionStatus submittedToChain(
         bcos::protocol::Transaction::ConstPtr _tx) override;
 
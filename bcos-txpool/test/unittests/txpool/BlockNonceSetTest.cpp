@@ -0,0 +1,110 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit test for the block-bucketed nonce set
+ * @file BlockNonceSetTest.cpp
+ * @date 2022-12-19
+ */
+#include "bcos-txpool/txpool/validator/BlockNonceSet.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(blockNonceSetTest, TestPromptFixture)
+
+NonceListPtr fakeNonceList(BlockNumber _number, size_t _size)
+{
+    auto nonceList = std::make_shared<NonceList>();
+    for (size_t i = 0; i < _size; ++i)
+    {
+        nonceList->emplace_back((u256(_number) << 128) + i);
+    }
+    return nonceList;
+}
+
+BOOST_AUTO_TEST_CASE(testExpireByBlock)
+{
+    int64_t window = 10;
+    BlockNonceSet nonces(window);
+    for (BlockNumber number = 1; number <= 30; ++number)
+    {
+        nonces.insertBlock(number, *fakeNonceList(number, 100));
+        // only the nonces of the latest window blocks are kept
+        BOOST_CHECK_EQUAL(nonces.size(), std::min<BlockNumber>(number, window) * 100);
+        BOOST_CHECK_EQUAL(nonces.expiredNumber(), std::max<BlockNumber>(number - window, -1));
+    }
+    for (BlockNumber number = 1; number <= 30; ++number)
+    {
+        auto exists = number > 30 - window;
+        auto nonceList = fakeNonceList(number, 100);
+        for (auto const& nonce : *nonceList)
+        {
+            BOOST_CHECK_EQUAL(nonces.contains(nonce), exists);
+        }
+    }
+    // the dead slots of the expired blocks are reused, and dropped when rehashed
+    BOOST_CHECK_LE(nonces.capacity(), 4096);
+
+    // the duplicated nonce and the nonce of the expired block can't be inserted
+    auto nonce = fakeNonceList(30, 1)->front();
+    BOOST_CHECK(!nonces.insert(30, nonce));
+    BOOST_CHECK(!nonces.insert(20, u256(12345)));
+    BOOST_CHECK(!nonces.contains(u256(12345)));
+
+    nonces.erase(nonce);
+    BOOST_CHECK(!nonces.contains(nonce));
+    BOOST_CHECK_EQUAL(nonces.size(), window * 100 - 1);
+    BOOST_CHECK(nonces.insert(30, nonce));
+    BOOST_CHECK(nonces.contains(nonce));
+
+    // the block far ahead expires all the blocks
+    nonces.insertBlock(100, *fakeNonceList(100, 10));
+    BOOST_CHECK_EQUAL(nonces.size(), 10);
+    BOOST_CHECK(!nonces.contains(nonce));
+}
+
+BOOST_AUTO_TEST_CASE(testInsertBlocks)
+{
+    int64_t window = 50;
+    std::map<BlockNumber, NonceListPtr> blocks;
+    for (BlockNumber number = 1; number <= 100; ++number)
+    {
+        blocks[number] = fakeNonceList(number, 200);
+    }
+    BlockNonceSet nonces(window);
+    nonces.insertBlocks(blocks);
+    BOOST_CHECK_EQUAL(nonces.size(), window * 200);
+    BOOST_CHECK_EQUAL(nonces.expiredNumber(), 100 - window);
+    for (auto const& [number, nonceList] : blocks)
+    {
+        for (auto const& nonce : *nonceList)
+        {
+            BOOST_CHECK_EQUAL(nonces.contains(nonce), number > 100 - window);
+        }
+    }
+    nonces.insertBlock(101, *fakeNonceList(101, 200));
+    BOOST_CHECK_EQUAL(nonces.size(), window * 200);
+    BOOST_CHECK(!nonces.contains(blocks[51]->front()));
+    BOOST_CHECK(nonces.contains(blocks[52]->front()));
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -21,6 +21,7 @@
 #include "bcos-crypto/interfaces/crypto/KeyPairInterface.h"
 #include "bcos-crypto/signature/sm2/SM2Crypto.h"
 #include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-txpool/txpool/storage/TxPriority.h"
 #include "test/unittests/txpool/TxPoolFixture.h"
 #include <bcos-crypto/hash/Keccak256.h>
 #include <bcos-crypto/hash/SM3.h>
@@ -28,6 +29,7 @@
 #include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-tars-protocol/testutil/FakeTransaction.h>
+#include <bcos-task/Wait.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/test/unit_test.hpp>
@@ -648,6 +650,339 @@ BOOST_AUTO_TEST_CASE(fillWithSubmit)
     //     });
     // fillPromise.get_future().get();
 }
+BOOST_AUTO_TEST_CASE(batchImportWithDuplicatedNonce)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    std::string groupId = "group_test_for_txpool";
+    std::string chainId = "chain_test_for_txpool";
+    int64_t blockLimit = 10;
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto txpoolStorage = faker->txpool()->txpoolStorage();
+    auto ledger = faker->ledger();
+
+    auto txs = std::make_shared<Transactions>();
+    auto nonce = utcTime() + 3000000;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        txs->emplace_back(fakeTransaction(cryptoSuite, nonce + i,
+            ledger->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId()));
+    }
+    // the txs of the same batch with the same nonce, only the first one is admitted
+    txs->emplace_back(fakeTransaction(cryptoSuite, nonce, ledger->blockNumber() + blockLimit - 4,
+        faker->chainId(), faker->groupId()));
+    // invalid groupId
+    txs->emplace_back(fakeTransaction(cryptoSuite, nonce + 100,
+        ledger->blockNumber() + blockLimit - 4, faker->chainId(), "invalidGroup"));
+    // duplicated tx
+    txs->emplace_back((*txs)[1]);
+
+    txpoolStorage->batchImportTxs(txs);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 10);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK(txpoolStorage->exist((*txs)[i]->hash()));
+    }
+    BOOST_CHECK(!txpoolStorage->exist((*txs)[10]->hash()));
+    BOOST_CHECK(!txpoolStorage->exist((*txs)[11]->hash()));
+    txpoolStorage->clear();
+}
+
+BOOST_AUTO_TEST_CASE(concurrentSubmitTransaction)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    std::string groupId = "group_test_for_txpool";
+    std::string chainId = "chain_test_for_txpool";
+    int64_t blockLimit = 10;
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto txpoolStorage = faker->txpool()->txpoolStorage();
+    auto ledger = faker->ledger();
+
+    size_t threadsNum = 4;
+    size_t uniqueTxsNum = 40;
+    size_t duplicatedTxsNum = 10;
+    std::vector<Transaction::Ptr> txs;
+    auto nonce = utcTime() + 6000000;
+    for (size_t i = 0; i < uniqueTxsNum; ++i)
+    {
+        txs.emplace_back(fakeTransaction(cryptoSuite, nonce + i,
+            ledger->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId()));
+    }
+    // the txs with the same nonce as the first txs, submitted from another thread
+    for (size_t i = 0; i < duplicatedTxsNum; ++i)
+    {
+        txs.emplace_back(fakeTransaction(cryptoSuite, nonce + i,
+            ledger->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId()));
+    }
+    auto threadOf = [&](size_t _index) {
+        return _index < uniqueTxsNum ? _index % threadsNum :
+                                       (_index - uniqueTxsNum + 1) % threadsNum;
+    };
+
+    std::vector<std::atomic<size_t>> callbacks(txs.size());
+    std::vector<int32_t> errors(txs.size(), 0);
+    std::atomic<size_t> rejectedTxs = 0;
+    std::atomic<size_t> finishedTxs = 0;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadsNum; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < txs.size(); ++i)
+            {
+                if (threadOf(i) != t)
+                {
+                    continue;
+                }
+                task::wait(txpoolStorage->submitTransaction(txs[i]), [&, i](auto&& _result) {
+                    using ResultType = std::remove_cvref_t<decltype(_result)>;
+                    if constexpr (std::is_same_v<ResultType, std::exception_ptr>)
+                    {
+                        try
+                        {
+                            std::rethrow_exception(_result);
+                        }
+                        catch (bcos::Error const& e)
+                        {
+                            errors[i] = e.errorCode();
+                        }
+                        catch (...)
+                        {
+                            errors[i] = -1;
+                        }
+                        ++rejectedTxs;
+                    }
+                    ++callbacks[i];
+                    ++finishedTxs;
+                });
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto startT = utcTime();
+    while (txpoolStorage->size() + rejectedTxs < txs.size() && utcTime() - startT <= 10000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    // only one of the txs with the same nonce is admitted
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), uniqueTxsNum);
+    BOOST_CHECK_EQUAL(rejectedTxs.load(), duplicatedTxsNum);
+    for (size_t i = 0; i < duplicatedTxsNum; ++i)
+    {
+        auto duplicated = uniqueTxsNum + i;
+        BOOST_CHECK(txpoolStorage->exist(txs[i]->hash()) !=
+                    txpoolStorage->exist(txs[duplicated]->hash()));
+        auto rejected = txpoolStorage->exist(txs[i]->hash()) ? duplicated : i;
+        BOOST_CHECK_EQUAL(errors[rejected], (int32_t)TransactionStatus::NonceCheckFail);
+        BOOST_CHECK_EQUAL(callbacks[rejected].load(), 1);
+    }
+
+    // the callbacks of the admitted txs are called when they are committed
+    auto txsResult = std::make_shared<TransactionSubmitResults>();
+    for (auto const& tx : txs)
+    {
+        if (!txpoolStorage->exist(tx->hash()))
+        {
+            continue;
+        }
+        auto txResult = std::make_shared<TransactionSubmitResultImpl>();
+        txResult->setTxHash(tx->hash());
+        txResult->setStatus((uint32_t)TransactionStatus::None);
+        txsResult->emplace_back(txResult);
+    }
+    txpoolStorage->batchRemove(ledger->blockNumber() + 1, *txsResult);
+    startT = utcTime();
+    while (finishedTxs < txs.size() && utcTime() - startT <= 10000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 0);
+    for (size_t i = 0; i < txs.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(callbacks[i].load(), 1);
+    }
+    txpoolStorage->clear();
+}
+
+BOOST_AUTO_TEST_CASE(memoryLimitWithSpill)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    std::string groupId = "group_test_for_txpool";
+    std::string chainId = "chain_test_for_txpool";
+    int64_t blockLimit = 10;
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto ledger = faker->ledger();
+
+    auto txs = std::make_shared<Transactions>();
+    auto nonce = utcTime() + 4000000;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto tx = fakeTransaction(cryptoSuite, nonce + i, ledger->blockNumber() + blockLimit - 4,
+            faker->chainId(), faker->groupId());
+        tx->setImportTime(utcTime() + i);
+        txs->emplace_back(tx);
+    }
+    // keep 5 txs in memory, the latest imported 5 txs are spilled
+    auto txMemory = MemoryStorage::txMemory(*(*txs)[0]);
+    auto spillPath = boost::filesystem::temp_directory_path() /
+                     boost::filesystem::unique_path("txpoolSpillTest-%%%%%%");
+    auto txpoolConfig = faker->txpool()->txpoolConfig();
+    txpoolConfig->setMemoryLimit(txMemory * 5 + txMemory / 2);
+    txpoolConfig->setSpillPath(spillPath.string());
+    auto txpoolStorage = std::make_shared<MemoryStorage>(txpoolConfig);
+    txpoolStorage->start();
+
+    txpoolStorage->batchImportTxs(txs);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 5);
+    BOOST_CHECK_EQUAL(txpoolStorage->spilledTxsSize(), 5);
+    BOOST_CHECK(txpoolStorage->txsMemory() <= txpoolConfig->memoryLimit());
+    for (size_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(txpoolStorage->exist((*txs)[i]->hash()), i < 5);
+    }
+    // the spilled txs are still pending
+    auto duplicatedTxs = std::make_shared<Transactions>();
+    duplicatedTxs->emplace_back((*txs)[9]);
+    txpoolStorage->batchImportTxs(duplicatedTxs);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 5);
+    BOOST_CHECK_EQUAL(txpoolStorage->spilledTxsSize(), 5);
+
+    // the txs in memory and a spilled tx committed, the other spilled txs reloaded
+    auto txsResult = std::make_shared<TransactionSubmitResults>();
+    for (size_t i = 0; i < 6; ++i)
+    {
+        auto txResult = std::make_shared<TransactionSubmitResultImpl>();
+        txResult->setTxHash((*txs)[i]->hash());
+        txResult->setStatus((uint32_t)TransactionStatus::None);
+        txsResult->emplace_back(txResult);
+    }
+    txpoolStorage->batchRemove(ledger->blockNumber() + 1, *txsResult);
+    BOOST_CHECK_EQUAL(txpoolStorage->spilledTxsSize(), 0);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 4);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(txpoolStorage->exist((*txs)[i]->hash()), i >= 6);
+    }
+    BOOST_CHECK_EQUAL(txpoolStorage->txsMemory(), txMemory * 4);
+
+    // the txs of the sender submitting the most txs are ranked higher
+    SenderFairPriority priority;
+    auto senderKeyPair = signatureImpl->generateKeyPair();
+    std::vector<Transaction::Ptr> senderTxs;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        senderTxs.emplace_back(fakeTransaction(cryptoSuite, senderKeyPair, "", asBytes("test"),
+            nonce + 100 + i, 100, chainId, groupId));
+        BOOST_CHECK_EQUAL(priority.onInserted(*senderTxs.back()), (int64_t)i + 1);
+    }
+    BOOST_CHECK_EQUAL(priority.onInserted(*(*txs)[0]), 1);
+    priority.onRemoved(*senderTxs[0]);
+    BOOST_CHECK_EQUAL(priority.pendingTxs(senderTxs[0]->sender()), 2);
+    priority.clear();
+    BOOST_CHECK_EQUAL(priority.pendingTxs(senderTxs[0]->sender()), 0);
+
+    txpoolStorage->clear();
+    txpoolStorage->stop();
+    boost::filesystem::remove_all(spillPath);
+}
+
+BOOST_AUTO_TEST_CASE(memoryLimitWithSealedTxs)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    std::string groupId = "group_test_for_txpool";
+    std::string chainId = "chain_test_for_txpool";
+    int64_t blockLimit = 10;
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto ledger = faker->ledger();
+
+    auto txs = std::make_shared<Transactions>();
+    auto nonce = utcTime() + 5000000;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        auto tx = fakeTransaction(cryptoSuite, nonce + i, ledger->blockNumber() + blockLimit - 4,
+            faker->chainId(), faker->groupId());
+        tx->setImportTime(utcTime() + i);
+        txs->emplace_back(tx);
+    }
+    auto txMemory = MemoryStorage::txMemory(*(*txs)[0]);
+    auto txpoolConfig = faker->txpool()->txpoolConfig();
+    txpoolConfig->setMemoryLimit(txMemory * 3 + txMemory / 2);
+    txpoolConfig->setSpillPath("");
+    auto txpoolStorage = std::make_shared<MemoryStorage>(txpoolConfig);
+    txpoolStorage->start();
+
+    // the txs of the proposals exceed the memory limit, they are sealed and never evicted
+    for (size_t i = 0; i < 5; ++i)
+    {
+        BOOST_CHECK(txpoolStorage->enforceSubmitTransaction((*txs)[i]) == TransactionStatus::None);
+    }
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 5);
+    BOOST_CHECK_EQUAL(txpoolStorage->txsMemory(), txMemory * 5);
+    BOOST_CHECK_EQUAL(txpoolStorage->unsealedTxsMemory(), 0);
+
+    // only the unsealed txs are evicted
+    auto unsealedTxs = std::make_shared<Transactions>();
+    unsealedTxs->emplace_back((*txs)[5]);
+    unsealedTxs->emplace_back((*txs)[6]);
+    txpoolStorage->batchImportTxs(unsealedTxs);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 5);
+    BOOST_CHECK_EQUAL(txpoolStorage->txsMemory(), txMemory * 5);
+    BOOST_CHECK_EQUAL(txpoolStorage->unsealedTxsMemory(), 0);
+    for (size_t i = 0; i < 7; ++i)
+    {
+        BOOST_CHECK_EQUAL(txpoolStorage->exist((*txs)[i]->hash()), i < 5);
+    }
+
+    // the unsealed txs of the failed proposal are put back to the eviction queue
+    HashList proposalTxs = {(*txs)[0]->hash(), (*txs)[1]->hash()};
+    txpoolStorage->batchMarkTxs(proposalTxs, (*txs)[0]->batchId(), (*txs)[0]->batchHash(), false);
+    BOOST_CHECK_EQUAL(txpoolStorage->unsealedTxsMemory(), txMemory * 2);
+    unsealedTxs->clear();
+    unsealedTxs->emplace_back((*txs)[7]);
+    txpoolStorage->batchImportTxs(unsealedTxs);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 3);
+    BOOST_CHECK_EQUAL(txpoolStorage->txsMemory(), txMemory * 3);
+    BOOST_CHECK_EQUAL(txpoolStorage->unsealedTxsMemory(), 0);
+    for (size_t i = 0; i < 8; ++i)
+    {
+        BOOST_CHECK_EQUAL(txpoolStorage->exist((*txs)[i]->hash()), i >= 2 && i < 5);
+    }
+
+    txpoolStorage->clear();
+    BOOST_CHECK_EQUAL(txpoolStorage->txsMemory(), 0);
+    BOOST_CHECK_EQUAL(txpoolStorage->unsealedTxsMemory(), 0);
+    txpoolStorage->stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
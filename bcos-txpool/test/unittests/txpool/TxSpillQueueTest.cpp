@@ -0,0 +1,174 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit test for the on-disk queue of the spilled txs
+ * @file TxSpillQueueTest.cpp
+ * @date 2022-12-26
+ */
+#include "bcos-txpool/txpool/storage/TxSpillQueue.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace bcos::txpool;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(txSpillQueueTest, TestPromptFixture)
+
+std::vector<bytesConstPtr> fakeDatas(size_t _start, size_t _size)
+{
+    std::vector<bytesConstPtr> datas;
+    for (auto i = _start; i < _start + _size; ++i)
+    {
+        // the records of different sizes, including the empty one
+        datas.emplace_back(std::make_shared<bytes>(i % 100, (byte)i));
+    }
+    return datas;
+}
+
+BOOST_AUTO_TEST_CASE(pushAndPop)
+{
+    auto path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("txSpillQueueTest-%%%%%%");
+    {
+        // the segments of 1KB
+        TxSpillQueue queue(path, 1024);
+        queue.open();
+        queue.push(fakeDatas(0, 200));
+        BOOST_CHECK_EQUAL(queue.size(), 200);
+
+        // pop across the segments, and push to the segment being read
+        auto datas = queue.pop(150);
+        BOOST_CHECK_EQUAL(datas.size(), 150);
+        queue.push(fakeDatas(200, 100));
+        auto remaining = queue.pop(1000);
+        BOOST_CHECK_EQUAL(remaining.size(), 150);
+        datas.insert(datas.end(), remaining.begin(), remaining.end());
+        for (size_t i = 0; i < datas.size(); ++i)
+        {
+            BOOST_CHECK(*datas[i] == bytes(i % 100, (byte)i));
+        }
+        BOOST_CHECK_EQUAL(queue.size(), 0);
+        BOOST_CHECK_EQUAL(queue.bytes(), 0);
+        BOOST_CHECK(queue.pop(10).empty());
+        // all the popped segments removed
+        BOOST_CHECK(boost::filesystem::is_empty(path));
+
+        queue.push(fakeDatas(0, 100));
+        queue.clear();
+        BOOST_CHECK_EQUAL(queue.size(), 0);
+        BOOST_CHECK(queue.pop(10).empty());
+        BOOST_CHECK(boost::filesystem::is_empty(path));
+
+        queue.push(fakeDatas(0, 10));
+        BOOST_CHECK_EQUAL(queue.pop(10).size(), 10);
+    }
+    {
+        // the segments left by the last run are removed when opened
+        TxSpillQueue queue(path);
+        queue.push(fakeDatas(0, 10));
+        TxSpillQueue reopenedQueue(path);
+        reopenedQueue.open();
+        BOOST_CHECK(boost::filesystem::is_empty(path));
+        BOOST_CHECK_EQUAL(reopenedQueue.size(), 0);
+    }
+    boost::filesystem::remove_all(path);
+}
+
+BOOST_AUTO_TEST_CASE(pushFailure)
+{
+    auto path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("txSpillQueueTest-%%%%%%");
+    {
+        TxSpillQueue queue(path, 1024);
+        queue.open();
+        BOOST_CHECK_EQUAL(queue.push(fakeDatas(0, 5)).size(), 5);
+        auto segment = *boost::filesystem::directory_iterator(path);
+        auto segmentSize = boost::filesystem::file_size(segment.path());
+
+        // the next segment can not be created, none of the records pushed
+        boost::filesystem::create_directory(path / "1.spill");
+        BOOST_CHECK_THROW(queue.push(fakeDatas(5, 100)), TxSpillQueueException);
+        BOOST_CHECK_EQUAL(queue.size(), 5);
+        BOOST_CHECK_EQUAL(boost::filesystem::file_size(segment.path()), segmentSize);
+        boost::filesystem::remove_all(path / "1.spill");
+
+        BOOST_CHECK_EQUAL(queue.push(fakeDatas(5, 10)).size(), 10);
+        auto datas = queue.pop(100);
+        BOOST_CHECK_EQUAL(datas.size(), 15);
+        for (size_t i = 0; i < datas.size(); ++i)
+        {
+            BOOST_CHECK(*datas[i] == bytes(i % 100, (byte)i));
+        }
+        BOOST_CHECK_EQUAL(queue.size(), 0);
+        BOOST_CHECK_EQUAL(queue.bytes(), 0);
+    }
+    boost::filesystem::remove_all(path);
+}
+
+BOOST_AUTO_TEST_CASE(corruptSegment)
+{
+    auto path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("txSpillQueueTest-%%%%%%");
+    {
+        TxSpillQueue queue(path, 1024);
+        queue.open();
+        auto segments = queue.push(fakeDatas(0, 200));
+        BOOST_CHECK_EQUAL(segments.size(), 200);
+        BOOST_CHECK_GT(segments.back(), segments.front() + 2);
+
+        // the short segment
+        auto shortSegment = segments.front();
+        boost::filesystem::resize_file(path / (std::to_string(shortSegment) + ".spill"), 2);
+        // the record of the segment larger than the segment
+        auto corruptSegment = segments[100];
+        {
+            std::fstream file((path / (std::to_string(corruptSegment) + ".spill")).string(),
+                std::ios::binary | std::ios::in | std::ios::out);
+            uint32_t size = 0xffffffff;
+            file.write((char const*)&size, sizeof(size));
+        }
+
+        std::vector<uint64_t> droppedSegments;
+        auto datas = queue.pop(1000, &droppedSegments);
+        BOOST_CHECK(droppedSegments == std::vector<uint64_t>({shortSegment, corruptSegment}));
+        size_t index = 0;
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            if (segments[i] == shortSegment || segments[i] == corruptSegment)
+            {
+                continue;
+            }
+            BOOST_REQUIRE_LT(index, datas.size());
+            BOOST_CHECK(*datas[index++] == bytes(i % 100, (byte)i));
+        }
+        BOOST_CHECK_EQUAL(index, datas.size());
+        BOOST_CHECK_EQUAL(queue.size(), 0);
+        BOOST_CHECK_EQUAL(queue.bytes(), 0);
+        BOOST_CHECK(boost::filesystem::is_empty(path));
+
+        // the queue is still usable
+        queue.push(fakeDatas(0, 10));
+        BOOST_CHECK_EQUAL(queue.pop(10).size(), 10);
+    }
+    boost::filesystem::remove_all(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
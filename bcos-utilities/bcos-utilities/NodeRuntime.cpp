@@ -0,0 +1,448 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: node-wide runtime shared by the modules of all groups
+ *
+ * @file NodeRuntime.cpp
+ * @date 2022-11-10
+ */
+#include "NodeRuntime.h"
+#include <boost/asio/post.hpp>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <time.h>
+
+using namespace bcos;
+
+#define RUNTIME_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("NodeRuntime")
+
+struct NodeRuntime::Channel
+{
+    Channel(GroupState* _group, TaskPriority _priority, size_t _concurrency, std::string _name)
+      : group(_group),
+        priority(static_cast<size_t>(_priority)),
+        concurrency(std::max<size_t>(_concurrency, 1)),
+        name(std::move(_name))
+    {}
+
+    GroupState* group;
+    size_t priority;
+    size_t concurrency;
+    std::string name;
+
+    // guarded by NodeRuntime::x_mutex
+    std::deque<QueuedTask> tasks;
+    size_t running = 0;
+    bool ready = false;
+    bool closed = false;
+};
+
+struct NodeRuntime::GroupState
+{
+    explicit GroupState(std::string _name) : name(std::move(_name)) {}
+
+    std::string name;
+    // guarded by NodeRuntime::x_mutex
+    std::array<std::deque<ChannelPtr>, TASK_PRIORITY_COUNT> readyChannels;
+    std::array<bool, TASK_PRIORITY_COUNT> scheduled = {false, false, false};
+    uint64_t pendingTasks = 0;
+
+    std::atomic<uint64_t> cpuTimeNs = {0};
+    std::atomic<uint64_t> waitTimeNs = {0};
+    std::atomic<uint64_t> executedTasks = {0};
+};
+
+namespace
+{
+thread_local NodeRuntime::Scope* t_scope = nullptr;
+// the channel whose task is running on the current thread
+thread_local void* t_runningChannel = nullptr;
+
+void pinThread([[maybe_unused]] size_t _index)
+{
+#if defined(__linux__)
+    auto cpuCount = std::max(std::thread::hardware_concurrency(), 1U);
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(_index % cpuCount, &cpuSet);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0)
+    {
+        RUNTIME_LOG(WARNING) << LOG_DESC("pin thread failed") << LOG_KV("cpu", _index % cpuCount);
+    }
+#endif
+}
+
+uint64_t threadCpuTimeNs()
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+}  // namespace
+
+NodeRuntime::NodeRuntime(
+    std::string _name, size_t _workerThreads, size_t _ioThreads, bool _pinThreads)
+  : m_name(std::move(_name)),
+    m_workerThreads(std::max<size_t>(_workerThreads, 1)),
+    m_pinThreads(_pinThreads)
+{
+    _ioThreads = std::max<size_t>(_ioThreads, 1);
+    for (size_t i = 0; i < _ioThreads; ++i)
+    {
+        m_ioContexts.emplace_back(std::make_unique<boost::asio::io_context>(1));
+        m_ioWorks.emplace_back(boost::asio::make_work_guard(*m_ioContexts.back()));
+    }
+    for (size_t i = 0; i < m_workerThreads; ++i)
+    {
+        m_workers.create_thread([this, i]() {
+            bcos::pthread_setThreadName(m_name + "-" + std::to_string(i));
+            if (m_pinThreads)
+            {
+                pinThread(i);
+            }
+            workerLoop();
+        });
+    }
+    for (size_t i = 0; i < m_ioContexts.size(); ++i)
+    {
+        m_ioWorkers.create_thread([this, i]() {
+            bcos::pthread_setThreadName(m_name + "-io-" + std::to_string(i));
+            if (m_pinThreads)
+            {
+                pinThread(m_workerThreads + i);
+            }
+            m_ioContexts[i]->run();
+        });
+    }
+    RUNTIME_LOG(INFO) << LOG_DESC("create NodeRuntime") << LOG_KV("name", m_name)
+                      << LOG_KV("workerThreads", m_workerThreads)
+                      << LOG_KV("ioThreads", m_ioContexts.size())
+                      << LOG_KV("pinThreads", m_pinThreads);
+}
+
+NodeRuntime::~NodeRuntime()
+{
+    stop();
+}
+
+void NodeRuntime::stop()
+{
+    if (m_stopped.exchange(true))
+    {
+        return;
+    }
+    {
+        boost::unique_lock<boost::mutex> l(x_mutex);
+    }
+    m_signal.notify_all();
+    m_channelIdle.notify_all();
+    if (!m_workers.is_this_thread_in())
+    {
+        m_workers.join_all();
+    }
+
+    if (m_reportTimer)
+    {
+        boost::asio::post(*m_ioContexts[0], [this]() { m_reportTimer->cancel(); });
+    }
+    for (auto& work : m_ioWorks)
+    {
+        work.reset();
+    }
+    for (auto& ioContext : m_ioContexts)
+    {
+        ioContext->stop();
+    }
+    if (!m_ioWorkers.is_this_thread_in())
+    {
+        m_ioWorkers.join_all();
+    }
+    RUNTIME_LOG(INFO) << LOG_DESC("NodeRuntime stopped") << LOG_KV("name", m_name);
+}
+
+NodeRuntime::GroupState* NodeRuntime::groupState(std::string const& _group)
+{
+    auto it = m_groups.find(_group);
+    if (it == m_groups.end())
+    {
+        it = m_groups.emplace(_group, std::make_unique<GroupState>(_group)).first;
+    }
+    return it->second.get();
+}
+
+NodeRuntime::ChannelPtr NodeRuntime::createChannel(
+    std::string const& _group, TaskPriority _priority, size_t _concurrency, std::string _name)
+{
+    boost::unique_lock<boost::mutex> l(x_mutex);
+    return std::make_shared<Channel>(
+        groupState(_group), _priority, _concurrency, std::move(_name));
+}
+
+void NodeRuntime::post(ChannelPtr const& _channel, std::function<void()> _task)
+{
+    {
+        boost::unique_lock<boost::mutex> l(x_mutex);
+        if (_channel->closed || m_stopped)
+        {
+            return;
+        }
+        _channel->tasks.emplace_back(QueuedTask{std::move(_task), std::chrono::steady_clock::now()});
+        _channel->group->pendingTasks++;
+        if (_channel->ready || _channel->running >= _channel->concurrency)
+        {
+            return;
+        }
+        makeReady(_channel);
+    }
+    m_signal.notify_one();
+}
+
+void NodeRuntime::closeChannel(ChannelPtr const& _channel)
+{
+    boost::unique_lock<boost::mutex> l(x_mutex);
+    _channel->closed = true;
+    _channel->group->pendingTasks -= _channel->tasks.size();
+    _channel->tasks.clear();
+    // wait for the running tasks like joining the threads of a ThreadPool, except the task
+    // closing its own channel
+    auto self = (t_runningChannel == _channel.get()) ? 1U : 0U;
+    m_channelIdle.wait(l, [&_channel, self]() { return _channel->running <= self; });
+}
+
+bool NodeRuntime::channelClosed(ChannelPtr const& _channel) const
+{
+    boost::unique_lock<boost::mutex> l(x_mutex);
+    return _channel->closed || m_stopped;
+}
+
+void NodeRuntime::makeReady(ChannelPtr const& _channel)
+{
+    auto* group = _channel->group;
+    _channel->ready = true;
+    group->readyChannels[_channel->priority].push_back(_channel);
+    if (!group->scheduled[_channel->priority])
+    {
+        group->scheduled[_channel->priority] = true;
+        m_readyGroups[_channel->priority].push_back(group);
+    }
+}
+
+bool NodeRuntime::pickFrom(size_t _priority, ChannelPtr& _channel, QueuedTask& _task)
+{
+    auto& readyGroups = m_readyGroups[_priority];
+    while (!readyGroups.empty())
+    {
+        auto* group = readyGroups.front();
+        readyGroups.pop_front();
+        auto& readyChannels = group->readyChannels[_priority];
+        auto channel = std::move(readyChannels.front());
+        readyChannels.pop_front();
+
+        bool picked = false;
+        if (!channel->tasks.empty())
+        {
+            _task = std::move(channel->tasks.front());
+            channel->tasks.pop_front();
+            group->pendingTasks--;
+            channel->running++;
+            picked = true;
+        }
+        // the channel takes its turn again if it can run more tasks
+        if (!channel->tasks.empty() && channel->running < channel->concurrency)
+        {
+            readyChannels.push_back(channel);
+        }
+        else
+        {
+            channel->ready = false;
+        }
+        // the group takes its turn again after the other groups
+        if (!readyChannels.empty())
+        {
+            readyGroups.push_back(group);
+        }
+        else
+        {
+            group->scheduled[_priority] = false;
+        }
+        if (picked)
+        {
+            _channel = std::move(channel);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NodeRuntime::pick(ChannelPtr& _channel, QueuedTask& _task)
+{
+    // the lowest priority goes first once in every STARVATION_PERIOD picks
+    if ((++m_picks) % STARVATION_PERIOD == 0)
+    {
+        for (size_t i = TASK_PRIORITY_COUNT; i > 0; --i)
+        {
+            if (pickFrom(i - 1, _channel, _task))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    for (size_t i = 0; i < TASK_PRIORITY_COUNT; ++i)
+    {
+        if (pickFrom(i, _channel, _task))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void NodeRuntime::workerLoop()
+{
+    while (!m_stopped)
+    {
+        ChannelPtr channel;
+        QueuedTask task;
+        {
+            boost::unique_lock<boost::mutex> l(x_mutex);
+            m_signal.wait(l, [this, &channel, &task]() {
+                return m_stopped || pick(channel, task);
+            });
+            if (!channel)
+            {
+                return;
+            }
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        auto startCpuTime = threadCpuTimeNs();
+        t_runningChannel = channel.get();
+        try
+        {
+            task.task();
+        }
+        catch (std::exception const& e)
+        {
+            RUNTIME_LOG(WARNING) << LOG_DESC("task exception") << LOG_KV("channel", channel->name)
+                                 << LOG_KV("group", channel->group->name)
+                                 << LOG_KV("error", boost::diagnostic_information(e));
+        }
+        auto* group = channel->group;
+        group->cpuTimeNs += threadCpuTimeNs() - startCpuTime;
+        group->waitTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            startTime - task.enqueueTime)
+                                 .count();
+        group->executedTasks++;
+        // release the captures before taking the lock
+        task.task = nullptr;
+        t_runningChannel = nullptr;
+
+        bool notify = false;
+        {
+            boost::unique_lock<boost::mutex> l(x_mutex);
+            channel->running--;
+            if (!channel->ready && !channel->tasks.empty() && !channel->closed)
+            {
+                makeReady(channel);
+                notify = true;
+            }
+            if (channel->closed)
+            {
+                m_channelIdle.notify_all();
+            }
+        }
+        if (notify)
+        {
+            m_signal.notify_one();
+        }
+    }
+}
+
+boost::asio::io_context& NodeRuntime::ioContext(std::string const& _group)
+{
+    return *m_ioContexts[std::hash<std::string>{}(_group) % m_ioContexts.size()];
+}
+
+std::vector<GroupCpuStat> NodeRuntime::groupStats() const
+{
+    std::vector<GroupCpuStat> stats;
+    boost::unique_lock<boost::mutex> l(x_mutex);
+    stats.reserve(m_groups.size());
+    for (auto const& [name, group] : m_groups)
+    {
+        GroupCpuStat stat;
+        stat.group = name;
+        stat.cpuTimeNs = group->cpuTimeNs.load();
+        stat.waitTimeNs = group->waitTimeNs.load();
+        stat.executedTasks = group->executedTasks.load();
+        stat.pendingTasks = group->pendingTasks;
+        stats.emplace_back(std::move(stat));
+    }
+    return stats;
+}
+
+void NodeRuntime::startReport(uint64_t _intervalMs)
+{
+    if (_intervalMs == 0 || m_reportTimer)
+    {
+        return;
+    }
+    m_reportTimer = std::make_unique<boost::asio::steady_timer>(*m_ioContexts[0]);
+    report(_intervalMs);
+}
+
+void NodeRuntime::report(uint64_t _intervalMs)
+{
+    m_reportTimer->expires_after(std::chrono::milliseconds(_intervalMs));
+    auto self = weak_from_this();
+    m_reportTimer->async_wait([self, _intervalMs](boost::system::error_code _error) {
+        auto runtime = self.lock();
+        if (_error || !runtime || runtime->stopped())
+        {
+            return;
+        }
+        for (auto const& stat : runtime->groupStats())
+        {
+            RUNTIME_LOG(INFO) << LOG_DESC("group cpu usage") << LOG_KV("group", stat.group)
+                              << LOG_KV("cpuTime(ms)", stat.cpuTimeNs / 1000000)
+                              << LOG_KV("waitTime(ms)", stat.waitTimeNs / 1000000)
+                              << LOG_KV("executed", stat.executedTasks)
+                              << LOG_KV("pending", stat.pendingTasks);
+        }
+        runtime->report(_intervalMs);
+    });
+}
+
+NodeRuntime::Scope::Scope(Ptr _runtime, std::string _group, TaskPriority _priority)
+  : m_runtime(std::move(_runtime)), m_group(std::move(_group)), m_priority(_priority), m_prev(t_scope)
+{
+    t_scope = this;
+}
+
+NodeRuntime::Scope::~Scope()
+{
+    t_scope = m_prev;
+}
+
+NodeRuntime::Scope const* NodeRuntime::currentScope()
+{
+    return t_scope;
+}
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: node-wide runtime shared by the modules of all groups
+ *
+ * @file NodeRuntime.h
+ * @date 2022-11-10
+ */
+
+#pragma once
+#include "Common.h"
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/thread/thread.hpp>
+#include <array>
+#include <deque>
+#include <memory>
+
+namespace bcos
+{
+// the tasks of higher priority are scheduled first
+enum class TaskPriority : uint8_t
+{
+    Consensus = 0,
+    Sync = 1,
+    Rpc = 2,
+};
+constexpr static size_t TASK_PRIORITY_COUNT = 3;
+
+struct GroupCpuStat
+{
+    std::string group;
+    // the cpu time spent by the tasks of the group
+    uint64_t cpuTimeNs = 0;
+    // the time the tasks of the group waited in the queues
+    uint64_t waitTimeNs = 0;
+    uint64_t executedTasks = 0;
+    uint64_t pendingTasks = 0;
+};
+
+/**
+ * @brief A fixed set of (CPU-pinned) worker threads and io_contexts shared by the modules of all
+ * groups of the node, instead of every ThreadPool/Worker of every group creating its own threads.
+ *
+ * Tasks are posted to channels, a channel belongs to a group and has a priority and a concurrency
+ * limit (1 for a serial executor). Higher priorities are scheduled first (one in
+ * STARVATION_PERIOD picks goes to the lowest non-empty priority so that RPC is never starved),
+ * groups with the same priority are scheduled round-robin, and the cpu time of every task is
+ * accounted to its group.
+ */
+class NodeRuntime : public std::enable_shared_from_this<NodeRuntime>
+{
+public:
+    using Ptr = std::shared_ptr<NodeRuntime>;
+    constexpr static size_t STARVATION_PERIOD = 8;
+
+    struct Channel;
+    using ChannelPtr = std::shared_ptr<Channel>;
+
+    NodeRuntime(std::string _name, size_t _workerThreads, size_t _ioThreads, bool _pinThreads);
+    NodeRuntime(const NodeRuntime&) = delete;
+    NodeRuntime(NodeRuntime&&) = delete;
+    NodeRuntime& operator=(const NodeRuntime&) = delete;
+    NodeRuntime& operator=(NodeRuntime&&) = delete;
+    virtual ~NodeRuntime();
+
+    void stop();
+    bool stopped() const { return m_stopped.load(); }
+
+    // at most _concurrency tasks of the channel run at the same time
+    ChannelPtr createChannel(std::string const& _group, TaskPriority _priority,
+        size_t _concurrency, std::string _name = "");
+    void post(ChannelPtr const& _channel, std::function<void()> _task);
+    // drop the pending tasks and wait for the running tasks, the tasks posted later are ignored
+    void closeChannel(ChannelPtr const& _channel);
+    bool channelClosed(ChannelPtr const& _channel) const;
+
+    // the io_context (for timers, sockets) assigned to the group
+    boost::asio::io_context& ioContext(std::string const& _group);
+
+    std::vector<GroupCpuStat> groupStats() const;
+    // log the cpu usage of every group every _intervalMs
+    void startReport(uint64_t _intervalMs);
+
+    size_t workerThreads() const { return m_workerThreads; }
+    size_t ioThreads() const { return m_ioContexts.size(); }
+
+    /**
+     * @brief the ThreadPools created during the lifetime of a Scope (on the same thread) schedule
+     * their tasks on the runtime with the group and priority of the scope instead of creating
+     * their own threads
+     */
+    class Scope
+    {
+    public:
+        Scope(Ptr _runtime, std::string _group, TaskPriority _priority);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        Ptr const& runtime() const { return m_runtime; }
+        std::string const& group() const { return m_group; }
+        TaskPriority priority() const { return m_priority; }
+
+    private:
+        Ptr m_runtime;
+        std::string m_group;
+        TaskPriority m_priority;
+        Scope* m_prev;
+    };
+    static Scope const* currentScope();
+
+private:
+    struct GroupState;
+    struct QueuedTask
+    {
+        std::function<void()> task;
+        std::chrono::steady_clock::time_point enqueueTime;
+    };
+
+    void workerLoop();
+    // with m_mutex held
+    void makeReady(ChannelPtr const& _channel);
+    bool pick(ChannelPtr& _channel, QueuedTask& _task);
+    bool pickFrom(size_t _priority, ChannelPtr& _channel, QueuedTask& _task);
+    GroupState* groupState(std::string const& _group);
+    void report(uint64_t _intervalMs);
+
+    std::string m_name;
+    size_t m_workerThreads;
+    bool m_pinThreads;
+    std::atomic_bool m_stopped = {false};
+
+    mutable boost::mutex x_mutex;
+    boost::condition_variable m_signal;
+    // notified when a task of a closed channel finished
+    boost::condition_variable m_channelIdle;
+    std::map<std::string, std::unique_ptr<GroupState>> m_groups;
+    // the groups with ready channels, round-robin
+    std::array<std::deque<GroupState*>, TASK_PRIORITY_COUNT> m_readyGroups;
+    uint64_t m_picks = 0;
+    boost::thread_group m_workers;
+
+    std::vector<std::unique_ptr<boost::asio::io_context>> m_ioContexts;
+    std::vector<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> m_ioWorks;
+    boost::thread_group m_ioWorkers;
+    std::unique_ptr<boost::asio::steady_timer> m_reportTimer;
+};
+}  // namespace bcos
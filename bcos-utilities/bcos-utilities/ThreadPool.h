@@ -22,6 +22,7 @@
 
 #pragma once
 #include "Common.h"
+#include "NodeRuntime.h"
 #include <boost/asio.hpp>
 #include <boost/thread/thread.hpp>
 #include <iosfwd>
@@ -34,10 +35,20 @@ class ThreadPool
 public:
     typedef std::shared_ptr<ThreadPool> Ptr;
 
+    // Note: when created in a NodeRuntime::Scope, the tasks are scheduled on the node-wide
+    // runtime (at most size tasks at the same time) instead of size dedicated threads
     explicit ThreadPool(const std::string& threadName, size_t size) : m_work(_ioService)
     {
         _threadName = threadName;
 
+        auto const* scope = NodeRuntime::currentScope();
+        if (scope && scope->runtime())
+        {
+            m_runtime = scope->runtime();
+            m_channel =
+                m_runtime->createChannel(scope->group(), scope->priority(), size, threadName);
+            return;
+        }
         for (size_t i = 0; i < size; ++i)
         {
             _workers.create_thread([this] {
@@ -48,6 +59,11 @@ public:
     }
     void stop()
     {
+        if (m_channel)
+        {
+            m_runtime->closeChannel(m_channel);
+            return;
+        }
         _ioService.stop();
         if (!_workers.is_this_thread_in())
         {
@@ -61,10 +77,22 @@ public:
     template <class F>
     void enqueue(F f)
     {
+        if (m_channel)
+        {
+            m_runtime->post(m_channel, std::move(f));
+            return;
+        }
         _ioService.post(f);
     }
 
-    bool hasStopped() { return _ioService.stopped(); }
+    bool hasStopped()
+    {
+        if (m_channel)
+        {
+            return m_runtime->channelClosed(m_channel);
+        }
+        return _ioService.stopped();
+    }
 
 private:
     std::string _threadName;
@@ -72,6 +100,9 @@ private:
     boost::asio::io_service _ioService;
     // m_work ensures that io_service's run() function will not exit while work is underway
     boost::asio::io_service::work m_work;
+
+    NodeRuntime::Ptr m_runtime;
+    NodeRuntime::ChannelPtr m_channel;
 };
 
 }  // namespace bcos
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: hierarchical timer wheel for large amounts of timeouts
+ *
+ * @file TimerWheel.cpp
+ * @date 2022-11-18
+ */
+#include "TimerWheel.h"
+
+using namespace bcos;
+
+TimerWheel::TimerWheel(uint64_t _tickMs, uint64_t _nowMs)
+  : m_tickMs(std::max<uint64_t>(_tickMs, 1)), m_tick(_nowMs / m_tickMs)
+{}
+
+void TimerWheel::add(uint64_t _id, uint64_t _deadlineMs, uint64_t _nowMs)
+{
+    // round up, never expire before the deadline
+    auto expireTick = (_deadlineMs + m_tickMs - 1) / m_tickMs;
+    Guard guard(x_wheel);
+    if (m_size == 0)
+    {
+        // catch up with the ticks passed while idle, the next expire() has none to replay and the
+        // deadline is not clamped to a stale end of the wheel
+        m_tick = std::max(m_tick, _nowMs / m_tickMs);
+    }
+    insert(Entry{_id, expireTick});
+    ++m_size;
+}
+
+void TimerWheel::insert(Entry const& _entry)
+{
+    if (_entry.expireTick < m_tick)
+    {
+        m_root[m_tick & (ROOT_SIZE - 1)].push_back(_entry);
+        return;
+    }
+    auto distance = _entry.expireTick - m_tick;
+    if (distance < ROOT_SIZE)
+    {
+        m_root[_entry.expireTick & (ROOT_SIZE - 1)].push_back(_entry);
+        return;
+    }
+    auto entry = _entry;
+    if (distance >= MAX_TICKS)
+    {
+        entry.expireTick = m_tick + MAX_TICKS - 1;
+        distance = MAX_TICKS - 1;
+    }
+    for (size_t level = 0; level < LEVELS; ++level)
+    {
+        auto shift = ROOT_BITS + level * LEVEL_BITS;
+        if (distance < (1ULL << (shift + LEVEL_BITS)))
+        {
+            m_levels[level][(entry.expireTick >> shift) & (LEVEL_SIZE - 1)].push_back(entry);
+            return;
+        }
+    }
+}
+
+uint64_t TimerWheel::cascade(size_t _level, uint64_t _index)
+{
+    Slot slot;
+    slot.swap(m_levels[_level][_index]);
+    for (auto const& entry : slot)
+    {
+        insert(entry);
+    }
+    return _index;
+}
+
+void TimerWheel::expire(uint64_t _nowMs, std::vector<uint64_t>& _expired)
+{
+    auto targetTick = _nowMs / m_tickMs;
+    Guard guard(x_wheel);
+    while (m_tick <= targetTick)
+    {
+        if (m_size == 0)
+        {
+            // nothing to cascade, jump over the idle ticks
+            m_tick = targetTick + 1;
+            break;
+        }
+        auto index = m_tick & (ROOT_SIZE - 1);
+        if (index == 0)
+        {
+            for (size_t level = 0; level < LEVELS; ++level)
+            {
+                auto shift = ROOT_BITS + level * LEVEL_BITS;
+                if (cascade(level, (m_tick >> shift) & (LEVEL_SIZE - 1)) != 0)
+                {
+                    break;
+                }
+            }
+        }
+        auto& slot = m_root[index];
+        for (auto const& entry : slot)
+        {
+            _expired.push_back(entry.id);
+        }
+        m_size -= slot.size();
+        slot.clear();
+        ++m_tick;
+    }
+}
+
+size_t TimerWheel::size() const
+{
+    Guard guard(x_wheel);
+    return m_size;
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: hierarchical timer wheel for large amounts of timeouts
+ *
+ * @file TimerWheel.h
+ * @date 2022-11-18
+ */
+
+#pragma once
+#include "Common.h"
+#include <array>
+#include <vector>
+
+namespace bcos
+{
+/**
+ * @brief Tracks the deadlines of many ids with one timer: adding a deadline is O(1), and expiring
+ * costs O(1) per tick plus an occasional cascade of the coarser levels into the finer ones.
+ * The first level has 256 slots of one tick, the next three have 64 slots of 256, 16384 and 1048576
+ * ticks. Deadlines beyond the last level are clamped into it.
+ * An id is never removed before expiring, the owner ignores the ids it no longer tracks.
+ */
+class TimerWheel
+{
+public:
+    using Ptr = std::shared_ptr<TimerWheel>;
+    constexpr static size_t ROOT_BITS = 8;
+    constexpr static size_t LEVEL_BITS = 6;
+    constexpr static size_t LEVELS = 3;
+    constexpr static uint64_t ROOT_SIZE = 1 << ROOT_BITS;
+    constexpr static uint64_t LEVEL_SIZE = 1 << LEVEL_BITS;
+    constexpr static uint64_t MAX_TICKS = 1ULL << (ROOT_BITS + LEVELS * LEVEL_BITS);
+
+    // _tickMs: the resolution of the deadlines, _nowMs: the current time, in milliseconds
+    TimerWheel(uint64_t _tickMs, uint64_t _nowMs);
+
+    // expire _id at _deadlineMs, at the next tick if it has already passed, _nowMs: the current
+    // time, the wheel is not advanced while it is empty
+    void add(uint64_t _id, uint64_t _deadlineMs, uint64_t _nowMs);
+    // advance the wheel to _nowMs, append the expired ids to _expired
+    void expire(uint64_t _nowMs, std::vector<uint64_t>& _expired);
+
+    size_t size() const;
+    uint64_t tickMs() const { return m_tickMs; }
+
+private:
+    struct Entry
+    {
+        uint64_t id;
+        uint64_t expireTick;
+    };
+    using Slot = std::vector<Entry>;
+
+    void insert(Entry const& _entry);
+    // move the entries of the slot of _level into the finer levels, return the index of the slot
+    uint64_t cascade(size_t _level, uint64_t _index);
+
+    uint64_t m_tickMs;
+    // the next tick to be expired
+    uint64_t m_tick;
+    size_t m_size = 0;
+    std::array<Slot, ROOT_SIZE> m_root;
+    std::array<std::array<Slot, LEVEL_SIZE>, LEVELS> m_levels;
+    mutable bcos::Mutex x_wheel;
+};
+}  // namespace bcos
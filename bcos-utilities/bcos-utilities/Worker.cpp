@@ -16,6 +16,7 @@
  * @file Worker.cpp
  */
 #include "Worker.h"
+#include "WorkerReactor.h"
 
 #if defined(WIN32) || defined(WIN64) || defined(_WIN32) || defined(_WIN32_)
 #include <stdio.h>
@@ -39,9 +40,116 @@ void setThreadName(const char* _threadName)
 #endif
 }
 
+void Worker::attachReactor(
+    std::shared_ptr<WorkerReactor> _reactor, std::string _group, TaskPriority _priority)
+{
+    boost::unique_lock<boost::mutex> l(x_work);
+    if (m_workerThread || m_registration)
+    {
+        BCOS_LOG(WARNING) << LOG_DESC("attachReactor failed for the worker has been started")
+                          << LOG_KV("threadName", m_threadName);
+        return;
+    }
+    m_reactor = std::move(_reactor);
+    m_reactorGroup = std::move(_group);
+    m_reactorPriority = _priority;
+}
+
+void Worker::notifyWorker()
+{
+    m_signalled.store(true);
+    {
+        // the condition variable-related lock, avoid missing the notification when the worker is
+        // about to wait
+        boost::unique_lock<boost::mutex> l(x_signalled);
+    }
+    m_signal.notify_all();
+
+    auto registration = std::atomic_load(&m_registration);
+    if (registration)
+    {
+        m_reactor->wakeup(registration);
+    }
+}
+
+bool Worker::waitWorkerSignal(unsigned _timeoutMs)
+{
+    if (m_reactor)
+    {
+        m_parkedWaitMs.store(_timeoutMs);
+        m_parked.store(true);
+        return m_signalled.load();
+    }
+    auto stopping = [this]() {
+        return m_workerState == WorkerState::Stopping || m_workerState == WorkerState::Killing;
+    };
+    boost::unique_lock<boost::mutex> l(x_signalled);
+    m_signal.wait_for(l, boost::chrono::milliseconds(_timeoutMs),
+        [this, &stopping]() { return m_signalled.load() || stopping(); });
+    return m_signalled.exchange(false);
+}
+
+unsigned Worker::executeWorkerOnReactor()
+{
+    m_signalled.store(false);
+    m_parked.store(false);
+    try
+    {
+        executeWorker();
+    }
+    catch (std::exception const& e)
+    {
+        BCOS_LOG(WARNING) << LOG_DESC("Exception thrown in Worker executeWorker")
+                          << LOG_KV("threadName", m_threadName)
+                          << LOG_KV("errorMsg", boost::diagnostic_information(e));
+    }
+    // notified during the round, or busy
+    if (m_signalled.load())
+    {
+        return 0;
+    }
+    if (m_parked.load())
+    {
+        return std::max(m_parkedWaitMs.load(), 1U);
+    }
+    return m_idleWaitMs;
+}
+
+void Worker::stopWorkingOnReactor()
+{
+    boost::unique_lock<boost::mutex> l(x_work);
+    WorkerState ex = WorkerState::Started;
+    if (!m_workerState.compare_exchange_strong(ex, WorkerState::Stopping))
+    {
+        return;
+    }
+    auto registration = std::atomic_exchange(&m_registration, {});
+    l.unlock();
+    // wait for the running round
+    m_reactor->detach(registration);
+    finishWorker();
+    l.lock();
+    m_workerState = WorkerState::Stopped;
+    m_workerStateNotifier.notify_all();
+}
+
 void Worker::startWorking()
 {
     boost::unique_lock<boost::mutex> l(x_work);
+    if (m_reactor)
+    {
+        if (m_workerState == WorkerState::Started || m_workerState == WorkerState::Killing)
+        {
+            return;
+        }
+        m_workerState = WorkerState::Started;
+        l.unlock();
+        initWorker();
+        std::atomic_store(
+            &m_registration, m_reactor->attach(this, m_reactorGroup, m_reactorPriority));
+        notifyWorker();
+        return;
+    }
     if (m_workerThread)
     {
         WorkerState workerState = WorkerState::Stopped;
@@ -102,6 +210,11 @@ void Worker::startWorking()
 
 void Worker::stopWorking()
 {
+    if (m_reactor)
+    {
+        stopWorkingOnReactor();
+        return;
+    }
     boost::unique_lock<boost::mutex> l(x_work);
     if (m_workerThread)
     {
@@ -109,6 +222,11 @@ void Worker::stopWorking()
         if (!m_workerState.compare_exchange_strong(ex, WorkerState::Stopping))
             return;
         m_workerStateNotifier.notify_all();
+        {
+            // interrupt waitWorkerSignal
+            boost::unique_lock<boost::mutex> signalLock(x_signalled);
+        }
+        m_signal.notify_all();
         while (m_workerState != WorkerState::Stopped)
         {
             m_workerStateNotifier.wait_for(l, boost::chrono::milliseconds(100));
@@ -118,6 +236,12 @@ void Worker::stopWorking()
 
 void Worker::terminate()
 {
+    if (m_reactor)
+    {
+        stopWorkingOnReactor();
+        m_workerState = WorkerState::Killing;
+        return;
+    }
     boost::unique_lock<boost::mutex> l(x_work);
     if (m_workerThread)
     {
@@ -125,6 +249,11 @@ void Worker::terminate()
             return;  // Somebody else is doing this
         l.unlock();
         m_workerStateNotifier.notify_all();
+        {
+            // interrupt waitWorkerSignal
+            boost::unique_lock<boost::mutex> signalLock(x_signalled);
+        }
+        m_signal.notify_all();
         m_workerThread->join();
 
         l.lock();
@@ -137,7 +266,7 @@ void Worker::workerProcessLoop()
     while (m_workerState == WorkerState::Started)
     {
         if (m_idleWaitMs)
-            this_thread::sleep_for(chrono::milliseconds(m_idleWaitMs));
+            waitWorkerSignal(m_idleWaitMs);
         executeWorker();
     }
 }
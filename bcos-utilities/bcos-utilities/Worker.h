@@ -19,13 +19,18 @@
 #pragma once
 
 #include "Common.h"
+#include "NodeRuntime.h"
 #include <atomic>
+#include <memory>
 #include <string>
 #include <thread>
 #include <utility>
 
 namespace bcos
 {
+class WorkerReactor;
+struct WorkerRegistration;
+
 enum class WorkerState
 {
     Starting,
@@ -37,6 +42,24 @@ enum class WorkerState
 
 class Worker
 {
+public:
+    /**
+     * @brief run executeWorker on the threads shared by all workers attached to the reactor
+     * instead of a dedicated thread, must be called before startWorking
+     * Note: workerProcessLoop is not used on a reactor, executeWorker is re-scheduled when
+     * notifyWorker is called, when the timeout of waitWorkerSignal elapses, or after idleWaitMs
+     * if executeWorker neither waited nor has been notified (immediately if idleWaitMs is 0)
+     * @param _group, _priority: where to account and how to schedule the rounds if the reactor
+     * runs on the NodeRuntime
+     */
+    void attachReactor(std::shared_ptr<WorkerReactor> _reactor, std::string _group = "",
+        TaskPriority _priority = TaskPriority::Rpc);
+    std::shared_ptr<WorkerReactor> const& reactor() const { return m_reactor; }
+
+    // wake up the worker when new work arrives: interrupts waitWorkerSignal, or schedules
+    // executeWorker on the reactor
+    void notifyWorker();
+
 protected:
     Worker(std::string _threadName = "worker", unsigned _idleWaitMs = 30)
       : m_threadName(std::move(_threadName)), m_idleWaitMs(_idleWaitMs)
@@ -86,7 +109,21 @@ protected:
     std::atomic<WorkerState>& workerState() { return m_workerState; }
     unsigned idleWaitMs() const { return m_idleWaitMs; }
 
+    /**
+     * @brief wait until notifyWorker is called or _timeoutMs elapsed, called by executeWorker
+     * when there is nothing to do
+     * Note: returns immediately on a reactor, the worker is parked until notified or timeout
+     * @return true if the worker has been notified
+     */
+    bool waitWorkerSignal(unsigned _timeoutMs);
+
 private:
+    friend class WorkerReactor;
+    // run executeWorker once on the reactor, return the time to wait before the next round
+    unsigned executeWorkerOnReactor();
+    void stopWorkingOnReactor();
+
+
     std::string m_threadName;
 
     unsigned m_idleWaitMs = 0;
@@ -97,6 +134,19 @@ private:
     // Notification when m_workerState changes
     mutable boost::condition_variable m_workerStateNotifier;
     std::atomic<WorkerState> m_workerState = {WorkerState::Starting};
+
+    // set by notifyWorker, consumed by waitWorkerSignal
+    std::atomic_bool m_signalled = {false};
+    boost::mutex x_signalled;
+    boost::condition_variable m_signal;
+
+    std::shared_ptr<WorkerReactor> m_reactor;
+    std::string m_reactorGroup;
+    TaskPriority m_reactorPriority = TaskPriority::Rpc;
+    std::shared_ptr<WorkerRegistration> m_registration;
+    // the timeout of waitWorkerSignal called in the current round on the reactor
+    std::atomic_bool m_parked = {false};
+    std::atomic<unsigned> m_parkedWaitMs = {0};
 };
 
 }  // namespace bcos
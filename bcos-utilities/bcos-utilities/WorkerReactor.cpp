@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: event-driven executor shared by the workers of all groups
+ *
+ * @file WorkerReactor.cpp
+ * @date 2022-11-08
+ */
+#include "WorkerReactor.h"
+#include "Worker.h"
+#include <boost/asio/post.hpp>
+
+using namespace bcos;
+
+// the registration whose round is running on the current thread
+thread_local WorkerRegistration* t_runningRegistration = nullptr;
+
+WorkerReactor::WorkerReactor(std::string const& _threadName, size_t _threadCount)
+  : m_threadName(_threadName),
+    m_threadCount(std::max<size_t>(_threadCount, 1)),
+    m_work(boost::asio::make_work_guard(m_ioContext))
+{
+    for (size_t i = 0; i < m_threadCount; ++i)
+    {
+        m_threads.create_thread([this] {
+            bcos::pthread_setThreadName(m_threadName);
+            m_ioContext.run();
+        });
+    }
+}
+
+WorkerReactor::WorkerReactor(NodeRuntime::Ptr _runtime)
+  : m_runtime(std::move(_runtime)),
+    m_threadName("workerReactor"),
+    m_threadCount(m_runtime->workerThreads()),
+    m_work(boost::asio::make_work_guard(m_ioContext))
+{}
+
+void WorkerReactor::stop()
+{
+    if (m_ioContext.stopped())
+    {
+        return;
+    }
+    m_work.reset();
+    m_ioContext.stop();
+    if (!m_threads.is_this_thread_in())
+    {
+        m_threads.join_all();
+    }
+}
+
+WorkerRegistration::Ptr WorkerReactor::attach(
+    Worker* _worker, std::string const& _group, TaskPriority _priority)
+{
+    WorkerRegistration::Ptr registration;
+    if (m_runtime)
+    {
+        registration = std::make_shared<WorkerRegistration>(_worker, m_ioContext,
+            m_runtime->ioContext(_group),
+            m_runtime->createChannel(_group, _priority, 1, _worker->threadName()));
+    }
+    else
+    {
+        registration =
+            std::make_shared<WorkerRegistration>(_worker, m_ioContext, m_ioContext, nullptr);
+    }
+    m_workerCount++;
+    BCOS_LOG(INFO) << LOG_DESC("WorkerReactor: attach worker")
+                   << LOG_KV("worker", _worker->threadName()) << LOG_KV("group", _group)
+                   << LOG_KV("priority", (int)_priority)
+                   << LOG_KV("workers", m_workerCount.load())
+                   << LOG_KV("threads", m_threadCount);
+    return registration;
+}
+
+void WorkerReactor::detach(WorkerRegistration::Ptr const& _registration)
+{
+    if (!_registration)
+    {
+        return;
+    }
+    // detach from the round of the worker itself
+    if (t_runningRegistration == _registration.get())
+    {
+        _registration->detached = true;
+    }
+    else
+    {
+        boost::unique_lock<boost::mutex> l(_registration->x_running);
+        _registration->detached = true;
+    }
+    dispatch(_registration, [_registration]() {
+        boost::system::error_code ec;
+        _registration->timer.cancel(ec);
+    });
+    m_workerCount--;
+}
+
+void WorkerReactor::wakeup(WorkerRegistration::Ptr const& _registration)
+{
+    if (_registration->scheduled.exchange(true))
+    {
+        // the next round has not been started yet, it will see the new work
+        return;
+    }
+    auto self = weak_from_this();
+    dispatch(_registration, [self, _registration]() {
+        auto reactor = self.lock();
+        if (!reactor)
+        {
+            return;
+        }
+        boost::system::error_code ec;
+        _registration->timer.cancel(ec);
+        reactor->execute(_registration);
+    });
+}
+
+void WorkerReactor::dispatch(
+    WorkerRegistration::Ptr const& _registration, std::function<void()> _handler)
+{
+    if (_registration->channel)
+    {
+        m_runtime->post(_registration->channel, std::move(_handler));
+        return;
+    }
+    boost::asio::post(_registration->strand, std::move(_handler));
+}
+
+void WorkerReactor::execute(WorkerRegistration::Ptr const& _registration)
+{
+    _registration->scheduled.store(false);
+    unsigned waitMs = 0;
+    {
+        boost::unique_lock<boost::mutex> l(_registration->x_running);
+        if (_registration->detached)
+        {
+            return;
+        }
+        t_runningRegistration = _registration.get();
+        waitMs = _registration->worker->executeWorkerOnReactor();
+        t_runningRegistration = nullptr;
+        m_executedRounds++;
+        if (_registration->detached)
+        {
+            return;
+        }
+    }
+    if (waitMs == 0)
+    {
+        wakeup(_registration);
+        return;
+    }
+    // the strand serializes this with the timer.cancel() of wakeup
+    auto self = weak_from_this();
+    _registration->timer.expires_after(std::chrono::milliseconds(waitMs));
+    _registration->timer.async_wait([self, _registration](boost::system::error_code _error) {
+        if (_error)
+        {
+            // cancelled by a notification
+            return;
+        }
+        auto reactor = self.lock();
+        if (reactor)
+        {
+            reactor->wakeup(_registration);
+        }
+    });
+}
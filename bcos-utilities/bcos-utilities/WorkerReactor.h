@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: event-driven executor shared by the workers of all groups
+ *
+ * @file WorkerReactor.h
+ * @date 2022-11-08
+ */
+
+#pragma once
+#include "Common.h"
+#include "NodeRuntime.h"
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/io_context_strand.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/thread/thread.hpp>
+#include <memory>
+
+namespace bcos
+{
+class Worker;
+
+// the state of a worker attached to the reactor
+struct WorkerRegistration
+{
+    using Ptr = std::shared_ptr<WorkerRegistration>;
+    WorkerRegistration(Worker* _worker, boost::asio::io_context& _ioContext,
+        boost::asio::io_context& _timerContext, NodeRuntime::ChannelPtr _channel)
+      : worker(_worker), strand(_ioContext), channel(std::move(_channel)), timer(_timerContext)
+    {}
+
+    Worker* worker;
+    // rounds of the same worker never run concurrently: on the strand, or on the serial channel
+    // of the worker when the reactor runs on the NodeRuntime
+    boost::asio::io_context::strand strand;
+    NodeRuntime::ChannelPtr channel;
+    // fires when the worker has waited long enough without being notified
+    boost::asio::steady_timer timer;
+    // coalesce the notifications arrived before the next round
+    std::atomic_bool scheduled = {false};
+    // held while running a round, detach waits for it
+    boost::mutex x_running;
+    bool detached = false;
+};
+
+/**
+ * @brief Instead of one polling thread per worker, the workers of all groups attached to the
+ * reactor share a few threads, and a worker is scheduled exactly when it is notified of new work
+ * (queue-non-empty, peer-status ...) or its wait timer fires.
+ */
+class WorkerReactor : public std::enable_shared_from_this<WorkerReactor>
+{
+public:
+    using Ptr = std::shared_ptr<WorkerReactor>;
+    WorkerReactor(std::string const& _threadName, size_t _threadCount);
+    // schedule the rounds on the node-wide runtime with the group and priority of every worker
+    explicit WorkerReactor(NodeRuntime::Ptr _runtime);
+    virtual ~WorkerReactor() { stop(); }
+
+    void stop();
+
+    size_t threadCount() const { return m_threadCount; }
+    size_t workerCount() const { return m_workerCount.load(); }
+    // the rounds executed by all workers
+    uint64_t executedRounds() const { return m_executedRounds.load(); }
+
+private:
+    friend class Worker;
+    WorkerRegistration::Ptr attach(
+        Worker* _worker, std::string const& _group, TaskPriority _priority);
+    // wait for the running round of the worker, no round is executed after detach
+    void detach(WorkerRegistration::Ptr const& _registration);
+    void wakeup(WorkerRegistration::Ptr const& _registration);
+    void execute(WorkerRegistration::Ptr const& _registration);
+    void dispatch(WorkerRegistration::Ptr const& _registration, std::function<void()> _handler);
+
+    NodeRuntime::Ptr m_runtime;
+    std::string m_threadName;
+    size_t m_threadCount;
+    boost::asio::io_context m_ioContext;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+    boost::thread_group m_threads;
+
+    std::atomic<size_t> m_workerCount = {0};
+    std::atomic<uint64_t> m_executedRounds = {0};
+};
+}  // namespace bcos
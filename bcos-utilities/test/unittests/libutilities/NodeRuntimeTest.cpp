@@ -0,0 +1,203 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: unit test for NodeRuntime
+ *
+ * @file NodeRuntimeTest.cpp
+ * @date 2022-11-10
+ */
+#include "bcos-utilities/NodeRuntime.h"
+#include "bcos-utilities/ThreadPool.h"
+#include "bcos-utilities/Worker.h"
+#include "bcos-utilities/WorkerReactor.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace bcos;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(NodeRuntimeTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(serialChannel)
+{
+    auto runtime = std::make_shared<NodeRuntime>("runtime", 4, 1, false);
+    auto channel = runtime->createChannel("group0", TaskPriority::Sync, 1);
+
+    std::atomic_int running = 0;
+    std::atomic_bool overlapped = false;
+    std::vector<int> order;
+    std::promise<void> finished;
+    for (int i = 0; i < 1000; ++i)
+    {
+        runtime->post(channel, [&, i]() {
+            if (running++ > 0)
+            {
+                overlapped = true;
+            }
+            order.push_back(i);
+            running--;
+            if (i == 999)
+            {
+                finished.set_value();
+            }
+        });
+    }
+    finished.get_future().wait();
+    BOOST_CHECK(!overlapped);
+    BOOST_CHECK_EQUAL(order.size(), 1000);
+    BOOST_CHECK(std::is_sorted(order.begin(), order.end()));
+
+    // the task is accounted after it returns
+    runtime->stop();
+    auto stats = runtime->groupStats();
+    BOOST_CHECK_EQUAL(stats.size(), 1);
+    BOOST_CHECK_EQUAL(stats[0].group, "group0");
+    BOOST_CHECK_EQUAL(stats[0].executedTasks, 1000);
+    BOOST_CHECK_EQUAL(stats[0].pendingTasks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(priorityAndFairness)
+{
+    // one thread, blocked until all the tasks are queued
+    auto runtime = std::make_shared<NodeRuntime>("runtime", 1, 1, false);
+    auto blocker = runtime->createChannel("group0", TaskPriority::Consensus, 1);
+    std::promise<void> start;
+    auto startFuture = start.get_future().share();
+    runtime->post(blocker, [startFuture]() { startFuture.wait(); });
+
+    std::vector<std::string> order;
+    auto rpc = runtime->createChannel("group0", TaskPriority::Rpc, 1);
+    auto sync = runtime->createChannel("group0", TaskPriority::Sync, 1);
+    auto consensus0 = runtime->createChannel("group0", TaskPriority::Consensus, 1);
+    auto consensus1 = runtime->createChannel("group1", TaskPriority::Consensus, 1);
+    for (int i = 0; i < 3; ++i)
+    {
+        runtime->post(rpc, [&order]() { order.emplace_back("rpc"); });
+        runtime->post(sync, [&order]() { order.emplace_back("sync"); });
+        runtime->post(consensus0, [&order]() { order.emplace_back("consensus0"); });
+        runtime->post(consensus1, [&order]() { order.emplace_back("consensus1"); });
+    }
+    std::promise<void> finished;
+    runtime->post(rpc, [&finished]() { finished.set_value(); });
+    start.set_value();
+    finished.get_future().wait();
+
+    BOOST_REQUIRE_EQUAL(order.size(), 12);
+    // the groups of the same priority take turns
+    std::vector<std::string> expected = {"consensus0", "consensus1", "consensus0", "consensus1",
+        "consensus0", "consensus1"};
+    // one in STARVATION_PERIOD picks goes to the lowest priority
+    auto rpcPosition = std::find(order.begin(), order.end(), "rpc") - order.begin();
+    BOOST_CHECK_LT(rpcPosition, (long)NodeRuntime::STARVATION_PERIOD);
+    std::vector<std::string> consensus;
+    std::copy_if(order.begin(), order.end(), std::back_inserter(consensus),
+        [](std::string const& name) { return name.starts_with("consensus"); });
+    BOOST_CHECK(consensus == expected);
+    // sync goes before rpc except the starvation pick
+    auto firstSync = std::find(order.begin(), order.end(), "sync") - order.begin();
+    auto lastConsensus = std::find(order.rbegin(), order.rend(), "consensus1").base() -
+                         order.begin() - 1;
+    BOOST_CHECK_GT(firstSync, lastConsensus);
+}
+
+BOOST_AUTO_TEST_CASE(threadPoolInScope)
+{
+    auto runtime = std::make_shared<NodeRuntime>("runtime", 2, 1, false);
+    std::shared_ptr<ThreadPool> pool;
+    {
+        NodeRuntime::Scope scope(runtime, "group0", TaskPriority::Rpc);
+        BOOST_CHECK(NodeRuntime::currentScope() == &scope);
+        pool = std::make_shared<ThreadPool>("pool", 1);
+    }
+    BOOST_CHECK(NodeRuntime::currentScope() == nullptr);
+
+    std::atomic_int count = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        pool->enqueue([&count]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            count++;
+        });
+    }
+    std::promise<void> finished;
+    pool->enqueue([&finished]() { finished.set_value(); });
+    finished.get_future().wait();
+    BOOST_CHECK_EQUAL(count, 100);
+
+    pool->stop();
+    BOOST_CHECK(pool->hasStopped());
+    pool->enqueue([&count]() { count++; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK_EQUAL(count, 100);
+    runtime->stop();
+    BOOST_CHECK_EQUAL(runtime->groupStats()[0].executedTasks, 101);
+}
+
+class RuntimeWorker : public Worker
+{
+public:
+    RuntimeWorker() : Worker("RuntimeWorker", 0) {}
+    void run() { startWorking(); }
+    void stop() { stopWorking(); }
+    int executed() const { return m_executed; }
+
+protected:
+    void executeWorker() override
+    {
+        m_executed++;
+        waitWorkerSignal(10000);
+    }
+
+private:
+    std::atomic_int m_executed = {0};
+};
+
+BOOST_AUTO_TEST_CASE(reactorOnRuntime)
+{
+    auto runtime = std::make_shared<NodeRuntime>("runtime", 2, 1, false);
+    auto reactor = std::make_shared<WorkerReactor>(runtime);
+    RuntimeWorker worker;
+    worker.attachReactor(reactor, "group1", TaskPriority::Consensus);
+    worker.run();
+    for (int i = 0; i < 10 && worker.executed() == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_GE(worker.executed(), 1);
+    auto executed = worker.executed();
+    worker.notifyWorker();
+    for (int i = 0; i < 100 && worker.executed() == executed; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_EQUAL(worker.executed(), executed + 1);
+    worker.stop();
+    runtime->stop();
+
+    auto stats = runtime->groupStats();
+    BOOST_REQUIRE_EQUAL(stats.size(), 1);
+    BOOST_CHECK_EQUAL(stats[0].group, "group1");
+    BOOST_CHECK_GE(stats[0].executedTasks, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
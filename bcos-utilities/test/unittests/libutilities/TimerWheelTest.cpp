@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: unit test for TimerWheel
+ *
+ * @file TimerWheelTest.cpp
+ * @date 2022-11-18
+ */
+#include "bcos-utilities/TimerWheel.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <map>
+#include <random>
+
+using namespace bcos;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(TimerWheelTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(expireInOrder)
+{
+    uint64_t now = 1000000;
+    TimerWheel wheel(10, now);
+    wheel.add(1, now + 25, now);
+    wheel.add(2, now + 5, now);
+    // already passed
+    wheel.add(3, now - 100, now);
+    BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+    std::vector<uint64_t> expired;
+    wheel.expire(now, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{3}));
+    expired.clear();
+
+    wheel.expire(now + 9, expired);
+    BOOST_CHECK(expired.empty());
+    wheel.expire(now + 10, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{2}));
+    expired.clear();
+
+    wheel.expire(now + 29, expired);
+    BOOST_CHECK(expired.empty());
+    wheel.expire(now + 30, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{1}));
+    BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(cascadeLevels)
+{
+    uint64_t tickMs = 1;
+    uint64_t now = 12345;
+    TimerWheel wheel(tickMs, now);
+
+    // deadlines on every level, and beyond the last one
+    std::mt19937_64 random(now);
+    std::map<uint64_t, uint64_t> deadlines;
+    for (uint64_t id = 0; id < 2000; ++id)
+    {
+        auto delay = random() % (id < 1000 ? 70000 : TimerWheel::MAX_TICKS);
+        deadlines[id] = now + delay;
+        wheel.add(id, now + delay, now);
+    }
+    wheel.add(3000, now + TimerWheel::MAX_TICKS * 2, now);
+
+    // jump by random steps, no id expires early and every id expires within one step
+    std::vector<uint64_t> expired;
+    uint64_t last = now;
+    while (wheel.size() > 1)
+    {
+        auto next = last + 1 + random() % 5000;
+        expired.clear();
+        wheel.expire(next, expired);
+        for (auto id : expired)
+        {
+            BOOST_REQUIRE(deadlines.count(id));
+            BOOST_CHECK_LE(deadlines[id], next);
+            BOOST_CHECK_GT(deadlines[id], last);
+            deadlines.erase(id);
+        }
+        last = next;
+    }
+    BOOST_CHECK(deadlines.empty());
+
+    // the clamped deadline expires at the end of the last level
+    expired.clear();
+    wheel.expire(now + TimerWheel::MAX_TICKS, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{3000}));
+}
+
+BOOST_AUTO_TEST_CASE(idle)
+{
+    TimerWheel wheel(10, 0);
+    std::vector<uint64_t> expired;
+    // nothing to expire, the wheel jumps forward instead of walking every tick
+    wheel.expire(uint64_t(1) << 40, expired);
+    BOOST_CHECK(expired.empty());
+
+    // the deadline is rounded up to the next tick
+    wheel.add(1, (uint64_t(1) << 40) + 100, uint64_t(1) << 40);
+    wheel.expire((uint64_t(1) << 40) + 100, expired);
+    BOOST_CHECK(expired.empty());
+    wheel.expire((uint64_t(1) << 40) + 110, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{1}));
+}
+
+BOOST_AUTO_TEST_CASE(addAfterIdle)
+{
+    uint64_t tickMs = 10;
+    TimerWheel wheel(tickMs, 0);
+    std::vector<uint64_t> expired;
+    wheel.add(1, 100, 0);
+    wheel.expire(100, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{1}));
+    expired.clear();
+
+    // idle past the span of the wheel without expire() being called
+    auto now = 100 + tickMs * TimerWheel::MAX_TICKS * 2;
+    wheel.add(2, now + 1000, now);
+    wheel.add(3, now + tickMs * TimerWheel::MAX_TICKS / 2, now);
+    BOOST_CHECK_EQUAL(wheel.size(), 2);
+    wheel.expire(now, expired);
+    BOOST_CHECK(expired.empty());
+    wheel.expire(now + 990, expired);
+    BOOST_CHECK(expired.empty());
+    wheel.expire(now + 1000, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{2}));
+    expired.clear();
+    wheel.expire(now + tickMs * TimerWheel::MAX_TICKS / 2 - tickMs, expired);
+    BOOST_CHECK(expired.empty());
+    wheel.expire(now + tickMs * TimerWheel::MAX_TICKS / 2, expired);
+    BOOST_CHECK((expired == std::vector<uint64_t>{3}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -21,6 +21,7 @@
 
 #include "bcos-utilities/Worker.h"
 #include "bcos-utilities/Timer.h"
+#include "bcos-utilities/WorkerReactor.h"
 #include "bcos-utilities/testutils/TestPromptFixture.h"
 #include <boost/test/unit_test.hpp>
 #include <chrono>
@@ -57,6 +58,49 @@ private:
     std::shared_ptr<Timer> m_timer;
 };
 
+// wait for the notification for a long time, execute only when notified
+class NotifiedWorker : public Worker
+{
+public:
+    NotifiedWorker() : Worker("NotifiedWorker", 0) {}
+    void run() { startWorking(); }
+    void stop() { stopWorking(); }
+    void push()
+    {
+        m_pending++;
+        notifyWorker();
+    }
+    int executed() const { return m_executed; }
+    int rounds() const { return m_rounds; }
+
+protected:
+    void executeWorker() override
+    {
+        m_rounds++;
+        if (m_pending == 0)
+        {
+            waitWorkerSignal(10000);
+            return;
+        }
+        m_pending--;
+        m_executed++;
+    }
+
+private:
+    std::atomic_int m_pending = {0};
+    std::atomic_int m_executed = {0};
+    std::atomic_int m_rounds = {0};
+};
+
+bool waitFor(std::function<bool()> _condition)
+{
+    for (int i = 0; i < 5000 && !_condition(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return _condition();
+}
+
 BOOST_FIXTURE_TEST_SUITE(Worker, TestPromptFixture)
 
 BOOST_AUTO_TEST_CASE(testWorker)
@@ -66,6 +110,63 @@ BOOST_AUTO_TEST_CASE(testWorker)
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
     workerImpl.stop();
 }
+
+BOOST_AUTO_TEST_CASE(testNotifyWorker)
+{
+    NotifiedWorker worker;
+    worker.run();
+    worker.push();
+    BOOST_CHECK(waitFor([&worker]() { return worker.executed() == 1; }));
+    worker.push();
+    worker.push();
+    BOOST_CHECK(waitFor([&worker]() { return worker.executed() == 3; }));
+    // stop interrupts the waiting worker
+    auto startT = std::chrono::steady_clock::now();
+    worker.stop();
+    BOOST_CHECK(std::chrono::steady_clock::now() - startT < std::chrono::seconds(5));
+}
+
+BOOST_AUTO_TEST_CASE(testWorkerReactor)
+{
+    auto reactor = std::make_shared<WorkerReactor>("reactor", 2);
+    std::vector<std::shared_ptr<NotifiedWorker>> workers;
+    for (int i = 0; i < 10; ++i)
+    {
+        auto worker = std::make_shared<NotifiedWorker>();
+        worker->attachReactor(reactor);
+        worker->run();
+        workers.push_back(worker);
+    }
+    BOOST_CHECK_EQUAL(reactor->workerCount(), 10);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        for (auto& worker : workers)
+        {
+            worker->push();
+        }
+    }
+    for (auto& worker : workers)
+    {
+        BOOST_CHECK(waitFor([&worker]() { return worker->executed() == 100; }));
+    }
+    // parked workers are not polled
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto rounds = reactor->executedRounds();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK_EQUAL(reactor->executedRounds(), rounds);
+
+    for (auto& worker : workers)
+    {
+        worker->stop();
+    }
+    BOOST_CHECK_EQUAL(reactor->workerCount(), 0);
+    // no round after stop
+    workers[0]->push();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK_EQUAL(reactor->executedRounds(), rounds);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
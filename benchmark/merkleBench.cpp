@@ -1,5 +1,6 @@
 #include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
 #include <bcos-crypto/hash/SM3.h>
+#include <bcos-crypto/hasher/MultiBuffer.h>
 #include <bcos-crypto/hasher/OpenSSLHasher.h>
 #include <bcos-crypto/merkle/Merkle.h>
 #include <bcos-protocol/ParallelMerkleProof.h>
@@ -15,6 +16,16 @@
 
 using Hasher = bcos::crypto::hasher::openssl::OpenSSL_SM3_Hasher;
 
+// the same hasher without hashBatch, every node is hashed alone
+struct SerialHasher
+{
+    constexpr static size_t HASH_SIZE = Hasher::HASH_SIZE;
+    void update(auto const& input) { m_hasher.update(input); }
+    void final(auto& output) { m_hasher.final(output); }
+
+    Hasher m_hasher;
+};
+
 std::string generateTestData(int count)
 {
     std::string buffer;
@@ -66,13 +77,33 @@ void testNewMerkle(const std::vector<bcos::bytes>& datas)
               << std::endl;
 }
 
+template <class HasherType>
+void testMerkle(const std::vector<bcos::bytes>& datas, std::string_view name)
+{
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    std::vector<bcos::bytes> out;
+
+    bcos::crypto::merkle::Merkle<HasherType, 16> merkle;
+    merkle.generateMerkle(datas, out);
+
+    auto root = *(out.rbegin());
+    std::string rootString;
+    boost::algorithm::hex_lower(
+        (char*)root.data(), (char*)(root.data() + root.size()), std::back_inserter(rootString));
+
+    auto duration = std::chrono::high_resolution_clock::now() - timePoint;
+    std::cout << "Root[" << name << "]: " << rootString << " "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << "ms"
+              << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
     boost::program_options::options_description options("Merkle benchmark");
 
     // clang-format off
     options.add_options()
-        ("type,t", boost::program_options::value<int>()->default_value(0), "0 for old merkle, 1 for new merkle")
+        ("type,t", boost::program_options::value<int>()->default_value(0), "0 for old merkle, 1 for new merkle, 2 for serial vs multi-buffer new merkle")
         ("prepare,p", boost::program_options::value<int>()->default_value(0), "Prepare test data, count of hashes")
         ("filename,f", boost::program_options::value<std::string>()->default_value("merkle_test.data"), "Test data file name")
         ;
@@ -116,7 +147,15 @@ int main(int argc, char* argv[])
     }
 
     auto type = vm["type"].as<int>();
-    if (type)
+    if (type == 2)
+    {
+        auto backend = bcos::crypto::hasher::multibuffer::bestBackend();
+        std::cout << "SM3 lanes: " << bcos::crypto::hasher::multibuffer::sm3Lanes(backend)
+                  << std::endl;
+        testMerkle<SerialHasher>(inputDatas, "serial");
+        testMerkle<Hasher>(inputDatas, "multi-buffer");
+    }
+    else if (type)
     {
         testNewMerkle(inputDatas);
     }
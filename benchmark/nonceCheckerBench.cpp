@@ -0,0 +1,185 @@
+#include <bcos-txpool/txpool/validator/BlockNonceSet.h>
+#include <bcos-txpool/txpool/validator/TxPoolNonceChecker.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <boost/program_options.hpp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <fstream>
+#include <shared_mutex>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+// the resident memory read from /proc, 0 if not supported
+size_t residentSize()
+{
+    size_t pages = 0;
+    size_t residentPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> residentPages;
+    return residentPages * 4096;
+}
+
+std::vector<NonceListPtr> randomBlocks(size_t blocks, size_t txs)
+{
+    std::mt19937_64 random(blocks * txs);
+    std::vector<NonceListPtr> nonceLists(blocks);
+    for (auto& nonceList : nonceLists)
+    {
+        nonceList = std::make_shared<NonceList>();
+        for (size_t i = 0; i < txs; ++i)
+        {
+            u256 nonce = random();
+            nonceList->emplace_back((nonce << 192) + (u256(random()) << 64) + random());
+        }
+    }
+    return nonceLists;
+}
+
+// the nonces committed and the nonces never seen, checked by the tbb threads
+template <class Contains>
+std::chrono::nanoseconds check(std::vector<NonceListPtr> const& blocks, Contains&& contains)
+{
+    auto missed = randomBlocks(blocks.size() / 10 + 1, blocks.front()->size());
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    std::atomic_size_t found = 0;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks.size()),
+        [&](tbb::blocked_range<size_t> const& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                for (auto const& nonce : *blocks[i])
+                {
+                    found += contains(nonce);
+                }
+                for (auto const& nonce : *missed[i % missed.size()])
+                {
+                    found += contains(nonce);
+                }
+            }
+        });
+    auto elapsed = std::chrono::high_resolution_clock::now() - timePoint;
+    if (found < blocks.size() * blocks.front()->size())
+    {
+        std::cout << "missing nonces!" << std::endl;
+    }
+    return elapsed / (blocks.size() * blocks.front()->size() * 2);
+}
+
+// the commit time of every block, and the check time of every nonce
+void report(std::string const& name, size_t nonceSize, size_t memory,
+    std::chrono::nanoseconds loadTime, std::chrono::nanoseconds commitTime,
+    std::chrono::nanoseconds checkTime)
+{
+    auto micros = [](std::chrono::nanoseconds duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    };
+    std::cout << name << ": memory " << memory / 1024 / 1024 << "MB, " << memory / nonceSize
+              << "B/nonce, load " << micros(loadTime) << "us, commit " << micros(commitTime)
+              << "us/block, check " << checkTime.count() << "ns/nonce" << std::endl;
+}
+
+// Baseline: the nonces in a concurrent hash map, and the nonce lists of the blocks kept to erase
+// them one by one when the block expired
+void testHashMap(std::vector<NonceListPtr> const& blocks, size_t limit)
+{
+    auto heap = residentSize();
+    TxPoolNonceChecker nonces;
+    std::map<BlockNumber, NonceListPtr> blockNonces;
+
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < limit; ++i)
+    {
+        blockNonces[i] = blocks[i];
+        nonces.batchInsert(i, blocks[i]);
+    }
+    auto loadTime = std::chrono::high_resolution_clock::now() - timePoint;
+    auto memory = residentSize() - heap;
+
+    timePoint = std::chrono::high_resolution_clock::now();
+    for (size_t i = limit; i < blocks.size(); ++i)
+    {
+        blockNonces[i] = blocks[i];
+        nonces.batchInsert(i, blocks[i]);
+        auto expired = blockNonces.begin();
+        nonces.batchRemove(*(expired->second));
+        blockNonces.erase(expired);
+    }
+    auto commitTime = std::chrono::high_resolution_clock::now() - timePoint;
+
+    std::vector<NonceListPtr> liveBlocks(blocks.end() - limit, blocks.end());
+    auto checkTime =
+        check(liveBlocks, [&](NonceType const& nonce) { return nonces.exists(nonce); });
+    report("concurrent_hash_map", limit * blocks.front()->size(), memory, loadTime,
+        commitTime / (blocks.size() - limit), checkTime);
+}
+
+// The fingerprints of the nonces in the open-addressing table, expired by block bucket
+void testBlockNonceSet(std::vector<NonceListPtr> const& blocks, size_t limit)
+{
+    auto heap = residentSize();
+    BlockNonceSet nonces(limit);
+    std::shared_mutex mutex;
+
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    std::map<BlockNumber, NonceListPtr> initialNonces;
+    for (size_t i = 0; i < limit; ++i)
+    {
+        initialNonces[i] = blocks[i];
+    }
+    nonces.insertBlocks(initialNonces);
+    auto loadTime = std::chrono::high_resolution_clock::now() - timePoint;
+    initialNonces.clear();
+    auto memory = residentSize() - heap;
+
+    timePoint = std::chrono::high_resolution_clock::now();
+    for (size_t i = limit; i < blocks.size(); ++i)
+    {
+        std::unique_lock lock(mutex);
+        nonces.insertBlock(i, *blocks[i]);
+    }
+    auto commitTime = std::chrono::high_resolution_clock::now() - timePoint;
+
+    std::vector<NonceListPtr> liveBlocks(blocks.end() - limit, blocks.end());
+    auto checkTime = check(liveBlocks, [&](NonceType const& nonce) {
+        std::shared_lock lock(mutex);
+        return nonces.contains(nonce);
+    });
+    report("BlockNonceSet", limit * blocks.front()->size(), memory, loadTime,
+        commitTime / (blocks.size() - limit), checkTime);
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Nonce checker benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("txs,t", boost::program_options::value<size_t>()->default_value(10000), "Transactions of the block")
+        ("blockLimit,l", boost::program_options::value<size_t>()->default_value(1000), "Blocks the nonces kept")
+        ("blocks,b", boost::program_options::value<size_t>()->default_value(100), "Blocks committed after loaded")
+        ("checker,c", boost::program_options::value<std::string>()->default_value("all"), "hashmap, set or all, run one checker in a process to measure the memory")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    auto txs = vm["txs"].as<size_t>();
+    auto limit = vm["blockLimit"].as<size_t>();
+    auto blocks = randomBlocks(limit + std::max<size_t>(vm["blocks"].as<size_t>(), 1), txs);
+
+    auto checker = vm["checker"].as<std::string>();
+    if (checker != "set")
+    {
+        testHashMap(blocks, limit);
+    }
+    if (checker != "hashmap")
+    {
+        testBlockNonceSet(blocks, limit);
+    }
+    return 0;
+}
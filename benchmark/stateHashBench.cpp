@@ -0,0 +1,82 @@
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-table/src/StateStorage.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace bcos::storage;
+
+// The writes of the transactions spread over the contract tables, written by the tbb threads
+std::chrono::nanoseconds write(StateStorage& storage, size_t count, size_t tables)
+{
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, count), [&](tbb::blocked_range<size_t> const& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                Entry entry;
+                entry.importFields({"value_" + std::to_string(i)});
+                storage.asyncSetRow("table_" + std::to_string(i % tables),
+                    "key_" + std::to_string(i), std::move(entry), [](bcos::Error::UniquePtr) {});
+            }
+        });
+    return std::chrono::high_resolution_clock::now() - timePoint;
+}
+
+void report(const std::string& name, std::chrono::nanoseconds writeTime,
+    std::chrono::nanoseconds hashTime, bcos::crypto::HashType const& hash)
+{
+    auto micros = [](std::chrono::nanoseconds duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    };
+    std::cout << name << ": write " << micros(writeTime) << "us, hash " << micros(hashTime)
+              << "us, " << hash.abridged() << std::endl;
+}
+
+// Baseline: the dirty entries are walked and hashed by hash() after all written
+void testWalkedHash(bcos::crypto::Hash::Ptr hashImpl, size_t count, size_t tables)
+{
+    StateStorage storage(nullptr);
+    auto writeTime = write(storage, count, tables);
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    auto hash = storage.hash(hashImpl);
+    report("StateStorage walked hash", writeTime,
+        std::chrono::high_resolution_clock::now() - timePoint, hash);
+}
+
+// The hashes accumulated by bucket when written, hash() only xors the buckets
+void testIncrementalHash(bcos::crypto::Hash::Ptr hashImpl, size_t count, size_t tables)
+{
+    StateStorage storage(nullptr);
+    storage.setHashImpl(hashImpl);
+    auto writeTime = write(storage, count, tables);
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    auto hash = storage.hash(hashImpl);
+    report("StateStorage incremental hash", writeTime,
+        std::chrono::high_resolution_clock::now() - timePoint, hash);
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("State hash benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("count,c", boost::program_options::value<size_t>()->default_value(1000000), "Entries written in the block")
+        ("tables,t", boost::program_options::value<size_t>()->default_value(1000), "Tables the entries spread over")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    auto count = vm["count"].as<size_t>();
+    auto tables = vm["tables"].as<size_t>();
+    auto hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+
+    testWalkedHash(hashImpl, count, tables);
+    testIncrementalHash(hashImpl, count, tables);
+    return 0;
+}
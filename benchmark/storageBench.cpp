@@ -0,0 +1,155 @@
+#include <bcos-storage/RocksDBStorage.h>
+#include <bcos-storage/RocksDBStorage2.h>
+#include <bcos-task/Wait.h>
+#include <bcos-task/WhenAll.h>
+#include <bcos-task/WorkStealingPool.h>
+#include <rocksdb/write_batch.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace bcos::storage;
+
+constexpr static std::string_view TABLE_NAME = "bench_table";
+
+std::string benchKey(size_t index)
+{
+    return "key_" + std::to_string(index);
+}
+
+void prepare(rocksdb::DB& db, size_t count)
+{
+    rocksdb::WriteBatch writeBatch;
+    for (size_t i = 0; i < count; ++i)
+    {
+        writeBatch.Put(toDBKey(TABLE_NAME, benchKey(i)), "value_" + std::to_string(i));
+    }
+    db.Write(rocksdb::WriteOptions(), &writeBatch);
+}
+
+std::vector<size_t> randomIndexes(size_t count, size_t reads)
+{
+    std::mt19937_64 random(0);
+    std::uniform_int_distribution<size_t> distribution(0, count - 1);
+    std::vector<size_t> indexes(reads);
+    for (auto& index : indexes)
+    {
+        index = distribution(random);
+    }
+    return indexes;
+}
+
+void report(const std::string& name, size_t reads, std::chrono::nanoseconds duration)
+{
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    std::cout << name << ": " << reads << " reads in " << millis << "ms, "
+              << (double)reads * 1000 / (double)std::max<int64_t>(millis, 1) << " reads/s"
+              << std::endl;
+}
+
+// Baseline: blocking point reads of RocksDBStorage, one Get per key, spread over tbb threads
+void testAsyncGetRow(RocksDBStorage& storage, const std::vector<size_t>& indexes)
+{
+    std::atomic_size_t found = 0;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, indexes.size()), [&](tbb::blocked_range<size_t> const& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                storage.asyncGetRow(TABLE_NAME, benchKey(indexes[i]),
+                    [&found](bcos::Error::UniquePtr error, std::optional<Entry> entry) {
+                        if (!error && entry)
+                        {
+                            ++found;
+                        }
+                    });
+            }
+        });
+    report("RocksDBStorage::asyncGetRow", indexes.size(),
+        std::chrono::high_resolution_clock::now() - timePoint);
+    std::cout << "found: " << found << std::endl;
+}
+
+bcos::task::Task<bool> readOne(
+    bcos::task::WorkStealingPool& pool, RocksDBStorage2& storage, size_t index)
+{
+    co_await bcos::task::scheduleOn(pool);
+    auto key = benchKey(index);
+    auto entry = co_await storage.getRow(TABLE_NAME, key);
+    co_return entry.has_value();
+}
+
+// Coroutine point reads of RocksDBStorage2, concurrently suspended reads share MultiGet calls
+void testStorage2GetRow(bcos::task::WorkStealingPool& pool, RocksDBStorage2& storage,
+    const std::vector<size_t>& indexes, size_t concurrency)
+{
+    size_t found = 0;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (size_t offset = 0; offset < indexes.size(); offset += concurrency)
+    {
+        std::vector<bcos::task::Task<bool>> reads;
+        for (auto i = offset; i < std::min(offset + concurrency, indexes.size()); ++i)
+        {
+            reads.emplace_back(readOne(pool, storage, indexes[i]));
+        }
+        auto results = bcos::task::syncWait(bcos::task::whenAll(std::move(reads)));
+        found += std::count(results.begin(), results.end(), true);
+    }
+    report("RocksDBStorage2::getRow", indexes.size(),
+        std::chrono::high_resolution_clock::now() - timePoint);
+    std::cout << "found: " << found << ", MultiGet calls: " << storage.multiGetCalls()
+              << ", keys per MultiGet: "
+              << (double)storage.readKeys() / (double)std::max<uint64_t>(storage.multiGetCalls(), 1)
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Storage point read benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("path,p", boost::program_options::value<std::string>()->default_value("storage_bench.db"), "RocksDB path")
+        ("count,c", boost::program_options::value<size_t>()->default_value(1000000), "Keys in the table")
+        ("reads,r", boost::program_options::value<size_t>()->default_value(1000000), "Point reads per case")
+        ("concurrency,n", boost::program_options::value<size_t>()->default_value(1024), "Concurrent coroutines of RocksDBStorage2")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    auto path = vm["path"].as<std::string>();
+    auto count = vm["count"].as<size_t>();
+    auto reads = vm["reads"].as<size_t>();
+    auto concurrency = vm["concurrency"].as<size_t>();
+
+    rocksdb::Options rocksdbOptions;
+    rocksdbOptions.create_if_missing = true;
+    rocksdb::DB* db = nullptr;
+    auto status = rocksdb::DB::Open(rocksdbOptions, path, &db);
+    if (!status.ok())
+    {
+        std::cout << "Open rocksdb failed: " << status.ToString() << std::endl;
+        return -1;
+    }
+    prepare(*db, count);
+    auto indexes = randomIndexes(count, reads);
+
+    {
+        RocksDBStorage2 storage2(*db);
+        bcos::task::WorkStealingPool pool;
+        testStorage2GetRow(pool, storage2, indexes, concurrency);
+    }
+
+    RocksDBStorage storage(
+        std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(db), nullptr);
+    testAsyncGetRow(storage, indexes);
+
+    boost::filesystem::remove_all(path);
+    return 0;
+}
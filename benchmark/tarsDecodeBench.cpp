@@ -0,0 +1,136 @@
+#include "../bcos-tars-protocol/bcos-tars-protocol/impl/TarsSerializable.h"
+#include <bcos-concepts/Serialize.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-tars-protocol/protocol/BlockFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace bcostars::protocol;
+
+struct Factories
+{
+    Factories()
+      : cryptoSuite(std::make_shared<bcos::crypto::CryptoSuite>(
+            std::make_shared<bcos::crypto::Keccak256>(),
+            std::make_shared<bcos::crypto::Secp256k1Crypto>(), nullptr)),
+        transactionFactory(std::make_shared<TransactionFactoryImpl>(cryptoSuite)),
+        receiptFactory(std::make_shared<TransactionReceiptFactoryImpl>(cryptoSuite)),
+        blockFactory(std::make_shared<BlockFactoryImpl>(cryptoSuite,
+            std::make_shared<BlockHeaderFactoryImpl>(cryptoSuite), transactionFactory,
+            receiptFactory))
+    {}
+
+    bcos::crypto::CryptoSuite::Ptr cryptoSuite;
+    std::shared_ptr<TransactionFactoryImpl> transactionFactory;
+    std::shared_ptr<TransactionReceiptFactoryImpl> receiptFactory;
+    std::shared_ptr<BlockFactoryImpl> blockFactory;
+};
+
+bcos::bytes generateBlock(Factories& factories, int count, int inputSize)
+{
+    auto keyPair = factories.cryptoSuite->signatureImpl()->generateKeyPair();
+    bcos::bytes input(inputSize, 'a');
+    bcos::bytes output(inputSize / 4, 'b');
+    std::vector<bcos::protocol::LogEntry> logEntries;
+    logEntries.emplace_back(bcos::asBytes("address"),
+        bcos::h256s{bcos::h256(bcos::asBytes("topic"))}, bcos::asBytes("data"));
+
+    auto block = factories.blockFactory->createBlock();
+    block->blockHeader()->setNumber(1);
+    for (auto i = 0; i < count; ++i)
+    {
+        block->appendTransaction(factories.transactionFactory->createTransaction(0, "to", input,
+            i, 100, "chain0", "group0", 0, keyPair));
+        block->appendReceipt(factories.receiptFactory->createReceipt(
+            1000, "contract", logEntries, 0, bcos::ref(output), 1));
+    }
+    bcos::bytes buffer;
+    block->encode(buffer);
+    return buffer;
+}
+
+template <class Func>
+void bench(std::string_view name, int rounds, size_t bytes, Func&& func)
+{
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (auto i = 0; i < rounds; ++i)
+    {
+        func();
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - timePoint)
+                        .count();
+    std::cout << name << ": " << duration / 1000 << "ms, "
+              << (double)bytes * rounds / std::max<int64_t>(duration, 1) << "MB/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Tars decode benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("count,c", boost::program_options::value<int>()->default_value(1000), "Transactions in the block")
+        ("input,i", boost::program_options::value<int>()->default_value(256), "Input size of every transaction")
+        ("rounds,r", boost::program_options::value<int>()->default_value(100), "Decode rounds")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    auto count = vm["count"].as<int>();
+    auto rounds = vm["rounds"].as<int>();
+    Factories factories;
+    auto blockBuffer = generateBlock(factories, count, vm["input"].as<int>());
+
+    auto block = factories.blockFactory->createBlock(bcos::ref(blockBuffer));
+    bcos::bytes txBuffer;
+    block->transaction(0)->encode(txBuffer);
+    bcos::bytes receiptBuffer;
+    block->receipt(0)->encode(receiptBuffer);
+    std::cout << "Block: " << count << " transactions, " << blockBuffer.size() << " bytes"
+              << std::endl;
+
+    bench("Transaction[full]", rounds * count, txBuffer.size(), [&]() {
+        bcostars::Transaction transaction;
+        bcos::concepts::serialize::decode(bcos::ref(txBuffer), transaction);
+    });
+    bench("Transaction[view]", rounds * count, txBuffer.size(), [&]() {
+        auto transaction = factories.transactionFactory->createTransaction(
+            bcos::ref(txBuffer), false, false);
+        (void)transaction->hash();
+    });
+    bench("Receipt[full]", rounds * count, receiptBuffer.size(), [&]() {
+        bcostars::TransactionReceipt receipt;
+        bcos::concepts::serialize::decode(bcos::ref(receiptBuffer), receipt);
+    });
+    bench("Receipt[view]", rounds * count, receiptBuffer.size(), [&]() {
+        auto receipt = factories.receiptFactory->createReceipt(bcos::ref(receiptBuffer));
+        (void)receipt->status();
+    });
+    bench("Block[full]", rounds, blockBuffer.size(), [&]() {
+        bcostars::Block tarsBlock;
+        bcos::concepts::serialize::decode(bcos::ref(blockBuffer), tarsBlock);
+    });
+    // the typical access of the consensus: the header and the hash of every transaction
+    bench("Block[view]", rounds, blockBuffer.size(), [&]() {
+        auto decodedBlock = factories.blockFactory->createBlock(bcos::ref(blockBuffer));
+        for (size_t i = 0; i < decodedBlock->transactionsSize(); ++i)
+        {
+            (void)decodedBlock->transaction(i)->hash();
+        }
+    });
+    bench("Block[view+root]", rounds, blockBuffer.size(), [&]() {
+        auto decodedBlock = factories.blockFactory->createBlock(bcos::ref(blockBuffer));
+        (void)decodedBlock->calculateTransactionRoot(*factories.cryptoSuite->hashImpl());
+    });
+
+    return 0;
+}
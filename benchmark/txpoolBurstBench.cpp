@@ -0,0 +1,213 @@
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-protocol/TransactionSubmitResultFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/BlockFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h>
+#include <bcos-txpool/txpool/storage/MemoryStorage.h>
+#include <bcos-txpool/txpool/storage/TxPriority.h>
+#include <bcos-txpool/txpool/validator/LedgerNonceChecker.h>
+#include <bcos-txpool/txpool/validator/TxPoolNonceChecker.h>
+#include <bcos-txpool/txpool/validator/TxValidator.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+constexpr const char* CHAIN_ID = "chain0";
+constexpr const char* GROUP_ID = "group0";
+
+// the resident memory read from /proc, 0 if not supported
+size_t residentSize()
+{
+    size_t pages = 0;
+    size_t residentPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> residentPages;
+    return residentPages * 4096;
+}
+
+// the encoded txs of the burst, signed by the senders in turn
+std::vector<bytes> generateTxs(BlockFactory& blockFactory, size_t count, size_t inputSize,
+    size_t senders)
+{
+    auto cryptoSuite = blockFactory.cryptoSuite();
+    std::vector<crypto::KeyPairInterface::Ptr> keyPairs(std::max<size_t>(senders, 1));
+    for (auto& keyPair : keyPairs)
+    {
+        keyPair = cryptoSuite->signatureImpl()->generateKeyPair();
+    }
+    std::mt19937_64 random(count);
+    u256 baseNonce = (u256(random()) << 128) + (u256(random()) << 64);
+    bytes input(inputSize, 'a');
+
+    std::vector<bytes> encodedTxs(count);
+    auto txFactory = blockFactory.transactionFactory();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
+        [&](tbb::blocked_range<size_t> const& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                auto tx = txFactory->createTransaction(0, "to", input, baseNonce + i, 500,
+                    CHAIN_ID, GROUP_ID, 0, keyPairs[i % keyPairs.size()]);
+                tx->encode(encodedTxs[i]);
+            }
+        });
+    return encodedTxs;
+}
+
+TxPoolConfig::Ptr createConfig(BlockFactory::Ptr blockFactory, size_t memoryLimit,
+    std::string const& spillPath, std::string const& priority)
+{
+    auto txpoolNonceChecker = std::make_shared<TxPoolNonceChecker>();
+    auto validator = std::make_shared<TxValidator>(
+        txpoolNonceChecker, blockFactory->cryptoSuite(), GROUP_ID, CHAIN_ID);
+    validator->setLedgerNonceChecker(std::make_shared<LedgerNonceChecker>(nullptr, 0, 1000));
+    auto config = std::make_shared<TxPoolConfig>(validator,
+        std::make_shared<TransactionSubmitResultFactoryImpl>(), blockFactory, nullptr,
+        txpoolNonceChecker, 1000);
+    config->setMemoryLimit(memoryLimit);
+    config->setSpillPath(spillPath);
+    if (priority == "sender")
+    {
+        config->setTxPriority(std::make_shared<SenderFairPriority>());
+    }
+    else
+    {
+        config->setTxPriority(std::make_shared<ImportTimePriority>());
+    }
+    return config;
+}
+
+// import the burst of txs in chunks as received from the peers, then seal and commit the pending
+// txs block by block until the txpool and the spilled txs are drained
+void testBurst(std::string const& name, TxPoolConfig::Ptr config,
+    std::vector<bytes> const& encodedTxs, size_t chunkSize, size_t blockTxs)
+{
+    auto baseline = residentSize();
+    auto storage = std::make_shared<MemoryStorage>(config);
+    storage->start();
+    auto txFactory = config->txFactory();
+
+    size_t peakMemory = 0;
+    std::chrono::nanoseconds importTime(0);
+    for (size_t i = 0; i < encodedTxs.size(); i += chunkSize)
+    {
+        auto txs = std::make_shared<Transactions>(std::min(chunkSize, encodedTxs.size() - i));
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, txs->size()),
+            [&](tbb::blocked_range<size_t> const& range) {
+                for (auto j = range.begin(); j < range.end(); ++j)
+                {
+                    (*txs)[j] = txFactory->createTransaction(ref(encodedTxs[i + j]), false, false);
+                    (*txs)[j]->setImportTime(utcTime());
+                }
+            });
+        auto timePoint = std::chrono::high_resolution_clock::now();
+        storage->batchImportTxs(txs);
+        importTime += std::chrono::high_resolution_clock::now() - timePoint;
+        peakMemory = std::max(peakMemory, residentSize() - std::min(baseline, residentSize()));
+    }
+    auto pendingTxs = storage->size();
+    auto spilledTxs = storage->spilledTxsSize();
+
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    BlockNumber number = 0;
+    size_t committedTxs = 0;
+    while (true)
+    {
+        auto txsHash = storage->getTxsHash(blockTxs);
+        if (txsHash->empty())
+        {
+            break;
+        }
+        ++number;
+        storage->batchMarkTxs(*txsHash, number, crypto::HashType(), true);
+        TransactionSubmitResults results;
+        results.reserve(txsHash->size());
+        for (auto const& txHash : *txsHash)
+        {
+            auto result = config->txResultFactory()->createTxSubmitResult();
+            result->setTxHash(txHash);
+            result->setStatus((uint32_t)TransactionStatus::None);
+            results.emplace_back(std::move(result));
+        }
+        storage->batchRemove(number, results);
+        committedTxs += results.size();
+    }
+    auto drainTime = std::chrono::high_resolution_clock::now() - timePoint;
+    storage->stop();
+
+    auto tps = [](size_t txs, std::chrono::nanoseconds duration) {
+        return txs * 1000000 /
+               std::max<int64_t>(
+                   std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 1);
+    };
+    std::cout << name << ": import " << tps(encodedTxs.size(), importTime) << " txs/s, peak memory "
+              << peakMemory / 1024 / 1024 << "MB, pending " << pendingTxs << ", spilled "
+              << spilledTxs << ", committed " << committedTxs << " in " << number
+              << " blocks, drain " << tps(committedTxs, drainTime) << " txs/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Txpool burst benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("txs,t", boost::program_options::value<size_t>()->default_value(100000), "Transactions of the burst")
+        ("input,i", boost::program_options::value<size_t>()->default_value(1024), "Input size of every transaction")
+        ("senders,s", boost::program_options::value<size_t>()->default_value(100), "Senders of the transactions")
+        ("memoryLimit,m", boost::program_options::value<size_t>()->default_value(64), "Memory limit of the txpool in MB")
+        ("spillPath,p", boost::program_options::value<std::string>()->default_value("./txpoolBurstBench.spill"), "Path to spill the evicted transactions")
+        ("priority", boost::program_options::value<std::string>()->default_value("import_time"), "import_time or sender")
+        ("chunk,c", boost::program_options::value<size_t>()->default_value(1000), "Transactions imported together")
+        ("blockTxs,b", boost::program_options::value<size_t>()->default_value(10000), "Transactions sealed in a block")
+        ("txpool", boost::program_options::value<std::string>()->default_value("all"), "unlimited, evict, spill or all, run one txpool in a process to measure the memory")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    auto cryptoSuite = std::make_shared<crypto::CryptoSuite>(std::make_shared<crypto::Keccak256>(),
+        std::make_shared<crypto::Secp256k1Crypto>(), nullptr);
+    auto blockFactory = std::make_shared<bcostars::protocol::BlockFactoryImpl>(cryptoSuite,
+        std::make_shared<bcostars::protocol::BlockHeaderFactoryImpl>(cryptoSuite),
+        std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite),
+        std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(cryptoSuite));
+
+    auto encodedTxs = generateTxs(*blockFactory, vm["txs"].as<size_t>(),
+        vm["input"].as<size_t>(), vm["senders"].as<size_t>());
+    auto memoryLimit = vm["memoryLimit"].as<size_t>() * 1024 * 1024;
+    auto spillPath = vm["spillPath"].as<std::string>();
+    auto priority = vm["priority"].as<std::string>();
+    auto chunk = std::max<size_t>(vm["chunk"].as<size_t>(), 1);
+    auto blockTxs = std::max<size_t>(vm["blockTxs"].as<size_t>(), 1);
+
+    auto txpool = vm["txpool"].as<std::string>();
+    if (txpool == "unlimited" || txpool == "all")
+    {
+        testBurst("unlimited", createConfig(blockFactory, 0, "", priority), encodedTxs, chunk,
+            blockTxs);
+    }
+    if (txpool == "evict" || txpool == "all")
+    {
+        testBurst("evict", createConfig(blockFactory, memoryLimit, "", priority), encodedTxs, chunk,
+            blockTxs);
+    }
+    if (txpool == "spill" || txpool == "all")
+    {
+        testBurst("spill", createConfig(blockFactory, memoryLimit, spillPath, priority),
+            encodedTxs, chunk, blockTxs);
+        boost::filesystem::remove_all(spillPath);
+    }
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <boost/exception/error_info.hpp>
 #include <boost/exception/exception.hpp>
 #include <exception>
+#include <string>
 
 namespace bcos::error
 {
@@ -65,6 +65,18 @@ public:
         return impl().impl_getABI(contractAddress);
     }
 
+    // read the rows of the state keys with what the light node needs to verify them
+    auto getStateProof(RANGES::range auto const& keys, auto& proof)
+    {
+        return impl().impl_getStateProof(keys, proof);
+    }
+
+    // same as above, read from the given node
+    auto getStateProof(RANGES::range auto const& keys, auto& proof, auto const& nodeID)
+    {
+        return impl().impl_getStateProof(keys, proof, nodeID);
+    }
+
 
     auto getTransactions(RANGES::range auto const& hashes, RANGES::range auto& out) requires
         TransactionOrReceipt<RANGES::range_value_t<std::remove_cvref_t<decltype(out)>>>
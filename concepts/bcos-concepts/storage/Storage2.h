@@ -5,6 +5,7 @@
 #include <bcos-framework/storage/Entry.h>
 #include <bcos-task/Task.h>
 #include <bcos-utilities/Ranges.h>
+#include <array>
 #include <type_traits>
 
 namespace bcos::concepts::storage
@@ -36,20 +37,18 @@ class StorageBase
 public:
     task::Task<OptionalEntry> getRow(TableName auto const& tableName, Key auto const& key)
     {
-        RANGES::single_view<decltype(key)> keys{bytebuffer::toView(key)};
-
-        OptionalEntry entry;
-        RANGES::single_view<decltype(key)> entries(entry);
+        std::array<std::string_view, 1> keys{bytebuffer::toView(key)};
+        std::array<OptionalEntry, 1> entries;
 
         co_await impl().impl_getRows(tableName, keys, entries);
-        co_return entry;
+        co_return std::move(entries[0]);
     }
 
     task::Task<void> setRow(
         TableName auto const& tableName, Key auto const& key, bcos::storage::Entry entry)
     {
-        RANGES::single_view<decltype(key)> keys{bytebuffer::toView(key)};
-        RANGES::single_view<decltype(key)> entries(&entry);
+        std::array<std::string_view, 1> keys{bytebuffer::toView(key)};
+        std::array<bcos::storage::Entry, 1> entries{std::move(entry)};
 
         co_await impl().impl_setRows(tableName, keys, entries);
     }
@@ -69,6 +68,7 @@ public:
     task::Task<void> createTable(TableName auto const& tableName)
     {
         // Impl it
+        co_return;
     }
 
 private:
@@ -59,6 +59,7 @@
 #include <bcos-tool/NodeConfig.h>
 #include <bcos-tool/NodeTimeMaintenance.h>
 #include <util/tc_clientsocket.h>
+#include <optional>
 #include <vector>
 
 using namespace bcos;
@@ -153,11 +154,12 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
     if (boost::iequals(m_nodeConfig->storageType(), "RocksDB"))
     {
         // m_protocolInitializer->dataEncryption() will return nullptr when storage_security = false
-        storage = StorageInitializer::build(
-            storagePath, m_protocolInitializer->dataEncryption(), m_nodeConfig->keyPageSize());
+        storage = StorageInitializer::build(storagePath, m_protocolInitializer->dataEncryption(),
+            m_nodeConfig->keyPageSize(), m_nodeConfig->storageSecurityBlockLevel(),
+            m_nodeConfig->enablePipelinedWrite());
         schedulerStorage = storage;
-        consensusStorage = StorageInitializer::build(
-            consensusStoragePath, m_protocolInitializer->dataEncryption());
+        consensusStorage = StorageInitializer::build(consensusStoragePath,
+            m_protocolInitializer->dataEncryption(), 0, m_nodeConfig->storageSecurityBlockLevel());
         airExecutorStorage = storage;
     }
     else if (boost::iequals(m_nodeConfig->storageType(), "TiKV"))
@@ -213,15 +215,32 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
     auto transactionSubmitResultFactory =
         std::make_shared<protocol::TransactionSubmitResultFactoryImpl>();
 
+    if (m_nodeConfig->enableNodeRuntime())
+    {
+        // the ThreadPools and workers of the node run on a fixed set of threads
+        m_nodeRuntime = std::make_shared<bcos::NodeRuntime>("runtime",
+            m_nodeConfig->runtimeWorkerThreads(), m_nodeConfig->runtimeIOThreads(),
+            m_nodeConfig->runtimePinThreads());
+        m_nodeRuntime->startReport(m_nodeConfig->runtimeReportInterval());
+    }
     // init the txpool
-    m_txpoolInitializer = std::make_shared<TxPoolInitializer>(
-        m_nodeConfig, m_protocolInitializer, m_frontServiceInitializer->front(), ledger);
+    {
+        // the ThreadPools created in the scope are scheduled on the runtime
+        std::optional<bcos::NodeRuntime::Scope> scope;
+        if (m_nodeRuntime)
+        {
+            scope.emplace(m_nodeRuntime, m_nodeConfig->groupId(), bcos::TaskPriority::Rpc);
+        }
+        m_txpoolInitializer = std::make_shared<TxPoolInitializer>(
+            m_nodeConfig, m_protocolInitializer, m_frontServiceInitializer->front(), ledger);
+    }
 
     auto factory = SchedulerInitializer::buildFactory(executorManager, ledger, schedulerStorage,
         executionMessageFactory, m_protocolInitializer->blockFactory(),
         m_txpoolInitializer->txpool(), m_protocolInitializer->txResultFactory(),
         m_protocolInitializer->cryptoSuite()->hashImpl(), m_nodeConfig->isAuthCheck(),
         m_nodeConfig->isWasm(), m_nodeConfig->isSerialExecute());
+    factory->setPreExecuteProposal(m_nodeConfig->preExecuteProposal());
 
     int64_t schedulerSeq = 0;  // In Max node, this seq will be update after consensus module switch
                                // to a leader during startup
@@ -295,6 +314,12 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
     auto nodeTimeMaintenance = std::make_shared<NodeTimeMaintenance>();
 
     // build and init the pbft related modules
+    std::optional<bcos::NodeRuntime::Scope> consensusScope;
+    if (m_nodeRuntime)
+    {
+        consensusScope.emplace(
+            m_nodeRuntime, m_nodeConfig->groupId(), bcos::TaskPriority::Consensus);
+    }
     if (_nodeArchType == protocol::NodeArchitectureType::AIR)
     {
         m_pbftInitializer = std::make_shared<PBFTInitializer>(_nodeArchType, m_nodeConfig,
@@ -343,6 +368,20 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
             consensus->clearExceptionProposalState(blockNumber);
         });
     }
+    consensusScope.reset();
+    if (m_nodeRuntime)
+    {
+        // the rounds of the workers are scheduled with the group and priority of every worker
+        m_workerReactor = std::make_shared<bcos::WorkerReactor>(m_nodeRuntime);
+        m_pbftInitializer->attachWorkerReactor(m_workerReactor);
+    }
+    else if (m_nodeConfig->workerReactorThreads() > 0)
+    {
+        // the sealer/consensus/sync workers share a few threads and are woken up when work arrives
+        m_workerReactor = std::make_shared<bcos::WorkerReactor>(
+            "workerReactor", m_nodeConfig->workerReactorThreads());
+        m_pbftInitializer->attachWorkerReactor(m_workerReactor);
+    }
     // init the txpool
     m_txpoolInitializer->init(m_pbftInitializer->sealer());
 
@@ -384,7 +423,8 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
             m_lightNodeInitializer->initLedgerServer(
                 std::dynamic_pointer_cast<bcos::front::FrontService>(
                     m_frontServiceInitializer->front()),
-                ledger, transactionPool, scheduler);
+                ledger, transactionPool, scheduler, m_protocolInitializer->cryptoSuite(),
+                m_protocolInitializer->keyPair());
         },
         anyHasher);
 #endif
@@ -527,6 +567,14 @@ void Initializer::stop()
         {
             m_txpoolInitializer->stop();
         }
+        if (m_workerReactor)
+        {
+            m_workerReactor->stop();
+        }
+        if (m_nodeRuntime)
+        {
+            m_nodeRuntime->stop();
+        }
         if (m_scheduler)
         {
             m_scheduler->stop();
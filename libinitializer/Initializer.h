@@ -28,6 +28,8 @@
 #include <bcos-executor/src/executor/SwitchExecutorManager.h>
 #include <bcos-scheduler/src/SchedulerManager.h>
 #include <bcos-utilities/BoostLogInitializer.h>
+#include <bcos-utilities/NodeRuntime.h>
+#include <bcos-utilities/WorkerReactor.h>
 #include <memory>
 #ifdef WITH_LIGHTNODE
 #include "LightNodeInitializer.h"
@@ -91,6 +93,8 @@ private:
     FrontServiceInitializer::Ptr m_frontServiceInitializer;
     TxPoolInitializer::Ptr m_txpoolInitializer;
     PBFTInitializer::Ptr m_pbftInitializer;
+    bcos::WorkerReactor::Ptr m_workerReactor;
+    bcos::NodeRuntime::Ptr m_nodeRuntime;
 #ifdef WITH_LIGHTNODE
     // Note: since LightNodeInitializer use weak_ptr of shared_from_this, this object must be exists
     // for the whole life time
@@ -42,6 +42,12 @@ public:
             auto ledger = std::make_shared<bcos::ledger::LedgerImpl<
                 bcos::crypto::hasher::openssl::OpenSSL_SM3_Hasher, decltype(storageWrapper)>>(
                 std::move(storageWrapper), blockFactory, storage);
+            ledger->setEnableGroupCommit(nodeConfig->enableGroupCommit());
+            if (nodeConfig->ledgerCacheSize() > 0)
+            {
+                ledger->setLedgerCache(std::make_shared<bcos::ledger::LedgerCache>(
+                    nodeConfig->ledgerCacheSize()));
+            }
             ledger->buildGenesisBlock(nodeConfig->ledgerConfig(), nodeConfig->txGasLimit(),
                 nodeConfig->genesisData(), nodeConfig->compatibilityVersionStr());
 
@@ -51,6 +57,12 @@ public:
         auto ledger = std::make_shared<bcos::ledger::LedgerImpl<
             bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher, decltype(storageWrapper)>>(
             std::move(storageWrapper), blockFactory, storage);
+        ledger->setEnableGroupCommit(nodeConfig->enableGroupCommit());
+        if (nodeConfig->ledgerCacheSize() > 0)
+        {
+            ledger->setLedgerCache(
+                std::make_shared<bcos::ledger::LedgerCache>(nodeConfig->ledgerCacheSize()));
+        }
         ledger->buildGenesisBlock(nodeConfig->ledgerConfig(), nodeConfig->txGasLimit(),
             nodeConfig->genesisData(), nodeConfig->compatibilityVersionStr());
 
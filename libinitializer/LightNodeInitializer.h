@@ -5,6 +5,7 @@
 #include "bcos-concepts/Exception.h"
 #include <bcos-concepts/ledger/Ledger.h>
 #include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-framework/front/FrontServiceInterface.h>
 #include <bcos-framework/protocol/Protocol.h>
 #include <bcos-framework/storage/StorageInterface.h>
@@ -13,6 +14,7 @@
 #include <bcos-ledger/src/libledger/LedgerImpl.h>
 #include <bcos-lightnode/Log.h>
 #include <bcos-lightnode/scheduler/SchedulerWrapperImpl.h>
+#include <bcos-lightnode/state/StateProof.h>
 #include <bcos-lightnode/transaction-pool/TransactionPoolImpl.h>
 #include <bcos-protocol/TransactionStatus.h>
 #include <bcos-scheduler/src/SchedulerImpl.h>
@@ -34,8 +36,12 @@ public:
             transactionPool,
         std::shared_ptr<bcos::scheduler::SchedulerWrapperImpl<
             std::shared_ptr<bcos::scheduler::SchedulerInterface>>>
-            scheduler)
+            scheduler,
+        bcos::crypto::CryptoSuite::Ptr cryptoSuite, bcos::crypto::KeyPairInterface::Ptr keyPair)
     {
+        m_cryptoSuite = std::move(cryptoSuite);
+        m_keyPair = std::move(keyPair);
+
         auto weakFront = std::weak_ptr<bcos::front::FrontService>(front);
         auto self = std::weak_ptr<LightNodeInitializer>(shared_from_this());
         front->registerModuleMessageDispatcher(bcos::protocol::LIGHTNODE_GET_BLOCK,
@@ -188,6 +194,25 @@ public:
                         []([[maybe_unused]] const Error::Ptr& error) {});
                 }(ledger, std::move(front), std::move(nodeID), std::string(id), data));
             });
+        front->registerModuleMessageDispatcher(bcos::protocol::LIGHTNODE_GET_STATE_PROOF,
+            [self, ledger, weakFront](
+                bcos::crypto::NodeIDPtr nodeID, const std::string& id, bytesConstRef data) {
+                auto front = weakFront.lock();
+                auto init = self.lock();
+                if (!front || !init)
+                {
+                    return;
+                }
+
+                bcostars::RequestGetStateProof request;
+                if (!init->decodeRequest<bcostars::ResponseGetStateProof>(
+                        request, front, protocol::LIGHTNODE_GET_STATE_PROOF, nodeID, id, data))
+                {
+                    return;
+                }
+                bcos::task::wait(init->getStateProof(
+                    std::move(front), ledger, std::move(nodeID), id, std::move(request)));
+            });
         front->registerModuleMessageDispatcher(bcos::protocol::LIGHTNODE_SEND_TRANSACTION,
             [transactionPool, self, weakFront](
                 bcos::crypto::NodeIDPtr nodeID, const std::string& id, bytesConstRef data) {
@@ -285,6 +310,50 @@ private:
             });
     }
 
+    task::Task<void> getStateProof(std::shared_ptr<bcos::front::FrontService> front,
+        bcos::concepts::ledger::Ledger auto ledger, bcos::crypto::NodeIDPtr nodeID,
+        std::string id, bcostars::RequestGetStateProof request)
+    {
+        bcostars::ResponseGetStateProof response;
+        try
+        {
+            LIGHTNODE_LOG(DEBUG) << "Get state proof:" << request.keys.size();
+            if (request.keys.empty() || request.keys.size() > MAX_STATE_PROOF_KEYS)
+            {
+                BOOST_THROW_EXCEPTION(std::invalid_argument{
+                    "Invalid state keys size: " + std::to_string(request.keys.size())});
+            }
+
+            co_await concepts::getRef(ledger).getStateProof(request.keys, response);
+
+            // sign the read set, the light node only accepts the proofs signed by the sealers
+            std::visit(
+                [this, &response](auto& hasher) {
+                    using Hasher = std::remove_cvref_t<decltype(hasher)>;
+                    auto stateRoot = bcos::lightnode::calculateStateRoot<Hasher>(response.values);
+                    auto hash = bcos::lightnode::calculateStateProofHash<Hasher>(
+                        response.blockNumber, response.blockHash, stateRoot);
+                    auto signature = m_cryptoSuite->signatureImpl()->sign(*m_keyPair, hash);
+                    response.signature.assign(signature->begin(), signature->end());
+                },
+                m_cryptoSuite->hashImpl()->hasher());
+            auto const& publicKey = m_keyPair->publicKey()->data();
+            response.nodeID.assign(publicKey.begin(), publicKey.end());
+        }
+        catch (std::exception& e)
+        {
+            LIGHTNODE_LOG(WARNING) << "Get state proof error!" << boost::diagnostic_information(e);
+            response.error.errorCode = -1;
+            response.error.errorMessage = boost::diagnostic_information(e);
+            response.values.clear();
+        }
+
+        bcos::bytes responseBuffer;
+        bcos::concepts::serialize::encode(response, responseBuffer);
+        front->asyncSendResponse(id, bcos::protocol::LIGHTNODE_GET_STATE_PROOF, nodeID,
+            bcos::ref(responseBuffer), [](Error::Ptr) {});
+    }
+
     task::Task<void> submitTransaction(std::shared_ptr<bcos::front::FrontService> front,
         std::shared_ptr<bcos::transaction_pool::TransactionPoolImpl<
             std::shared_ptr<bcos::txpool::TxPoolInterface>>>
@@ -335,5 +404,11 @@ private:
         front->asyncSendResponse(id, bcos::protocol::LIGHTNODE_CALL, nodeID,
             bcos::ref(responseBuffer), [](Error::Ptr) {});
     }
+
+    // a contract call reads tens of keys, bound the work of one request
+    constexpr static size_t MAX_STATE_PROOF_KEYS = 1024;
+
+    bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
+    bcos::crypto::KeyPairInterface::Ptr m_keyPair;
 };
 }  // namespace bcos::initializer
\ No newline at end of file
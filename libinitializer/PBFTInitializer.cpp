@@ -39,6 +39,7 @@
 #include <bcos-utilities/FileUtility.h>
 #include <include/BuildInfo.h>
 #include <json/json.h>
+#include <optional>
 
 using namespace bcos;
 using namespace bcos::tool;
@@ -280,6 +281,21 @@ void PBFTInitializer::registerHandlers()
         }
     });
 
+    // the consensus module notify the time cost of the scheduler to the sealer
+    m_pbft->registerBlockCostNotifier(
+        [weakedSealer](bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost) {
+            if (auto sealer = weakedSealer.lock())
+            {
+                sealer->asyncNoteBlockExecuted(_number, _txsSize, _timeCost);
+            }
+        },
+        [weakedSealer](bcos::protocol::BlockNumber _number, size_t _txsSize, uint64_t _timeCost) {
+            if (auto sealer = weakedSealer.lock())
+            {
+                sealer->asyncNoteBlockCommitted(_number, _txsSize, _timeCost);
+            }
+        });
+
     // the consensus moudle notify new block to the sync module
     std::weak_ptr<BlockSyncInterface> weakedSync = m_blockSync;
     m_pbft->registerNewBlockNotifier([weakedSync](bcos::ledger::LedgerConfig::Ptr _ledgerConfig,
@@ -391,6 +407,8 @@ void PBFTInitializer::createSealer()
     // create sealer
     auto sealerFactory = std::make_shared<SealerFactory>(m_protocolInitializer->blockFactory(),
         m_txpool, m_nodeConfig->minSealTime(), m_nodeTimeMaintenance);
+    sealerFactory->setAdaptiveSealing(m_nodeConfig->adaptiveSealing(),
+        m_nodeConfig->targetBlockTime(), m_nodeConfig->minTxsPerBlock());
     m_sealer = sealerFactory->createSealer();
 }
 
@@ -402,15 +420,28 @@ void PBFTInitializer::createPBFT()
     auto pbftFactory = std::make_shared<PBFTFactory>(m_protocolInitializer->cryptoSuite(),
         m_protocolInitializer->keyPair(), m_frontService, kvStorage, m_ledger, m_scheduler,
         m_txpool, m_protocolInitializer->blockFactory(), m_protocolInitializer->txResultFactory());
+    if (m_nodeConfig->enableConsensusWAL())
+    {
+        pbftFactory->setConsensusWALPath(m_nodeConfig->storagePath() + "/consensus_wal");
+    }
 
     m_pbft = pbftFactory->createPBFT();
     auto pbftConfig = m_pbft->pbftEngine()->pbftConfig();
     pbftConfig->setCheckPointTimeoutInterval(m_nodeConfig->checkPointTimeoutInterval());
     pbftConfig->setMinSealTime(m_nodeConfig->minSealTime());
+    pbftConfig->setProposalDissemination(m_nodeConfig->proposalDissemination());
+    pbftConfig->setVoteCollection(m_nodeConfig->voteCollection());
+    pbftConfig->setPreExecuteProposal(m_nodeConfig->preExecuteProposal());
 }
 
 void PBFTInitializer::createSync()
 {
+    // the ThreadPools of the sync run after the consensus on the shared runtime
+    std::optional<bcos::NodeRuntime::Scope> scope;
+    if (auto const* current = bcos::NodeRuntime::currentScope())
+    {
+        scope.emplace(current->runtime(), current->group(), bcos::TaskPriority::Sync);
+    }
     // create sync
     auto keyPair = m_protocolInitializer->keyPair();
     auto blockSyncFactory = std::make_shared<BlockSyncFactory>(keyPair->publicKey(),
@@ -436,6 +467,26 @@ std::shared_ptr<bcos::sealer::SealerInterface> PBFTInitializer::sealer()
     return m_sealer;
 }
 
+void PBFTInitializer::attachWorkerReactor(std::shared_ptr<bcos::WorkerReactor> _reactor)
+{
+    auto const& groupID = m_nodeConfig->groupId();
+    m_sealer->attachReactor(_reactor, groupID, bcos::TaskPriority::Consensus);
+    m_pbft->pbftEngine()->attachReactor(_reactor, groupID, bcos::TaskPriority::Consensus);
+    m_blockSync->attachReactor(_reactor, groupID, bcos::TaskPriority::Sync);
+    auto txpool = std::dynamic_pointer_cast<bcos::txpool::TxPool>(m_txpool);
+    if (txpool)
+    {
+        auto transactionSync =
+            std::dynamic_pointer_cast<bcos::Worker>(txpool->transactionSync());
+        if (transactionSync)
+        {
+            transactionSync->attachReactor(_reactor, groupID, bcos::TaskPriority::Sync);
+        }
+    }
+    INITIALIZER_LOG(INFO) << LOG_DESC("attachWorkerReactor")
+                          << LOG_KV("threads", _reactor->threadCount());
+}
+
 // sync groupNodeInfo from the gateway
 void PBFTInitializer::syncGroupNodeInfo()
 {
@@ -36,6 +36,7 @@
 #include <bcos-ledger/src/libledger/Ledger.h>
 #include <fisco-bcos-tars-service/Common/TarsUtils.h>
 #include <bcos-tool/NodeTimeMaintenance.h>
+#include <bcos-utilities/WorkerReactor.h>
 
 namespace bcos
 {
@@ -78,6 +79,9 @@ public:
     bcos::consensus::ConsensusInterface::Ptr pbft();
     bcos::sealer::SealerInterface::Ptr sealer();
 
+    // run the workers of sealer, consensus and sync on the shared reactor, before start
+    virtual void attachWorkerReactor(std::shared_ptr<bcos::WorkerReactor> _reactor);
+
     bcos::protocol::BlockFactory::Ptr blockFactory()
     {
         return m_protocolInitializer->blockFactory();
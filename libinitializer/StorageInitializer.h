@@ -29,15 +29,43 @@
 #include "rocksdb/write_batch.h"
 #include <bcos-framework/security/DataEncryptInterface.h>
 #include <bcos-framework/storage/StorageInterface.h>
+#include <bcos-storage/RocksDBEncryption.h>
 #include <bcos-storage/RocksDBStorage.h>
 #include <bcos-storage/TiKVStorage.h>
+#include <fstream>
 
 namespace bcos::initializer
 {
 class StorageInitializer
 {
 public:
-    static auto createRocksDB(const std::string& _path)
+    // the database encrypted by blocks can't be opened without the encryption and vice versa
+    constexpr static std::string_view c_blockEncryptionMarker = "BLOCK_ENCRYPTION";
+
+    static void checkEncryptionMarker(const std::string& _path, bool _blockEncryption)
+    {
+        auto marker = boost::filesystem::path(_path) / std::string(c_blockEncryptionMarker);
+        auto exists = boost::filesystem::exists(boost::filesystem::path(_path) / "CURRENT");
+        if (_blockEncryption && exists && !boost::filesystem::exists(marker))
+        {
+            BCOS_LOG(ERROR) << LOG_DESC("the storage is not encrypted by blocks")
+                            << LOG_KV("path", _path);
+            throw std::runtime_error("the storage " + _path +
+                                     " is not encrypted by blocks, migrate it by storage tool");
+        }
+        if (!_blockEncryption && boost::filesystem::exists(marker))
+        {
+            BCOS_LOG(ERROR) << LOG_DESC("the storage is encrypted by blocks")
+                            << LOG_KV("path", _path);
+            throw std::runtime_error("the storage " + _path +
+                                     " is encrypted by blocks, set storage_security.level=block");
+        }
+    }
+
+    // encrypt all the files of the database by blocks if _blockEncryption is set
+    static auto createRocksDB(const std::string& _path,
+        const bcos::security::DataEncryptInterface::Ptr& _blockEncryption = nullptr,
+        bool _enablePipelinedWrite = false)
     {
         boost::filesystem::create_directories(_path);
         rocksdb::DB* db;
@@ -53,6 +81,8 @@ public:
         options.compression = rocksdb::kZSTD;
         options.max_open_files = 512;
         // options.min_blob_size = 1024;
+        // the WAL write of a block overlaps the memtable write of the previous one
+        options.enable_pipelined_write = _enablePipelinedWrite;
 
         if (boost::filesystem::space(_path).available < 1024 * 1024 * 100)
         {
@@ -60,6 +90,17 @@ public:
             throw std::runtime_error("available disk space is less than 100MB");
         }
 
+        checkEncryptionMarker(_path, _blockEncryption != nullptr);
+        std::shared_ptr<rocksdb::Env> env;
+        if (_blockEncryption)
+        {
+            env = bcos::storage::newBlockEncryptedEnv(*_blockEncryption);
+            options.env = env.get();
+            std::ofstream(
+                (boost::filesystem::path(_path) / std::string(c_blockEncryptionMarker)).string())
+                << (_blockEncryption->smCryptoType() ? "SM4-CTR" : "AES-256-CTR");
+        }
+
         // open DB
         rocksdb::Status status = rocksdb::DB::Open(options, _path, &db);
         if (!status.ok())
@@ -67,8 +108,9 @@ public:
             BCOS_LOG(INFO) << LOG_DESC("open rocksDB failed") << LOG_KV("error", status.ToString());
             throw std::runtime_error("open rocksDB failed, err:" + status.ToString());
         }
+        // the env is released after the db
         return std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(
-            db, [](rocksdb::DB* db) {
+            db, [env = std::move(env)](rocksdb::DB* db) {
                 CancelAllBackgroundWork(db, true);
                 db->Close();
                 delete db;
@@ -76,12 +118,78 @@ public:
     }
     static bcos::storage::TransactionalStorageInterface::Ptr build(const std::string& _storagePath,
         const bcos::security::DataEncryptInterface::Ptr _dataEncrypt,
-        [[maybe_unused]] size_t keyPageSize = 0)
+        [[maybe_unused]] size_t keyPageSize = 0, bool _blockEncryption = false,
+        bool _enablePipelinedWrite = false)
     {
-        auto unique_db = createRocksDB(_storagePath);
+        if (_dataEncrypt && _blockEncryption)
+        {
+            // the values are written in plain, encrypted with the files
+            auto unique_db = createRocksDB(_storagePath, _dataEncrypt, _enablePipelinedWrite);
+            return std::make_shared<bcos::storage::RocksDBStorage>(std::move(unique_db), nullptr);
+        }
+        auto unique_db = createRocksDB(_storagePath, nullptr, _enablePipelinedWrite);
         return std::make_shared<bcos::storage::RocksDBStorage>(std::move(unique_db), _dataEncrypt);
     }
 
+    // copy the database encrypted by values to a new database encrypted by blocks, the source
+    // should not be opened by the node, returns the number of the entries copied
+    static size_t migrateToBlockEncryption(const std::string& _srcPath, const std::string& _dstPath,
+        const bcos::security::DataEncryptInterface::Ptr& _dataEncrypt)
+    {
+        if (!boost::filesystem::exists(boost::filesystem::path(_srcPath) / "CURRENT"))
+        {
+            throw std::runtime_error("the storage to migrate not exists: " + _srcPath);
+        }
+        if (boost::filesystem::exists(boost::filesystem::path(_dstPath) / "CURRENT"))
+        {
+            throw std::runtime_error("the target storage already exists: " + _dstPath);
+        }
+        auto srcDB = createRocksDB(_srcPath);
+        auto dstDB = createRocksDB(_dstPath, _dataEncrypt);
+
+        constexpr size_t maxBatchSize = 64 * 1024 * 1024;
+        size_t count = 0;
+        rocksdb::WriteBatch writeBatch;
+        auto write = [&]() {
+            auto status = dstDB->Write(rocksdb::WriteOptions(), &writeBatch);
+            if (!status.ok())
+            {
+                throw std::runtime_error("write the migrated storage failed: " + status.ToString());
+            }
+            writeBatch.Clear();
+        };
+        std::unique_ptr<rocksdb::Iterator> it(srcDB->NewIterator(rocksdb::ReadOptions()));
+        for (it->SeekToFirst(); it->Valid(); it->Next())
+        {
+            // the empty values are not encrypted
+            auto value = it->value().ToString();
+            if (!value.empty())
+            {
+                value = _dataEncrypt->decrypt(value);
+            }
+            writeBatch.Put(it->key(), value);
+            ++count;
+            if (writeBatch.GetDataSize() >= maxBatchSize)
+            {
+                write();
+            }
+        }
+        if (!it->status().ok())
+        {
+            throw std::runtime_error("read the storage to migrate failed: " +
+                                     it->status().ToString());
+        }
+        write();
+        auto status = dstDB->Flush(rocksdb::FlushOptions());
+        if (!status.ok())
+        {
+            throw std::runtime_error("flush the migrated storage failed: " + status.ToString());
+        }
+        BCOS_LOG(INFO) << LOG_DESC("migrateToBlockEncryption") << LOG_KV("src", _srcPath)
+                       << LOG_KV("dst", _dstPath) << LOG_KV("count", count);
+        return count;
+    }
+
 #ifdef WITH_TIKV
     static bcos::storage::TransactionalStorageInterface::Ptr build(
         const std::vector<std::string>& _pdAddrs, const std::string& _logPath,
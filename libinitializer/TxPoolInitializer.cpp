@@ -21,6 +21,7 @@
 #include "TxPoolInitializer.h"
 #include "Common.h"
 #include <bcos-txpool/TxPoolFactory.h>
+#include <bcos-txpool/txpool/storage/TxPriority.h>
 #include <fisco-bcos-tars-service/Common/TarsUtils.h>
 
 #include <utility>
@@ -49,6 +50,16 @@ TxPoolInitializer::TxPoolInitializer(bcos::tool::NodeConfig::Ptr _nodeConfig,
         m_nodeConfig->verifierWorkerNum(), m_nodeConfig->txsExpirationTime());
     auto txpoolConfig = m_txpool->txpoolConfig();
     txpoolConfig->setPoolLimit(m_nodeConfig->txpoolLimit());
+    txpoolConfig->setMemoryLimit(m_nodeConfig->txpoolMemoryLimit());
+    txpoolConfig->setSpillPath(m_nodeConfig->txpoolSpillPath());
+    if (m_nodeConfig->txpoolPriority() == "sender")
+    {
+        txpoolConfig->setTxPriority(std::make_shared<bcos::txpool::SenderFairPriority>());
+    }
+    else
+    {
+        txpoolConfig->setTxPriority(std::make_shared<bcos::txpool::ImportTimePriority>());
+    }
 }
 
 void TxPoolInitializer::init(bcos::sealer::SealerInterface::Ptr _sealer)
@@ -0,0 +1,52 @@
+#pragma once
+#include <bcos-concepts/Exception.h>
+#include <boost/throw_exception.hpp>
+#include <atomic>
+#include <memory>
+
+namespace bcos::task
+{
+
+// clang-format off
+struct TaskCancelled : public bcos::error::Exception {};
+// clang-format on
+
+// Cooperative cancellation: the owner of a CancellationSource requests the stop, running tasks
+// observe it through their CancellationToken at their next cancellation point
+class CancellationToken
+{
+public:
+    CancellationToken() = default;
+    explicit CancellationToken(std::shared_ptr<std::atomic_bool> flag) : m_flag(std::move(flag)) {}
+
+    bool cancellable() const noexcept { return m_flag != nullptr; }
+    bool cancelled() const noexcept
+    {
+        return m_flag && m_flag->load(std::memory_order_acquire);
+    }
+    void throwIfCancelled() const
+    {
+        if (cancelled())
+        {
+            BOOST_THROW_EXCEPTION(TaskCancelled{});
+        }
+    }
+
+private:
+    std::shared_ptr<std::atomic_bool> m_flag;
+};
+
+class CancellationSource
+{
+public:
+    CancellationSource() : m_flag(std::make_shared<std::atomic_bool>(false)) {}
+
+    CancellationToken token() const { return CancellationToken(m_flag); }
+    void cancel() noexcept { m_flag->store(true, std::memory_order_release); }
+    bool cancelled() const noexcept { return m_flag->load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<std::atomic_bool> m_flag;
+};
+
+}  // namespace bcos::task
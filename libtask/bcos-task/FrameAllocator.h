@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <new>
+
+namespace bcos::task
+{
+
+// Per-thread recycling allocator for coroutine frames
+// Frames are grouped into fixed size classes, freed frames are kept in a thread local free list
+// and handed out again to the next coroutine of the same class, so the steady state of a busy
+// thread does not touch the global heap. A frame may be released on another thread than the one
+// that allocated it (tasks migrate between pool workers), the block simply joins the free list of
+// the releasing thread.
+class FrameAllocator
+{
+public:
+    constexpr static size_t GRANULARITY = 64;
+    constexpr static size_t CLASS_COUNT = 16;
+    constexpr static size_t MAX_FRAME_SIZE = GRANULARITY * CLASS_COUNT;
+    constexpr static size_t MAX_CACHED_PER_CLASS = 256;
+
+    static void* allocate(size_t size)
+    {
+        if (size > MAX_FRAME_SIZE) [[unlikely]]
+        {
+            return ::operator new(size);
+        }
+
+        auto& freeList = local().m_classes[sizeClass(size)];
+        if (freeList.head != nullptr)
+        {
+            auto* block = freeList.head;
+            freeList.head = block->next;
+            --freeList.count;
+            return block;
+        }
+        return ::operator new((sizeClass(size) + 1) * GRANULARITY);
+    }
+
+    static void deallocate(void* ptr, size_t size) noexcept
+    {
+        if (size > MAX_FRAME_SIZE) [[unlikely]]
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        auto& freeList = local().m_classes[sizeClass(size)];
+        if (freeList.count >= MAX_CACHED_PER_CLASS)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        auto* block = static_cast<Block*>(ptr);
+        block->next = freeList.head;
+        freeList.head = block;
+        ++freeList.count;
+    }
+
+    // Number of frames currently cached by the calling thread, for tests and benchmarks
+    static size_t cachedFrames() noexcept
+    {
+        size_t total = 0;
+        for (auto const& freeList : local().m_classes)
+        {
+            total += freeList.count;
+        }
+        return total;
+    }
+
+private:
+    struct Block
+    {
+        Block* next;
+    };
+    struct FreeList
+    {
+        Block* head = nullptr;
+        size_t count = 0;
+    };
+
+    FrameAllocator() = default;
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+    ~FrameAllocator()
+    {
+        for (auto& freeList : m_classes)
+        {
+            while (freeList.head != nullptr)
+            {
+                auto* block = freeList.head;
+                freeList.head = block->next;
+                ::operator delete(block);
+            }
+        }
+    }
+
+    constexpr static size_t sizeClass(size_t size) noexcept
+    {
+        return size == 0 ? 0 : (size - 1) / GRANULARITY;
+    }
+
+    static FrameAllocator& local() noexcept
+    {
+        thread_local FrameAllocator allocator;
+        return allocator;
+    }
+
+    std::array<FreeList, CLASS_COUNT> m_classes;
+};
+
+}  // namespace bcos::task
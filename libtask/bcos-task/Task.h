@@ -1,5 +1,6 @@
 #pragma once
 #include "Coroutine.h"
+#include "FrameAllocator.h"
 #include <bcos-concepts/Exception.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
@@ -31,6 +32,12 @@ public:
     template <class PromiseImpl>
     struct PromiseBase
     {
+        static void* operator new(size_t size) { return FrameAllocator::allocate(size); }
+        static void operator delete(void* ptr, size_t size) noexcept
+        {
+            FrameAllocator::deallocate(ptr, size);
+        }
+
         constexpr CO_STD::suspend_always initial_suspend() const noexcept { return {}; }
         constexpr auto final_suspend() const noexcept
         {
@@ -87,6 +94,7 @@ public:
     {
         m_handle = task.m_handle;
         task.m_handle = nullptr;
+        return *this;
     }
     ~TaskBase() = default;
 
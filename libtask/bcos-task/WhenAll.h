@@ -0,0 +1,136 @@
+#pragma once
+#include "Coroutine.h"
+#include "Task.h"
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace bcos::task
+{
+namespace detail
+{
+template <class ChildTask>
+using WhenAllValue = std::conditional_t<std::is_void_v<typename ChildTask::ReturnType>,
+    std::monostate, typename ChildTask::ReturnType>;
+
+// Counts finished children, the awaiting coroutine holds one extra count until it has
+// suspended so that a child completing on another thread can never resume it too early
+class WhenAllLatch
+{
+public:
+    explicit WhenAllLatch(size_t count) : m_count(count + 1) {}
+
+    bool await_ready() const noexcept { return m_count.load(std::memory_order_acquire) == 1; }
+    bool await_suspend(CO_STD::coroutine_handle<> handle) noexcept
+    {
+        m_continuation = handle;
+        return m_count.fetch_sub(1, std::memory_order_acq_rel) > 1;
+    }
+    void await_resume() const
+    {
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    void arrive() noexcept
+    {
+        if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_continuation.resume();
+        }
+    }
+    void fail(std::exception_ptr error) noexcept
+    {
+        if (!m_failed.test_and_set())
+        {
+            m_error = std::move(error);
+        }
+    }
+
+private:
+    std::atomic_size_t m_count;
+    std::atomic_flag m_failed = ATOMIC_FLAG_INIT;
+    std::exception_ptr m_error;
+    CO_STD::coroutine_handle<> m_continuation;
+};
+
+template <class ChildTask, class Result>
+Task<void> runWhenAllChild(WhenAllLatch& latch, Result& result, ChildTask task)
+{
+    try
+    {
+        if constexpr (std::is_void_v<typename ChildTask::ReturnType>)
+        {
+            co_await task;
+            result.emplace();
+        }
+        else
+        {
+            result.emplace(co_await task);
+        }
+    }
+    catch (...)
+    {
+        latch.fail(std::current_exception());
+    }
+    // Must be the last access to latch and result, the parent may be gone once it returns
+    latch.arrive();
+}
+}  // namespace detail
+
+// Run all tasks concurrently and resume when every one of them has finished
+// Children that never suspend run inline one after another, children that co_await
+// scheduleOn(pool) run in parallel. The first exception, if any, is rethrown after all children
+// have finished. The caller is resumed on the thread that finished the last child.
+template <class Value>
+Task<std::conditional_t<std::is_void_v<Value>, void, std::vector<Value>>> whenAll(
+    std::vector<Task<Value>> tasks)
+{
+    detail::WhenAllLatch latch(tasks.size());
+    std::vector<std::optional<detail::WhenAllValue<Task<Value>>>> results(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        detail::runWhenAllChild(latch, results[i], std::move(tasks[i])).run();
+    }
+    co_await latch;
+
+    if constexpr (!std::is_void_v<Value>)
+    {
+        std::vector<Value> values;
+        values.reserve(results.size());
+        for (auto& result : results)
+        {
+            values.emplace_back(std::move(*result));
+        }
+        co_return values;
+    }
+}
+
+// Variadic form, void tasks yield std::monostate in the result tuple
+template <class... Tasks>
+requires(sizeof...(Tasks) > 0) && (requires { typename Tasks::ReturnType; } && ...)
+Task<std::tuple<detail::WhenAllValue<Tasks>...>> whenAll(Tasks... tasks)
+{
+    detail::WhenAllLatch latch(sizeof...(Tasks));
+    std::tuple<std::optional<detail::WhenAllValue<Tasks>>...> results;
+    [&]<size_t... indexes>(std::index_sequence<indexes...>)
+    {
+        (detail::runWhenAllChild(latch, std::get<indexes>(results), std::move(tasks)).run(), ...);
+    }
+    (std::index_sequence_for<Tasks...>{});
+    co_await latch;
+
+    co_return std::apply(
+        [](auto&... result) { return std::tuple<detail::WhenAllValue<Tasks>...>(
+                                  std::move(*result)...); },
+        results);
+}
+
+}  // namespace bcos::task
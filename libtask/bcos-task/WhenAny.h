@@ -0,0 +1,119 @@
+#pragma once
+#include "Coroutine.h"
+#include "Task.h"
+#include <boost/throw_exception.hpp>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace bcos::task
+{
+namespace detail
+{
+// Shared with the children because the losers keep running after the caller is resumed
+template <class Value>
+struct WhenAnyState
+{
+    // Resume the caller once both the winner has arrived and the caller has suspended
+    std::atomic_int m_arrivals{2};
+    std::atomic_flag m_decided = ATOMIC_FLAG_INIT;
+    CO_STD::coroutine_handle<> m_continuation;
+
+    size_t m_index = 0;
+    std::optional<std::conditional_t<std::is_void_v<Value>, std::monostate, Value>> m_value;
+    std::exception_ptr m_error;
+
+    void arrive() noexcept
+    {
+        if (m_arrivals.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_continuation.resume();
+        }
+    }
+};
+
+template <class Value>
+Task<void> runWhenAnyChild(std::shared_ptr<WhenAnyState<Value>> state, size_t index, Task<Value> task)
+{
+    std::optional<std::conditional_t<std::is_void_v<Value>, std::monostate, Value>> value;
+    std::exception_ptr error;
+    try
+    {
+        if constexpr (std::is_void_v<Value>)
+        {
+            co_await task;
+            value.emplace();
+        }
+        else
+        {
+            value.emplace(co_await task);
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    if (!state->m_decided.test_and_set())
+    {
+        state->m_index = index;
+        state->m_value = std::move(value);
+        state->m_error = std::move(error);
+        state->arrive();
+    }
+}
+
+template <class Value>
+struct WhenAnyAwaitable
+{
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(CO_STD::coroutine_handle<> handle) noexcept
+    {
+        m_state->m_continuation = handle;
+        return m_state->m_arrivals.fetch_sub(1, std::memory_order_acq_rel) > 1;
+    }
+    void await_resume() const {}
+
+    WhenAnyState<Value>* m_state;
+};
+}  // namespace detail
+
+// Resume with the index (and value) of the first task to finish, successfully or not
+// The remaining tasks are not stopped, pass them a CancellationToken and cancel it after
+// whenAny returns if they should give up early.
+template <class Value>
+Task<std::conditional_t<std::is_void_v<Value>, size_t, std::tuple<size_t, Value>>> whenAny(
+    std::vector<Task<Value>> tasks)
+{
+    if (tasks.empty())
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument{"whenAny requires at least one task"});
+    }
+
+    auto state = std::make_shared<detail::WhenAnyState<Value>>();
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        detail::runWhenAnyChild(state, i, std::move(tasks[i])).run();
+    }
+    co_await detail::WhenAnyAwaitable<Value>{state.get()};
+
+    if (state->m_error)
+    {
+        std::rethrow_exception(state->m_error);
+    }
+    if constexpr (std::is_void_v<Value>)
+    {
+        co_return state->m_index;
+    }
+    else
+    {
+        co_return std::tuple<size_t, Value>{state->m_index, std::move(*state->m_value)};
+    }
+}
+
+}  // namespace bcos::task
@@ -0,0 +1,264 @@
+#pragma once
+#include "Cancel.h"
+#include "Coroutine.h"
+#include "Task.h"
+#include "Wait.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bcos::task
+{
+
+// Work-stealing runtime for coroutines
+// Every worker owns a deque: coroutines scheduled from a worker are pushed to and popped from the
+// back of its own deque (LIFO, cache friendly), idle workers steal from the front of the others.
+// Coroutines scheduled from outside the pool go to a shared injection queue that workers poll
+// periodically so that local work can not starve it.
+class WorkStealingPool
+{
+public:
+    constexpr static size_t GLOBAL_POLL_INTERVAL = 61;
+
+    explicit WorkStealingPool(size_t threadCount = std::thread::hardware_concurrency())
+      : m_workers(std::max<size_t>(threadCount, 1))
+    {
+        m_threads.reserve(m_workers.size());
+        for (size_t i = 0; i < m_workers.size(); ++i)
+        {
+            m_threads.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool(WorkStealingPool&&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+    ~WorkStealingPool() { stop(); }
+
+    // Workers drain every scheduled coroutine before exit
+    void stop()
+    {
+        {
+            std::unique_lock lock(m_sleepMutex);
+            if (m_stopped)
+            {
+                return;
+            }
+            m_stopped = true;
+        }
+        m_sleepCondition.notify_all();
+        for (auto& thread : m_threads)
+        {
+            if (!thread.joinable())
+            {
+                continue;
+            }
+            if (thread.get_id() == std::this_thread::get_id())
+            {
+                thread.detach();
+            }
+            else
+            {
+                thread.join();
+            }
+        }
+    }
+
+    void schedule(CO_STD::coroutine_handle<> handle)
+    {
+        m_pending.fetch_add(1);
+        if (t_currentPool == this)
+        {
+            auto& worker = m_workers[t_currentWorker];
+            std::unique_lock lock(worker.mutex);
+            worker.queue.push_back(handle);
+        }
+        else
+        {
+            std::unique_lock lock(m_globalMutex);
+            m_globalQueue.push_back(handle);
+        }
+
+        if (m_sleeping.load() > 0)
+        {
+            std::unique_lock lock(m_sleepMutex);
+            m_sleepCondition.notify_one();
+        }
+    }
+
+    // Start a task on the pool without waiting for it, exceptions are dropped
+    template <class Task>
+    void spawn(Task task)
+    {
+        wait(runOn(*this, std::move(task)));
+    }
+
+    // Start a task on the pool, callback receives the result or the exception_ptr (see wait())
+    template <class Task, class Callback>
+    void spawn(Task task, Callback callback)
+    {
+        wait(runOn(*this, std::move(task)), std::move(callback));
+    }
+
+    size_t threadCount() const noexcept { return m_workers.size(); }
+    bool inPool() const noexcept { return t_currentPool == this; }
+
+private:
+    template <class Task>
+    static task::Task<typename Task::ReturnType> runOn(WorkStealingPool& pool, Task task);
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<CO_STD::coroutine_handle<>> queue;
+    };
+
+    CO_STD::coroutine_handle<> popLocal(size_t index)
+    {
+        auto& worker = m_workers[index];
+        std::unique_lock lock(worker.mutex);
+        if (worker.queue.empty())
+        {
+            return nullptr;
+        }
+        auto handle = worker.queue.back();
+        worker.queue.pop_back();
+        return handle;
+    }
+
+    CO_STD::coroutine_handle<> popGlobal()
+    {
+        std::unique_lock lock(m_globalMutex);
+        if (m_globalQueue.empty())
+        {
+            return nullptr;
+        }
+        auto handle = m_globalQueue.front();
+        m_globalQueue.pop_front();
+        return handle;
+    }
+
+    CO_STD::coroutine_handle<> steal(size_t index)
+    {
+        for (size_t offset = 1; offset < m_workers.size(); ++offset)
+        {
+            auto& victim = m_workers[(index + offset) % m_workers.size()];
+            std::unique_lock lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || victim.queue.empty())
+            {
+                continue;
+            }
+            auto handle = victim.queue.front();
+            victim.queue.pop_front();
+            return handle;
+        }
+        return nullptr;
+    }
+
+    CO_STD::coroutine_handle<> next(size_t index, size_t tick)
+    {
+        CO_STD::coroutine_handle<> handle;
+        if (tick % GLOBAL_POLL_INTERVAL == 0)
+        {
+            handle = popGlobal();
+        }
+        if (!handle)
+        {
+            handle = popLocal(index);
+        }
+        if (!handle)
+        {
+            handle = popGlobal();
+        }
+        if (!handle)
+        {
+            handle = steal(index);
+        }
+        return handle;
+    }
+
+    void workerLoop(size_t index)
+    {
+        t_currentPool = this;
+        t_currentWorker = index;
+
+        for (size_t tick = 1;; ++tick)
+        {
+            if (auto handle = next(index, tick))
+            {
+                m_pending.fetch_sub(1);
+                handle.resume();
+                continue;
+            }
+
+            std::unique_lock lock(m_sleepMutex);
+            m_sleeping.fetch_add(1);
+            m_sleepCondition.wait(lock, [this]() { return m_stopped || m_pending.load() > 0; });
+            m_sleeping.fetch_sub(1);
+            if (m_stopped && m_pending.load() == 0)
+            {
+                break;
+            }
+        }
+
+        t_currentPool = nullptr;
+    }
+
+    std::vector<Worker> m_workers;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_globalMutex;
+    std::deque<CO_STD::coroutine_handle<>> m_globalQueue;
+
+    std::atomic_size_t m_pending{0};
+    std::atomic_size_t m_sleeping{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    bool m_stopped = false;
+
+    inline static thread_local WorkStealingPool* t_currentPool = nullptr;
+    inline static thread_local size_t t_currentWorker = 0;
+};
+
+// co_await scheduleOn(pool) resumes the awaiting coroutine on one of the pool's workers
+inline auto scheduleOn(WorkStealingPool& pool)
+{
+    struct Awaitable
+    {
+        constexpr bool await_ready() const noexcept { return false; }
+        void await_suspend(CO_STD::coroutine_handle<> handle) { m_pool.schedule(handle); }
+        constexpr void await_resume() const noexcept {}
+
+        WorkStealingPool& m_pool;
+    };
+    return Awaitable{pool};
+}
+
+// Same as scheduleOn(pool) and also a cancellation point: throws TaskCancelled if the token was
+// cancelled before or while the coroutine was queued
+inline auto scheduleOn(WorkStealingPool& pool, CancellationToken token)
+{
+    struct Awaitable
+    {
+        bool await_ready() const noexcept { return m_token.cancelled(); }
+        void await_suspend(CO_STD::coroutine_handle<> handle) { m_pool.schedule(handle); }
+        void await_resume() const { m_token.throwIfCancelled(); }
+
+        WorkStealingPool& m_pool;
+        CancellationToken m_token;
+    };
+    return Awaitable{pool, std::move(token)};
+}
+
+template <class Task>
+task::Task<typename Task::ReturnType> WorkStealingPool::runOn(WorkStealingPool& pool, Task task)
+{
+    co_await scheduleOn(pool);
+    co_return co_await task;
+}
+
+}  // namespace bcos::task
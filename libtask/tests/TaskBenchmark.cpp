@@ -0,0 +1,91 @@
+#include <bcos-task/Task.h>
+#include <bcos-task/Wait.h>
+#include <bcos-task/WhenAll.h>
+#include <bcos-task/WorkStealingPool.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace bcos::task;
+
+template <class Func>
+void measure(const std::string& name, size_t count, Func&& func)
+{
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    func();
+    auto duration = std::chrono::high_resolution_clock::now() - timePoint;
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+    std::cout << name << ": " << count << " in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()
+              << "ms, " << (double)nanos / (double)count << "ns/op" << std::endl;
+}
+
+Task<int> leaf(int num)
+{
+    co_return num;
+}
+
+// Spawn: create, run and destroy a coroutine frame, no thread switch involved
+Task<long> spawnLoop(size_t count)
+{
+    long sum = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += co_await leaf((int)i);
+    }
+    co_return sum;
+}
+
+// Switch: hop onto the pool repeatedly, every hop goes through a worker queue
+Task<void> switchLoop(WorkStealingPool& pool, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        co_await scheduleOn(pool);
+    }
+}
+
+Task<int> fanOutChild(WorkStealingPool& pool, int num)
+{
+    co_await scheduleOn(pool);
+    co_return num;
+}
+
+// Fan-out: start many children in parallel and join them with whenAll
+Task<size_t> fanOut(WorkStealingPool& pool, size_t count)
+{
+    std::vector<Task<int>> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        tasks.emplace_back(fanOutChild(pool, (int)i));
+    }
+    auto results = co_await whenAll(std::move(tasks));
+    co_return results.size();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("Task benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("count,c", boost::program_options::value<size_t>()->default_value(1000000), "Operations per case")
+        ("threads,t", boost::program_options::value<size_t>()->default_value(std::thread::hardware_concurrency()), "Pool threads")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    auto count = vm["count"].as<size_t>();
+    auto threads = vm["threads"].as<size_t>();
+    WorkStealingPool pool(threads);
+
+    measure("spawn", count, [&]() { syncWait(spawnLoop(count)); });
+    measure("switch", count, [&]() { syncWait(switchLoop(pool, count)); });
+    measure("fan-out", count, [&]() { syncWait(fanOut(pool, count)); });
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <bcos-task/Cancel.h>
+#include <bcos-task/FrameAllocator.h>
+#include <bcos-task/Task.h>
+#include <bcos-task/Wait.h>
+#include <bcos-task/WhenAll.h>
+#include <bcos-task/WhenAny.h>
+#include <bcos-task/WorkStealingPool.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace bcos::task;
+
+struct WorkStealingPoolFixture
+{
+    WorkStealingPool pool{4};
+};
+
+BOOST_FIXTURE_TEST_SUITE(WorkStealingPoolTest, WorkStealingPoolFixture)
+
+Task<std::thread::id> threadOf(WorkStealingPool& pool)
+{
+    co_await scheduleOn(pool);
+    co_return std::this_thread::get_id();
+}
+
+BOOST_AUTO_TEST_CASE(scheduleOnPool)
+{
+    auto id = syncWait(threadOf(pool));
+    BOOST_CHECK_NE(id, std::this_thread::get_id());
+}
+
+Task<int> square(WorkStealingPool& pool, int num)
+{
+    co_await scheduleOn(pool);
+    co_return num * num;
+}
+
+Task<void> throwing(WorkStealingPool& pool)
+{
+    co_await scheduleOn(pool);
+    BOOST_THROW_EXCEPTION(std::runtime_error("expected"));
+}
+
+BOOST_AUTO_TEST_CASE(whenAllRange)
+{
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 1000; ++i)
+    {
+        tasks.emplace_back(square(pool, i));
+    }
+    auto results = syncWait(whenAll(std::move(tasks)));
+    BOOST_REQUIRE_EQUAL(results.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        BOOST_CHECK_EQUAL(results[i], i * i);
+    }
+
+    std::vector<Task<void>> failed;
+    failed.emplace_back(throwing(pool));
+    BOOST_CHECK_THROW(syncWait(whenAll(std::move(failed))), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(whenAllVariadic)
+{
+    auto [a, b, c] = syncWait(whenAll(square(pool, 2), square(pool, 3), threadOf(pool)));
+    BOOST_CHECK_EQUAL(a, 4);
+    BOOST_CHECK_EQUAL(b, 9);
+    BOOST_CHECK_NE(c, std::this_thread::get_id());
+}
+
+Task<int> sleepThen(WorkStealingPool& pool, int num, std::chrono::milliseconds duration)
+{
+    co_await scheduleOn(pool);
+    std::this_thread::sleep_for(duration);
+    co_return num;
+}
+
+BOOST_AUTO_TEST_CASE(whenAnyRange)
+{
+    std::vector<Task<int>> tasks;
+    tasks.emplace_back(sleepThen(pool, 1, std::chrono::milliseconds(500)));
+    tasks.emplace_back(sleepThen(pool, 2, std::chrono::milliseconds(0)));
+    auto [index, value] = syncWait(whenAny(std::move(tasks)));
+    BOOST_CHECK_EQUAL(index, 1);
+    BOOST_CHECK_EQUAL(value, 2);
+}
+
+Task<void> cancellable(WorkStealingPool& pool, CancellationToken token, std::atomic_int& steps)
+{
+    while (true)
+    {
+        co_await scheduleOn(pool, token);
+        ++steps;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cancel)
+{
+    CancellationSource source;
+    std::atomic_int steps = 0;
+    std::atomic_bool cancelled = false;
+    pool.spawn(cancellable(pool, source.token(), steps),
+        [&cancelled](std::exception_ptr error = nullptr) {
+            try
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+            catch (TaskCancelled&)
+            {
+                cancelled = true;
+            }
+        });
+    while (steps < 10)
+    {
+        std::this_thread::yield();
+    }
+    source.cancel();
+    while (!cancelled)
+    {
+        std::this_thread::yield();
+    }
+    BOOST_CHECK(cancelled);
+}
+
+Task<int> noop()
+{
+    co_return 1;
+}
+
+BOOST_AUTO_TEST_CASE(recycleFrames)
+{
+    BOOST_CHECK_EQUAL(syncWait(noop()), 1);
+    auto cached = FrameAllocator::cachedFrames();
+    BOOST_CHECK_GT(cached, 0);
+
+    // Reusing the cached frames must not grow the cache
+    for (int i = 0; i < 100; ++i)
+    {
+        BOOST_CHECK_EQUAL(syncWait(noop()), 1);
+    }
+    BOOST_CHECK_EQUAL(FrameAllocator::cachedFrames(), cached);
+}
+
+BOOST_AUTO_TEST_CASE(spreadAcrossWorkers)
+{
+    std::vector<Task<std::thread::id>> tasks;
+    for (int i = 0; i < 200; ++i)
+    {
+        tasks.emplace_back([](WorkStealingPool& pool) -> Task<std::thread::id> {
+            co_await scheduleOn(pool);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            co_return std::this_thread::get_id();
+        }(pool));
+    }
+    auto ids = syncWait(whenAll(std::move(tasks)));
+    std::set<std::thread::id> distinct(ids.begin(), ids.end());
+    BOOST_CHECK_GT(distinct.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,7 @@
 #include <bcos-tars-protocol/impl/TarsHashable.h>
 
 #include "../Log.h"
+#include "../state/StateReader.h"
 #include "Converter.h"
 #include "bcos-concepts/Basic.h"
 #include "bcos-concepts/ByteBuffer.h"
@@ -16,12 +17,14 @@
 #include <bcos-concepts/transaction-pool/TransactionPool.h>
 #include <bcos-crypto/hasher/Hasher.h>
 #include <bcos-crypto/merkle/Merkle.h>
+#include <bcos-framework/ledger/LedgerTypeDef.h>
 #include <bcos-rpc/jsonrpc/JsonRpcInterface.h>
 #include <bcos-tars-protocol/tars/Block.h>
 #include <bcos-tars-protocol/tars/Transaction.h>
 #include <bcos-task/Wait.h>
 #include <json/value.h>
 #include <boost/algorithm/hex.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
 #include <exception>
@@ -46,14 +49,21 @@ class LightNodeRPC : public bcos::rpc::JsonRpcInterface
 public:
     LightNodeRPC(LocalLedgerType localLedger, RemoteLedgerType remoteLedger,
         TransactionPoolType remoteTransactionPool, SchedulerType scheduler, std::string chainID,
-        std::string groupID)
+        std::string groupID, bcos::crypto::SignatureCrypto::Ptr signatureImpl = nullptr)
       : m_localLedger(std::move(localLedger)),
         m_remoteLedger(std::move(remoteLedger)),
         m_remoteTransactionPool(std::move(remoteTransactionPool)),
         m_scheduler(std::move(scheduler)),
         m_chainID(std::move(chainID)),
         m_groupID(std::move(groupID))
-    {}
+    {
+        // the state is read with proofs only when the signatures can be verified
+        if (signatureImpl)
+        {
+            m_stateReader = std::make_unique<StateReaderType>(
+                m_localLedger, m_remoteLedger, std::move(signatureImpl));
+        }
+    }
 
     void toErrorResp(std::exception_ptr error, RespFunc respFunc)
     {
@@ -388,11 +398,32 @@ public:
             });
     }
 
-    void getCode(std::string_view _groupID, std::string_view _nodeName,
-        std::string_view _contractAddress, RespFunc _respFunc) override
+    void getCode([[maybe_unused]] std::string_view _groupID,
+        [[maybe_unused]] std::string_view _nodeName, std::string_view _contractAddress,
+        RespFunc _respFunc) override
     {
-        Json::Value value;
-        _respFunc(BCOS_ERROR_PTR(-1, "Unspported method!"), value);
+        if (!m_stateReader)
+        {
+            Json::Value value;
+            _respFunc(BCOS_ERROR_PTR(-1, "Unspported method!"), value);
+            return;
+        }
+
+        bcos::task::wait([](decltype(this) self, std::string contractAddress,
+                             RespFunc respFunc) -> task::Task<void> {
+            try
+            {
+                LIGHTNODE_LOG(INFO) << "RPC get code request: " << contractAddress;
+
+                auto code = co_await self->getCodeFromState(contractAddress);
+                Json::Value resp = code.empty() ? std::string() : bcos::toHexStringWithPrefix(code);
+                respFunc(nullptr, resp);
+            }
+            catch (std::exception& error)
+            {
+                self->toErrorResp(error, std::move(respFunc));
+            }
+        }(this, std::string(_contractAddress), std::move(_respFunc)));
     }
 
     void getABI([[maybe_unused]]std::string_view _groupID, [[maybe_unused]]std::string_view _nodeName,
@@ -532,6 +563,45 @@ private:
     auto& remoteTransactionPool() { return bcos::concepts::getRef(m_remoteTransactionPool); }
     auto& scheduler() { return bcos::concepts::getRef(m_scheduler); }
 
+    // the same lookup as the executor: the code binary table by the code hash, then the contract
+    // table, both keys of the contract table are read in one request
+    task::Task<bcos::bytes> getCodeFromState(std::string contractAddress)
+    {
+        std::string_view address = contractAddress;
+        if (address.starts_with("0x") || address.starts_with("0X"))
+        {
+            address.remove_prefix(2);
+        }
+        std::string contractTableName = "/apps/";
+        if (address.starts_with('/'))
+        {
+            address.remove_prefix(1);
+        }
+        contractTableName.append(address);
+        boost::algorithm::to_lower(contractTableName);
+
+        std::vector<bcostars::StateKey> keys(2);
+        keys[0].table = contractTableName;
+        keys[0].key = "codeHash";
+        keys[1].table = contractTableName;
+        keys[1].key = "code";
+        auto values = co_await m_stateReader->getStates(keys);
+
+        if (values[0] && !values[0]->empty())
+        {
+            std::vector<bcostars::StateKey> binaryKeys(1);
+            binaryKeys[0].table = std::string(bcos::ledger::SYS_CODE_BINARY);
+            binaryKeys[0].key.assign(values[0]->begin(), values[0]->end());
+            auto binaryValues = co_await m_stateReader->getStates(binaryKeys);
+            if (binaryValues[0])
+            {
+                co_return std::move(*binaryValues[0]);
+            }
+        }
+
+        co_return values[1] ? std::move(*values[1]) : bcos::bytes();
+    }
+
     void decodeData(bcos::concepts::bytebuffer::ByteBuffer auto const& input,
         bcos::concepts::bytebuffer::ByteBuffer auto& out)
     {
@@ -561,5 +631,9 @@ private:
 
     std::string m_chainID;
     std::string m_groupID;
+
+    using StateReaderType =
+        bcos::lightnode::StateReader<LocalLedgerType, RemoteLedgerType, Hasher>;
+    std::unique_ptr<StateReaderType> m_stateReader;
 };
 }  // namespace bcos::rpc
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <bcos-crypto/hasher/Hasher.h>
+#include <bcos-crypto/merkle/Merkle.h>
+#include <bcos-utilities/FixedBytes.h>
+#include <bcos-utilities/Ranges.h>
+#include <boost/endian/conversion.hpp>
+#include <boost/throw_exception.hpp>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace bcos::lightnode
+{
+
+// The state root in the block header is the xor of the entries written by the block, which can't
+// prove a single entry. A state proof is the merkle root of the read set, bound to the block the
+// values were read at and signed by a consensus node of that block.
+
+template <bcos::crypto::hasher::Hasher Hasher>
+std::array<std::byte, Hasher::HASH_SIZE> calculateStateLeaf(auto const& value)
+{
+    Hasher hasher;
+    // length prefixed, table "ab" key "c" and table "a" key "bc" are different leaves
+    hasher.update(boost::endian::native_to_big((uint32_t)RANGES::size(value.table)));
+    hasher.update(value.table);
+    hasher.update(boost::endian::native_to_big((uint32_t)RANGES::size(value.key)));
+    hasher.update(value.key);
+    uint8_t exists = value.exists ? 1 : 0;
+    hasher.update(exists);
+    if (value.exists)
+    {
+        hasher.update(value.value);
+    }
+
+    std::array<std::byte, Hasher::HASH_SIZE> leaf;
+    hasher.final(leaf);
+    return leaf;
+}
+
+template <bcos::crypto::hasher::Hasher Hasher>
+std::array<std::byte, Hasher::HASH_SIZE> calculateStateRoot(RANGES::range auto const& values)
+{
+    if (RANGES::empty(values)) [[unlikely]]
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument{"Empty state values!"});
+    }
+
+    std::vector<std::array<std::byte, Hasher::HASH_SIZE>> leaves;
+    leaves.reserve(RANGES::size(values));
+    for (auto const& value : values)
+    {
+        leaves.emplace_back(calculateStateLeaf<Hasher>(value));
+    }
+
+    bcos::crypto::merkle::Merkle<Hasher> merkle;
+    std::vector<std::array<std::byte, Hasher::HASH_SIZE>> merkles;
+    merkle.generateMerkle(leaves, merkles);
+    return *RANGES::rbegin(merkles);
+}
+
+// The hash signed by the full node
+template <bcos::crypto::hasher::Hasher Hasher>
+bcos::h256 calculateStateProofHash(
+    int64_t blockNumber, auto const& blockHash, auto const& stateRoot)
+{
+    Hasher hasher;
+    hasher.update(boost::endian::native_to_big(blockNumber));
+    hasher.update(blockHash);
+    hasher.update(stateRoot);
+
+    std::array<std::byte, Hasher::HASH_SIZE> hash;
+    hasher.final(hash);
+    return bcos::h256((const bcos::byte*)hash.data(), hash.size());
+}
+
+}  // namespace bcos::lightnode
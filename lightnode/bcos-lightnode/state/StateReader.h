@@ -0,0 +1,295 @@
+#pragma once
+
+#include <bcos-tars-protocol/impl/TarsHashable.h>
+
+#include "../Log.h"
+#include "StateProof.h"
+#include <bcos-concepts/Basic.h>
+#include <bcos-concepts/ByteBuffer.h>
+#include <bcos-concepts/Exception.h>
+#include <bcos-concepts/Hash.h>
+#include <bcos-concepts/ledger/Ledger.h>
+#include <bcos-crypto/hasher/Hasher.h>
+#include <bcos-crypto/interfaces/crypto/Signature.h>
+#include <bcos-tars-protocol/tars/Block.h>
+#include <bcos-tars-protocol/tars/LightNode.h>
+#include <bcos-task/Task.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::lightnode
+{
+// clang-format off
+struct InvalidStateProof: public bcos::error::Exception {};
+struct StateProofNotSynced: public bcos::error::Exception {};
+// clang-format on
+
+// Reads the state from the sealers, verifies the proofs against the local block headers and
+// caches the values of the latest local block. A value is trusted only when enough sealers sign
+// the same state, f + 1 of them by default so that at least one of them is honest
+template <bcos::concepts::ledger::Ledger LocalLedgerType,
+    bcos::concepts::ledger::Ledger RemoteLedgerType, bcos::crypto::hasher::Hasher Hasher>
+class StateReader
+{
+public:
+    constexpr static size_t DEFAULT_CACHE_CAPACITY = 10000;
+
+    StateReader(LocalLedgerType localLedger, RemoteLedgerType remoteLedger,
+        bcos::crypto::SignatureCrypto::Ptr signatureImpl,
+        size_t cacheCapacity = DEFAULT_CACHE_CAPACITY, size_t requiredSealers = 0)
+      : m_localLedger(std::move(localLedger)),
+        m_remoteLedger(std::move(remoteLedger)),
+        m_signatureImpl(std::move(signatureImpl)),
+        m_cacheCapacity(cacheCapacity),
+        m_requiredSealers(requiredSealers),
+        m_rng(std::random_device{}())
+    {}
+
+    // all the keys missing in the cache are read by one request, nullopt for the keys not found
+    task::Task<std::vector<std::optional<bcos::bytes>>> getStates(
+        std::vector<bcostars::StateKey> const& keys)
+    {
+        auto status = co_await localLedger().getStatus();
+
+        std::vector<std::optional<bcos::bytes>> values(keys.size());
+        std::vector<bcostars::StateKey> missingKeys;
+        std::vector<size_t> missingIndexes;
+        {
+            std::unique_lock lock(x_cache);
+            if (m_blockNumber != status.blockNumber)
+            {
+                m_cache.clear();
+                m_blockNumber = status.blockNumber;
+            }
+
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                auto it = m_cache.find(cacheKey(keys[i]));
+                if (it != m_cache.end())
+                {
+                    values[i] = it->second;
+                    continue;
+                }
+                missingKeys.emplace_back(keys[i]);
+                missingIndexes.emplace_back(i);
+            }
+        }
+        if (missingKeys.empty())
+        {
+            co_return values;
+        }
+
+        auto proof = co_await getAgreedStateProof(missingKeys, status.blockNumber);
+
+        LIGHTNODE_LOG(DEBUG) << "Verified state proof" << LOG_KV("keys", keys.size())
+                             << LOG_KV("missing", missingKeys.size())
+                             << LOG_KV("number", proof.blockNumber);
+
+        std::unique_lock lock(x_cache);
+        // the values of an older block are returned but not cached
+        auto cacheable = (proof.blockNumber == m_blockNumber);
+        if (cacheable && m_cache.size() + missingKeys.size() > m_cacheCapacity)
+        {
+            m_cache.clear();
+        }
+        for (size_t i = 0; i < missingKeys.size(); ++i)
+        {
+            auto& value = proof.values[i];
+            std::optional<bcos::bytes> result;
+            if (value.exists)
+            {
+                result.emplace(value.value.begin(), value.value.end());
+            }
+            if (cacheable)
+            {
+                m_cache.insert_or_assign(cacheKey(missingKeys[i]), result);
+            }
+            values[missingIndexes[i]] = std::move(result);
+        }
+
+        co_return values;
+    }
+
+    size_t cacheSize() const
+    {
+        std::unique_lock lock(x_cache);
+        return m_cache.size();
+    }
+
+private:
+    auto& localLedger() { return bcos::concepts::getRef(m_localLedger); }
+    auto& remoteLedger() { return bcos::concepts::getRef(m_remoteLedger); }
+
+    // the table name has no '\0', unique for all the keys
+    static std::string cacheKey(bcostars::StateKey const& key)
+    {
+        std::string out;
+        out.reserve(key.table.size() + key.key.size() + 1);
+        out.append(key.table).append(1, '\0').append(key.key);
+        return out;
+    }
+
+    // the number of sealers that must sign the same state, 0 for f + 1
+    size_t requiredSealers(size_t sealers) const
+    {
+        auto required = m_requiredSealers > 0 ? m_requiredSealers : (sealers - 1) / 3 + 1;
+        return std::min(required, sealers);
+    }
+
+    // asks the sealers of the latest local block in random order until enough of them sign the
+    // same state, the unreachable sealers and the invalid proofs are skipped
+    task::Task<bcostars::ResponseGetStateProof> getAgreedStateProof(
+        std::vector<bcostars::StateKey> const& keys, int64_t localBlockNumber)
+    {
+        bcostars::Block block;
+        co_await localLedger().template getBlock<bcos::concepts::ledger::HEADER>(
+            localBlockNumber, block);
+        auto sealerList = std::move(block.blockHeader.data.sealerList);
+        if (sealerList.empty())
+        {
+            BOOST_THROW_EXCEPTION(InvalidStateProof{} << bcos::error::ErrorMessage{
+                                      "No sealer in block " + std::to_string(localBlockNumber)});
+        }
+        {
+            std::unique_lock lock(x_rng);
+            std::shuffle(sealerList.begin(), sealerList.end(), m_rng);
+        }
+        auto required = requiredSealers(sealerList.size());
+
+        // the verified proofs grouped by the signed hash, with the number of the signers
+        std::map<bcos::h256, std::pair<size_t, bcostars::ResponseGetStateProof>> agreedProofs;
+        std::exception_ptr notSynced;
+        for (auto const& sealer : sealerList)
+        {
+            bcostars::ResponseGetStateProof proof;
+            bcos::h256 hash;
+            try
+            {
+                co_await remoteLedger().getStateProof(keys, proof, sealer);
+                if (proof.nodeID != sealer)
+                {
+                    BOOST_THROW_EXCEPTION(InvalidStateProof{} << bcos::error::ErrorMessage{
+                                              "State proof not by the requested sealer!"});
+                }
+                hash = co_await verifyStateProof(keys, proof, localBlockNumber);
+            }
+            catch (StateProofNotSynced const&)
+            {
+                notSynced = std::current_exception();
+                continue;
+            }
+            catch (std::exception const& e)
+            {
+                LIGHTNODE_LOG(WARNING) << "Get state proof from sealer failed"
+                                       << LOG_KV("sealer", bcos::toHex(sealer))
+                                       << LOG_KV("message", boost::diagnostic_information(e));
+                continue;
+            }
+
+            auto& [signers, agreedProof] = agreedProofs[hash];
+            if (signers++ == 0)
+            {
+                agreedProof = std::move(proof);
+            }
+            if (signers >= required)
+            {
+                co_return std::move(agreedProof);
+            }
+        }
+
+        // retry after the headers are synced if some sealers are ahead
+        if (notSynced)
+        {
+            std::rethrow_exception(notSynced);
+        }
+        BOOST_THROW_EXCEPTION(InvalidStateProof{} << bcos::error::ErrorMessage{
+                                  "Not enough sealers agree on the state, required: " +
+                                  std::to_string(required)});
+    }
+
+    // returns the hash signed by the sealer
+    task::Task<bcos::h256> verifyStateProof(std::vector<bcostars::StateKey> const& keys,
+        bcostars::ResponseGetStateProof const& proof, int64_t localBlockNumber)
+    {
+        if (proof.values.size() != keys.size() ||
+            !std::equal(keys.begin(), keys.end(), proof.values.begin(),
+                [](bcostars::StateKey const& key, bcostars::StateValue const& value) {
+                    return key.table == value.table && key.key == value.key;
+                }))
+        {
+            BOOST_THROW_EXCEPTION(
+                InvalidStateProof{} << bcos::error::ErrorMessage{"No match state keys!"});
+        }
+
+        // the full node may be a little ahead, retry after the headers are synced
+        if (proof.blockNumber > localBlockNumber)
+        {
+            BOOST_THROW_EXCEPTION(StateProofNotSynced{} << bcos::error::ErrorMessage{
+                                      "State proof of block " + std::to_string(proof.blockNumber) +
+                                      " is ahead of the local block " +
+                                      std::to_string(localBlockNumber)});
+        }
+
+        bcostars::Block block;
+        co_await localLedger().template getBlock<bcos::concepts::ledger::HEADER>(
+            proof.blockNumber, block);
+        std::array<std::byte, Hasher::HASH_SIZE> blockHash;
+        bcos::concepts::hash::calculate<Hasher>(block, blockHash);
+        if (!bcos::concepts::bytebuffer::equalTo(proof.blockHash, blockHash))
+        {
+            BOOST_THROW_EXCEPTION(
+                InvalidStateProof{} << bcos::error::ErrorMessage{"No match block hash!"});
+        }
+
+        auto const& sealerList = block.blockHeader.data.sealerList;
+        if (std::find(sealerList.begin(), sealerList.end(), proof.nodeID) == sealerList.end())
+        {
+            BOOST_THROW_EXCEPTION(
+                InvalidStateProof{} << bcos::error::ErrorMessage{"State proof not by a sealer!"});
+        }
+
+        auto stateRoot = calculateStateRoot<Hasher>(proof.values);
+        auto hash = calculateStateProofHash<Hasher>(proof.blockNumber, blockHash, stateRoot);
+        bool verified = false;
+        try
+        {
+            verified = m_signatureImpl->verify(
+                std::make_shared<bcos::bytes const>(proof.nodeID.begin(), proof.nodeID.end()), hash,
+                bcos::bytesConstRef(
+                    (const bcos::byte*)proof.signature.data(), proof.signature.size()));
+        }
+        catch (std::exception& e)
+        {
+            LIGHTNODE_LOG(WARNING) << "Verify state proof signature error"
+                                   << boost::diagnostic_information(e);
+        }
+        if (!verified)
+        {
+            BOOST_THROW_EXCEPTION(InvalidStateProof{}
+                                  << bcos::error::ErrorMessage{"Invalid state proof signature!"});
+        }
+        co_return hash;
+    }
+
+    LocalLedgerType m_localLedger;
+    RemoteLedgerType m_remoteLedger;
+    bcos::crypto::SignatureCrypto::Ptr m_signatureImpl;
+
+    size_t m_cacheCapacity;
+    size_t m_requiredSealers;
+    std::mutex x_rng;
+    std::mt19937 m_rng;
+    mutable std::mutex x_cache;
+    int64_t m_blockNumber = -1;
+    std::unordered_map<std::string, std::optional<bcos::bytes>> m_cache;
+};
+}  // namespace bcos::lightnode
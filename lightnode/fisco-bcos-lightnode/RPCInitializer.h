@@ -7,6 +7,7 @@
 #include <bcos-cpp-sdk/multigroup/JsonGroupInfoCodec.h>
 #include <bcos-cpp-sdk/ws/HandshakeResponse.h>
 #include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-crypto/interfaces/crypto/KeyFactory.h>
 #include <bcos-crypto/interfaces/crypto/KeyInterface.h>
 #include <bcos-framework/protocol/GlobalConfig.h>
@@ -34,7 +35,7 @@ namespace bcos::lightnode
 
 static auto initRPC(bcos::tool::NodeConfig::Ptr nodeConfig, std::string nodeID,
     bcos::gateway::Gateway::Ptr gateway, bcos::crypto::KeyFactory::Ptr keyFactory,
-    bcos::concepts::ledger::Ledger auto localLedger,
+    bcos::crypto::CryptoSuite::Ptr cryptoSuite, bcos::concepts::ledger::Ledger auto localLedger,
     bcos::concepts::ledger::Ledger auto remoteLedger,
     bcos::concepts::transacton_pool::TransactionPool auto transactionPool,
     bcos::concepts::scheduler::Scheduler auto scheduler)
@@ -42,10 +43,24 @@ static auto initRPC(bcos::tool::NodeConfig::Ptr nodeConfig, std::string nodeID,
     bcos::rpc::RpcFactory rpcFactory(nodeConfig->chainId(), gateway, keyFactory, nullptr);
     auto wsConfig = rpcFactory.initConfig(nodeConfig);
     auto wsService = rpcFactory.buildWsService(wsConfig);
-    auto jsonrpc = std::make_shared<bcos::rpc::LightNodeRPC<decltype(localLedger),
-        decltype(remoteLedger), decltype(transactionPool), decltype(scheduler),
-        bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher>>(localLedger, remoteLedger,
-        transactionPool, scheduler, nodeConfig->chainId(), nodeConfig->groupId());
+    // the hasher verifies the block hashes and the state proofs, the same as the chain
+    std::shared_ptr<bcos::rpc::JsonRpcInterface> jsonrpc;
+    if (nodeConfig->smCryptoType())
+    {
+        jsonrpc = std::make_shared<bcos::rpc::LightNodeRPC<decltype(localLedger),
+            decltype(remoteLedger), decltype(transactionPool), decltype(scheduler),
+            bcos::crypto::hasher::openssl::OpenSSL_SM3_Hasher>>(localLedger, remoteLedger,
+            transactionPool, scheduler, nodeConfig->chainId(), nodeConfig->groupId(),
+            cryptoSuite->signatureImpl());
+    }
+    else
+    {
+        jsonrpc = std::make_shared<bcos::rpc::LightNodeRPC<decltype(localLedger),
+            decltype(remoteLedger), decltype(transactionPool), decltype(scheduler),
+            bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher>>(localLedger, remoteLedger,
+            transactionPool, scheduler, nodeConfig->chainId(), nodeConfig->groupId(),
+            cryptoSuite->signatureImpl());
+    }
 
     wsService->registerMsgHandler(bcos::protocol::MessageType::HANDESHAKE,
         [nodeConfig, nodeID, localLedger](std::shared_ptr<bcos::boostssl::MessageFace> msg,
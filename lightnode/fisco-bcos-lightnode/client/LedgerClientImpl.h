@@ -30,6 +30,29 @@ public:
 private:
     auto& p2p() { return bcos::concepts::getRef(m_p2p); }
 
+    task::Task<void> getStateProofFrom(RANGES::range auto const& keys,
+        bcostars::ResponseGetStateProof& proof, crypto::NodeIDPtr nodeID)
+    {
+        bcostars::RequestGetStateProof request;
+        request.keys.reserve(RANGES::size(keys));
+        for (auto const& key : keys)
+        {
+            auto& stateKey = request.keys.emplace_back();
+            stateKey.table = key.table;
+            stateKey.key = key.key;
+        }
+
+        co_await p2p().sendMessageByNodeID(
+            protocol::LIGHTNODE_GET_STATE_PROOF, std::move(nodeID), request, proof);
+
+        if (proof.error.errorCode)
+        {
+            LIGHTNODE_LOG(WARNING) << "Get state proof failed, errorCode: "
+                                   << proof.error.errorCode << " " << proof.error.errorMessage;
+            BOOST_THROW_EXCEPTION(std::runtime_error(proof.error.errorMessage));
+        }
+    }
+
     template <bcos::concepts::ledger::DataFlag Flag>
     void processGetBlockFlags(bool& onlyHeaderFlag)
     {
@@ -122,6 +145,21 @@ private:
         co_return abiStr;
     }
 
+    task::Task<void> impl_getStateProof(
+        RANGES::range auto const& keys, bcostars::ResponseGetStateProof& proof)
+    {
+        auto nodeID = co_await p2p().randomSelectNode();
+        co_await getStateProofFrom(keys, proof, std::move(nodeID));
+    }
+
+    // only the proofs signed by the sealers can be verified, ask the given one
+    task::Task<void> impl_getStateProof(RANGES::range auto const& keys,
+        bcostars::ResponseGetStateProof& proof,
+        bcos::concepts::bytebuffer::ByteBuffer auto const& nodeID)
+    {
+        co_await getStateProofFrom(keys, proof, p2p().createNodeID(nodeID));
+    }
+
     task::Task<bcos::concepts::ledger::Status> impl_getStatus()
     {
         bcostars::RequestGetStatus request;
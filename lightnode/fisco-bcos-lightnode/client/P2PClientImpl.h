@@ -5,6 +5,7 @@
 #include "bcos-lightnode/Log.h"
 #include "bcos-utilities/BoostLog.h"
 #include <bcos-concepts/Basic.h>
+#include <bcos-concepts/ByteBuffer.h>
 #include <bcos-concepts/Serialize.h>
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-framework/gateway/GatewayInterface.h>
@@ -192,6 +193,12 @@ public:
         co_return nodeIDPtr;
     }
 
+    crypto::NodeIDPtr createNodeID(bcos::concepts::bytebuffer::ByteBuffer auto const& nodeID)
+    {
+        return m_keyFactory->createKey(bcos::bytesConstRef(
+            (const bcos::byte*)RANGES::data(nodeID), RANGES::size(nodeID)));
+    }
+
 private:
     bcos::front::FrontServiceInterface::Ptr m_front;
     bcos::gateway::GatewayInterface::Ptr m_gateway;
@@ -127,7 +127,7 @@ static auto startSyncerThread(bcos::concepts::ledger::Ledger auto fromLedger,
 
 
 void starLightnode(bcos::tool::NodeConfig::Ptr nodeConfig, auto ledger, auto front, auto gateway,
-    auto keyFactory, auto nodeID)
+    auto keyFactory, auto cryptoSuite, auto nodeID)
 {
     LIGHTNODE_LOG(INFO) << "Init lightnode p2p client...";
     auto p2pClient = std::make_shared<bcos::p2p::P2PClientImpl>(
@@ -154,8 +154,8 @@ void starLightnode(bcos::tool::NodeConfig::Ptr nodeConfig, auto ledger, auto fro
     ~ledger->setupGenesisBlock(std::move(genesisBlock));
 
     LIGHTNODE_LOG(INFO) << "Init lightnode rpc...";
-    auto wsService = bcos::lightnode::initRPC(
-        nodeConfig, nodeID, gateway, keyFactory, ledger, remoteLedger, transactionPool, scheduler);
+    auto wsService = bcos::lightnode::initRPC(nodeConfig, nodeID, gateway, keyFactory,
+        cryptoSuite, ledger, remoteLedger, transactionPool, scheduler);
     wsService->start();
 
     LIGHTNODE_LOG(INFO) << "Init lightnode block syner...";
@@ -225,7 +225,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] const char* argv[])
             std::move(storageWrapper), protocolInitializer.blockFactory(), storage);
 
         LIGHTNODE_LOG(INFO) << "start sm light node...";
-        starLightnode(nodeConfig, localLedger, front, gateway, keyFactory, nodeID);
+        starLightnode(nodeConfig, localLedger, front, gateway, keyFactory,
+            protocolInitializer.cryptoSuite(), nodeID);
     }
     else
     {
@@ -234,7 +235,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] const char* argv[])
             std::move(storageWrapper), protocolInitializer.blockFactory(), storage);
 
         LIGHTNODE_LOG(INFO) << "start light node...";
-        starLightnode(nodeConfig, localLedger, front, gateway, keyFactory, nodeID);
+        starLightnode(nodeConfig, localLedger, front, gateway, keyFactory,
+            protocolInitializer.cryptoSuite(), nodeID);
     }
 
     return 0;
@@ -0,0 +1,86 @@
+#include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-lightnode/state/StateProof.h>
+#include <bcos-tars-protocol/tars/LightNode.h>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+
+using Hasher = bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher;
+
+struct StateProofFixture
+{
+    StateProofFixture()
+    {
+        for (auto i = 0; i < 5; ++i)
+        {
+            auto& value = values.emplace_back();
+            value.table = "/apps/test";
+            value.key = "key" + std::to_string(i);
+            value.exists = (i != 3);
+            if (value.exists)
+            {
+                auto data = "value" + std::to_string(i);
+                value.value.assign(data.begin(), data.end());
+            }
+        }
+    }
+
+    std::vector<bcostars::StateValue> values;
+};
+
+BOOST_FIXTURE_TEST_SUITE(StateProofTest, StateProofFixture)
+
+BOOST_AUTO_TEST_CASE(stateRoot)
+{
+    auto root = bcos::lightnode::calculateStateRoot<Hasher>(values);
+    BOOST_CHECK(root == bcos::lightnode::calculateStateRoot<Hasher>(values));
+
+    // any changed value changes the root
+    auto changed = values;
+    changed[1].value.back() = 'x';
+    BOOST_CHECK(root != bcos::lightnode::calculateStateRoot<Hasher>(changed));
+
+    // a missing key is not an empty value
+    changed = values;
+    changed[3].exists = true;
+    BOOST_CHECK(root != bcos::lightnode::calculateStateRoot<Hasher>(changed));
+
+    // the boundary between the table and the key is a part of the leaf
+    changed = values;
+    changed[0].table = "/apps/testk";
+    changed[0].key = "ey0";
+    BOOST_CHECK(root != bcos::lightnode::calculateStateRoot<Hasher>(changed));
+
+    // the order of the keys is a part of the root
+    changed = values;
+    std::swap(changed[0], changed[1]);
+    BOOST_CHECK(root != bcos::lightnode::calculateStateRoot<Hasher>(changed));
+
+    // a single key is its own root
+    std::vector<bcostars::StateValue> single{values[0]};
+    BOOST_CHECK(bcos::lightnode::calculateStateRoot<Hasher>(single) ==
+                bcos::lightnode::calculateStateLeaf<Hasher>(values[0]));
+
+    std::vector<bcostars::StateValue> empty;
+    BOOST_CHECK_THROW(bcos::lightnode::calculateStateRoot<Hasher>(empty), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(stateProofHash)
+{
+    auto root = bcos::lightnode::calculateStateRoot<Hasher>(values);
+    std::vector<char> blockHash(Hasher::HASH_SIZE, 1);
+    auto hash = bcos::lightnode::calculateStateProofHash<Hasher>(100, blockHash, root);
+
+    // the same bytes in another container, as the light node checks it
+    std::array<std::byte, Hasher::HASH_SIZE> blockHashArray;
+    blockHashArray.fill(std::byte{1});
+    BOOST_CHECK_EQUAL(
+        hash, bcos::lightnode::calculateStateProofHash<Hasher>(100, blockHashArray, root));
+
+    // bound to the block
+    BOOST_CHECK_NE(hash, bcos::lightnode::calculateStateProofHash<Hasher>(101, blockHash, root));
+    blockHash[0] = 2;
+    BOOST_CHECK_NE(hash, bcos::lightnode::calculateStateProofHash<Hasher>(100, blockHash, root));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
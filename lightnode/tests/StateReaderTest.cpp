@@ -0,0 +1,233 @@
+#include <bcos-tars-protocol/impl/TarsHashable.h>
+
+#include <bcos-concepts/ledger/Ledger.h>
+#include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-lightnode/state/StateProof.h>
+#include <bcos-lightnode/state/StateReader.h>
+#include <bcos-tars-protocol/tars/Block.h>
+#include <bcos-tars-protocol/tars/LightNode.h>
+#include <bcos-task/Task.h>
+#include <bcos-task/Wait.h>
+#include <boost/test/unit_test.hpp>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Hasher = bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher;
+
+// the signature is the public key followed by the hash
+class FakeSignature : public bcos::crypto::SignatureCrypto
+{
+public:
+    static std::vector<char> sign(std::vector<char> const& nodeID, bcos::h256 const& hash)
+    {
+        auto signature = nodeID;
+        signature.insert(signature.end(), hash.begin(), hash.end());
+        return signature;
+    }
+
+    std::shared_ptr<bcos::bytes> sign(const bcos::crypto::KeyPairInterface&,
+        const bcos::crypto::HashType&, bool) const override
+    {
+        return nullptr;
+    }
+    bool verify(bcos::crypto::PublicPtr, const bcos::crypto::HashType&,
+        bcos::bytesConstRef) const override
+    {
+        return false;
+    }
+    bool verify(std::shared_ptr<const bcos::bytes> pubKeyBytes,
+        const bcos::crypto::HashType& hash, bcos::bytesConstRef signatureData) const override
+    {
+        auto expected = *pubKeyBytes;
+        expected.insert(expected.end(), hash.begin(), hash.end());
+        return signatureData.toBytes() == expected;
+    }
+    bcos::crypto::PublicPtr recover(
+        const bcos::crypto::HashType&, bcos::bytesConstRef) const override
+    {
+        return nullptr;
+    }
+    bcos::crypto::KeyPairInterface::UniquePtr generateKeyPair() const override
+    {
+        return nullptr;
+    }
+    std::pair<bool, bcos::bytes> recoverAddress(
+        bcos::crypto::Hash::Ptr, bcos::bytesConstRef) const override
+    {
+        return {};
+    }
+    bcos::crypto::KeyPairInterface::UniquePtr createKeyPair(
+        bcos::crypto::SecretPtr) const override
+    {
+        return nullptr;
+    }
+};
+
+class FakeLocalLedger : public bcos::concepts::ledger::LedgerBase<FakeLocalLedger>
+{
+public:
+    bcos::task::Task<bcos::concepts::ledger::Status> impl_getStatus()
+    {
+        bcos::concepts::ledger::Status status;
+        status.blockNumber = blocks.rbegin()->first;
+        co_return status;
+    }
+
+    template <bcos::concepts::ledger::DataFlag... Flags>
+    bcos::task::Task<void> impl_getBlock(int64_t blockNumber, bcostars::Block& block)
+    {
+        block = blocks.at(blockNumber);
+        co_return;
+    }
+
+    std::map<int64_t, bcostars::Block> blocks;
+};
+
+enum class Reply
+{
+    VALID,
+    CHANGED,
+    AHEAD,
+    OBSERVER,
+    UNREACHABLE,
+};
+
+// answers as the node of the requested nodeID
+class FakeRemoteLedger : public bcos::concepts::ledger::LedgerBase<FakeRemoteLedger>
+{
+public:
+    bcos::task::Task<void> impl_getStateProof(std::vector<bcostars::StateKey> const& keys,
+        bcostars::ResponseGetStateProof& proof, std::vector<char> const& nodeID)
+    {
+        ++requests;
+        auto reply = replies.at(nodeID);
+        if (reply == Reply::UNREACHABLE)
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("Unreachable node!"));
+        }
+
+        proof.blockNumber = local->blocks.rbegin()->first + (reply == Reply::AHEAD ? 1 : 0);
+        auto const& block = local->blocks.rbegin()->second;
+        std::array<std::byte, Hasher::HASH_SIZE> blockHash;
+        bcos::concepts::hash::calculate<Hasher>(block, blockHash);
+        proof.blockHash.assign(
+            (const char*)blockHash.data(), (const char*)blockHash.data() + blockHash.size());
+        for (auto const& key : keys)
+        {
+            auto& value = proof.values.emplace_back();
+            value.table = key.table;
+            value.key = key.key;
+            value.exists = true;
+            auto data = key.key + (reply == Reply::CHANGED ? "-changed" : "-value");
+            value.value.assign(data.begin(), data.end());
+        }
+        proof.nodeID = nodeID;
+        if (reply == Reply::OBSERVER)
+        {
+            proof.nodeID.assign(nodeID.size(), 'z');
+        }
+        auto stateRoot = bcos::lightnode::calculateStateRoot<Hasher>(proof.values);
+        proof.signature = FakeSignature::sign(proof.nodeID,
+            bcos::lightnode::calculateStateProofHash<Hasher>(
+                proof.blockNumber, blockHash, stateRoot));
+        co_return;
+    }
+
+    std::shared_ptr<FakeLocalLedger> local;
+    std::map<std::vector<char>, Reply> replies;
+    size_t requests = 0;
+};
+
+using StateReader =
+    bcos::lightnode::StateReader<std::shared_ptr<FakeLocalLedger>,
+        std::shared_ptr<FakeRemoteLedger>, Hasher>;
+
+struct StateReaderFixture
+{
+    StateReaderFixture()
+    {
+        local = std::make_shared<FakeLocalLedger>();
+        remote = std::make_shared<FakeRemoteLedger>();
+        remote->local = local;
+
+        auto& block = local->blocks[10];
+        block.blockHeader.data.blockNumber = 10;
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto& sealer = block.blockHeader.data.sealerList.emplace_back(64, (char)('a' + i));
+            remote->replies[sealer] = Reply::VALID;
+        }
+        key.table = "/apps/test";
+        key.key = "key";
+    }
+
+    std::vector<char> const& sealer(size_t index) const
+    {
+        return local->blocks[10].blockHeader.data.sealerList[index];
+    }
+
+    std::vector<std::optional<bcos::bytes>> getState(StateReader& reader)
+    {
+        return bcos::task::syncWait(reader.getStates({key}));
+    }
+
+    std::shared_ptr<FakeLocalLedger> local;
+    std::shared_ptr<FakeRemoteLedger> remote;
+    bcostars::StateKey key;
+};
+
+BOOST_FIXTURE_TEST_SUITE(StateReaderTest, StateReaderFixture)
+
+BOOST_AUTO_TEST_CASE(sealersOnly)
+{
+    // an observer answering for a sealer and an unreachable sealer are skipped
+    remote->replies[sealer(0)] = Reply::UNREACHABLE;
+    remote->replies[sealer(1)] = Reply::OBSERVER;
+    StateReader reader(local, remote, std::make_shared<FakeSignature>());
+
+    auto values = getState(reader);
+    BOOST_REQUIRE(values[0]);
+    BOOST_CHECK_EQUAL(std::string(values[0]->begin(), values[0]->end()), "key-value");
+    // f + 1 of the 4 sealers signed it
+    BOOST_CHECK_GE(remote->requests, 2);
+    BOOST_CHECK_EQUAL(reader.cacheSize(), 1);
+
+    // cached
+    auto requests = remote->requests;
+    getState(reader);
+    BOOST_CHECK_EQUAL(remote->requests, requests);
+}
+
+BOOST_AUTO_TEST_CASE(disagreedSealers)
+{
+    // one of the two reachable sealers signs another state
+    remote->replies[sealer(0)] = Reply::UNREACHABLE;
+    remote->replies[sealer(1)] = Reply::UNREACHABLE;
+    remote->replies[sealer(2)] = Reply::CHANGED;
+    StateReader reader(local, remote, std::make_shared<FakeSignature>());
+    BOOST_CHECK_THROW(getState(reader), bcos::lightnode::InvalidStateProof);
+    BOOST_CHECK_EQUAL(remote->requests, 4);
+    BOOST_CHECK_EQUAL(reader.cacheSize(), 0);
+
+    // trusting a single sealer
+    StateReader singleReader(local, remote, std::make_shared<FakeSignature>(),
+        StateReader::DEFAULT_CACHE_CAPACITY, 1);
+    auto values = getState(singleReader);
+    BOOST_REQUIRE(values[0]);
+}
+
+BOOST_AUTO_TEST_CASE(notSynced)
+{
+    for (auto& it : remote->replies)
+    {
+        it.second = Reply::AHEAD;
+    }
+    remote->replies[sealer(0)] = Reply::VALID;
+    StateReader reader(local, remote, std::make_shared<FakeSignature>());
+    BOOST_CHECK_THROW(getState(reader), bcos::lightnode::StateProofNotSynced);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
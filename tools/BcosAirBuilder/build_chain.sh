@@ -1240,10 +1240,31 @@ generate_common_ini() {
     ; url of the key center, in format of ip:port
     ;key_center_url=
     ;cipher_data_key=
+    ; value: encrypt every value, block: encrypt the files of rocksdb, which keeps the compression
+    ; effective, migrate the data by storage tool before switching from value to block
+    ;level=value
 
 [consensus]
     ; min block generation time(ms)
     min_seal_time=500
+    ; choose the block size and the seal interval by the measured execution time
+    ; adaptive_sealing=false
+    ; the block time(ms) the adaptive sealing tends to, no less than min_seal_time,
+    ; max(1000, min_seal_time) by default
+    ; target_block_time=1000
+    ; the lower bound of the block size chosen by the adaptive sealing
+    ; min_txs_per_block=100
+    ; send the proposal by erasure-coded chunks relayed by the consensus nodes,
+    ; requires all the consensus nodes to support it
+    ; proposal_dissemination=false
+    ; send the votes to the leader which broadcasts the quorum certificates,
+    ; requires all the consensus nodes to support it
+    ; vote_collection=false
+    ; write the committed proposals into the append-only WAL under data_path
+    ; instead of the storage
+    ; enable_wal=false
+    ; execute the proposal once pre-prepared, and reuse the result when it committed
+    ; pre_execute_proposal=false
 
 [storage]
     data_path=data
@@ -1256,6 +1277,12 @@ generate_common_ini() {
     enable_archive=false
     archive_ip=127.0.0.1
     archive_port=
+    ; write the transactions and receipts of a block with its state in one write batch
+    ; enable_group_commit=false
+    ; pipeline the writes of consecutive blocks to the WAL and the memtable of RocksDB
+    ; enable_pipelined_write=false
+    ; the memory size in bytes of the decoded latest blocks cached for the RPC reads, 0 to disable
+    ; ledger_cache_size=67108864
 
 [txpool]
     ; size of the txpool, default is 15000
@@ -1266,6 +1293,30 @@ generate_common_ini() {
     ;verify_worker_num=2
     ; txs expiration time, in seconds, default is 10 minutes
     txs_expiration_time = 600
+    ; memory of the pending txs, in MB, the txs exceeded are evicted by the priority, default is 0(unlimited)
+    ;memory_limit=1024
+    ; directory to spill the evicted txs and reload them later, the evicted txs are dropped if not set
+    ;spill_path=./data/txpool
+    ; priority to evict the txs, import_time(the latest imported first) or sender(the txs of the senders submitting the most first)
+    ;priority=import_time
+
+[others]
+    ; the sealer, consensus, block sync and txs sync workers run on these threads by default
+    ; instead of a thread each, and are woken up when work arrives, 0 to give every worker its
+    ; own thread
+    ;worker_reactor_threads=2
+
+[runtime]
+    ; the thread pools and workers of the node share the threads of the runtime, default disable
+    ;enable=false
+    ; worker threads of the runtime, default is the number of CPU cores
+    ;worker_threads=8
+    ; I/O threads of the runtime, default is 2
+    ;io_threads=2
+    ; pin the worker threads to the CPU cores, default is true
+    ;pin_threads=true
+    ; interval to report the cpu usage of the groups, in ms, 0 means never report, default is 60000
+    ;report_interval=60000
 
 [redis]
     ; redis server ip
@@ -1315,6 +1366,16 @@ generate_common_ini() {
     ;   group_outgoing_bw_limit_group0=2
     ;   group_outgoing_bw_limit_group1=2
     ;   group_outgoing_bw_limit_group2=2
+    ;
+    ; specify module to limit bandwidth in every group, module_outgoing_bw_limit_moduleName=n
+    ;   module_outgoing_bw_limit_block_sync=1
+    ;
+    ; the over-quota messages of the group are delayed by the weights of the modules instead of
+    ; being rejected, module_weight_moduleName=n, default 1
+    ;   module_weight_pbft=4
+    ;
+    ; the longest delay of the over-quota messages, unit: ms, 0 means reject directly
+    ; max_outgoing_delay=200
 
 [log]
     enable=true
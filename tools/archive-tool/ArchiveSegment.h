@@ -0,0 +1,423 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the archived transactions and receipts of a block range in one compressed value
+ * @file ArchiveSegment.h
+ * @date 2022-11-23
+ */
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/ZstdCompress.h>
+#include <boost/endian/conversion.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bcos::archive
+{
+const std::string SYS_ARCHIVE_SEGMENT = "s_archive_segment";
+// the key of the segment containing the transaction, keyed by the transaction hash
+const std::string SYS_ARCHIVE_TX_SEGMENT = "s_archive_tx_segment";
+
+/**
+ * @brief The transactions and receipts of [startBlock, endBlock) encoded as on chain and grouped
+ * by column, a segment is one row of SYS_ARCHIVE_SEGMENT keyed by its start block:
+ *
+ *   header:   magic | version | startBlock | endBlock | count | hashSize | indexSize
+ *   blocks:   u32 transaction count of every block
+ *   index:    u32 open addressing slots from the transaction hash to its ordinal + 1
+ *   hashes:   count * hashSize
+ *   columns:  u64 size | zstd(u32 lengths[count] | transactions)
+ *             u64 size | zstd(u32 lengths[count] | receipts)
+ *
+ * The hashes and the index are not compressed, a point lookup only decompresses the column it
+ * reads. All the integers are little endian.
+ */
+class ArchiveSegment
+{
+public:
+    constexpr static uint32_t MAGIC = 0x53414342;
+    constexpr static uint32_t VERSION = 2;
+    constexpr static uint32_t MAX_HASH_SIZE = 64;
+    constexpr static int COMPRESSION_LEVEL = 3;
+
+    enum Column : int
+    {
+        TRANSACTIONS = 1,
+        RECEIPTS = 2,
+        ALL = TRANSACTIONS | RECEIPTS,
+    };
+
+    ArchiveSegment(int64_t _startBlock, int64_t _endBlock)
+      : m_startBlock(_startBlock), m_endBlock(_endBlock)
+    {
+        m_blockTxCounts.reserve(_endBlock - _startBlock);
+        m_transactions.offsets.push_back(0);
+        m_receipts.offsets.push_back(0);
+    }
+
+    // the key of the segment starting at _startBlock, in the order of the block numbers
+    static std::string key(int64_t _startBlock)
+    {
+        std::ostringstream stream;
+        stream << std::setw(20) << std::setfill('0') << _startBlock;
+        return stream.str();
+    }
+    static int64_t startBlockFromKey(std::string_view _key)
+    {
+        return boost::lexical_cast<int64_t>(_key);
+    }
+
+    int64_t startBlock() const { return m_startBlock; }
+    int64_t endBlock() const { return m_endBlock; }
+    size_t size() const { return m_blockNumbers.size(); }
+
+    // append the next block, the transactions and receipts are the on chain encodings
+    void appendBlock(std::vector<std::string> const& _hashes,
+        std::vector<bytes> const& _transactions, std::vector<bytes> const& _receipts)
+    {
+        auto blockNumber = m_startBlock + (int64_t)m_blockTxCounts.size();
+        if (blockNumber >= m_endBlock || _hashes.size() != _transactions.size() ||
+            _hashes.size() != _receipts.size())
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("invalid block of archive segment"));
+        }
+        m_blockTxCounts.push_back(_hashes.size());
+        for (size_t i = 0; i < _hashes.size(); ++i)
+        {
+            if (m_hashSize == 0)
+            {
+                m_hashSize = _hashes[i].size();
+            }
+            if (_hashes[i].size() != m_hashSize)
+            {
+                BOOST_THROW_EXCEPTION(std::invalid_argument("invalid transaction hash size"));
+            }
+            m_hashes.append(_hashes[i]);
+            m_blockNumbers.push_back(blockNumber);
+            m_transactions.append(ref(_transactions[i]));
+            m_receipts.append(ref(_receipts[i]));
+        }
+    }
+
+    bytes encode() const
+    {
+        if ((int64_t)m_blockTxCounts.size() != m_endBlock - m_startBlock)
+        {
+            BOOST_THROW_EXCEPTION(std::logic_error("archive segment not complete"));
+        }
+        auto index = buildIndex();
+
+        bytes out;
+        out.reserve(HEADER_SIZE + 4 * (m_blockTxCounts.size() + index.size()) + m_hashes.size() +
+                    m_transactions.data.size() / 2 + m_receipts.data.size() / 2);
+        putInt(out, MAGIC);
+        putInt(out, VERSION);
+        putInt(out, m_startBlock);
+        putInt(out, m_endBlock);
+        putInt(out, (uint32_t)size());
+        putInt(out, (uint32_t)m_hashSize);
+        putInt(out, (uint32_t)index.size());
+        for (auto count : m_blockTxCounts)
+        {
+            putInt(out, count);
+        }
+        for (auto slot : index)
+        {
+            putInt(out, slot);
+        }
+        out.insert(out.end(), m_hashes.begin(), m_hashes.end());
+        m_transactions.encode(out);
+        m_receipts.encode(out);
+        return out;
+    }
+
+    // only the columns in _columns are decompressed
+    static ArchiveSegment decode(bytesConstRef _data, int _columns = ALL)
+    {
+        Reader reader{_data};
+        if (reader.get<uint32_t>() != MAGIC || reader.get<uint32_t>() != VERSION)
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("not an archive segment"));
+        }
+        auto startBlock = reader.get<int64_t>();
+        auto endBlock = reader.get<int64_t>();
+        auto count = reader.get<uint32_t>();
+        auto hashSize = reader.get<uint32_t>();
+        auto indexSize = reader.get<uint32_t>();
+        // check the counts against the size of the data before allocating anything by them
+        if (startBlock < 0 || endBlock < startBlock ||
+            (uint64_t)(endBlock - startBlock) > reader.remaining() / 4)
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment range"));
+        }
+        if (count > 0 && (hashSize == 0 || hashSize > MAX_HASH_SIZE ||
+                             (uint64_t)count * hashSize > reader.remaining()))
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment hashes"));
+        }
+        // the index has at least one empty slot, the probes always end
+        if (count == 0 ? indexSize != 0 :
+                         (indexSize <= count || (indexSize & (indexSize - 1)) != 0 ||
+                             indexSize > reader.remaining() / 4))
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment index"));
+        }
+
+        ArchiveSegment segment(startBlock, endBlock);
+        segment.m_hashSize = hashSize;
+        uint64_t total = 0;
+        for (auto blockNumber = startBlock; blockNumber < endBlock; ++blockNumber)
+        {
+            auto blockTxCount = reader.get<uint32_t>();
+            total += blockTxCount;
+            if (total > count)
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment count"));
+            }
+            segment.m_blockTxCounts.push_back(blockTxCount);
+            segment.m_blockNumbers.insert(segment.m_blockNumbers.end(), blockTxCount, blockNumber);
+        }
+        if (total != count)
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment count"));
+        }
+        segment.m_index.resize(indexSize);
+        size_t usedSlots = 0;
+        for (auto& slot : segment.m_index)
+        {
+            slot = reader.get<uint32_t>();
+            if (slot > count)
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment index"));
+            }
+            usedSlots += slot != 0 ? 1 : 0;
+        }
+        if (usedSlots != count)
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment index"));
+        }
+        auto hashes = reader.take((size_t)count * hashSize);
+        segment.m_hashes.assign((const char*)hashes.data(), hashes.size());
+
+        segment.m_transactions.decode(reader, count, (_columns & TRANSACTIONS) != 0);
+        segment.m_receipts.decode(reader, count, (_columns & RECEIPTS) != 0);
+        return segment;
+    }
+
+    // the ordinal of the transaction in the segment, -1 if not found
+    int64_t find(std::string_view _hash) const
+    {
+        if (m_index.empty() || _hash.size() != m_hashSize)
+        {
+            return -1;
+        }
+        auto mask = m_index.size() - 1;
+        for (auto slot = slotOf(_hash) & mask;; slot = (slot + 1) & mask)
+        {
+            auto ordinal = m_index[slot];
+            if (ordinal == 0)
+            {
+                return -1;
+            }
+            if (hash(ordinal - 1) == _hash)
+            {
+                return ordinal - 1;
+            }
+        }
+    }
+
+    std::string_view hash(size_t _index) const
+    {
+        return std::string_view(m_hashes).substr(_index * m_hashSize, m_hashSize);
+    }
+    int64_t blockNumber(size_t _index) const { return m_blockNumbers[_index]; }
+    // the ordinals of the transactions of the block are [first, second)
+    std::pair<size_t, size_t> blockRange(int64_t _blockNumber) const
+    {
+        auto begin = std::lower_bound(m_blockNumbers.begin(), m_blockNumbers.end(), _blockNumber);
+        auto end = std::upper_bound(begin, m_blockNumbers.end(), _blockNumber);
+        return {begin - m_blockNumbers.begin(), end - m_blockNumbers.begin()};
+    }
+    bytesConstRef transaction(size_t _index) const { return m_transactions.at(_index); }
+    bytesConstRef receipt(size_t _index) const { return m_receipts.at(_index); }
+
+private:
+    constexpr static size_t HEADER_SIZE = 4 + 4 + 8 + 8 + 4 + 4 + 4;
+
+    template <class T>
+    static void putInt(bytes& _out, T _value)
+    {
+        auto value = boost::endian::native_to_little(_value);
+        auto* begin = (const byte*)&value;
+        _out.insert(_out.end(), begin, begin + sizeof(value));
+    }
+
+    struct Reader
+    {
+        bytesConstRef data;
+        size_t offset = 0;
+
+        size_t remaining() const { return data.size() - offset; }
+
+        bytesConstRef take(size_t _size)
+        {
+            if (_size > remaining())
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("archive segment truncated"));
+            }
+            auto out = data.getCroppedData(offset, _size);
+            offset += _size;
+            return out;
+        }
+        template <class T>
+        T get()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+            return boost::endian::little_to_native(value);
+        }
+    };
+
+    // the values of a column, the lengths and the data are compressed together
+    struct ValueColumn
+    {
+        // 64 bits, a column may exceed 4GB
+        std::vector<uint64_t> offsets;
+        bytes data;
+
+        void append(bytesConstRef _value)
+        {
+            data.insert(data.end(), _value.begin(), _value.end());
+            offsets.push_back(data.size());
+        }
+        bytesConstRef at(size_t _index) const
+        {
+            if (_index + 1 >= offsets.size())
+            {
+                BOOST_THROW_EXCEPTION(std::out_of_range("archive segment column not decoded"));
+            }
+            return bytesConstRef(
+                data.data() + offsets[_index], offsets[_index + 1] - offsets[_index]);
+        }
+        void encode(bytes& _out) const
+        {
+            bytes raw;
+            raw.reserve(4 * (offsets.size() - 1) + data.size());
+            for (size_t i = 1; i < offsets.size(); ++i)
+            {
+                putInt(raw, (uint32_t)(offsets[i] - offsets[i - 1]));
+            }
+            raw.insert(raw.end(), data.begin(), data.end());
+
+            bytes compressed;
+            if (!ZstdCompress::compress(ref(raw), compressed, COMPRESSION_LEVEL))
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("compress archive segment failed"));
+            }
+            putInt(_out, (uint64_t)compressed.size());
+            _out.insert(_out.end(), compressed.begin(), compressed.end());
+        }
+        void decode(Reader& _reader, uint32_t _count, bool _decompress)
+        {
+            auto size = _reader.get<uint64_t>();
+            if (size > _reader.remaining())
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("archive segment truncated"));
+            }
+            auto compressed = _reader.take(size);
+            // zstd can't tell an empty frame from an error
+            if (!_decompress || _count == 0)
+            {
+                return;
+            }
+            bytes raw;
+            if (!ZstdCompress::uncompress(compressed, raw))
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("uncompress archive segment failed"));
+            }
+            if ((uint64_t)_count * 4 > raw.size())
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment column"));
+            }
+            Reader rawReader{ref(raw)};
+            offsets.reserve(_count + 1);
+            uint64_t total = 0;
+            for (uint32_t i = 0; i < _count; ++i)
+            {
+                total += rawReader.get<uint32_t>();
+                offsets.push_back(total);
+            }
+            if (total != raw.size() - rawReader.offset)
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("invalid archive segment column"));
+            }
+            data.assign(raw.begin() + rawReader.offset, raw.end());
+        }
+    };
+
+    static uint64_t slotOf(std::string_view _hash)
+    {
+        // the hashes are uniformly distributed already, read as little endian like the other
+        // integers so that archive-reader probes the same slots
+        uint64_t slot = 0;
+        std::memcpy(&slot, _hash.data(), std::min(sizeof(slot), _hash.size()));
+        return boost::endian::little_to_native(slot);
+    }
+
+    std::vector<uint32_t> buildIndex() const
+    {
+        if (size() == 0)
+        {
+            return {};
+        }
+        // at most half full, the probes stay short
+        size_t capacity = 1;
+        while (capacity < size() * 2)
+        {
+            capacity <<= 1;
+        }
+        std::vector<uint32_t> index(capacity, 0);
+        auto mask = capacity - 1;
+        for (size_t i = 0; i < size(); ++i)
+        {
+            auto slot = slotOf(hash(i)) & mask;
+            while (index[slot] != 0)
+            {
+                slot = (slot + 1) & mask;
+            }
+            index[slot] = i + 1;
+        }
+        return index;
+    }
+
+    int64_t m_startBlock;
+    int64_t m_endBlock;
+    size_t m_hashSize = 0;
+    std::vector<uint32_t> m_blockTxCounts;
+    std::vector<int64_t> m_blockNumbers;
+    std::string m_hashes;
+    std::vector<uint32_t> m_index;
+    ValueColumn m_transactions;
+    ValueColumn m_receipts;
+};
+}  // namespace bcos::archive
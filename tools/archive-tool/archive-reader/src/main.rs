@@ -18,6 +18,8 @@ use tide::Response;
 use tikv_client::TransactionOptions;
 use tokio::sync::Mutex;
 
+mod segment;
+
 #[derive(StructOpt)]
 struct Cli {
     /// The path of the abi json file
@@ -76,6 +78,57 @@ macro_rules! new_json_response {
     };
 }
 
+fn table_key(table: &[u8], key: &[u8]) -> Vec<u8> {
+    table.iter().chain(key.iter()).cloned().collect()
+}
+
+// the values of the keys, None if not found
+async fn get_values(storage: &Storage, keys: Vec<Vec<u8>>) -> tide::Result<Vec<Option<Vec<u8>>>> {
+    match storage {
+        Storage::RocksDB(db) => Ok(db
+            .multi_get(keys)
+            .into_iter()
+            .map(|x| x.ok().flatten())
+            .collect()),
+        Storage::TiKV(_client) => {
+            let client = _client.clone();
+            let timestamp = client.current_timestamp().await?;
+            let mut txn = client.snapshot(timestamp, TransactionOptions::new_optimistic());
+            let mut found: HashMap<Vec<u8>, Vec<u8>> = txn
+                .batch_get(keys.clone())
+                .await?
+                .map(|x| (x.key().clone().into(), x.value().clone()))
+                .collect();
+            Ok(keys.iter().map(|key| found.remove(key)).collect())
+        }
+    }
+}
+
+// the transaction or the receipt archived in a segment, found by the index of the segment
+async fn get_from_segment(
+    storage: &Storage,
+    hash: &[u8],
+    column: segment::Column,
+) -> tide::Result<Option<Vec<u8>>> {
+    let key = table_key(segment::TX_SEGMENT_TABLE.as_bytes(), hash);
+    let segment_key = match get_values(storage, vec![key]).await?.pop().flatten() {
+        Some(segment_key) => segment_key,
+        None => return Ok(None),
+    };
+    let key = table_key(segment::SEGMENT_TABLE.as_bytes(), &segment_key);
+    let data = match get_values(storage, vec![key]).await?.pop().flatten() {
+        Some(data) => data,
+        None => return Ok(None),
+    };
+    let to_error =
+        |message: String| tide::Error::from_str(tide::StatusCode::InternalServerError, message);
+    let segment = segment::Segment::parse(&data).map_err(to_error)?;
+    match segment.find(hash) {
+        Some(ordinal) => Ok(Some(segment.value(ordinal, column).map_err(to_error)?)),
+        None => Ok(None),
+    }
+}
+
 #[tokio::main(flavor = "multi_thread", worker_threads = 4)]
 async fn main() -> tide::Result<()> {
     let args = Cli::from_args();
@@ -126,14 +179,16 @@ async fn main() -> tide::Result<()> {
                     .build());
             }
 
-            let keys: Vec<Vec<u8>>;
             let hex_keys: Vec<String>;
             let table;
+            let column;
 
             if method == "getTransactionByHash" || method == "getTransactions" {
                 table = "s_hash_2_tx:".as_bytes();
+                column = segment::Column::Transactions;
             } else if method == "getTransactionReceipt" || method == "getTransactionReceipts" {
                 table = "s_hash_2_receipt:".as_bytes();
+                column = segment::Column::Receipts;
             } else {
                 let response = new_json_response!(
                     request_json.id,
@@ -152,16 +207,6 @@ async fn main() -> tide::Result<()> {
             if method == "getTransactionByHash" || method == "getTransactionReceipt" {
                 let hash = request_json.params.as_array().unwrap()[0].as_str().unwrap();
                 hex_keys = vec![hash.to_string()];
-                keys = vec![table
-                    .to_vec()
-                    .into_iter()
-                    .chain(
-                        prefix_hex::decode::<Vec<u8>>(hash)
-                            .unwrap()
-                            .to_owned()
-                            .into_iter(),
-                    )
-                    .collect()];
             } else {
                 hex_keys = request_json.params.as_array().unwrap()[0]
                     .as_array()
@@ -170,60 +215,28 @@ async fn main() -> tide::Result<()> {
                     .map(|s| s.as_str().unwrap().to_string())
                     .collect();
                 debug!("hex_keys: {:?}", hex_keys);
-                keys = hex_keys
-                    .iter()
-                    .map(|s| {
-                        table
-                            .to_vec()
-                            .into_iter()
-                            .chain(
-                                prefix_hex::decode::<Vec<u8>>(s.as_str())
-                                    .unwrap()
-                                    .to_owned()
-                                    .into_iter(),
-                            )
-                            .collect()
-                    })
-                    .collect();
-                debug!("keys: {:?}", keys);
             }
+            let hashes: Vec<Vec<u8>> = hex_keys
+                .iter()
+                .map(|s| prefix_hex::decode::<Vec<u8>>(s.as_str()).unwrap())
+                .collect();
+            let keys: Vec<Vec<u8>> = hashes.iter().map(|hash| table_key(table, hash)).collect();
+            debug!("keys: {:?}", keys);
 
-            // #[allow(unused_assignments)]
-            let result: HashMap<String, String>;
+            let mut result: HashMap<String, String> = HashMap::new();
             let database = req.state().lock().await;
-            match &*database {
-                Storage::RocksDB(db) => {
-                    let values: Vec<String> = db
-                        .multi_get(keys)
-                        .into_iter()
-                        .filter_map(|x| x.ok())
-                        .map(|x| match x {
-                            Some(v) => unsafe {
-                                std::str::from_utf8_unchecked(v.as_ref()).to_string()
-                            },
-                            None => "".to_string(),
-                        })
-                        .collect();
-                    // debug!("values: {:?}", values);
-                    result = zip(hex_keys, values)
-                        .map(|(k, v)| (k.to_string(), v))
-                        .collect();
-                }
-                Storage::TiKV(_client) => {
-                    let client = _client.clone();
-                    let timestamp = client.current_timestamp().await?;
-                    let mut txn = client.snapshot(timestamp, TransactionOptions::new_optimistic());
-                    result = txn
-                        .batch_get(keys)
-                        .await?
-                        .map(|x| unsafe {
-                            let value = std::str::from_utf8_unchecked(x.value()).to_string();
-                            let key: Vec<u8> = x.key().clone().into();
-                            let key = prefix_hex::encode(key.strip_prefix(table).unwrap());
-                            (key, value)
-                        })
-                        .collect();
-                }
+            let values = get_values(&database, keys).await?;
+            for ((hex_key, hash), value) in zip(zip(hex_keys, hashes), values) {
+                let value = match value {
+                    // archived as json
+                    Some(v) => unsafe { std::str::from_utf8_unchecked(v.as_ref()).to_string() },
+                    // archived in a segment, the hex of the on chain encoding
+                    None => match get_from_segment(&database, &hash, column).await? {
+                        Some(v) => prefix_hex::encode(v.as_slice()),
+                        None => "".to_string(),
+                    },
+                };
+                result.insert(hex_key, value);
             }
             let response = JsonResponse {
                 jsonrpc: "2.0".to_string(),
@@ -0,0 +1,204 @@
+// The archive segments written by archive-tool, see ArchiveSegment.h for the layout:
+//
+//   header:   magic | version | startBlock | endBlock | count | hashSize | indexSize
+//   blocks:   u32 transaction count of every block
+//   index:    u32 open addressing slots from the transaction hash to its ordinal + 1
+//   hashes:   count * hashSize
+//   columns:  u64 size | zstd(u32 lengths[count] | transactions)
+//             u64 size | zstd(u32 lengths[count] | receipts)
+
+use std::convert::TryInto;
+
+pub const SEGMENT_TABLE: &str = "s_archive_segment:";
+pub const TX_SEGMENT_TABLE: &str = "s_archive_tx_segment:";
+
+const MAGIC: u32 = 0x53414342;
+const VERSION: u32 = 2;
+const MAX_HASH_SIZE: usize = 64;
+const ZSTD_CONTENTSIZE_UNKNOWN: u64 = u64::MAX;
+const ZSTD_CONTENTSIZE_ERROR: u64 = u64::MAX - 1;
+
+#[derive(Clone, Copy)]
+pub enum Column {
+    Transactions = 0,
+    Receipts = 1,
+}
+
+struct Reader<'a> {
+    data: &'a [u8],
+    offset: usize,
+}
+
+impl<'a> Reader<'a> {
+    fn remaining(&self) -> usize {
+        self.data.len() - self.offset
+    }
+
+    fn take(&mut self, size: usize) -> Result<&'a [u8], String> {
+        if size > self.remaining() {
+            return Err("archive segment truncated".to_string());
+        }
+        let out = &self.data[self.offset..self.offset + size];
+        self.offset += size;
+        Ok(out)
+    }
+
+    fn u32(&mut self) -> Result<u32, String> {
+        Ok(u32::from_le_bytes(self.take(4)?.try_into().unwrap()))
+    }
+
+    fn u64(&mut self) -> Result<u64, String> {
+        Ok(u64::from_le_bytes(self.take(8)?.try_into().unwrap()))
+    }
+
+    fn i64(&mut self) -> Result<i64, String> {
+        Ok(i64::from_le_bytes(self.take(8)?.try_into().unwrap()))
+    }
+}
+
+pub struct Segment<'a> {
+    count: usize,
+    hash_size: usize,
+    index: Vec<u32>,
+    hashes: &'a [u8],
+    columns: [&'a [u8]; 2],
+}
+
+impl<'a> Segment<'a> {
+    // only the header, the index and the hashes are read, the columns are decompressed on demand
+    pub fn parse(data: &'a [u8]) -> Result<Self, String> {
+        let mut reader = Reader { data, offset: 0 };
+        if reader.u32()? != MAGIC || reader.u32()? != VERSION {
+            return Err("not an archive segment".to_string());
+        }
+        let start_block = reader.i64()?;
+        let end_block = reader.i64()?;
+        let count = reader.u32()? as usize;
+        let hash_size = reader.u32()? as usize;
+        let index_size = reader.u32()? as usize;
+        if start_block < 0
+            || end_block < start_block
+            || (end_block - start_block) as u64 > (reader.remaining() / 4) as u64
+        {
+            return Err("invalid archive segment range".to_string());
+        }
+        if count > 0
+            && (hash_size == 0
+                || hash_size > MAX_HASH_SIZE
+                || count as u64 * hash_size as u64 > reader.remaining() as u64)
+        {
+            return Err("invalid archive segment hashes".to_string());
+        }
+        let valid_index = if count == 0 {
+            index_size == 0
+        } else {
+            index_size > count
+                && index_size.is_power_of_two()
+                && index_size <= reader.remaining() / 4
+        };
+        if !valid_index {
+            return Err("invalid archive segment index".to_string());
+        }
+
+        let mut total: u64 = 0;
+        for _ in start_block..end_block {
+            total += reader.u32()? as u64;
+        }
+        if total != count as u64 {
+            return Err("invalid archive segment count".to_string());
+        }
+        let mut index = Vec::with_capacity(index_size);
+        for _ in 0..index_size {
+            let slot = reader.u32()?;
+            if slot as usize > count {
+                return Err("invalid archive segment index".to_string());
+            }
+            index.push(slot);
+        }
+        // the index has an empty slot, the probes always end
+        if index.iter().filter(|slot| **slot != 0).count() != count {
+            return Err("invalid archive segment index".to_string());
+        }
+        let hashes = reader.take(count * hash_size)?;
+        let size = reader.u64()?;
+        let transactions =
+            reader.take(size.try_into().map_err(|_| "archive segment truncated")?)?;
+        let size = reader.u64()?;
+        let receipts = reader.take(size.try_into().map_err(|_| "archive segment truncated")?)?;
+        Ok(Segment {
+            count,
+            hash_size,
+            index,
+            hashes,
+            columns: [transactions, receipts],
+        })
+    }
+
+    fn hash(&self, ordinal: usize) -> &[u8] {
+        &self.hashes[ordinal * self.hash_size..(ordinal + 1) * self.hash_size]
+    }
+
+    // the ordinal of the transaction in the segment
+    pub fn find(&self, hash: &[u8]) -> Option<usize> {
+        if self.index.is_empty() || hash.len() != self.hash_size {
+            return None;
+        }
+        let mut prefix = [0u8; 8];
+        let size = std::cmp::min(prefix.len(), hash.len());
+        prefix[..size].copy_from_slice(&hash[..size]);
+        let mask = self.index.len() - 1;
+        let mut slot = u64::from_le_bytes(prefix) as usize & mask;
+        loop {
+            let ordinal = self.index[slot] as usize;
+            if ordinal == 0 {
+                return None;
+            }
+            if self.hash(ordinal - 1) == hash {
+                return Some(ordinal - 1);
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    // the on chain encoding of the transaction or the receipt, only its column is decompressed
+    pub fn value(&self, ordinal: usize, column: Column) -> Result<Vec<u8>, String> {
+        let raw = decompress(self.columns[column as usize])?;
+        let mut reader = Reader {
+            data: &raw,
+            offset: 0,
+        };
+        let mut lengths = Vec::with_capacity(std::cmp::min(self.count, raw.len() / 4));
+        for _ in 0..self.count {
+            lengths.push(reader.u32()? as usize);
+        }
+        if ordinal >= self.count || lengths.iter().sum::<usize>() != reader.remaining() {
+            return Err("invalid archive segment column".to_string());
+        }
+        reader.take(lengths[..ordinal].iter().sum())?;
+        Ok(reader.take(lengths[ordinal])?.to_vec())
+    }
+}
+
+fn decompress(data: &[u8]) -> Result<Vec<u8>, String> {
+    let size = unsafe { zstd_sys::ZSTD_getFrameContentSize(data.as_ptr().cast(), data.len()) };
+    if size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR {
+        return Err("invalid archive segment column".to_string());
+    }
+    let size: usize = size
+        .try_into()
+        .map_err(|_| "invalid archive segment column")?;
+    let mut out = vec![0u8; size];
+    let written = unsafe {
+        zstd_sys::ZSTD_decompress(
+            out.as_mut_ptr().cast(),
+            out.len(),
+            data.as_ptr().cast(),
+            data.len(),
+        )
+    };
+    if unsafe { zstd_sys::ZSTD_isError(written) } != 0 {
+        return Err("uncompress archive segment failed".to_string());
+    }
+    out.truncate(written);
+    Ok(out)
+}
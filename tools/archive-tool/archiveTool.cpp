@@ -19,6 +19,7 @@
  * @date 2022-11-08
  */
 
+#include "ArchiveSegment.h"
 #include "bcos-framework/ledger/LedgerTypeDef.h"
 #include "bcos-framework/storage/StorageInterface.h"
 #include "bcos-ledger/src/libledger/Ledger.h"
@@ -38,6 +39,7 @@
 #include <bcos-crypto/hash/SM3.h>
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-security/bcos-security/DataEncryption.h>
+#include <bcos-storage/RocksDBEncryption.h>
 #include <bcos-storage/RocksDBStorage.h>
 #include <bcos-table/src/KeyPageStorage.h>
 #include <json/value.h>
@@ -57,6 +59,7 @@
 #include <boost/program_options.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/throw_exception.hpp>
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <functional>
@@ -100,7 +103,14 @@ po::variables_map initCommandLine(int argc, const char* argv[])
         "the ip and port of node archive service in format of IP:Port, ipv6 is not supported")("pd",
         boost::program_options::value<std::string>(),
         "pd address of TiKV, if set use TiKV to archive data of reimport from TiKV, multi address "
-        "is split by comma");
+        "is split by comma")("format,f",
+        boost::program_options::value<std::string>()->default_value("segment"),
+        "the format of the archived data, segment: the compressed segments of blocks, json: the "
+        "json of every transaction and receipt, both are served by archive-reader")(
+        "segment-blocks",
+        boost::program_options::value<int64_t>()->default_value(100),
+        "the number of blocks in a segment, the segments are aligned to the multiples of it")(
+        "keep-blocks", "archive without deleting the archived blocks in the node");
     po::variables_map varMap;
     try
     {
@@ -121,11 +131,19 @@ po::variables_map initCommandLine(int argc, const char* argv[])
     return varMap;
 }
 
-DB* createSecondaryRocksDB(const std::string& path, const std::string& secondaryPath)
+// the env of the local storage encrypted by blocks, lives until the tool exits
+std::shared_ptr<rocksdb::Env> blockEncryptedEnv = nullptr;
+
+DB* createSecondaryRocksDB(
+    const std::string& path, const std::string& secondaryPath, rocksdb::Env* env = nullptr)
 {
     Options options;
     options.create_if_missing = false;
     options.max_open_files = -1;
+    if (env != nullptr)
+    {
+        options.env = env;
+    }
     DB* db_secondary = nullptr;
     Status status = DB::OpenAsSecondary(options, path, secondaryPath, &db_secondary);
     if (!status.ok())
@@ -157,8 +175,16 @@ TransactionalStorageInterface::Ptr createBackendStorage(
         }
         if (write)
         {
-            storage = StorageInitializer::build(
-                nodeConfig->storagePath(), dataEncryption, nodeConfig->keyPageSize());
+            storage = StorageInitializer::build(nodeConfig->storagePath(), dataEncryption,
+                nodeConfig->keyPageSize(), nodeConfig->storageSecurityBlockLevel());
+        }
+        else if (dataEncryption && nodeConfig->storageSecurityBlockLevel())
+        {
+            blockEncryptedEnv = newBlockEncryptedEnv(*dataEncryption);
+            auto* rocksdb = createSecondaryRocksDB(
+                nodeConfig->storagePath(), secondaryPath, blockEncryptedEnv.get());
+            storage =
+                std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(rocksdb), nullptr);
         }
         else
         {
@@ -254,6 +280,111 @@ void deleteArchivedBlocksInNode(const std::string& endpoint, int64_t startBlock,
     }
 }
 
+bcos::protocol::Block::Ptr getBlock(auto ledger, int64_t blockNumber)
+{
+    std::promise<bcos::protocol::Block::Ptr> promise;
+    ledger->asyncGetBlockDataByNumber(blockNumber, bcos::ledger::FULL_BLOCK,
+        [&promise](const Error::Ptr& error, bcos::protocol::Block::Ptr block) {
+            if (error)
+            {
+                std::cerr << "get block failed: " << error->errorMessage() << endl;
+                exit(1);
+            }
+            promise.set_value(std::move(block));
+        });
+    return promise.get_future().get();
+}
+
+// the segments of [startBlockNumber, endBlockNumber), the boundaries are aligned to the multiples
+// of segmentBlocks so that archiving the adjacent ranges produces the same segments
+std::vector<std::pair<int64_t, int64_t>> splitSegments(
+    int64_t startBlockNumber, int64_t endBlockNumber, int64_t segmentBlocks)
+{
+    std::vector<std::pair<int64_t, int64_t>> segments;
+    for (auto start = startBlockNumber; start < endBlockNumber;)
+    {
+        auto end = std::min((start / segmentBlocks + 1) * segmentBlocks, endBlockNumber);
+        segments.emplace_back(start, end);
+        start = end;
+    }
+    return segments;
+}
+
+void archiveSegments(auto archiveStorage, auto ledger, int64_t startBlockNumber,
+    int64_t endBlockNumber, int64_t segmentBlocks)
+{
+    auto segments = splitSegments(startBlockNumber, endBlockNumber, segmentBlocks);
+    std::atomic<size_t> writtenSegments = 0;
+    std::atomic<size_t> writtenBytes = 0;
+    // every segment is read, encoded and written by one task, the blocks of a segment in order
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, segments.size(), 1),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i)
+            {
+                auto [start, end] = segments[i];
+                archive::ArchiveSegment segment(start, end);
+                for (auto blockNumber = start; blockNumber < end; ++blockNumber)
+                {
+                    auto block = getBlock(ledger, blockNumber);
+                    auto size = block->transactionsSize();
+                    if (block->receiptsSize() != size)
+                    {
+                        std::cerr << "the receipts of block " << blockNumber
+                                  << " mismatch, transactions: " << size
+                                  << ", receipts: " << block->receiptsSize() << std::endl;
+                        exit(1);
+                    }
+                    std::vector<std::string> hashes(size);
+                    std::vector<bytes> transactions(size);
+                    std::vector<bytes> receipts(size);
+                    for (size_t j = 0; j < size; ++j)
+                    {
+                        auto transaction = block->transaction(j);
+                        auto hash = transaction->hash();
+                        hashes[j] = std::string((char*)hash.data(), hash.size());
+                        transaction->encode(transactions[j]);
+                        block->receipt(j)->encode(receipts[j]);
+                    }
+                    segment.appendBlock(hashes, transactions, receipts);
+                }
+                auto value = segment.encode();
+                auto key = archive::ArchiveSegment::key(start);
+                // archive-reader finds the segment of a transaction by its hash, and the
+                // transaction in the segment by the index of the segment
+                std::vector<std::string_view> hashes;
+                hashes.reserve(segment.size());
+                for (size_t j = 0; j < segment.size(); ++j)
+                {
+                    hashes.emplace_back(segment.hash(j));
+                }
+                std::vector<std::string_view> segmentKeys(segment.size(), key);
+                auto error = archiveStorage->setRows(
+                    archive::SYS_ARCHIVE_TX_SEGMENT, std::move(hashes), std::move(segmentKeys));
+                if (!error)
+                {
+                    std::vector<std::string_view> keys{key};
+                    std::vector<std::string_view> values{
+                        std::string_view((char*)value.data(), value.size())};
+                    error = archiveStorage->setRows(archive::SYS_ARCHIVE_SEGMENT, keys, values);
+                }
+                if (error)
+                {
+                    std::cerr << "write segment " << start << " failed: " << error->errorMessage()
+                              << std::endl;
+                    exit(1);
+                }
+                writtenBytes += value.size();
+                std::cout << "\r"
+                          << "write segments " << ++writtenSegments << "/" << segments.size()
+                          << std::flush;
+            }
+        });
+    std::cout << std::endl
+              << "write " << segments.size() << " segments of " << writtenBytes
+              << " bytes to archive database, block range [" << startBlockNumber << ","
+              << endBlockNumber << ")" << std::endl;
+}
+
 void archiveBlocks(auto archiveStorage, auto ledger,
     const std::shared_ptr<bcos::tool::NodeConfig>& nodeConfig, int64_t startBlockNumber,
     int64_t endBlockNumber)
@@ -507,6 +638,106 @@ void reimportBlocks(auto archiveStorage, TransactionalStorageInterface::Ptr loca
               << endBlockNumber << ")" << std::endl;
 }
 
+void reimportSegments(auto archiveStorage, TransactionalStorageInterface::Ptr localStorage,
+    int64_t startBlockNumber, int64_t endBlockNumber)
+{
+    std::promise<std::vector<std::string>> promiseKeys;
+    archiveStorage->asyncGetPrimaryKeys(archive::SYS_ARCHIVE_SEGMENT, std::nullopt,
+        [&](Error::UniquePtr err, std::vector<std::string> keys) {
+            if (err)
+            {
+                std::cerr << "get archive segments failed: " << err->errorMessage() << std::endl;
+                exit(1);
+            }
+            promiseKeys.set_value(std::move(keys));
+        });
+    auto keys = promiseKeys.get_future().get();
+    // a segment never crosses a multiple of the segment size, the one starts before the range
+    // may overlap it
+    std::sort(keys.begin(), keys.end());
+
+    int64_t reimportedBlocks = 0;
+    // one segment in memory at a time
+    for (auto const& key : keys)
+    {
+        if (archive::ArchiveSegment::startBlockFromKey(key) >= endBlockNumber)
+        {
+            break;
+        }
+        std::promise<std::optional<Entry>> promiseSegment;
+        archiveStorage->asyncGetRow(archive::SYS_ARCHIVE_SEGMENT, key,
+            [&](Error::UniquePtr err, std::optional<Entry> entry) {
+                if (err)
+                {
+                    std::cerr << "get archive segment failed: " << err->errorMessage()
+                              << std::endl;
+                    exit(1);
+                }
+                promiseSegment.set_value(std::move(entry));
+            });
+        auto entry = promiseSegment.get_future().get();
+        if (!entry)
+        {
+            std::cerr << "archive segment not found, key: " << key << std::endl;
+            exit(1);
+        }
+        auto view = entry->get();
+        auto data = bytesConstRef((const byte*)view.data(), view.size());
+        auto segment = archive::ArchiveSegment::decode(data, 0);
+        auto start = std::max(segment.startBlock(), startBlockNumber);
+        auto end = std::min(segment.endBlock(), endBlockNumber);
+        if (start >= end)
+        {
+            continue;
+        }
+        segment = archive::ArchiveSegment::decode(data);
+        auto [first, last] = segment.blockRange(start);
+        last = segment.blockRange(end - 1).second;
+
+        std::vector<std::string_view> txHashes;
+        std::vector<std::string_view> txs;
+        std::vector<std::string_view> receipts;
+        txHashes.reserve(last - first);
+        txs.reserve(last - first);
+        receipts.reserve(last - first);
+        for (auto i = first; i < last; ++i)
+        {
+            txHashes.emplace_back(segment.hash(i));
+            auto transaction = segment.transaction(i);
+            txs.emplace_back((const char*)transaction.data(), transaction.size());
+            auto receipt = segment.receipt(i);
+            receipts.emplace_back((const char*)receipt.data(), receipt.size());
+        }
+        // the transactions and receipts are archived as encoded on chain, write them back directly
+        auto error = localStorage->setRows(ledger::SYS_HASH_2_TX, txHashes, std::move(txs));
+        if (!error)
+        {
+            error = localStorage->setRows(
+                ledger::SYS_HASH_2_RECEIPT, std::move(txHashes), std::move(receipts));
+        }
+        if (error)
+        {
+            std::cerr << "write segment " << segment.startBlock()
+                      << " to local storage failed: " << error->errorMessage() << std::endl;
+            exit(1);
+        }
+        reimportedBlocks += end - start;
+        std::cout << "\r"
+                  << "reimport blocks [" << start << "," << end << ") size: " << last - first
+                  << std::flush;
+    }
+    if (reimportedBlocks != endBlockNumber - startBlockNumber)
+    {
+        std::cerr << std::endl
+                  << "only " << reimportedBlocks << " blocks of range [" << startBlockNumber << ","
+                  << endBlockNumber << ") found in the archive segments" << std::endl;
+        exit(1);
+    }
+    std::cout << std::endl
+              << "reimport from archive database success, block range [" << startBlockNumber << ","
+              << endBlockNumber << ")" << std::endl;
+}
+
 int main(int argc, const char* argv[])
 {
     boost::property_tree::ptree propertyTree;
@@ -544,7 +775,21 @@ int main(int argc, const char* argv[])
     {
         endpoint = params["endpoint"].as<std::string>();
     }
-    if (params.count("archive") != 0U && endpoint.empty())
+    auto format = params["format"].as<std::string>();
+    if (format != "segment" && format != "json")
+    {
+        cerr << "archive format not support, only support segment and json, format: " << format
+             << endl;
+        return 1;
+    }
+    auto segmentBlocks = params["segment-blocks"].as<int64_t>();
+    if (segmentBlocks <= 0)
+    {
+        cerr << "invalid segment blocks: " << segmentBlocks << endl;
+        return 1;
+    }
+    auto keepBlocks = params.count("keep-blocks") != 0U;
+    if (params.count("archive") != 0U && endpoint.empty() && !keepBlocks)
     {
         cout << "the IP::Port of node's archive service is empty" << endl;
         return 1;
@@ -688,12 +933,31 @@ int main(int argc, const char* argv[])
     }
     if (isArchive)
     {
-        archiveBlocks(archiveStorage, ledger, nodeConfig, startBlockNumber, endBlockNumber);
-        deleteArchivedBlocksInNode(endpoint, startBlockNumber, endBlockNumber);
+        if (format == "segment")
+        {
+            archiveSegments(
+                archiveStorage, ledger, startBlockNumber, endBlockNumber, segmentBlocks);
+        }
+        else
+        {
+            archiveBlocks(archiveStorage, ledger, nodeConfig, startBlockNumber, endBlockNumber);
+        }
+        if (!keepBlocks)
+        {
+            deleteArchivedBlocksInNode(endpoint, startBlockNumber, endBlockNumber);
+        }
     }
     else
     {  // reimport
-        reimportBlocks(archiveStorage, localStorage, nodeConfig, startBlockNumber, endBlockNumber);
+        if (format == "segment")
+        {
+            reimportSegments(archiveStorage, localStorage, startBlockNumber, endBlockNumber);
+        }
+        else
+        {
+            reimportBlocks(
+                archiveStorage, localStorage, nodeConfig, startBlockNumber, endBlockNumber);
+        }
     }
     if (fs::exists(secondaryPath))
     {
@@ -0,0 +1,194 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit tests for the archive segments
+ * @file ArchiveSegmentTest.cpp
+ * @date 2022-11-23
+ */
+#include "ArchiveSegment.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <limits>
+#include <map>
+
+using namespace bcos;
+using namespace bcos::archive;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(ArchiveSegmentTest, TestPromptFixture)
+
+// block n has n % 4 transactions, the block 4k has none
+size_t blockTxs(int64_t _blockNumber)
+{
+    return _blockNumber % 4;
+}
+std::string fakeHash(int64_t _blockNumber, size_t _index)
+{
+    auto hash = std::string(32, (char)_index);
+    std::memcpy(hash.data(), &_blockNumber, sizeof(_blockNumber));
+    return hash;
+}
+bytes fakeValue(std::string const& _hash, char _column)
+{
+    // the values of different sizes
+    auto value = bytes(_hash.begin(), _hash.end());
+    value.insert(value.end(), (size_t)_hash[0] * 3, (byte)_column);
+    return value;
+}
+
+// archive [_start, _end) into the rows keyed as archiveSegments
+std::map<std::string, bytes> archive(int64_t _start, int64_t _end, int64_t _segmentBlocks)
+{
+    std::map<std::string, bytes> rows;
+    for (auto start = _start; start < _end;)
+    {
+        auto end = std::min((start / _segmentBlocks + 1) * _segmentBlocks, _end);
+        ArchiveSegment segment(start, end);
+        for (auto blockNumber = start; blockNumber < end; ++blockNumber)
+        {
+            std::vector<std::string> hashes;
+            std::vector<bytes> transactions;
+            std::vector<bytes> receipts;
+            for (size_t i = 0; i < blockTxs(blockNumber); ++i)
+            {
+                hashes.push_back(fakeHash(blockNumber, i));
+                transactions.push_back(fakeValue(hashes.back(), 't'));
+                receipts.push_back(fakeValue(hashes.back(), 'r'));
+            }
+            segment.appendBlock(hashes, transactions, receipts);
+        }
+        rows.emplace(ArchiveSegment::key(start), segment.encode());
+        start = end;
+    }
+    return rows;
+}
+
+BOOST_AUTO_TEST_CASE(testRoundTrip)
+{
+    auto rows = archive(3, 95, 10);
+    BOOST_CHECK_EQUAL(rows.size(), 10);
+    // the keys in the order of the block numbers
+    BOOST_CHECK_EQUAL(ArchiveSegment::startBlockFromKey(rows.begin()->first), 3);
+    BOOST_CHECK_EQUAL(ArchiveSegment::startBlockFromKey(rows.rbegin()->first), 90);
+
+    // read every block back from the segment containing it
+    for (int64_t blockNumber = 3; blockNumber < 95; ++blockNumber)
+    {
+        auto it = rows.upper_bound(ArchiveSegment::key(blockNumber));
+        BOOST_REQUIRE(it != rows.begin());
+        --it;
+        auto segment = ArchiveSegment::decode(ref(it->second));
+        BOOST_CHECK_LE(segment.startBlock(), blockNumber);
+        BOOST_CHECK_GT(segment.endBlock(), blockNumber);
+
+        auto [first, last] = segment.blockRange(blockNumber);
+        BOOST_CHECK_EQUAL(last - first, blockTxs(blockNumber));
+        for (auto i = first; i < last; ++i)
+        {
+            auto hash = fakeHash(blockNumber, i - first);
+            BOOST_CHECK(segment.hash(i) == hash);
+            BOOST_CHECK_EQUAL(segment.blockNumber(i), blockNumber);
+            BOOST_CHECK(segment.transaction(i).toBytes() == fakeValue(hash, 't'));
+            BOOST_CHECK(segment.receipt(i).toBytes() == fakeValue(hash, 'r'));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFind)
+{
+    auto rows = archive(20, 60, 40);
+    auto segment = ArchiveSegment::decode(ref(rows.begin()->second), 0);
+    // found by the index without decompressing the columns
+    for (size_t i = 0; i < segment.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(segment.find(segment.hash(i)), i);
+    }
+    auto [first, last] = segment.blockRange(23);
+    BOOST_CHECK_EQUAL(last - first, 3);
+    BOOST_CHECK_EQUAL(segment.find(fakeHash(23, 2)), last - 1);
+    BOOST_CHECK_EQUAL(segment.find(fakeHash(23, 3)), -1);
+    BOOST_CHECK_EQUAL(segment.find(fakeHash(24, 0)), -1);
+    BOOST_CHECK_EQUAL(segment.find("short"), -1);
+
+    // no transactions
+    segment = ArchiveSegment::decode(ref(archive(40, 41, 10).begin()->second));
+    BOOST_CHECK_EQUAL(segment.size(), 0);
+    BOOST_CHECK_EQUAL(segment.find(fakeHash(40, 0)), -1);
+}
+
+BOOST_AUTO_TEST_CASE(testColumns)
+{
+    auto rows = archive(10, 20, 10);
+    auto const& data = rows.begin()->second;
+    auto segment = ArchiveSegment::decode(ref(data), 0);
+    BOOST_CHECK_EQUAL(segment.size(), 17);
+    BOOST_CHECK(segment.hash(0) == fakeHash(10, 0));
+    BOOST_CHECK_THROW(segment.transaction(0), std::out_of_range);
+    BOOST_CHECK_THROW(segment.receipt(0), std::out_of_range);
+
+    segment = ArchiveSegment::decode(ref(data), ArchiveSegment::RECEIPTS);
+    BOOST_CHECK_THROW(segment.transaction(0), std::out_of_range);
+    BOOST_CHECK(segment.receipt(0).toBytes() == fakeValue(fakeHash(10, 0), 'r'));
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidSegment)
+{
+    ArchiveSegment segment(0, 2);
+    segment.appendBlock({}, {}, {});
+    // not all the blocks appended
+    BOOST_CHECK_THROW(segment.encode(), std::logic_error);
+    BOOST_CHECK_THROW(segment.appendBlock({fakeHash(1, 0)}, {}, {}), std::invalid_argument);
+    segment.appendBlock({}, {}, {});
+    BOOST_CHECK_THROW(segment.appendBlock({}, {}, {}), std::invalid_argument);
+
+    auto data = archive(10, 20, 10).begin()->second;
+    auto truncated = bytesConstRef(data.data(), data.size() - 1);
+    BOOST_CHECK_THROW(ArchiveSegment::decode(truncated), std::runtime_error);
+    data[0] ^= 1;
+    BOOST_CHECK_THROW(ArchiveSegment::decode(ref(data)), std::runtime_error);
+
+    // the counts of the header are checked against the size before allocating by them
+    auto valid = archive(10, 20, 10).begin()->second;
+    auto corrupt = [&valid](size_t _offset, uint64_t _value, size_t _size) {
+        auto data = valid;
+        std::memcpy(data.data() + _offset, &_value, _size);
+        return data;
+    };
+    // the end block
+    data = corrupt(16, std::numeric_limits<int64_t>::max(), 8);
+    BOOST_CHECK_THROW(ArchiveSegment::decode(ref(data)), std::runtime_error);
+    // the transaction count
+    data = corrupt(24, std::numeric_limits<uint32_t>::max(), 4);
+    BOOST_CHECK_THROW(ArchiveSegment::decode(ref(data)), std::runtime_error);
+    // the hash size
+    data = corrupt(28, 1U << 20, 4);
+    BOOST_CHECK_THROW(ArchiveSegment::decode(ref(data)), std::runtime_error);
+    // the index size, too large or without an empty slot
+    data = corrupt(32, 1U << 30, 4);
+    BOOST_CHECK_THROW(ArchiveSegment::decode(ref(data)), std::runtime_error);
+    data = corrupt(32, 16, 4);
+    BOOST_CHECK_THROW(ArchiveSegment::decode(ref(data)), std::runtime_error);
+    // the transaction count of a block
+    data = corrupt(36, std::numeric_limits<uint32_t>::max(), 4);
+    BOOST_CHECK_THROW(ArchiveSegment::decode(ref(data)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
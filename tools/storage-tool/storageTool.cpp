@@ -34,6 +34,7 @@
 #include "tikv_client.h"
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-security/bcos-security/DataEncryption.h>
+#include <bcos-storage/RocksDBEncryption.h>
 #include <bcos-storage/RocksDBStorage.h>
 #include <bcos-table/src/KeyPageStorage.h>
 #include <bcos-table/src/StateStorageFactory.h>
@@ -84,7 +85,9 @@ po::variables_map initCommandLine(int argc, const char* argv[])
         po::value<std::vector<std::string>>()->multitoken(),
         "[RocksDB] [path] [Table] or [TiKV] [pd addresses] [Table]/[ca path if use ssl] [cert path "
         "if use ssl] [Table], eg RocksDB ../node0/data s_hash_2_tx"
-        "[key path if use ssl]")("config,c",
+        "[key path if use ssl]")("migrate-encryption,m", po::value<std::string>(),
+        "[target path] copy the storage encrypted by values to the target path encrypted by "
+        "blocks, the node should be stopped")("config,c",
         boost::program_options::value<std::string>()->default_value("./config.ini"),
         "config file path")("genesis,g",
         boost::program_options::value<std::string>()->default_value("./config.genesis"),
@@ -175,12 +178,19 @@ void writeKeys(std::ostream& output, const std::vector<std::string>& keys, bool
     output << (hex ? toHex(keys.back()) : keys.back()) << "]" << endl;
 }
 
-DB* createSecondaryRocksDB(
-    const std::string& path, const std::string& secondaryPath = "./rocksdb_secondary/")
+// the env of the local storage encrypted by blocks, lives until the tool exits
+std::shared_ptr<rocksdb::Env> blockEncryptedEnv = nullptr;
+
+DB* createSecondaryRocksDB(const std::string& path,
+    const std::string& secondaryPath = "./rocksdb_secondary/", rocksdb::Env* env = nullptr)
 {
     Options options;
     options.create_if_missing = false;
     options.max_open_files = -1;
+    if (env != nullptr)
+    {
+        options.env = env;
+    }
     DB* db_secondary = nullptr;
     Status status = DB::OpenAsSecondary(options, path, secondaryPath, &db_secondary);
     if (!status.ok())
@@ -254,8 +264,15 @@ TransactionalStorageInterface::Ptr createBackendStorage(
         }
         if (write)
         {
-            storage = StorageInitializer::build(
-                nodeConfig->storagePath(), dataEncryption, nodeConfig->keyPageSize());
+            storage = StorageInitializer::build(nodeConfig->storagePath(), dataEncryption,
+                nodeConfig->keyPageSize(), nodeConfig->storageSecurityBlockLevel());
+        }
+        else if (blockEncryptedEnv)
+        {
+            auto* rocksdb = createSecondaryRocksDB(
+                nodeConfig->storagePath(), secondaryPath, blockEncryptedEnv.get());
+            storage =
+                std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(rocksdb), nullptr);
         }
         else
         {
@@ -457,13 +474,40 @@ int main(int argc, const char* argv[])
     {
         dataEncryption = std::make_shared<bcos::security::DataEncryption>(nodeConfig);
         dataEncryption->init();
+        if (nodeConfig->storageSecurityBlockLevel())
+        {
+            blockEncryptedEnv = storage::newBlockEncryptedEnv(*dataEncryption);
+        }
     }
 
     auto keyPageSize = nodeConfig->keyPageSize();
     auto keyPageIgnoreTables = getKeyPageIgnoreTables(nodeConfig->compatibilityVersion());
     std::string secondaryPath = "./rocksdb_secondary/";
     std::string remoteSecondaryPath = "./rocksdb_secondary/";
-    if (params.count("read"))
+    if (params.count("migrate-encryption") != 0U)
+    {
+        if (!dataEncryption || nodeConfig->storageSecurityBlockLevel())
+        {
+            cerr << "the storage should be encrypted by values, check storage_security" << endl;
+            return -1;
+        }
+        auto targetPath = params["migrate-encryption"].as<std::string>();
+        cout << "migrate " << nodeConfig->storagePath() << " to " << targetPath << endl;
+        auto count = StorageInitializer::migrateToBlockEncryption(
+            nodeConfig->storagePath(), targetPath, dataEncryption);
+        cout << "migrate " << count << " entries" << endl;
+        // the consensus log of the air node is a database in the storage path
+        auto consensusPath = fs::path(nodeConfig->storagePath()) / "consensus_log";
+        if (fs::exists(consensusPath / "CURRENT"))
+        {
+            count = StorageInitializer::migrateToBlockEncryption(consensusPath.string(),
+                (fs::path(targetPath) / "consensus_log").string(), dataEncryption);
+            cout << "migrate " << count << " entries of consensus log" << endl;
+        }
+        cout << "replace " << nodeConfig->storagePath() << " with " << targetPath
+             << " and set storage_security.level=block before starting the node" << endl;
+    }
+    else if (params.count("read"))
     {  // read
         auto readParameters = params["read"].as<vector<string>>();
         if (readParameters.empty())
@@ -662,7 +706,8 @@ int main(int argc, const char* argv[])
             if (boost::iequals(nodeConfig->storageType(), "RocksDB"))
             {
                 // rocksdb
-                auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                auto* rocksdb = createSecondaryRocksDB(
+                    nodeConfig->storagePath(), secondaryPath, blockEncryptedEnv.get());
                 rocksdb::Iterator* it = rocksdb->NewIterator(rocksdb::ReadOptions());
                 it->Seek(tableName);
                 while (it->Valid())
@@ -734,7 +779,8 @@ int main(int argc, const char* argv[])
         {
             if (params.count("statistic") || params.count("s"))
             {  // statistics
-                auto* db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                auto* db = createSecondaryRocksDB(
+                    nodeConfig->storagePath(), secondaryPath, blockEncryptedEnv.get());
                 getTableSize(db, storage::StorageInterface::SYS_TABLES);
                 getTableSize(db, ledger::SYS_CONSENSUS);
                 getTableSize(db, ledger::SYS_CONFIG);
@@ -753,7 +799,8 @@ int main(int argc, const char* argv[])
             }
             if (params.count("stateSize") || params.count("S"))
             {  // calculate contract data size
-                auto* db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                auto* db = createSecondaryRocksDB(
+                    nodeConfig->storagePath(), secondaryPath, blockEncryptedEnv.get());
                 getTableSize(db, storage::FS_APPS);
             }
         }